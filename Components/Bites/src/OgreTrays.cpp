@@ -1555,6 +1555,13 @@ void TrayManager::showFrameStats(TrayLocation trayLoc, size_t place)
         stats.push_back("Worst FPS");
         stats.push_back("Triangles");
         stats.push_back("Batches");
+        stats.push_back("Passes");
+        stats.push_back("Program Binds");
+        stats.push_back("Texture Binds");
+        stats.push_back("Constants KB");
+        stats.push_back("Buffer Locks");
+        stats.push_back("Locked KB");
+        stats.push_back("Render ms");
 
         mFpsLabel = createLabel(TL_NONE, mName + "/FpsLabel", "FPS:", 180);
         mFpsLabel->_assignListener(this);
@@ -1968,6 +1975,19 @@ void TrayManager::frameRendered(const Ogre::FrameEvent &evt)
             str = Ogre::StringConverter::toString(stats.batchCount);
             values.push_back(str);
 
+            // CPU side counters of the whole last frame, not only of this window
+            const Ogre::RenderSystem::FrameStatistics& fs = Ogre::Root::getSingleton().getFrameStatistics();
+            values.push_back(Ogre::StringConverter::toString(fs.passChanges));
+            values.push_back(Ogre::StringConverter::toString(fs.programBinds));
+            values.push_back(Ogre::StringConverter::toString(fs.textureBinds));
+            values.push_back(Ogre::StringConverter::toString(fs.constantBytesUploaded / 1024));
+            values.push_back(Ogre::StringConverter::toString(fs.getTotalBufferLocks()));
+            values.push_back(Ogre::StringConverter::toString(fs.getTotalBufferBytesLocked() / 1024));
+
+            oss.str("");
+            oss << std::fixed << std::setprecision(2) << fs.renderVisibleObjectsTime / 1000.0f;
+            values.push_back(oss.str());
+
             mStatsPanel->setAllParamValues(values);
         }
     }
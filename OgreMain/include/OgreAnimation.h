@@ -500,6 +500,14 @@ namespace Ogre {
         
         /// Internal method to adjust keyframes relative to a base keyframe (@see setUseBaseKeyFrame) */
         void _applyBaseKeyFrame();
+
+        /** Internal method which builds the data that is otherwise built on
+            demand when the animation is applied.
+        @remarks
+            Animations are shared by all instances of a skeleton, so this must be
+            called before the animation is applied to several of them concurrently.
+        */
+        void _prepareConcurrentApply(void);
         
         void _notifyContainer(AnimationContainer* c);
         /** Retrieve the container of this animation. */
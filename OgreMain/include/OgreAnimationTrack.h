@@ -384,6 +384,13 @@ namespace Ogre
         NodeAnimationTrack* _clone(Animation* newParent) const;
         
         void _applyBaseKeyFrame(const KeyFrame* base);
+
+        /// Build the splines now if they need to be, rather than when first interpolating
+        void _buildInterpolationSplines(void) const
+        {
+            if (mSplineBuildNeeded)
+                buildInterpolationSplines();
+        }
         
     protected:
         /// Specialised keyframe creation
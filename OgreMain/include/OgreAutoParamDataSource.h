@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreCommon.h"
 #include "OgreLight.h"
+#include "OgreAtomicScalar.h"
 
 namespace Ogre {
 
@@ -123,6 +124,22 @@ namespace Ogre {
         const VisibleObjectsBoundsInfo* mMainCamBoundsInfo;
         const Pass* mCurrentPass;
 
+        /// Versions of the GPV_GLOBAL, GPV_PER_OBJECT and GPV_LIGHTS data, see getVersion
+        uint64 mGlobalVersion;
+        uint64 mPerObjectVersion;
+        uint64 mLightsVersion;
+        /// Hash of the light list the GPV_LIGHTS version was assigned for
+        uint32 mCurrentLightListHash;
+        /// Whether the current renderable overrides the view / projection matrix
+        bool mUseIdentityView;
+        bool mUseIdentityProjection;
+        /// Source of the versions, shared by all instances so versions are never reused,
+        /// also when they are used on different threads
+        static AtomicScalar<uint64> msVersionCounter;
+
+        /// Assigns new versions to the data of all categories in the given GpuParamVariability mask
+        void markChanged(uint16 variability);
+
         Light mBlankLight;
     public:
         AutoParamDataSource();
@@ -149,6 +166,21 @@ namespace Ogre {
         /** Sets the current pass */
         void setCurrentPass(const Pass* pass);
 
+        /** Gets a number identifying the current state of the data of the given category.
+        @remarks
+            The number changes whenever any information that auto constants of this
+            GpuParamVariability are derived from is changed, while the current pass and
+            pass number are tracked separately. As numbers are never reused, even across
+            different data sources, GpuProgramParameters can compare them to skip
+            updating constants that are still up to date.
+        @param variability One of GPV_GLOBAL, GPV_PER_OBJECT or GPV_LIGHTS
+        */
+        uint64 getVersion(GpuParamVariability variability) const
+        {
+            return variability == GPV_GLOBAL ? mGlobalVersion
+                : variability == GPV_PER_OBJECT ? mPerObjectVersion : mLightsVersion;
+        }
+
 		/** Returns the current bounded camera */
 		const Camera* getCurrentCamera() const;
 
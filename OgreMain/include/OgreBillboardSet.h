@@ -575,6 +575,13 @@ namespace Ogre {
         */
         virtual void _updateRenderQueue(RenderQueue* queue);
 
+        /** Overridden from MovableObject
+        @remarks
+            Only while the billboard geometry does not have to be rebuilt, as that
+            locks the vertex buffer.
+        */
+        bool _supportsParallelRenderQueueUpdate(void) const;
+
         /** Overridden from MovableObject
         @see
             MovableObject
@@ -591,6 +591,13 @@ namespace Ogre {
 
         /// @copydoc Frustum::isVisible(const AxisAlignedBox&, FrustumPlane*) const
         bool isVisible(const AxisAlignedBox& bound, FrustumPlane* culledBy = 0) const;
+        /** @copydoc Frustum::areVisible
+        @note
+            This tests the boxes using SIMD instructions, so subclasses overriding
+            isVisible for boxes must override this too.
+        */
+        void areVisible(const AxisAlignedBox* const* bounds, size_t numBounds,
+            char* visibilities) const;
         /// @copydoc Frustum::isVisible(const Sphere&, FrustumPlane*) const
         bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const;
         /// @copydoc Frustum::isVisible(const Vector3&, FrustumPlane*) const
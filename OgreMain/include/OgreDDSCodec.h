@@ -39,15 +39,14 @@ namespace Ogre {
     *  @{
     */
 
-    // Forward declarations
-    struct DXTColourBlock;
-    struct DXTExplicitAlphaBlock;
-    struct DXTInterpolatedAlphaBlock;
-
     /** Codec specialized in loading DDS (Direct Draw Surface) images.
     @remarks
         We implement our own codec here since we need to be able to keep DXT
-        data compressed if the card supports it.
+        data compressed if the card supports it. Otherwise, or without a render
+        system, the DXT, BC4, BC5, BC6H and BC7 formats are decompressed in
+        software, using all threads of the Root TaskScheduler for large images.
+        The block compressed formats Image::compress produces are written as
+        they are.
     */
     class _OgreExport DDSCodec : public ImageCodec
     {
@@ -59,16 +58,11 @@ namespace Ogre {
 
         PixelFormat convertFourCCFormat(uint32 fourcc) const;
         PixelFormat convertDXToOgreFormat(uint32 fourcc) const;
+        uint32 convertOgreToFourCCFormat(PixelFormat format) const;
+        uint32 convertOgreToDXFormat(PixelFormat format) const;
         PixelFormat convertPixelFormat(uint32 rgbBits, uint32 rMask,
             uint32 gMask, uint32 bMask, uint32 aMask) const;
 
-        /// Unpack DXT colours into array of 16 colour values
-        void unpackDXTColour(PixelFormat pf, const DXTColourBlock& block, ColourValue* pCol) const;
-        /// Unpack DXT alphas into array of 16 colour values
-        void unpackDXTAlpha(const DXTExplicitAlphaBlock& block, ColourValue* pCol) const;
-        /// Unpack DXT alphas into array of 16 colour values
-        void unpackDXTAlpha(const DXTInterpolatedAlphaBlock& block, ColourValue* pCol) const;
-
         /// Single registered codec instance
         static DDSCodec* msInstance;
     public:
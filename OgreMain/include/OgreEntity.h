@@ -200,6 +200,10 @@ namespace Ogre {
         /// Perform all the updates required for an animated entity.
         void updateAnimation(void);
 
+        struct PendingAnimationUpdate;
+        /// Work left between the phases of an animation update, created on demand
+        std::unique_ptr<PendingAnimationUpdate> mPendingAnimationUpdate;
+
         /// Records the last frame in which the bones was updated.
         /// It's a pointer because it can be shared between different entities with
         /// a shared skeleton.
@@ -443,6 +447,12 @@ namespace Ogre {
         */
         void _updateRenderQueue(RenderQueue* queue);
 
+        /** @copydoc MovableObject::_supportsParallelRenderQueueUpdate
+        @remarks
+            Not for animated entities, as queueing them updates the animation.
+        */
+        bool _supportsParallelRenderQueueUpdate(void) const;
+
         /** @copydoc MovableObject::getMovableType */
         const String& getMovableType(void) const;
 
@@ -741,6 +751,34 @@ namespace Ogre {
         */
         void _updateAnimation(void);
 
+        /** Internal method which does the first phase of an animation update
+            split into phases, so several entities can be animated in parallel.
+        @remarks
+            The phases together do the same as _updateAnimation. This one must be
+            called on the main thread; it applies vertex animation, checks out
+            the temporary blend buffers and locks the buffers for software
+            skinning into the given set, which must be kept locked until
+            _executeAnimationUpdate has been called.
+        @return
+            Whether there is anything to do for _executeAnimationUpdate.
+        */
+        bool _prepareAnimationUpdate(HardwareBufferLockSet& locks);
+
+        /** Internal method which derives the bone matrices and does the software
+            skinning of an animation update, see _prepareAnimationUpdate.
+        @remarks
+            May be called on any thread, but not concurrently for entities sharing
+            a skeleton instance.
+        */
+        void _executeAnimationUpdate(void);
+
+        /** Internal method which updates the objects attached to the bones once
+            the animation update is done, see _prepareAnimationUpdate.
+        @remarks
+            Must be called on the main thread, after the buffers have been unlocked.
+        */
+        void _finishAnimationUpdate(void);
+
         /** Tests if any animation applied to this entity.
         @remarks
             An entity is animated if any animation state is enabled, or any manual bone
@@ -67,6 +67,19 @@ namespace Ogre {
 
         /// Get whether hidden files are ignored during filesystem enumeration.
         static bool getIgnoreHidden();
+
+        /** Set whether files opened read-only are memory mapped instead of being read
+            through a file stream. The default is false.
+        @remarks
+            The returned streams are MemoryDataStream instances then, so their contents
+            can be accessed in place through MemoryDataStream::getPtr and are not copied
+            into RAM again by the mesh and script loaders. Files must not be truncated
+            while such a stream is open.
+        */
+        static void setUseMemoryMapping(bool use);
+
+        /// Get whether files opened read-only are memory mapped.
+        static bool getUseMemoryMapping();
     };
 
     class APKFileSystemArchiveFactory : public ArchiveFactory
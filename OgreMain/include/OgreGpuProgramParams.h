@@ -1566,6 +1566,14 @@ namespace Ogre {
         bool mIgnoreMissingParams;
         /// physical index for active pass iteration parameter real constant entry;
         size_t mActivePassIterationIndex;
+        /// AutoParamDataSource versions of the GPV_GLOBAL, GPV_PER_OBJECT and GPV_LIGHTS autos
+        uint64 mAutoParamVersions[3];
+        /// Pass and pass number the GPV_GLOBAL autos were last updated for
+        const Pass* mAutoParamPass;
+        int mAutoParamPassNumber;
+
+        /// Forget which AutoParamDataSource state the autos are up to date with
+        void invalidateAutoParamVersions(void);
 
         /// Return the variability for an auto constant
         uint16 deriveVariability(AutoConstantType act);
@@ -2106,6 +2114,9 @@ namespace Ogre {
         const AutoConstantEntry* _findRawAutoConstantEntryBool(size_t physicalIndex) const;
 
         /** Update automatic parameters.
+            @remarks
+                Autos of a GpuParamVariability whose data did not change since they were last
+                updated from the source are skipped, see AutoParamDataSource::getVersion.
             @param source The source of the parameters
             @param variabilityMask A mask of GpuParamVariability which identifies which autos will need updating
         */
@@ -222,7 +222,10 @@ namespace Ogre {
                         "Lock request out of bounds.",
                         "HardwareBuffer::lock");
                 }
-                else if (mUseShadowBuffer)
+
+                _notifyLocked(options, length);
+
+                if (mUseShadowBuffer)
                 {
                     if (options != HBL_READ_ONLY)
                     {
@@ -249,6 +252,21 @@ namespace Ogre {
             {
                 return this->lock(0, mSizeInBytes, options);
             }
+
+            /** Records a lock in the global lock statistics.
+            @remarks
+                This is done by lock() itself. Subclasses that override lock() without
+                forwarding to the base implementation should call this so the lock
+                shows up in RenderSystem::FrameStatistics.
+            */
+            static void _notifyLocked(LockOptions options, size_t length);
+
+            /** Retrieves the number of locks and locked bytes per LockOptions
+                since the last call and resets the counters.
+            @param counts array of HBL_WRITE_ONLY + 1 entries receiving the lock counts
+            @param bytes array of HBL_WRITE_ONLY + 1 entries receiving the locked bytes
+            */
+            static void _collectLockStatistics(size_t* counts, size_t* bytes);
             /** Releases the lock on this buffer. 
             @remarks 
                 Locking and unlocking a buffer can, in some rare circumstances such as 
@@ -402,6 +420,50 @@ namespace Ogre {
         const T& pBuf;
         void* pData;
     };
+
+    /** Keeps several buffers locked until unlockAll is called, locking each
+        buffer only once however often it is requested.
+    @remarks
+        This allows a batch of operations which share source buffers to be
+        executed concurrently on the locked memory. The buffers must still be
+        locked and unlocked on a single thread.
+    */
+    class HardwareBufferLockSet
+    {
+    public:
+        HardwareBufferLockSet() {}
+        ~HardwareBufferLockSet() { unlockAll(); }
+
+        /** Lock a buffer, or return the memory it was locked to before.
+        @remarks
+            The options are only used by the first lock of a buffer.
+        */
+        void* lock(HardwareBuffer* buf, HardwareBuffer::LockOptions options)
+        {
+            LockMap::iterator i = mLocks.find(buf);
+            if (i != mLocks.end())
+                return i->second;
+
+            void* pData = buf->lock(options);
+            mLocks[buf] = pData;
+            return pData;
+        }
+
+        /// Unlock all buffers
+        void unlockAll(void)
+        {
+            for (LockMap::iterator i = mLocks.begin(); i != mLocks.end(); ++i)
+                i->first->unlock();
+            mLocks.clear();
+        }
+
+    private:
+        HardwareBufferLockSet(const HardwareBufferLockSet&);
+        HardwareBufferLockSet& operator=(const HardwareBufferLockSet&);
+
+        typedef map<HardwareBuffer*, void*>::type LockMap;
+        LockMap mLocks;
+    };
 }
 #endif
 
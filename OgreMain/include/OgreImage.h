@@ -397,19 +397,68 @@ namespace Ogre {
             FILTER_BILINEAR,
             FILTER_BOX,
             FILTER_TRIANGLE,
-            FILTER_BICUBIC
+            FILTER_BICUBIC,
+            /// Lanczos windowed sinc, 3 lobes
+            FILTER_LANCZOS,
+            /// Kaiser windowed sinc, 3 lobes
+            FILTER_KAISER
         };
         /** Scale a 1D, 2D or 3D image volume. 
             @param  src         PixelBox containing the source pointer, dimensions and format
             @param  dst         PixelBox containing the destination pointer, dimensions and format
             @param  filter      Which filter to use
+            @param  gammaCorrected Whether the pixels are sRGB encoded and should be
+                                filtered in linear colour space
             @remarks    This function can do pixel format conversion in the process.
+                FILTER_BOX, FILTER_TRIANGLE, FILTER_BICUBIC, FILTER_LANCZOS and
+                FILTER_KAISER are separable filters which are widened when
+                minifying, so every source pixel contributes. Large boxes are
+                split into rows scaled on the threads of the Root TaskScheduler.
             @note   dst and src can point to the same PixelBox object without any problem
         */
-        static void scale(const PixelBox &src, const PixelBox &dst, Filter filter = FILTER_BILINEAR);
+        static void scale(const PixelBox &src, const PixelBox &dst, Filter filter = FILTER_BILINEAR,
+                          bool gammaCorrected = false);
         
         /** Resize a 2D image, applying the appropriate filter. */
         void resize(ushort width, ushort height, Filter filter = FILTER_BILINEAR);
+
+        /** Generate the whole mipmap chain down to 1x1x1 from the top level.
+            @param  gammaCorrected Whether the pixels are sRGB encoded and should be
+                                filtered in linear colour space
+            @param  filter      Which filter to use
+            @remarks Replaces any existing mipmaps, of every face. The image
+                takes ownership of the new buffer. 8 bit formats box filtered
+                without gamma correction are filtered from the previous level
+                directly, all other combinations filter in floating point from
+                the previous level, so the chain is only quantised once per level.
+            @return false if the pixel format is compressed or not accessible
+        */
+        bool generateMipmaps(bool gammaCorrected = false, Filter filter = FILTER_BOX);
+
+        /// Trade-off between speed and quality of compress
+        enum CompressionQuality
+        {
+            /// Endpoints from the bounding box of every block
+            CQ_FAST,
+            /// Endpoints along the principal axis of every block, refined once
+            CQ_NORMAL,
+            /// Endpoints refined several times, BC7 also tries 2 subset partitions
+            CQ_BEST
+        };
+        /** Compress every face and mipmap to a block compressed format.
+            @param  format      PF_DXT1, PF_DXT3, PF_DXT5, PF_BC4_UNORM, PF_BC5_UNORM
+                                or PF_BC7_UNORM
+            @param  quality     Trade-off between speed and quality
+            @remarks The pixels are converted to PF_BYTE_RGBA and encoded in
+                blocks of 4x4. PF_DXT1 stores pixels with alpha below 0.5 as
+                transparent black, PF_BC4_UNORM keeps red, PF_BC5_UNORM red and
+                green. Large levels are split into rows of blocks compressed on
+                the threads of the Root TaskScheduler. The image takes
+                ownership of the new buffer.
+            @return false if the format can not be encoded, or the pixel format
+                of the image is compressed or not accessible
+        */
+        bool compress(PixelFormat format, CompressionQuality quality = CQ_NORMAL);
         
         /// Static function to calculate size in bytes from the number of mipmaps, faces and the dimensions
         static size_t calculateSize(size_t mipmaps, size_t faces, uint32 width, uint32 height, uint32 depth, PixelFormat format);
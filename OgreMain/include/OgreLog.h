@@ -107,6 +107,9 @@ namespace Ogre {
 
         typedef vector<LogListener*>::type mtLogListener;
         mtLogListener mListeners;
+
+        /// Serialises messages from worker threads, even without OGRE_AUTO_MUTEX
+        OGRE_WQ_MUTEX(mMessageMutex);
     public:
 
         class Stream;
@@ -820,6 +820,51 @@ namespace Ogre {
             const Affine3* const* blendMatrices, size_t numMatrices,
             bool blendNormals);
 
+        /** Locked source and target data of a software vertex blend.
+        @see lockForSoftwareVertexBlend
+        */
+        struct SoftwareBlendData
+        {
+            const float* srcPos;
+            const float* srcNorm;
+            float* destPos;
+            float* destNorm;
+            const float* blendWeight;
+            const unsigned char* blendIdx;
+            size_t srcPosStride;
+            size_t srcNormStride;
+            size_t destPosStride;
+            size_t destNormStride;
+            size_t blendWeightStride;
+            size_t blendIdxStride;
+            size_t numWeightsPerVertex;
+            size_t vertexCount;
+        };
+
+        /** Locks the buffers of a software vertex blend, so it can be performed
+            later and on any thread.
+        @remarks
+            Buffers shared by several blends, such as the source data of entities
+            using the same mesh, are locked only once, so the blends can be
+            performed concurrently. The parameters are the same as for
+            softwareVertexBlend.
+        @param locks
+            Keeps the buffers locked until the blend has been performed.
+        @param blendData
+            Receives the locked data to be passed to softwareVertexBlend.
+        */
+        static void lockForSoftwareVertexBlend(const VertexData* sourceVertexData,
+            const VertexData* targetVertexData, bool blendNormals,
+            HardwareBufferLockSet& locks, SoftwareBlendData& blendData);
+
+        /** Performs a software indexed vertex blend on data locked by
+            lockForSoftwareVertexBlend.
+        @remarks
+            This only touches the locked memory, so it may be called on any thread.
+        */
+        static void softwareVertexBlend(const SoftwareBlendData& blendData,
+            const Affine3* const* blendMatrices);
+
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
         @remarks
@@ -429,6 +429,14 @@ namespace Ogre {
         /** @see ManualResourceLoader::loadResource */
         void loadResource(Resource* res);
 
+        /** Gets the buffer manager meshes use when there is no HardwareBufferManager, i.e.
+            no RenderSystem was initialised.
+        @remarks
+            It keeps the vertex and index data in system memory only, so tools can load
+            and process meshes without creating any hardware buffers.
+        */
+        HardwareBufferManagerBase* _getDataOnlyBufferManager();
+
     protected:
         /// @copydoc ResourceManager::createImpl
         Resource* createImpl(const String& name, ResourceHandle handle, 
@@ -496,6 +504,9 @@ namespace Ogre {
 
         // The listener to pass to serializers
         MeshSerializerListener *mListener;
+
+        // Created on demand, see _getDataOnlyBufferManager
+        HardwareBufferManagerBase* mDataOnlyBufferManager;
     };
 
     /** @} */
@@ -272,6 +272,17 @@ namespace Ogre {
         */
         virtual void _updateRenderQueue(RenderQueue* queue) = 0;
 
+        /** Whether _notifyCurrentCamera and _updateRenderQueue may currently be called on
+            a worker thread, concurrently with other objects.
+        @remarks
+            The SceneManager then queues the object into a staging RenderQueue, see
+            SceneManager::setParallelRenderQueueUpdate. Implementations returning true must
+            only modify state of their own in those methods, must not lock hardware buffers
+            and must not call any listeners. The default is false, so the object is always
+            queued on the thread rendering the scene.
+        */
+        virtual bool _supportsParallelRenderQueueUpdate(void) const { return false; }
+
         /** Tells this object whether to be visible or not, if it has a renderable component. 
         @note An alternative approach of making an object invisible is to detach it
             from it's SceneNode, or to remove the SceneNode entirely. 
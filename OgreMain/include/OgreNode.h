@@ -70,6 +70,12 @@ namespace Ogre {
         typedef vector<Node*>::type ChildNodeMap;
         typedef VectorIterator<ChildNodeMap> ChildNodeIterator;
         typedef ConstVectorIterator<ChildNodeMap> ConstChildNodeIterator;
+        /// Nodes still to be updated, each with the parentHasChanged flag to pass to _update
+        typedef vector<std::pair<Node*, bool> >::type PendingUpdateList;
+        /** Deferred listener calls: Listener::nodeUpdated of the node, or
+            MovableObject::Listener::objectMoved if the object is set
+        */
+        typedef vector<std::pair<const Node*, MovableObject*> >::type UpdatedNodeList;
 
         /** Listener which gets called back on Node events.
         */
@@ -568,6 +574,17 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /** Internal method to update the Node without cascading to its children.
+        @remarks
+            Does the same for this node as _update(true, parentHasChanged), except that
+            the children which would have been updated are appended to @c children
+            instead, together with the parentHasChanged flag they would have received.
+            This allows a SceneManager to split the graph into independent subtrees.
+            Any bounds depending on the children must be updated by the caller once
+            they are done.
+        */
+        void _updateAndCollectChildren(bool parentHasChanged, PendingUpdateList& children);
+
         /** Sets a listener for this Node.
         @remarks
             Note for size and performance reasons only one listener per node is
@@ -661,6 +678,23 @@ namespace Ogre {
         /** Process queued 'needUpdate' calls. */
         static void processQueuedUpdates(void);
 
+        /** Defer Listener::nodeUpdated and MovableObject::Listener::objectMoved
+            calls made on the calling thread.
+        @remarks
+            While set, nodes updated and objects moved on this thread are appended
+            to the given list instead of notifying their listener, so that the
+            listeners can be called later on the main thread. Pass 0 to go back to
+            immediate notification. This is used by SceneManager when updating the
+            scene graph in parallel.
+        */
+        static void _setDeferredListenerQueue(UpdatedNodeList* queue);
+
+        /** Append a listener call to the queue of the calling thread, see
+            _setDeferredListenerQueue.
+        @return false if calls are not deferred on this thread, and should be made now
+        */
+        static bool _deferListenerCall(const Node* node, MovableObject* object = 0);
+
 
         /** @deprecated use UserObjectBindings::setUserAny via getUserObjectBindings() instead.
             Sets any kind of user value on this object.
@@ -72,6 +72,19 @@ namespace Ogre {
         */
         static OptimisedUtil* getImplementation(void) { return msImplementation; }
 
+        /** Gets all the implementations which can run on the current machine.
+        @remarks
+            The general implementation always comes first, followed by the
+            SIMD implementations supported by the run-time CPU, from the
+            narrowest to the widest vector width. This is meant for
+            validating and benchmarking the implementations against each
+            other, the engine itself always uses getImplementation().
+        */
+        static const vector<OptimisedUtil*>::type& getAvailableImplementations(void);
+
+        /// Gets the name of the instruction set used by this implementation, e.g. "SSE"
+        virtual const char* getName(void) const = 0;
+
         /** Performs software vertex skinning.
         @param srcPosPtr Pointer to source position buffer.
         @param destPosPtr Pointer to destination position buffer.
@@ -203,6 +216,32 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Test axis aligned boxes against a set of planes, in the way
+            Frustum::isVisible does.
+        @remarks
+            A box is culled if it is entirely on the negative side of any of
+            the planes, and visible otherwise. Null and infinite boxes must be
+            handled by the caller.
+        @param planes The planes to test against, which usually are the
+            frustum planes.
+        @param numPlanes Number of planes to test against.
+        @param boxes The boxes in structure-of-arrays layout: for each block
+            of 4 boxes, 4 centre x, 4 centre y, 4 centre z, 4 half size x,
+            4 half size y and 4 half size z values, 24 floats per block in
+            total. The last block must be complete even if numBoxes is not a
+            multiple of 4. This array must be aligned to SIMD alignment.
+        @param visibilities An array of flags to store the results, the flag
+            is true if the corresponding box is visible, false if it was culled.
+            This array no alignment requires.
+        @param numBoxes Number of boxes to test.
+        */
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
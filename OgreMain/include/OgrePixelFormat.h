@@ -645,9 +645,45 @@ namespace Ogre {
             @param  dst         PixelBox containing the destination pixels, pitches and format
             @remarks The source and destination boxes must have the same
             dimensions. In case the source and destination format match, a plain copy is done.
+            @par
+                Conversions between formats with 8 bit channels, from those to
+                and from PF_FLOAT32_R, PF_FLOAT32_GR, PF_FLOAT32_RGB and
+                PF_FLOAT32_RGBA, and between the 16 and 32 bit float formats
+                use SIMD row kernels where the CPU supports them. The results
+                are the same as converting every pixel with unpackColour and
+                packColour.
+            @par
+                The DXT, BC4, BC5, BC6H and BC7 formats can be decompressed to
+                any uncompressed format if the source box starts at its first
+                block. Large boxes are decoded on the threads of the Root
+                TaskScheduler. Other conversions from or to compressed formats
+                throw ERR_NOT_IMPLEMENTED.
         */
         static void bulkPixelConversion(const PixelBox &src, const PixelBox &dst);
 
+        /** Convert pixels from sRGB to linear colour space.
+            @param  src         PixelBox containing the sRGB encoded source pixels
+            @param  dst         PixelBox receiving the linear pixels
+            @remarks The source and destination boxes must have the same
+            dimensions. The colour channels are decoded with the sRGB transfer
+            function, alpha is copied unchanged. Formats with 8 bit channels
+            converted to PF_FLOAT32_RGB or PF_FLOAT32_RGBA use a lookup table,
+            other formats are converted per pixel.
+        */
+        static void convertSRGBToLinear(const PixelBox &src, const PixelBox &dst);
+
+        /** Convert pixels from linear to sRGB colour space.
+            @param  src         PixelBox containing the linear source pixels
+            @param  dst         PixelBox receiving the sRGB encoded pixels
+            @remarks The source and destination boxes must have the same
+            dimensions. The colour channels are encoded with the sRGB transfer
+            function, alpha is copied unchanged. PF_FLOAT32_RGB and
+            PF_FLOAT32_RGBA converted to formats with 8 bit channels are
+            exactly rounded using lookup tables, other formats are converted
+            per pixel.
+        */
+        static void convertLinearToSRGB(const PixelBox &src, const PixelBox &dst);
+
         /** Flips pixels inplace in vertical direction.
             @param  box         PixelBox containing pixels, pitches and format
             @remarks Non consecutive pixel boxes are supported.
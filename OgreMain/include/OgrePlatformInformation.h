@@ -98,6 +98,28 @@ namespace Ogre {
 #   define __OGRE_HAVE_VFP  0
 #endif
 
+/* Define whether or not Ogre compiled with the AVX2 and AVX-512 routines.
+   These are built per function, so the rest of Ogre doesn't require such a
+   CPU, and only selected at run-time if the CPU and OS support them.
+*/
+#if __OGRE_HAVE_SSE && OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64 && \
+    (OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_GNUC, 490) || OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_CLANG, 380) || OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_MSVC, 1800))
+#   define __OGRE_HAVE_AVX2  1
+#endif
+
+#if __OGRE_HAVE_SSE && OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64 && \
+    (OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_GNUC, 490) || OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_CLANG, 380) || OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_MSVC, 1911))
+#   define __OGRE_HAVE_AVX512  1
+#endif
+
+#ifndef __OGRE_HAVE_AVX2
+#   define __OGRE_HAVE_AVX2  0
+#endif
+
+#ifndef __OGRE_HAVE_AVX512
+#   define __OGRE_HAVE_AVX512  0
+#endif
+
 #ifndef __OGRE_HAVE_NEON
 #   define __OGRE_HAVE_NEON  0
 #endif
@@ -150,6 +172,11 @@ namespace Ogre {
             CPU_FEATURE_FPU             = 1 << 12,
             CPU_FEATURE_PRO             = 1 << 13,
             CPU_FEATURE_HTT             = 1 << 14,
+            CPU_FEATURE_AVX             = 1 << 18,
+            CPU_FEATURE_AVX2            = 1 << 19,
+            CPU_FEATURE_FMA             = 1 << 20,
+            CPU_FEATURE_AVX512F         = 1 << 21,
+            CPU_FEATURE_SSSE3           = 1 << 22,
 #elif OGRE_CPU == OGRE_CPU_ARM          
             CPU_FEATURE_VFP             = 1 << 15,
             CPU_FEATURE_NEON            = 1 << 16,
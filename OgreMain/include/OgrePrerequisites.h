@@ -118,6 +118,7 @@ namespace Ogre {
     class GpuProgram;
     class GpuProgramManager;
     class GpuProgramUsage;
+    class HardwareBufferLockSet;
     class HardwareCounterBuffer;
     class HardwareIndexBuffer;
     class HardwareOcclusionQuery;
@@ -259,6 +260,7 @@ namespace Ogre {
     class VertexMorphKeyFrame;
     class WireBoundingBox;
     class WorkQueue;
+    class TaskScheduler;
     class Compositor;
     class CompositorManager;
     class CompositorChain;
@@ -131,6 +131,26 @@ namespace Ogre {
             virtual bool renderableQueued(Renderable* rend, uint8 groupID, 
                 ushort priority, Technique** ppTech, RenderQueue* pQueue) = 0;
         };
+
+        /// A Renderable recorded by a staging queue, see _setStaging
+        struct StagedRenderable
+        {
+            Renderable* renderable;
+            uint8 groupID;
+            ushort priority;
+        };
+        typedef vector<StagedRenderable>::type StagedRenderableList;
+
+        /// Outcome of stageVisibleObject, to be passed on to mergeStagedObject
+        enum StagedObjectState
+        {
+            /// the object is not visible and did not queue anything
+            SOS_HIDDEN,
+            /// the object queued its renderables
+            SOS_QUEUED,
+            /// the object is visible, but only shadow casters were wanted
+            SOS_NOT_CASTER
+        };
     protected:
         RenderQueueGroupMap mGroups;
         /// The current default queue group
@@ -141,8 +161,13 @@ namespace Ogre {
         bool mSplitPassesByLightingType;
         bool mSplitNoShadowPasses;
         bool mShadowCastersCannotBeReceivers;
+        bool mSortKeysEnabled;
 
         RenderableListener* mRenderableListener;
+
+        /// Whether addRenderable records into mStagedRenderables
+        bool mStaging;
+        StagedRenderableList mStagedRenderables;
     public:
         RenderQueue();
         virtual ~RenderQueue();
@@ -275,6 +300,20 @@ namespace Ogre {
         */
         bool getShadowCastersCannotBeReceivers(void) const;
 
+        /** Sets whether the renderables are ordered by sorting on packed 64-bit keys.
+        @remarks
+            Instead of grouping solids by inserting them into a map of passes and
+            sorting transparents twice, each collection is ordered by a single
+            radix sort of a flat list, on a key packing the pass hash and the view
+            depth. This reduces the sorting cost in scenes with many renderables,
+            and issues the solids sharing a pass front to back. It is off by default.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
+        /** Gets whether the renderables are ordered by sorting on packed 64-bit keys. */
+        bool getSortKeysEnabled(void) const;
+
         /** Set a renderable listener on the queue.
         @remarks
             There can only be a single renderable listener on the queue, since
@@ -299,6 +338,53 @@ namespace Ogre {
             bool onlyShadowCasters, 
             VisibleObjectsBoundsInfo* visibleBounds);
 
+        /** Sets whether this queue only records the renderables added to it.
+        @remarks
+            A staging queue does not sort the renderables into its groups, it only
+            appends them to a list, without touching their materials or calling the
+            RenderableListener. That allows several staging queues to be filled
+            concurrently, e.g. one per worker thread, and their contents to be added to
+            the actual queue on the thread owning it in a deterministic order.
+            Changing the mode discards all renderables staged so far.
+        */
+        void _setStaging(bool staging);
+        /// Whether this is a staging queue, see _setStaging
+        bool _isStaging(void) const { return mStaging; }
+        /// The renderables recorded by a staging queue, in the order they were added
+        const StagedRenderableList& _getStagedRenderables(void) const { return mStagedRenderables; }
+
+        /** Staging counterpart of processVisibleObject, may be called on any thread.
+        @remarks
+            Must be called on a staging queue, for objects which support
+            MovableObject::_supportsParallelRenderQueueUpdate. The renderables of the
+            object are appended to the staged renderables. The work touching shared state
+            is left to mergeStagedObject.
+        */
+        StagedObjectState stageVisibleObject(MovableObject* mo, Camera* cam, bool onlyShadowCasters);
+
+        /** Completes the processing of an object staged by stageVisibleObject.
+        @remarks
+            Adds the renderables the object staged to this queue and updates the
+            visible bounds, so calling this for all objects in the order
+            processVisibleObject would have processed them gives the same queue contents.
+        @param mo The object
+        @param state The return value of stageVisibleObject
+        @param begin, end The renderables staged for the object
+        @param cam, onlyShadowCasters, visibleBounds See processVisibleObject. Pass
+            no visibleBounds if mergeStagedBounds already merged the object.
+        */
+        void mergeStagedObject(MovableObject* mo, StagedObjectState state,
+            const StagedRenderable* begin, const StagedRenderable* end,
+            Camera* cam, bool onlyShadowCasters, VisibleObjectsBoundsInfo* visibleBounds);
+
+        /** The visible bounds part of mergeStagedObject, may be called on any thread.
+        @remarks
+            Called on the queue the object is merged into, which is only read, so the
+            bounds of the objects staged by different threads can be merged there and
+            be combined afterwards.
+        */
+        void mergeStagedBounds(MovableObject* mo, StagedObjectState state, Camera* cam,
+            VisibleObjectsBoundsInfo* visibleBounds) const;
     };
 
     /** @} */
@@ -229,17 +229,40 @@ namespace Ogre {
         /// Radix sorter for sort value 2 (distance)
         static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
 
+        /// A RenderablePass with the packed key it is sorted on
+        struct SortKeyedRenderablePass
+        {
+            uint64 key;
+            RenderablePass renderablePass;
+
+            SortKeyedRenderablePass(Renderable* rend, Pass* p) : key(0), renderablePass(rend, p) {}
+        };
+        typedef vector<SortKeyedRenderablePass>::type SortKeyedRenderablePassList;
+
+        /// Scratch area for sorting on packed keys
+        static SortKeyedRenderablePassList msSortKeyScratch;
+
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
+        /// Whether packed sort keys are used instead of the pass map and 2 sort passes
+        bool mSortKeysEnabled;
 
         /// Grouped 
         PassGroupRenderableMap mGrouped;
         /// Sorted descending (can iterate backwards to get ascending)
         RenderablePassList mSortedDescending;
+        /** Grouped by sorting on a key of pass hash and depth, used instead of 
+            mGrouped with sort keys enabled */
+        SortKeyedRenderablePassList mGroupedByKey;
+        /** Sorted descending on a key of depth and pass hash, used instead of
+            mSortedDescending with sort keys enabled */
+        SortKeyedRenderablePassList mSortedDescendingByKey;
 
         /// Internal visitor implementation
         void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
+        void acceptVisitorGroupedByKey(QueuedRenderableVisitor* visitor) const;
+        /// Internal visitor implementation
         void acceptVisitorDescending(QueuedRenderableVisitor* visitor) const;
         /// Internal visitor implementation
         void acceptVisitorAscending(QueuedRenderableVisitor* visitor) const;
@@ -277,6 +300,30 @@ namespace Ogre {
             mOrganisationMode |= om; 
         }
 
+        /** Sets whether the collection is ordered by sorting on packed 64-bit keys.
+        @remarks
+            When enabled, grouping by pass is done by a single radix sort of a 
+            flat list on a key made of the pass hash and the quantised view depth,
+            rather than by inserting into a map of passes. Depth sorting uses a 
+            single radix sort on a key made of the depth and the pass hash rather 
+            than 2 separate sorts. This is cheaper with many renderables, and also
+            orders the renderables sharing a pass front to back.
+        @par
+            Passes whose hashes collide are kept apart by part of their address;
+            should that collide too, the visitor is called again whenever the 
+            Pass changes. You can only do this when the collection is empty.
+        */
+        void setSortKeysEnabled(bool enabled)
+        {
+            mSortKeysEnabled = enabled;
+        }
+
+        /** Gets whether the collection is ordered by sorting on packed 64-bit keys. */
+        bool getSortKeysEnabled(void) const
+        {
+            return mSortKeysEnabled;
+        }
+
         /// Add a renderable to the collection using a given pass
         void addRenderable(Pass* pass, Renderable* rend);
         
@@ -436,6 +483,11 @@ namespace Ogre {
             mSplitNoShadowPasses = split;
         }
 
+        /** Sets whether the collections are ordered by sorting on packed keys.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
         /** Sets whether or not objects which cast shadows should be treated as
             never receiving shadows. 
         */
@@ -476,6 +528,8 @@ namespace Ogre {
         bool mShadowsEnabled;
         /// Bitmask of the organisation modes requested (for new priority groups)
         uint8 mOrganisationMode;
+        /// Whether the priority groups are ordered by sorting on packed keys
+        bool mSortKeysEnabled;
 
 
     public:
@@ -489,6 +543,7 @@ namespace Ogre {
             , mShadowCastersNotReceivers(shadowCastersNotReceivers)
             , mShadowsEnabled(true)
             , mOrganisationMode(0)
+            , mSortKeysEnabled(false)
         {
         }
 
@@ -531,6 +586,7 @@ namespace Ogre {
                     pPriorityGrp->resetOrganisationModes();
                     pPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                 }
+                pPriorityGrp->setSortKeysEnabled(mSortKeysEnabled);
 
                 mPriorityGroups.insert(PriorityMap::value_type(priority, pPriorityGrp));
             }
@@ -625,6 +681,26 @@ namespace Ogre {
                 i->second->setShadowCastersCannotBeReceivers(ind);
             }
         }
+        /** Sets whether the renderables in this group are ordered by sorting on
+            packed 64-bit keys.
+        @remarks
+            You can only do this when the group is empty, ie after clearing the 
+            queue.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled)
+        {
+            mSortKeysEnabled = enabled;
+            PriorityMap::iterator i, iend;
+            iend = mPriorityGroups.end();
+            for (i = mPriorityGroups.begin(); i != iend; ++i)
+            {
+                i->second->setSortKeysEnabled(enabled);
+            }
+        }
+        /** Gets whether the renderables in this group are ordered by sorting on
+            packed 64-bit keys. */
+        bool getSortKeysEnabled(void) const { return mSortKeysEnabled; }
         /** Reset the organisation modes required for the solids in this group. 
         @remarks
             You can only do this when the group is empty, ie after clearing the 
@@ -705,6 +781,7 @@ namespace Ogre {
                         pDstPriorityGrp->resetOrganisationModes();
                         pDstPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                     }
+                    pDstPriorityGrp->setSortKeysEnabled(mSortKeysEnabled);
 
                     mPriorityGroups.insert(PriorityMap::value_type(priority, pDstPriorityGrp));
                 }
@@ -832,6 +832,75 @@ namespace Ogre
         /** Reports the number of vertices passed to the renderer since the last _beginGeometryCount call. */
         virtual unsigned int _getVertexCount(void) const;
 
+        /** CPU side statistics of a complete frame.
+        @remarks
+            Unlike RenderTarget::FrameStats these are accumulated over all render targets
+            updated during a frame. Gathering them costs a few increments per call, so they
+            are always on.
+        @par
+            The SceneManager phase times are in microseconds and include all nested work,
+            e.g. prepareShadowTexturesTime includes rendering the shadow textures.
+        */
+        struct _OgreExport FrameStatistics
+        {
+            /// Number of batches (draw calls) rendered
+            size_t batchCount;
+            /// Number of triangles rendered
+            size_t faceCount;
+            /// Number of vertices passed to the renderer
+            size_t vertexCount;
+            /// Number of Pass changes done by the SceneManager
+            size_t passChanges;
+            /// Number of GPU programs bound
+            size_t programBinds;
+            /// Number of texture units set up
+            size_t textureBinds;
+            /// Number of draw calls using a different VertexDeclaration than the previous one
+            size_t vertexDeclarationChanges;
+            /// Size of the GPU program constants handed to the RenderSystem, in bytes
+            size_t constantBytesUploaded;
+            /// Number of HardwareBuffer locks, indexed by HardwareBuffer::LockOptions
+            size_t bufferLocks[HardwareBuffer::HBL_WRITE_ONLY + 1];
+            /// Bytes locked, indexed by HardwareBuffer::LockOptions
+            size_t bufferBytesLocked[HardwareBuffer::HBL_WRITE_ONLY + 1];
+
+            /// Time spent in SceneManager::_updateSceneGraph
+            unsigned long updateSceneGraphTime;
+            /// Time spent in SceneManager::findLightsAffectingFrustum
+            unsigned long findLightsTime;
+            /// Time spent in SceneManager::prepareShadowTextures
+            unsigned long prepareShadowTexturesTime;
+            /// Time spent in SceneManager::_findVisibleObjects
+            unsigned long findVisibleObjectsTime;
+            /// Time spent in SceneManager::_renderVisibleObjects
+            unsigned long renderVisibleObjectsTime;
+
+            FrameStatistics() { reset(); }
+            /// Sets all values to zero
+            void reset();
+            /// Total number of buffer locks regardless of the lock type
+            size_t getTotalBufferLocks() const;
+            /// Total number of bytes locked regardless of the lock type
+            size_t getTotalBufferBytesLocked() const;
+        };
+
+        /** Returns the statistics of the last completed frame.
+        @see Root::getFrameStatistics
+        */
+        const FrameStatistics& getFrameStatistics() const { return mLastFrameStats; }
+
+        /** Returns the statistics of the frame currently being rendered for accumulation.
+
+            Used by the SceneManager to add its counters.
+        */
+        FrameStatistics& _getCurrentFrameStatistics() { return mFrameStats; }
+
+        /** Completes the statistics of the current frame and starts a new one.
+
+            Called by Root once per frame.
+        */
+        void _finishFrameStatistics();
+
         /** Generates a packed data version of the passed in ColourValue suitable for
         use as with this RenderSystem.
         @remarks
@@ -1372,6 +1441,12 @@ namespace Ogre
         size_t mFaceCount;
         size_t mVertexCount;
 
+        /// statistics of the frame in progress and of the last complete one
+        FrameStatistics mFrameStats;
+        FrameStatistics mLastFrameStats;
+        /// to detect vertex declaration changes
+        const VertexDeclaration* mLastVertexDeclaration;
+
         /// Saved manual colour blends
         ColourValue mManualBlendColours[OGRE_MAX_TEXTURE_LAYERS][2];
 
@@ -218,6 +218,9 @@ namespace Ogre {
         */
         virtual void unloadImpl(void) = 0;
 
+        /// Wait for a parallel preparation of ResourceGroupManager preparing this
+        void waitForParallelPreparation(void);
+
     public:
         /** Standard constructor.
         @param creator Pointer to the ResourceManager that is creating this resource
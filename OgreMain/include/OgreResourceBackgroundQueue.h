@@ -118,7 +118,8 @@ namespace Ogre {
             RT_LOAD_GROUP = 4,
             RT_LOAD_RESOURCE = 5,
             RT_UNLOAD_GROUP = 6,
-            RT_UNLOAD_RESOURCE = 7
+            RT_UNLOAD_RESOURCE = 7,
+            RT_STREAM_TEXTURE = 8
         };
         /** Encapsulates a queued request for the background queue */
         struct ResourceRequest
@@ -133,6 +134,10 @@ namespace Ogre {
             NameValuePairList* loadParams;
             Listener* listener;
             BackgroundProcessResult result;
+            /// The first resident mipmap for RT_STREAM_TEXTURE
+            uint32 mipmap;
+            /// The image read for RT_STREAM_TEXTURE
+            SharedPtr<Image> image;
 
             friend std::ostream& operator<<(std::ostream& o, const ResourceRequest& r)
             { (void)r; return o; }
@@ -298,6 +303,21 @@ namespace Ogre {
             ManualResourceLoader* loader = 0, 
             const NameValuePairList* loadParams = 0, 
             Listener* listener = 0);
+        /** Change the resident mipmaps of a streamed texture in the background.
+        @remarks
+            The source image of the texture is read in the background, and the
+            mipmaps from residentMipmap on are uploaded in the main thread.
+        @see Texture::isStreamed
+        @param handle Handle to the texture
+        @param residentMipmap The first mipmap of the source image to make resident
+        @param listener Optional callback interface, take note of warnings in
+            the header and only use if you understand them.
+        @return Ticket identifying the request, use isProcessComplete() to 
+            determine if completed if not using listener
+        */
+        BackgroundProcessTicket streamTexture(ResourceHandle handle, uint32 residentMipmap,
+                                              Listener* listener = 0);
+
         /** Returns whether a previously queued process has completed or not. 
         @remarks
             This method of checking that a background process has completed is
@@ -433,6 +433,56 @@ namespace Ogre {
 
         /// Stored current group - optimisation for when bulk loading a group
         ResourceGroup* mCurrentGroup;
+
+        /// See setParallelPreparation
+        bool mParallelPreparation;
+        /// Prepares the resources of a group on the TaskScheduler threads
+        class ParallelPreparation;
+        /// The outermost preparation running, see _waitForPreparation
+        ParallelPreparation* mActivePreparation;
+        OGRE_WQ_MUTEX(mPreparationMutex);
+        /// Serialises the lookups and Archive::open of openResource and openScript
+        /// for the tasks of parallel preparation, even without OGRE_AUTO_MUTEX
+        OGRE_WQ_MUTEX(mOpenResourceMutex);
+        /// See setParallelScriptParsing
+        bool mParallelScriptParsing;
+        /// Prepares a script on a TaskScheduler thread
+        class ScriptPrepareTask;
+        /// Prepares the scripts of a group on the TaskScheduler threads
+        class ParallelScriptPreparation;
+        /// Opens a script, copying small files into memory
+        DataStreamPtr openScript(const FileInfo& file, const String& group) const;
+        /// Resources of the group to prepare concurrently, if enabled and possible
+        vector<ResourcePtr>::type collectParallelPreparation(ResourceGroup* grp) const;
+
+        /// Cached listing of a resource location, see setUseResourceIndexCache
+        struct ResourceIndexCacheEntry
+        {
+            ResourceIndexCacheEntry() : validated(false) {}
+
+            typedef vector<std::pair<String, time_t> >::type DirectoryTimeList;
+            /// Modification times of the listed directories, the root being ""
+            DirectoryTimeList directories;
+            /// All files of the location in listing order, without archive
+            FileInfoList files;
+            /// Whether the modification times were checked in this run
+            bool validated;
+        };
+        typedef map<String, ResourceIndexCacheEntry>::type ResourceIndexCache;
+        /// Listings by archive type, name and recursive flag
+        ResourceIndexCache mResourceIndexCache;
+        bool mUseResourceIndexCache;
+        bool mResourceIndexCacheDirty;
+
+        /** Lists all files of a location through the resource index cache,
+            validating or (re)creating its entry.
+        @return the files or a null pointer if the location can not be cached
+        */
+        FileInfoListPtr listCachedResourceIndex(Archive* arch, bool recursive);
+        /** Like findResourceFileInfo, but uses the cached listing of the
+            locations validated in this run.
+        */
+        FileInfoListPtr findIndexedFileInfo(ResourceGroup* grp, const String& pattern) const;
     public:
         ResourceGroupManager();
         virtual ~ResourceGroupManager();
@@ -563,6 +613,68 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
             bool loadWorldGeom = true);
 
+        /** Sets whether prepareResourceGroup and loadResourceGroup prepare the
+            resources of the group concurrently.
+        @remarks
+            Resource::prepare, which does the disk I/O and decoding of e.g. images
+            and meshes, is then started for all resources of the group at once on
+            the threads of Root::getTaskScheduler. The calling thread still goes
+            through the resources in the usual order, waiting for each one to be
+            prepared, and does the Resource::load step, which may use the
+            RenderSystem, itself. The ResourceGroupListener callbacks are fired on
+            the calling thread, in the same order and number as before.
+        @par
+            Only the resources of managers for which
+            ResourceManager::isPrepareThreadSafe is true, i.e. meshes and textures
+            by default, are prepared concurrently, and only those which are not
+            manually loaded and whose file is in their own group. If the preparation
+            of a resource fails, it is repeated on the calling thread, so the
+            exception is thrown in order. With OGRE_THREAD_SUPPORT 1 or 2, preparing
+            locks this manager, so groups are always prepared serially there.
+            The default is false.
+        @par
+            Resource::prepareImpl and the Archive::open of its file are the only
+            code running on the other threads. Resource::Listener::preparingComplete
+            is fired on the calling thread when it reaches the resource, and no
+            ManualResourceLoader is called concurrently. While a
+            ResourceLoadingListener is set, groups are prepared serially, so its
+            callbacks are never called on other threads either.
+        */
+        void setParallelPreparation(bool parallel) { mParallelPreparation = parallel; }
+
+        /// Gets whether resource groups are prepared concurrently
+        bool getParallelPreparation(void) const { return mParallelPreparation; }
+
+        /** Internal method waiting until a resource which a task of a parallel
+            preparation is preparing is done, helping with other tasks meanwhile.
+            Does nothing if no task prepares it.
+        */
+        void _waitForPreparation(Resource* res);
+
+        /** Sets whether initialising a resource group parses its scripts concurrently.
+        @remarks
+            For the ScriptLoaders supporting it, see ScriptLoader::isPrepareScriptThreadSafe,
+            the scripts of the group are then opened and prepared, i.e. lexed, parsed
+            and processed into abstract syntax trees in the case of the
+            ScriptCompilerManager, all at once on the threads of Root::getTaskScheduler.
+            The calling thread still goes through the scripts in the usual order and
+            creates the resources they define itself, so they are created in the same
+            order as before. The ResourceGroupListener callbacks are fired on
+            the calling thread, in the same order and number as before.
+        @par
+            Scripts skipped by a ResourceGroupListener are prepared nevertheless.
+            While a ResourceLoadingListener is set, scripts are parsed serially, so
+            its callbacks are only called on the calling thread. If preparing a
+            script fails, it is parsed again on the calling thread, so the exception
+            is thrown in order. With OGRE_THREAD_SUPPORT 1 or 2, scripts are always
+            parsed serially.
+            The default is false.
+        */
+        void setParallelScriptParsing(bool parallel) { mParallelScriptParsing = parallel; }
+
+        /// Gets whether the scripts of resource groups are parsed concurrently
+        bool getParallelScriptParsing(void) const { return mParallelScriptParsing; }
+
         /** Unloads a resource group.
         @remarks
             This method unloads all the resources that have been declared as
@@ -690,6 +802,42 @@ namespace Ogre {
         bool resourceLocationExists(const String& name, 
             const String& resGroup = DEFAULT_RESOURCE_GROUP_NAME) const;
 
+        /** Sets whether the listings of FileSystem resource locations are kept
+            in the resource index cache.
+        @remarks
+            Listing all files of a location in addResourceLocation, and again for
+            every script pattern in initialiseResourceGroup, can take seconds on
+            network mounted asset directories. With the cache enabled, a location
+            is listed once and its files are taken from the cache afterwards, as
+            long as the modification times of all its listed directories are
+            unchanged. Note that these only change when files are added, removed
+            or renamed, which is all the index depends on.
+        @par
+            Combined with loadResourceIndexCache and saveResourceIndexCache, the
+            listing is skipped entirely on the next run if nothing changed.
+            The default is false.
+        */
+        void setUseResourceIndexCache(bool use) { mUseResourceIndexCache = use; }
+
+        /// Gets whether the resource index cache is used
+        bool getUseResourceIndexCache(void) const { return mUseResourceIndexCache; }
+
+        /** Returns true if the resource index cache changed since it was loaded,
+            i.e. it should be saved again.
+        */
+        bool isResourceIndexCacheDirty(void) const { return mResourceIndexCacheDirty; }
+
+        /** Saves the resource index cache, e.g. to a file on disk. */
+        void saveResourceIndexCache(const DataStreamPtr& stream) const;
+
+        /** Loads the resource index cache saved by saveResourceIndexCache.
+        @remarks
+            Call this before adding the resource locations. The entries are
+            validated when their location is added, an invalid or outdated
+            cache is ignored.
+        */
+        void loadResourceIndexCache(const DataStreamPtr& stream);
+
         /** Declares a resource to be a part of a resource group, allowing you 
             to load and unload it as part of the group.
         @remarks
@@ -482,6 +482,18 @@ namespace Ogre {
         /** Gets whether this manager and its resources habitually produce log output */
         bool getVerbose(void) { return mVerbose; }
 
+        /** Sets whether Resource::prepare of the resources of this manager may run on
+            other threads while further resources are prepared and loaded.
+        @remarks
+            See ResourceGroupManager::setParallelPreparation. This is true for meshes and
+            textures, whose preparation only reads and decodes their files, and false by
+            default otherwise.
+        */
+        void setPrepareThreadSafe(bool safe) { mPrepareThreadSafe = safe; }
+
+        /** Gets whether Resource::prepare of the resources of this manager may run on other threads */
+        bool isPrepareThreadSafe(void) const { return mPrepareThreadSafe; }
+
         /** Definition of a pool of resources, which users can use to reuse similar
             resources many times without destroying and recreating them.
         @remarks
@@ -563,6 +575,7 @@ namespace Ogre {
         AtomicScalar<size_t> mMemoryUsage; /// In bytes
 
         bool mVerbose;
+        bool mPrepareThreadSafe;
 
         // IMPORTANT - all subclasses must populate the fields below
 
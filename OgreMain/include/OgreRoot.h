@@ -84,6 +84,7 @@ namespace Ogre
         std::unique_ptr<DynLibManager> mDynLibManager;
         std::unique_ptr<Timer> mTimer;
         std::unique_ptr<WorkQueue> mWorkQueue;
+        std::unique_ptr<TaskScheduler> mTaskScheduler;
         std::unique_ptr<ResourceGroupManager> mResourceGroupManager;
         std::unique_ptr<ResourceBackgroundQueue> mResourceBackgroundQueue;
         std::unique_ptr<MaterialManager> mMaterialManager;
@@ -204,6 +205,15 @@ namespace Ogre
 
     public:
 
+        /// The WorkQueue implementation created by Root
+        enum WorkQueueType
+        {
+            /// DefaultWorkQueue, a thread pool sharing a single request queue
+            WQT_DEFAULT,
+            /// WorkStealingWorkQueue, per-thread lock-free deques with work stealing
+            WQT_WORK_STEALING
+        };
+
         /** Constructor
         @param pluginFileName The file that contains plugins information.
             Defaults to "plugins.cfg" in release build and to "plugins_d.cfg"
@@ -212,10 +222,13 @@ namespace Ogre
             Defaults to "ogre.cfg", may be left blank to load nothing.
         @param logFileName The logfile to create, defaults to Ogre.log, may be 
             left blank if you've already set up LogManager & Log yourself
+        @param workQueueType The WorkQueue implementation to create, you can
+            still replace it later with setWorkQueue
         */
         Root(const String& pluginFileName = "plugins" OGRE_BUILD_SUFFIX ".cfg", 
             const String& configFileName = "ogre.cfg", 
-            const String& logFileName = "Ogre.log");
+            const String& logFileName = "Ogre.log",
+            WorkQueueType workQueueType = WQT_DEFAULT);
         ~Root();
 
         /** Saves the details of the current configuration
@@ -772,6 +785,14 @@ namespace Ogre
             next frame. */
         unsigned long getNextFrameNumber(void) const { return mNextFrame; }
 
+        /** Returns the CPU side statistics of the last completed frame.
+        @remarks
+            The statistics are gathered by the active RenderSystem and the SceneManagers
+            rendering to it and are completed in _fireFrameEnded.
+        @see RenderSystem::FrameStatistics
+        */
+        const RenderSystem::FrameStatistics& getFrameStatistics() const;
+
         /** Returns the scene manager currently being used to render a frame.
         @remarks
             This is only intended for internal use; it is only valid during the
@@ -924,6 +945,11 @@ namespace Ogre
         */
         WorkQueue* getWorkQueue() const { return mWorkQueue.get(); }
 
+        /** Get the TaskScheduler for splitting engine work into fine grained tasks.
+            It executes the tasks on the worker threads of the WorkQueue.
+        */
+        TaskScheduler* getTaskScheduler() const { return mTaskScheduler.get(); }
+
         /** Replace the current work queue with an alternative. 
             You can use this method to replace the internal implementation of
             WorkQueue with  your own, e.g. to externalise the processing of 
@@ -47,6 +47,7 @@ Torus Knot Software Ltd.
 #include "OgreInstanceManager.h"
 #include "OgreRenderSystem.h"
 #include "OgreLodListener.h"
+#include "OgreTaskScheduler.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreNameGenerator.h"
 
@@ -101,6 +102,8 @@ namespace Ogre {
         */
         void mergeNonRenderedButInFrustum(const AxisAlignedBox& boxBounds, 
             const Sphere& sphereBounds, const Camera* cam);
+        /// Merge the bounds of other visible objects, e.g. collected on another thread
+        void merge(const VisibleObjectsBoundsInfo& other);
 
 
     };
@@ -880,6 +883,62 @@ namespace Ogre {
         uint32 mVisibilityMask;
         bool mFindVisibleObjects;
 
+        /// Whether the scene graph is updated on several threads
+        bool mParallelSceneGraphUpdate;
+        /// Whether the scene graph is culled on several threads
+        bool mParallelCulling;
+        /// Whether animated entities are updated in a batch on several threads
+        bool mParallelAnimation;
+        /// Whether visible objects are queued on several threads during parallel culling
+        bool mParallelRenderQueueUpdate;
+        /// Staging queues of findVisibleObjectsParallel, one per culled subtree
+        typedef vector<RenderQueue*>::type RenderQueueList;
+        RenderQueueList mStagingRenderQueues;
+        /// Number of threads to split parallel work across, 0 for automatic
+        size_t mParallelThreadCount;
+
+        /** Work split into independent items, which the calling thread and the
+            worker threads of the TaskScheduler process together.
+        */
+        class _OgreExport ParallelJob : public TaskScheduler::RangeJob, public SceneMgtAlloc
+        {
+        public:
+            ParallelJob(size_t itemCount) : mItemCount(itemCount) {}
+            void execute(size_t begin, size_t end);
+            size_t getItemCount(void) const { return mItemCount; }
+        protected:
+            /// Execute a single item; may be called on any thread
+            virtual void executeItem(size_t index) = 0;
+        private:
+            size_t mItemCount;
+        };
+        class SceneGraphUpdateJob;
+        class CullingJob;
+        class AnimationJob;
+
+        /** Execute a job on up to getParallelThreadCount() threads, including the
+            calling one, returning once all of its items are done.
+        */
+        void runParallelJob(ParallelJob& job);
+        /// Number of threads runParallelJob will actually use
+        size_t getEffectiveParallelThreadCount(void) const;
+        /** Update the scene graph from the root, splitting it into subtrees which
+            are updated in parallel.
+        */
+        void updateSceneGraphParallel(void);
+        /** Cull the scene graph from the root on several threads, then process
+            the visible objects on the calling thread in the usual order.
+        */
+        void findVisibleObjectsParallel(Camera* cam, VisibleObjectsBoundsInfo* visibleBounds,
+            bool onlyShadowCasters);
+        /** Whether the nodes of this SceneManager can be updated concurrently.
+        @remarks
+            Subclasses whose nodes override Node::_update, or modify shared structures
+            without synchronisation when they are updated, must return false; the scene
+            graph is then always updated serially.
+        */
+        virtual bool supportsParallelSceneGraphUpdate(void) const { return true; }
+
         /// Suppress render state changes?
         bool mSuppressRenderStateChanges;
         /// Suppress shadows?
@@ -1791,6 +1850,19 @@ namespace Ogre {
         */
         void _applySceneAnimations(void);
 
+        /** Internal method for updating the animation of all animated entities
+            visible from a camera in one batch.
+        @remarks
+            The vertex animation and buffer management is done on the calling
+            thread, the bone matrices and the software skinning are then done on
+            several threads, unless the effective thread count is 1. Entities which
+            are not updated here, for example because they are attached to a bone
+            or show a manual LOD level, are still updated when they are queued for
+            rendering.
+        @see setParallelAnimation
+        */
+        void _updateEntityAnimations(Camera* cam);
+
         /** Sends visible objects found in _findVisibleObjects to the rendering engine.
         */
         void _renderVisibleObjects(void);
@@ -3197,6 +3269,104 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Sets whether the scene graph is updated on several threads.
+        @remarks
+            When enabled, _updateSceneGraph splits the tree into independent subtrees
+            which are updated concurrently by the WorkQueue worker threads and the
+            calling thread. The resulting derived transforms and bounds are the same
+            as with the serial update. Node::Listener::nodeUpdated and
+            MovableObject::Listener::objectMoved are still called on the calling
+            thread, in the same order, but only once all subtrees have been updated.
+            Nodes of another class than the ones the SceneManager creates are
+            updated together with their children through their own Node::_update.
+        @par
+            Node::Listener and MovableObject bounds implementations must not modify
+            state shared with other nodes while this is enabled. It has no effect for
+            SceneManagers which do not support it, and without thread support.
+        */
+        void setParallelSceneGraphUpdate(bool enable) { mParallelSceneGraphUpdate = enable; }
+
+        /** Gets whether the scene graph is updated on several threads.
+        @see setParallelSceneGraphUpdate
+        */
+        bool getParallelSceneGraphUpdate(void) const { return mParallelSceneGraphUpdate; }
+
+        /** Sets whether the frustum culling of the scene graph is done on several threads.
+        @remarks
+            When enabled, _findVisibleObjects tests the bounds of independent subtrees
+            against the camera frustum concurrently on the WorkQueue worker threads and
+            the calling thread. The visible objects are then passed to the RenderQueue
+            on the calling thread in the same order as with serial culling, so the
+            result is identical.
+        @par
+            Only applies to SceneManagers which use the default _findVisibleObjects
+            implementation, and has no effect without thread support.
+        */
+        void setParallelCulling(bool enable) { mParallelCulling = enable; }
+
+        /** Gets whether the frustum culling of the scene graph is done on several threads.
+        @see setParallelCulling
+        */
+        bool getParallelCulling(void) const { return mParallelCulling; }
+
+        /** Sets whether the animated entities are updated in a batch on several threads.
+        @remarks
+            Normally each animated Entity derives its bone matrices and does its
+            software skinning when it is queued for rendering, one at a time. When
+            this is enabled, all animated entities whose bounds are visible from the
+            camera are updated together just before the render queue is filled, with
+            the bone matrices and the software skinning of different entities
+            computed concurrently on the WorkQueue worker threads and the calling
+            thread. Entities sharing a skeleton instance are updated on the same
+            thread in a fixed order, so the results are the same as with the serial
+            update.
+        @par
+            Vertex animation is still applied on the calling thread. Node::Listener
+            implementations on tag points must not modify shared state while this
+            is enabled. It has no effect without thread support.
+        @see _updateEntityAnimations
+        */
+        void setParallelAnimation(bool enable) { mParallelAnimation = enable; }
+
+        /** Gets whether the animated entities are updated in a batch on several threads.
+        @see setParallelAnimation
+        */
+        bool getParallelAnimation(void) const { return mParallelAnimation; }
+
+        /** Sets whether the visible objects are queued for rendering on several threads.
+        @remarks
+            Only applies together with setParallelCulling. Each worker then also lets
+            the objects it found visible add their renderables to a staging RenderQueue
+            of its own. The staged renderables are added to the actual RenderQueue on the
+            calling thread in the same order as with serial culling, so the result is
+            identical.
+        @par
+            Only objects returning true from MovableObject::_supportsParallelRenderQueueUpdate
+            are queued this way, e.g. static entities, StaticGeometry regions and BillboardSets
+            whose geometry is up to date. All others, like animated entities and
+            ParticleSystems, are still queued on the calling thread. It is also disabled
+            while LodListeners are registered, as they are notified while queueing.
+        */
+        void setParallelRenderQueueUpdate(bool enable) { mParallelRenderQueueUpdate = enable; }
+
+        /** Gets whether the visible objects are queued for rendering on several threads.
+        @see setParallelRenderQueueUpdate
+        */
+        bool getParallelRenderQueueUpdate(void) const { return mParallelRenderQueueUpdate; }
+
+        /** Sets the number of threads, including the calling thread, parallel
+            SceneManager work is split across.
+        @remarks
+            The default of 0 uses one thread per hardware thread. The count is
+            further limited by the number of WorkQueue workers available.
+        */
+        void setParallelThreadCount(size_t count) { mParallelThreadCount = count; }
+
+        /** Gets the number of threads parallel SceneManager work is split across.
+        @see setParallelThreadCount
+        */
+        size_t getParallelThreadCount(void) const { return mParallelThreadCount; }
+
         /** Set whether to automatically normalise normals on objects whenever they
             are scaled.
         @remarks
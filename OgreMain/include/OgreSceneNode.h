@@ -61,6 +61,18 @@ namespace Ogre {
         typedef VectorIterator<ObjectMap> ObjectIterator;
         typedef ConstVectorIterator<ObjectMap> ConstObjectIterator;
 
+        /** Entry produced by _collectVisibleObjects.
+        @remarks
+            If object is null, the entry stands for the debug renderables of node
+            (see _addDebugRenderablesToQueue), otherwise object is attached to node.
+        */
+        struct VisibleEntry
+        {
+            MovableObject* object;
+            SceneNode* node;
+        };
+        typedef vector<VisibleEntry>::type VisibleEntryList;
+
     protected:
         ObjectMap mObjectsByName;
 
@@ -86,6 +98,14 @@ namespace Ogre {
         */
         virtual void setInSceneGraph(bool inGraph);
 
+        /// _findVisibleObjects for a node which is already known to be visible
+        void findVisibleObjectsImpl(Camera* cam, RenderQueue* queue,
+            VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren,
+            bool displayNodes, bool onlyShadowCasters);
+        /// _collectVisibleObjects for a node which is already known to be visible
+        void collectVisibleObjectsImpl(const Camera* cam, VisibleEntryList& entries,
+            bool displayNodes) const;
+
         /// Auto tracking target
         SceneNode* mAutoTrackTarget;
         /// Pointer to a Wire Bounding Box for this Node
@@ -209,6 +229,31 @@ namespace Ogre {
             VisibleObjectsBoundsInfo* visibleBounds, 
             bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
 
+        /** Internal method which locates the objects attached to this node and its children
+            which are in the frustum of the camera, without processing them.
+        @remarks
+            The entries are appended in the order _findVisibleObjects would process them, so
+            passing each object to RenderQueue::processVisibleObject and calling
+            _addDebugRenderablesToQueue for each node entry gives the same result.
+            Only reads the scene graph, so it can be called for disjoint subtrees from
+            several threads at once, provided the frustum planes of the camera are up to date.
+        @param
+            cam The active camera
+        @param
+            entries List the visible entries are appended to
+        @param
+            displayNodes Whether the nodes themselves are going to be rendered, see _findVisibleObjects
+        */
+        void _collectVisibleObjects(const Camera* cam, VisibleEntryList& entries, bool displayNodes) const;
+
+        /** Adds the axes of this node and its bounding box to the queue, as far as enabled.
+        @param
+            queue The SceneManager's rendering queue
+        @param
+            displayNodes If true, the node itself is rendered as a set of 3 axes
+        */
+        void _addDebugRenderablesToQueue(RenderQueue* queue, bool displayNodes);
+
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
             Recommended only if you are extending a SceneManager, because the bounding box returned
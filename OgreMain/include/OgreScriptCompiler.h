@@ -235,6 +235,14 @@ namespace Ogre
         AbstractNodeListPtr _generateAST(const String &str, const String &source, bool doImports = false, bool doObjects = false, bool doVariables = false);
         /// Compiles the given abstract syntax tree
         bool _compile(AbstractNodeListPtr nodes, const String &group, bool doImports = true, bool doObjects = true, bool doVariables = true);
+        /// Converts the given concrete node list into an AST, processing its imports, object inheritance and variables
+        /**
+         * This is compile without the translation step.
+         * @param importedScripts Receives the names of all scripts requested by import statements
+         */
+        AbstractNodeListPtr _generateProcessedAST(const ConcreteNodeListPtr &nodes, const String &group, StringVector *importedScripts = 0);
+        /// Returns the errors of the last compilation
+        const ErrorList &getErrors() const { return mErrors; }
         /// Adds the given error to the compiler's list of errors
         void addError(uint32 code, const String &file, int line, const String &msg = "");
         /// Sets the listener used by the compiler
@@ -268,6 +276,9 @@ namespace Ogre
 		*/
 		uint32 registerCustomWordId(const String &word);
 
+        /// Returns a hash of the custom word ids registered so far
+        uint32 _getCustomWordIdHash() const { return mCustomWordIdHash; }
+
     private: // Tree processing
         AbstractNodeListPtr convertToAST(const ConcreteNodeListPtr &nodes);
         /// This built-in function processes import nodes
@@ -294,6 +305,8 @@ namespace Ogre
 
 		// The largest registered id
 		uint32 mLargestRegisteredWordId;
+		// Hash of the custom words in registration order, which determines their ids
+		uint32 mCustomWordIdHash;
 
         // This is an environment map
         typedef map<String,String>::type Environment;
@@ -418,6 +431,52 @@ namespace Ogre
 
         // A pointer to the specific compiler instance used
         OGRE_THREAD_POINTER(ScriptCompiler, mScriptCompiler);
+
+        // The custom words in registration order, so other compilers assign them the same ids
+        StringVector mCustomWords;
+        // Idle compilers for prepareScript, which may run on any thread
+        vector<ScriptCompiler*>::type mCompilerPool;
+        OGRE_WQ_MUTEX(mCompilerPoolMutex);
+
+        // Creates a compiler knowing the registered custom words
+        ScriptCompiler* createCompiler();
+        // Returns the AST of the script after its imports, objects and variables were processed
+        AbstractNodeListPtr generateScriptAST(DataStreamPtr& stream, const String& groupName, ScriptCompiler *compiler);
+
+        typedef std::pair<uint64, uint64> ScriptHash;
+        // A processed AST in the compiled script cache
+        struct CompiledScript
+        {
+            // Hash of the script contents
+            ScriptHash hash;
+            // Hash of the custom word ids the AST was built with
+            uint32 customWordIdHash;
+            // Scripts requested by imports, with the hash of their contents
+            vector<std::pair<String, ScriptHash> >::type imports;
+            // The serialised AST
+            vector<uchar>::type ast;
+        };
+        typedef map<String, CompiledScript>::type CompiledScriptMap;
+        // Compiled scripts by name
+        CompiledScriptMap mCompiledScripts;
+        bool mUseCompiledScriptCache;
+        bool mCompiledScriptCacheDirty;
+        OGRE_WQ_MUTEX(mCompiledScriptMutex);
+
+        typedef map<String, ScriptHash>::type ImportHashMap;
+        // Import hashes by group, kept only while the scripts of the group are parsed
+        map<String, ImportHashMap>::type mImportHashes;
+        // Tracks the script parsing of resource groups for mImportHashes
+        class ImportHashListener;
+        ImportHashListener *mImportHashListener;
+
+        // Hashes an imported script, found in the given group
+        ScriptHash hashImportedScript(const String &name, const String &group);
+        // Returns the AST of a valid cache entry for the script, or a null pointer
+        AbstractNodeListPtr getCompiledScript(const String &name, const ScriptHash &hash, const String &group, const ScriptCompiler *compiler);
+        // Adds the processed AST of a script to the cache
+        void addCompiledScript(const String &name, const ScriptHash &hash, const StringVector &imports, const String &group,
+            const AbstractNodeList &ast, const ScriptCompiler *compiler);
     public:
         ScriptCompilerManager();
         virtual ~ScriptCompilerManager();
@@ -457,6 +516,47 @@ namespace Ogre
         void parseScript(DataStreamPtr& stream, const String& groupName);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
+        /** @copydoc ScriptLoader::isPrepareScriptThreadSafe
+        @remarks
+            True unless a ScriptCompilerListener is set, as its callbacks would
+            be called on other threads.
+        */
+        bool isPrepareScriptThreadSafe(void) const;
+        /** @copydoc ScriptLoader::prepareScript
+        @remarks
+            Lexes and parses the script and processes its abstract syntax tree,
+            using the compiled script cache if enabled. Only the translation is
+            left for parsePreparedScript.
+        */
+        Any prepareScript(DataStreamPtr& stream, const String& groupName);
+        /// @copydoc ScriptLoader::parsePreparedScript
+        void parsePreparedScript(const Any& prepared, const String& groupName);
+
+        /** Sets whether scripts are compiled through the compiled script cache.
+        @remarks
+            The cache holds the abstract syntax tree of each script after its
+            imports, object inheritance and variables were processed, keyed by the
+            hash of its contents. As long as neither the script nor the scripts it
+            imports changed, parseScript then skips lexing, parsing and all the
+            AST processing, and only runs the translators.
+        @par
+            Combined with loadCompiledScriptCache and saveCompiledScriptCache, this
+            carries over to the next run. Scripts are always compiled from text
+            while a ScriptCompilerListener is set, as it may alter the trees.
+            The default is false.
+        */
+        void setUseCompiledScriptCache(bool use) { mUseCompiledScriptCache = use; }
+        /// Gets whether the compiled script cache is used
+        bool getUseCompiledScriptCache(void) const { return mUseCompiledScriptCache; }
+        /// Returns true if the compiled script cache changed since it was loaded
+        bool isCompiledScriptCacheDirty(void) const { return mCompiledScriptCacheDirty; }
+        /// Saves the compiled script cache, e.g. to a file on disk
+        void saveCompiledScriptCache(const DataStreamPtr &stream) const;
+        /** Loads the compiled script cache saved by saveCompiledScriptCache.
+        @remarks
+            A cache written by another version of OGRE, or an invalid one, is ignored.
+        */
+        void loadCompiledScriptCache(const DataStreamPtr &stream);
 
         /// @copydoc Singleton::getSingleton()
         static ScriptCompilerManager& getSingleton(void);
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreDataStream.h"
 #include "OgreStringVector.h"
+#include "OgreAny.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -77,6 +78,33 @@ namespace Ogre {
         */
         virtual void parseScript(DataStreamPtr& stream, const String& groupName) = 0;
 
+        /** Returns whether scripts may be parsed in 2 steps, see prepareScript.
+        @remarks
+            If true, ResourceGroupManager::setParallelScriptParsing makes resource
+            groups call prepareScript for their scripts on other threads, and then
+            parsePreparedScript for each of them in order on the calling thread,
+            instead of parseScript.
+        */
+        virtual bool isPrepareScriptThreadSafe(void) const { return false; }
+
+        /** Does the part of parsing a script file which does not create anything,
+            e.g. tokenizing it.
+        @remarks
+            This may be called from any thread, concurrently with itself and with
+            parsePreparedScript for other scripts.
+        @param stream The data stream which is the source of the script
+        @param groupName The name of the resource group the script belongs to
+        @return The data parsePreparedScript needs to finish parsing the script
+        */
+        virtual Any prepareScript(DataStreamPtr& stream, const String& groupName) { return Any(); }
+
+        /** Finishes parsing a script file, creating the resources it defines.
+        @param prepared The value prepareScript returned for the script
+        @param groupName The name of a resource group which should be used if any resources
+            are created during the parse of this script.
+        */
+        virtual void parsePreparedScript(const Any& prepared, const String& groupName) {}
+
         /** Gets the relative loading order of scripts of this type.
         @remarks
             There are dependencies between some kinds of scripts, and to enforce
@@ -263,8 +263,10 @@ namespace Ogre {
             String mMaterialName;
             /// Pointer to material being used
             MaterialPtr mMaterial;
-            /// Active technique
-            Technique* mTechnique;
+            /// Material LOD index selected by addRenderables
+            ushort mMaterialLodIndex;
+            /// Active technique, resolved on first use
+            mutable Technique* mTechnique;
 
             /// list of Geometry Buckets in this region
             GeometryBucketList mGeometryBucketList;
@@ -294,7 +296,7 @@ namespace Ogre {
             /// Get an iterator over the contained geometry
             GeometryIterator getGeometryIterator(void);
             /// Get the current Technique
-            Technique* getCurrentTechnique(void) const { return mTechnique; }
+            Technique* getCurrentTechnique(void) const;
             /// Dump contents for diagnostics
             void dump(std::ofstream& of) const;
             void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables);
@@ -450,6 +452,7 @@ namespace Ogre {
             const AxisAlignedBox& getBoundingBox(void) const;
             Real getBoundingRadius(void) const;
             void _updateRenderQueue(RenderQueue* queue);
+            bool _supportsParallelRenderQueueUpdate(void) const { return true; }
             /// @copydoc MovableObject::visitRenderables
             void visitRenderables(Renderable::Visitor* visitor, 
                 bool debugRenderables = false);
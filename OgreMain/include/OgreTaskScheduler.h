@@ -0,0 +1,221 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __OgreTaskScheduler_H__
+#define __OgreTaskScheduler_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreWorkQueue.h"
+#include "OgreAtomicScalar.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+    class TaskGroup;
+
+    /** A unit of work executed by the TaskScheduler.
+    @remarks
+        Subclass and implement execute(). Tasks are owned by the caller and
+        are typically allocated on the stack or in an array, they must stay
+        alive until they have finished. A task can only be submitted once.
+    */
+    class _OgreExport Task : public UtilityAlloc
+    {
+    public:
+        Task();
+        virtual ~Task() {}
+
+        /// Do the work of the task; may be called on any thread
+        virtual void execute(void) = 0;
+
+        /** Don't execute this task before the given task has finished.
+        @remarks
+            This is how continuations are expressed: the continuation depends on
+            the tasks it follows. Dependencies must be added before either task
+            is submitted.
+        */
+        void addDependency(Task* task);
+
+        /// Whether the task has been executed
+        bool isFinished(void) const { return mFinished.load(std::memory_order_acquire); }
+
+    private:
+        friend class TaskScheduler;
+
+        /// Dependencies which haven't finished yet, plus one until submitted
+        AtomicScalar<size_t> mPendingDependencies;
+        /// Tasks which depend on this one
+        vector<Task*>::type mContinuations;
+        TaskGroup* mGroup;
+        /// Link in the ready list of the scheduler
+        Task* mNext;
+        AtomicScalar<bool> mFinished;
+    };
+
+    /** A set of tasks which can be waited for together.
+    @remarks
+        If any of the tasks throws an exception, the first one is rethrown by
+        TaskScheduler::wait.
+    */
+    class _OgreExport TaskGroup
+    {
+    public:
+        TaskGroup();
+        /// Waits for the tasks of the group which are still executing
+        ~TaskGroup();
+
+        /// Whether all tasks submitted to the group have finished
+        bool isFinished(void) const { return mPendingTasks.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class TaskScheduler;
+
+        AtomicScalar<size_t> mPendingTasks;
+        AtomicScalar<bool> mFailed;
+        std::exception_ptr mException;
+    };
+
+    /** Runs fine grained Task graphs on the worker threads of a WorkQueue.
+    @remarks
+        WorkQueue requests carry their data in an Any and return their results
+        through processResponses, which is too heavy for splitting per frame
+        engine work such as animation or culling. The TaskScheduler keeps its
+        own list of ready tasks instead and only posts a request to the
+        WorkQueue to wake up a worker, which then executes ready tasks until
+        there are none left.
+    @par
+        A thread waiting for a TaskGroup executes ready tasks itself, so tasks
+        may submit and wait for other tasks, and everything still completes
+        when the WorkQueue has no worker threads.
+    @par
+        Root owns a scheduler which uses the Root WorkQueue, see
+        Root::getTaskScheduler.
+    */
+    class _OgreExport TaskScheduler : public WorkQueue::RequestHandler,
+        public WorkQueue::ResponseHandler, public UtilityAlloc
+    {
+    public:
+        /** A range of indices processed by parallelFor.
+        */
+        class _OgreExport RangeJob
+        {
+        public:
+            virtual ~RangeJob() {}
+            /// Process the indices [begin, end); may be called on any thread
+            virtual void execute(size_t begin, size_t end) = 0;
+        };
+
+        /// Create a scheduler using the worker threads of the given queue
+        TaskScheduler(WorkQueue* queue = 0);
+        virtual ~TaskScheduler();
+
+        /** Set the WorkQueue whose worker threads execute the tasks.
+        @remarks
+            May be null, the tasks are then executed by the waiting threads.
+            Must not be called while tasks are pending.
+        */
+        void setWorkQueue(WorkQueue* queue);
+        WorkQueue* getWorkQueue(void) const { return mQueue; }
+
+        /** Number of threads which can execute tasks at the same time, ie the
+            worker threads of the WorkQueue plus the waiting thread.
+        */
+        size_t getThreadCount(void) const;
+
+        /** Add a task to a group and schedule it once its dependencies have
+            finished.
+        */
+        void submit(Task* task, TaskGroup& group);
+
+        /** Execute ready tasks on the calling thread until all tasks of the
+            group have finished.
+        @remarks
+            Rethrows the first exception thrown by a task of the group.
+        */
+        void wait(TaskGroup& group);
+
+        /** Execute ready tasks on the calling thread until the given task has
+            finished.
+        @remarks
+            Exceptions are only reported by waiting for the group of the task.
+        */
+        void wait(Task& task);
+
+        /** Process the indices [begin, end) in chunks of grainSize on several
+            threads, including the calling one, and return once all are done.
+        @param maxThreads Maximum number of threads to use, 0 for getThreadCount()
+        */
+        void parallelFor(size_t begin, size_t end, size_t grainSize, RangeJob& job,
+            size_t maxThreads = 0);
+
+        /// @copydoc WorkQueue::RequestHandler::canHandleRequest
+        bool canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
+        /// @copydoc WorkQueue::RequestHandler::handleRequest
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
+        /// @copydoc WorkQueue::ResponseHandler::handleResponse
+        void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ);
+
+    private:
+        /// Maximum number of threads parallelFor splits a range across
+        static const size_t MAX_RANGE_THREADS = 64;
+
+        /// Put a task whose dependencies have finished on the ready list
+        void makeReady(Task* task);
+        /// Take a task from the ready list, or null if there is none
+        Task* acquireTask(void);
+        void executeTask(Task* task);
+        /// Post a request to wake up another worker if one is idle
+        void requestWorker(void);
+        /// Number of worker threads of the WorkQueue
+        size_t getWorkerCount(void) const;
+
+        WorkQueue* mQueue;
+        uint16 mChannel;
+
+        OGRE_WQ_MUTEX(mReadyMutex);
+        Task* mReadyHead; // Guarded by mReadyMutex
+        Task* mReadyTail; // Guarded by mReadyMutex
+        AtomicScalar<size_t> mReadyCount;
+        /// Worker threads currently executing tasks, or about to
+        AtomicScalar<size_t> mActiveWorkers;
+    };
+
+    /** @} */
+    /** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
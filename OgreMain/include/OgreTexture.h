@@ -309,6 +309,53 @@ namespace Ogre {
         */
         void _loadImages( const ConstImagePtrList& images );
 
+        /** Whether only the smaller mipmaps of the texture are resident.
+        @remarks
+            2D textures loaded from a file with mipmaps, like DDS or KTX, are
+            streamed when TextureManager::setStreamingBudget is set. They are
+            first created with their mipmaps up to
+            TextureManager::getStreamingMinSize only, and the larger ones are
+            loaded in the background as the objects using them come closer to
+            the camera. getWidth, getHeight and getNumMipmaps describe the
+            resident mipmaps, getSrcWidth and getSrcHeight the whole image.
+        */
+        bool isStreamed(void) const { return mStreamed; }
+        /// The first mipmap of the source image which is resident, 0 if all of them are
+        uint32 getResidentMipmap(void) const { return mResidentMipmap; }
+        /// The number of mipmaps of the source image of a streamed texture
+        uint32 getNumSrcMipmaps(void) const { return mNumSrcMipmaps; }
+        /** The size of the resident mipmaps of a streamed texture, if the
+            given mipmap of its source image was the first resident one.
+        */
+        size_t getStreamedSize(uint32 residentMipmap) const;
+
+        /** Internal method to record that an object using this texture covers
+            size pixels on screen, the largest of which is kept until the
+            TextureManager next updates the streamed textures.
+        */
+        void _notifyStreamingDemand(Real size) { mStreamingDemand = std::max(mStreamingDemand, size); }
+        /// The size on screen recorded by _notifyStreamingDemand
+        Real _getStreamingDemand(void) const { return mStreamingDemand; }
+        /// Forgets the size on screen recorded by _notifyStreamingDemand
+        void _resetStreamingDemand(void) { mStreamingDemand = 0; }
+
+        /** Internal method to make the mipmaps of a streamed texture from
+            residentMipmap on resident, replacing the current ones.
+        @param img The source image the texture was loaded from, with all its mipmaps
+        @param residentMipmap The first mipmap of img to make resident
+        */
+        void _loadStreamedImage(const Image& img, uint32 residentMipmap);
+
+        /** Internal method reading the source image of a streamed texture for
+            _loadStreamedImage, may be called in a background thread.
+        */
+        void _readStreamedImage(Image& img);
+
+        /** Internal method called when _readStreamedImage failed. The texture
+            keeps its resident mipmaps and is not streamed any more.
+        */
+        void _notifyStreamingFailed(void) { mStreamed = false; }
+
         /** Returns the pixel format for the texture surface. */
         PixelFormat getFormat() const
         {
@@ -442,6 +489,19 @@ namespace Ogre {
 
         bool mInternalResourcesCreated;
 
+        /// See isStreamed
+        bool mStreamed;
+        /// Whether loadImpl is loading the texture from its own file, only those are streamed
+        bool mLoadingFromFile;
+        uint32 mResidentMipmap;
+        uint32 mNumSrcMipmaps;
+        Real mStreamingDemand;
+
+        /// @copydoc Resource::preLoadImpl
+        void preLoadImpl(void);
+        /// @copydoc Resource::postLoadImpl
+        void postLoadImpl(void);
+
         /// @copydoc Resource::calculateSize
         size_t calculateSize(void) const;
         
@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 
 #include "OgreResourceManager.h"
+#include "OgreResourceBackgroundQueue.h"
 #include "OgreTexture.h"
 #include "OgreSingleton.h"
 
@@ -447,6 +448,87 @@ namespace Ogre {
         /// Internal method to create a warning texture (bound when a texture unit is blank)
         const TexturePtr& _getWarningTexture();
 
+        /** Sets the memory the streamed textures may use, 0 to not stream textures.
+        @remarks
+            2D textures with mipmaps in their file, like DDS or KTX, which are
+            loaded while a budget is set are streamed: they are created with
+            their mipmaps up to getStreamingMinSize only. Once a frame the
+            larger mipmaps the objects using each texture need for their size
+            on screen are read by the ResourceBackgroundQueue, as long as all
+            streamed textures fit into the budget. Otherwise the detail of the
+            textures with the most texels per pixel on screen is reduced first,
+            which drops the textures that were not seen at all before the
+            others. A texture is assumed to cover the objects using it once,
+            so tiled textures ask for less detail than they show.
+        @note
+            The budget applies to the streamed textures only, and the
+            mipmaps up to getStreamingMinSize are always resident.
+        @param bytes The memory in bytes, 0 by default
+        */
+        void setStreamingBudget(size_t bytes) { mStreamingBudget = bytes; }
+        /// See setStreamingBudget
+        size_t getStreamingBudget(void) const { return mStreamingBudget; }
+
+        /** Sets the size of the largest mipmap of streamed textures which is
+            always resident, 64 by default.
+        */
+        void setStreamingMinSize(uint32 size) { mStreamingMinSize = std::max(size, 1u); }
+        /// See setStreamingMinSize
+        uint32 getStreamingMinSize(void) const { return mStreamingMinSize; }
+
+        /** Sets how many textures may be streamed in the background at the
+            same time, 2 by default. Without background threads this is how
+            many are loaded per frame.
+        */
+        void setStreamingMaxRequests(size_t count) { mStreamingMaxRequests = std::max<size_t>(count, 1); }
+        /// See setStreamingMaxRequests
+        size_t getStreamingMaxRequests(void) const { return mStreamingMaxRequests; }
+
+        /// The memory the resident mipmaps of the streamed textures use
+        size_t getStreamingUsage(void) const { return mStreamingUsage; }
+
+        /** Internal method recording the size on screen of an object for the
+            streamed textures its renderables use, called by the RenderQueue
+            for the visible objects.
+        */
+        void _notifyStreamingDemand(MovableObject* mo, const Camera* cam);
+
+        /** Internal method choosing the resident mipmaps of the streamed
+            textures from their demand and the budget, and queueing the
+            requests to change them. Called by Root once a frame.
+        */
+        void _updateStreaming(void);
+
+        /// A streamed texture as _planStreaming sees it
+        struct StreamingTexture
+        {
+            /// The source image
+            uint32 width, height, numMipmaps;
+            PixelFormat format;
+            /// The smallest detail to keep, the mipmaps after it are always resident
+            uint32 maxResidentMipmap;
+            /// The first resident mipmap
+            uint32 residentMipmap;
+            /// The size on screen of the objects using the texture, 0 if none was visible
+            Real demand;
+            /// The first mipmap which should be resident, set by _planStreaming
+            uint32 targetMipmap;
+            /// The texture, if any
+            Texture* texture;
+
+            /// The memory used if the given mipmap was the first resident one
+            size_t getSize(uint32 mipmap) const;
+        };
+        typedef vector<StreamingTexture>::type StreamingTextureList;
+
+        /** Sets the target mipmap of each texture to the one closest to its
+            demand, but not to less detail than is resident, then reduces the
+            detail of the textures with the most texels per pixel on screen
+            until all of them fit into the budget.
+        @return the memory the textures use at their target mipmaps
+        */
+        static size_t _planStreaming(StreamingTextureList& textures, size_t budget);
+
         /// @copydoc Singleton::getSingleton()
         static TextureManager& getSingleton(void);
         /// @copydoc Singleton::getSingleton()
@@ -458,6 +540,14 @@ namespace Ogre {
         ushort mPreferredFloatBitDepth;
         uint32 mDefaultNumMipmaps;
         TexturePtr mWarningTexture;
+
+        size_t mStreamingBudget;
+        uint32 mStreamingMinSize;
+        size_t mStreamingMaxRequests;
+        size_t mStreamingUsage;
+        /// The background requests changing the resident mipmaps, by texture handle
+        typedef map<ResourceHandle, BackgroundProcessTicket>::type StreamingRequestMap;
+        StreamingRequestMap mStreamingRequests;
     };
     /** @} */
     /** @} */
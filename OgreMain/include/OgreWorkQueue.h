@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreAny.h"
 #include "OgreSharedPtr.h"
+#include "OgreAtomicScalar.h"
 #include "OgreCommon.h"
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreHeaderPrefix.h"
@@ -503,19 +504,22 @@ namespace Ogre
         class _OgreExport RequestHandlerHolder : public UtilityAlloc
         {
         protected:
-            OGRE_WQ_RW_MUTEX(mRWMutex);
-            RequestHandler* mHandler;
+            AtomicScalar<RequestHandler*> mHandler;
+            /// Number of requests currently being processed by the handler
+            AtomicScalar<size_t> mActiveRequests;
+
+            struct ActiveRequestScope
+            {
+                AtomicScalar<size_t>& mCount;
+                ActiveRequestScope(AtomicScalar<size_t>& count) : mCount(count) { ++mCount; }
+                ~ActiveRequestScope() { --mCount; }
+            };
         public:
             RequestHandlerHolder(RequestHandler* handler)
-                : mHandler(handler) {}
+                : mHandler(handler), mActiveRequests(0) {}
 
             // Disconnect the handler to allow it to be destroyed
-            void disconnectHandler()
-            {
-                // write lock - must wait for all requests to finish
-                OGRE_WQ_LOCK_RW_MUTEX_WRITE(mRWMutex);
-                mHandler = 0;
-            }
+            void disconnectHandler();
 
             /** Get handler pointer - note, only use this for == comparison or similar,
                 do not attempt to call it as it is not thread safe. 
@@ -527,15 +531,16 @@ namespace Ogre
             */
             Response* handleRequest(const Request* req, const WorkQueue* srcQ)
             {
-                // Read mutex so that multiple requests can be processed by the
-                // same handler in parallel if required
-                OGRE_WQ_LOCK_RW_MUTEX_READ(mRWMutex);
+                // Counted rather than locked so that multiple requests can be
+                // processed by the same handler in parallel
+                ActiveRequestScope scope(mActiveRequests);
                 Response* response = 0;
-                if (mHandler)
+                RequestHandler* handler = mHandler;
+                if (handler)
                 {
-                    if (mHandler->canHandleRequest(req, srcQ))
+                    if (handler->canHandleRequest(req, srcQ))
                     {
-                        response = mHandler->handleRequest(req, srcQ);
+                        response = handler->handleRequest(req, srcQ);
                     }
                 }
                 return response;
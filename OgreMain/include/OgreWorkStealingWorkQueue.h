@@ -0,0 +1,170 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __OgreWorkStealingWorkQueue_H__
+#define __OgreWorkStealingWorkQueue_H__
+
+#include "OgreWorkQueue.h"
+#include "OgreAtomicScalar.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup General
+    *  @{
+    */
+
+    /** Work queue implementation which schedules requests with per-worker
+        lock-free deques and work stealing.
+    @remarks
+        DefaultWorkQueue keeps all pending requests in a single mutex protected
+        queue, which becomes a point of contention once many small requests are
+        issued per frame. This implementation gives each worker thread its own
+        bounded deque; requests added from a worker thread are pushed onto that
+        thread's deque, requests added from any other thread go through a
+        lock-free injection queue. Idle workers take requests from their own
+        deque first, then from the injection queue and finally steal from the
+        other workers.
+    @par
+        Every queued request is recorded in a registry keyed by its RequestID,
+        so aborting a single request does not scan the queues. Apart from the
+        scheduling order, the behaviour is identical to DefaultWorkQueue:
+        handlers, retries, idle requests, responses and the response time
+        limit work the same way.
+    @par
+        Select this implementation by passing Root::WQT_WORK_STEALING to the
+        Root constructor, or by installing it with Root::setWorkQueue.
+    */
+    class _OgreExport WorkStealingWorkQueue : public DefaultWorkQueueBase
+    {
+    public:
+        WorkStealingWorkQueue(const String& name = BLANKSTRING);
+        virtual ~WorkStealingWorkQueue();
+
+        /// @copydoc WorkQueue::startup
+        virtual void startup(bool forceRestart = true);
+        /// @copydoc WorkQueue::shutdown
+        virtual void shutdown();
+
+        /// @copydoc WorkQueue::addRequest
+        virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData,
+            uint8 retryCount = 2, bool forceSynchronous = false, bool idleThread = false);
+        /// @copydoc WorkQueue::abortRequest
+        virtual void abortRequest(RequestID id);
+        /// @copydoc WorkQueue::abortPendingRequest
+        virtual bool abortPendingRequest(RequestID id);
+        /// @copydoc WorkQueue::abortRequestsByChannel
+        virtual void abortRequestsByChannel(uint16 channel);
+        /// @copydoc WorkQueue::abortPendingRequestsByChannel
+        virtual void abortPendingRequestsByChannel(uint16 channel);
+        /// @copydoc WorkQueue::abortAllRequests
+        virtual void abortAllRequests();
+        /// @copydoc WorkQueue::processResponses
+        virtual void processResponses();
+
+        /** Process the next request on the queue, if there is one.
+        @remarks
+            Called by the worker threads; may also be called by another thread
+            to help process the pending requests.
+        */
+        virtual void _processNextRequest();
+
+        /// Main function for each thread spawned.
+        virtual void _threadMain();
+
+    protected:
+        class WorkerDeque;
+        class InjectionQueue;
+        struct RequestShard;
+
+        /// Number of shards in the request registry
+        static const size_t REQUEST_SHARD_COUNT = 64;
+
+        /// Returns true if there is a request a worker could pick up
+        bool hasPendingWork() const;
+        /// Suspend the calling worker until there is work or the queue shuts down
+        void waitForNextRequest();
+        virtual void notifyWorkers();
+        /// Notify that a thread has registered itself with the render system
+        void notifyThreadRegistered();
+
+        /// Index of the worker deque owned by the calling thread, or -1
+        int getCurrentWorkerIndex() const;
+        /// Queue a request on the deque of the calling worker or the injection queue
+        void enqueueRequest(Request* r);
+        /// Take a request from the local deque, the injection queue or another worker
+        Request* acquireRequest();
+        bool processIdleRequest();
+        void runRequest(Request* r, bool synchronous);
+
+        RequestShard& getShard(RequestID id) const;
+        void registerRequest(Request* r);
+        void unregisterRequest(const Request* r);
+        /// Mark a request as being processed, so it's no longer pending
+        void markRequestStarted(const Request* r);
+        /// Delete a response and forget about its request
+        void destroyResponse(Response* r);
+
+        typedef vector<WorkerDeque*>::type WorkerDequeList;
+        WorkerDequeList mWorkerDeques;
+        InjectionQueue* mInjectionQueue;
+        RequestShard* mRequestShards;
+
+        AtomicScalar<RequestID> mNextRequestID;
+        AtomicScalar<size_t> mNextWorkerIndex;
+        AtomicScalar<size_t> mSleepingWorkers;
+        AtomicScalar<size_t> mOverflowCount; // Guarded by mRequestMutex when modified
+        AtomicScalar<size_t> mIdleCount; // Guarded by mIdleMutex when modified
+        AtomicScalar<bool> mIdleRunning; // Guarded by mIdleMutex when modified
+
+        /// Requests which did not fit the injection queue, guarded by mRequestMutex
+        RequestQueue mOverflowQueue;
+
+        size_t mNumThreadsRegisteredWithRS;
+        /// Init notification mutex (must lock before waiting on initCondition)
+        OGRE_WQ_MUTEX(mInitMutex);
+        /// Synchroniser token to wait / notify on thread init
+        OGRE_WQ_THREAD_SYNCHRONISER(mInitSync);
+
+        OGRE_WQ_THREAD_SYNCHRONISER(mRequestCondition);
+#if OGRE_THREAD_SUPPORT
+        typedef vector<OGRE_THREAD_TYPE*>::type WorkerThreadList;
+        WorkerThreadList mWorkers;
+#endif
+    };
+
+    /** @} */
+    /** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -40,6 +40,7 @@ namespace Ogre {
         0,      0,    1,    0,
         0,      0,    0,    1);
 
+    AtomicScalar<uint64> AutoParamDataSource::msVersionCounter(0);
     //-----------------------------------------------------------------------------
     AutoParamDataSource::AutoParamDataSource()
         : mWorldMatrixCount(0),
@@ -69,7 +70,10 @@ namespace Ogre {
          mCurrentViewport(0), 
          mCurrentSceneManager(0),
          mMainCamBoundsInfo(0),
-         mCurrentPass(0)
+         mCurrentPass(0),
+         mCurrentLightListHash(0),
+         mUseIdentityView(false),
+         mUseIdentityProjection(false)
     {
         mBlankLight.setDiffuseColour(ColourValue::Black);
         mBlankLight.setSpecularColour(ColourValue::Black);
@@ -83,7 +87,18 @@ namespace Ogre {
             mCurrentTextureProjector[i] = 0;
             mShadowCamDepthRangesDirty[i] = false;
         }
-
+        markChanged(GPV_ALL);
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::markChanged(uint16 variability)
+    {
+        uint64 version = ++msVersionCounter;
+        if (variability & GPV_GLOBAL)
+            mGlobalVersion = version;
+        if (variability & GPV_PER_OBJECT)
+            mPerObjectVersion = version;
+        if (variability & GPV_LIGHTS)
+            mLightsVersion = version;
     }
     //-----------------------------------------------------------------------------
 	const Camera* AutoParamDataSource::getCurrentCamera() const
@@ -126,6 +141,17 @@ namespace Ogre {
             mSpotlightWorldViewProjMatrixDirty[i] = true;
         }
 
+        uint16 changed = GPV_PER_OBJECT;
+        // the view and projection matrices depend on the renderable too
+        bool useIdentityView = rend && rend->getUseIdentityView();
+        bool useIdentityProjection = rend && rend->getUseIdentityProjection();
+        if (useIdentityView != mUseIdentityView || useIdentityProjection != mUseIdentityProjection)
+        {
+            mUseIdentityView = useIdentityView;
+            mUseIdentityProjection = useIdentityProjection;
+            changed |= GPV_GLOBAL;
+        }
+        markChanged(changed);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentCamera(const Camera* cam, bool useCameraRelative)
@@ -145,6 +171,8 @@ namespace Ogre {
         mCameraPositionDirty = true;
         mLodCameraPositionObjectSpaceDirty = true;
         mLodCameraPositionDirty = true;
+        // also done for the same camera, as it might have moved since
+        markChanged(GPV_ALL);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentLightList(const LightList* ll)
@@ -156,6 +184,12 @@ namespace Ogre {
             mSpotlightWorldViewProjMatrixDirty[i] = true;
         }
 
+        // same rule as SceneManager::useLights, lights do not change during a render
+        if (ll->getHash() != mCurrentLightListHash)
+        {
+            mCurrentLightListHash = ll->getHash();
+            markChanged(GPV_LIGHTS);
+        }
     }
     //---------------------------------------------------------------------
     float AutoParamDataSource::getLightNumber(size_t index) const
@@ -255,11 +289,16 @@ namespace Ogre {
     {
         mMainCamBoundsInfo = info;
         mSceneDepthRangeDirty = true;
+        markChanged(GPV_GLOBAL);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentSceneManager(const SceneManager* sm)
     {
-        mCurrentSceneManager = sm;
+        if (sm != mCurrentSceneManager)
+        {
+            mCurrentSceneManager = sm;
+            markChanged(GPV_ALL);
+        }
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setWorldMatrices(const Affine3* m, size_t count)
@@ -267,6 +306,7 @@ namespace Ogre {
         mWorldMatrixArray = m;
         mWorldMatrixCount = count;
         mWorldMatrixDirty = false;
+        markChanged(GPV_PER_OBJECT);
     }
     //-----------------------------------------------------------------------------
     const Affine3& AutoParamDataSource::getWorldMatrix(void) const
@@ -510,7 +550,11 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setAmbientLightColour(const ColourValue& ambient)
     {
-        mAmbientLight = ambient;
+        if (ambient != mAmbientLight)
+        {
+            mAmbientLight = ambient;
+            markChanged(GPV_GLOBAL);
+        }
     }
     //---------------------------------------------------------------------
     float AutoParamDataSource::getLightCount() const
@@ -616,11 +660,14 @@ namespace Ogre {
         Real expDensity, Real linearStart, Real linearEnd)
     {
         (void)mode; // ignored
+        Vector4 fogParams(expDensity, linearStart, linearEnd,
+                          linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0);
+        if (colour == mFogColour && fogParams == mFogParams)
+            return;
+
         mFogColour = colour;
-        mFogParams.x = expDensity;
-        mFogParams.y = linearStart;
-        mFogParams.z = linearEnd;
-        mFogParams.w = linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0;
+        mFogParams = fogParams;
+        markChanged(GPV_GLOBAL);
     }
     //-----------------------------------------------------------------------------
     const ColourValue& AutoParamDataSource::getFogColour(void) const
@@ -636,12 +683,14 @@ namespace Ogre {
     void AutoParamDataSource::setPointParameters(Real size, bool attenuation, Real constant,
                                                  Real linear, Real quadratic)
     {
-        mPointParams.x = size;
+        Vector4 pointParams(size, constant, linear, quadratic);
         if(attenuation)
-            mPointParams.x *= getViewportHeight();
-        mPointParams.y = constant;
-        mPointParams.z = linear;
-        mPointParams.w = quadratic;
+            pointParams.x *= getViewportHeight();
+        if (pointParams == mPointParams)
+            return;
+
+        mPointParams = pointParams;
+        markChanged(GPV_GLOBAL);
     }
 
     const Vector4& AutoParamDataSource::getPointParams() const
@@ -651,12 +700,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setTextureProjector(const Frustum* frust, size_t index = 0)
     {
-        if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
+        if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS && frust != mCurrentTextureProjector[index])
         {
             mCurrentTextureProjector[index] = frust;
             mTextureViewProjMatrixDirty[index] = true;
             mTextureWorldViewProjMatrixDirty[index] = true;
             mShadowCamDepthRangesDirty[index] = true;
+            markChanged(GPV_ALL);
         }
 
     }
@@ -806,7 +856,11 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderTarget(const RenderTarget* target)
     {
-        mCurrentRenderTarget = target;
+        if (target != mCurrentRenderTarget)
+        {
+            mCurrentRenderTarget = target;
+            markChanged(GPV_GLOBAL);
+        }
     }
     //-----------------------------------------------------------------------------
     const RenderTarget* AutoParamDataSource::getCurrentRenderTarget(void) const
@@ -816,12 +870,20 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentViewport(const Viewport* viewport)
     {
-        mCurrentViewport = viewport;
+        if (viewport != mCurrentViewport)
+        {
+            mCurrentViewport = viewport;
+            markChanged(GPV_GLOBAL);
+        }
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowDirLightExtrusionDistance(Real dist)
     {
-        mDirLightExtrusionDistance = dist;
+        if (dist != mDirLightExtrusionDistance)
+        {
+            mDirLightExtrusionDistance = dist;
+            markChanged(GPV_LIGHTS);
+        }
     }
     //-----------------------------------------------------------------------------
     Real AutoParamDataSource::getShadowExtrusionDistance(void) const
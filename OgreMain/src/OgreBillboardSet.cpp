@@ -583,6 +583,12 @@ namespace Ogre {
         return mAABB;
     }
 
+    //-----------------------------------------------------------------------
+    bool BillboardSet::_supportsParallelRenderQueueUpdate(void) const
+    {
+        return !mListener &&
+               (mExternalData || !(mAutoUpdate || mBillboardDataChanged || !mBuffersCreated));
+    }
     //-----------------------------------------------------------------------
     void BillboardSet::_updateRenderQueue(RenderQueue* queue)
     {
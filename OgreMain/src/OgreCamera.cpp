@@ -872,6 +872,19 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Camera::areVisible(const AxisAlignedBox* const* bounds, size_t numBounds,
+        char* visibilities) const
+    {
+        if (mCullFrustum)
+        {
+            mCullFrustum->areVisible(bounds, numBounds, visibilities);
+        }
+        else
+        {
+            areVisibleImpl(bounds, numBounds, visibilities);
+        }
+    }
+    //-----------------------------------------------------------------------
     bool Camera::isVisible(const Sphere& bound, FrustumPlane* culledBy) const
     {
         if (mCullFrustum)
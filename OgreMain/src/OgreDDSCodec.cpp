@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include "OgreDDSCodec.h"
 #include "OgreImage.h"
+#include "OgrePixelBlockDecompression.h"
 
 namespace Ogre {
     // Internal DDS structure definitions
@@ -89,32 +90,6 @@ namespace Ogre {
     };
     
 
-    // An 8-byte DXT colour block, represents a 4x4 texel area. Used by all DXT formats
-    struct DXTColourBlock
-    {
-        // 2 colour ranges
-        uint16 colour_0;
-        uint16 colour_1;
-        // 16 2-bit indexes, each byte here is one row
-        uint8 indexRow[4];
-    };
-    // An 8-byte DXT explicit alpha block, represents a 4x4 texel area. Used by DXT2/3
-    struct DXTExplicitAlphaBlock
-    {
-        // 16 4-bit values, each 16-bit value is one row
-        uint16 alphaRow[4];
-    };
-    // An 8-byte DXT interpolated alpha block, represents a 4x4 texel area. Used by DXT4/5
-    struct DXTInterpolatedAlphaBlock
-    {
-        // 2 alpha ranges
-        uint8 alpha_0;
-        uint8 alpha_1;
-        // 16 3-bit indexes. Unfortunately 3 bits doesn't map too well to row bytes
-        // so just stored raw
-        uint8 indexes[6];
-    };
-    
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
 #pragma pack (pop)
 #else
@@ -130,6 +105,7 @@ namespace Ogre {
     const uint32 DDSD_HEIGHT = 0x00000002;
     const uint32 DDSD_WIDTH = 0x00000004;
     const uint32 DDSD_PIXELFORMAT = 0x00001000;
+    const uint32 DDSD_LINEARSIZE = 0x00080000;
     const uint32 DDSD_DEPTH = 0x00800000;
     const uint32 DDPF_ALPHAPIXELS = 0x00000001;
     const uint32 DDPF_FOURCC = 0x00000004;
@@ -149,7 +125,6 @@ namespace Ogre {
     // Currently unused
 //    const uint32 DDSD_PITCH = 0x00000008;
 //    const uint32 DDSD_MIPMAPCOUNT = 0x00020000;
-//    const uint32 DDSD_LINEARSIZE = 0x00080000;
 
     // Special FourCC codes
     const uint32 D3DFMT_R16F            = 111;
@@ -195,14 +170,6 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     DataStreamPtr DDSCodec::encode(const MemoryDataStreamPtr& input, const Codec::CodecDataPtr& pData) const
-    {        
-        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
-            "DDS encoding not supported",
-            "DDSCodec::encode" ) ;
-    }
-    //---------------------------------------------------------------------
-    void DDSCodec::encodeToFile(const MemoryDataStreamPtr& input, const String& outFileName,
-                                const Codec::CodecDataPtr& pData) const
     {
         // Unwrap codecDataPtr - data is cleaned by calling function
         ImageData* imgData = static_cast<ImageData* >(pData.get());  
@@ -218,6 +185,7 @@ namespace Ogre {
         bool isFloat32r = (imgData->format == PF_FLOAT32_R);
         bool isFloat16 = (imgData->format == PF_FLOAT16_RGBA);
         bool isFloat32 = (imgData->format == PF_FLOAT32_RGBA);
+        bool isCompressed = PixelUtil::isCompressed(imgData->format);
         bool notImplemented = false;
         String notImplementedString = "";
 
@@ -252,9 +220,17 @@ namespace Ogre {
         case PF_FLOAT32_R:
         case PF_FLOAT16_RGBA:
         case PF_FLOAT32_RGBA:
+        case PF_DXT1:
+        case PF_DXT2:
+        case PF_DXT3:
+        case PF_DXT4:
+        case PF_DXT5:
+        case PF_BC4_UNORM:
+        case PF_BC5_UNORM:
+        case PF_BC7_UNORM:
             break;
         default:
-            // No crazy FOURCC or 565 et al. file formats at this stage
+            // No 565 et al. file formats at this stage
             notImplemented = true;
             notImplementedString = " unsupported pixel format";
             break;
@@ -267,11 +243,11 @@ namespace Ogre {
         {
             OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
                 "DDS encoding for" + notImplementedString + " not supported",
-                "DDSCodec::encodeToFile" ) ;
+                "DDSCodec::encode" ) ;
         }
         else
         {
-            // Build header and write to disk
+            // Build header
 
             // Variables for some DDS header flags
             bool hasAlpha = false;
@@ -325,7 +301,17 @@ namespace Ogre {
             }
 
             // Initalise the SizeOrPitch flags (power two textures for now)
-            ddsHeaderSizeOrPitch = static_cast<uint32>(ddsHeaderRgbBits * imgData->width);
+            if (isCompressed)
+            {
+                // size of the top level of block compressed formats
+                ddsHeaderFlags |= DDSD_LINEARSIZE;
+                ddsHeaderSizeOrPitch = static_cast<uint32>(
+                    PixelUtil::getMemorySize(imgData->width, imgData->height, 1, imgData->format));
+            }
+            else
+            {
+                ddsHeaderSizeOrPitch = static_cast<uint32>(ddsHeaderRgbBits * imgData->width);
+            }
 
             // Initalise the caps flags
             ddsHeaderCaps1 = (isVolume||isCubeMap) ? DDSCAPS_COMPLEX|DDSCAPS_TEXTURE : DDSCAPS_TEXTURE;
@@ -362,8 +348,12 @@ namespace Ogre {
 
             ddsHeader.pixelFormat.size = DDS_PIXELFORMAT_SIZE;
             ddsHeader.pixelFormat.flags = (hasAlpha) ? DDPF_RGB|DDPF_ALPHAPIXELS : DDPF_RGB;
-            ddsHeader.pixelFormat.flags = (isFloat32r || isFloat16 || isFloat32) ? DDPF_FOURCC : ddsHeader.pixelFormat.flags;
-            if (isFloat32r) {
+            ddsHeader.pixelFormat.flags = (isFloat32r || isFloat16 || isFloat32 || isCompressed) ?
+                DDPF_FOURCC : ddsHeader.pixelFormat.flags;
+            if (isCompressed) {
+                ddsHeader.pixelFormat.fourCC = convertOgreToFourCCFormat(imgData->format);
+            }
+            else if (isFloat32r) {
                 ddsHeader.pixelFormat.fourCC = D3DFMT_R32F;
             }
             else if (isFloat16) {
@@ -382,6 +372,11 @@ namespace Ogre {
             ddsHeader.pixelFormat.redMask   = (isFloat32r) ? 0xFFFFFFFF :0x00FF0000;
             ddsHeader.pixelFormat.greenMask = (isFloat32r) ? 0x00000000 :0x0000FF00;
             ddsHeader.pixelFormat.blueMask  = (isFloat32r) ? 0x00000000 :0x000000FF;
+            if (isCompressed)
+            {
+                ddsHeader.pixelFormat.redMask = ddsHeader.pixelFormat.greenMask = 0;
+                ddsHeader.pixelFormat.blueMask = ddsHeader.pixelFormat.alphaMask = 0;
+            }
 
             if( flipRgbMasks )
                 std::swap( ddsHeader.pixelFormat.redMask, ddsHeader.pixelFormat.blueMask );
@@ -391,39 +386,93 @@ namespace Ogre {
 //          ddsHeader.caps.reserved[0] = 0;
 //          ddsHeader.caps.reserved[1] = 0;
 
+            // Formats without a FourCC code of their own follow in the extended header
+            bool hasExtendedHeader = ddsHeader.pixelFormat.fourCC == FOURCC('D', 'X', '1', '0');
+            DDSExtendedHeader extHeader;
+            if (hasExtendedHeader)
+            {
+                extHeader.dxgiFormat = convertOgreToDXFormat(imgData->format);
+                extHeader.resourceDimension = isVolume ? 4 : 3; // D3D10_RESOURCE_DIMENSION_TEXTURE3D / 2D
+                extHeader.miscFlag = isCubeMap ? 0x4 : 0; // D3D11_RESOURCE_MISC_TEXTURECUBE
+                extHeader.arraySize = 1;
+                extHeader.reserved = 0;
+                flipEndian(&extHeader, 4, sizeof(DDSExtendedHeader) / 4);
+            }
+
             // Swap endian
             flipEndian(&ddsMagic, sizeof(uint32));
             flipEndian(&ddsHeader, 4, sizeof(DDSHeader) / 4);
 
-            char *tmpData = 0;
-            char const *dataPtr = (char const *)input->getPtr();
+            size_t headerSize = sizeof(uint32) + DDS_HEADER_SIZE + (hasExtendedHeader ? sizeof(DDSExtendedHeader) : 0);
+            MemoryDataStreamPtr output(OGRE_NEW MemoryDataStream(headerSize + imgData->size));
+            uint8* dst = output->getPtr();
+            memcpy(dst, &ddsMagic, sizeof(uint32));
+            memcpy(dst + sizeof(uint32), &ddsHeader, DDS_HEADER_SIZE);
+            if (hasExtendedHeader)
+                memcpy(dst + sizeof(uint32) + DDS_HEADER_SIZE, &extHeader, sizeof(DDSExtendedHeader));
 
+            // XXX flipEndian on each pixel chunk written unless isFloat32r ?
             if( imgData->format == PF_B8G8R8 )
             {
                 PixelBox src( imgData->size / 3, 1, 1, PF_B8G8R8, input->getPtr() );
-                tmpData = new char[imgData->size];
-                PixelBox dst( imgData->size / 3, 1, 1, PF_R8G8B8, tmpData );
-
-                PixelUtil::bulkPixelConversion( src, dst );
-
-                dataPtr = tmpData;
+                PixelBox converted( imgData->size / 3, 1, 1, PF_R8G8B8, dst + headerSize );
+                PixelUtil::bulkPixelConversion( src, converted );
             }
-
-            try
-            {
-                // Write the file
-                std::ofstream of;
-                of.open(outFileName.c_str(), std::ios_base::binary|std::ios_base::out);
-                of.write((const char *)&ddsMagic, sizeof(uint32));
-                of.write((const char *)&ddsHeader, DDS_HEADER_SIZE);
-                // XXX flipEndian on each pixel chunk written unless isFloat32r ?
-                of.write(dataPtr, (uint32)imgData->size);
-                of.close();
-            }
-            catch(...)
+            else
             {
-                delete [] tmpData;
+                memcpy(dst + headerSize, input->getPtr(), imgData->size);
             }
+            return output;
+        }
+    }
+    //---------------------------------------------------------------------
+    void DDSCodec::encodeToFile(const MemoryDataStreamPtr& input, const String& outFileName,
+                                const Codec::CodecDataPtr& pData) const
+    {
+        MemoryDataStreamPtr data = static_pointer_cast<MemoryDataStream>(encode(input, pData));
+        std::ofstream f(outFileName.c_str(), std::ios::out | std::ios::binary);
+
+        if(!f.is_open()) {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                        "could not open file",
+                        "DDSCodec::encodeToFile" ) ;
+        }
+
+        f.write((char*)data->getPtr(), data->size());
+    }
+    //---------------------------------------------------------------------
+    uint32 DDSCodec::convertOgreToFourCCFormat(PixelFormat format) const
+    {
+        switch (format)
+        {
+        case PF_DXT1:
+            return FOURCC('D','X','T','1');
+        case PF_DXT2:
+            return FOURCC('D','X','T','2');
+        case PF_DXT3:
+            return FOURCC('D','X','T','3');
+        case PF_DXT4:
+            return FOURCC('D','X','T','4');
+        case PF_DXT5:
+            return FOURCC('D','X','T','5');
+        case PF_BC4_UNORM:
+            return FOURCC('B','C','4','U');
+        case PF_BC5_UNORM:
+            return FOURCC('B','C','5','U');
+        default:
+            return FOURCC('D','X','1','0');
+        }
+    }
+    //---------------------------------------------------------------------
+    uint32 DDSCodec::convertOgreToDXFormat(PixelFormat format) const
+    {
+        switch (format)
+        {
+        case PF_BC7_UNORM:
+            return 98; // DXGI_FORMAT_BC7_UNORM
+        default:
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unsupported pixel format",
+                        "DDSCodec::convertOgreToDXFormat");
         }
     }
     //---------------------------------------------------------------------
@@ -621,127 +670,6 @@ namespace Ogre {
             "DDSCodec::convertPixelFormat");
     }
     //---------------------------------------------------------------------
-    void DDSCodec::unpackDXTColour(PixelFormat pf, const DXTColourBlock& block, 
-        ColourValue* pCol) const
-    {
-        // Note - we assume all values have already been endian swapped
-
-        // Colour lookup table
-        ColourValue derivedColours[4];
-
-        if (pf == PF_DXT1 && block.colour_0 <= block.colour_1)
-        {
-            // 1-bit alpha
-            PixelUtil::unpackColour(&(derivedColours[0]), PF_R5G6B5, &(block.colour_0));
-            PixelUtil::unpackColour(&(derivedColours[1]), PF_R5G6B5, &(block.colour_1));
-            // one intermediate colour, half way between the other two
-            derivedColours[2] = (derivedColours[0] + derivedColours[1]) / 2;
-            // transparent colour
-            derivedColours[3] = ColourValue::ZERO;
-        }
-        else
-        {
-            PixelUtil::unpackColour(&(derivedColours[0]), PF_R5G6B5, &(block.colour_0));
-            PixelUtil::unpackColour(&(derivedColours[1]), PF_R5G6B5, &(block.colour_1));
-            // first interpolated colour, 1/3 of the way along
-            derivedColours[2] = (2 * derivedColours[0] + derivedColours[1]) / 3;
-            // second interpolated colour, 2/3 of the way along
-            derivedColours[3] = (derivedColours[0] + 2 * derivedColours[1]) / 3;
-        }
-
-        // Process 4x4 block of texels
-        for (size_t row = 0; row < 4; ++row)
-        {
-            for (size_t x = 0; x < 4; ++x)
-            {
-                // LSB come first
-                uint8 colIdx = static_cast<uint8>(block.indexRow[row] >> (x * 2) & 0x3);
-                if (pf == PF_DXT1)
-                {
-                    // Overwrite entire colour
-                    pCol[(row * 4) + x] = derivedColours[colIdx];
-                }
-                else
-                {
-                    // alpha has already been read (alpha precedes colour)
-                    ColourValue& col = pCol[(row * 4) + x];
-                    col.r = derivedColours[colIdx].r;
-                    col.g = derivedColours[colIdx].g;
-                    col.b = derivedColours[colIdx].b;
-                }
-            }
-
-        }
-
-
-    }
-    //---------------------------------------------------------------------
-    void DDSCodec::unpackDXTAlpha(
-        const DXTExplicitAlphaBlock& block, ColourValue* pCol) const
-    {
-        // Note - we assume all values have already been endian swapped
-        
-        // This is an explicit alpha block, 4 bits per pixel, LSB first
-        for (size_t row = 0; row < 4; ++row)
-        {
-            for (size_t x = 0; x < 4; ++x)
-            {
-                // Shift and mask off to 4 bits
-                uint8 val = static_cast<uint8>(block.alphaRow[row] >> (x * 4) & 0xF);
-                // Convert to [0,1]
-                pCol->a = (Real)val / (Real)0xF;
-                pCol++;
-                
-            }
-            
-        }
-
-    }
-    //---------------------------------------------------------------------
-    void DDSCodec::unpackDXTAlpha(
-        const DXTInterpolatedAlphaBlock& block, ColourValue* pCol) const
-    {
-        // Adaptive 3-bit alpha part
-        float derivedAlphas[8];
-
-        // Explicit extremes
-        derivedAlphas[0] = ((float) block.alpha_0) * (1.0f / 255.0f);
-        derivedAlphas[1] = ((float) block.alpha_1) * (1.0f / 255.0f);
-
-        if(block.alpha_0 > block.alpha_1)
-        {
-            // 6 interpolated alpha values.
-            // full range including extremes at [0] and [7]
-            // we want to fill in [1] through [6] at weights ranging
-            // from 1/7 to 6/7
-            for(size_t i = 1; i < 7; ++i)
-                derivedAlphas[i + 1] = (derivedAlphas[0] * (7 - i) + derivedAlphas[1] * i) * (1.0f / 7.0f);
-        }
-        else
-        {
-            // 4 interpolated alpha values.
-            // full range including extremes at [0] and [5]
-            // we want to fill in [1] through [4] at weights ranging
-            // from 1/5 to 4/5
-            for(size_t i = 1; i < 5; ++i)
-                derivedAlphas[i + 1] = (derivedAlphas[0] * (5 - i) + derivedAlphas[1] * i) * (1.0f / 5.0f);
-
-            derivedAlphas[6] = 0.0f;
-            derivedAlphas[7] = 1.0f;
-        }
-
-        // Ok, now we've built the reference values, process the indexes
-        uint32 dw = block.indexes[0] | (block.indexes[1] << 8) | (block.indexes[2] << 16);
-
-        for(size_t i = 0; i < 8; ++i, dw >>= 3)
-            pCol[i].a = derivedAlphas[dw & 0x7];
-
-        dw = block.indexes[3] | (block.indexes[4] << 8) | (block.indexes[5] << 16);
-
-        for(size_t i = 8; i < 16; ++i, dw >>= 3)
-            pCol[i].a = derivedAlphas[dw & 0x7];
-    }
-    //---------------------------------------------------------------------
     Codec::DecodeResult DDSCodec::decode(const DataStreamPtr& stream) const
     {
         // Read 4 character code
@@ -792,7 +720,7 @@ namespace Ogre {
         }
         imgData->flags = 0;
 
-        bool decompressDXT = false;
+        const PixelBlockDecompression* decompression = 0;
         // Figure out basic image type
         if (header.caps.caps2 & DDSCAPS2_CUBEMAP)
         {
@@ -816,7 +744,7 @@ namespace Ogre {
                 stream->read(&extHeader, sizeof(DDSExtendedHeader));
 
                 // Endian flip if required, all 32-bit values
-                flipEndian(&header, sizeof(DDSExtendedHeader));
+                flipEndian(&extHeader, 4, sizeof(DDSExtendedHeader) / 4);
                 sourceFormat = convertDXToOgreFormat(extHeader.dxgiFormat);
             }
             else
@@ -835,13 +763,24 @@ namespace Ogre {
 
         if (PixelUtil::isCompressed(sourceFormat))
         {
-            if (Root::getSingleton().getRenderSystem() == NULL ||
-                !Root::getSingleton().getRenderSystem()->getCapabilities()->hasCapability(RSC_TEXTURE_COMPRESSION_DXT)
-                || (!Root::getSingleton().getRenderSystem()->getCapabilities()->hasCapability(RSC_AUTOMIPMAP_COMPRESSED)
+            Capabilities family = RSC_TEXTURE_COMPRESSION_DXT;
+            if (sourceFormat >= PF_BC4_UNORM && sourceFormat <= PF_BC5_SNORM)
+                family = RSC_TEXTURE_COMPRESSION_BC4_BC5;
+            else if (sourceFormat >= PF_BC6H_UF16 && sourceFormat <= PF_BC7_UNORM)
+                family = RSC_TEXTURE_COMPRESSION_BC6H_BC7;
+
+            RenderSystem* renderSystem = Root::getSingleton().getRenderSystem();
+            if (renderSystem == NULL ||
+                !renderSystem->getCapabilities()->hasCapability(family)
+                || (!renderSystem->getCapabilities()->hasCapability(RSC_AUTOMIPMAP_COMPRESSED)
                 && !imgData->num_mipmaps))
             {
-                // We'll need to decompress
-                decompressDXT = true;
+                // We'll need to decompress, if we can
+                decompression = _findPixelBlockDecompression(sourceFormat);
+            }
+
+            if (decompression)
+            {
                 // Convert format
                 switch (sourceFormat)
                 {
@@ -853,14 +792,12 @@ namespace Ogre {
                     // values will benefit from the 32-bit results, and the source
                     // from which the 16-bit samples are calculated may have been
                     // 32-bit so can benefit from this.
-                    DXTColourBlock block;
-                    stream->read(&block, sizeof(DXTColourBlock));
-                    flipEndian(&(block.colour_0), sizeof(uint16));
-                    flipEndian(&(block.colour_1), sizeof(uint16));
+                    uint8 block[8];
+                    stream->read(block, sizeof(block));
                     // skip back since we'll need to read this again
-                    stream->skip(0 - (long)sizeof(DXTColourBlock));
+                    stream->skip(0 - (long)sizeof(block));
                     // colour_0 <= colour_1 means transparency in DXT1
-                    if (block.colour_0 <= block.colour_1)
+                    if (_readBlockUint16(block) <= _readBlockUint16(block + 2))
                     {
                         imgData->format = PF_BYTE_RGBA;
                     }
@@ -869,15 +806,24 @@ namespace Ogre {
                         imgData->format = PF_BYTE_RGB;
                     }
                     break;
-                case PF_DXT2:
-                case PF_DXT3:
-                case PF_DXT4:
-                case PF_DXT5:
-                    // full alpha present, formats vary only in encoding 
-                    imgData->format = PF_BYTE_RGBA;
+                case PF_BC4_UNORM:
+                    imgData->format = PF_R8;
+                    break;
+                case PF_BC5_UNORM:
+                    imgData->format = PF_BYTE_RGB;
+                    break;
+                case PF_BC4_SNORM:
+                    imgData->format = PF_FLOAT16_R;
+                    break;
+                case PF_BC5_SNORM:
+                case PF_BC6H_UF16:
+                case PF_BC6H_SF16:
+                    // signed and HDR values need floats
+                    imgData->format = PF_FLOAT16_RGB;
                     break;
                 default:
-                    // all other cases need no special format handling
+                    // full alpha present, formats vary only in encoding 
+                    imgData->format = PF_BYTE_RGBA;
                     break;
                 }
             }
@@ -907,6 +853,9 @@ namespace Ogre {
         // Now deal with the data
         void* destPtr = output->getPtr();
 
+        // compressed blocks of the current mip, when decompressing
+        vector<uint8>::type blocks;
+
         // all mips for a face, then each face
         for(size_t i = 0; i < numFaces; ++i)
         {
@@ -921,94 +870,16 @@ namespace Ogre {
                 if (PixelUtil::isCompressed(sourceFormat))
                 {
                     // Compressed data
-                    if (decompressDXT)
+                    if (decompression)
                     {
-                        DXTColourBlock col;
-                        DXTInterpolatedAlphaBlock iAlpha;
-                        DXTExplicitAlphaBlock eAlpha;
-                        // 4x4 block of decompressed colour
-                        ColourValue tempColours[16];
-                        size_t destBpp = PixelUtil::getNumElemBytes(imgData->format);
-
-                        // slices are done individually
-                        for(size_t z = 0; z < depth; ++z)
-                        {
-                            size_t remainingHeight = height;
-
-                            // 4x4 blocks in x/y
-                            for (size_t y = 0; y < height; y += 4)
-                            {
-                                size_t sy = std::min<size_t>( remainingHeight, 4u );
-                                remainingHeight -= sy;
-
-                                size_t remainingWidth = width;
-
-                                for (size_t x = 0; x < width; x += 4)
-                                {
-                                    size_t sx = std::min<size_t>( remainingWidth, 4u );
-                                    size_t destPitchMinus4 = dstPitch - destBpp * sx;
-
-                                    remainingWidth -= sx;
-
-                                    if (sourceFormat == PF_DXT2 || 
-                                        sourceFormat == PF_DXT3)
-                                    {
-                                        // explicit alpha
-                                        stream->read(&eAlpha, sizeof(DXTExplicitAlphaBlock));
-                                        flipEndian(eAlpha.alphaRow, sizeof(uint16), 4);
-                                        unpackDXTAlpha(eAlpha, tempColours) ;
-                                    }
-                                    else if (sourceFormat == PF_DXT4 || 
-                                        sourceFormat == PF_DXT5)
-                                    {
-                                        // interpolated alpha
-                                        stream->read(&iAlpha, sizeof(DXTInterpolatedAlphaBlock));
-                                        flipEndian(&(iAlpha.alpha_0), sizeof(uint16));
-                                        flipEndian(&(iAlpha.alpha_1), sizeof(uint16));
-                                        unpackDXTAlpha(iAlpha, tempColours) ;
-                                    }
-                                    // always read colour
-                                    stream->read(&col, sizeof(DXTColourBlock));
-                                    flipEndian(&(col.colour_0), sizeof(uint16));
-                                    flipEndian(&(col.colour_1), sizeof(uint16));
-                                    unpackDXTColour(sourceFormat, col, tempColours);
-
-                                    // write 4x4 block to uncompressed version
-                                    for (size_t by = 0; by < sy; ++by)
-                                    {
-                                        for (size_t bx = 0; bx < sx; ++bx)
-                                        {
-                                            PixelUtil::packColour(tempColours[by*4+bx],
-                                                imgData->format, destPtr);
-                                            destPtr = static_cast<void*>(
-                                                static_cast<uchar*>(destPtr) + destBpp);
-                                        }
-                                        // advance to next row
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) + destPitchMinus4);
-                                    }
-                                    // next block. Our dest pointer is 4 lines down
-                                    // from where it started
-                                    if (x + 4 >= width)
-                                    {
-                                        // Jump back to the start of the line
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) - destPitchMinus4);
-                                    }
-                                    else
-                                    {
-                                        // Jump back up 4 rows and 4 pixels to the
-                                        // right to be at the next block to the right
-                                        destPtr = static_cast<void*>(
-                                            static_cast<uchar*>(destPtr) - dstPitch * sy + destBpp * sx);
-
-                                    }
-
-                                }
-
-                            }
-                        }
-
+                        // all slices of the mip at once, the blocks are decoded in parallel
+                        size_t srcSize = PixelUtil::getMemorySize(width, height, depth, sourceFormat);
+                        blocks.resize(srcSize);
+                        stream->read(&blocks[0], srcSize);
+                        PixelBox src(width, height, depth, sourceFormat, &blocks[0]);
+                        PixelBox dst(width, height, depth, imgData->format, destPtr);
+                        _decompressPixelBlocks(*decompression, src, dst);
+                        destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dst.getConsecutiveSize());
                     }
                     else
                     {
@@ -1022,15 +893,11 @@ namespace Ogre {
                 }
                 else
                 {
-                    // Note: We assume the source and destination have the same pitch
-                    for (size_t z = 0; z < depth; ++z)
-                    {
-                        for (size_t y = 0; y < height; ++y)
-                        {
-                            stream->read(destPtr, dstPitch);
-                            destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + dstPitch);
-                        }
-                    }
+                    // Note: We assume the source and destination have the same pitch,
+                    // so all slices of the mip can be read at once
+                    size_t mipSize = dstPitch * height * depth;
+                    stream->read(destPtr, mipSize);
+                    destPtr = static_cast<void*>(static_cast<uchar*>(destPtr) + mipSize);
                 }
 
                 /// Next mip
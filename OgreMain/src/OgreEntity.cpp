@@ -36,6 +36,25 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 
 
 namespace Ogre {
+    /// State kept between the phases of an animation update
+    struct Entity::PendingAnimationUpdate : public AnimationAlloc
+    {
+        /// A software skinning blend waiting for the bone matrices
+        struct VertexBlend
+        {
+            Mesh::SoftwareBlendData data;
+            const Mesh::IndexMap* indexMap;
+        };
+        typedef vector<VertexBlend>::type VertexBlendList;
+
+        VertexBlendList vertexBlends;
+        /// Whether the bone matrices have to be cached
+        bool updateBones;
+        /// Whether the child objects have to be updated even if the parent didn't move
+        bool updateChildren;
+
+        PendingAnimationUpdate() : updateBones(false), updateChildren(false) {}
+    };
     //-----------------------------------------------------------------------
     Entity::Entity ()
         : mAnimationState(NULL),
@@ -608,6 +627,13 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    bool Entity::_supportsParallelRenderQueueUpdate(void) const
+    {
+        // a reloaded mesh makes _updateRenderQueue reinitialise the entity
+        return mInitialised && !mListener && !hasSkeleton() && !hasVertexAnimation() &&
+               mMesh->getStateCount() == mMeshStateCount;
+    }
+    //-----------------------------------------------------------------------
     void Entity::_updateRenderQueue(RenderQueue* queue)
     {
         // Do nothing if not initialised yet
@@ -823,10 +849,25 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void Entity::updateAnimation(void)
+    {
+        HardwareBufferLockSet locks;
+        if (_prepareAnimationUpdate(locks))
+            _executeAnimationUpdate();
+        locks.unlockAll();
+        _finishAnimationUpdate();
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::_prepareAnimationUpdate(HardwareBufferLockSet& locks)
     {
         // Do nothing if not initialised yet
         if (!mInitialised)
-            return;
+            return false;
+
+        if (!mPendingAnimationUpdate)
+            mPendingAnimationUpdate.reset(OGRE_NEW PendingAnimationUpdate());
+        PendingAnimationUpdate& pending = *mPendingAnimationUpdate;
+        pending.vertexBlends.clear();
+        pending.updateBones = false;
 
         Root& root = Root::getSingleton();
         bool hwAnimation = isHardwareAnimationEnabled();
@@ -893,12 +934,27 @@ namespace Ogre {
 
             if (hasSkeleton())
             {
-                cacheBoneMatrices();
+                pending.updateBones = true;
+
+                // The animations are shared with other skeleton instances, which
+                // may be updated at the same time
+                if (!mSkipAnimStateUpdates)
+                {
+                    EnabledAnimationStateList::const_iterator animIt;
+                    for (animIt = mAnimationState->getEnabledAnimationStates().begin();
+                         animIt != mAnimationState->getEnabledAnimationStates().end(); ++animIt)
+                    {
+                        Animation* anim =
+                            mSkeletonInstance->_getAnimationImpl((*animIt)->getAnimationName());
+                        if (anim)
+                            anim->_prepareConcurrentApply();
+                    }
+                }
 
                 // Software blend?
                 if (softwareAnimation)
                 {
-                    const Affine3* blendMatrices[256];
+                    PendingAnimationUpdate::VertexBlend blend;
 
                     // Ok, we need to do a software blend
                     // Firstly, check out working vertex buffers
@@ -911,16 +967,13 @@ namespace Ogre {
                         mTempSkelAnimInfo.checkoutTempCopies(true, blendNormals);
                         mTempSkelAnimInfo.bindTempCopies(mSkelAnimVertexData.get(),
                                                          hwAnimation);
-                        // Prepare blend matrices, TODO: Move out of here
-                        Mesh::prepareMatricesForVertexBlend(blendMatrices,
-                                                            mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
                         // Blend, taking source from either mesh data or morph data
-                        Mesh::softwareVertexBlend(
+                        Mesh::lockForSoftwareVertexBlend(
                             (mMesh->getSharedVertexDataAnimationType() != VAT_NONE) ?
                             mSoftwareVertexAnimVertexData.get() : mMesh->sharedVertexData,
-                            mSkelAnimVertexData.get(),
-                            blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
-                            blendNormals);
+                            mSkelAnimVertexData.get(), blendNormals, locks, blend.data);
+                        blend.indexMap = &mMesh->sharedBlendIndexToBoneIndexMap;
+                        pending.vertexBlends.push_back(blend);
                     }
                     SubEntityList::iterator i, iend;
                     iend = mSubEntityList.end();
@@ -933,16 +986,13 @@ namespace Ogre {
                             se->mTempSkelAnimInfo.checkoutTempCopies(true, blendNormals);
                             se->mTempSkelAnimInfo.bindTempCopies(se->mSkelAnimVertexData.get(),
                                                                  hwAnimation);
-                            // Prepare blend matrices, TODO: Move out of here
-                            Mesh::prepareMatricesForVertexBlend(blendMatrices,
-                                                                mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
                             // Blend, taking source from either mesh data or morph data
-                            Mesh::softwareVertexBlend(
+                            Mesh::lockForSoftwareVertexBlend(
                                 (se->getSubMesh()->getVertexAnimationType() != VAT_NONE)?
                                 se->mSoftwareVertexAnimVertexData.get() : se->mSubMesh->vertexData,
-                                se->mSkelAnimVertexData.get(),
-                                blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
-                                blendNormals);
+                                se->mSkelAnimVertexData.get(), blendNormals, locks, blend.data);
+                            blend.indexMap = &se->mSubMesh->blendIndexToBoneIndexMap;
+                            pending.vertexBlends.push_back(blend);
                         }
 
                     }
@@ -957,11 +1007,40 @@ namespace Ogre {
             mFrameAnimationLastUpdated = mAnimationState->getDirtyFrameNumber();
         }
 
+        pending.updateChildren = isNeedUpdateHardwareAnim || animationDirty;
+
+        return pending.updateBones;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_executeAnimationUpdate(void)
+    {
+        PendingAnimationUpdate& pending = *mPendingAnimationUpdate;
+        if (!pending.updateBones)
+            return;
+
+        cacheBoneMatrices();
+        pending.updateBones = false;
+
+        const Affine3* blendMatrices[256];
+        PendingAnimationUpdate::VertexBlendList::iterator i;
+        for (i = pending.vertexBlends.begin(); i != pending.vertexBlends.end(); ++i)
+        {
+            Mesh::prepareMatricesForVertexBlend(blendMatrices, mBoneMatrices, *i->indexMap);
+            Mesh::softwareVertexBlend(i->data, blendMatrices);
+        }
+        pending.vertexBlends.clear();
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_finishAnimationUpdate(void)
+    {
+        if (!mInitialised || !mPendingAnimationUpdate)
+            return;
+
         // Need to update the child object's transforms when animation dirty
         // or parent node transform has altered.
         if (hasSkeleton() && 
-            (isNeedUpdateHardwareAnim || 
-             animationDirty || mLastParentXform != _getParentNodeFullTransform()))
+            (mPendingAnimationUpdate->updateChildren ||
+             mLastParentXform != _getParentNodeFullTransform()))
         {
             // Cache last parent transform for next frame use too.
             mLastParentXform = _getParentNodeFullTransform();
@@ -976,7 +1055,7 @@ namespace Ogre {
 
             // Also calculate bone world matrices, since are used as replacement world matrices,
             // but only if it's used (when using hardware animation and skeleton animated).
-            if (hwAnimation && _isSkeletonAnimated())
+            if (mCurrentHWAnimationState && _isSkeletonAnimated())
             {
                 // Allocate bone world matrices on demand, for better memory footprint
                 // when using software animation.
@@ -993,6 +1072,7 @@ namespace Ogre {
                     mNumBoneMatrices);
             }
         }
+        mPendingAnimationUpdate->updateChildren = false;
     }
     //-----------------------------------------------------------------------
     ushort Entity::initHardwareAnimationElements(VertexData* vdata,
@@ -35,6 +35,9 @@ THE SOFTWARE.
     OGRE_PLATFORM == OGRE_PLATFORM_EMSCRIPTEN
 #   include "OgreSearchOps.h"
 #   include <sys/param.h>
+#   include <sys/mman.h>
+#   include <fcntl.h>
+#   include <unistd.h>
 #endif
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT
@@ -115,7 +118,33 @@ namespace {
         time_t getModifiedTime(const String& filename) const;
     };
 
+    /** Read-only stream over a memory mapped file.
+    @remarks
+        Being a MemoryDataStream, the file contents can be parsed in place through
+        getPtr, without copying them to an intermediate buffer first.
+    */
+    class MappedFileDataStream : public MemoryDataStream
+    {
+    public:
+        MappedFileDataStream(const String& name, void* data, size_t size)
+            : MemoryDataStream(name, data, size, false, true) {}
+        ~MappedFileDataStream() { close(); }
+
+        void close(void)
+        {
+            if (!mData)
+                return;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            UnmapViewOfFile(mData);
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+            munmap(mData, mSize);
+#endif
+            mData = mPos = mEnd = 0;
+        }
+    };
+
     bool gIgnoreHidden = true;
+    bool gUseMemoryMapping = false;
 }
 
     //-----------------------------------------------------------------------
@@ -190,6 +219,50 @@ namespace {
 		return "";
 	}
 #endif
+    //-----------------------------------------------------------------------
+    /// Maps the file read-only, returns a null pointer if that is not possible
+    static DataStreamPtr map_file(const String& filename, const String& full_path, size_t size)
+    {
+        // cannot map empty files
+        if (size == 0)
+            return DataStreamPtr();
+
+        void* data = 0;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
+        HANDLE file = CreateFileW(to_wpath(full_path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+        HANDLE file = CreateFileA(full_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+        if (file == INVALID_HANDLE_VALUE)
+            return DataStreamPtr();
+
+        // the view keeps the mapping alive, so both handles can be closed right away
+        HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+        int fd = ::open(full_path.c_str(), O_RDONLY);
+        if (fd == -1)
+            return DataStreamPtr();
+
+        // the mapping stays valid after closing the descriptor
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+            data = 0;
+#endif
+        if (!data)
+            return DataStreamPtr();
+
+        return DataStreamPtr(OGRE_NEW MappedFileDataStream(filename, data, size));
+    }
     //-----------------------------------------------------------------------
     void FileSystemArchive::findFiles(const String& pattern, bool recursive, 
         bool dirs, StringVector* simpleList, FileInfoList* detailList) const
@@ -342,6 +415,14 @@ namespace {
         assert(ret == 0 && "Problem getting file size" );
         (void)ret;  // Silence warning
 
+        if (readOnly && gUseMemoryMapping)
+        {
+            DataStreamPtr mapped = map_file(filename, full_path, (size_t)tagStat.st_size);
+            if (mapped)
+                return mapped;
+            // fall back to a file stream, e.g. for empty files
+        }
+
         // Always open in binary mode
         // Also, always include reading
         std::ios::openmode mode = std::ios::in | std::ios::binary;
@@ -577,4 +658,14 @@ namespace {
     {
         return gIgnoreHidden;
     }
+
+    void FileSystemArchiveFactory::setUseMemoryMapping(bool use)
+    {
+        gUseMemoryMapping = use;
+    }
+
+    bool FileSystemArchiveFactory::getUseMemoryMapping()
+    {
+        return gUseMemoryMapping;
+    }
 }
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "OgreMovablePlane.h"
+#include "OgreOptimisedUtil.h"
 
 namespace Ogre {
 
@@ -248,6 +249,75 @@ namespace Ogre {
         return true;
     }
 
+    //-----------------------------------------------------------------------
+    void Frustum::areVisible(const AxisAlignedBox* const* bounds, size_t numBounds,
+        char* visibilities) const
+    {
+        for (size_t i = 0; i < numBounds; ++i)
+            visibilities[i] = isVisible(*bounds[i]);
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::areVisibleImpl(const AxisAlignedBox* const* bounds, size_t numBounds,
+        char* visibilities) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        // Skip far plane if infinite view frustum
+        Plane planes[6];
+        size_t numPlanes = 0;
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            if (plane != FRUSTUM_PLANE_FAR || mFarDist != 0)
+                planes[numPlanes++] = mFrustumPlanes[plane];
+        }
+
+        // Convert the boxes to the structure-of-arrays layout
+        // OptimisedUtil expects, a chunk at a time
+        const size_t chunkSize = 64;
+        OGRE_SIMD_ALIGNED_DECL(float, boxes[chunkSize / 4 * 24]);
+        OptimisedUtil* util = OptimisedUtil::getImplementation();
+
+        for (size_t start = 0; start < numBounds; start += chunkSize)
+        {
+            size_t count = std::min(chunkSize, numBounds - start);
+            // Keep the padding of the last block free of garbage values
+            if (count % 4)
+                memset(boxes + (count / 4) * 24, 0, 24 * sizeof(float));
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const AxisAlignedBox& bound = *bounds[start + i];
+                float* block = boxes + (i / 4) * 24 + (i % 4);
+                if (bound.isFinite())
+                {
+                    Vector3 centre = bound.getCenter();
+                    Vector3 halfSize = bound.getHalfSize();
+                    block[0] = centre.x;
+                    block[4] = centre.y;
+                    block[8] = centre.z;
+                    block[12] = halfSize.x;
+                    block[16] = halfSize.y;
+                    block[20] = halfSize.z;
+                }
+                else
+                {
+                    block[0] = block[4] = block[8] = 0;
+                    block[12] = block[16] = block[20] = 0;
+                }
+            }
+
+            util->cullAxisAlignedBoxes(planes, numPlanes, boxes, visibilities + start, count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                // Null boxes always invisible, infinite boxes always visible
+                const AxisAlignedBox& bound = *bounds[start + i];
+                if (!bound.isFinite())
+                    visibilities[start + i] = bound.isInfinite();
+            }
+        }
+    }
     //-----------------------------------------------------------------------
     bool Frustum::isVisible(const Vector3& vert, FrustumPlane* culledBy) const
     {
@@ -926,6 +926,7 @@ namespace Ogre
         , mIgnoreMissingParams(false)
         , mActivePassIterationIndex(std::numeric_limits<size_t>::max())
     {
+        invalidateAutoParamVersions();
     }
     //-----------------------------------------------------------------------------
 
@@ -957,10 +958,22 @@ namespace Ogre
         mTransposeMatrices = oth.mTransposeMatrices;
         mIgnoreMissingParams  = oth.mIgnoreMissingParams;
         mActivePassIterationIndex = oth.mActivePassIterationIndex;
+        // the values were copied too, so they are as up to date as the originals
+        std::copy(oth.mAutoParamVersions, oth.mAutoParamVersions + 3, mAutoParamVersions);
+        mAutoParamPass = oth.mAutoParamPass;
+        mAutoParamPassNumber = oth.mAutoParamPassNumber;
 
         return *this;
     }
     //---------------------------------------------------------------------
+    void GpuProgramParameters::invalidateAutoParamVersions(void)
+    {
+        // versions start at 1, so no data source matches these
+        std::fill(mAutoParamVersions, mAutoParamVersions + 3, 0);
+        mAutoParamPass = 0;
+        mAutoParamPassNumber = -1;
+    }
+    //---------------------------------------------------------------------
     void GpuProgramParameters::copySharedParamSetUsage(const GpuSharedParamUsageList& srcList)
     {
         mSharedParamSets.clear();
@@ -2262,6 +2275,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, extraInfo, variability, elementSize));
 
         mCombinedVariability |= variability;
+        invalidateAutoParamVersions();
 
 
     }
@@ -2312,6 +2326,7 @@ namespace Ogre
             mAutoConstants.push_back(AutoConstantEntry(acType, physicalIndex, rData, variability, elementSize));
 
         mCombinedVariability |= variability;
+        invalidateAutoParamVersions();
     }
     //-----------------------------------------------------------------------------
     void GpuProgramParameters::clearAutoConstant(size_t index)
@@ -2400,6 +2415,36 @@ namespace Ogre
         if (!(mask & mCombinedVariability))
             return;
 
+        mActivePassIterationIndex = std::numeric_limits<size_t>::max();
+
+        // skip the autos which are up to date with the source data already
+        uint16 upToDate = 0;
+        const Pass* pass = source->getCurrentPass();
+        int passNumber = source->getPassNumber();
+        if (mAutoParamVersions[0] == source->getVersion(GPV_GLOBAL) &&
+            mAutoParamPass == pass && mAutoParamPassNumber == passNumber)
+            upToDate |= GPV_GLOBAL;
+        if (mAutoParamVersions[1] == source->getVersion(GPV_PER_OBJECT))
+            upToDate |= GPV_PER_OBJECT;
+        if (mAutoParamVersions[2] == source->getVersion(GPV_LIGHTS))
+            upToDate |= GPV_LIGHTS;
+
+        // everything in the mask is recomputed below, so it will be up to date afterwards
+        if (mask & GPV_GLOBAL)
+        {
+            mAutoParamVersions[0] = source->getVersion(GPV_GLOBAL);
+            mAutoParamPass = pass;
+            mAutoParamPassNumber = passNumber;
+        }
+        if (mask & GPV_PER_OBJECT)
+            mAutoParamVersions[1] = source->getVersion(GPV_PER_OBJECT);
+        if (mask & GPV_LIGHTS)
+            mAutoParamVersions[2] = source->getVersion(GPV_LIGHTS);
+
+        mask &= ~upToDate;
+        if (!(mask & mCombinedVariability))
+            return;
+
         size_t index;
         size_t numMatrices;
         const Affine3* pMatrix;
@@ -2410,8 +2455,6 @@ namespace Ogre
         Matrix4 scaleM;
         DualQuaternion dQuat;
 
-        mActivePassIterationIndex = std::numeric_limits<size_t>::max();
-
         // Autoconstant index is not a physical index
         for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
         {
@@ -3430,6 +3473,7 @@ namespace Ogre
         mAutoConstants = source.getAutoConstantList();
         mCombinedVariability = source.mCombinedVariability;
         copySharedParamSetUsage(source.mSharedParamSets);
+        invalidateAutoParamVersions();
     }
     //---------------------------------------------------------------------
     void GpuProgramParameters::copyMatchingNamedConstantsFrom(const GpuProgramParameters& source)
@@ -0,0 +1,58 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreHardwareBuffer.h"
+
+#include <atomic>
+
+namespace Ogre {
+
+    namespace
+    {
+        const size_t NUM_LOCK_OPTIONS = HardwareBuffer::HBL_WRITE_ONLY + 1;
+
+        // relaxed atomics, so locking from background threads stays cheap
+        std::atomic<size_t> gLockCounts[NUM_LOCK_OPTIONS];
+        std::atomic<size_t> gLockedBytes[NUM_LOCK_OPTIONS];
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBuffer::_notifyLocked(LockOptions options, size_t length)
+    {
+        gLockCounts[options].fetch_add(1, std::memory_order_relaxed);
+        gLockedBytes[options].fetch_add(length, std::memory_order_relaxed);
+    }
+    //-----------------------------------------------------------------------
+    void HardwareBuffer::_collectLockStatistics(size_t* counts, size_t* bytes)
+    {
+        for (size_t i = 0; i < NUM_LOCK_OPTIONS; ++i)
+        {
+            counts[i] = gLockCounts[i].exchange(0, std::memory_order_relaxed);
+            bytes[i] = gLockedBytes[i].exchange(0, std::memory_order_relaxed);
+        }
+    }
+}
@@ -79,6 +79,8 @@ namespace Ogre
         else
         {
             // Lock the real buffer if there is no shadow buffer 
+            _notifyLocked(options, PixelUtil::getMemorySize(lockBox.getWidth(), lockBox.getHeight(),
+                                                            lockBox.getDepth(), mFormat));
             mCurrentLock = lockImpl(lockBox, options);
             mIsLocked = true;
         }
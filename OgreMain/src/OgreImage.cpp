@@ -29,8 +29,42 @@ THE SOFTWARE.
 #include "OgreImage.h"
 #include "OgreImageCodec.h"
 #include "OgreImageResampler.h"
+#include "OgrePixelBlockCompression.h"
 
 namespace Ogre {
+    /// formats with 1 byte per channel, which the byte resamplers handle
+    static bool isByteFormat(PixelFormat format)
+    {
+        switch (format)
+        {
+        case PF_L8: case PF_A8: case PF_BYTE_LA:
+        case PF_R8G8B8: case PF_B8G8R8:
+        case PF_R8G8B8A8: case PF_B8G8R8A8:
+        case PF_A8B8G8R8: case PF_A8R8G8B8:
+        case PF_X8B8G8R8: case PF_X8R8G8B8:
+            return true;
+        default:
+            return false;
+        }
+    }
+    //-----------------------------------------------------------------------
+    static void scaleFloat32RGBA(const PixelBox &src, const PixelBox &dst, Image::Filter filter)
+    {
+        switch (filter)
+        {
+        case Image::FILTER_NEAREST:
+            ResamplerPass<NearestResampler<16> >::scale(src, dst);
+            break;
+        case Image::FILTER_LINEAR:
+        case Image::FILTER_BILINEAR:
+            ResamplerPass<LinearResampler_Float32>::scale(src, dst);
+            break;
+        default:
+            FilterResampler(src, dst, filter).scale();
+            break;
+        }
+    }
+    //-----------------------------------------------------------------------------
     ImageCodec::~ImageCodec() {
     }
 
@@ -365,6 +399,8 @@ namespace Ogre {
         imgData->height = mHeight;
         imgData->width = mWidth;
         imgData->depth = mDepth;
+        imgData->size = mBufSize;
+        imgData->num_mipmaps = mNumMipmaps;
         // Wrap in CodecDataPtr, this will delete
         Codec::CodecDataPtr codeDataPtr(imgData);
         // Wrap memory, be sure not to delete when stream destroyed
@@ -574,12 +610,142 @@ namespace Ogre {
         Image::scale(temp.getPixelBox(), getPixelBox(), filter);
     }
     //-----------------------------------------------------------------------
-    void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter) 
+    bool Image::generateMipmaps(bool gammaCorrected, Filter filter)
+    {
+        if (PixelUtil::isCompressed(mFormat) || !PixelUtil::isAccessible(mFormat))
+            return false;
+
+        uint32 numMipmaps = 0;
+        for (uint32 w = mWidth, h = mHeight, d = mDepth; w > 1 || h > 1 || d > 1; ++numMipmaps)
+        {
+            w = std::max(w / 2, 1u);
+            h = std::max(h / 2, 1u);
+            d = std::max(d / 2, 1u);
+        }
+        size_t numFaces = getNumFaces();
+
+        // hand the current buffer to base, which deletes it if we own it
+        Image base;
+        base.loadDynamicImage(mBuffer, mWidth, mHeight, mDepth, mFormat, mAutoDelete, numFaces, mNumMipmaps);
+        mAutoDelete = false;
+        uint32 width = mWidth, height = mHeight, depth = mDepth;
+        uchar* buffer = OGRE_ALLOC_T(uchar, calculateSize(numMipmaps, numFaces, width, height, depth, mFormat),
+                                     MEMCATEGORY_GENERAL);
+        loadDynamicImage(buffer, width, height, depth, mFormat, true, numFaces, numMipmaps);
+
+        // these scale without converting the pixels
+        const bool direct = !gammaCorrected &&
+            (filter == FILTER_NEAREST || (isByteFormat(mFormat) && filter != FILTER_TRIANGLE &&
+                                          filter != FILTER_BICUBIC && filter != FILTER_LANCZOS &&
+                                          filter != FILTER_KAISER));
+
+        for (size_t face = 0; face < numFaces; ++face)
+        {
+            PixelUtil::bulkPixelConversion(base.getPixelBox(face, 0), getPixelBox(face, 0));
+            if (direct)
+            {
+                for (uint32 mip = 1; mip <= numMipmaps; ++mip)
+                    scale(getPixelBox(face, mip - 1), getPixelBox(face, mip), filter);
+                continue;
+            }
+
+            // keep the previous level in floating point linear colour space
+            PixelBox level = getPixelBox(face, 0);
+            vector<float>::type buffers[2];
+            buffers[0].resize(level.getWidth() * level.getHeight() * level.getDepth() * 4);
+            PixelBox prev(level.getWidth(), level.getHeight(), level.getDepth(), PF_FLOAT32_RGBA, &buffers[0][0]);
+            if (gammaCorrected)
+                PixelUtil::convertSRGBToLinear(level, prev);
+            else
+                PixelUtil::bulkPixelConversion(level, prev);
+
+            for (uint32 mip = 1; mip <= numMipmaps; ++mip)
+            {
+                level = getPixelBox(face, mip);
+                vector<float>::type& next = buffers[mip & 1];
+                next.resize(level.getWidth() * level.getHeight() * level.getDepth() * 4);
+                PixelBox cur(level.getWidth(), level.getHeight(), level.getDepth(), PF_FLOAT32_RGBA, &next[0]);
+                scaleFloat32RGBA(prev, cur, filter);
+                if (gammaCorrected)
+                    PixelUtil::convertLinearToSRGB(cur, level);
+                else
+                    PixelUtil::bulkPixelConversion(cur, level);
+                prev = cur;
+            }
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    bool Image::compress(PixelFormat format, CompressionQuality quality)
+    {
+        const PixelBlockCompression* compression = _findPixelBlockCompression(format);
+        if (!compression || PixelUtil::isCompressed(mFormat) || !PixelUtil::isAccessible(mFormat))
+            return false;
+
+        size_t numFaces = getNumFaces();
+
+        // hand the current buffer to base, which deletes it if we own it
+        Image base;
+        base.loadDynamicImage(mBuffer, mWidth, mHeight, mDepth, mFormat, mAutoDelete, numFaces, mNumMipmaps);
+        mAutoDelete = false;
+        uint32 width = mWidth, height = mHeight, depth = mDepth, numMipmaps = mNumMipmaps;
+        uchar* buffer = OGRE_ALLOC_T(uchar, calculateSize(numMipmaps, numFaces, width, height, depth, format),
+                                     MEMCATEGORY_GENERAL);
+        loadDynamicImage(buffer, width, height, depth, format, true, numFaces, numMipmaps);
+
+        for (size_t face = 0; face < numFaces; ++face)
+        {
+            for (uint32 mip = 0; mip <= numMipmaps; ++mip)
+                _compressPixelBlocks(*compression, base.getPixelBox(face, mip), getPixelBox(face, mip), quality);
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void Image::scale(const PixelBox &src, const PixelBox &scaled, Filter filter, bool gammaCorrected)
     {
         assert(PixelUtil::isAccessible(src.format));
         assert(PixelUtil::isAccessible(scaled.format));
         MemoryDataStreamPtr buf; // For auto-delete
         PixelBox temp;
+
+        bool byteFormat = isByteFormat(src.format);
+        bool separable = filter == FILTER_TRIANGLE || filter == FILTER_BICUBIC ||
+                         filter == FILTER_LANCZOS || filter == FILTER_KAISER ||
+                         (filter == FILTER_BOX && !(byteFormat && BoxResampler_Byte<1>::canScale(src, scaled)));
+        if (filter != FILTER_NEAREST && (gammaCorrected || separable))
+        {
+            // filter PF_FLOAT32_RGBA in linear colour space
+            MemoryDataStreamPtr dstBuf;
+            PixelBox floatSrc = src, floatDst = scaled;
+            if (gammaCorrected || src.format != PF_FLOAT32_RGBA)
+            {
+                floatSrc = PixelBox(src.getWidth(), src.getHeight(), src.getDepth(), PF_FLOAT32_RGBA);
+                buf.reset(OGRE_NEW MemoryDataStream(floatSrc.getConsecutiveSize()));
+                floatSrc.data = buf->getPtr();
+                if (gammaCorrected)
+                    PixelUtil::convertSRGBToLinear(src, floatSrc);
+                else
+                    PixelUtil::bulkPixelConversion(src, floatSrc);
+            }
+            if (gammaCorrected || scaled.format != PF_FLOAT32_RGBA)
+            {
+                floatDst = PixelBox(scaled.getWidth(), scaled.getHeight(), scaled.getDepth(), PF_FLOAT32_RGBA);
+                dstBuf.reset(OGRE_NEW MemoryDataStream(floatDst.getConsecutiveSize()));
+                floatDst.data = dstBuf->getPtr();
+            }
+
+            scaleFloat32RGBA(floatSrc, floatDst, filter);
+
+            if (floatDst.data != scaled.data)
+            {
+                if (gammaCorrected)
+                    PixelUtil::convertLinearToSRGB(floatDst, scaled);
+                else
+                    PixelUtil::bulkPixelConversion(floatDst, scaled);
+            }
+            return;
+        }
+
         switch (filter) 
         {
         default:
@@ -599,14 +765,14 @@ namespace Ogre {
             // super-optimized: no conversion
             switch (PixelUtil::getNumElemBytes(src.format)) 
             {
-            case 1: NearestResampler<1>::scale(src, temp); break;
-            case 2: NearestResampler<2>::scale(src, temp); break;
-            case 3: NearestResampler<3>::scale(src, temp); break;
-            case 4: NearestResampler<4>::scale(src, temp); break;
-            case 6: NearestResampler<6>::scale(src, temp); break;
-            case 8: NearestResampler<8>::scale(src, temp); break;
-            case 12: NearestResampler<12>::scale(src, temp); break;
-            case 16: NearestResampler<16>::scale(src, temp); break;
+            case 1: ResamplerPass<NearestResampler<1> >::scale(src, temp); break;
+            case 2: ResamplerPass<NearestResampler<2> >::scale(src, temp); break;
+            case 3: ResamplerPass<NearestResampler<3> >::scale(src, temp); break;
+            case 4: ResamplerPass<NearestResampler<4> >::scale(src, temp); break;
+            case 6: ResamplerPass<NearestResampler<6> >::scale(src, temp); break;
+            case 8: ResamplerPass<NearestResampler<8> >::scale(src, temp); break;
+            case 12: ResamplerPass<NearestResampler<12> >::scale(src, temp); break;
+            case 16: ResamplerPass<NearestResampler<16> >::scale(src, temp); break;
             default:
                 // never reached
                 assert(false);
@@ -618,15 +784,11 @@ namespace Ogre {
             }
             break;
 
+        case FILTER_BOX:
         case FILTER_LINEAR:
         case FILTER_BILINEAR:
-            switch (src.format) 
+            if (byteFormat)
             {
-            case PF_L8: case PF_A8: case PF_BYTE_LA:
-            case PF_R8G8B8: case PF_B8G8R8:
-            case PF_R8G8B8A8: case PF_B8G8R8A8:
-            case PF_A8B8G8R8: case PF_A8R8G8B8:
-            case PF_X8B8G8R8: case PF_X8R8G8B8:
                 if(src.format == scaled.format) 
                 {
                     // No intermediate buffer needed
@@ -640,34 +802,48 @@ namespace Ogre {
                     temp.data = buf->getPtr();
                 }
                 // super-optimized: byte-oriented math, no conversion
-                switch (PixelUtil::getNumElemBytes(src.format)) 
+                if (filter == FILTER_BOX)
                 {
-                case 1: LinearResampler_Byte<1>::scale(src, temp); break;
-                case 2: LinearResampler_Byte<2>::scale(src, temp); break;
-                case 3: LinearResampler_Byte<3>::scale(src, temp); break;
-                case 4: LinearResampler_Byte<4>::scale(src, temp); break;
-                default:
-                    // never reached
-                    assert(false);
+                    switch (PixelUtil::getNumElemBytes(src.format)) 
+                    {
+                    case 1: ResamplerPass<BoxResampler_Byte<1> >::scale(src, temp); break;
+                    case 2: ResamplerPass<BoxResampler_Byte<2> >::scale(src, temp); break;
+                    case 3: ResamplerPass<BoxResampler_Byte<3> >::scale(src, temp); break;
+                    case 4: ResamplerPass<BoxResampler_Byte<4> >::scale(src, temp); break;
+                    default:
+                        // never reached
+                        assert(false);
+                    }
+                }
+                else
+                {
+                    switch (PixelUtil::getNumElemBytes(src.format)) 
+                    {
+                    case 1: ResamplerPass<LinearResampler_Byte<1> >::scale(src, temp); break;
+                    case 2: ResamplerPass<LinearResampler_Byte<2> >::scale(src, temp); break;
+                    case 3: ResamplerPass<LinearResampler_Byte<3> >::scale(src, temp); break;
+                    case 4: ResamplerPass<LinearResampler_Byte<4> >::scale(src, temp); break;
+                    default:
+                        // never reached
+                        assert(false);
+                    }
                 }
                 if(temp.data != scaled.data)
                 {
                     // Blit temp buffer
                     PixelUtil::bulkPixelConversion(temp, scaled);
                 }
-                break;
-            case PF_FLOAT32_RGB:
-            case PF_FLOAT32_RGBA:
-                if (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA)
-                {
-                    // float32 to float32, avoid unpack/repack overhead
-                    LinearResampler_Float32::scale(src, scaled);
-                    break;
-                }
-                // else, fall through
-            default:
+            }
+            else if ((src.format == PF_FLOAT32_RGB || src.format == PF_FLOAT32_RGBA) &&
+                     (scaled.format == PF_FLOAT32_RGB || scaled.format == PF_FLOAT32_RGBA))
+            {
+                // float32 to float32, avoid unpack/repack overhead
+                ResamplerPass<LinearResampler_Float32>::scale(src, scaled);
+            }
+            else
+            {
                 // non-optimized: floating-point math, performs conversion but always works
-                LinearResampler::scale(src, scaled);
+                ResamplerPass<LinearResampler>::scale(src, scaled);
             }
             break;
         }
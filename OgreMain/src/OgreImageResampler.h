@@ -29,6 +29,14 @@ THE SOFTWARE.
 #define OGREIMAGERESAMPLER_H
 
 #include <algorithm>
+#include "OgreRoot.h"
+#include "OgreTaskScheduler.h"
+
+#if __OGRE_HAVE_SSE && OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
+#   include <xmmintrin.h>
+#elif __OGRE_HAVE_NEON
+#   include <arm_neon.h>
+#endif
 
 // this file is inlined into OgreImage.cpp!
 // do not include anywhere else.
@@ -40,6 +48,10 @@ namespace Ogre {
     *  @{
     */
 
+// All resamplers process a range of destination rows, numbered
+// z * dst.getHeight() + y, so the rows can be split across threads with
+// processRowsParallel.
+
 // variable name hints:
 // sx_48 = 16/48-bit fixed-point x-position in source
 // stepx = difference between adjacent sx_48 values
@@ -52,12 +64,12 @@ namespace Ogre {
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as simplifying memcpy() and replacing multiplies with bitshifts
 template<unsigned int elemsize> struct NearestResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t begin, size_t end) {
         // assert(src.format == dst.format);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -65,40 +77,52 @@ template<unsigned int elemsize> struct NearestResampler {
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         uint64 stepz = ((uint64)src.getDepth() << 48) / dst.getDepth();
 
-        // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
-        // for the center of the destination pixel, not the top-left corner
-        uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48 += stepz) {
+        const size_t height = dst.getHeight();
+        for (size_t row = begin; row < end; row++) {
+            size_t z = row / height, y = row % height;
+
+            // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
+            // for the center of the destination pixel, not the top-left corner
+            uint64 sz_48 = (stepz >> 1) - 1 + z * stepz;
             size_t srczoff = (size_t)(sz_48 >> 48) * src.slicePitch;
-            
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48 += stepy) {
-                size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
-            
-                uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48 += stepx) {
-                    uchar* psrc = srcdata +
-                        elemsize*((size_t)(sx_48 >> 48) + srcyoff + srczoff);
-                    memcpy(pdst, psrc, elemsize);
-                    pdst += elemsize;
-                }
-                pdst += elemsize*dst.getRowSkip();
+
+            uint64 sy_48 = (stepy >> 1) - 1 + y * stepy;
+            size_t srcyoff = (size_t)(sy_48 >> 48) * src.rowPitch;
+
+            uchar* pdst = dstdata + elemsize*(z * dst.slicePitch + y * dst.rowPitch);
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for (size_t x = dst.left; x < dst.right; x++, sx_48 += stepx) {
+                uchar* psrc = srcdata +
+                    elemsize*((size_t)(sx_48 >> 48) + srcyoff + srczoff);
+                memcpy(pdst, psrc, elemsize);
+                pdst += elemsize;
             }
-            pdst += elemsize*dst.getSliceSkip();
         }
     }
 };
 
+// temp is 16/16 bit fixed precision, used to adjust a source
+// coordinate (x, y, or z) backwards by half a pixel so that the
+// integer bits represent the first sample (eg, sx1) and the
+// fractional bits are the blend weight of the second sample
+inline void linearSamples(uint64 s_48, uint32 srcSize, uint32& s1, uint32& s2, float& sf)
+{
+    unsigned int temp = static_cast<unsigned int>(s_48 >> 32);
+    temp = (temp > 0x8000)? temp - 0x8000 : 0;
+    s1 = temp >> 16;                        // src sample #1
+    s2 = std::min(s1+1,srcSize-1);          // src sample #2
+    sf = (temp & 0xFFFF) / 65536.f;         // weight of sample #2
+}
 
 // default floating-point linear resampler, does format conversion
 struct LinearResampler {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t begin, size_t end) {
         size_t srcelemsize = PixelUtil::getNumElemBytes(src.format);
         size_t dstelemsize = PixelUtil::getNumElemBytes(dst.format);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
         
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -106,66 +130,50 @@ struct LinearResampler {
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         uint64 stepz = ((uint64)src.getDepth() << 48) / dst.getDepth();
         
-        // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
-        // for the center of the destination pixel, not the top-left corner
-        uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48+=stepz) {
-            // temp is 16/16 bit fixed precision, used to adjust a source
-            // coordinate (x, y, or z) backwards by half a pixel so that the
-            // integer bits represent the first sample (eg, sx1) and the
-            // fractional bits are the blend weight of the second sample
-            unsigned int temp = static_cast<unsigned int>(sz_48 >> 32);
-
-            temp = (temp > 0x8000)? temp - 0x8000 : 0;
-            uint32 sz1 = temp >> 16;                 // src z, sample #1
-            uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
-            float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
-
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
-                temp = static_cast<unsigned int>(sy_48 >> 32);
-                temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                uint32 sy1 = temp >> 16;                    // src y #1
-                uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
-                float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
-                uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
-                    temp = static_cast<unsigned int>(sx_48 >> 32);
-                    temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                    uint32 sx1 = temp >> 16;                    // src x #1
-                    uint32 sx2 = std::min(sx1+1,src.getWidth()-1);// src x #2
-                    float sxf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                
-                    ColourValue x1y1z1, x2y1z1, x1y2z1, x2y2z1;
-                    ColourValue x1y1z2, x2y1z2, x1y2z2, x2y2z2;
+        const size_t height = dst.getHeight();
+        for (size_t row = begin; row < end; row++) {
+            size_t z = row / height, y = row % height;
+
+            // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
+            // for the center of the destination pixel, not the top-left corner
+            uint32 sz1, sz2, sy1, sy2;
+            float szf, syf;
+            linearSamples((stepz >> 1) - 1 + z * stepz, src.getDepth(), sz1, sz2, szf);
+            linearSamples((stepy >> 1) - 1 + y * stepy, src.getHeight(), sy1, sy2, syf);
+
+            uchar* pdst = dstdata + dstelemsize*(z * dst.slicePitch + y * dst.rowPitch);
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
+                uint32 sx1, sx2;
+                float sxf;
+                linearSamples(sx_48, src.getWidth(), sx1, sx2, sxf);
+            
+                ColourValue x1y1z1, x2y1z1, x1y2z1, x2y2z1;
+                ColourValue x1y1z2, x2y1z2, x1y2z2, x2y2z2;
 
 #define UNPACK(dst,x,y,z) PixelUtil::unpackColour(&dst, src.format, \
     srcdata + srcelemsize*((x)+(y)*src.rowPitch+(z)*src.slicePitch))
 
-                    UNPACK(x1y1z1,sx1,sy1,sz1); UNPACK(x2y1z1,sx2,sy1,sz1);
-                    UNPACK(x1y2z1,sx1,sy2,sz1); UNPACK(x2y2z1,sx2,sy2,sz1);
-                    UNPACK(x1y1z2,sx1,sy1,sz2); UNPACK(x2y1z2,sx2,sy1,sz2);
-                    UNPACK(x1y2z2,sx1,sy2,sz2); UNPACK(x2y2z2,sx2,sy2,sz2);
+                UNPACK(x1y1z1,sx1,sy1,sz1); UNPACK(x2y1z1,sx2,sy1,sz1);
+                UNPACK(x1y2z1,sx1,sy2,sz1); UNPACK(x2y2z1,sx2,sy2,sz1);
+                UNPACK(x1y1z2,sx1,sy1,sz2); UNPACK(x2y1z2,sx2,sy1,sz2);
+                UNPACK(x1y2z2,sx1,sy2,sz2); UNPACK(x2y2z2,sx2,sy2,sz2);
 #undef UNPACK
 
-                    ColourValue accum =
-                        x1y1z1 * ((1.0f - sxf)*(1.0f - syf)*(1.0f - szf)) +
-                        x2y1z1 * (        sxf *(1.0f - syf)*(1.0f - szf)) +
-                        x1y2z1 * ((1.0f - sxf)*        syf *(1.0f - szf)) +
-                        x2y2z1 * (        sxf *        syf *(1.0f - szf)) +
-                        x1y1z2 * ((1.0f - sxf)*(1.0f - syf)*        szf ) +
-                        x2y1z2 * (        sxf *(1.0f - syf)*        szf ) +
-                        x1y2z2 * ((1.0f - sxf)*        syf *        szf ) +
-                        x2y2z2 * (        sxf *        syf *        szf );
+                ColourValue accum =
+                    x1y1z1 * ((1.0f - sxf)*(1.0f - syf)*(1.0f - szf)) +
+                    x2y1z1 * (        sxf *(1.0f - syf)*(1.0f - szf)) +
+                    x1y2z1 * ((1.0f - sxf)*        syf *(1.0f - szf)) +
+                    x2y2z1 * (        sxf *        syf *(1.0f - szf)) +
+                    x1y1z2 * ((1.0f - sxf)*(1.0f - syf)*        szf ) +
+                    x2y1z2 * (        sxf *(1.0f - syf)*        szf ) +
+                    x1y2z2 * ((1.0f - sxf)*        syf *        szf ) +
+                    x2y2z2 * (        sxf *        syf *        szf );
 
-                    PixelUtil::packColour(accum, dst.format, pdst);
+                PixelUtil::packColour(accum, dst.format, pdst);
 
-                    pdst += dstelemsize;
-                }
-                pdst += dstelemsize*dst.getRowSkip();
+                pdst += dstelemsize;
             }
-            pdst += dstelemsize*dst.getSliceSkip();
         }
     }
 };
@@ -174,15 +182,15 @@ struct LinearResampler {
 // float32 linear resampler, converts FLOAT32_RGB/FLOAT32_RGBA only.
 // avoids overhead of pixel unpack/repack function calls
 struct LinearResampler_Float32 {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t begin, size_t end) {
         size_t srcchannels = PixelUtil::getNumElemBytes(src.format) / sizeof(float);
         size_t dstchannels = PixelUtil::getNumElemBytes(dst.format) / sizeof(float);
         // assert(srcchannels == 3 || srcchannels == 4);
         // assert(dstchannels == 3 || dstchannels == 4);
 
-        // srcdata stays at beginning, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning, pdst is a moving pointer
         float* srcdata = (float*)src.getTopLeftFrontPixelPtr();
-        float* pdst = (float*)dst.getTopLeftFrontPixelPtr();
+        float* dstdata = (float*)dst.getTopLeftFrontPixelPtr();
         
         // sx_48,sy_48,sz_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
@@ -190,39 +198,26 @@ struct LinearResampler_Float32 {
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         uint64 stepz = ((uint64)src.getDepth() << 48) / dst.getDepth();
         
-        // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
-        // for the center of the destination pixel, not the top-left corner
-        uint64 sz_48 = (stepz >> 1) - 1;
-        for (size_t z = dst.front; z < dst.back; z++, sz_48+=stepz) {
-            // temp is 16/16 bit fixed precision, used to adjust a source
-            // coordinate (x, y, or z) backwards by half a pixel so that the
-            // integer bits represent the first sample (eg, sx1) and the
-            // fractional bits are the blend weight of the second sample
-            unsigned int temp = static_cast<unsigned int>(sz_48 >> 32);
-
-            temp = (temp > 0x8000)? temp - 0x8000 : 0;
-            uint32 sz1 = temp >> 16;                 // src z, sample #1
-            uint32 sz2 = std::min(sz1+1,src.getDepth()-1);// src z, sample #2
-            float szf = (temp & 0xFFFF) / 65536.f; // weight of sample #2
-
-            uint64 sy_48 = (stepy >> 1) - 1;
-            for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
-                temp = static_cast<unsigned int>(sy_48 >> 32);
-                temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                uint32 sy1 = temp >> 16;                    // src y #1
-                uint32 sy2 = std::min(sy1+1,src.getHeight()-1);// src y #2
-                float syf = (temp & 0xFFFF) / 65536.f; // weight of #2
+        const size_t height = dst.getHeight();
+        for (size_t row = begin; row < end; row++) {
+            size_t z = row / height, y = row % height;
+
+            // note: ((stepz>>1) - 1) is an extra half-step increment to adjust
+            // for the center of the destination pixel, not the top-left corner
+            uint32 sz1, sz2, sy1, sy2;
+            float szf, syf;
+            linearSamples((stepz >> 1) - 1 + z * stepz, src.getDepth(), sz1, sz2, szf);
+            linearSamples((stepy >> 1) - 1 + y * stepy, src.getHeight(), sy1, sy2, syf);
+
+            float* pdst = dstdata + dstchannels*(z * dst.slicePitch + y * dst.rowPitch);
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
+                uint32 sx1, sx2;
+                float sxf;
+                linearSamples(sx_48, src.getWidth(), sx1, sx2, sxf);
                 
-                uint64 sx_48 = (stepx >> 1) - 1;
-                for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
-                    temp = static_cast<unsigned int>(sx_48 >> 32);
-                    temp = (temp > 0x8000)? temp - 0x8000 : 0;
-                    uint32 sx1 = temp >> 16;                    // src x #1
-                    uint32 sx2 = std::min(sx1+1,src.getWidth()-1);// src x #2
-                    float sxf = (temp & 0xFFFF) / 65536.f; // weight of #2
-                    
-                    // process R,G,B,A simultaneously for cache coherence?
-                    float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                // process R,G,B,A simultaneously for cache coherence?
+                float accum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 #define ACCUM3(x,y,z,factor) \
     { float f = factor; \
@@ -236,39 +231,36 @@ struct LinearResampler_Float32 {
     accum[0]+=srcdata[off+0]*f; accum[1]+=srcdata[off+1]*f; \
     accum[2]+=srcdata[off+2]*f; accum[3]+=srcdata[off+3]*f; }
 
-                    if (srcchannels == 3 || dstchannels == 3) {
-                        // RGB, no alpha
-                        ACCUM3(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
-                        ACCUM3(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
-                        ACCUM3(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
-                        ACCUM3(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
-                        ACCUM3(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
-                        ACCUM3(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
-                        ACCUM3(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
-                        ACCUM3(sx2,sy2,sz2,      sxf *      syf *      szf );
-                        accum[3] = 1.0f;
-                    } else {
-                        // RGBA
-                        ACCUM4(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
-                        ACCUM4(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
-                        ACCUM4(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
-                        ACCUM4(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
-                        ACCUM4(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
-                        ACCUM4(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
-                        ACCUM4(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
-                        ACCUM4(sx2,sy2,sz2,      sxf *      syf *      szf );
-                    }
-
-                    memcpy(pdst, accum, sizeof(float)*dstchannels);
+                if (srcchannels == 3 || dstchannels == 3) {
+                    // RGB, no alpha
+                    ACCUM3(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
+                    ACCUM3(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
+                    ACCUM3(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
+                    ACCUM3(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
+                    ACCUM3(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
+                    ACCUM3(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
+                    ACCUM3(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
+                    ACCUM3(sx2,sy2,sz2,      sxf *      syf *      szf );
+                    accum[3] = 1.0f;
+                } else {
+                    // RGBA
+                    ACCUM4(sx1,sy1,sz1,(1.0f-sxf)*(1.0f-syf)*(1.0f-szf));
+                    ACCUM4(sx2,sy1,sz1,      sxf *(1.0f-syf)*(1.0f-szf));
+                    ACCUM4(sx1,sy2,sz1,(1.0f-sxf)*      syf *(1.0f-szf));
+                    ACCUM4(sx2,sy2,sz1,      sxf *      syf *(1.0f-szf));
+                    ACCUM4(sx1,sy1,sz2,(1.0f-sxf)*(1.0f-syf)*      szf );
+                    ACCUM4(sx2,sy1,sz2,      sxf *(1.0f-syf)*      szf );
+                    ACCUM4(sx1,sy2,sz2,(1.0f-sxf)*      syf *      szf );
+                    ACCUM4(sx2,sy2,sz2,      sxf *      syf *      szf );
+                }
+
+                memcpy(pdst, accum, sizeof(float)*dstchannels);
 
 #undef ACCUM3
 #undef ACCUM4
 
-                    pdst += dstchannels;
-                }
-                pdst += dstchannels*dst.getRowSkip();
+                pdst += dstchannels;
             }
-            pdst += dstchannels*dst.getSliceSkip();
         }
     }
 };
@@ -281,26 +273,26 @@ struct LinearResampler_Float32 {
 // templated on bytes-per-pixel to allow compiler optimizations, such
 // as unrolling loops and replacing multiplies with bitshifts
 template<unsigned int channels> struct LinearResampler_Byte {
-    static void scale(const PixelBox& src, const PixelBox& dst) {
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t begin, size_t end) {
         // assert(src.format == dst.format);
 
         // only optimized for 2D
         if (src.getDepth() > 1 || dst.getDepth() > 1) {
-            LinearResampler::scale(src, dst);
+            LinearResampler::scale(src, dst, begin, end);
             return;
         }
 
-        // srcdata stays at beginning of slice, pdst is a moving pointer
+        // srcdata and dstdata stay at beginning of slice, pdst is a moving pointer
         uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
-        uchar* pdst = (uchar*)dst.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
 
         // sx_48,sy_48 represent current position in source
         // using 16/48-bit fixed precision, incremented by steps
         uint64 stepx = ((uint64)src.getWidth() << 48) / dst.getWidth();
         uint64 stepy = ((uint64)src.getHeight() << 48) / dst.getHeight();
         
-        uint64 sy_48 = (stepy >> 1) - 1;
-        for (size_t y = dst.top; y < dst.bottom; y++, sy_48+=stepy) {
+        for (size_t y = begin; y < end; y++) {
+            uint64 sy_48 = (stepy >> 1) - 1 + y * stepy;
             // bottom 28 bits of temp are 16/12 bit fixed precision, used to
             // adjust a source coordinate backwards by half a pixel so that the
             // integer bits represent the first sample (eg, sx1) and the
@@ -313,6 +305,7 @@ template<unsigned int channels> struct LinearResampler_Byte {
             size_t syoff1 = sy1 * src.rowPitch;
             size_t syoff2 = sy2 * src.rowPitch;
 
+            uchar* pdst = dstdata + channels * y * dst.rowPitch;
             uint64 sx_48 = (stepx >> 1) - 1;
             for (size_t x = dst.left; x < dst.right; x++, sx_48+=stepx) {
                 temp = static_cast<unsigned int>(sx_48 >> 36);
@@ -333,10 +326,371 @@ template<unsigned int channels> struct LinearResampler_Byte {
                     *pdst++ = static_cast<uchar>((accum + 0x800000) >> 24);
                 }
             }
-            pdst += channels*dst.getRowSkip();
         }
     }
 };
+
+
+// byte box filter halving the size, does not do any format conversions.
+// only handles pixel formats that use 1 byte per color channel, and
+// boxes where every dimension is either halved or 1, see canScale.
+// this is what mipmap generation of 8 bit textures mostly does.
+template<unsigned int channels> struct BoxResampler_Byte {
+    static bool canScale(const PixelBox& src, const PixelBox& dst) {
+        return (src.getWidth() == dst.getWidth() * 2 || (src.getWidth() == 1 && dst.getWidth() == 1)) &&
+            (src.getHeight() == dst.getHeight() * 2 || (src.getHeight() == 1 && dst.getHeight() == 1)) &&
+            (src.getDepth() == dst.getDepth() * 2 || (src.getDepth() == 1 && dst.getDepth() == 1));
+    }
+
+    static void scale(const PixelBox& src, const PixelBox& dst, size_t begin, size_t end) {
+        // assert(src.format == dst.format && canScale(src, dst));
+
+        uchar* srcdata = (uchar*)src.getTopLeftFrontPixelPtr();
+        uchar* dstdata = (uchar*)dst.getTopLeftFrontPixelPtr();
+
+        // offsets of the second sample in each dimension, 0 if it is not halved
+        const size_t offx = src.getWidth() > 1 ? channels : 0;
+        const size_t offy = src.getHeight() > 1 ? channels * src.rowPitch : 0;
+        const size_t offz = src.getDepth() > 1 ? channels * src.slicePitch : 0;
+        const size_t stepx = src.getWidth() > 1 ? 2 : 1;
+        const size_t stepy = src.getHeight() > 1 ? 2 : 1;
+        const size_t stepz = src.getDepth() > 1 ? 2 : 1;
+
+        const size_t height = dst.getHeight();
+        for (size_t row = begin; row < end; row++) {
+            size_t z = row / height, y = row % height;
+            uchar* pdst = dstdata + channels * (z * dst.slicePitch + y * dst.rowPitch);
+            const uchar* psrc = srcdata + channels * (z * stepz * src.slicePitch + y * stepy * src.rowPitch);
+
+            for (size_t x = dst.left; x < dst.right; x++, psrc += stepx * channels) {
+                for (unsigned int k = 0; k < channels; k++) {
+                    // the samples of a dimension that is not halved are
+                    // counted twice, which keeps the weights equal
+                    const uchar* p = psrc + k;
+                    unsigned int accum = p[0] + p[offx] + p[offy] + p[offy + offx];
+                    accum += offz ? p[offz] + p[offz + offx] + p[offz + offy] + p[offz + offy + offx] : accum;
+                    *pdst++ = static_cast<uchar>((accum + 4) >> 3);
+                }
+            }
+        }
+    }
+};
+
+
+// the pixels of the separable filters, PF_FLOAT32_RGBA in one SIMD
+// register, so all channels are filtered at once
+#if __OGRE_HAVE_SSE && OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
+struct FilterPixel {
+    __m128 v;
+    static FilterPixel zero() { FilterPixel p; p.v = _mm_setzero_ps(); return p; }
+    static FilterPixel load(const float* src) { FilterPixel p; p.v = _mm_loadu_ps(src); return p; }
+    void store(float* dst) const { _mm_storeu_ps(dst, v); }
+    void add(const float* src, float weight) { v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(src), _mm_set1_ps(weight))); }
+};
+#elif __OGRE_HAVE_NEON
+struct FilterPixel {
+    float32x4_t v;
+    static FilterPixel zero() { FilterPixel p; p.v = vdupq_n_f32(0.0f); return p; }
+    static FilterPixel load(const float* src) { FilterPixel p; p.v = vld1q_f32(src); return p; }
+    void store(float* dst) const { vst1q_f32(dst, v); }
+    void add(const float* src, float weight) { v = vmlaq_n_f32(v, vld1q_f32(src), weight); }
+};
+#else
+struct FilterPixel {
+    float v[4];
+    static FilterPixel zero() { FilterPixel p = { { 0.0f, 0.0f, 0.0f, 0.0f } }; return p; }
+    static FilterPixel load(const float* src) { FilterPixel p; memcpy(p.v, src, sizeof(p.v)); return p; }
+    void store(float* dst) const { memcpy(dst, v, sizeof(v)); }
+    void add(const float* src, float weight) {
+        v[0] += src[0] * weight; v[1] += src[1] * weight;
+        v[2] += src[2] * weight; v[3] += src[3] * weight;
+    }
+};
+#endif
+
+// the windowed filters of Image::Filter, in source pixels
+struct ResamplingFilter {
+    static float support(Image::Filter filter) {
+        switch (filter) {
+        case Image::FILTER_BOX: return 0.5f;
+        case Image::FILTER_TRIANGLE: return 1.0f;
+        case Image::FILTER_BICUBIC: return 2.0f;
+        default: return 3.0f;
+        }
+    }
+
+    static double sinc(double x) {
+        if (std::abs(x) < 1e-6)
+            return 1.0;
+        x *= Math::PI;
+        return std::sin(x) / x;
+    }
+
+    // zeroth order modified bessel function of the first kind
+    static double besselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; k++) {
+            term *= (x / (2 * k)) * (x / (2 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    static float weight(Image::Filter filter, float x) {
+        double t = std::abs(x);
+        switch (filter) {
+        case Image::FILTER_BOX:
+            // half open, so a pixel exactly between two samples is only counted once
+            return x >= -0.5f && x < 0.5f ? 1.0f : 0.0f;
+        case Image::FILTER_TRIANGLE:
+            return t < 1.0 ? float(1.0 - t) : 0.0f;
+        case Image::FILTER_BICUBIC:
+            // Catmull-Rom, which interpolates the samples
+            if (t < 1.0)
+                return float(1.5 * t * t * t - 2.5 * t * t + 1.0);
+            if (t < 2.0)
+                return float(-0.5 * t * t * t + 2.5 * t * t - 4.0 * t + 2.0);
+            return 0.0f;
+        case Image::FILTER_LANCZOS:
+            return t < 3.0 ? float(sinc(t) * sinc(t / 3.0)) : 0.0f;
+        case Image::FILTER_KAISER:
+        default:
+        {
+            // kaiser windowed sinc, width 3 and alpha 4
+            const double alpha = 4.0;
+            if (t >= 3.0)
+                return 0.0f;
+            double r = t / 3.0;
+            return float(sinc(t) * besselI0(alpha * std::sqrt(1.0 - r * r)) / besselI0(alpha));
+        }
+        }
+    }
+};
+
+// the source pixels contributing to each destination pixel of one dimension
+struct FilterContributions {
+    vector<size_t>::type first;
+    vector<size_t>::type count;
+    // maxCount weights per destination pixel
+    vector<float>::type weights;
+    size_t maxCount;
+
+    FilterContributions(size_t srcSize, size_t dstSize, Image::Filter filter) {
+        // widen the filter when minifying, so every source pixel contributes
+        const float scale = float(dstSize) / float(srcSize);
+        const float filterScale = std::max(1.0f, 1.0f / scale);
+        const float support = ResamplingFilter::support(filter) * filterScale;
+
+        maxCount = std::min(size_t(std::ceil(support * 2)) + 3, srcSize);
+        first.resize(dstSize);
+        count.resize(dstSize);
+        weights.resize(dstSize * maxCount, 0.0f);
+
+        for (size_t i = 0; i < dstSize; i++) {
+            // centre of the destination pixel in source pixels
+            float centre = (i + 0.5f) / scale;
+            int lo = int(std::floor(centre - support));
+            int hi = int(std::ceil(centre + support));
+
+            // samples outside of the source are clamped to the edge
+            size_t clampedLo = size_t(Math::Clamp(lo, 0, int(srcSize) - 1));
+            size_t clampedHi = size_t(Math::Clamp(hi, 0, int(srcSize) - 1));
+            clampedHi = std::min(clampedHi, clampedLo + maxCount - 1);
+            float* w = &weights[i * maxCount];
+            float sum = 0.0f;
+            for (int j = lo; j <= hi; j++) {
+                float weight = ResamplingFilter::weight(filter, (j + 0.5f - centre) / filterScale);
+                if (weight == 0.0f)
+                    continue;
+                size_t index = size_t(Math::Clamp(j, int(clampedLo), int(clampedHi)));
+                w[index - clampedLo] += weight;
+                sum += weight;
+            }
+
+            first[i] = clampedLo;
+            count[i] = clampedHi - clampedLo + 1;
+            if (sum == 0.0f) {
+                // nearest sample
+                first[i] = std::min(size_t(centre), srcSize - 1);
+                count[i] = 1;
+                w[0] = 1.0f;
+                continue;
+            }
+            for (size_t k = 0; k < count[i]; k++)
+                w[k] /= sum;
+        }
+    }
+};
+
+// separable filter resampler for Image::FILTER_BOX, FILTER_TRIANGLE,
+// FILTER_BICUBIC, FILTER_LANCZOS and FILTER_KAISER. filters each
+// dimension in turn, on PF_FLOAT32_RGBA boxes only.
+class FilterResampler {
+public:
+    FilterResampler(const PixelBox& src, const PixelBox& dst, Image::Filter filter)
+        : mSrc(src), mDst(dst), mFilter(filter), mPass(PASS_X), mX(0), mY(0), mZ(0) {
+        // assert(src.format == PF_FLOAT32_RGBA && dst.format == PF_FLOAT32_RGBA);
+    }
+
+    ~FilterResampler() {
+        OGRE_DELETE_T(mX, FilterContributions, MEMCATEGORY_GENERAL);
+        OGRE_DELETE_T(mY, FilterContributions, MEMCATEGORY_GENERAL);
+        OGRE_DELETE_T(mZ, FilterContributions, MEMCATEGORY_GENERAL);
+    }
+
+    void scale();
+
+    // filters the rows of the current pass, see processRowsParallel
+    void processRows(size_t begin, size_t end);
+
+private:
+    enum Pass { PASS_X, PASS_Y, PASS_Z };
+
+    void runPass(Pass pass, const PixelBox& in, const PixelBox& out);
+
+    PixelBox mSrc, mDst;
+    Image::Filter mFilter;
+
+    // the current pass
+    Pass mPass;
+    PixelBox mIn, mOut;
+    FilterContributions *mX, *mY, *mZ;
+};
+
+// calls processRows of a pass for the rows [begin, end)
+template<class Pass> class RowJob : public TaskScheduler::RangeJob {
+public:
+    RowJob(Pass& pass) : mPass(pass) {}
+    void execute(size_t begin, size_t end) { mPass.processRows(begin, end); }
+private:
+    Pass& mPass;
+};
+
+// processes all rows of a pass, split across the TaskScheduler threads
+// if there are enough pixels to make it worthwhile
+template<class Pass> void processRowsParallel(Pass& pass, size_t rows, size_t pixelsPerRow) {
+    // small enough to stay in the caches of one core
+    const size_t minPixels = 128 * 128;
+    const size_t pixelsPerTask = 16 * 1024;
+
+#if OGRE_THREAD_SUPPORT
+    Root* root = Root::getSingletonPtr();
+    TaskScheduler* scheduler = root ? root->getTaskScheduler() : 0;
+    if (scheduler && scheduler->getThreadCount() > 1 && rows > 1 && rows * pixelsPerRow >= minPixels) {
+        RowJob<Pass> job(pass);
+        scheduler->parallelFor(0, rows, std::max<size_t>(pixelsPerTask / std::max<size_t>(pixelsPerRow, 1), 1), job);
+        return;
+    }
+#else
+    (void)minPixels;
+    (void)pixelsPerTask;
+#endif
+    pass.processRows(0, rows);
+}
+
+// runs one of the row resamplers above on all rows of dst
+template<class Resampler> struct ResamplerPass {
+    const PixelBox& src;
+    const PixelBox& dst;
+
+    ResamplerPass(const PixelBox& s, const PixelBox& d) : src(s), dst(d) {}
+
+    void processRows(size_t begin, size_t end) { Resampler::scale(src, dst, begin, end); }
+
+    static void scale(const PixelBox& src, const PixelBox& dst) {
+        ResamplerPass pass(src, dst);
+        processRowsParallel(pass, dst.getHeight() * dst.getDepth(), dst.getWidth());
+    }
+};
+
+//-----------------------------------------------------------------------
+inline void FilterResampler::scale() {
+    // unchanged dimensions are skipped, all filters interpolate the samples
+    PixelBox in = mSrc;
+    vector<float>::type buffers[2];
+    int buffer = 0;
+
+    const bool scaleX = mSrc.getWidth() != mDst.getWidth();
+    const bool scaleY = mSrc.getHeight() != mDst.getHeight();
+    const bool scaleZ = mSrc.getDepth() != mDst.getDepth();
+    if (scaleX) {
+        mX = OGRE_NEW_T(FilterContributions, MEMCATEGORY_GENERAL)(mSrc.getWidth(), mDst.getWidth(), mFilter);
+        PixelBox out = mDst;
+        if (scaleY || scaleZ) {
+            buffers[buffer].resize(mDst.getWidth() * in.getHeight() * in.getDepth() * 4);
+            out = PixelBox(mDst.getWidth(), in.getHeight(), in.getDepth(), PF_FLOAT32_RGBA, &buffers[buffer][0]);
+            buffer ^= 1;
+        }
+        runPass(PASS_X, in, out);
+        in = out;
+    }
+    if (scaleY) {
+        mY = OGRE_NEW_T(FilterContributions, MEMCATEGORY_GENERAL)(mSrc.getHeight(), mDst.getHeight(), mFilter);
+        PixelBox out = mDst;
+        if (scaleZ) {
+            buffers[buffer].resize(mDst.getWidth() * mDst.getHeight() * in.getDepth() * 4);
+            out = PixelBox(mDst.getWidth(), mDst.getHeight(), in.getDepth(), PF_FLOAT32_RGBA, &buffers[buffer][0]);
+            buffer ^= 1;
+        }
+        runPass(PASS_Y, in, out);
+        in = out;
+    }
+    if (scaleZ) {
+        mZ = OGRE_NEW_T(FilterContributions, MEMCATEGORY_GENERAL)(mSrc.getDepth(), mDst.getDepth(), mFilter);
+        runPass(PASS_Z, in, mDst);
+    }
+    if (!scaleX && !scaleY && !scaleZ)
+        PixelUtil::bulkPixelConversion(mSrc, mDst);
+}
+//-----------------------------------------------------------------------
+inline void FilterResampler::runPass(Pass pass, const PixelBox& in, const PixelBox& out) {
+    mPass = pass;
+    mIn = in;
+    mOut = out;
+    processRowsParallel(*this, out.getHeight() * out.getDepth(), out.getWidth());
+}
+//-----------------------------------------------------------------------
+inline void FilterResampler::processRows(size_t begin, size_t end) {
+    const float* indata = (const float*)mIn.getTopLeftFrontPixelPtr();
+    float* outdata = (float*)mOut.getTopLeftFrontPixelPtr();
+    const size_t width = mOut.getWidth();
+    const size_t height = mOut.getHeight();
+
+    for (size_t row = begin; row < end; row++) {
+        size_t z = row / height, y = row % height;
+        float* pdst = outdata + 4 * (z * mOut.slicePitch + y * mOut.rowPitch);
+
+        if (mPass == PASS_X) {
+            // weighted sums of neighbouring pixels of the input row
+            const float* psrc = indata + 4 * (z * mIn.slicePitch + y * mIn.rowPitch);
+            for (size_t x = 0; x < width; x++, pdst += 4) {
+                const float* w = &mX->weights[x * mX->maxCount];
+                const float* p = psrc + 4 * mX->first[x];
+                FilterPixel accum = FilterPixel::zero();
+                for (size_t k = 0, n = mX->count[x]; k < n; k++, p += 4)
+                    accum.add(p, w[k]);
+                accum.store(pdst);
+            }
+        }
+        else {
+            // weighted sums of whole input rows, which are a row pitch
+            // apart for PASS_Y and a slice pitch apart for PASS_Z
+            const FilterContributions& c = mPass == PASS_Y ? *mY : *mZ;
+            const size_t index = mPass == PASS_Y ? y : z;
+            const size_t stride = 4 * (mPass == PASS_Y ? mIn.rowPitch : mIn.slicePitch);
+            const float* w = &c.weights[index * c.maxCount];
+            const float* psrc = indata + 4 * (mPass == PASS_Y ? z * mIn.slicePitch + c.first[index] * mIn.rowPitch
+                                                              : c.first[index] * mIn.slicePitch + y * mIn.rowPitch);
+            for (size_t x = 0; x < width; x++, pdst += 4) {
+                const float* p = psrc + 4 * x;
+                FilterPixel accum = FilterPixel::zero();
+                for (size_t k = 0, n = c.count[index]; k < n; k++, p += stride)
+                    accum.add(p, w[k]);
+                accum.store(pdst);
+            }
+        }
+    }
+}
 /** @} */
 /** @} */
 
@@ -87,9 +87,11 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void Log::logMessage( const String& message, LogMessageLevel lml, bool maskDebug )
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        // filtered messages don't need the lock, worker threads log a lot of these
         if ((mLogLevel + lml) >= OGRE_LOG_THRESHOLD)
         {
+            OGRE_LOCK_AUTO_MUTEX;
+            OGRE_WQ_LOCK_MUTEX(mMessageMutex);
             bool skipThisMessage = false;
             for( mtLogListener::iterator i = mListeners.begin(); i != mListeners.end(); ++i )
                 (*i)->messageLogged( message, lml, maskDebug, mLogName, skipThisMessage);
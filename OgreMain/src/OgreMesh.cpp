@@ -81,7 +81,12 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     HardwareBufferManagerBase* Mesh::getHardwareBufferManager()
     {
-        return mBufferManager ? mBufferManager : HardwareBufferManager::getSingletonPtr();
+        if (mBufferManager)
+            return mBufferManager;
+        if (HardwareBufferManager* mgr = HardwareBufferManager::getSingletonPtr())
+            return mgr;
+        // data only, there is no RenderSystem to create hardware buffers with
+        return MeshManager::getSingleton()._getDataOnlyBufferManager();
     }
     //-----------------------------------------------------------------------
     SubMesh* Mesh::createSubMesh()
@@ -209,8 +214,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless it is there already (e.g. memory mapped)
+        if (!dynamic_cast<MemoryDataStream*>(mFreshFromDisk.get()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -1928,6 +1934,18 @@ namespace Ogre {
         const VertexData* targetVertexData,
         const Affine3* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
+    {
+        HardwareBufferLockSet locks;
+        SoftwareBlendData blendData;
+        lockForSoftwareVertexBlend(sourceVertexData, targetVertexData, blendNormals,
+            locks, blendData);
+
+        softwareVertexBlend(blendData, blendMatrices);
+    }
+    //---------------------------------------------------------------------
+    void Mesh::lockForSoftwareVertexBlend(const VertexData* sourceVertexData,
+        const VertexData* targetVertexData, bool blendNormals,
+        HardwareBufferLockSet& locks, SoftwareBlendData& blendData)
     {
         float *pSrcPos = 0;
         float *pSrcNorm = 0;
@@ -1935,13 +1953,6 @@ namespace Ogre {
         float *pDestNorm = 0;
         float *pBlendWeight = 0;
         unsigned char* pBlendIdx = 0;
-        size_t srcPosStride = 0;
-        size_t srcNormStride = 0;
-        size_t destPosStride = 0;
-        size_t destNormStride = 0;
-        size_t blendWeightStride = 0;
-        size_t blendIdxStride = 0;
-
 
         // Get elements for source
         const VertexElement* srcElemPos =
@@ -1965,107 +1976,92 @@ namespace Ogre {
 
 
         // Get buffers for source
-        HardwareVertexBufferSharedPtr srcPosBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemPos->getSource());
-        HardwareVertexBufferSharedPtr srcIdxBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemBlendIndices->getSource());
-        HardwareVertexBufferSharedPtr srcWeightBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemBlendWeights->getSource());
-        HardwareVertexBufferSharedPtr srcNormBuf;
-
-        srcPosStride = srcPosBuf->getVertexSize();
-        
-        blendIdxStride = srcIdxBuf->getVertexSize();
-        
-        blendWeightStride = srcWeightBuf->getVertexSize();
-        if (includeNormals)
-        {
-            srcNormBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemNorm->getSource());
-            srcNormStride = srcNormBuf->getVertexSize();
-        }
+        const HardwareVertexBufferSharedPtr& srcPosBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemPos->getSource());
+        const HardwareVertexBufferSharedPtr& srcIdxBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemBlendIndices->getSource());
+        const HardwareVertexBufferSharedPtr& srcWeightBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemBlendWeights->getSource());
         // Get buffers for target
-        HardwareVertexBufferSharedPtr destPosBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemPos->getSource());
-        HardwareVertexBufferSharedPtr destNormBuf;
-        destPosStride = destPosBuf->getVertexSize();
-        if (includeNormals)
-        {
-            destNormBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemNorm->getSource());
-            destNormStride = destNormBuf->getVertexSize();
-        }
+        const HardwareVertexBufferSharedPtr& destPosBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemPos->getSource());
+
+        blendData.srcPosStride = srcPosBuf->getVertexSize();
+        blendData.blendIdxStride = srcIdxBuf->getVertexSize();
+        blendData.blendWeightStride = srcWeightBuf->getVertexSize();
+        blendData.destPosStride = destPosBuf->getVertexSize();
+        blendData.srcNormStride = 0;
+        blendData.destNormStride = 0;
 
         void* pBuffer;
 
         // Lock source buffers for reading
-        pBuffer = srcPosBuf->lock(HardwareBuffer::HBL_READ_ONLY);
+        pBuffer = locks.lock(srcPosBuf.get(), HardwareBuffer::HBL_READ_ONLY);
         srcElemPos->baseVertexPointerToElement(pBuffer, &pSrcPos);
         if (includeNormals)
         {
-            if (srcNormBuf != srcPosBuf)
-            {
-                // Different buffer
-                pBuffer = srcNormBuf->lock(HardwareBuffer::HBL_READ_ONLY);
-            }
+            const HardwareVertexBufferSharedPtr& srcNormBuf =
+                sourceVertexData->vertexBufferBinding->getBuffer(srcElemNorm->getSource());
+            blendData.srcNormStride = srcNormBuf->getVertexSize();
+            pBuffer = locks.lock(srcNormBuf.get(), HardwareBuffer::HBL_READ_ONLY);
             srcElemNorm->baseVertexPointerToElement(pBuffer, &pSrcNorm);
         }
 
         // Indices must be 4 bytes
         assert(srcElemBlendIndices->getType() == VET_UBYTE4 &&
                "Blend indices must be VET_UBYTE4");
-        pBuffer = srcIdxBuf->lock(HardwareBuffer::HBL_READ_ONLY);
+        pBuffer = locks.lock(srcIdxBuf.get(), HardwareBuffer::HBL_READ_ONLY);
         srcElemBlendIndices->baseVertexPointerToElement(pBuffer, &pBlendIdx);
-        if (srcWeightBuf != srcIdxBuf)
-        {
-            // Lock buffer
-            pBuffer = srcWeightBuf->lock(HardwareBuffer::HBL_READ_ONLY);
-        }
+        pBuffer = locks.lock(srcWeightBuf.get(), HardwareBuffer::HBL_READ_ONLY);
         srcElemBlendWeights->baseVertexPointerToElement(pBuffer, &pBlendWeight);
-        unsigned short numWeightsPerVertex =
+        blendData.numWeightsPerVertex =
             VertexElement::getTypeCount(srcElemBlendWeights->getType());
 
 
         // Lock destination buffers for writing
-        pBuffer = destPosBuf->lock(
-            (destNormBuf != destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize()) ||
-            (destNormBuf == destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize() + destElemNorm->getSize()) ?
-            HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
-        destElemPos->baseVertexPointerToElement(pBuffer, &pDestPos);
         if (includeNormals)
         {
-            if (destNormBuf != destPosBuf)
-            {
-                pBuffer = destNormBuf->lock(
-                    destNormBuf->getVertexSize() == destElemNorm->getSize() ?
-                    HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
-            }
-            destElemNorm->baseVertexPointerToElement(pBuffer, &pDestNorm);
-        }
+            const HardwareVertexBufferSharedPtr& destNormBuf =
+                targetVertexData->vertexBufferBinding->getBuffer(destElemNorm->getSource());
+            blendData.destNormStride = destNormBuf->getVertexSize();
 
-        OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
-            pBlendWeight, pBlendIdx,
-            blendMatrices,
-            srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
-            blendWeightStride, blendIdxStride,
-            numWeightsPerVertex,
-            targetVertexData->vertexCount);
+            pBuffer = locks.lock(destPosBuf.get(),
+                (destNormBuf != destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize()) ||
+                (destNormBuf == destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize() + destElemNorm->getSize()) ?
+                HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+            destElemPos->baseVertexPointerToElement(pBuffer, &pDestPos);
 
-        // Unlock source buffers
-        srcPosBuf->unlock();
-        srcIdxBuf->unlock();
-        if (srcWeightBuf != srcIdxBuf)
-        {
-            srcWeightBuf->unlock();
-        }
-        if (includeNormals && srcNormBuf != srcPosBuf)
-        {
-            srcNormBuf->unlock();
+            pBuffer = locks.lock(destNormBuf.get(),
+                destNormBuf->getVertexSize() == destElemNorm->getSize() ?
+                HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+            destElemNorm->baseVertexPointerToElement(pBuffer, &pDestNorm);
         }
-        // Unlock destination buffers
-        destPosBuf->unlock();
-        if (includeNormals && destNormBuf != destPosBuf)
+        else
         {
-            destNormBuf->unlock();
+            pBuffer = locks.lock(destPosBuf.get(),
+                destPosBuf->getVertexSize() == destElemPos->getSize() ?
+                HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
+            destElemPos->baseVertexPointerToElement(pBuffer, &pDestPos);
         }
 
+        blendData.srcPos = pSrcPos;
+        blendData.srcNorm = pSrcNorm;
+        blendData.destPos = pDestPos;
+        blendData.destNorm = pDestNorm;
+        blendData.blendWeight = pBlendWeight;
+        blendData.blendIdx = pBlendIdx;
+        blendData.vertexCount = targetVertexData->vertexCount;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::softwareVertexBlend(const SoftwareBlendData& blendData,
+        const Affine3* const* blendMatrices)
+    {
+        OptimisedUtil::getImplementation()->softwareVertexSkinning(
+            blendData.srcPos, blendData.destPos,
+            blendData.srcNorm, blendData.destNorm,
+            blendData.blendWeight, blendData.blendIdx,
+            blendMatrices,
+            blendData.srcPosStride, blendData.destPosStride,
+            blendData.srcNormStride, blendData.destNormStride,
+            blendData.blendWeightStride, blendData.blendIdxStride,
+            blendData.numWeightsPerVertex,
+            blendData.vertexCount);
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexMorph(Real t,
@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "OgrePatchMesh.h"
 #include "OgrePrefabFactory.h"
+#include "OgreDefaultHardwareBufferManager.h"
 
 namespace Ogre
 {
@@ -44,13 +45,14 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     MeshManager::MeshManager():
-    mBoundsPaddingFactor(0.01), mListener(0)
+    mBoundsPaddingFactor(0.01), mListener(0), mDataOnlyBufferManager(0)
     {
         mBlendWeightsBaseElementType = VET_FLOAT1;
         mPrepAllMeshesForShadowVolumes = false;
 
         mLoadOrder = 350.0f;
         mResourceType = "Mesh";
+        mPrepareThreadSafe = true;
 
         ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
 
@@ -59,6 +61,21 @@ namespace Ogre
     MeshManager::~MeshManager()
     {
         ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+
+        if (mDataOnlyBufferManager)
+        {
+            // the meshes may still have buffers of it
+            removeAll();
+            OGRE_DELETE mDataOnlyBufferManager;
+        }
+    }
+    //-----------------------------------------------------------------------
+    HardwareBufferManagerBase* MeshManager::_getDataOnlyBufferManager()
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        if (!mDataOnlyBufferManager)
+            mDataOnlyBufferManager = OGRE_NEW DefaultHardwareBufferManagerBase();
+        return mDataOnlyBufferManager;
     }
     //-----------------------------------------------------------------------
     MeshPtr MeshManager::getByName(const String& name, const String& groupName)
@@ -814,16 +814,19 @@ namespace Ogre {
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
             pMesh->mVertexBufferShadowBuffer);
-        void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
-        stream->read(pBuf, dest->vertexCount * vertexSize);
-
-        // endian conversion for OSX
-        flipFromLittleEndian(
-            pBuf,
-            dest->vertexCount,
-            vertexSize,
-            dest->vertexDeclaration->findElementsBySource(bindIndex));
-        vbuf->unlock();
+        if (!readBufferInPlace(stream, vbuf.get(), vbuf->getSizeInBytes()))
+        {
+            void* pBuf = vbuf->lock(HardwareBuffer::HBL_DISCARD);
+            stream->read(pBuf, dest->vertexCount * vertexSize);
+
+            // endian conversion for OSX
+            flipFromLittleEndian(
+                pBuf,
+                dest->vertexCount,
+                vertexSize,
+                dest->vertexDeclaration->findElementsBySource(bindIndex));
+            vbuf->unlock();
+        }
 
         // Set binding
         dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
@@ -916,7 +919,7 @@ namespace Ogre {
                 switch(streamID)
                 {
                 case M_GEOMETRY:
-                    pMesh->sharedVertexData = OGRE_NEW VertexData();
+                    pMesh->sharedVertexData = OGRE_NEW VertexData(pMesh->getHardwareBufferManager());
                     try {
                         readGeometry(stream, pMesh, pMesh->sharedVertexData);
                     }
@@ -1011,11 +1014,14 @@ namespace Ogre {
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
                 // unsigned int* faceVertexIndices
-                unsigned int* pIdx = static_cast<unsigned int*>(
-                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                    );
-                readInts(stream, pIdx, sm->indexData->indexCount);
-                ibuf->unlock();
+                if (!readBufferInPlace(stream, ibuf.get(), ibuf->getSizeInBytes()))
+                {
+                    unsigned int* pIdx = static_cast<unsigned int*>(
+                        ibuf->lock(HardwareBuffer::HBL_DISCARD)
+                        );
+                    readInts(stream, pIdx, sm->indexData->indexCount);
+                    ibuf->unlock();
+                }
 
             }
             else // 16-bit
@@ -1026,11 +1032,14 @@ namespace Ogre {
                         pMesh->mIndexBufferUsage,
                         pMesh->mIndexBufferShadowBuffer);
                 // unsigned short* faceVertexIndices
-                unsigned short* pIdx = static_cast<unsigned short*>(
-                    ibuf->lock(HardwareBuffer::HBL_DISCARD)
-                    );
-                readShorts(stream, pIdx, sm->indexData->indexCount);
-                ibuf->unlock();
+                if (!readBufferInPlace(stream, ibuf.get(), ibuf->getSizeInBytes()))
+                {
+                    unsigned short* pIdx = static_cast<unsigned short*>(
+                        ibuf->lock(HardwareBuffer::HBL_DISCARD)
+                        );
+                    readShorts(stream, pIdx, sm->indexData->indexCount);
+                    ibuf->unlock();
+                }
             }
         }
         sm->indexData->indexBuffer = ibuf;
@@ -1046,7 +1055,7 @@ namespace Ogre {
                 OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Missing geometry data in mesh file",
                     "MeshSerializerImpl::readSubMesh");
             }
-            sm->vertexData = OGRE_NEW VertexData();
+            sm->vertexData = OGRE_NEW VertexData(pMesh->getHardwareBufferManager());
             readGeometry(stream, pMesh, sm->vertexData);
         }
 
@@ -1589,23 +1598,42 @@ namespace Ogre {
                 indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
                     idx32Bit ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
                     buffIndexCount, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                void* pIdx = static_cast<unsigned int*>(indexData->indexBuffer->lock(
-                    0, indexData->indexBuffer->getSizeInBytes(), HardwareBuffer::HBL_DISCARD));
-
                 // unsigned short*/int* faceIndexes;  ((v1, v2, v3) * numFaces)
-                if (idx32Bit)
-                {
-                    readInts(stream, (uint32*)pIdx, buffIndexCount);
-                }
-                else
+                if (!readBufferInPlace(stream, indexData->indexBuffer.get(),
+                                       indexData->indexBuffer->getSizeInBytes()))
                 {
-                    readShorts(stream, (uint16*)pIdx, buffIndexCount);
+                    void* pIdx = static_cast<unsigned int*>(indexData->indexBuffer->lock(
+                        0, indexData->indexBuffer->getSizeInBytes(), HardwareBuffer::HBL_DISCARD));
+
+                    if (idx32Bit)
+                    {
+                        readInts(stream, (uint32*)pIdx, buffIndexCount);
+                    }
+                    else
+                    {
+                        readShorts(stream, (uint16*)pIdx, buffIndexCount);
+                    }
+                    indexData->indexBuffer->unlock();
                 }
-                indexData->indexBuffer->unlock();
             }
         }
     }
 #endif
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::readBufferInPlace(DataStreamPtr& stream, HardwareBuffer* buf, size_t length)
+    {
+        if (mFlipEndian)
+            return false;
+
+        MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get());
+        if (!memStream || memStream->size() - memStream->tell() < length)
+            return false;
+
+        // no lock and no intermediate copy, e.g. a single glBufferData from the mapped file
+        buf->writeData(0, length, memStream->getCurrentPtr(), true);
+        stream->skip(length);
+        return true;
+    }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::flipFromLittleEndian(void* pData, size_t vertexCount,
         size_t vertexSize, const VertexDeclaration::VertexElementList& elems)
@@ -2664,10 +2692,13 @@ namespace Ogre {
                 vertexSize, vertexCount,
                 HardwareBuffer::HBU_STATIC, true);
         // float x,y,z          // repeat by number of vertices in original geometry
-        float* pDst = static_cast<float*>(
-            vbuf->lock(HardwareBuffer::HBL_DISCARD));
-        readFloats(stream, pDst, vertexCount * (includesNormals ? 6 : 3));
-        vbuf->unlock();
+        if (!readBufferInPlace(stream, vbuf.get(), vbuf->getSizeInBytes()))
+        {
+            float* pDst = static_cast<float*>(
+                vbuf->lock(HardwareBuffer::HBL_DISCARD));
+            readFloats(stream, pDst, vertexCount * (includesNormals ? 6 : 3));
+            vbuf->unlock();
+        }
         kf->setVertexBuffer(vbuf);
 
     }
@@ -3022,28 +3053,35 @@ namespace Ogre {
                     indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
                         HardwareIndexBuffer::IT_32BIT, indexData->indexCount,
                         pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                    unsigned int* pIdx = static_cast<unsigned int*>(
-                        indexData->indexBuffer->lock(
-                        0,
-                        indexData->indexBuffer->getSizeInBytes(),
-                        HardwareBuffer::HBL_DISCARD));
-
-                    readInts(stream, pIdx, indexData->indexCount);
-                    indexData->indexBuffer->unlock();
-
+                    if (!readBufferInPlace(stream, indexData->indexBuffer.get(),
+                                           indexData->indexBuffer->getSizeInBytes()))
+                    {
+                        unsigned int* pIdx = static_cast<unsigned int*>(
+                            indexData->indexBuffer->lock(
+                            0,
+                            indexData->indexBuffer->getSizeInBytes(),
+                            HardwareBuffer::HBL_DISCARD));
+
+                        readInts(stream, pIdx, indexData->indexCount);
+                        indexData->indexBuffer->unlock();
+                    }
                 }
                 else
                 {
                     indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
                         HardwareIndexBuffer::IT_16BIT, indexData->indexCount,
                         pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                    unsigned short* pIdx = static_cast<unsigned short*>(
-                        indexData->indexBuffer->lock(
-                        0,
-                        indexData->indexBuffer->getSizeInBytes(),
-                        HardwareBuffer::HBL_DISCARD));
-                    readShorts(stream, pIdx, indexData->indexCount);
-                    indexData->indexBuffer->unlock();
+                    if (!readBufferInPlace(stream, indexData->indexBuffer.get(),
+                                           indexData->indexBuffer->getSizeInBytes()))
+                    {
+                        unsigned short* pIdx = static_cast<unsigned short*>(
+                            indexData->indexBuffer->lock(
+                            0,
+                            indexData->indexBuffer->getSizeInBytes(),
+                            HardwareBuffer::HBL_DISCARD));
+                        readShorts(stream, pIdx, indexData->indexCount);
+                        indexData->indexBuffer->unlock();
+                    }
                 }
             }
         }
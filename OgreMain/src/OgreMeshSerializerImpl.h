@@ -174,6 +174,12 @@ namespace Ogre {
         virtual void readPoseKeyFrame(DataStreamPtr& stream, VertexAnimationTrack* track);
         virtual void readExtremes(DataStreamPtr& stream, Mesh *pMesh);
 
+        /** Uploads the next length bytes of a memory stream (e.g. a memory mapped file)
+            straight to the buffer with a single HardwareBuffer::writeData.
+        @return false if the stream is not in memory or the data needs endian conversion,
+            in which case nothing was read and it has to be copied through a lock
+        */
+        bool readBufferInPlace(DataStreamPtr& stream, HardwareBuffer* buf, size_t length);
 
         /// Flip an entire vertex buffer from little endian
         virtual void flipFromLittleEndian(void* pData, size_t vertexCount, size_t vertexSize, const VertexDeclaration::VertexElementList& elems);
@@ -174,8 +174,9 @@ namespace Ogre {
         // counter by one for minimise overhead
         --mLightListUpdated;
 
-        // Notify listener if exists
-        if (mListener)
+        // Notify listener if exists, later on the main thread when moved by a
+        // parallel scene graph update
+        if (mListener && !Node::_deferListenerCall(mParentNode, this))
         {
             mListener->objectMoved(this);
         }
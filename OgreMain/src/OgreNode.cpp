@@ -31,6 +31,8 @@ THE SOFTWARE.
 namespace Ogre {
 
     Node::QueuedUpdates Node::msQueuedUpdates;
+    /// Per-thread target for deferred listener calls, see _setDeferredListenerQueue
+    static thread_local Node::UpdatedNodeList* tlsDeferredListenerQueue = 0;
     //-----------------------------------------------------------------------
     Node::Node() : Node(BLANKSTRING) {}
     //-----------------------------------------------------------------------
@@ -195,15 +197,42 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Node::_updateAndCollectChildren(bool parentHasChanged, PendingUpdateList& children)
+    {
+        mParentNotified = false;
+
+        if (mNeedParentUpdate || parentHasChanged)
+        {
+            _updateFromParent();
+        }
+
+        if (mNeedChildUpdate || parentHasChanged)
+        {
+            for (ChildNodeMap::iterator it = mChildren.begin(); it != mChildren.end(); ++it)
+            {
+                children.push_back(std::make_pair(*it, true));
+            }
+        }
+        else
+        {
+            for (ChildUpdateSet::iterator it = mChildrenToUpdate.begin();
+                it != mChildrenToUpdate.end(); ++it)
+            {
+                children.push_back(std::make_pair(*it, false));
+            }
+        }
+
+        mChildrenToUpdate.clear();
+        mNeedChildUpdate = false;
+    }
+    //-----------------------------------------------------------------------
     void Node::_updateFromParent(void) const
     {
         updateFromParentImpl();
 
         // Call listener (note, this method only called if there's something to do)
-        if (mListener)
-        {
+        if (mListener && !_deferListenerCall(this))
             mListener->nodeUpdated(this);
-        }
     }
     //-----------------------------------------------------------------------
     void Node::updateFromParentImpl(void) const
@@ -813,6 +842,19 @@ namespace Ogre {
         }
         msQueuedUpdates.clear();
     }
+    //-----------------------------------------------------------------------
+    void Node::_setDeferredListenerQueue(UpdatedNodeList* queue)
+    {
+        tlsDeferredListenerQueue = queue;
+    }
+    //-----------------------------------------------------------------------
+    bool Node::_deferListenerCall(const Node* node, MovableObject* object)
+    {
+        if (!tlsDeferredListenerQueue)
+            return false;
+        tlsDeferredListenerQueue->push_back(std::make_pair(node, object));
+        return true;
+    }
     //---------------------------------------------------------------------
     Node::DebugRenderable* Node::getDebugRenderable(Real scaling)
     {
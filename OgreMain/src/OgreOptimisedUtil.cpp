@@ -42,6 +42,12 @@ namespace Ogre {
 //#elif __OGRE_HAVE_VFP
 //    extern OptimisedUtil* _getOptimisedUtilVFP(void);
 #endif
+#if __OGRE_HAVE_AVX2
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+#endif
+#if __OGRE_HAVE_AVX512
+    extern OptimisedUtil* _getOptimisedUtilAVX512(void);
+#endif
 #if __OGRE_HAVE_DIRECTXMATH
     extern OptimisedUtil* _getOptimisedUtilDirectXMath(void);
 #endif
@@ -144,6 +150,11 @@ namespace Ogre {
 #endif
         }
 
+        virtual const char* getName(void) const
+        {
+            return "Profiler";
+        }
+
         virtual void softwareVertexSkinning(
             const float *srcPosPtr, float *destPosPtr,
             const float *srcNormPtr, float *destNormPtr,
@@ -342,12 +353,68 @@ namespace Ogre {
             ++index;    // So we can put break point here even if in release build
         }
 
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->cullAxisAlignedBoxes(
+                planes,
+                numPlanes,
+                boxes,
+                visibilities,
+                numBoxes);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
     };
 #endif // __DO_PROFILE__
 
     //---------------------------------------------------------------------
     OptimisedUtil* OptimisedUtil::msImplementation = OptimisedUtil::_detectImplementation();
 
+    //---------------------------------------------------------------------
+    const vector<OptimisedUtil*>::type& OptimisedUtil::getAvailableImplementations(void)
+    {
+        static vector<OptimisedUtil*>::type sImplementations;
+        if (sImplementations.empty())
+        {
+            const uint features = PlatformInformation::getCpuFeatures();
+            (void)features;
+
+            sImplementations.push_back(_getOptimisedUtilGeneral());
+#if __OGRE_HAVE_DIRECTXMATH
+            sImplementations.push_back(_getOptimisedUtilDirectXMath());
+#endif
+#if __OGRE_HAVE_SSE
+            if (features & PlatformInformation::CPU_FEATURE_SSE)
+                sImplementations.push_back(_getOptimisedUtilSSE());
+#endif
+#if __OGRE_HAVE_AVX2
+            if ((features & PlatformInformation::CPU_FEATURE_AVX2) && (features & PlatformInformation::CPU_FEATURE_FMA))
+                sImplementations.push_back(_getOptimisedUtilAVX2());
+#endif
+#if __OGRE_HAVE_AVX512
+            if ((features & PlatformInformation::CPU_FEATURE_AVX512F) &&
+                (features & PlatformInformation::CPU_FEATURE_AVX2) && (features & PlatformInformation::CPU_FEATURE_FMA))
+                sImplementations.push_back(_getOptimisedUtilAVX512());
+#endif
+        }
+        return sImplementations;
+    }
     //---------------------------------------------------------------------
     OptimisedUtil* OptimisedUtil::_detectImplementation(void)
     {
@@ -395,6 +462,23 @@ namespace Ogre {
 
 #else   // !__DO_PROFILE__
 
+#if __OGRE_HAVE_AVX512
+        if ((PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_AVX512F) &&
+            (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_AVX2) &&
+            (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_FMA))
+        {
+            return _getOptimisedUtilAVX512();
+        }
+        else
+#endif
+#if __OGRE_HAVE_AVX2
+        if ((PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_AVX2) &&
+            (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_FMA))
+        {
+            return _getOptimisedUtilAVX2();
+        }
+        else
+#endif
 #if __OGRE_HAVE_SSE
         if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
         {
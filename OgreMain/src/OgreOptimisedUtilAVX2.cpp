@@ -0,0 +1,597 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreOptimisedUtil.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_AVX2
+
+#include <immintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// The routines in this file are compiled for AVX2 and FMA per function,
+// rather than for the whole file, so that no inline function pulled in from
+// the headers gets AVX2 code which would then be shared by the rest of the
+// library. OptimisedUtil only selects this implementation after checking
+// the CPU and OS support at run-time.
+//
+// Vertices are processed 8 at a time, or in pairs, one per 128-bit lane,
+// where every vertex needs its own matrix. The remaining few vertices are
+// handed to the SSE implementation, as is everything which doesn't benefit
+// from wider registers.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
+#   define __OGRE_AVX2_TARGET __attribute__((target("avx2,fma")))
+#else
+#   define __OGRE_AVX2_TARGET
+#endif
+
+namespace Ogre {
+
+    extern OptimisedUtil* _getOptimisedUtilSSE(void);
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX2 implementation of OptimisedUtil.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX2 : public OptimisedUtil
+    {
+    protected:
+        /// Implementation used for short tails and for the routines not done here
+        OptimisedUtil* mFallback;
+
+    public:
+        /// Constructor
+        OptimisedUtilAVX2(OptimisedUtil* fallback)
+            : mFallback(fallback)
+        {
+        }
+
+        /// @copydoc OptimisedUtil::getName
+        virtual const char* getName(void) const { return "AVX2"; }
+
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        virtual void __OGRE_AVX2_TARGET softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Affine3* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        virtual void __OGRE_AVX2_TARGET softwareVertexMorph(
+            Real t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals);
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        virtual void __OGRE_AVX2_TARGET concatenateAffineMatrices(
+            const Affine3& baseMatrix,
+            const Affine3* srcMatrices,
+            Affine3* dstMatrices,
+            size_t numMatrices);
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        virtual void __OGRE_AVX2_TARGET calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles);
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        virtual void __OGRE_AVX2_TARGET calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces);
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        virtual void __OGRE_AVX2_TARGET extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes);
+    };
+
+//-------------------------------------------------------------------------
+// AVX2 helpers
+//-------------------------------------------------------------------------
+
+    /// Map to convert 4-bits mask to 4 byte values
+    static const char msMaskMapping[16][4] =
+    {
+        {0, 0, 0, 0},   {1, 0, 0, 0},   {0, 1, 0, 0},   {1, 1, 0, 0},
+        {0, 0, 1, 0},   {1, 0, 1, 0},   {0, 1, 1, 0},   {1, 1, 1, 0},
+        {0, 0, 0, 1},   {1, 0, 0, 1},   {0, 1, 0, 1},   {1, 1, 0, 1},
+        {0, 0, 1, 1},   {1, 0, 1, 1},   {0, 1, 1, 1},   {1, 1, 1, 1},
+    };
+
+    /// Load (x, y, z, 0) from p0 into the low lane and from p1 into the high lane
+    static inline __m256 __OGRE_AVX2_TARGET _loadXYZ2(const float* p0, const float* p1)
+    {
+        const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+        return _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_maskload_ps(p0, mask)), _mm_maskload_ps(p1, mask), 1);
+    }
+
+    /// Store x, y, z of the low lane to p0 and of the high lane to p1
+    static inline void __OGRE_AVX2_TARGET _storeXYZ2(float* p0, float* p1, __m256 v)
+    {
+        const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+        _mm_maskstore_ps(p0, mask, _mm256_castps256_ps128(v));
+        _mm_maskstore_ps(p1, mask, _mm256_extractf128_ps(v, 1));
+    }
+
+    /// Load 4 floats from p0 into the low lane and from p1 into the high lane
+    static inline __m256 __OGRE_AVX2_TARGET _load2(const float* p0, const float* p1)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p0)), _mm_loadu_ps(p1), 1);
+    }
+
+    /// Transform the vector of each lane by the 3x4 matrix with rows r0, r1, r2 of that lane
+    static inline __m256 __OGRE_AVX2_TARGET _transform3x4(__m256 r0, __m256 r1, __m256 r2, __m256 v)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        __m256 t0 = _mm256_mul_ps(r0, v);
+        __m256 t1 = _mm256_mul_ps(r1, v);
+        __m256 t2 = _mm256_mul_ps(r2, v);
+
+        // (t0.x+t0.z, t1.x+t1.z, t0.y+t0.w, t1.y+t1.w) and (t2.x+t2.z, 0, t2.y+t2.w, 0)
+        __m256 s01 = _mm256_add_ps(_mm256_unpacklo_ps(t0, t1), _mm256_unpackhi_ps(t0, t1));
+        __m256 s2 = _mm256_add_ps(_mm256_unpacklo_ps(t2, zero), _mm256_unpackhi_ps(t2, zero));
+
+        return _mm256_add_ps(
+            _mm256_shuffle_ps(s01, s2, _MM_SHUFFLE(1, 0, 1, 0)),
+            _mm256_shuffle_ps(s01, s2, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+
+    /// Normalise the (x, y, z, 0) vector of each lane selected by mask, zero vectors are left alone
+    static inline __m256 __OGRE_AVX2_TARGET _normaliseXYZ(__m256 v, __m256 mask)
+    {
+        __m256 sq = _mm256_mul_ps(v, v);
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+        sq = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m256 len = _mm256_sqrt_ps(sq);
+        __m256 invLen = _mm256_div_ps(_mm256_set1_ps(1.0f), len);
+        mask = _mm256_and_ps(mask, _mm256_cmp_ps(len, _mm256_setzero_ps(), _CMP_GT_OQ));
+        return _mm256_blendv_ps(v, _mm256_mul_ps(v, invLen), mask);
+    }
+
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        const __m256 allLanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        // Two vertices per iteration, one in each lane. The last vertex
+        // of an odd count takes both lanes, and is stored once.
+        for (size_t i = 0; i < numVertices; i += 2)
+        {
+            const bool pair = i + 1 < numVertices;
+            const ptrdiff_t next = pair ? 1 : 0;
+
+            const float* pBlendWeight1 = rawOffsetPointer(pBlendWeight, next * blendWeightStride);
+            const unsigned char* pBlendIndex1 = rawOffsetPointer(pBlendIndex, next * blendIndexStride);
+
+            // Blend the matrices first, then transform once
+            __m256 r0 = _mm256_setzero_ps();
+            __m256 r1 = _mm256_setzero_ps();
+            __m256 r2 = _mm256_setzero_ps();
+            for (size_t b = 0; b < numWeightsPerVertex; ++b)
+            {
+                const float w0 = pBlendWeight[b];
+                const float w1 = pBlendWeight1[b];
+                const float* m0 = (*blendMatrices[pBlendIndex[b]])[0];
+                const float* m1 = (*blendMatrices[pBlendIndex1[b]])[0];
+
+                __m256 w = _mm256_insertf128_ps(
+                    _mm256_castps128_ps256(_mm_set1_ps(w0)), _mm_set1_ps(w1), 1);
+                r0 = _mm256_fmadd_ps(_load2(m0 + 0, m1 + 0), w, r0);
+                r1 = _mm256_fmadd_ps(_load2(m0 + 4, m1 + 4), w, r1);
+                r2 = _mm256_fmadd_ps(_load2(m0 + 8, m1 + 8), w, r2);
+            }
+
+            // Position, with w = 1
+            const float* pSrcPos1 = rawOffsetPointer(pSrcPos, next * srcPosStride);
+            float* pDestPos1 = rawOffsetPointer(pDestPos, next * destPosStride);
+            __m256 pos = _mm256_blend_ps(_loadXYZ2(pSrcPos, pSrcPos1), _mm256_set1_ps(1.0f), 0x88);
+            __m256 res = _transform3x4(r0, r1, r2, pos);
+            _storeXYZ2(pDestPos, pDestPos1, res);
+
+            if (pSrcNorm)
+            {
+                // Normal, with w = 0 to use the rotational part only
+                const float* pSrcNorm1 = rawOffsetPointer(pSrcNorm, next * srcNormStride);
+                float* pDestNorm1 = rawOffsetPointer(pDestNorm, next * destNormStride);
+                __m256 norm = _transform3x4(r0, r1, r2, _loadXYZ2(pSrcNorm, pSrcNorm1));
+                _storeXYZ2(pDestNorm, pDestNorm1, _normaliseXYZ(norm, allLanes));
+
+                advanceRawPointer(pSrcNorm, 2 * srcNormStride);
+                advanceRawPointer(pDestNorm, 2 * destNormStride);
+            }
+
+            advanceRawPointer(pSrcPos, 2 * srcPosStride);
+            advanceRawPointer(pDestPos, 2 * destPosStride);
+            advanceRawPointer(pBlendWeight, 2 * blendWeightStride);
+            advanceRawPointer(pBlendIndex, 2 * blendIndexStride);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::softwareVertexMorph(
+        Real t,
+        const float *pSrc1, const float *pSrc2,
+        float *pDst,
+        size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+        size_t numVertices,
+        bool morphNormals)
+    {
+        const __m256 t8 = _mm256_set1_ps(t);
+
+        if (!morphNormals &&
+            pos1VSize == sizeof(float) * 3 && pos2VSize == sizeof(float) * 3 && dstVSize == sizeof(float) * 3)
+        {
+            // All buffers are packed, morph as plain arrays of floats
+            size_t numFloats = numVertices * 3;
+            size_t i = 0;
+            for (; i + 8 <= numFloats; i += 8)
+            {
+                __m256 a = _mm256_loadu_ps(pSrc1 + i);
+                __m256 b = _mm256_loadu_ps(pSrc2 + i);
+                _mm256_storeu_ps(pDst + i, _mm256_fmadd_ps(t8, _mm256_sub_ps(b, a), a));
+            }
+            for (; i < numFloats; ++i)
+            {
+                pDst[i] = pSrc1[i] + t * (pSrc2[i] - pSrc1[i]);
+            }
+            return;
+        }
+
+        // Position in the low lane and normal in the high lane, or the positions
+        // of two vertices if there are no normals. Normals need an nlerp.
+        const __m256 normalLanes = morphNormals ?
+            _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1)) : _mm256_setzero_ps();
+
+        for (size_t i = 0; i < numVertices; )
+        {
+            const float *pSrc1b, *pSrc2b;
+            float *pDstb;
+            size_t count;
+            if (morphNormals)
+            {
+                pSrc1b = pSrc1 + 3;
+                pSrc2b = pSrc2 + 3;
+                pDstb = pDst + 3;
+                count = 1;
+            }
+            else
+            {
+                const ptrdiff_t next = i + 1 < numVertices ? 1 : 0;
+                pSrc1b = rawOffsetPointer(pSrc1, next * pos1VSize);
+                pSrc2b = rawOffsetPointer(pSrc2, next * pos2VSize);
+                pDstb = rawOffsetPointer(pDst, next * dstVSize);
+                count = 2;
+            }
+
+            __m256 a = _loadXYZ2(pSrc1, pSrc1b);
+            __m256 b = _loadXYZ2(pSrc2, pSrc2b);
+            __m256 res = _mm256_fmadd_ps(t8, _mm256_sub_ps(b, a), a);
+            _storeXYZ2(pDst, pDstb, _normaliseXYZ(res, normalLanes));
+
+            advanceRawPointer(pSrc1, count * pos1VSize);
+            advanceRawPointer(pSrc2, count * pos2VSize);
+            advanceRawPointer(pDst, count * dstVSize);
+            i += count;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::concatenateAffineMatrices(
+        const Affine3& baseMatrix,
+        const Affine3* pSrcMat,
+        Affine3* pDstMat,
+        size_t numMatrices)
+    {
+        // Rows 0 and 1 of the result in one register, row 2 in another.
+        // Row 3 of the base matrix is (0, 0, 0, 1), so column 3 only adds
+        // its translation, and row 3 of the results is left untouched.
+        __m256 m01[3];
+        __m128 m2[3];
+        for (size_t k = 0; k < 3; ++k)
+        {
+            m01[k] = _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_set1_ps(baseMatrix[0][k])), _mm_set1_ps(baseMatrix[1][k]), 1);
+            m2[k] = _mm_set1_ps(baseMatrix[2][k]);
+        }
+        const __m256 t01 = _mm256_setr_ps(0, 0, 0, baseMatrix[0][3], 0, 0, 0, baseMatrix[1][3]);
+        const __m128 t2 = _mm_setr_ps(0, 0, 0, baseMatrix[2][3]);
+
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            const __m256 s0 = _mm256_broadcast_ps((const __m128*)(*pSrcMat)[0]);
+            const __m256 s1 = _mm256_broadcast_ps((const __m128*)(*pSrcMat)[1]);
+            const __m256 s2 = _mm256_broadcast_ps((const __m128*)(*pSrcMat)[2]);
+
+            __m256 r01 = _mm256_fmadd_ps(m01[0], s0,
+                _mm256_fmadd_ps(m01[1], s1, _mm256_fmadd_ps(m01[2], s2, t01)));
+            __m128 r2 = _mm_fmadd_ps(m2[0], _mm256_castps256_ps128(s0),
+                _mm_fmadd_ps(m2[1], _mm256_castps256_ps128(s1), _mm_fmadd_ps(m2[2], _mm256_castps256_ps128(s2), t2)));
+
+            _mm256_storeu_ps((*pDstMat)[0], r01);
+            _mm_storeu_ps((*pDstMat)[2], r2);
+
+            ++pSrcMat;
+            ++pDstMat;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::calculateFaceNormals(
+        const float *positions,
+        const EdgeData::Triangle *triangles,
+        Vector4 *faceNormals,
+        size_t numTriangles)
+    {
+        size_t i = 0;
+        for (; i + 8 <= numTriangles; i += 8, triangles += 8, faceNormals += 8)
+        {
+            // Load the corners of 8 triangles, triangles 0 to 3 in the low
+            // lanes and 4 to 7 in the high lanes, and transpose them to
+            // structure-of-arrays form. Gathers are slower than this.
+            __m256 vx[3], vy[3], vz[3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                __m256 v0 = _loadXYZ2(positions + triangles[0].vertIndex[k] * 3, positions + triangles[4].vertIndex[k] * 3);
+                __m256 v1 = _loadXYZ2(positions + triangles[1].vertIndex[k] * 3, positions + triangles[5].vertIndex[k] * 3);
+                __m256 v2 = _loadXYZ2(positions + triangles[2].vertIndex[k] * 3, positions + triangles[6].vertIndex[k] * 3);
+                __m256 v3 = _loadXYZ2(positions + triangles[3].vertIndex[k] * 3, positions + triangles[7].vertIndex[k] * 3);
+                __m256 t0 = _mm256_unpacklo_ps(v0, v1);     // x0 x1 y0 y1
+                __m256 t1 = _mm256_unpacklo_ps(v2, v3);     // x2 x3 y2 y3
+                __m256 t2 = _mm256_unpackhi_ps(v0, v1);     // z0 z1 -- --
+                __m256 t3 = _mm256_unpackhi_ps(v2, v3);     // z2 z3 -- --
+                vx[k] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+                vy[k] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+                vz[k] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            }
+
+            // normal = (v2 - v1) x (v3 - v1), w = -(normal . v1)
+            __m256 ax = _mm256_sub_ps(vx[1], vx[0]);
+            __m256 ay = _mm256_sub_ps(vy[1], vy[0]);
+            __m256 az = _mm256_sub_ps(vz[1], vz[0]);
+            __m256 bx = _mm256_sub_ps(vx[2], vx[0]);
+            __m256 by = _mm256_sub_ps(vy[2], vy[0]);
+            __m256 bz = _mm256_sub_ps(vz[2], vz[0]);
+
+            __m256 nx = _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by));
+            __m256 ny = _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz));
+            __m256 nz = _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx));
+            __m256 nw = _mm256_fnmsub_ps(nz, vz[0],
+                _mm256_fmadd_ps(ny, vy[0], _mm256_mul_ps(nx, vx[0])));
+
+            // Transpose to Vector4s, within each lane first
+            __m256 t0 = _mm256_unpacklo_ps(nx, ny);
+            __m256 t1 = _mm256_unpacklo_ps(nz, nw);
+            __m256 t2 = _mm256_unpackhi_ps(nx, ny);
+            __m256 t3 = _mm256_unpackhi_ps(nz, nw);
+            __m256 f0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));   // 0 | 4
+            __m256 f1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));   // 1 | 5
+            __m256 f2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));   // 2 | 6
+            __m256 f3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));   // 3 | 7
+
+            float* pDest = faceNormals->ptr();
+            _mm256_storeu_ps(pDest +  0, _mm256_permute2f128_ps(f0, f1, 0x20));
+            _mm256_storeu_ps(pDest +  8, _mm256_permute2f128_ps(f2, f3, 0x20));
+            _mm256_storeu_ps(pDest + 16, _mm256_permute2f128_ps(f0, f1, 0x31));
+            _mm256_storeu_ps(pDest + 24, _mm256_permute2f128_ps(f2, f3, 0x31));
+        }
+
+        if (i < numTriangles)
+        {
+            mFallback->calculateFaceNormals(positions, triangles, faceNormals, numTriangles - i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::calculateLightFacing(
+        const Vector4& lightPos,
+        const Vector4* faceNormals,
+        char* lightFacings,
+        size_t numFaces)
+    {
+        const __m256 lp = _mm256_broadcast_ps((const __m128*)lightPos.ptr());
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        size_t i = 0;
+        for (; i + 8 <= numFaces; i += 8, faceNormals += 8, lightFacings += 8)
+        {
+            const float* n = faceNormals->ptr();
+            __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(n +  0), lp);    // 0 | 1
+            __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(n +  8), lp);    // 2 | 3
+            __m256 p2 = _mm256_mul_ps(_mm256_loadu_ps(n + 16), lp);    // 4 | 5
+            __m256 p3 = _mm256_mul_ps(_mm256_loadu_ps(n + 24), lp);    // 6 | 7
+
+            // Horizontal sums, ordered (0, 2, 4, 6 | 1, 3, 5, 7) and then fixed up
+            __m256 dots = _mm256_hadd_ps(_mm256_hadd_ps(p0, p1), _mm256_hadd_ps(p2, p3));
+            dots = _mm256_permutevar8x32_ps(dots, order);
+
+            int bitmask = _mm256_movemask_ps(_mm256_cmp_ps(dots, _mm256_setzero_ps(), _CMP_GT_OQ));
+            memcpy(lightFacings + 0, msMaskMapping[bitmask & 0xF], 4);
+            memcpy(lightFacings + 4, msMaskMapping[bitmask >> 4], 4);
+        }
+
+        if (i < numFaces)
+        {
+            mFallback->calculateLightFacing(lightPos, faceNormals, lightFacings, numFaces - i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::extrudeVertices(
+        const Vector4& lightPos,
+        Real extrudeDist,
+        const float* pSrcPos,
+        float* pDestPos,
+        size_t numVertices)
+    {
+        // 8 vertices are 24 floats, or 3 registers, so per component values
+        // are laid out in that repeating (x, y, z) pattern
+        size_t i = 0;
+        if (lightPos.w == 0.0f)
+        {
+            // Directional light, extrusion is along light direction
+            Vector3 extrusionDir(-lightPos.x, -lightPos.y, -lightPos.z);
+            extrusionDir.normalise();
+            extrusionDir *= extrudeDist;
+
+            float pattern[24];
+            for (size_t k = 0; k < 24; ++k)
+                pattern[k] = extrusionDir[k % 3];
+            const __m256 d0 = _mm256_loadu_ps(pattern + 0);
+            const __m256 d1 = _mm256_loadu_ps(pattern + 8);
+            const __m256 d2 = _mm256_loadu_ps(pattern + 16);
+
+            for (; i + 8 <= numVertices; i += 8, pSrcPos += 24, pDestPos += 24)
+            {
+                _mm256_storeu_ps(pDestPos +  0, _mm256_add_ps(_mm256_loadu_ps(pSrcPos +  0), d0));
+                _mm256_storeu_ps(pDestPos +  8, _mm256_add_ps(_mm256_loadu_ps(pSrcPos +  8), d1));
+                _mm256_storeu_ps(pDestPos + 16, _mm256_add_ps(_mm256_loadu_ps(pSrcPos + 16), d2));
+            }
+        }
+        else
+        {
+            // Point light, calculate extrusionDir for every vertex
+            assert(lightPos.w == 1.0f);
+
+            float pattern[24];
+            int scaleIndices[24];
+            for (size_t k = 0; k < 24; ++k)
+            {
+                pattern[k] = lightPos[k % 3];
+                scaleIndices[k] = (int)(k / 3);
+            }
+            const __m256 l0 = _mm256_loadu_ps(pattern + 0);
+            const __m256 l1 = _mm256_loadu_ps(pattern + 8);
+            const __m256 l2 = _mm256_loadu_ps(pattern + 16);
+            const __m256i s0 = _mm256_loadu_si256((const __m256i*)(scaleIndices + 0));
+            const __m256i s1 = _mm256_loadu_si256((const __m256i*)(scaleIndices + 8));
+            const __m256i s2 = _mm256_loadu_si256((const __m256i*)(scaleIndices + 16));
+
+            // Deinterleave permutations, see below
+            const __m256i px = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+            const __m256i py = _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6);
+            const __m256i pz = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+            const __m256 dist = _mm256_set1_ps(extrudeDist);
+            const __m256 zero = _mm256_setzero_ps();
+
+            for (; i + 8 <= numVertices; i += 8, pSrcPos += 24, pDestPos += 24)
+            {
+                __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(pSrcPos +  0), l0);
+                __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(pSrcPos +  8), l1);
+                __m256 d2 = _mm256_sub_ps(_mm256_loadu_ps(pSrcPos + 16), l2);
+                __m256 q0 = _mm256_mul_ps(d0, d0);
+                __m256 q1 = _mm256_mul_ps(d1, d1);
+                __m256 q2 = _mm256_mul_ps(d2, d2);
+
+                // Pick the squared x, y and z of all 8 vertices out of the
+                // 3 registers, then permute them into vertex order
+                __m256 sx = _mm256_blend_ps(_mm256_blend_ps(q0, q1, 0x92), q2, 0x24);
+                __m256 sy = _mm256_blend_ps(_mm256_blend_ps(q0, q1, 0x24), q2, 0x49);
+                __m256 sz = _mm256_blend_ps(_mm256_blend_ps(q0, q1, 0x49), q2, 0x92);
+                __m256 len = _mm256_sqrt_ps(_mm256_add_ps(
+                    _mm256_add_ps(_mm256_permutevar8x32_ps(sx, px), _mm256_permutevar8x32_ps(sy, py)),
+                    _mm256_permutevar8x32_ps(sz, pz)));
+
+                // Per vertex scale, extrudeDist / length, zero for degenerated
+                __m256 scale = _mm256_div_ps(dist, len);
+                scale = _mm256_blendv_ps(zero, scale, _mm256_cmp_ps(len, zero, _CMP_GT_OQ));
+
+                // Back to the interleaved layout
+                _mm256_storeu_ps(pDestPos +  0,
+                    _mm256_fmadd_ps(d0, _mm256_permutevar8x32_ps(scale, s0), _mm256_loadu_ps(pSrcPos +  0)));
+                _mm256_storeu_ps(pDestPos +  8,
+                    _mm256_fmadd_ps(d1, _mm256_permutevar8x32_ps(scale, s1), _mm256_loadu_ps(pSrcPos +  8)));
+                _mm256_storeu_ps(pDestPos + 16,
+                    _mm256_fmadd_ps(d2, _mm256_permutevar8x32_ps(scale, s2), _mm256_loadu_ps(pSrcPos + 16)));
+            }
+        }
+
+        if (i < numVertices)
+        {
+            mFallback->extrudeVertices(lightPos, extrudeDist, pSrcPos, pDestPos, numVertices - i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX2::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* boxes,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        // The boxes come in blocks of 4, which fit SSE exactly
+        mFallback->cullAxisAlignedBoxes(planes, numPlanes, boxes, visibilities, numBoxes);
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void)
+    {
+        static OptimisedUtilAVX2 msOptimisedUtilAVX2(_getOptimisedUtilSSE());
+        return &msOptimisedUtilAVX2;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX2
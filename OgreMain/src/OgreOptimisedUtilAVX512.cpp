@@ -0,0 +1,612 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreOptimisedUtil.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_AVX512
+
+#include <immintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// AVX-512 Foundation routines, compiled per function like the AVX2 ones,
+// see OgreOptimisedUtilAVX2.cpp. Vertices are processed 16 at a time, or 4
+// at a time, one per 128-bit lane, where every vertex needs its own matrix.
+// Tails shorter than a register go to the AVX2 implementation, which is
+// always present on CPUs supporting AVX-512.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
+#   define __OGRE_AVX512_TARGET __attribute__((target("avx512f,avx2,fma")))
+#else
+#   define __OGRE_AVX512_TARGET
+#endif
+
+namespace Ogre {
+
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX-512 implementation of OptimisedUtil.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX512 : public OptimisedUtil
+    {
+    protected:
+        /// Implementation used for short tails and for the routines not done here
+        OptimisedUtil* mFallback;
+
+    public:
+        /// Constructor
+        OptimisedUtilAVX512(OptimisedUtil* fallback)
+            : mFallback(fallback)
+        {
+        }
+
+        /// @copydoc OptimisedUtil::getName
+        virtual const char* getName(void) const { return "AVX512"; }
+
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        virtual void __OGRE_AVX512_TARGET softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Affine3* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        virtual void __OGRE_AVX512_TARGET softwareVertexMorph(
+            Real t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals);
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        virtual void __OGRE_AVX512_TARGET concatenateAffineMatrices(
+            const Affine3& baseMatrix,
+            const Affine3* srcMatrices,
+            Affine3* dstMatrices,
+            size_t numMatrices);
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        virtual void __OGRE_AVX512_TARGET calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles);
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        virtual void __OGRE_AVX512_TARGET calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces);
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        virtual void __OGRE_AVX512_TARGET extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes);
+    };
+
+//-------------------------------------------------------------------------
+// AVX-512 helpers
+//-------------------------------------------------------------------------
+
+    /// Load (x, y, z, 0) from each pointer into the matching 128-bit lane
+    static inline __m512 __OGRE_AVX512_TARGET _loadXYZ4(const float* const p[4])
+    {
+        const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+        __m512 v = _mm512_castps128_ps512(_mm_maskload_ps(p[0], mask));
+        v = _mm512_insertf32x4(v, _mm_maskload_ps(p[1], mask), 1);
+        v = _mm512_insertf32x4(v, _mm_maskload_ps(p[2], mask), 2);
+        return _mm512_insertf32x4(v, _mm_maskload_ps(p[3], mask), 3);
+    }
+
+    /// Store x, y, z of each 128-bit lane to the matching pointer
+    static inline void __OGRE_AVX512_TARGET _storeXYZ4(float* const p[4], __m512 v)
+    {
+        const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+        _mm_maskstore_ps(p[0], mask, _mm512_extractf32x4_ps(v, 0));
+        _mm_maskstore_ps(p[1], mask, _mm512_extractf32x4_ps(v, 1));
+        _mm_maskstore_ps(p[2], mask, _mm512_extractf32x4_ps(v, 2));
+        _mm_maskstore_ps(p[3], mask, _mm512_extractf32x4_ps(v, 3));
+    }
+
+    /** Sum the 4 floats of each 128-bit lane of p[0] to p[3]. Lane j of the
+        result holds the sums of lane j of p[0], p[1], p[2] and p[3].
+    */
+    static inline __m512 __OGRE_AVX512_TARGET _sumLanes4(const __m512 p[4])
+    {
+        // (p0.x+p0.z, p1.x+p1.z, p0.y+p0.w, p1.y+p1.w) and the same for p2, p3
+        __m512 s01 = _mm512_add_ps(_mm512_unpacklo_ps(p[0], p[1]), _mm512_unpackhi_ps(p[0], p[1]));
+        __m512 s23 = _mm512_add_ps(_mm512_unpacklo_ps(p[2], p[3]), _mm512_unpackhi_ps(p[2], p[3]));
+
+        return _mm512_add_ps(
+            _mm512_shuffle_ps(s01, s23, _MM_SHUFFLE(1, 0, 1, 0)),
+            _mm512_shuffle_ps(s01, s23, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+
+    /** Normalise 4 vectors with their x, y and z in lanes 0, 1 and 2, zero
+        vectors are left alone.
+    */
+    static inline __m512 __OGRE_AVX512_TARGET _normaliseLanes(__m512 v)
+    {
+        __m512 sq = _mm512_mul_ps(v, v);
+        __m512 sum = _mm512_add_ps(sq, _mm512_shuffle_f32x4(sq, sq, _MM_SHUFFLE(0, 3, 2, 1)));
+        sum = _mm512_add_ps(sum, _mm512_shuffle_f32x4(sq, sq, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm512_shuffle_f32x4(sum, sum, _MM_SHUFFLE(0, 0, 0, 0));
+        // rsqrt14 is accurate enough for normals
+        __mmask16 mask = _mm512_cmp_ps_mask(sum, _mm512_setzero_ps(), _CMP_GT_OQ);
+        return _mm512_mask_mul_ps(v, mask, v, _mm512_rsqrt14_ps(sum));
+    }
+
+    /// Normalise 16 vectors in structure-of-arrays form, zero vectors are left alone
+    static inline void __OGRE_AVX512_TARGET _normaliseSoA(__m512& x, __m512& y, __m512& z)
+    {
+        __m512 len = _mm512_sqrt_ps(_mm512_fmadd_ps(x, x, _mm512_fmadd_ps(y, y, _mm512_mul_ps(z, z))));
+        __m512 invLen = _mm512_div_ps(_mm512_set1_ps(1.0f), len);
+        __mmask16 mask = _mm512_cmp_ps_mask(len, _mm512_setzero_ps(), _CMP_GT_OQ);
+        x = _mm512_mask_mul_ps(x, mask, x, invLen);
+        y = _mm512_mask_mul_ps(y, mask, y, invLen);
+        z = _mm512_mask_mul_ps(z, mask, z, invLen);
+    }
+
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // From x, y, z in lanes 0, 1, 2 back to one vertex per lane
+        const __m512i transpose = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+        const __m128i xyzMask = _mm_setr_epi32(-1, -1, -1, 0);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        // Four vertices per iteration. Each blended matrix fills a register
+        // with rows 0 to 2 in lanes 0 to 2, and is multiplied by the vertex
+        // copied to all the lanes. Vertices past the last one repeat it,
+        // storing the same result again.
+        for (size_t i = 0; i < numVertices; i += 4)
+        {
+            const size_t count = std::min<size_t>(numVertices - i, 4);
+
+            float* destPos[4];
+            float* destNorm[4];
+            __m512 m[4];
+            __m512 p[4];
+            __m512 n[4];
+            for (size_t k = 0; k < 4; ++k)
+            {
+                const ptrdiff_t v = (ptrdiff_t)std::min(k, count - 1);
+                const float* weights = rawOffsetPointer(pBlendWeight, v * blendWeightStride);
+                const unsigned char* indices = rawOffsetPointer(pBlendIndex, v * blendIndexStride);
+
+                // Blend the matrices first, row 3 ends up in lane 3 unused
+                m[k] = _mm512_mul_ps(_mm512_loadu_ps((*blendMatrices[indices[0]])[0]), _mm512_set1_ps(weights[0]));
+                for (size_t b = 1; b < numWeightsPerVertex; ++b)
+                {
+                    m[k] = _mm512_fmadd_ps(
+                        _mm512_loadu_ps((*blendMatrices[indices[b]])[0]), _mm512_set1_ps(weights[b]), m[k]);
+                }
+
+                // Position, with w = 1
+                __m128 pos = _mm_blend_ps(
+                    _mm_maskload_ps(rawOffsetPointer(pSrcPos, v * srcPosStride), xyzMask), one, 0x8);
+                p[k] = _mm512_mul_ps(m[k], _mm512_broadcast_f32x4(pos));
+                destPos[k] = rawOffsetPointer(pDestPos, v * destPosStride);
+
+                if (pSrcNorm)
+                {
+                    // Normal, with w = 0 to use the rotational part only
+                    __m128 norm = _mm_maskload_ps(rawOffsetPointer(pSrcNorm, v * srcNormStride), xyzMask);
+                    n[k] = _mm512_mul_ps(m[k], _mm512_broadcast_f32x4(norm));
+                    destNorm[k] = rawOffsetPointer(pDestNorm, v * destNormStride);
+                }
+            }
+
+            _storeXYZ4(destPos, _mm512_permutexvar_ps(transpose, _sumLanes4(p)));
+
+            if (pSrcNorm)
+            {
+                __m512 norm = _normaliseLanes(_sumLanes4(n));
+                _storeXYZ4(destNorm, _mm512_permutexvar_ps(transpose, norm));
+
+                advanceRawPointer(pSrcNorm, 4 * srcNormStride);
+                advanceRawPointer(pDestNorm, 4 * destNormStride);
+            }
+
+            advanceRawPointer(pSrcPos, 4 * srcPosStride);
+            advanceRawPointer(pDestPos, 4 * destPosStride);
+            advanceRawPointer(pBlendWeight, 4 * blendWeightStride);
+            advanceRawPointer(pBlendIndex, 4 * blendIndexStride);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::softwareVertexMorph(
+        Real t,
+        const float *pSrc1, const float *pSrc2,
+        float *pDst,
+        size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+        size_t numVertices,
+        bool morphNormals)
+    {
+        const __m512 t16 = _mm512_set1_ps(t);
+
+        if (!morphNormals &&
+            pos1VSize == sizeof(float) * 3 && pos2VSize == sizeof(float) * 3 && dstVSize == sizeof(float) * 3)
+        {
+            // All buffers are packed, morph as plain arrays of floats
+            size_t numFloats = numVertices * 3;
+            for (size_t i = 0; i < numFloats; i += 16)
+            {
+                __mmask16 mask = numFloats - i >= 16 ? 0xFFFF : (__mmask16)((1u << (numFloats - i)) - 1);
+                __m512 a = _mm512_maskz_loadu_ps(mask, pSrc1 + i);
+                __m512 b = _mm512_maskz_loadu_ps(mask, pSrc2 + i);
+                _mm512_mask_storeu_ps(pDst + i, mask, _mm512_fmadd_ps(t16, _mm512_sub_ps(b, a), a));
+            }
+            return;
+        }
+
+        // Gather 16 vertices to structure-of-arrays form, and scatter them back
+        const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i offsets1 = _mm512_mullo_epi32(lanes, _mm512_set1_epi32((int)(pos1VSize / sizeof(float))));
+        const __m512i offsets2 = _mm512_mullo_epi32(lanes, _mm512_set1_epi32((int)(pos2VSize / sizeof(float))));
+        const __m512i offsetsDst = _mm512_mullo_epi32(lanes, _mm512_set1_epi32((int)(dstVSize / sizeof(float))));
+        const __m512 zero = _mm512_setzero_ps();
+        const size_t numComponents = morphNormals ? 6 : 3;
+
+        for (size_t i = 0; i < numVertices; i += 16)
+        {
+            __mmask16 mask = numVertices - i >= 16 ? 0xFFFF : (__mmask16)((1u << (numVertices - i)) - 1);
+
+            __m512 res[6];
+            for (size_t c = 0; c < numComponents; ++c)
+            {
+                __m512 a = _mm512_mask_i32gather_ps(zero, mask, offsets1, pSrc1 + c, 4);
+                __m512 b = _mm512_mask_i32gather_ps(zero, mask, offsets2, pSrc2 + c, 4);
+                res[c] = _mm512_fmadd_ps(t16, _mm512_sub_ps(b, a), a);
+            }
+
+            if (morphNormals)
+            {
+                // nlerp, we don't have enough information for a spherical interp
+                _normaliseSoA(res[3], res[4], res[5]);
+            }
+
+            for (size_t c = 0; c < numComponents; ++c)
+            {
+                _mm512_mask_i32scatter_ps(pDst + c, mask, offsetsDst, res[c], 4);
+            }
+
+            advanceRawPointer(pSrc1, 16 * pos1VSize);
+            advanceRawPointer(pSrc2, 16 * pos2VSize);
+            advanceRawPointer(pDst, 16 * dstVSize);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::concatenateAffineMatrices(
+        const Affine3& baseMatrix,
+        const Affine3* pSrcMat,
+        Affine3* pDstMat,
+        size_t numMatrices)
+    {
+        // Rows 0 to 2 of the result in one register. Row 3 of the base
+        // matrix is (0, 0, 0, 1), so column 3 only adds its translation,
+        // and row 3 of the results is left untouched.
+        const __m512i splat = _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+        __m512 m[3];
+        for (size_t k = 0; k < 3; ++k)
+        {
+            m[k] = _mm512_permutexvar_ps(splat, _mm512_castps128_ps512(
+                _mm_setr_ps(baseMatrix[0][k], baseMatrix[1][k], baseMatrix[2][k], 0)));
+        }
+        const __m512 t = _mm512_setr_ps(
+            0, 0, 0, baseMatrix[0][3],
+            0, 0, 0, baseMatrix[1][3],
+            0, 0, 0, baseMatrix[2][3],
+            0, 0, 0, 0);
+
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            const __m512 s0 = _mm512_broadcast_f32x4(_mm_loadu_ps((*pSrcMat)[0]));
+            const __m512 s1 = _mm512_broadcast_f32x4(_mm_loadu_ps((*pSrcMat)[1]));
+            const __m512 s2 = _mm512_broadcast_f32x4(_mm_loadu_ps((*pSrcMat)[2]));
+
+            __m512 r = _mm512_fmadd_ps(m[0], s0, _mm512_fmadd_ps(m[1], s1, _mm512_fmadd_ps(m[2], s2, t)));
+            _mm512_mask_storeu_ps((*pDstMat)[0], 0x0FFF, r);
+
+            ++pSrcMat;
+            ++pDstMat;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::calculateFaceNormals(
+        const float *positions,
+        const EdgeData::Triangle *triangles,
+        Vector4 *faceNormals,
+        size_t numTriangles)
+    {
+        size_t i = 0;
+        for (; i + 16 <= numTriangles; i += 16, triangles += 16, faceNormals += 16)
+        {
+            // Load the corners of 16 triangles, triangles 4 * j to 4 * j + 3
+            // in lane j, and transpose them to structure-of-arrays form.
+            // Gathers are slower than this.
+            __m512 vx[3], vy[3], vz[3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                __m512 v[4];
+                for (size_t t = 0; t < 4; ++t)
+                {
+                    const float* p[4] = {
+                        positions + triangles[t +  0].vertIndex[k] * 3,
+                        positions + triangles[t +  4].vertIndex[k] * 3,
+                        positions + triangles[t +  8].vertIndex[k] * 3,
+                        positions + triangles[t + 12].vertIndex[k] * 3 };
+                    v[t] = _loadXYZ4(p);
+                }
+                __m512 t0 = _mm512_unpacklo_ps(v[0], v[1]);     // x0 x1 y0 y1
+                __m512 t1 = _mm512_unpacklo_ps(v[2], v[3]);     // x2 x3 y2 y3
+                __m512 t2 = _mm512_unpackhi_ps(v[0], v[1]);     // z0 z1 -- --
+                __m512 t3 = _mm512_unpackhi_ps(v[2], v[3]);     // z2 z3 -- --
+                vx[k] = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+                vy[k] = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+                vz[k] = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            }
+
+            // normal = (v2 - v1) x (v3 - v1), w = -(normal . v1)
+            __m512 ax = _mm512_sub_ps(vx[1], vx[0]);
+            __m512 ay = _mm512_sub_ps(vy[1], vy[0]);
+            __m512 az = _mm512_sub_ps(vz[1], vz[0]);
+            __m512 bx = _mm512_sub_ps(vx[2], vx[0]);
+            __m512 by = _mm512_sub_ps(vy[2], vy[0]);
+            __m512 bz = _mm512_sub_ps(vz[2], vz[0]);
+
+            __m512 nx = _mm512_fmsub_ps(ay, bz, _mm512_mul_ps(az, by));
+            __m512 ny = _mm512_fmsub_ps(az, bx, _mm512_mul_ps(ax, bz));
+            __m512 nz = _mm512_fmsub_ps(ax, by, _mm512_mul_ps(ay, bx));
+            __m512 nw = _mm512_fnmsub_ps(nz, vz[0],
+                _mm512_fmadd_ps(ny, vy[0], _mm512_mul_ps(nx, vx[0])));
+
+            // Transpose to Vector4s, within each lane first, then the lanes
+            __m512 t0 = _mm512_unpacklo_ps(nx, ny);
+            __m512 t1 = _mm512_unpacklo_ps(nz, nw);
+            __m512 t2 = _mm512_unpackhi_ps(nx, ny);
+            __m512 t3 = _mm512_unpackhi_ps(nz, nw);
+            __m512 f0 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));   // 0 | 4 | 8  | 12
+            __m512 f1 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));   // 1 | 5 | 9  | 13
+            __m512 f2 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));   // 2 | 6 | 10 | 14
+            __m512 f3 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));   // 3 | 7 | 11 | 15
+
+            __m512 u0 = _mm512_shuffle_f32x4(f0, f1, _MM_SHUFFLE(1, 0, 1, 0));  // 0 | 4 | 1 | 5
+            __m512 u1 = _mm512_shuffle_f32x4(f2, f3, _MM_SHUFFLE(1, 0, 1, 0));  // 2 | 6 | 3 | 7
+            __m512 u2 = _mm512_shuffle_f32x4(f0, f1, _MM_SHUFFLE(3, 2, 3, 2));  // 8 | 12 | 9 | 13
+            __m512 u3 = _mm512_shuffle_f32x4(f2, f3, _MM_SHUFFLE(3, 2, 3, 2));  // 10 | 14 | 11 | 15
+
+            float* pDest = faceNormals->ptr();
+            _mm512_storeu_ps(pDest +  0, _mm512_shuffle_f32x4(u0, u1, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm512_storeu_ps(pDest + 16, _mm512_shuffle_f32x4(u0, u1, _MM_SHUFFLE(3, 1, 3, 1)));
+            _mm512_storeu_ps(pDest + 32, _mm512_shuffle_f32x4(u2, u3, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm512_storeu_ps(pDest + 48, _mm512_shuffle_f32x4(u2, u3, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+
+        if (i < numTriangles)
+        {
+            mFallback->calculateFaceNormals(positions, triangles, faceNormals, numTriangles - i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::calculateLightFacing(
+        const Vector4& lightPos,
+        const Vector4* faceNormals,
+        char* lightFacings,
+        size_t numFaces)
+    {
+        // Pick the even and the odd elements out of two registers
+        const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+        const __m512 light = _mm512_broadcast_f32x4(_mm_loadu_ps(lightPos.ptr()));
+        const __m512i one = _mm512_set1_epi32(1);
+
+        size_t i = 0;
+        for (; i + 16 <= numFaces; i += 16, faceNormals += 16, lightFacings += 16)
+        {
+            const float* n = faceNormals->ptr();
+            __m512 p0 = _mm512_mul_ps(_mm512_loadu_ps(n +  0), light);
+            __m512 p1 = _mm512_mul_ps(_mm512_loadu_ps(n + 16), light);
+            __m512 p2 = _mm512_mul_ps(_mm512_loadu_ps(n + 32), light);
+            __m512 p3 = _mm512_mul_ps(_mm512_loadu_ps(n + 48), light);
+
+            // Horizontal sums of each face, (x + y, z + w) pairs first
+            __m512 s01 = _mm512_add_ps(_mm512_permutex2var_ps(p0, even, p1), _mm512_permutex2var_ps(p0, odd, p1));
+            __m512 s23 = _mm512_add_ps(_mm512_permutex2var_ps(p2, even, p3), _mm512_permutex2var_ps(p2, odd, p3));
+            __m512 dots = _mm512_add_ps(_mm512_permutex2var_ps(s01, even, s23), _mm512_permutex2var_ps(s01, odd, s23));
+
+            // One byte per face, narrowed from the 0 or 1 dwords
+            __mmask16 facing = _mm512_cmp_ps_mask(dots, _mm512_setzero_ps(), _CMP_GT_OQ);
+            _mm_storeu_si128((__m128i*)lightFacings, _mm512_cvtepi32_epi8(_mm512_maskz_mov_epi32(facing, one)));
+        }
+
+        if (i < numFaces)
+        {
+            mFallback->calculateLightFacing(lightPos, faceNormals, lightFacings, numFaces - i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::extrudeVertices(
+        const Vector4& lightPos,
+        Real extrudeDist,
+        const float* pSrcPos,
+        float* pDestPos,
+        size_t numVertices)
+    {
+        // 16 vertices are 48 floats, or 3 registers, so per component values
+        // are laid out in that repeating (x, y, z) pattern
+        size_t i = 0;
+        if (lightPos.w == 0.0f)
+        {
+            // Directional light, extrusion is along light direction
+            Vector3 extrusionDir(-lightPos.x, -lightPos.y, -lightPos.z);
+            extrusionDir.normalise();
+            extrusionDir *= extrudeDist;
+
+            float pattern[48];
+            for (size_t k = 0; k < 48; ++k)
+                pattern[k] = extrusionDir[k % 3];
+            const __m512 d0 = _mm512_loadu_ps(pattern + 0);
+            const __m512 d1 = _mm512_loadu_ps(pattern + 16);
+            const __m512 d2 = _mm512_loadu_ps(pattern + 32);
+
+            for (; i + 16 <= numVertices; i += 16, pSrcPos += 48, pDestPos += 48)
+            {
+                _mm512_storeu_ps(pDestPos +  0, _mm512_add_ps(_mm512_loadu_ps(pSrcPos +  0), d0));
+                _mm512_storeu_ps(pDestPos + 16, _mm512_add_ps(_mm512_loadu_ps(pSrcPos + 16), d1));
+                _mm512_storeu_ps(pDestPos + 32, _mm512_add_ps(_mm512_loadu_ps(pSrcPos + 32), d2));
+            }
+        }
+        else
+        {
+            // Point light, calculate extrusionDir for every vertex
+            assert(lightPos.w == 1.0f);
+
+            float pattern[48];
+            int scaleIndices[48];
+            int pick01[3][16], pick2[3][16];
+            for (size_t k = 0; k < 48; ++k)
+            {
+                pattern[k] = lightPos[k % 3];
+                scaleIndices[k] = (int)(k / 3);
+            }
+            // Component c of vertex k is element 3 * k + c of the 48 floats,
+            // the first 32 of them are picked from registers 0 and 1, the
+            // rest from register 2
+            for (size_t c = 0; c < 3; ++c)
+            {
+                for (size_t k = 0; k < 16; ++k)
+                {
+                    int e = (int)(k * 3 + c);
+                    pick01[c][k] = e < 32 ? e : 0;
+                    pick2[c][k] = e < 32 ? (int)k : e - 32 + 16;
+                }
+            }
+            const __m512 l0 = _mm512_loadu_ps(pattern + 0);
+            const __m512 l1 = _mm512_loadu_ps(pattern + 16);
+            const __m512 l2 = _mm512_loadu_ps(pattern + 32);
+            const __m512i s0 = _mm512_loadu_si512(scaleIndices + 0);
+            const __m512i s1 = _mm512_loadu_si512(scaleIndices + 16);
+            const __m512i s2 = _mm512_loadu_si512(scaleIndices + 32);
+            const __m512i x01 = _mm512_loadu_si512(pick01[0]), x2 = _mm512_loadu_si512(pick2[0]);
+            const __m512i y01 = _mm512_loadu_si512(pick01[1]), y2 = _mm512_loadu_si512(pick2[1]);
+            const __m512i z01 = _mm512_loadu_si512(pick01[2]), z2 = _mm512_loadu_si512(pick2[2]);
+
+            const __m512 dist = _mm512_set1_ps(extrudeDist);
+            const __m512 zero = _mm512_setzero_ps();
+
+            for (; i + 16 <= numVertices; i += 16, pSrcPos += 48, pDestPos += 48)
+            {
+                __m512 a0 = _mm512_loadu_ps(pSrcPos +  0);
+                __m512 a1 = _mm512_loadu_ps(pSrcPos + 16);
+                __m512 a2 = _mm512_loadu_ps(pSrcPos + 32);
+                __m512 d0 = _mm512_sub_ps(a0, l0);
+                __m512 d1 = _mm512_sub_ps(a1, l1);
+                __m512 d2 = _mm512_sub_ps(a2, l2);
+
+                // Per vertex scale, extrudeDist / length, in structure-of-arrays form
+                __m512 dx = _mm512_permutex2var_ps(_mm512_permutex2var_ps(d0, x01, d1), x2, d2);
+                __m512 dy = _mm512_permutex2var_ps(_mm512_permutex2var_ps(d0, y01, d1), y2, d2);
+                __m512 dz = _mm512_permutex2var_ps(_mm512_permutex2var_ps(d0, z01, d1), z2, d2);
+                __m512 len = _mm512_sqrt_ps(
+                    _mm512_fmadd_ps(dx, dx, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dz, dz))));
+                __mmask16 nonZero = _mm512_cmp_ps_mask(len, zero, _CMP_GT_OQ);
+                __m512 scale = _mm512_maskz_div_ps(nonZero, dist, len);
+
+                // Back to the interleaved layout
+                _mm512_storeu_ps(pDestPos +  0, _mm512_fmadd_ps(d0, _mm512_permutexvar_ps(s0, scale), a0));
+                _mm512_storeu_ps(pDestPos + 16, _mm512_fmadd_ps(d1, _mm512_permutexvar_ps(s1, scale), a1));
+                _mm512_storeu_ps(pDestPos + 32, _mm512_fmadd_ps(d2, _mm512_permutexvar_ps(s2, scale), a2));
+            }
+        }
+
+        if (i < numVertices)
+        {
+            mFallback->extrudeVertices(lightPos, extrudeDist, pSrcPos, pDestPos, numVertices - i);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX512::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* boxes,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        // The boxes come in blocks of 4, which fit SSE exactly
+        mFallback->cullAxisAlignedBoxes(planes, numPlanes, boxes, visibilities, numBoxes);
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX512(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX512(void)
+    {
+        static OptimisedUtilAVX512 msOptimisedUtilAVX512(_getOptimisedUtilAVX2());
+        return &msOptimisedUtilAVX512;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX512
@@ -42,6 +42,9 @@ namespace Ogre {
     class _OgrePrivate OptimisedUtilGeneral : public OptimisedUtil
     {
     public:
+        /// @copydoc OptimisedUtil::getName
+        virtual const char* getName(void) const { return "General"; }
+
         /// @copydoc OptimisedUtil::softwareVertexSkinning
         virtual void softwareVertexSkinning(
             const float *srcPosPtr, float *destPosPtr,
@@ -91,6 +94,14 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -364,6 +375,33 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* boxes,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            // Locate the box in the structure-of-arrays block
+            const float* block = boxes + (i / 4) * 24 + (i % 4);
+            Vector3 centre(block[0], block[4], block[8]);
+            Vector3 halfSize(block[12], block[16], block[20]);
+
+            char visible = true;
+            for (size_t plane = 0; plane < numPlanes; ++plane)
+            {
+                if (planes[plane].getSide(centre, halfSize) == Plane::NEGATIVE_SIDE)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
@@ -80,6 +80,9 @@ namespace Ogre {
         /// Constructor
         OptimisedUtilSSE(void);
 
+        /// @copydoc OptimisedUtil::getName
+        virtual const char* getName(void) const { return "SSE"; }
+
         /// @copydoc OptimisedUtil::softwareVertexSkinning
         virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE softwareVertexSkinning(
             const float *srcPosPtr, float *destPosPtr,
@@ -129,6 +132,14 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -157,6 +168,12 @@ namespace Ogre {
         {
         }
 
+        /// @copydoc OptimisedUtil::getName
+        virtual const char* getName(void) const
+        {
+            return mImpl->getName();
+        }
+
         /// @copydoc OptimisedUtil::softwareVertexSkinning
         virtual void softwareVertexSkinning(
             const float *srcPosPtr, float *destPosPtr,
@@ -268,6 +285,24 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->cullAxisAlignedBoxes(
+                planes,
+                numPlanes,
+                boxes,
+                visibilities,
+                numBoxes);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -1495,16 +1530,10 @@ namespace Ogre {
                 // Fill a 4-vec with vector length
                 // square
                 __m128 tmp = _mm_mul_ps(norm, norm);
-                // Add - for this we want this effect:
-                // orig   3 | 2 | 1 | 0
-                // add1   0 | 0 | 0 | 2
-                // add2   2 | 3 | 0 | 3
-                // This way elements 0, 2 and 3 have the sum of all entries (except 1 which is unused)
-                
-                tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(0,0,0,2)));
-                // Add final combination & sqrt 
-                // bottom 3 elements of l will have length, we don't care about 4
-                tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(2,3,0,3)));
+                // Element 1 is zero, so the horizontal sum of all four
+                // elements is the squared length
+                tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(2,3,0,1)));
+                tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(1,0,3,2)));
                 // Then divide to normalise
                 norm = _mm_div_ps(norm, _mm_sqrt_ps(tmp));
                 
@@ -2130,6 +2159,86 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilSSE::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* boxes,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        assert(_isAlignedForSSE(boxes));
+
+        // Map to convert 4-bits mask to 4 byte values
+        static const char msMaskMapping[16][4] =
+        {
+            {0, 0, 0, 0},   {1, 0, 0, 0},   {0, 1, 0, 0},   {1, 1, 0, 0},
+            {0, 0, 1, 0},   {1, 0, 1, 0},   {0, 1, 1, 0},   {1, 1, 1, 0},
+            {0, 0, 0, 1},   {1, 0, 0, 1},   {0, 1, 0, 1},   {1, 1, 0, 1},
+            {0, 0, 1, 1},   {1, 0, 1, 1},   {0, 1, 1, 1},   {1, 1, 1, 1},
+        };
+
+        // Splat the planes once, the absolute value of the normal is used
+        // to project the half size onto it
+        const size_t maxPlanes = 8;
+        __m128 nx[maxPlanes], ny[maxPlanes], nz[maxPlanes], nd[maxPlanes];
+        __m128 ax[maxPlanes], ay[maxPlanes], az[maxPlanes];
+        assert(numPlanes <= maxPlanes);
+        for (size_t i = 0; i < numPlanes; ++i)
+        {
+            nx[i] = _mm_set_ps1(static_cast<float>(planes[i].normal.x));
+            ny[i] = _mm_set_ps1(static_cast<float>(planes[i].normal.y));
+            nz[i] = _mm_set_ps1(static_cast<float>(planes[i].normal.z));
+            nd[i] = _mm_set_ps1(static_cast<float>(planes[i].d));
+            ax[i] = _mm_set_ps1(static_cast<float>(Math::Abs(planes[i].normal.x)));
+            ay[i] = _mm_set_ps1(static_cast<float>(Math::Abs(planes[i].normal.y)));
+            az[i] = _mm_set_ps1(static_cast<float>(Math::Abs(planes[i].normal.z)));
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        size_t numIterations = (numBoxes + 3) / 4;
+        for (size_t i = 0; i < numIterations; ++i)
+        {
+            __m128 cx = _mm_load_ps(boxes + 0);
+            __m128 cy = _mm_load_ps(boxes + 4);
+            __m128 cz = _mm_load_ps(boxes + 8);
+            __m128 hx = _mm_load_ps(boxes + 12);
+            __m128 hy = _mm_load_ps(boxes + 16);
+            __m128 hz = _mm_load_ps(boxes + 20);
+            boxes += 24;
+
+            // A box is culled if it is entirely on the negative side of a
+            // plane, i.e. distance < -projected half size. Same evaluation
+            // order as Plane::getSide, so the results match exactly.
+            __m128 culled = zero;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                __m128 dist = _mm_add_ps(__MM_DOT3x3_PS(nx[p], ny[p], nz[p], cx, cy, cz), nd[p]);
+                __m128 radius = __MM_DOT3x3_PS(ax[p], ay[p], az[p], hx, hy, hz);
+                culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, _mm_sub_ps(zero, radius)));
+
+                // All 4 boxes culled already
+                if (_mm_movemask_ps(culled) == 0xF)
+                    break;
+            }
+
+            int bitmask = ~_mm_movemask_ps(culled) & 0xF;
+            size_t count = std::min<size_t>(numBoxes - i * 4, 4);
+            if (count == 4)
+            {
+                // Store 4 visibility flags at once
+                memcpy(visibilities, msMaskMapping[bitmask], 4);
+            }
+            else
+            {
+                for (size_t j = 0; j < count; ++j)
+                    visibilities[j] = msMaskMapping[bitmask][j];
+            }
+            visibilities += 4;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
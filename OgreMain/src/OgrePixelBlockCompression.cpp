@@ -0,0 +1,855 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelBlockCompression.h"
+#include "OgrePixelBlockDecompression.h"
+#include "OgreRoot.h"
+#include "OgreTaskScheduler.h"
+
+namespace Ogre {
+
+    namespace {
+        //---------------------------------------------------------------------
+        // Endpoint fitting
+        //---------------------------------------------------------------------
+        /// Pixels of a block, or of a subset of one
+        struct BlockPixels
+        {
+            float values[16][4];
+            /// Position of every pixel in the block
+            uint8 positions[16];
+            size_t count;
+            size_t channels;
+
+            explicit BlockPixels(size_t numChannels) : count(0), channels(numChannels) {}
+
+            void add(const uint8* pixel, size_t position)
+            {
+                for (size_t c = 0; c < channels; ++c)
+                    values[count][c] = pixel[c];
+                positions[count++] = static_cast<uint8>(position);
+            }
+        };
+        //---------------------------------------------------------------------
+        inline float distance(const float* a, const uint8* b, size_t channels)
+        {
+            float d = 0;
+            for (size_t c = 0; c < channels; ++c)
+                d += (a[c] - b[c]) * (a[c] - b[c]);
+            return d;
+        }
+        //---------------------------------------------------------------------
+        /// Index of the nearest of count palette entries, which are 4 bytes apart
+        inline uint8 nearest(const float* value, const uint8* palette, size_t count, size_t channels, float& error)
+        {
+            uint8 best = 0;
+            error = distance(value, palette, channels);
+            for (size_t i = 1; i < count && error > 0; ++i)
+            {
+                float d = distance(value, palette + i * 4, channels);
+                if (d < error)
+                {
+                    error = d;
+                    best = static_cast<uint8>(i);
+                }
+            }
+            return best;
+        }
+        //---------------------------------------------------------------------
+        /// Mean and covariance of the channels of the pixels
+        void covariance(const BlockPixels& pixels, float mean[4], float cov[4][4])
+        {
+            const size_t n = pixels.channels;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                mean[c] = 0;
+                for (size_t d = 0; d < 4; ++d)
+                    cov[c][d] = 0;
+            }
+            for (size_t i = 0; i < pixels.count; ++i)
+                for (size_t c = 0; c < n; ++c)
+                    mean[c] += pixels.values[i][c];
+            for (size_t c = 0; c < n; ++c)
+                mean[c] /= pixels.count;
+            for (size_t i = 0; i < pixels.count; ++i)
+            {
+                for (size_t c = 0; c < n; ++c)
+                    for (size_t d = c; d < n; ++d)
+                        cov[c][d] += (pixels.values[i][c] - mean[c]) * (pixels.values[i][d] - mean[d]);
+            }
+            for (size_t c = 0; c < n; ++c)
+                for (size_t d = 0; d < c; ++d)
+                    cov[c][d] = cov[d][c];
+        }
+        //---------------------------------------------------------------------
+        /** Unit length principal axis of a covariance matrix by power iteration.
+            @return the variance along it, 0 if all pixels are the same
+        */
+        float principalAxis(const float cov[4][4], size_t channels, float axis[4])
+        {
+            // start with the channel of the largest variance
+            size_t widest = 0;
+            for (size_t c = 0; c < 4; ++c)
+            {
+                axis[c] = 0;
+                if (c < channels && cov[c][c] > cov[widest][widest])
+                    widest = c;
+            }
+            if (cov[widest][widest] <= 0)
+                return 0;
+            axis[widest] = 1;
+
+            float length = 0;
+            for (int iteration = 0; iteration < 8; ++iteration)
+            {
+                float next[4] = { 0, 0, 0, 0 };
+                for (size_t c = 0; c < channels; ++c)
+                    for (size_t d = 0; d < channels; ++d)
+                        next[c] += cov[c][d] * axis[d];
+                length = 0;
+                for (size_t c = 0; c < channels; ++c)
+                    length += next[c] * next[c];
+                length = std::sqrt(length);
+                if (length <= 0)
+                    return 0;
+                for (size_t c = 0; c < channels; ++c)
+                    axis[c] = next[c] / length;
+            }
+            return length;
+        }
+        //---------------------------------------------------------------------
+        inline float clampChannel(float v)
+        {
+            return std::min(std::max(v, 0.0f), 255.0f);
+        }
+        //---------------------------------------------------------------------
+        /** Endpoints of a line through the pixels. CQ_FAST takes the bounding
+            box, inset by 1/16, with the channels that decrease along the
+            widest one swapped. The other qualities take the extent of the
+            pixels along their principal axis.
+        */
+        void fitEndpoints(const BlockPixels& pixels, Image::CompressionQuality quality, float e0[4], float e1[4])
+        {
+            const size_t n = pixels.channels;
+            float mean[4], cov[4][4], axis[4];
+            covariance(pixels, mean, cov);
+
+            if (quality == Image::CQ_FAST)
+            {
+                size_t widest = 0;
+                for (size_t c = 0; c < n; ++c)
+                {
+                    e0[c] = 255;
+                    e1[c] = 0;
+                    for (size_t i = 0; i < pixels.count; ++i)
+                    {
+                        e0[c] = std::min(e0[c], pixels.values[i][c]);
+                        e1[c] = std::max(e1[c], pixels.values[i][c]);
+                    }
+                    if (e1[c] - e0[c] > e1[widest] - e0[widest])
+                        widest = c;
+                }
+                for (size_t c = 0; c < n; ++c)
+                {
+                    if (cov[c][widest] < 0)
+                        std::swap(e0[c], e1[c]);
+                    float inset = (e1[c] - e0[c]) / 16;
+                    e0[c] += inset;
+                    e1[c] -= inset;
+                }
+                return;
+            }
+
+            if (principalAxis(cov, n, axis) <= 0)
+            {
+                for (size_t c = 0; c < n; ++c)
+                    e0[c] = e1[c] = mean[c];
+                return;
+            }
+            float lo = 0, hi = 0;
+            for (size_t i = 0; i < pixels.count; ++i)
+            {
+                float t = 0;
+                for (size_t c = 0; c < n; ++c)
+                    t += (pixels.values[i][c] - mean[c]) * axis[c];
+                lo = std::min(lo, t);
+                hi = std::max(hi, t);
+            }
+            for (size_t c = 0; c < n; ++c)
+            {
+                e0[c] = clampChannel(mean[c] + axis[c] * lo);
+                e1[c] = clampChannel(mean[c] + axis[c] * hi);
+            }
+        }
+        //---------------------------------------------------------------------
+        /** Least squares endpoints of the line the pixels are interpolated
+            along, given the position of every pixel on it from 0 to 1.
+            @return false if the positions do not determine the endpoints
+        */
+        bool refineEndpoints(const BlockPixels& pixels, const float* weights, float e0[4], float e1[4])
+        {
+            float aa = 0, ab = 0, bb = 0;
+            float ax[4] = { 0, 0, 0, 0 }, bx[4] = { 0, 0, 0, 0 };
+            for (size_t i = 0; i < pixels.count; ++i)
+            {
+                float b = weights[i], a = 1 - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (size_t c = 0; c < pixels.channels; ++c)
+                {
+                    ax[c] += a * pixels.values[i][c];
+                    bx[c] += b * pixels.values[i][c];
+                }
+            }
+            float det = aa * bb - ab * ab;
+            if (std::abs(det) < 1e-6f)
+                return false;
+            for (size_t c = 0; c < pixels.channels; ++c)
+            {
+                e0[c] = clampChannel((bb * ax[c] - ab * bx[c]) / det);
+                e1[c] = clampChannel((aa * bx[c] - ab * ax[c]) / det);
+            }
+            return true;
+        }
+        //---------------------------------------------------------------------
+        /// How often the endpoints are quantised and refined
+        inline int numIterations(Image::CompressionQuality quality)
+        {
+            return quality == Image::CQ_FAST ? 1 : quality == Image::CQ_NORMAL ? 2 : 4;
+        }
+
+        //---------------------------------------------------------------------
+        // BC1 - BC5
+        //---------------------------------------------------------------------
+        inline uint16 quantise565(const float* colour)
+        {
+            uint32 r = static_cast<uint32>(colour[0] * 31 / 255 + 0.5f);
+            uint32 g = static_cast<uint32>(colour[1] * 63 / 255 + 0.5f);
+            uint32 b = static_cast<uint32>(colour[2] * 31 / 255 + 0.5f);
+            return static_cast<uint16>((r << 11) | (g << 5) | b);
+        }
+        //---------------------------------------------------------------------
+        inline void writeUint16(uint8* dst, uint16 value)
+        {
+            dst[0] = static_cast<uint8>(value);
+            dst[1] = static_cast<uint8>(value >> 8);
+        }
+        //---------------------------------------------------------------------
+        /** Encodes the colours of a DXT/BC1-3 colour block. If transparency is
+            allowed, which BC1 does, pixels with alpha below 128 use the 3
+            colour mode, whose fourth colour is transparent black.
+        */
+        void encodeColourBlock(const uint8* pixels, bool allowTransparency,
+            Image::CompressionQuality quality, uint8* block)
+        {
+            BlockPixels opaque(3);
+            for (size_t i = 0; i < 16; ++i)
+            {
+                if (!allowTransparency || pixels[i * 4 + 3] >= 128)
+                    opaque.add(pixels + i * 4, i);
+            }
+            const bool threeColours = opaque.count < 16;
+            if (opaque.count == 0)
+            {
+                // equal endpoints and all indices 3
+                memset(block, 0, 4);
+                memset(block + 4, 0xFF, 4);
+                return;
+            }
+
+            // position on the line between the endpoints of each palette entry
+            static const float POSITIONS4[4] = { 0, 1, 1.0f / 3, 2.0f / 3 };
+            static const float POSITIONS3[3] = { 0, 1, 0.5f };
+
+            float e0[4], e1[4];
+            fitEndpoints(opaque, quality, e0, e1);
+            float bestError = std::numeric_limits<float>::max();
+            const int iterations = numIterations(quality);
+            for (int iteration = 0; iteration < iterations; ++iteration)
+            {
+                uint16 c0 = quantise565(e0), c1 = quantise565(e1);
+                // the order of the endpoints selects the mode
+                if (threeColours ? c0 > c1 : c0 < c1)
+                {
+                    std::swap(c0, c1);
+                    std::swap(e0, e1);
+                }
+                uint8 candidate[8];
+                writeUint16(candidate, c0);
+                writeUint16(candidate + 2, c1);
+                uint8 palette[16];
+                _decodeBlockColourPalette(candidate, false, palette);
+                // equal endpoints decode in the 3 colour mode, all of whose colours are the same
+                const bool fourColours = !threeColours && c0 != c1;
+
+                uint8 indices[16];
+                memset(indices, 3, sizeof(indices));
+                float weights[16], error = 0;
+                for (size_t i = 0; i < opaque.count; ++i)
+                {
+                    float d;
+                    uint8 index = nearest(opaque.values[i], palette, fourColours ? 4 : 3, 3, d);
+                    indices[opaque.positions[i]] = index;
+                    weights[i] = fourColours ? POSITIONS4[index] : POSITIONS3[index];
+                    error += d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    for (size_t y = 0; y < 4; ++y)
+                    {
+                        candidate[4 + y] = static_cast<uint8>(indices[y * 4] | (indices[y * 4 + 1] << 2) |
+                                                              (indices[y * 4 + 2] << 4) | (indices[y * 4 + 3] << 6));
+                    }
+                    memcpy(block, candidate, sizeof(candidate));
+                }
+                if (error == 0 || !refineEndpoints(opaque, weights, e0, e1))
+                    break;
+            }
+        }
+        //---------------------------------------------------------------------
+        /// Writes the endpoints and indices of a BC3 alpha or BC4 block, returns the squared error
+        float encodeChannelEndpoints(const BlockPixels& values, uint8 a0, uint8 a1, uint8* block, float* weights)
+        {
+            block[0] = a0;
+            block[1] = a1;
+            uint8 palette[8], paletteRGBA[32];
+            _decodeBlockAlphaPalette(block, palette);
+            for (size_t i = 0; i < 8; ++i)
+                paletteRGBA[i * 4] = palette[i];
+
+            uint64 bits = 0;
+            float error = 0;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                float d;
+                uint64 index = nearest(values.values[i], paletteRGBA, 8, 1, d);
+                bits |= index << (i * 3);
+                error += d;
+                if (weights)
+                    weights[i] = index < 2 ? static_cast<float>(index) : (index - 1) / 7.0f;
+            }
+            for (size_t i = 0; i < 6; ++i)
+                block[2 + i] = static_cast<uint8>(bits >> (i * 8));
+            return error;
+        }
+        //---------------------------------------------------------------------
+        /// Encodes one channel of the pixels as a BC3 alpha or BC4 block
+        void encodeChannelBlock(const uint8* pixels, size_t channel, Image::CompressionQuality quality, uint8* block)
+        {
+            BlockPixels values(1);
+            uint8 lo = 255, hi = 0, innerLo = 255, innerHi = 0;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                uint8 v = pixels[i * 4 + channel];
+                values.add(&v, i);
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+                if (v != 0 && v != 255)
+                {
+                    innerLo = std::min(innerLo, v);
+                    innerHi = std::max(innerHi, v);
+                }
+            }
+            if (lo == hi)
+            {
+                block[0] = block[1] = lo;
+                memset(block + 2, 0, 6);
+                return;
+            }
+
+            // 8 values between the extremes
+            float weights[16];
+            float bestError = encodeChannelEndpoints(values, hi, lo, block, weights);
+            if (quality == Image::CQ_FAST)
+                return;
+
+            uint8 candidate[8];
+            if (quality == Image::CQ_BEST)
+            {
+                float e0 = hi, e1 = lo;
+                for (int iteration = 1; iteration < numIterations(quality) && bestError > 0; ++iteration)
+                {
+                    if (!refineEndpoints(values, weights, &e0, &e1))
+                        break;
+                    int a0 = static_cast<int>(e0 + 0.5f), a1 = static_cast<int>(e1 + 0.5f);
+                    if (a0 <= a1)
+                        break;
+                    float error = encodeChannelEndpoints(values, static_cast<uint8>(a0), static_cast<uint8>(a1),
+                                                         candidate, weights);
+                    if (error >= bestError)
+                        break;
+                    bestError = error;
+                    memcpy(block, candidate, sizeof(candidate));
+                }
+            }
+
+            // 6 values between the extremes other than 0 and 255, which are exact
+            if (lo == 0 || hi == 255)
+            {
+                if (innerLo > innerHi)
+                    innerLo = innerHi = 0;
+                if (encodeChannelEndpoints(values, innerLo, innerHi, candidate, 0) < bestError)
+                    memcpy(block, candidate, sizeof(candidate));
+            }
+        }
+        //---------------------------------------------------------------------
+        void encodeBC1(const uint8* pixels, uint8* block, Image::CompressionQuality quality)
+        {
+            encodeColourBlock(pixels, true, quality, block);
+        }
+        //---------------------------------------------------------------------
+        void encodeBC2(const uint8* pixels, uint8* block, Image::CompressionQuality quality)
+        {
+            // explicit 4 bit alpha
+            for (size_t i = 0; i < 8; ++i)
+            {
+                uint32 a0 = (pixels[i * 8 + 3] * 15 + 127) / 255;
+                uint32 a1 = (pixels[i * 8 + 7] * 15 + 127) / 255;
+                block[i] = static_cast<uint8>(a0 | (a1 << 4));
+            }
+            encodeColourBlock(pixels, false, quality, block + 8);
+        }
+        //---------------------------------------------------------------------
+        void encodeBC3(const uint8* pixels, uint8* block, Image::CompressionQuality quality)
+        {
+            encodeChannelBlock(pixels, 3, quality, block);
+            encodeColourBlock(pixels, false, quality, block + 8);
+        }
+        //---------------------------------------------------------------------
+        void encodeBC4(const uint8* pixels, uint8* block, Image::CompressionQuality quality)
+        {
+            encodeChannelBlock(pixels, 0, quality, block);
+        }
+        //---------------------------------------------------------------------
+        void encodeBC5(const uint8* pixels, uint8* block, Image::CompressionQuality quality)
+        {
+            encodeChannelBlock(pixels, 0, quality, block);
+            encodeChannelBlock(pixels, 1, quality, block + 8);
+        }
+
+        //---------------------------------------------------------------------
+        // BC7
+        //---------------------------------------------------------------------
+        /// Writes the fields of a BC7 block, least significant bits first
+        class BlockBitWriter
+        {
+            uint8* mBlock;
+            uint32 mPos;
+        public:
+            explicit BlockBitWriter(uint8* block) : mBlock(block), mPos(0)
+            {
+                memset(block, 0, 16);
+            }
+
+            void write(uint32 value, uint32 count)
+            {
+                for (uint32 i = 0; i < count; ++i, ++mPos)
+                    mBlock[mPos / 8] |= static_cast<uint8>(((value >> i) & 1) << (mPos % 8));
+            }
+        };
+        //---------------------------------------------------------------------
+        /// A channel of bits and a p-bit expanded to 8 bits, as the decoder does
+        inline uint8 expandEndpoint(uint32 value, uint32 pbit, uint32 bits)
+        {
+            uint32 v = ((value << 1) | pbit) << (7 - bits);
+            return static_cast<uint8>(v | (v >> (bits + 1)));
+        }
+        //---------------------------------------------------------------------
+        /** Quantises the channels of an endpoint to bits and a p-bit.
+            @return the squared error of the expanded endpoint
+        */
+        float quantiseEndpoint(const float* e, size_t channels, uint32 bits, uint32 pbit,
+            uint8* quantised, uint8* expanded)
+        {
+            const int maxValue = (1 << bits) - 1;
+            float error = 0;
+            for (size_t c = 0; c < channels; ++c)
+            {
+                int guess = static_cast<int>((e[c] * ((2 << bits) - 1) / 255 - pbit) / 2 + 0.5f);
+                float best = std::numeric_limits<float>::max();
+                for (int v = std::max(guess - 1, 0); v <= std::min(guess + 1, maxValue); ++v)
+                {
+                    uint8 x = expandEndpoint(v, pbit, bits);
+                    float d = (x - e[c]) * (x - e[c]);
+                    if (d < best)
+                    {
+                        best = d;
+                        quantised[c] = static_cast<uint8>(v);
+                        expanded[c] = x;
+                    }
+                }
+                error += best;
+            }
+            return error;
+        }
+        //---------------------------------------------------------------------
+        /// The endpoints and indices of a subset of a BC7 block
+        struct BC7Subset
+        {
+            uint8 endpoints[2][4];
+            uint8 pbits[2];
+            /// Indices of the pixels of the subset, by position in the block
+            uint8 indices[16];
+            float error;
+        };
+        //---------------------------------------------------------------------
+        /** Encodes the pixels of one subset of a BC7 block.
+            @param shared Whether the endpoints share their p-bit
+            @param minPbit 1 to keep the p-bits set, which opaque blocks do so
+                alpha expands to 255 exactly
+        */
+        void encodeBC7Subset(const BlockPixels& pixels, uint32 bits, bool shared, uint32 minPbit,
+            uint32 indexBits, Image::CompressionQuality quality, BC7Subset& subset)
+        {
+            const size_t n = pixels.channels;
+            const uint8* weights = indexBits == 3 ? _blockWeights3 : _blockWeights4;
+            const size_t numIndices = size_t(1) << indexBits;
+
+            float e0[4], e1[4];
+            fitEndpoints(pixels, quality, e0, e1);
+            subset.error = std::numeric_limits<float>::max();
+            const int iterations = numIterations(quality);
+            for (int iteration = 0; iteration < iterations; ++iteration)
+            {
+                // the p-bits with the smallest error
+                uint8 quantised[2][4], expanded[2][4], best[2][4], bestExpanded[2][4];
+                uint8 pbits[2] = { 0, 0 };
+                if (shared)
+                {
+                    float bestError = std::numeric_limits<float>::max();
+                    for (uint32 p = minPbit; p < 2; ++p)
+                    {
+                        float error = quantiseEndpoint(e0, n, bits, p, quantised[0], expanded[0]) +
+                                      quantiseEndpoint(e1, n, bits, p, quantised[1], expanded[1]);
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            pbits[0] = pbits[1] = static_cast<uint8>(p);
+                            memcpy(best, quantised, sizeof(best));
+                            memcpy(bestExpanded, expanded, sizeof(bestExpanded));
+                        }
+                    }
+                }
+                else
+                {
+                    for (size_t k = 0; k < 2; ++k)
+                    {
+                        const float* e = k ? e1 : e0;
+                        float bestError = std::numeric_limits<float>::max();
+                        for (uint32 p = minPbit; p < 2; ++p)
+                        {
+                            float error = quantiseEndpoint(e, n, bits, p, quantised[k], expanded[k]);
+                            if (error < bestError)
+                            {
+                                bestError = error;
+                                pbits[k] = static_cast<uint8>(p);
+                                memcpy(best[k], quantised[k], sizeof(best[k]));
+                                memcpy(bestExpanded[k], expanded[k], sizeof(bestExpanded[k]));
+                            }
+                        }
+                    }
+                }
+
+                uint8 palette[16 * 4];
+                for (size_t i = 0; i < numIndices; ++i)
+                {
+                    for (size_t c = 0; c < n; ++c)
+                    {
+                        palette[i * 4 + c] = static_cast<uint8>(((64 - weights[i]) * bestExpanded[0][c] +
+                                                                 weights[i] * bestExpanded[1][c] + 32) >> 6);
+                    }
+                }
+
+                uint8 indices[16];
+                float positions[16], error = 0;
+                for (size_t i = 0; i < pixels.count; ++i)
+                {
+                    float d;
+                    uint8 index = nearest(pixels.values[i], palette, numIndices, n, d);
+                    indices[pixels.positions[i]] = index;
+                    positions[i] = weights[index] / 64.0f;
+                    error += d;
+                }
+                if (error < subset.error)
+                {
+                    subset.error = error;
+                    memcpy(subset.endpoints, best, sizeof(best));
+                    memcpy(subset.pbits, pbits, sizeof(pbits));
+                    memcpy(subset.indices, indices, sizeof(indices));
+                }
+                if (error == 0 || !refineEndpoints(pixels, positions, e0, e1))
+                    break;
+            }
+        }
+        //---------------------------------------------------------------------
+        /** Swaps the endpoints of a subset if the index of its anchor pixel
+            has the highest bit set, which is not stored.
+        */
+        void fixAnchor(BC7Subset& subset, const BlockPixels& pixels, size_t anchor, uint32 indexBits)
+        {
+            const uint8 maxIndex = static_cast<uint8>((1 << indexBits) - 1);
+            if (!(subset.indices[anchor] >> (indexBits - 1)))
+                return;
+            for (size_t c = 0; c < 4; ++c)
+                std::swap(subset.endpoints[0][c], subset.endpoints[1][c]);
+            std::swap(subset.pbits[0], subset.pbits[1]);
+            for (size_t i = 0; i < pixels.count; ++i)
+                subset.indices[pixels.positions[i]] = maxIndex - subset.indices[pixels.positions[i]];
+        }
+        //---------------------------------------------------------------------
+        /// Mode 6: one subset of RGBA 7.7.7.7 endpoints with a p-bit each and 4 bit indices
+        float encodeBC7Mode6(const uint8* pixels, Image::CompressionQuality quality, uint8* block)
+        {
+            BlockPixels all(4);
+            uint32 opaque = 1;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                all.add(pixels + i * 4, i);
+                opaque &= pixels[i * 4 + 3] == 255;
+            }
+            BC7Subset subset;
+            encodeBC7Subset(all, 7, false, opaque, 4, quality, subset);
+            fixAnchor(subset, all, 0, 4);
+
+            BlockBitWriter writer(block);
+            writer.write(1 << 6, 7);
+            for (size_t c = 0; c < 4; ++c)
+            {
+                writer.write(subset.endpoints[0][c], 7);
+                writer.write(subset.endpoints[1][c], 7);
+            }
+            writer.write(subset.pbits[0], 1);
+            writer.write(subset.pbits[1], 1);
+            for (size_t i = 0; i < 16; ++i)
+                writer.write(subset.indices[i], i == 0 ? 3 : 4);
+            return subset.error;
+        }
+        //---------------------------------------------------------------------
+        /// Mode 1: two subsets of RGB 6.6.6 endpoints with a shared p-bit each and 3 bit indices
+        float encodeBC7Mode1(const uint8* pixels, uint32 partition, Image::CompressionQuality quality, uint8* block)
+        {
+            BlockPixels subsetPixels[2] = { BlockPixels(3), BlockPixels(3) };
+            for (size_t i = 0; i < 16; ++i)
+                subsetPixels[(_blockPartitions2[partition] >> i) & 1].add(pixels + i * 4, i);
+
+            BC7Subset subsets[2];
+            const size_t anchors[2] = { 0, _blockAnchors2[partition] };
+            uint8 indices[16];
+            for (size_t s = 0; s < 2; ++s)
+            {
+                encodeBC7Subset(subsetPixels[s], 6, true, 0, 3, quality, subsets[s]);
+                fixAnchor(subsets[s], subsetPixels[s], anchors[s], 3);
+                for (size_t i = 0; i < subsetPixels[s].count; ++i)
+                    indices[subsetPixels[s].positions[i]] = subsets[s].indices[subsetPixels[s].positions[i]];
+            }
+
+            BlockBitWriter writer(block);
+            writer.write(1 << 1, 2);
+            writer.write(partition, 6);
+            for (size_t c = 0; c < 3; ++c)
+            {
+                for (size_t s = 0; s < 2; ++s)
+                {
+                    writer.write(subsets[s].endpoints[0][c], 6);
+                    writer.write(subsets[s].endpoints[1][c], 6);
+                }
+            }
+            writer.write(subsets[0].pbits[0], 1);
+            writer.write(subsets[1].pbits[0], 1);
+            for (size_t i = 0; i < 16; ++i)
+                writer.write(indices[i], i == anchors[0] || i == anchors[1] ? 2 : 3);
+            return subsets[0].error + subsets[1].error;
+        }
+        //---------------------------------------------------------------------
+        /// Squared distance of the pixels of each subset of a partition from their principal axis
+        float estimatePartitionError(const uint8* pixels, uint32 partition)
+        {
+            BlockPixels subsetPixels[2] = { BlockPixels(3), BlockPixels(3) };
+            for (size_t i = 0; i < 16; ++i)
+                subsetPixels[(_blockPartitions2[partition] >> i) & 1].add(pixels + i * 4, i);
+
+            float error = 0;
+            for (size_t s = 0; s < 2; ++s)
+            {
+                float mean[4], cov[4][4], axis[4];
+                covariance(subsetPixels[s], mean, cov);
+                error += cov[0][0] + cov[1][1] + cov[2][2] - principalAxis(cov, 3, axis);
+            }
+            return error;
+        }
+        //---------------------------------------------------------------------
+        void encodeBC7(const uint8* pixels, uint8* block, Image::CompressionQuality quality)
+        {
+            float error = encodeBC7Mode6(pixels, quality, block);
+            if (quality != Image::CQ_BEST || error == 0)
+                return;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                // mode 1 has no alpha
+                if (pixels[i * 4 + 3] != 255)
+                    return;
+            }
+
+            // the two partitions whose subsets are closest to lines
+            uint32 partitions[2] = { 0, 0 };
+            float estimates[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+            for (uint32 partition = 0; partition < 64; ++partition)
+            {
+                float estimate = estimatePartitionError(pixels, partition);
+                if (estimate < estimates[1])
+                {
+                    size_t slot = estimate < estimates[0] ? 0 : 1;
+                    if (slot == 0)
+                    {
+                        estimates[1] = estimates[0];
+                        partitions[1] = partitions[0];
+                    }
+                    estimates[slot] = estimate;
+                    partitions[slot] = partition;
+                }
+            }
+
+            for (size_t i = 0; i < 2; ++i)
+            {
+                uint8 candidate[16];
+                float candidateError = encodeBC7Mode1(pixels, partitions[i], quality, candidate);
+                if (candidateError < error)
+                {
+                    error = candidateError;
+                    memcpy(block, candidate, sizeof(candidate));
+                }
+            }
+        }
+
+        //---------------------------------------------------------------------
+        // Encoding of boxes
+        //---------------------------------------------------------------------
+        /// Encodes rows of blocks, numbered slice * blocks per column + block row
+        class BlockRowJob : public TaskScheduler::RangeJob
+        {
+            const PixelBlockCompression& mCompression;
+            const PixelBox& mSrc;
+            const PixelBox& mDst;
+            Image::CompressionQuality mQuality;
+            size_t mBlocksX, mBlocksY;
+        public:
+            BlockRowJob(const PixelBlockCompression& compression, const PixelBox& src, const PixelBox& dst,
+                        Image::CompressionQuality quality)
+                : mCompression(compression), mSrc(src), mDst(dst), mQuality(quality)
+                , mBlocksX((src.getWidth() + 3) / 4), mBlocksY((src.getHeight() + 3) / 4)
+            {
+            }
+
+            size_t getNumRows(void) const { return mBlocksY * mSrc.getDepth(); }
+            size_t getPixelsPerRow(void) const { return mBlocksX * 16; }
+
+            void execute(size_t begin, size_t end)
+            {
+                const uint32 width = mSrc.getWidth();
+                vector<uint8>::type rows(width * 4 * 4);
+                const size_t rowBytes = mBlocksX * mCompression.blockSize;
+                const size_t sliceBytes = rowBytes * mBlocksY;
+                uint8 pixels[16 * 4];
+
+                for (size_t row = begin; row < end; ++row)
+                {
+                    size_t z = row / mBlocksY, by = row % mBlocksY;
+                    uint32 top = static_cast<uint32>(by * 4);
+                    uint32 numRows = std::min<uint32>(4, mSrc.getHeight() - top);
+                    uint32 front = static_cast<uint32>(mSrc.front + z);
+                    PixelUtil::bulkPixelConversion(mSrc.getSubVolume(
+                        Box(mSrc.left, mSrc.top + top, front, mSrc.right, mSrc.top + top + numRows, front + 1), false),
+                        PixelBox(Box(0, 0, width, numRows), PF_BYTE_RGBA, &rows[0]));
+
+                    uint8* block = mDst.data + (mDst.front + z) * sliceBytes + by * rowBytes;
+                    for (size_t bx = 0; bx < mBlocksX; ++bx, block += mCompression.blockSize)
+                    {
+                        // the blocks may extend past the edges of the box
+                        for (size_t y = 0; y < 4; ++y)
+                        {
+                            const uint8* src = &rows[std::min<size_t>(y, numRows - 1) * width * 4];
+                            for (size_t x = 0; x < 4; ++x)
+                                memcpy(pixels + (y * 4 + x) * 4, src + std::min<size_t>(bx * 4 + x, width - 1) * 4, 4);
+                        }
+                        mCompression.encoder(pixels, block, mQuality);
+                    }
+                }
+            }
+        };
+    }
+
+    //-----------------------------------------------------------------------
+    const PixelBlockCompression* _findPixelBlockCompression(PixelFormat format)
+    {
+        static const PixelBlockCompression compressions[] = {
+            { PF_DXT1, 8, encodeBC1 },
+            { PF_DXT3, 16, encodeBC2 },
+            { PF_DXT5, 16, encodeBC3 },
+            { PF_BC4_UNORM, 8, encodeBC4 },
+            { PF_BC5_UNORM, 16, encodeBC5 },
+            { PF_BC7_UNORM, 16, encodeBC7 }
+        };
+        for (size_t i = 0; i < sizeof(compressions) / sizeof(compressions[0]); ++i)
+        {
+            if (compressions[i].format == format)
+                return &compressions[i];
+        }
+        return 0;
+    }
+    //-----------------------------------------------------------------------
+    void _compressPixelBlocks(const PixelBlockCompression& compression,
+        const PixelBox& src, const PixelBox& dst, Image::CompressionQuality quality)
+    {
+        assert(dst.format == compression.format && dst.left == 0 && dst.top == 0);
+        assert(src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight() &&
+               src.getDepth() == dst.getDepth());
+
+        BlockRowJob job(compression, src, dst, quality);
+        const size_t rows = job.getNumRows();
+        // a 128x128 image at least, encoded in rows of 4K pixels
+        const size_t minPixels = 128 * 128;
+        const size_t pixelsPerTask = 4 * 1024;
+
+#if OGRE_THREAD_SUPPORT
+        Root* root = Root::getSingletonPtr();
+        TaskScheduler* scheduler = root ? root->getTaskScheduler() : 0;
+        if (scheduler && scheduler->getThreadCount() > 1 && rows > 1 &&
+            rows * job.getPixelsPerRow() >= minPixels)
+        {
+            scheduler->parallelFor(0, rows, std::max<size_t>(pixelsPerTask / job.getPixelsPerRow(), 1), job);
+            return;
+        }
+#else
+        (void)minPixels;
+        (void)pixelsPerTask;
+#endif
+        job.execute(0, rows);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+/** Internal include file -- do not use externally */
+#ifndef __PixelBlockCompression_H__
+#define __PixelBlockCompression_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreImage.h"
+
+namespace Ogre {
+
+    /// Encodes 16 PF_BYTE_RGBA pixels, in 4 rows of 4, to one 4x4 block
+    typedef void (*PixelBlockEncoder)(const uint8* pixels, uint8* block, Image::CompressionQuality quality);
+
+    /// Encodes a block compressed format in software
+    struct PixelBlockCompression
+    {
+        /// The block compressed format
+        PixelFormat format;
+        /// Bytes per 4x4 block
+        size_t blockSize;
+        PixelBlockEncoder encoder;
+    };
+
+    /// The compression to a format, or NULL if it can not be encoded in software
+    const PixelBlockCompression* _findPixelBlockCompression(PixelFormat format);
+
+    /** Encodes src of any accessible format into the blocks of dst, which
+        must start at its first block and have the same size. Pixels past the
+        edges of src are replicated to fill the blocks. Large boxes are split
+        into rows of blocks encoded on the threads of the Root TaskScheduler.
+    */
+    void _compressPixelBlocks(const PixelBlockCompression& compression,
+        const PixelBox& src, const PixelBox& dst, Image::CompressionQuality quality);
+}
+
+#endif
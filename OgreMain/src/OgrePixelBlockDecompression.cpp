@@ -0,0 +1,803 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelBlockDecompression.h"
+#include "OgrePixelRowConversions.h"
+#include "OgreBitwise.h"
+#include "OgreRoot.h"
+#include "OgreTaskScheduler.h"
+
+namespace Ogre {
+
+#if __OGRE_HAVE_SSSE3_PIXEL_ROWS
+    extern PixelBlockDecoder _getPixelBlockDecoderSSSE3(PixelFormat format);
+#endif
+
+    //-----------------------------------------------------------------------
+    // Tables shared by BC6H, BC7 and the BC7 encoder
+    //-----------------------------------------------------------------------
+    /// Subset of each pixel of the 2 subset partitions, one bit per pixel
+    const uint16 _blockPartitions2[64] = {
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+        0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+        0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+        0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+        0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+        0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+        0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+        0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+    };
+    /// Anchor pixel of the second subset of the 2 subset partitions
+    const uint8 _blockAnchors2[64] = {
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+        15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+         6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+    };
+    /// BC7 and BC6H interpolation weights of 2, 3 and 4 bit indices, out of 64
+    const uint8 _blockWeights2[4] = { 0, 21, 43, 64 };
+    const uint8 _blockWeights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+    const uint8 _blockWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    namespace {
+        //---------------------------------------------------------------------
+        // BC1 - BC5, also known as DXT1 - DXT5, ATI1 and ATI2
+        //---------------------------------------------------------------------
+        /// Writes the colours of a DXT/BC1-3 colour block
+        void decodeColourBlock(const uint8* block, bool opaque, uint8* dst, size_t dstPitch)
+        {
+            uint8 palette[16];
+            _decodeBlockColourPalette(block, opaque, palette);
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                uint8 indices = block[4 + y];
+                for (size_t x = 0; x < 4; ++x, indices >>= 2)
+                    memcpy(dst + x * 4, palette + (indices & 0x3) * 4, 4);
+            }
+        }
+        //---------------------------------------------------------------------
+        /// Overwrites one channel of 4x4 RGBA pixels with the values of a BC3 alpha or BC4 block
+        void decodeAlphaBlock(const uint8* block, uint8* dst, size_t dstPitch, size_t channel)
+        {
+            uint8 palette[8], indices[16];
+            _decodeBlockAlphaPalette(block, palette);
+            _decodeBlockAlphaIndices(block, indices);
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                for (size_t x = 0; x < 4; ++x)
+                    dst[x * 4 + channel] = palette[indices[y * 4 + x]];
+            }
+        }
+        //---------------------------------------------------------------------
+        void decodeBC1(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeColourBlock(block, false, dst, dstPitch);
+        }
+        //---------------------------------------------------------------------
+        void decodeBC2(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeColourBlock(block + 8, true, dst, dstPitch);
+            // explicit 4 bit alpha
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                uint16 row = _readBlockUint16(block + y * 2);
+                for (size_t x = 0; x < 4; ++x, row >>= 4)
+                    dst[x * 4 + 3] = static_cast<uint8>((row & 0xF) * 0x11);
+            }
+        }
+        //---------------------------------------------------------------------
+        void decodeBC3(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeColourBlock(block + 8, true, dst, dstPitch);
+            decodeAlphaBlock(block, dst, dstPitch, 3);
+        }
+        //---------------------------------------------------------------------
+        /// Sets 4x4 RGBA pixels to black
+        void clearBlock(uint8* dst, size_t dstPitch)
+        {
+            static const uint8 black[16] = { 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF };
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+                memcpy(dst, black, sizeof(black));
+        }
+        //---------------------------------------------------------------------
+        void decodeBC4(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            clearBlock(dst, dstPitch);
+            decodeAlphaBlock(block, dst, dstPitch, 0);
+        }
+        //---------------------------------------------------------------------
+        void decodeBC5(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            clearBlock(dst, dstPitch);
+            decodeAlphaBlock(block, dst, dstPitch, 0);
+            decodeAlphaBlock(block + 8, dst, dstPitch, 1);
+        }
+        //---------------------------------------------------------------------
+        /// Writes one channel of 4x4 float RGBA pixels from a signed BC4 block
+        void decodeSignedBlock(const uint8* block, uint8* dst, size_t dstPitch, size_t channel)
+        {
+            // -128 is treated as -127
+            float a0 = std::max<int>(static_cast<int8>(block[0]), -127) / 127.0f;
+            float a1 = std::max<int>(static_cast<int8>(block[1]), -127) / 127.0f;
+            float palette[8] = { a0, a1 };
+            if (static_cast<int8>(block[0]) > static_cast<int8>(block[1]))
+            {
+                for (int i = 1; i < 7; ++i)
+                    palette[i + 1] = ((7 - i) * a0 + i * a1) / 7.0f;
+            }
+            else
+            {
+                for (int i = 1; i < 5; ++i)
+                    palette[i + 1] = ((5 - i) * a0 + i * a1) / 5.0f;
+                palette[6] = -1.0f;
+                palette[7] = 1.0f;
+            }
+
+            uint8 indices[16];
+            _decodeBlockAlphaIndices(block, indices);
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                float* row = reinterpret_cast<float*>(dst);
+                for (size_t x = 0; x < 4; ++x)
+                    row[x * 4 + channel] = palette[indices[y * 4 + x]];
+            }
+        }
+        //---------------------------------------------------------------------
+        /// Sets 4x4 float RGBA pixels to black
+        void clearFloatBlock(uint8* dst, size_t dstPitch)
+        {
+            static const float black[16] = { 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+                memcpy(dst, black, sizeof(black));
+        }
+        //---------------------------------------------------------------------
+        void decodeBC4Signed(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            clearFloatBlock(dst, dstPitch);
+            decodeSignedBlock(block, dst, dstPitch, 0);
+        }
+        //---------------------------------------------------------------------
+        void decodeBC5Signed(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            clearFloatBlock(dst, dstPitch);
+            decodeSignedBlock(block, dst, dstPitch, 0);
+            decodeSignedBlock(block + 8, dst, dstPitch, 1);
+        }
+
+        //---------------------------------------------------------------------
+        // Tables of BC6H and BC7
+        //---------------------------------------------------------------------
+        /// Subset of each pixel of the 3 subset partitions, two bits per pixel
+        const uint32 PARTITIONS3[64] = {
+            0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+            0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+            0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+            0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+            0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+            0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+            0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+            0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254
+        };
+        /// Anchor pixels of the second and third subsets of the 3 subset partitions
+        const uint8 ANCHORS3[2][64] = {
+            {  3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+               3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+               8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+               3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3 },
+            { 15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+              15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+              15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+              15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8 }
+        };
+
+        const uint8* weightsFor(uint32 indexBits)
+        {
+            return indexBits == 2 ? _blockWeights2 : indexBits == 3 ? _blockWeights3 : _blockWeights4;
+        }
+        //---------------------------------------------------------------------
+        /// Subset of a pixel
+        inline uint32 subsetOf(uint32 subsets, uint32 partition, uint32 pixel)
+        {
+            if (subsets == 2)
+                return (_blockPartitions2[partition] >> pixel) & 1;
+            if (subsets == 3)
+                return (PARTITIONS3[partition] >> (pixel * 2)) & 3;
+            return 0;
+        }
+        //---------------------------------------------------------------------
+        /// Whether a pixel is the anchor of its subset, whose index has one bit less
+        inline bool isAnchor(uint32 subsets, uint32 partition, uint32 pixel)
+        {
+            if (pixel == 0)
+                return true;
+            if (subsets == 2)
+                return pixel == _blockAnchors2[partition];
+            if (subsets == 3)
+                return pixel == ANCHORS3[0][partition] || pixel == ANCHORS3[1][partition];
+            return false;
+        }
+        //---------------------------------------------------------------------
+        /// Reads the 128 bits of a BC6H or BC7 block, least significant bits first
+        class BlockBits
+        {
+            uint64 mLow, mHigh;
+            uint32 mPos;
+        public:
+            explicit BlockBits(const uint8* block) : mPos(0)
+            {
+                mLow = _readBlockUint32(block) | (static_cast<uint64>(_readBlockUint32(block + 4)) << 32);
+                mHigh = _readBlockUint32(block + 8) | (static_cast<uint64>(_readBlockUint32(block + 12)) << 32);
+            }
+
+            /// Reads up to 16 bits
+            uint32 read(uint32 count)
+            {
+                uint64 bits;
+                if (mPos >= 64)
+                    bits = mHigh >> (mPos - 64);
+                else if (mPos + count <= 64)
+                    bits = mLow >> mPos;
+                else
+                    bits = (mLow >> mPos) | (mHigh << (64 - mPos));
+                mPos += count;
+                return static_cast<uint32>(bits) & ((1u << count) - 1);
+            }
+        };
+
+        //---------------------------------------------------------------------
+        // BC7
+        //---------------------------------------------------------------------
+        struct BC7Mode
+        {
+            uint8 subsets;
+            uint8 partitionBits;
+            uint8 rotationBits;
+            uint8 indexSelectionBits;
+            uint8 colourBits;
+            uint8 alphaBits;
+            /// Per endpoint p-bit
+            uint8 endpointPBits;
+            /// P-bit shared by the endpoints of a subset
+            uint8 sharedPBits;
+            uint8 indexBits;
+            uint8 secondaryIndexBits;
+        };
+
+        const BC7Mode BC7_MODES[8] = {
+            { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+            { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+            { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+            { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+            { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+            { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+            { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+            { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 }
+        };
+
+        void decodeBC7(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            BlockBits bits(block);
+            uint32 mode = 0;
+            while (mode < 8 && !bits.read(1))
+                ++mode;
+            if (mode == 8)
+            {
+                // reserved, transparent black
+                for (size_t y = 0; y < 4; ++y)
+                    memset(dst + y * dstPitch, 0, 16);
+                return;
+            }
+
+            const BC7Mode& m = BC7_MODES[mode];
+            uint32 partition = bits.read(m.partitionBits);
+            uint32 rotation = bits.read(m.rotationBits);
+            uint32 indexSelection = bits.read(m.indexSelectionBits);
+
+            // endpoints, each channel of all of them in turn
+            const uint32 numEndpoints = m.subsets * 2u;
+            uint32 endpoints[6][4];
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                uint32 channelBits = c < 3 ? m.colourBits : m.alphaBits;
+                for (uint32 e = 0; e < numEndpoints; ++e)
+                    endpoints[e][c] = bits.read(channelBits);
+            }
+
+            // p-bits are the lowest bit of every channel
+            uint32 extraBits = 0;
+            if (m.endpointPBits || m.sharedPBits)
+            {
+                extraBits = 1;
+                uint32 pbits[6];
+                for (uint32 e = 0; e < numEndpoints; ++e)
+                    pbits[e] = m.endpointPBits || e % 2 == 0 ? bits.read(1) : pbits[e - 1];
+                for (uint32 e = 0; e < numEndpoints; ++e)
+                    for (uint32 c = 0; c < 4; ++c)
+                        endpoints[e][c] = (endpoints[e][c] << 1) | pbits[e];
+            }
+
+            // expand to 8 bits by replicating the highest bits
+            for (uint32 e = 0; e < numEndpoints; ++e)
+            {
+                for (uint32 c = 0; c < 4; ++c)
+                {
+                    uint32 channelBits = (c < 3 ? m.colourBits : m.alphaBits) + extraBits;
+                    if (c == 3 && m.alphaBits == 0)
+                    {
+                        endpoints[e][c] = 0xFF;
+                        continue;
+                    }
+                    uint32 v = endpoints[e][c] << (8 - channelBits);
+                    endpoints[e][c] = v | (v >> channelBits);
+                }
+            }
+
+            uint8 indices[16], secondaryIndices[16];
+            for (uint32 i = 0; i < 16; ++i)
+                indices[i] = static_cast<uint8>(bits.read(m.indexBits - isAnchor(m.subsets, partition, i)));
+            if (m.secondaryIndexBits)
+            {
+                for (uint32 i = 0; i < 16; ++i)
+                    secondaryIndices[i] = static_cast<uint8>(bits.read(m.secondaryIndexBits - (i == 0)));
+            }
+
+            // which index set the colour and the alpha use
+            const uint8* colourIndices = indices;
+            const uint8* alphaIndices = indices;
+            const uint8* colourWeights = weightsFor(m.indexBits);
+            const uint8* alphaWeights = colourWeights;
+            if (m.secondaryIndexBits)
+            {
+                alphaIndices = secondaryIndices;
+                alphaWeights = weightsFor(m.secondaryIndexBits);
+                if (indexSelection)
+                {
+                    std::swap(colourIndices, alphaIndices);
+                    std::swap(colourWeights, alphaWeights);
+                }
+            }
+
+            for (uint32 i = 0; i < 16; ++i)
+            {
+                const uint32* e0 = endpoints[subsetOf(m.subsets, partition, i) * 2];
+                const uint32* e1 = e0 + 4;
+                uint32 cw = colourWeights[colourIndices[i]], aw = alphaWeights[alphaIndices[i]];
+                uint8* pixel = dst + (i / 4) * dstPitch + (i % 4) * 4;
+                for (uint32 c = 0; c < 3; ++c)
+                    pixel[c] = static_cast<uint8>(((64 - cw) * e0[c] + cw * e1[c] + 32) >> 6);
+                pixel[3] = static_cast<uint8>(((64 - aw) * e0[3] + aw * e1[3] + 32) >> 6);
+                if (rotation)
+                    std::swap(pixel[3], pixel[rotation - 1]);
+            }
+        }
+
+        //---------------------------------------------------------------------
+        // BC6H
+        //---------------------------------------------------------------------
+        /** Bits of an endpoint channel stored in a BC6H header. Fields are
+            channel + 3 * endpoint, the endpoints being w, x, y and z.
+        */
+        struct BC6HBits
+        {
+            uint8 field;
+            uint8 shift;
+            uint8 count;
+        };
+
+        enum
+        {
+            RW = 0, GW, BW, RX, GX, BX, RY, GY, BY, RZ, GZ, BZ
+        };
+
+        struct BC6HMode
+        {
+            uint8 regions;
+            bool transformed;
+            uint8 endpointBits;
+            uint8 deltaBits[3];
+            const BC6HBits* bits;
+            size_t numBits;
+        };
+
+        // the header bits following the mode, in order, see the BC6H format
+        // description of the D3D11 functional specification
+        const BC6HBits BC6H_MODE1[] = {
+            { GY, 4, 1 }, { BY, 4, 1 }, { BZ, 4, 1 }, { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 },
+            { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 },
+            { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 },
+            { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE2[] = {
+            { GY, 5, 1 }, { GZ, 4, 1 }, { GZ, 5, 1 }, { RW, 0, 7 }, { BZ, 0, 1 }, { BZ, 1, 1 },
+            { BY, 4, 1 }, { GW, 0, 7 }, { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 7 },
+            { BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 6 },
+            { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }
+        };
+        const BC6HBits BC6H_MODE3[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 5 }, { RW, 10, 1 }, { GY, 0, 4 },
+            { GX, 0, 4 }, { GW, 10, 1 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 4 }, { BW, 10, 1 },
+            { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE4[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { GZ, 4, 1 },
+            { GY, 0, 4 }, { GX, 0, 5 }, { GW, 10, 1 }, { GZ, 0, 4 }, { BX, 0, 4 }, { BW, 10, 1 },
+            { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 0, 1 }, { BZ, 2, 1 }, { RZ, 0, 4 },
+            { GY, 4, 1 }, { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE5[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { BY, 4, 1 },
+            { GY, 0, 4 }, { GX, 0, 4 }, { GW, 10, 1 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 },
+            { BW, 10, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 1, 1 }, { BZ, 2, 1 }, { RZ, 0, 4 },
+            { BZ, 4, 1 }, { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE6[] = {
+            { RW, 0, 9 }, { BY, 4, 1 }, { GW, 0, 9 }, { GY, 4, 1 }, { BW, 0, 9 }, { BZ, 4, 1 },
+            { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 },
+            { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 },
+            { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE7[] = {
+            { RW, 0, 8 }, { GZ, 4, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BZ, 2, 1 }, { GY, 4, 1 },
+            { BW, 0, 8 }, { BZ, 3, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 5 },
+            { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 6 },
+            { RZ, 0, 6 }
+        };
+        const BC6HBits BC6H_MODE8[] = {
+            { RW, 0, 8 }, { BZ, 0, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { GY, 5, 1 }, { GY, 4, 1 },
+            { BW, 0, 8 }, { GZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 },
+            { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 },
+            { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE9[] = {
+            { RW, 0, 8 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BY, 5, 1 }, { GY, 4, 1 },
+            { BW, 0, 8 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 },
+            { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 5 },
+            { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }
+        };
+        const BC6HBits BC6H_MODE10[] = {
+            { RW, 0, 6 }, { GZ, 4, 1 }, { BZ, 0, 1 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 6 },
+            { GY, 5, 1 }, { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 6 }, { GZ, 5, 1 },
+            { BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 6 },
+            { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }
+        };
+        const BC6HBits BC6H_MODE11[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 10 }, { GX, 0, 10 }, { BX, 0, 10 }
+        };
+        const BC6HBits BC6H_MODE12[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 9 }, { RW, 10, 1 }, { GX, 0, 9 },
+            { GW, 10, 1 }, { BX, 0, 9 }, { BW, 10, 1 }
+        };
+        // the high bits of the base endpoint are stored reversed in modes 13 and 14
+        const BC6HBits BC6H_MODE13[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 8 }, { RW, 11, 1 }, { RW, 10, 1 },
+            { GX, 0, 8 }, { GW, 11, 1 }, { GW, 10, 1 }, { BX, 0, 8 }, { BW, 11, 1 }, { BW, 10, 1 }
+        };
+        const BC6HBits BC6H_MODE14[] = {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 },
+            { RW, 15, 1 }, { RW, 14, 1 }, { RW, 13, 1 }, { RW, 12, 1 }, { RW, 11, 1 }, { RW, 10, 1 },
+            { GX, 0, 4 },
+            { GW, 15, 1 }, { GW, 14, 1 }, { GW, 13, 1 }, { GW, 12, 1 }, { GW, 11, 1 }, { GW, 10, 1 },
+            { BX, 0, 4 },
+            { BW, 15, 1 }, { BW, 14, 1 }, { BW, 13, 1 }, { BW, 12, 1 }, { BW, 11, 1 }, { BW, 10, 1 }
+        };
+
+#define OGRE_BC6H_MODE(regions, transformed, endpointBits, dr, dg, db, bits) \
+        { regions, transformed, endpointBits, { dr, dg, db }, bits, sizeof(bits) / sizeof(bits[0]) }
+
+        /// The modes by the value of their 5 bit mode field, NULL for the reserved ones
+        const BC6HMode* findBC6HMode(uint32 field)
+        {
+            static const BC6HMode modes[14] = {
+                OGRE_BC6H_MODE(2, true, 10, 5, 5, 5, BC6H_MODE1),
+                OGRE_BC6H_MODE(2, true, 7, 6, 6, 6, BC6H_MODE2),
+                OGRE_BC6H_MODE(2, true, 11, 5, 4, 4, BC6H_MODE3),
+                OGRE_BC6H_MODE(2, true, 11, 4, 5, 4, BC6H_MODE4),
+                OGRE_BC6H_MODE(2, true, 11, 4, 4, 5, BC6H_MODE5),
+                OGRE_BC6H_MODE(2, true, 9, 5, 5, 5, BC6H_MODE6),
+                OGRE_BC6H_MODE(2, true, 8, 6, 5, 5, BC6H_MODE7),
+                OGRE_BC6H_MODE(2, true, 8, 5, 6, 5, BC6H_MODE8),
+                OGRE_BC6H_MODE(2, true, 8, 5, 5, 6, BC6H_MODE9),
+                OGRE_BC6H_MODE(2, false, 6, 6, 6, 6, BC6H_MODE10),
+                OGRE_BC6H_MODE(1, false, 10, 10, 10, 10, BC6H_MODE11),
+                OGRE_BC6H_MODE(1, true, 11, 9, 9, 9, BC6H_MODE12),
+                OGRE_BC6H_MODE(1, true, 12, 8, 8, 8, BC6H_MODE13),
+                OGRE_BC6H_MODE(1, true, 16, 4, 4, 4, BC6H_MODE14)
+            };
+            switch (field)
+            {
+            case 0x00: return &modes[0];
+            case 0x01: return &modes[1];
+            case 0x02: return &modes[2];
+            case 0x06: return &modes[3];
+            case 0x0A: return &modes[4];
+            case 0x0E: return &modes[5];
+            case 0x12: return &modes[6];
+            case 0x16: return &modes[7];
+            case 0x1A: return &modes[8];
+            case 0x1E: return &modes[9];
+            case 0x03: return &modes[10];
+            case 0x07: return &modes[11];
+            case 0x0B: return &modes[12];
+            case 0x0F: return &modes[13];
+            default: return 0;
+            }
+        }
+#undef OGRE_BC6H_MODE
+
+        inline int32 signExtend(int32 value, uint32 bits)
+        {
+            int32 sign = 1 << (bits - 1);
+            return ((value & ((1 << bits) - 1)) ^ sign) - sign;
+        }
+        //---------------------------------------------------------------------
+        /// Scales an endpoint channel to 16 bits, see the D3D11 specification
+        inline int32 unquantize(int32 value, uint32 bits, bool isSigned)
+        {
+            if (!isSigned)
+            {
+                if (bits >= 15 || value == 0)
+                    return value;
+                if (value == (1 << bits) - 1)
+                    return 0xFFFF;
+                return ((value << 16) + 0x8000) >> bits;
+            }
+
+            if (bits >= 16 || value == 0)
+                return value;
+            bool negative = value < 0;
+            if (negative)
+                value = -value;
+            int32 result = value >= (1 << (bits - 1)) - 1 ? 0x7FFF : ((value << 15) + 0x4000) >> (bits - 1);
+            return negative ? -result : result;
+        }
+        //---------------------------------------------------------------------
+        /// Scales an interpolated value to the bits of a half float
+        inline uint16 finishUnquantize(int32 value, bool isSigned)
+        {
+            if (!isSigned)
+                return static_cast<uint16>((value * 31) >> 6);
+            if (value < 0)
+                return static_cast<uint16>(0x8000 | (((-value) * 31) >> 5));
+            return static_cast<uint16>((value * 31) >> 5);
+        }
+        //---------------------------------------------------------------------
+        void decodeBC6H(const uint8* block, uint8* dst, size_t dstPitch, bool isSigned)
+        {
+            BlockBits bits(block);
+            uint32 field = bits.read(2);
+            if (field > 1)
+                field |= bits.read(3) << 2;
+            const BC6HMode* mode = findBC6HMode(field);
+            if (!mode)
+            {
+                // reserved
+                clearFloatBlock(dst, dstPitch);
+                return;
+            }
+
+            int32 endpoints[4][3] = { { 0 } };
+            for (size_t i = 0; i < mode->numBits; ++i)
+            {
+                const BC6HBits& b = mode->bits[i];
+                endpoints[b.field / 3][b.field % 3] |= static_cast<int32>(bits.read(b.count)) << b.shift;
+            }
+            uint32 partition = mode->regions == 2 ? bits.read(5) : 0;
+
+            const uint32 numEndpoints = mode->regions * 2u;
+            const uint32 epb = mode->endpointBits;
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                if (isSigned)
+                    endpoints[0][c] = signExtend(endpoints[0][c], epb);
+                for (uint32 e = 1; e < numEndpoints; ++e)
+                {
+                    int32& v = endpoints[e][c];
+                    if (mode->transformed)
+                    {
+                        // the other endpoints are deltas from the first
+                        v = (endpoints[0][c] + signExtend(v, mode->deltaBits[c])) & ((1 << epb) - 1);
+                        if (isSigned)
+                            v = signExtend(v, epb);
+                    }
+                    else if (isSigned)
+                    {
+                        v = signExtend(v, epb);
+                    }
+                }
+                for (uint32 e = 0; e < numEndpoints; ++e)
+                    endpoints[e][c] = unquantize(endpoints[e][c], epb, isSigned);
+            }
+
+            const uint32 indexBits = mode->regions == 2 ? 3 : 4;
+            const uint8* weights = weightsFor(indexBits);
+            for (uint32 i = 0; i < 16; ++i)
+            {
+                uint32 index = bits.read(indexBits - isAnchor(mode->regions, partition, i));
+                uint32 w = weights[index];
+                const int32* e0 = endpoints[subsetOf(mode->regions, partition, i) * 2];
+                const int32* e1 = e0 + 3;
+                float* pixel = reinterpret_cast<float*>(dst + (i / 4) * dstPitch) + (i % 4) * 4;
+                for (uint32 c = 0; c < 3; ++c)
+                {
+                    int32 v = (static_cast<int32>(64 - w) * e0[c] + static_cast<int32>(w) * e1[c] + 32) >> 6;
+                    pixel[c] = Bitwise::halfToFloat(finishUnquantize(v, isSigned));
+                }
+                pixel[3] = 1.0f;
+            }
+        }
+        //---------------------------------------------------------------------
+        void decodeBC6HUnsigned(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeBC6H(block, dst, dstPitch, false);
+        }
+        //---------------------------------------------------------------------
+        void decodeBC6HSigned(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeBC6H(block, dst, dstPitch, true);
+        }
+
+        //---------------------------------------------------------------------
+        // Selection
+        //---------------------------------------------------------------------
+        struct PixelBlockDecompressions
+        {
+            PixelBlockDecompression decompressions[12];
+
+            PixelBlockDecompressions(void)
+            {
+                const PixelBlockDecompression general[12] = {
+                    { PF_DXT1, PF_BYTE_RGBA, 8, decodeBC1, false },
+                    { PF_DXT2, PF_BYTE_RGBA, 16, decodeBC2, false },
+                    { PF_DXT3, PF_BYTE_RGBA, 16, decodeBC2, false },
+                    { PF_DXT4, PF_BYTE_RGBA, 16, decodeBC3, false },
+                    { PF_DXT5, PF_BYTE_RGBA, 16, decodeBC3, false },
+                    { PF_BC4_UNORM, PF_BYTE_RGBA, 8, decodeBC4, false },
+                    { PF_BC4_SNORM, PF_FLOAT32_RGBA, 8, decodeBC4Signed, false },
+                    { PF_BC5_UNORM, PF_BYTE_RGBA, 16, decodeBC5, false },
+                    { PF_BC5_SNORM, PF_FLOAT32_RGBA, 16, decodeBC5Signed, false },
+                    { PF_BC6H_UF16, PF_FLOAT32_RGBA, 16, decodeBC6HUnsigned, false },
+                    { PF_BC6H_SF16, PF_FLOAT32_RGBA, 16, decodeBC6HSigned, false },
+                    { PF_BC7_UNORM, PF_BYTE_RGBA, 16, decodeBC7, false }
+                };
+
+                uint features = PlatformInformation::getCpuFeatures();
+                (void)features;
+                for (size_t i = 0; i < 12; ++i)
+                {
+                    decompressions[i] = general[i];
+#if __OGRE_HAVE_SSSE3_PIXEL_ROWS
+                    if (features & PlatformInformation::CPU_FEATURE_SSSE3)
+                    {
+                        if (PixelBlockDecoder decoder = _getPixelBlockDecoderSSSE3(general[i].format))
+                        {
+                            decompressions[i].decoder = decoder;
+                            decompressions[i].vectorised = true;
+                        }
+                    }
+#endif
+                }
+            }
+
+            static const PixelBlockDecompressions& get(void)
+            {
+                static PixelBlockDecompressions decompressions;
+                return decompressions;
+            }
+        };
+
+        //---------------------------------------------------------------------
+        // Decoding of boxes
+        //---------------------------------------------------------------------
+        /// Decodes rows of blocks, numbered slice * blocks per column + block row
+        class BlockRowJob : public TaskScheduler::RangeJob
+        {
+            const PixelBlockDecompression& mDecompression;
+            const PixelBox& mSrc;
+            const PixelBox& mDst;
+            size_t mBlocksX, mBlocksY;
+        public:
+            BlockRowJob(const PixelBlockDecompression& decompression, const PixelBox& src, const PixelBox& dst)
+                : mDecompression(decompression), mSrc(src), mDst(dst)
+                , mBlocksX((src.getWidth() + 3) / 4), mBlocksY((src.getHeight() + 3) / 4)
+            {
+            }
+
+            size_t getNumRows(void) const { return mBlocksY * mSrc.getDepth(); }
+            size_t getPixelsPerRow(void) const { return mBlocksX * 16; }
+
+            void execute(size_t begin, size_t end)
+            {
+                const size_t pixelBytes = PixelUtil::getNumElemBytes(mDecompression.decodedFormat);
+                const size_t pitch = mBlocksX * 4 * pixelBytes;
+                vector<uint8>::type decoded(pitch * 4);
+                const size_t rowBytes = mBlocksX * mDecompression.blockSize;
+                const size_t sliceBytes = rowBytes * mBlocksY;
+                const uint8* blocks = mSrc.data + mSrc.front * sliceBytes;
+
+                for (size_t row = begin; row < end; ++row)
+                {
+                    size_t z = row / mBlocksY, by = row % mBlocksY;
+                    const uint8* block = blocks + z * sliceBytes + by * rowBytes;
+                    for (size_t bx = 0; bx < mBlocksX; ++bx, block += mDecompression.blockSize)
+                        mDecompression.decoder(block, &decoded[bx * 4 * pixelBytes], pitch);
+
+                    // the blocks may extend past the edges of the box
+                    uint32 top = static_cast<uint32>(by * 4);
+                    uint32 rows = std::min<uint32>(4, mSrc.getHeight() - top);
+                    PixelBox decodedRows(Box(0, 0, mSrc.getWidth(), rows), mDecompression.decodedFormat, &decoded[0]);
+                    decodedRows.rowPitch = mBlocksX * 4;
+                    decodedRows.slicePitch = decodedRows.rowPitch * rows;
+                    uint32 front = static_cast<uint32>(mDst.front + z);
+                    PixelUtil::bulkPixelConversion(decodedRows, mDst.getSubVolume(
+                        Box(mDst.left, mDst.top + top, front, mDst.right, mDst.top + top + rows, front + 1), false));
+                }
+            }
+        };
+    }
+
+    //-----------------------------------------------------------------------
+    const PixelBlockDecompression* _findPixelBlockDecompression(PixelFormat format)
+    {
+        const PixelBlockDecompressions& all = PixelBlockDecompressions::get();
+        for (size_t i = 0; i < sizeof(all.decompressions) / sizeof(all.decompressions[0]); ++i)
+        {
+            if (all.decompressions[i].format == format)
+                return &all.decompressions[i];
+        }
+        return 0;
+    }
+    //-----------------------------------------------------------------------
+    void _decompressPixelBlocks(const PixelBlockDecompression& decompression,
+        const PixelBox& src, const PixelBox& dst)
+    {
+        assert(src.format == decompression.format && src.left == 0 && src.top == 0);
+        assert(src.getWidth() == dst.getWidth() && src.getHeight() == dst.getHeight() &&
+               src.getDepth() == dst.getDepth());
+
+        BlockRowJob job(decompression, src, dst);
+        const size_t rows = job.getNumRows();
+        // a 256x256 image at least, decoded in rows of 16K pixels
+        const size_t minPixels = 256 * 256;
+        const size_t pixelsPerTask = 16 * 1024;
+
+#if OGRE_THREAD_SUPPORT
+        Root* root = Root::getSingletonPtr();
+        TaskScheduler* scheduler = root ? root->getTaskScheduler() : 0;
+        if (scheduler && scheduler->getThreadCount() > 1 && rows > 1 &&
+            rows * job.getPixelsPerRow() >= minPixels)
+        {
+            scheduler->parallelFor(0, rows, std::max<size_t>(pixelsPerTask / job.getPixelsPerRow(), 1), job);
+            return;
+        }
+#else
+        (void)minPixels;
+        (void)pixelsPerTask;
+#endif
+        job.execute(0, rows);
+    }
+}
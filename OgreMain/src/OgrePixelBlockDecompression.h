@@ -0,0 +1,165 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+/** Internal include file -- do not use externally */
+#ifndef __PixelBlockDecompression_H__
+#define __PixelBlockDecompression_H__
+
+#include "OgrePrerequisites.h"
+#include "OgrePixelFormat.h"
+
+namespace Ogre {
+
+    /// Decodes one 4x4 block to 16 pixels, the rows of which are dstPitch bytes apart
+    typedef void (*PixelBlockDecoder)(const uint8* block, uint8* dst, size_t dstPitch);
+
+    /** Decodes a block compressed format in software.
+    @remarks
+        The decoders are selected at run-time for the instruction sets the
+        CPU supports, see _findPixelBlockDecompression.
+    */
+    struct PixelBlockDecompression
+    {
+        /// The block compressed format
+        PixelFormat format;
+        /// What the decoder writes, PF_BYTE_RGBA or PF_FLOAT32_RGBA
+        PixelFormat decodedFormat;
+        /// Bytes per 4x4 block
+        size_t blockSize;
+        PixelBlockDecoder decoder;
+        /// Whether the decoder uses SIMD instructions
+        bool vectorised;
+    };
+
+    /// The decompression of a format, or NULL if it can not be decoded in software
+    const PixelBlockDecompression* _findPixelBlockDecompression(PixelFormat format);
+
+    /** Decodes the blocks of src, which must start at its first block, into
+        dst of the same size and any accessible format. Large boxes are split
+        into rows of blocks decoded on the threads of the Root TaskScheduler.
+    */
+    void _decompressPixelBlocks(const PixelBlockDecompression& decompression,
+        const PixelBox& src, const PixelBox& dst);
+
+    /// Subset of each pixel of the BC6H and BC7 2 subset partitions, one bit per pixel
+    extern const uint16 _blockPartitions2[64];
+    /// Anchor pixel of the second subset of the 2 subset partitions
+    extern const uint8 _blockAnchors2[64];
+    /// BC7 and BC6H interpolation weights of 2, 3 and 4 bit indices, out of 64
+    extern const uint8 _blockWeights2[4];
+    extern const uint8 _blockWeights3[8];
+    extern const uint8 _blockWeights4[16];
+
+    //-------------------------------------------------------------------------
+    // Shared by the scalar and the SIMD decoders, and the encoders
+    //-------------------------------------------------------------------------
+    /// Reads a little endian 16 bit value
+    inline uint16 _readBlockUint16(const uint8* src)
+    {
+        return static_cast<uint16>(src[0] | (src[1] << 8));
+    }
+    //-------------------------------------------------------------------------
+    /// Reads a little endian 32 bit value
+    inline uint32 _readBlockUint32(const uint8* src)
+    {
+        return static_cast<uint32>(src[0]) | (static_cast<uint32>(src[1]) << 8) |
+            (static_cast<uint32>(src[2]) << 16) | (static_cast<uint32>(src[3]) << 24);
+    }
+    //-------------------------------------------------------------------------
+    /** The 4 RGBA colours of a DXT/BC1-3 colour block.
+    @param opaque Whether the block always uses 4 colours, which BC2 and BC3 do
+    */
+    inline void _decodeBlockColourPalette(const uint8* block, bool opaque, uint8 palette[16])
+    {
+        uint16 c0 = _readBlockUint16(block), c1 = _readBlockUint16(block + 2);
+        for (int i = 0; i < 2; ++i)
+        {
+            uint16 c = i ? c1 : c0;
+            uint8 r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+            palette[i * 4 + 0] = static_cast<uint8>((r << 3) | (r >> 2));
+            palette[i * 4 + 1] = static_cast<uint8>((g << 2) | (g >> 4));
+            palette[i * 4 + 2] = static_cast<uint8>((b << 3) | (b >> 2));
+            palette[i * 4 + 3] = 0xFF;
+        }
+
+        if (opaque || c0 > c1)
+        {
+            // 1/3 and 2/3 of the way along
+            for (int k = 0; k < 3; ++k)
+            {
+                palette[8 + k] = static_cast<uint8>((2 * palette[k] + palette[4 + k] + 1) / 3);
+                palette[12 + k] = static_cast<uint8>((palette[k] + 2 * palette[4 + k] + 1) / 3);
+            }
+            palette[11] = palette[15] = 0xFF;
+        }
+        else
+        {
+            // half way between the two, and transparent black
+            for (int k = 0; k < 3; ++k)
+            {
+                palette[8 + k] = static_cast<uint8>((palette[k] + palette[4 + k] + 1) / 2);
+                palette[12 + k] = 0;
+            }
+            palette[11] = 0xFF;
+            palette[15] = 0;
+        }
+    }
+    //-------------------------------------------------------------------------
+    /// The 8 values of a BC3 alpha or BC4 unsigned block
+    inline void _decodeBlockAlphaPalette(const uint8* block, uint8 palette[8])
+    {
+        uint32 a0 = block[0], a1 = block[1];
+        palette[0] = static_cast<uint8>(a0);
+        palette[1] = static_cast<uint8>(a1);
+        if (a0 > a1)
+        {
+            for (uint32 i = 1; i < 7; ++i)
+                palette[i + 1] = static_cast<uint8>(((7 - i) * a0 + i * a1 + 3) / 7);
+        }
+        else
+        {
+            for (uint32 i = 1; i < 5; ++i)
+                palette[i + 1] = static_cast<uint8>(((5 - i) * a0 + i * a1 + 2) / 5);
+            palette[6] = 0;
+            palette[7] = 0xFF;
+        }
+    }
+    //-------------------------------------------------------------------------
+    /// The 16 3 bit indices of a BC3 alpha or BC4 block
+    inline void _decodeBlockAlphaIndices(const uint8* block, uint8 indices[16])
+    {
+        for (int half = 0; half < 2; ++half)
+        {
+            const uint8* src = block + 2 + half * 3;
+            uint32 bits = src[0] | (src[1] << 8) | (src[2] << 16);
+            for (int i = 0; i < 8; ++i, bits >>= 3)
+                indices[half * 8 + i] = static_cast<uint8>(bits & 0x7);
+        }
+    }
+}
+
+#endif
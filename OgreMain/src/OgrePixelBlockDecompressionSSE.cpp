@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelBlockDecompression.h"
+#include "OgrePixelRowConversions.h"
+
+#if __OGRE_HAVE_SSSE3_PIXEL_ROWS
+
+#include <tmmintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// SSSE3 block decoders. The palettes are built by the same code as the
+// scalar decoders, then every row of 4 pixels is a single pshufb of the
+// palette: by a mask looked up from the 4 colour indices of the row, or
+// by the 16 alpha indices of the block followed by a spread of the row's
+// 4 alpha values into their channel.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
+#   define __OGRE_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#   define __OGRE_SSSE3_TARGET
+#endif
+
+namespace Ogre {
+
+    namespace {
+        /// pshufb masks of the rows of a block
+        struct BlockRowMasks
+        {
+            /// Picks the palette colour of each of the 4 pixels of a row, by its index byte
+            OGRE_ALIGNED_DECL(uint8, colours[256][16], 16);
+            /// Moves the 4 values of a row of 16 to one channel of 4 pixels, by channel and row
+            OGRE_ALIGNED_DECL(uint8, spread[4][4][16], 16);
+
+            BlockRowMasks(void)
+            {
+                for (size_t b = 0; b < 256; ++b)
+                    for (size_t x = 0; x < 4; ++x)
+                        for (size_t k = 0; k < 4; ++k)
+                            colours[b][x * 4 + k] = static_cast<uint8>(((b >> (x * 2)) & 0x3) * 4 + k);
+
+                memset(spread, 0x80, sizeof(spread));
+                for (size_t c = 0; c < 4; ++c)
+                    for (size_t y = 0; y < 4; ++y)
+                        for (size_t x = 0; x < 4; ++x)
+                            spread[c][y][x * 4 + c] = static_cast<uint8>(y * 4 + x);
+            }
+
+            static const BlockRowMasks& get(void)
+            {
+                static BlockRowMasks masks;
+                return masks;
+            }
+        };
+        //---------------------------------------------------------------------
+        inline void __OGRE_SSSE3_TARGET decodeColourBlockSSSE3(const uint8* block, bool opaque,
+            uint8* dst, size_t dstPitch)
+        {
+            OGRE_ALIGNED_DECL(uint8, palette[16], 16);
+            _decodeBlockColourPalette(block, opaque, palette);
+            const __m128i colours = _mm_load_si128(reinterpret_cast<const __m128i*>(palette));
+            const BlockRowMasks& rowMasks = BlockRowMasks::get();
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(rowMasks.colours[block[4 + y]]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(colours, mask));
+            }
+        }
+        //---------------------------------------------------------------------
+        /// The 16 values of a BC3 alpha or BC4 block, in pixel order
+        inline __m128i __OGRE_SSSE3_TARGET decodeAlphaValuesSSSE3(const uint8* block)
+        {
+            uint8 palette[8];
+            OGRE_ALIGNED_DECL(uint8, indices[16], 16);
+            _decodeBlockAlphaPalette(block, palette);
+            _decodeBlockAlphaIndices(block, indices);
+            return _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(palette)),
+                                    _mm_load_si128(reinterpret_cast<const __m128i*>(indices)));
+        }
+        //---------------------------------------------------------------------
+        /// pshufb mask moving the 4 values of row y to one channel of 4 pixels
+        inline __m128i __OGRE_SSSE3_TARGET spreadMaskSSSE3(size_t y, size_t channel)
+        {
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(BlockRowMasks::get().spread[channel][y]));
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_SSSE3_TARGET decodeBC1SSSE3(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeColourBlockSSSE3(block, false, dst, dstPitch);
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_SSSE3_TARGET decodeBC2SSSE3(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeColourBlockSSSE3(block + 8, true, dst, dstPitch);
+
+            // the 4 bit values of the pixels in the high nibbles of 16 bytes
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block));
+            const __m128i nibbles = _mm_unpacklo_epi8(_mm_slli_epi16(packed, 4), packed);
+            __m128i alpha = _mm_and_si128(nibbles, _mm_set1_epi8(static_cast<char>(0xF0)));
+            alpha = _mm_or_si128(alpha, _mm_and_si128(_mm_srli_epi16(alpha, 4), _mm_set1_epi8(0x0F)));
+
+            const __m128i colourMask = _mm_set1_epi32(0x00FFFFFF);
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                __m128i* row = reinterpret_cast<__m128i*>(dst);
+                __m128i colour = _mm_and_si128(_mm_loadu_si128(row), colourMask);
+                _mm_storeu_si128(row, _mm_or_si128(colour, _mm_shuffle_epi8(alpha, spreadMaskSSSE3(y, 3))));
+            }
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_SSSE3_TARGET decodeBC3SSSE3(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            decodeColourBlockSSSE3(block + 8, true, dst, dstPitch);
+
+            const __m128i alpha = decodeAlphaValuesSSSE3(block);
+            const __m128i colourMask = _mm_set1_epi32(0x00FFFFFF);
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                __m128i* row = reinterpret_cast<__m128i*>(dst);
+                __m128i colour = _mm_and_si128(_mm_loadu_si128(row), colourMask);
+                _mm_storeu_si128(row, _mm_or_si128(colour, _mm_shuffle_epi8(alpha, spreadMaskSSSE3(y, 3))));
+            }
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_SSSE3_TARGET decodeBC4SSSE3(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            const __m128i red = decodeAlphaValuesSSSE3(block);
+            const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                                 _mm_or_si128(opaque, _mm_shuffle_epi8(red, spreadMaskSSSE3(y, 0))));
+            }
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_SSSE3_TARGET decodeBC5SSSE3(const uint8* block, uint8* dst, size_t dstPitch)
+        {
+            const __m128i red = decodeAlphaValuesSSSE3(block);
+            const __m128i green = decodeAlphaValuesSSSE3(block + 8);
+            const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+            for (size_t y = 0; y < 4; ++y, dst += dstPitch)
+            {
+                __m128i row = _mm_or_si128(_mm_shuffle_epi8(red, spreadMaskSSSE3(y, 0)),
+                                           _mm_shuffle_epi8(green, spreadMaskSSSE3(y, 1)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(opaque, row));
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    extern PixelBlockDecoder _getPixelBlockDecoderSSSE3(PixelFormat format);
+    extern PixelBlockDecoder _getPixelBlockDecoderSSSE3(PixelFormat format)
+    {
+        switch (format)
+        {
+        case PF_DXT1:
+            return decodeBC1SSSE3;
+        case PF_DXT2:
+        case PF_DXT3:
+            return decodeBC2SSSE3;
+        case PF_DXT4:
+        case PF_DXT5:
+            return decodeBC3SSSE3;
+        case PF_BC4_UNORM:
+            return decodeBC4SSSE3;
+        case PF_BC5_UNORM:
+            return decodeBC5SSSE3;
+        default:
+            return 0;
+        }
+    }
+}
+
+#endif // __OGRE_HAVE_SSSE3_PIXEL_ROWS
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
 #include "OgrePixelFormatDescriptions.h"
+#include "OgrePixelRowConversions.h"
+#include "OgrePixelBlockDecompression.h"
 
 namespace {
 #include "OgrePixelConversions.h"
@@ -707,9 +709,10 @@ namespace Ogre {
         assert(src.getWidth() == dst.getWidth() &&
                src.getHeight() == dst.getHeight());
 
-        // Check for compressed formats, we don't support decompression, compression or recoding
+        // Check for compressed formats, we only support decompression of whole blocks in software
         if(PixelUtil::isCompressed(src.format) || PixelUtil::isCompressed(dst.format))
         {
+            const PixelBlockDecompression* decompression = 0;
             if(src.format == dst.format && src.left == 0 && src.top == 0 && dst.left == 0 && dst.top == 0)
             {
                 // we can copy with slice granularity, useful for Tex2DArray handling
@@ -719,6 +722,12 @@ namespace Ogre {
                     bytesPerSlice * src.getDepth());
                 return;
             }
+            else if(!PixelUtil::isCompressed(dst.format) && src.left == 0 && src.top == 0 &&
+                    (decompression = _findPixelBlockDecompression(src.format)))
+            {
+                _decompressPixelBlocks(*decompression, src, dst);
+                return;
+            }
             else
             {
                 OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
@@ -790,6 +799,15 @@ namespace Ogre {
             return;
         }
 
+        // Is there a row conversion using SIMD instructions?
+        PixelRowConversion rowConversion;
+        const bool hasRowConversion = _findPixelRowConversion(src.format, dst.format, PRG_NONE, rowConversion);
+        if(hasRowConversion && rowConversion.vectorised)
+        {
+            _convertPixelRows(rowConversion, src, dst);
+            return;
+        }
+
 // NB VC6 can't handle the templates required for optimised conversion, tough
 #if OGRE_COMPILER != OGRE_COMPILER_MSVC || OGRE_COMP_VER >= 1300
         // Is there a specialized, inlined, conversion?
@@ -800,6 +818,13 @@ namespace Ogre {
         }
 #endif
 
+        // Still better than unpacking every pixel
+        if(hasRowConversion)
+        {
+            _convertPixelRows(rowConversion, src, dst);
+            return;
+        }
+
         const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
         const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
         uint8 *srcptr = src.data
@@ -837,6 +862,66 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    static void convertColourSpace(const PixelBox &src, const PixelBox &dst, PixelRowGamma gamma,
+                                   const char* source)
+    {
+        assert(src.getWidth() == dst.getWidth() &&
+               src.getHeight() == dst.getHeight() &&
+               src.getDepth() == dst.getDepth());
+
+        if(PixelUtil::isCompressed(src.format) || PixelUtil::isCompressed(dst.format))
+        {
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+                "This method can not be used for compressed formats", source);
+        }
+
+        PixelRowConversion rowConversion;
+        if(_findPixelRowConversion(src.format, dst.format, gamma, rowConversion))
+        {
+            _convertPixelRows(rowConversion, src, dst);
+            return;
+        }
+
+        const size_t srcPixelSize = PixelUtil::getNumElemBytes(src.format);
+        const size_t dstPixelSize = PixelUtil::getNumElemBytes(dst.format);
+        for(size_t z = 0; z < src.getDepth(); z++)
+        {
+            for(size_t y = 0; y < src.getHeight(); y++)
+            {
+                const uint8 *srcptr = src.data + ((src.front + z) * src.slicePitch +
+                    (src.top + y) * src.rowPitch + src.left) * srcPixelSize;
+                uint8 *dstptr = dst.data + ((dst.front + z) * dst.slicePitch +
+                    (dst.top + y) * dst.rowPitch + dst.left) * dstPixelSize;
+                for(size_t x = 0; x < src.getWidth(); x++)
+                {
+                    float rgba[4];
+                    PixelUtil::unpackColour(&rgba[0], &rgba[1], &rgba[2], &rgba[3], src.format, srcptr);
+                    for(int c = 0; c < 3; c++)
+                    {
+                        float v = rgba[c];
+                        if(gamma == PRG_SRGB_TO_LINEAR)
+                            rgba[c] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+                        else
+                            rgba[c] = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+                    }
+                    PixelUtil::packColour(rgba[0], rgba[1], rgba[2], rgba[3], dst.format, dstptr);
+                    srcptr += srcPixelSize;
+                    dstptr += dstPixelSize;
+                }
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PixelUtil::convertSRGBToLinear(const PixelBox &src, const PixelBox &dst)
+    {
+        convertColourSpace(src, dst, PRG_SRGB_TO_LINEAR, "PixelUtil::convertSRGBToLinear");
+    }
+    //-----------------------------------------------------------------------
+    void PixelUtil::convertLinearToSRGB(const PixelBox &src, const PixelBox &dst)
+    {
+        convertColourSpace(src, dst, PRG_LINEAR_TO_SRGB, "PixelUtil::convertLinearToSRGB");
+    }
+    //-----------------------------------------------------------------------
     void PixelUtil::bulkPixelVerticalFlip(const PixelBox &box)
     {
         // Check for compressed formats, we don't support decompression, compression or recoding
@@ -0,0 +1,521 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelRowConversions.h"
+#include "OgreBitwise.h"
+
+namespace Ogre {
+
+#if __OGRE_HAVE_SSSE3_PIXEL_ROWS
+    extern void _getPixelRowKernelsSSE2(PixelRowKernels& kernels);
+    extern void _getPixelRowKernelsSSSE3(PixelRowKernels& kernels);
+#endif
+#if __OGRE_HAVE_AVX2
+    extern void _getPixelRowKernelsAVX2(PixelRowKernels& kernels);
+#endif
+
+    namespace {
+        const uint8 PRM_ZERO = PixelRowConversion::PRM_ZERO;
+        const uint8 PRM_ONE = PixelRowConversion::PRM_ONE;
+
+        //---------------------------------------------------------------------
+        // General kernels, used where no SIMD kernel is available and for the
+        // tails of the SIMD ones.
+        //---------------------------------------------------------------------
+        void byteShuffleGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const size_t srcBytes = conv.srcBytes, dstBytes = conv.dstBytes;
+            // source bytes with a zero and a 0xFF byte appended, so the map can index them
+            uint8 pixel[PRM_ONE + 1];
+            pixel[PRM_ZERO] = 0;
+            pixel[PRM_ONE] = 0xFF;
+            for (size_t i = 0; i < count; ++i, src += srcBytes, dst += dstBytes)
+            {
+                for (size_t j = 0; j < srcBytes; ++j)
+                    pixel[j] = src[j];
+                for (size_t j = 0; j < dstBytes; ++j)
+                    dst[j] = pixel[conv.map[j]];
+            }
+        }
+        //---------------------------------------------------------------------
+        void byteToFloatGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const size_t srcBytes = conv.srcBytes, components = conv.dstBytes / sizeof(float);
+            float* out = reinterpret_cast<float*>(dst);
+            for (size_t i = 0; i < count; ++i, src += srcBytes)
+            {
+                for (size_t k = 0; k < components; ++k)
+                {
+                    // same as Bitwise::fixedToFloat
+                    uint8 index = conv.map[k];
+                    *out++ = index == PRM_ONE ? 1.0f : (float)src[index] / 255.0f;
+                }
+            }
+        }
+        //---------------------------------------------------------------------
+        /// Bitwise::floatToFixed for 8 bits, also giving 0 for NaN
+        inline uint8 floatToByte(float v)
+        {
+            if (!(v > 0.0f))
+                return 0;
+            if (v >= 1.0f)
+                return 255;
+            return static_cast<uint8>(v * 256.0f);
+        }
+        //---------------------------------------------------------------------
+        void floatToByteGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const size_t components = conv.srcBytes / sizeof(float), dstBytes = conv.dstBytes;
+            const float* in = reinterpret_cast<const float*>(src);
+            for (size_t i = 0; i < count; ++i, in += components, dst += dstBytes)
+            {
+                for (size_t j = 0; j < dstBytes; ++j)
+                {
+                    uint8 index = conv.map[j];
+                    dst[j] = index == PRM_ZERO ? 0 : index == PRM_ONE ? 255 : floatToByte(in[index]);
+                }
+            }
+        }
+        //---------------------------------------------------------------------
+        void halfToFloatGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const uint16* in = reinterpret_cast<const uint16*>(src);
+            uint32* out = reinterpret_cast<uint32*>(dst);
+            for (size_t i = 0, n = count * conv.srcBytes / sizeof(uint16); i < n; ++i)
+                out[i] = Bitwise::halfToFloatI(in[i]);
+        }
+        //---------------------------------------------------------------------
+        void floatToHalfGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const uint32* in = reinterpret_cast<const uint32*>(src);
+            uint16* out = reinterpret_cast<uint16*>(dst);
+            for (size_t i = 0, n = count * conv.dstBytes / sizeof(uint16); i < n; ++i)
+                out[i] = Bitwise::floatToHalfI(in[i]);
+        }
+        //---------------------------------------------------------------------
+        void sRGBToLinearGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const PixelSRGBTables& tables = PixelSRGBTables::get();
+            const size_t srcBytes = conv.srcBytes, components = conv.dstBytes / sizeof(float);
+            float* out = reinterpret_cast<float*>(dst);
+            for (size_t i = 0; i < count; ++i, src += srcBytes)
+            {
+                for (size_t k = 0; k < components; ++k)
+                {
+                    uint8 index = conv.map[k];
+                    if (index == PRM_ONE)
+                        *out++ = 1.0f;
+                    else if (k == 3)
+                        *out++ = (float)src[index] / 255.0f;
+                    else
+                        *out++ = tables.toLinear[src[index]];
+                }
+            }
+        }
+        //---------------------------------------------------------------------
+        void linearToSRGBGeneral(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const PixelSRGBTables& tables = PixelSRGBTables::get();
+            const size_t components = conv.srcBytes / sizeof(float), dstBytes = conv.dstBytes;
+            const float* in = reinterpret_cast<const float*>(src);
+            for (size_t i = 0; i < count; ++i, in += components, dst += dstBytes)
+            {
+                for (size_t j = 0; j < dstBytes; ++j)
+                {
+                    uint8 index = conv.map[j];
+                    if (index == PRM_ZERO)
+                        dst[j] = 0;
+                    else if (index == PRM_ONE)
+                        dst[j] = 255;
+                    else if (index == 3)
+                        dst[j] = floatToByte(in[index]);
+                    else
+                        dst[j] = tables.encode(in[index]);
+                }
+            }
+        }
+        //---------------------------------------------------------------------
+        struct PixelRowKernelSets
+        {
+            PixelRowKernels general;
+            PixelRowKernels selected;
+
+            PixelRowKernelSets(void)
+            {
+                general[PixelRowConversion::PRK_BYTE_SHUFFLE] = byteShuffleGeneral;
+                general[PixelRowConversion::PRK_BYTE_TO_FLOAT] = byteToFloatGeneral;
+                general[PixelRowConversion::PRK_FLOAT_TO_BYTE] = floatToByteGeneral;
+                general[PixelRowConversion::PRK_HALF_TO_FLOAT] = halfToFloatGeneral;
+                general[PixelRowConversion::PRK_FLOAT_TO_HALF] = floatToHalfGeneral;
+                general[PixelRowConversion::PRK_SRGB_TO_LINEAR] = sRGBToLinearGeneral;
+                general[PixelRowConversion::PRK_LINEAR_TO_SRGB] = linearToSRGBGeneral;
+
+                for (int i = 0; i < PixelRowConversion::PRK_COUNT; ++i)
+                    selected[i] = NULL;
+
+                // each instruction set overrides the kernels of the previous ones
+                uint features = PlatformInformation::getCpuFeatures();
+                (void)features;
+#if __OGRE_HAVE_SSSE3_PIXEL_ROWS
+                if (features & PlatformInformation::CPU_FEATURE_SSE2)
+                    _getPixelRowKernelsSSE2(selected);
+                if (features & PlatformInformation::CPU_FEATURE_SSSE3)
+                    _getPixelRowKernelsSSSE3(selected);
+#endif
+#if __OGRE_HAVE_AVX2
+                if (features & PlatformInformation::CPU_FEATURE_AVX2)
+                    _getPixelRowKernelsAVX2(selected);
+#endif
+            }
+
+            static const PixelRowKernelSets& get(void)
+            {
+                static PixelRowKernelSets sets;
+                return sets;
+            }
+        };
+
+        //---------------------------------------------------------------------
+        // Format layouts
+        //---------------------------------------------------------------------
+        /** Gets the byte of every channel of a native endian format with 8 bit
+            channels or PF_BYTE_LA, or PRM_ZERO for the missing ones. Returns
+            false for other formats.
+        */
+        bool getChannelBytes(PixelFormat format, uint8 bytes[4])
+        {
+            // byte addressed, so the same on every platform
+            if (format == PF_BYTE_LA)
+            {
+                bytes[0] = 0;
+                bytes[1] = bytes[2] = PRM_ZERO;
+                bytes[3] = 1;
+                return true;
+            }
+
+            if (!PixelUtil::isNativeEndian(format) || PixelUtil::isFloatingPoint(format) ||
+                PixelUtil::isCompressed(format) || PixelUtil::isDepth(format))
+                return false;
+
+            const size_t elemBytes = PixelUtil::getNumElemBytes(format);
+            if (elemBytes < 1 || elemBytes > 4)
+                return false;
+
+            int depths[4];
+            unsigned char shifts[4];
+            PixelUtil::getBitDepths(format, depths);
+            PixelUtil::getBitShifts(format, shifts);
+            for (int c = 0; c < 4; ++c)
+            {
+                if (depths[c] == 0)
+                {
+                    bytes[c] = PRM_ZERO;
+                    continue;
+                }
+                if (depths[c] != 8 || shifts[c] % 8 != 0)
+                    return false;
+#if OGRE_ENDIAN == OGRE_ENDIAN_BIG
+                bytes[c] = static_cast<uint8>(elemBytes - 1 - shifts[c] / 8);
+#else
+                bytes[c] = static_cast<uint8>(shifts[c] / 8);
+#endif
+            }
+            if (PixelUtil::isLuminance(format))
+                bytes[1] = bytes[2] = PRM_ZERO;
+            return true;
+        }
+        //---------------------------------------------------------------------
+        /** Gets the source byte of each channel as PixelUtil::unpackColour reads
+            it, or PRM_ONE for a missing alpha.
+        */
+        bool getSourceBytes(PixelFormat format, uint8 bytes[4])
+        {
+            if (!getChannelBytes(format, bytes))
+                return false;
+            if (PixelUtil::isLuminance(format))
+            {
+                if (bytes[0] == PRM_ZERO)
+                    return false;
+                bytes[1] = bytes[2] = bytes[0];
+            }
+            // formats missing colour channels unpack them as NaN
+            else if (bytes[0] == PRM_ZERO || bytes[1] == PRM_ZERO || bytes[2] == PRM_ZERO)
+                return false;
+
+            if (!PixelUtil::hasAlpha(format))
+                bytes[3] = PRM_ONE;
+            else if (bytes[3] == PRM_ZERO)
+                return false;
+            return true;
+        }
+        //---------------------------------------------------------------------
+        /** Gets the channel written to each byte of a pixel as
+            PixelUtil::packColour writes it, or PRM_ZERO for unused bytes.
+        */
+        bool getDestinationChannels(PixelFormat format, uint8 channels[4])
+        {
+            uint8 bytes[4];
+            if (!getChannelBytes(format, bytes))
+                return false;
+            channels[0] = channels[1] = channels[2] = channels[3] = PRM_ZERO;
+            for (uint8 c = 0; c < 4; ++c)
+            {
+                if (bytes[c] != PRM_ZERO)
+                    channels[bytes[c]] = c;
+            }
+            return true;
+        }
+        //---------------------------------------------------------------------
+        /// Number of components of the 32 bit float formats, else 0
+        size_t getFloatComponents(PixelFormat format)
+        {
+            switch (format)
+            {
+            case PF_FLOAT32_R:
+                return 1;
+            case PF_FLOAT32_GR:
+                return 2;
+            case PF_FLOAT32_RGB:
+                return 3;
+            case PF_FLOAT32_RGBA:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+        //---------------------------------------------------------------------
+        /// The 32 bit float format with the layout of a 16 bit float format
+        PixelFormat getFloat32Format(PixelFormat halfFormat)
+        {
+            switch (halfFormat)
+            {
+            case PF_FLOAT16_R:
+                return PF_FLOAT32_R;
+            case PF_FLOAT16_GR:
+                return PF_FLOAT32_GR;
+            case PF_FLOAT16_RGB:
+                return PF_FLOAT32_RGB;
+            case PF_FLOAT16_RGBA:
+                return PF_FLOAT32_RGBA;
+            default:
+                return PF_UNKNOWN;
+            }
+        }
+        //---------------------------------------------------------------------
+        /** Component of a 32 bit float format PixelUtil::unpackColour reads for
+            a channel, or PRM_ONE for a missing alpha.
+        */
+        uint8 getSourceComponent(PixelFormat format, uint8 channel)
+        {
+            switch (format)
+            {
+            case PF_FLOAT32_R:
+                return channel < 3 ? 0 : PRM_ONE;
+            case PF_FLOAT32_GR:
+                return channel == 1 ? 0 : channel < 3 ? 1 : PRM_ONE;
+            case PF_FLOAT32_RGB:
+                return channel < 3 ? channel : PRM_ONE;
+            default:
+                return channel;
+            }
+        }
+        //---------------------------------------------------------------------
+        /// Channel PixelUtil::packColour writes to a component of a 32 bit float format
+        uint8 getDestinationChannel(PixelFormat format, uint8 component)
+        {
+            if (format == PF_FLOAT32_GR)
+                return component == 0 ? 1 : 0;
+            return component;
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool _findPixelRowConversion(PixelFormat srcFormat, PixelFormat dstFormat,
+        PixelRowGamma gamma, PixelRowConversion& conv)
+    {
+        PixelRowConversion::Kind kind;
+        uint8 srcBytes[4], dstChannels[4];
+        const size_t srcFloats = getFloatComponents(srcFormat);
+        const size_t dstFloats = getFloatComponents(dstFormat);
+
+        conv.map[0] = conv.map[1] = conv.map[2] = conv.map[3] = PRM_ZERO;
+        if (gamma == PRG_NONE && dstFloats && getFloat32Format(srcFormat) == dstFormat)
+        {
+            kind = PixelRowConversion::PRK_HALF_TO_FLOAT;
+        }
+        else if (gamma == PRG_NONE && srcFloats && getFloat32Format(dstFormat) == srcFormat)
+        {
+            kind = PixelRowConversion::PRK_FLOAT_TO_HALF;
+        }
+        else if (gamma == PRG_NONE && getSourceBytes(srcFormat, srcBytes) &&
+                 getDestinationChannels(dstFormat, dstChannels))
+        {
+            kind = PixelRowConversion::PRK_BYTE_SHUFFLE;
+            for (size_t j = 0; j < PixelUtil::getNumElemBytes(dstFormat); ++j)
+            {
+                if (dstChannels[j] != PRM_ZERO)
+                    conv.map[j] = srcBytes[dstChannels[j]];
+            }
+        }
+        else if (gamma != PRG_LINEAR_TO_SRGB && dstFloats && getSourceBytes(srcFormat, srcBytes))
+        {
+            kind = gamma == PRG_NONE ? PixelRowConversion::PRK_BYTE_TO_FLOAT
+                                     : PixelRowConversion::PRK_SRGB_TO_LINEAR;
+            for (uint8 k = 0; k < dstFloats; ++k)
+                conv.map[k] = srcBytes[getDestinationChannel(dstFormat, k)];
+        }
+        else if (gamma != PRG_SRGB_TO_LINEAR && srcFloats && getDestinationChannels(dstFormat, dstChannels))
+        {
+            kind = gamma == PRG_NONE ? PixelRowConversion::PRK_FLOAT_TO_BYTE
+                                     : PixelRowConversion::PRK_LINEAR_TO_SRGB;
+            for (size_t j = 0; j < PixelUtil::getNumElemBytes(dstFormat); ++j)
+            {
+                if (dstChannels[j] != PRM_ZERO)
+                    conv.map[j] = getSourceComponent(srcFormat, dstChannels[j]);
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        const PixelRowKernelSets& kernels = PixelRowKernelSets::get();
+        conv.kind = kind;
+        conv.vectorised = kernels.selected[kind] != NULL;
+        conv.kernel = conv.vectorised ? kernels.selected[kind] : kernels.general[kind];
+        conv.srcBytes = static_cast<uint8>(PixelUtil::getNumElemBytes(srcFormat));
+        conv.dstBytes = static_cast<uint8>(PixelUtil::getNumElemBytes(dstFormat));
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    const PixelRowKernels& _getPixelRowKernelsGeneral(void)
+    {
+        return PixelRowKernelSets::get().general;
+    }
+    //-----------------------------------------------------------------------
+    void _convertPixelRows(const PixelRowConversion& conv, const PixelBox& src, const PixelBox& dst)
+    {
+        const size_t srcPixelSize = conv.srcBytes;
+        const size_t dstPixelSize = conv.dstBytes;
+        const uint8* srcptr = src.data
+            + (src.left + src.top * src.rowPitch + src.front * src.slicePitch) * srcPixelSize;
+        uint8* dstptr = dst.data
+            + (dst.left + dst.top * dst.rowPitch + dst.front * dst.slicePitch) * dstPixelSize;
+
+        if (src.isConsecutive() && dst.isConsecutive())
+        {
+            conv.kernel(conv, srcptr, dstptr, src.getWidth() * src.getHeight() * src.getDepth());
+            return;
+        }
+
+        const size_t width = src.getWidth();
+        const size_t srcRowPitchBytes = src.rowPitch * srcPixelSize;
+        const size_t srcSlicePitchBytes = src.slicePitch * srcPixelSize;
+        const size_t dstRowPitchBytes = dst.rowPitch * dstPixelSize;
+        const size_t dstSlicePitchBytes = dst.slicePitch * dstPixelSize;
+        for (size_t z = 0; z < src.getDepth(); ++z)
+        {
+            const uint8* srcRow = srcptr + z * srcSlicePitchBytes;
+            uint8* dstRow = dstptr + z * dstSlicePitchBytes;
+            for (size_t y = 0; y < src.getHeight(); ++y)
+            {
+                conv.kernel(conv, srcRow, dstRow, width);
+                srcRow += srcRowPitchBytes;
+                dstRow += dstRowPitchBytes;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    namespace {
+        /// Exactly rounded 8 bit sRGB encoding of a linear value in [0, 1]
+        int encodeSRGB(double v)
+        {
+            double s = v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+            return static_cast<int>(std::floor(s * 255.0 + 0.5));
+        }
+
+        uint32 floatBits(float v)
+        {
+            uint32 i;
+            memcpy(&i, &v, sizeof(i));
+            return i;
+        }
+
+        float bitsFloat(uint32 i)
+        {
+            float v;
+            memcpy(&v, &i, sizeof(v));
+            return v;
+        }
+    }
+    //-----------------------------------------------------------------------
+    const PixelSRGBTables& PixelSRGBTables::get(void)
+    {
+        struct Tables : PixelSRGBTables
+        {
+            Tables(void)
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    double c = i / 255.0;
+                    toLinear[i] = static_cast<float>(
+                        c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+                }
+
+                // less than one sRGB step per bucket, so there is at most one
+                // threshold in each, found by bisecting the float values
+                for (uint32 b = 0; b < 4096; ++b)
+                {
+                    float start = b / 4096.0f;
+                    float end = (b + 1) / 4096.0f;
+                    int code = encodeSRGB(start);
+                    toSRGB[b] = static_cast<uint8>(code);
+
+                    uint32 lo = floatBits(start), hi = floatBits(end);
+                    if (encodeSRGB(bitsFloat(hi - 1)) == code)
+                    {
+                        threshold[b] = 2.0f;
+                        continue;
+                    }
+                    // encodeSRGB(lo) == code, encodeSRGB(hi - 1) == code + 1
+                    --hi;
+                    while (hi - lo > 1)
+                    {
+                        uint32 mid = lo + (hi - lo) / 2;
+                        if (encodeSRGB(bitsFloat(mid)) == code)
+                            lo = mid;
+                        else
+                            hi = mid;
+                    }
+                    threshold[b] = bitsFloat(hi);
+                }
+            }
+        };
+        static Tables tables;
+        return tables;
+    }
+}
@@ -0,0 +1,158 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+/** Internal include file -- do not use externally */
+#ifndef __PixelRowConversions_H__
+#define __PixelRowConversions_H__
+
+#include "OgrePrerequisites.h"
+#include "OgrePixelFormat.h"
+#include "OgrePlatformInformation.h"
+
+/* The SSE2 and SSSE3 kernels are compiled per function, like the AVX2 ones,
+   so they don't raise the instruction set required by the rest of Ogre.
+*/
+#if __OGRE_HAVE_SSE && (OGRE_COMPILER == OGRE_COMPILER_MSVC || \
+    OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_GNUC, 490) || OGRE_COMPILER_MIN_VERSION(OGRE_COMPILER_CLANG, 380))
+#   define __OGRE_HAVE_SSSE3_PIXEL_ROWS  1
+#else
+#   define __OGRE_HAVE_SSSE3_PIXEL_ROWS  0
+#endif
+
+namespace Ogre {
+
+    struct PixelRowConversion;
+
+    /// Converts count consecutive pixels of a row
+    typedef void (*PixelRowKernel)(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count);
+
+    /** Converts rows of pixels from one format to another without going
+        through PixelUtil::unpackColour and PixelUtil::packColour, with the
+        same results.
+    @remarks
+        The kernels are selected at run-time for the instruction sets the
+        CPU supports, see _findPixelRowConversion.
+    */
+    struct PixelRowConversion
+    {
+        enum Kind
+        {
+            /// 8 bit channels to 8 bit channels
+            PRK_BYTE_SHUFFLE,
+            /// 8 bit channels to 32 bit float channels
+            PRK_BYTE_TO_FLOAT,
+            /// 32 bit float channels to 8 bit channels
+            PRK_FLOAT_TO_BYTE,
+            /// 16 bit float to 32 bit float, per component
+            PRK_HALF_TO_FLOAT,
+            /// 32 bit float to 16 bit float, per component
+            PRK_FLOAT_TO_HALF,
+            /// 8 bit sRGB channels to linear 32 bit float channels
+            PRK_SRGB_TO_LINEAR,
+            /// linear 32 bit float channels to 8 bit sRGB channels
+            PRK_LINEAR_TO_SRGB,
+            PRK_COUNT
+        };
+
+        /// Values of map other than source bytes or channels
+        enum
+        {
+            /// Set to 0
+            PRM_ZERO = 0x80,
+            /// Set to 255 for bytes, or 1 for floats
+            PRM_ONE = 0xFF
+        };
+
+        Kind kind;
+        PixelRowKernel kernel;
+        /// Whether the kernel uses SIMD instructions
+        bool vectorised;
+        /// Bytes per source and destination pixel
+        uint8 srcBytes, dstBytes;
+        /** The source byte of each destination byte for shuffles, or the source
+            byte or channel of each destination channel for the other byte and
+            float conversions. Channels are in r, g, b, a order; for sRGB
+            conversions only channel 3 is alpha.
+        */
+        uint8 map[4];
+    };
+
+    /// The kernels of an instruction set, or NULL where it has none
+    typedef PixelRowKernel PixelRowKernels[PixelRowConversion::PRK_COUNT];
+
+    /// The scalar kernels, which the SIMD ones use for the remaining pixels of a row
+    const PixelRowKernels& _getPixelRowKernelsGeneral(void);
+
+    /// The colour space conversion done by a PixelRowConversion
+    enum PixelRowGamma
+    {
+        PRG_NONE,
+        PRG_SRGB_TO_LINEAR,
+        PRG_LINEAR_TO_SRGB
+    };
+
+    /** Finds a row conversion between the formats, returns false if there is none.
+    @param gamma Whether the colour channels are decoded from or encoded to sRGB
+    */
+    bool _findPixelRowConversion(PixelFormat srcFormat, PixelFormat dstFormat,
+        PixelRowGamma gamma, PixelRowConversion& conv);
+
+    /// Converts a box of pixels using the row conversion
+    void _convertPixelRows(const PixelRowConversion& conv, const PixelBox& src, const PixelBox& dst);
+
+    /** Tables for sRGB conversion.
+    @remarks
+        Linear to sRGB uses one bucket per 1/4096th of the range. The sRGB
+        value is the one at the bucket start, plus one if the linear value
+        is at least the threshold of the bucket, which gives exactly rounded
+        results.
+    */
+    struct PixelSRGBTables
+    {
+        /// Linear value of each 8 bit sRGB value
+        float toLinear[256];
+        /// Lowest linear value of the next sRGB value in each bucket
+        float threshold[4096];
+        /// sRGB value at the start of each bucket
+        uint8 toSRGB[4096];
+
+        static const PixelSRGBTables& get(void);
+
+        /// Encodes a linear value to 8 bit sRGB, clamping to [0, 1]
+        inline uint8 encode(float v) const
+        {
+            if (!(v > 0.0f))
+                return 0;
+            if (v >= 1.0f)
+                return 255;
+            size_t bucket = static_cast<size_t>(v * 4096.0f);
+            return static_cast<uint8>(toSRGB[bucket] + (v >= threshold[bucket]));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,231 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelRowConversions.h"
+#include "OgreBitwise.h"
+
+#if __OGRE_HAVE_AVX2
+
+#include <immintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// AVX2 row kernels for the byte shuffles, 8 pixels at a time as 4 per
+// 128-bit lane, and the half float conversions, 8 components at a time.
+// The byte to float conversions are limited by the division and stay with
+// the SSSE3 kernels.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
+#   define __OGRE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#   define __OGRE_AVX2_TARGET
+#endif
+
+namespace Ogre {
+
+    namespace {
+        const uint8 PRM_ZERO = PixelRowConversion::PRM_ZERO;
+        const uint8 PRM_ONE = PixelRowConversion::PRM_ONE;
+
+        //---------------------------------------------------------------------
+        // Helpers
+        //---------------------------------------------------------------------
+        /// Loads 4, 8, 12 or 16 bytes
+        template <size_t N>
+        inline __m128i __OGRE_AVX2_TARGET loadBytes(const uint8* src)
+        {
+            if (N == 16)
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if (N == 8)
+                return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            int last;
+            memcpy(&last, src + N - 4, sizeof(last));
+            if (N == 4)
+                return _mm_cvtsi32_si128(last);
+            return _mm_insert_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), last, 2);
+        }
+        //---------------------------------------------------------------------
+        /// Stores the first 4, 8, 12 or 16 bytes
+        template <size_t N>
+        inline void __OGRE_AVX2_TARGET storeBytes(uint8* dst, __m128i v)
+        {
+            if (N == 16)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+                return;
+            }
+            if (N >= 8)
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v);
+            if (N % 8 != 0)
+            {
+                int last = _mm_extract_epi32(v, N / 4 - 1);
+                memcpy(dst + N - 4, &last, sizeof(last));
+            }
+        }
+        //---------------------------------------------------------------------
+        /// Bitwise::halfToFloatI of 8 zero extended halves
+        inline __m256i __OGRE_AVX2_TARGET halfToFloat8(__m256i h)
+        {
+            __m256i sign = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x8000)), 16);
+            __m256i em = _mm256_and_si256(h, _mm256_set1_epi32(0x7fff));
+            __m256i shifted = _mm256_slli_epi32(em, 13);
+            __m256i normal = _mm256_add_epi32(shifted, _mm256_set1_epi32(0x38000000));
+            __m256i special = _mm256_add_epi32(shifted, _mm256_set1_epi32(0x70000000));
+            __m256i denormal = _mm256_castps_si256(
+                _mm256_mul_ps(_mm256_cvtepi32_ps(em), _mm256_set1_ps(1.0f / 16777216.0f)));
+
+            __m256i r = _mm256_blendv_epi8(normal, special, _mm256_cmpgt_epi32(em, _mm256_set1_epi32(0x7bff)));
+            r = _mm256_blendv_epi8(r, denormal, _mm256_cmpgt_epi32(_mm256_set1_epi32(0x400), em));
+            return _mm256_or_si256(r, sign);
+        }
+        //---------------------------------------------------------------------
+        /// Bitwise::floatToHalfI of 8 floats, as 32 bit integers
+        inline __m256i __OGRE_AVX2_TARGET floatToHalf8(__m256i i)
+        {
+            __m256i sign = _mm256_and_si256(_mm256_srli_epi32(i, 16), _mm256_set1_epi32(0x8000));
+            __m256i a = _mm256_and_si256(i, _mm256_set1_epi32(0x7fffffff));
+            __m256i e = _mm256_srli_epi32(a, 23);
+
+            __m256i normal = _mm256_sub_epi32(_mm256_srli_epi32(a, 13), _mm256_set1_epi32(112 << 10));
+            __m256i small = _mm256_cvttps_epi32(
+                _mm256_mul_ps(_mm256_castsi256_ps(a), _mm256_set1_ps(16777216.0f)));
+            __m256i nan = _mm256_srli_epi32(_mm256_and_si256(a, _mm256_set1_epi32(0x7fffff)), 13);
+            nan = _mm256_or_si256(nan, _mm256_and_si256(
+                _mm256_cmpeq_epi32(nan, _mm256_setzero_si256()), _mm256_set1_epi32(1)));
+            __m256i big = _mm256_or_si256(_mm256_set1_epi32(0x7c00),
+                _mm256_and_si256(_mm256_cmpgt_epi32(a, _mm256_set1_epi32(0x7f800000)), nan));
+
+            __m256i r = _mm256_blendv_epi8(normal, big, _mm256_cmpgt_epi32(e, _mm256_set1_epi32(142)));
+            r = _mm256_blendv_epi8(r, small, _mm256_cmpgt_epi32(_mm256_set1_epi32(113), e));
+            sign = _mm256_and_si256(sign, _mm256_cmpgt_epi32(e, _mm256_set1_epi32(101)));
+            return _mm256_or_si256(r, sign);
+        }
+
+        //---------------------------------------------------------------------
+        // Kernels
+        //---------------------------------------------------------------------
+        void __OGRE_AVX2_TARGET halfToFloatAVX2(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const uint16* in = reinterpret_cast<const uint16*>(src);
+            uint32* out = reinterpret_cast<uint32*>(dst);
+            const size_t n = count * conv.srcBytes / sizeof(uint16);
+
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), halfToFloat8(h));
+            }
+            for (; i < n; ++i)
+                out[i] = Bitwise::halfToFloatI(in[i]);
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_AVX2_TARGET floatToHalfAVX2(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const uint32* in = reinterpret_cast<const uint32*>(src);
+            uint16* out = reinterpret_cast<uint16*>(dst);
+            const size_t n = count * conv.dstBytes / sizeof(uint16);
+
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                __m256i h = floatToHalf8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                    _mm_packus_epi32(_mm256_castsi256_si128(h), _mm256_extracti128_si256(h, 1)));
+            }
+            for (; i < n; ++i)
+                out[i] = Bitwise::floatToHalfI(in[i]);
+        }
+        //---------------------------------------------------------------------
+        template <size_t SB, size_t DB>
+        void __OGRE_AVX2_TARGET byteShuffleAVX2(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            // shuffle of 4 pixels in each lane, 0xFF bytes are or'ed in afterwards
+            uint8 shuffle[16], ones[16];
+            memset(shuffle, 0x80, sizeof(shuffle));
+            memset(ones, 0, sizeof(ones));
+            for (size_t p = 0; p < 4; ++p)
+            {
+                for (size_t j = 0; j < DB; ++j)
+                {
+                    uint8 index = conv.map[j];
+                    if (index < PRM_ZERO)
+                        shuffle[p * DB + j] = static_cast<uint8>(p * SB + index);
+                    else if (index == PRM_ONE)
+                        ones[p * DB + j] = 0xFF;
+                }
+            }
+            const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle)));
+            const __m256i one = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ones)));
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8, src += 8 * SB, dst += 8 * DB)
+            {
+                __m256i pixels = SB == 4 ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src))
+                                         : _mm256_inserti128_si256(_mm256_castsi128_si256(loadBytes<4 * SB>(src)),
+                                                                   loadBytes<4 * SB>(src + 4 * SB), 1);
+                __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), one);
+                if (DB == 4)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), r);
+                }
+                else
+                {
+                    storeBytes<4 * DB>(dst, _mm256_castsi256_si128(r));
+                    storeBytes<4 * DB>(dst + 4 * DB, _mm256_extracti128_si256(r, 1));
+                }
+            }
+
+            if (i < count)
+                _getPixelRowKernelsGeneral()[conv.kind](conv, src, dst, count - i);
+        }
+        //---------------------------------------------------------------------
+        void byteShuffleAVX2(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            static const PixelRowKernel kernels[4][4] = {
+                { byteShuffleAVX2<1, 1>, byteShuffleAVX2<1, 2>, byteShuffleAVX2<1, 3>, byteShuffleAVX2<1, 4> },
+                { byteShuffleAVX2<2, 1>, byteShuffleAVX2<2, 2>, byteShuffleAVX2<2, 3>, byteShuffleAVX2<2, 4> },
+                { byteShuffleAVX2<3, 1>, byteShuffleAVX2<3, 2>, byteShuffleAVX2<3, 3>, byteShuffleAVX2<3, 4> },
+                { byteShuffleAVX2<4, 1>, byteShuffleAVX2<4, 2>, byteShuffleAVX2<4, 3>, byteShuffleAVX2<4, 4> }
+            };
+            kernels[conv.srcBytes - 1][conv.dstBytes - 1](conv, src, dst, count);
+        }
+    }
+    //-----------------------------------------------------------------------
+    extern void _getPixelRowKernelsAVX2(PixelRowKernels& kernels);
+    extern void _getPixelRowKernelsAVX2(PixelRowKernels& kernels)
+    {
+        kernels[PixelRowConversion::PRK_BYTE_SHUFFLE] = byteShuffleAVX2;
+        kernels[PixelRowConversion::PRK_HALF_TO_FLOAT] = halfToFloatAVX2;
+        kernels[PixelRowConversion::PRK_FLOAT_TO_HALF] = floatToHalfAVX2;
+    }
+}
+
+#endif // __OGRE_HAVE_AVX2
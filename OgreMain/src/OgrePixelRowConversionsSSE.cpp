@@ -0,0 +1,372 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePixelRowConversions.h"
+#include "OgreBitwise.h"
+
+#if __OGRE_HAVE_SSSE3_PIXEL_ROWS
+
+#include <tmmintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// SSE2 and SSSE3 row kernels. Byte formats are converted 4 pixels at a
+// time: pshufb moves every source byte to its destination byte, or to its
+// 32 bit lane for float conversions, using masks built from the map of the
+// conversion. The half float conversions do the same integer operations as
+// Bitwise::halfToFloatI and Bitwise::floatToHalfI without branches, rather
+// than using F16C, whose rounding and NaN handling differ.
+//
+// The loads and stores touch exactly the bytes of the pixels, so rows
+// need no padding. Remaining pixels are handed to the general kernels.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
+#   define __OGRE_SSE2_TARGET __attribute__((target("sse2")))
+#   define __OGRE_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#   define __OGRE_SSE2_TARGET
+#   define __OGRE_SSSE3_TARGET
+#endif
+
+namespace Ogre {
+
+    namespace {
+        const uint8 PRM_ZERO = PixelRowConversion::PRM_ZERO;
+        const uint8 PRM_ONE = PixelRowConversion::PRM_ONE;
+
+        //---------------------------------------------------------------------
+        // Helpers
+        //---------------------------------------------------------------------
+        /// Loads 4, 8, 12 or 16 bytes
+        template <size_t N>
+        inline __m128i __OGRE_SSE2_TARGET loadBytes(const uint8* src)
+        {
+            if (N == 16)
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if (N == 8)
+                return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            int last;
+            memcpy(&last, src + N - 4, sizeof(last));
+            if (N == 4)
+                return _mm_cvtsi32_si128(last);
+            return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+                                      _mm_cvtsi32_si128(last));
+        }
+        //---------------------------------------------------------------------
+        /// Stores the first 4, 8, 12 or 16 bytes
+        template <size_t N>
+        inline void __OGRE_SSE2_TARGET storeBytes(uint8* dst, __m128i v)
+        {
+            if (N == 16)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+                return;
+            }
+            if (N >= 8)
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v);
+            if (N % 8 != 0)
+            {
+                int last = _mm_cvtsi128_si32(N == 4 ? v : _mm_srli_si128(v, 8));
+                memcpy(dst + N - 4, &last, sizeof(last));
+            }
+        }
+        //---------------------------------------------------------------------
+        inline __m128i __OGRE_SSE2_TARGET select(__m128i mask, __m128i a, __m128i b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+        //---------------------------------------------------------------------
+        /// Bitwise::halfToFloatI of 4 zero extended halves
+        inline __m128i __OGRE_SSE2_TARGET halfToFloat4(__m128i h)
+        {
+            __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+            __m128i em = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+            __m128i shifted = _mm_slli_epi32(em, 13);
+            // rebias the exponent, keeping infinities and NaNs at the maximum
+            __m128i normal = _mm_add_epi32(shifted, _mm_set1_epi32(0x38000000));
+            __m128i special = _mm_add_epi32(shifted, _mm_set1_epi32(0x70000000));
+            // denormals are exact as floats
+            __m128i denormal = _mm_castps_si128(
+                _mm_mul_ps(_mm_cvtepi32_ps(em), _mm_set1_ps(1.0f / 16777216.0f)));
+
+            __m128i r = select(_mm_cmpgt_epi32(em, _mm_set1_epi32(0x7bff)), special, normal);
+            r = select(_mm_cmplt_epi32(em, _mm_set1_epi32(0x400)), denormal, r);
+            return _mm_or_si128(r, sign);
+        }
+        //---------------------------------------------------------------------
+        /// Bitwise::floatToHalfI of 4 floats, as 32 bit integers
+        inline __m128i __OGRE_SSE2_TARGET floatToHalf4(__m128i i)
+        {
+            __m128i sign = _mm_and_si128(_mm_srli_epi32(i, 16), _mm_set1_epi32(0x8000));
+            __m128i a = _mm_and_si128(i, _mm_set1_epi32(0x7fffffff));
+            __m128i e = _mm_srli_epi32(a, 23);
+
+            __m128i normal = _mm_sub_epi32(_mm_srli_epi32(a, 13), _mm_set1_epi32(112 << 10));
+            // denormal halves, truncated
+            __m128i small = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(a), _mm_set1_ps(16777216.0f)));
+            // infinity, or NaN keeping the top of the mantissa
+            __m128i nan = _mm_srli_epi32(_mm_and_si128(a, _mm_set1_epi32(0x7fffff)), 13);
+            nan = _mm_or_si128(nan, _mm_and_si128(_mm_cmpeq_epi32(nan, _mm_setzero_si128()), _mm_set1_epi32(1)));
+            __m128i big = _mm_or_si128(_mm_set1_epi32(0x7c00),
+                _mm_and_si128(_mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f800000)), nan));
+
+            __m128i r = select(_mm_cmpgt_epi32(e, _mm_set1_epi32(142)), big, normal);
+            r = select(_mm_cmplt_epi32(e, _mm_set1_epi32(113)), small, r);
+            // values below 2^-25 become an unsigned zero
+            sign = _mm_and_si128(sign, _mm_cmpgt_epi32(e, _mm_set1_epi32(101)));
+            return _mm_or_si128(r, sign);
+        }
+        //---------------------------------------------------------------------
+        /// Packs 2 x 4 values in [0, 0xFFFF] to 16 bits
+        inline __m128i __OGRE_SSE2_TARGET packUint16(__m128i lo, __m128i hi)
+        {
+            // sign extend, so the signed saturation leaves them alone
+            lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+            hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+            return _mm_packs_epi32(lo, hi);
+        }
+
+        //---------------------------------------------------------------------
+        // SSE2 kernels
+        //---------------------------------------------------------------------
+        void __OGRE_SSE2_TARGET halfToFloatSSE2(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const uint16* in = reinterpret_cast<const uint16*>(src);
+            uint32* out = reinterpret_cast<uint32*>(dst);
+            const size_t n = count * conv.srcBytes / sizeof(uint16);
+            const __m128i zero = _mm_setzero_si128();
+
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), halfToFloat4(_mm_unpacklo_epi16(h, zero)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), halfToFloat4(_mm_unpackhi_epi16(h, zero)));
+            }
+            for (; i < n; ++i)
+                out[i] = Bitwise::halfToFloatI(in[i]);
+        }
+        //---------------------------------------------------------------------
+        void __OGRE_SSE2_TARGET floatToHalfSSE2(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            const uint32* in = reinterpret_cast<const uint32*>(src);
+            uint16* out = reinterpret_cast<uint16*>(dst);
+            const size_t n = count * conv.dstBytes / sizeof(uint16);
+
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                __m128i lo = floatToHalf4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                __m128i hi = floatToHalf4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packUint16(lo, hi));
+            }
+            for (; i < n; ++i)
+                out[i] = Bitwise::floatToHalfI(in[i]);
+        }
+
+        //---------------------------------------------------------------------
+        // SSSE3 kernels, instantiated per pixel size
+        //---------------------------------------------------------------------
+        template <size_t SB, size_t DB>
+        void __OGRE_SSSE3_TARGET byteShuffleSSSE3(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            // shuffle of 4 pixels, 0xFF bytes are or'ed in afterwards
+            uint8 shuffle[16], ones[16];
+            memset(shuffle, 0x80, sizeof(shuffle));
+            memset(ones, 0, sizeof(ones));
+            for (size_t p = 0; p < 4; ++p)
+            {
+                for (size_t j = 0; j < DB; ++j)
+                {
+                    uint8 index = conv.map[j];
+                    if (index < PRM_ZERO)
+                        shuffle[p * DB + j] = static_cast<uint8>(p * SB + index);
+                    else if (index == PRM_ONE)
+                        ones[p * DB + j] = 0xFF;
+                }
+            }
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle));
+            const __m128i one = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ones));
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4, src += 4 * SB, dst += 4 * DB)
+                storeBytes<4 * DB>(dst, _mm_or_si128(_mm_shuffle_epi8(loadBytes<4 * SB>(src), mask), one));
+
+            if (i < count)
+                _getPixelRowKernelsGeneral()[conv.kind](conv, src, dst, count - i);
+        }
+        //---------------------------------------------------------------------
+        template <size_t SB, size_t C>
+        void __OGRE_SSSE3_TARGET byteToFloatSSSE3(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            // the 4 pixels give C vectors of floats, each with a shuffle
+            // zero extending the source bytes to 32 bits, and 1.0 or'ed in
+            // for the missing alpha
+            __m128i masks[C];
+            __m128 ones[C];
+            for (size_t v = 0; v < C; ++v)
+            {
+                uint8 shuffle[16];
+                float one[4];
+                memset(shuffle, 0x80, sizeof(shuffle));
+                for (size_t l = 0; l < 4; ++l)
+                {
+                    size_t p = (v * 4 + l) / C, k = (v * 4 + l) % C;
+                    uint8 index = conv.map[k];
+                    one[l] = index == PRM_ONE ? 1.0f : 0.0f;
+                    if (index != PRM_ONE)
+                        shuffle[l * 4] = static_cast<uint8>(p * SB + index);
+                }
+                masks[v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle));
+                ones[v] = _mm_loadu_ps(one);
+            }
+            const __m128 scale = _mm_set1_ps(255.0f);
+
+            float* out = reinterpret_cast<float*>(dst);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4, src += 4 * SB, out += 4 * C)
+            {
+                __m128i pixels = loadBytes<4 * SB>(src);
+                for (size_t v = 0; v < C; ++v)
+                {
+                    // a real division, as Bitwise::fixedToFloat
+                    __m128 f = _mm_div_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(pixels, masks[v])), scale);
+                    _mm_storeu_ps(out + v * 4, _mm_or_ps(f, ones[v]));
+                }
+            }
+
+            if (i < count)
+                _getPixelRowKernelsGeneral()[conv.kind](conv, src, reinterpret_cast<uint8*>(out), count - i);
+        }
+        //---------------------------------------------------------------------
+        template <size_t C, size_t DB>
+        void __OGRE_SSSE3_TARGET floatToByteSSSE3(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            // the floats of 4 pixels are packed to bytes in order, then
+            // shuffled to the destination bytes
+            uint8 shuffle[16], ones[16];
+            memset(shuffle, 0x80, sizeof(shuffle));
+            memset(ones, 0, sizeof(ones));
+            for (size_t p = 0; p < 4; ++p)
+            {
+                for (size_t j = 0; j < DB; ++j)
+                {
+                    uint8 index = conv.map[j];
+                    if (index < PRM_ZERO)
+                        shuffle[p * DB + j] = static_cast<uint8>(p * C + index);
+                    else if (index == PRM_ONE)
+                        ones[p * DB + j] = 0xFF;
+                }
+            }
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle));
+            const __m128i one = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ones));
+            const __m128 scale = _mm_set1_ps(256.0f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 maximum = _mm_set1_ps(255.0f);
+
+            const float* in = reinterpret_cast<const float*>(src);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4, in += 4 * C, dst += 4 * DB)
+            {
+                __m128i values[4];
+                for (size_t v = 0; v < 4; ++v)
+                {
+                    if (v >= C)
+                    {
+                        values[v] = _mm_setzero_si128();
+                        continue;
+                    }
+                    // Bitwise::floatToFixed, the maximum with zero as first
+                    // operand also turns NaN into 0
+                    __m128 f = _mm_mul_ps(_mm_loadu_ps(in + v * 4), scale);
+                    values[v] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(f, zero), maximum));
+                }
+                __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]),
+                                                 _mm_packs_epi32(values[2], values[3]));
+                storeBytes<4 * DB>(dst, _mm_or_si128(_mm_shuffle_epi8(bytes, mask), one));
+            }
+
+            if (i < count)
+                _getPixelRowKernelsGeneral()[conv.kind](conv, reinterpret_cast<const uint8*>(in), dst, count - i);
+        }
+        //---------------------------------------------------------------------
+        // Dispatch on the pixel sizes
+        //---------------------------------------------------------------------
+        void byteShuffleSSSE3(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            static const PixelRowKernel kernels[4][4] = {
+                { byteShuffleSSSE3<1, 1>, byteShuffleSSSE3<1, 2>, byteShuffleSSSE3<1, 3>, byteShuffleSSSE3<1, 4> },
+                { byteShuffleSSSE3<2, 1>, byteShuffleSSSE3<2, 2>, byteShuffleSSSE3<2, 3>, byteShuffleSSSE3<2, 4> },
+                { byteShuffleSSSE3<3, 1>, byteShuffleSSSE3<3, 2>, byteShuffleSSSE3<3, 3>, byteShuffleSSSE3<3, 4> },
+                { byteShuffleSSSE3<4, 1>, byteShuffleSSSE3<4, 2>, byteShuffleSSSE3<4, 3>, byteShuffleSSSE3<4, 4> }
+            };
+            kernels[conv.srcBytes - 1][conv.dstBytes - 1](conv, src, dst, count);
+        }
+        //---------------------------------------------------------------------
+        void byteToFloatSSSE3(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            static const PixelRowKernel kernels[4][4] = {
+                { byteToFloatSSSE3<1, 1>, byteToFloatSSSE3<1, 2>, byteToFloatSSSE3<1, 3>, byteToFloatSSSE3<1, 4> },
+                { byteToFloatSSSE3<2, 1>, byteToFloatSSSE3<2, 2>, byteToFloatSSSE3<2, 3>, byteToFloatSSSE3<2, 4> },
+                { byteToFloatSSSE3<3, 1>, byteToFloatSSSE3<3, 2>, byteToFloatSSSE3<3, 3>, byteToFloatSSSE3<3, 4> },
+                { byteToFloatSSSE3<4, 1>, byteToFloatSSSE3<4, 2>, byteToFloatSSSE3<4, 3>, byteToFloatSSSE3<4, 4> }
+            };
+            kernels[conv.srcBytes - 1][conv.dstBytes / sizeof(float) - 1](conv, src, dst, count);
+        }
+        //---------------------------------------------------------------------
+        void floatToByteSSSE3(const PixelRowConversion& conv, const uint8* src, uint8* dst, size_t count)
+        {
+            static const PixelRowKernel kernels[4][4] = {
+                { floatToByteSSSE3<1, 1>, floatToByteSSSE3<1, 2>, floatToByteSSSE3<1, 3>, floatToByteSSSE3<1, 4> },
+                { floatToByteSSSE3<2, 1>, floatToByteSSSE3<2, 2>, floatToByteSSSE3<2, 3>, floatToByteSSSE3<2, 4> },
+                { floatToByteSSSE3<3, 1>, floatToByteSSSE3<3, 2>, floatToByteSSSE3<3, 3>, floatToByteSSSE3<3, 4> },
+                { floatToByteSSSE3<4, 1>, floatToByteSSSE3<4, 2>, floatToByteSSSE3<4, 3>, floatToByteSSSE3<4, 4> }
+            };
+            kernels[conv.srcBytes / sizeof(float) - 1][conv.dstBytes - 1](conv, src, dst, count);
+        }
+    }
+    //-----------------------------------------------------------------------
+    extern void _getPixelRowKernelsSSE2(PixelRowKernels& kernels);
+    extern void _getPixelRowKernelsSSE2(PixelRowKernels& kernels)
+    {
+        kernels[PixelRowConversion::PRK_HALF_TO_FLOAT] = halfToFloatSSE2;
+        kernels[PixelRowConversion::PRK_FLOAT_TO_HALF] = floatToHalfSSE2;
+    }
+    //-----------------------------------------------------------------------
+    extern void _getPixelRowKernelsSSSE3(PixelRowKernels& kernels);
+    extern void _getPixelRowKernelsSSSE3(PixelRowKernels& kernels)
+    {
+        kernels[PixelRowConversion::PRK_BYTE_SHUFFLE] = byteShuffleSSSE3;
+        kernels[PixelRowConversion::PRK_BYTE_TO_FLOAT] = byteToFloatSSSE3;
+        kernels[PixelRowConversion::PRK_FLOAT_TO_BYTE] = floatToByteSSSE3;
+    }
+}
+
+#endif // __OGRE_HAVE_SSSE3_PIXEL_ROWS
@@ -148,11 +148,20 @@ namespace Ogre {
     }
 
     //---------------------------------------------------------------------
-    // Performs CPUID instruction with 'query', fill the results, and return value of eax.
-    static uint _performCpuid(int query, CpuidResult& result)
+    // Performs CPUID instruction with 'query' and 'subQuery' (the value of ecx, only
+    // used by some functions), fill the results, and return value of eax.
+    static uint _performCpuid(int query, CpuidResult& result, int subQuery = 0)
     {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
-    #if _MSC_VER >= 1400 
+    #if _MSC_VER >= 1500
+        int CPUInfo[4];
+        __cpuidex(CPUInfo, query, subQuery);
+        result._eax = CPUInfo[0];
+        result._ebx = CPUInfo[1];
+        result._ecx = CPUInfo[2];
+        result._edx = CPUInfo[3];
+        return result._eax;
+    #elif _MSC_VER >= 1400
         int CPUInfo[4];
         __cpuid(CPUInfo, query);
         result._eax = CPUInfo[0];
@@ -165,6 +174,7 @@ namespace Ogre {
         {
             mov     edi, result
             mov     eax, query
+            mov     ecx, subQuery
             cpuid
             mov     [edi]._eax, eax
             mov     [edi]._ebx, ebx
@@ -177,7 +187,7 @@ namespace Ogre {
         #if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (subQuery)
         );
         #else
         __asm__
@@ -187,7 +197,7 @@ namespace Ogre {
             "movl   %%ebx, %%edi    \n\t"
             "popl   %%ebx           \n\t"
             : "=a" (result._eax), "=D" (result._ebx), "=c" (result._ecx), "=d" (result._edx)
-            : "a" (query)
+            : "a" (query), "c" (subQuery)
         );
        #endif // OGRE_ARCHITECTURE_64
         return result._eax;
@@ -202,6 +212,28 @@ namespace Ogre {
 #pragma warning(pop)
 #endif
 
+    //---------------------------------------------------------------------
+    // Reads the extended control register 0, which tells the register states
+    // saved by the OS. Must only be called if CPUID reports OSXSAVE.
+    static uint64 _readXCR0(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+    #if _MSC_VER >= 1600
+        return _xgetbv(0);
+    #else
+        return 0;
+    #endif
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_EMSCRIPTEN
+        uint eax, edx;
+        // xgetbv, spelled as bytes for old assemblers
+        __asm__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+        return ((uint64)edx << 32) | eax;
+#else
+        // TODO: Supports other compiler
+        return 0;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Detect whether or not os support Streaming SIMD Extension.
 #if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
@@ -278,6 +310,8 @@ namespace Ogre {
     // Compiler-independent routines
     //---------------------------------------------------------------------
 
+    static uint queryAvxFeatures(uint standardFeaturesEcx, uint maxStandardFunctionSupport);
+
     static uint queryCpuFeatures(void)
     {
 
@@ -296,8 +330,19 @@ namespace Ogre {
 #define CPUID_STD_HTT               (1<<28)     // EDX[28] - Bit 28 set indicates  Hyper-Threading Technology is supported in hardware.
 
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0]  - Bit 0 of standard function 1 indicate SSE3 supported
+#define CPUID_STD_SSSE3             (1<<9)      // ECX[9]  - Bit 9 of standard function 1 indicate SSSE3 supported
 #define CPUID_STD_SSE41             (1<<19)     // ECX[19] - Bit 0 of standard function 1 indicate SSE41 supported
 #define CPUID_STD_SSE42             (1<<20)     // ECX[20] - Bit 0 of standard function 1 indicate SSE42 supported
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - Bit 12 of standard function 1 indicate FMA3 supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate XGETBV enabled by the OS
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+
+#define CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES 0x7
+#define CPUID_SEF_AVX2              (1<<5)      // EBX[5]  - Bit 5 of function 7 indicate AVX2 supported
+#define CPUID_SEF_AVX512F           (1<<16)     // EBX[16] - Bit 16 of function 7 indicate AVX-512 Foundation supported
+
+#define XCR0_AVX_STATE              0x06        // XMM and YMM registers
+#define XCR0_AVX512_STATE           0xE6        // XMM, YMM, ZMM0-15 upper halves, ZMM16-31 and opmask registers
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -320,6 +365,8 @@ namespace Ogre {
             // Has standard feature ?
             if (_performCpuid(CPUID_FUNC_VENDOR_ID, result))
             {
+                const uint maxStandardFunctionSupport = result._eax;
+
                 // Check vendor strings
                 if (memcmp(&result._ebx, "GenuineIntel", 12) == 0)
                 {
@@ -343,11 +390,15 @@ namespace Ogre {
                         features |= PlatformInformation::CPU_FEATURE_SSE2;
                     if (result._ecx & CPUID_STD_SSE3)
                         features |= PlatformInformation::CPU_FEATURE_SSE3;
+                    if (result._ecx & CPUID_STD_SSSE3)
+                        features |= PlatformInformation::CPU_FEATURE_SSSE3;
                     if (result._ecx & CPUID_STD_SSE41)
                         features |= PlatformInformation::CPU_FEATURE_SSE41;
                     if (result._ecx & CPUID_STD_SSE42)
                         features |= PlatformInformation::CPU_FEATURE_SSE42;
 
+                    features |= queryAvxFeatures(result._ecx, maxStandardFunctionSupport);
+
                     // Check to see if this is a Pentium 4 or later processor
                     if ((result._eax & CPUID_EXT_FAMILY_ID_MASK) ||
                         (result._eax & CPUID_FAMILY_ID_MASK) == CPUID_PENTIUM4_ID)
@@ -389,6 +440,10 @@ namespace Ogre {
 
                     if (result._ecx & CPUID_STD_SSE3)
                         features |= PlatformInformation::CPU_FEATURE_SSE3;
+                    if (result._ecx & CPUID_STD_SSSE3)
+                        features |= PlatformInformation::CPU_FEATURE_SSSE3;
+
+                    features |= queryAvxFeatures(result._ecx, maxStandardFunctionSupport);
 
                     // Has extended feature ?
                     const uint maxExtensionFunctionSupport = _performCpuid(CPUID_FUNC_EXTENSION_QUERY, result);
@@ -420,6 +475,37 @@ namespace Ogre {
         return features;
     }
     //---------------------------------------------------------------------
+    // Detect AVX features, common to all vendors. The OS must save the wider
+    // register states on context switches as well, which is checked via XCR0.
+    static uint queryAvxFeatures(uint standardFeaturesEcx, uint maxStandardFunctionSupport)
+    {
+        uint features = 0;
+
+        if (!(standardFeaturesEcx & CPUID_STD_OSXSAVE) || !(standardFeaturesEcx & CPUID_STD_AVX))
+            return features;
+
+        const uint64 xcr0 = _readXCR0();
+        if ((xcr0 & XCR0_AVX_STATE) != XCR0_AVX_STATE)
+            return features;
+
+        features |= PlatformInformation::CPU_FEATURE_AVX;
+        if (standardFeaturesEcx & CPUID_STD_FMA)
+            features |= PlatformInformation::CPU_FEATURE_FMA;
+
+        if (maxStandardFunctionSupport >= CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES)
+        {
+            CpuidResult result;
+            _performCpuid(CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES, result, 0);
+
+            if (result._ebx & CPUID_SEF_AVX2)
+                features |= PlatformInformation::CPU_FEATURE_AVX2;
+            if ((result._ebx & CPUID_SEF_AVX512F) && (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE)
+                features |= PlatformInformation::CPU_FEATURE_AVX512F;
+        }
+
+        return features;
+    }
+    //---------------------------------------------------------------------
     static uint _detectCpuFeatures(void)
     {
         uint features = queryCpuFeatures();
@@ -428,8 +514,13 @@ namespace Ogre {
             | PlatformInformation::CPU_FEATURE_SSE
             | PlatformInformation::CPU_FEATURE_SSE2
             | PlatformInformation::CPU_FEATURE_SSE3
+            | PlatformInformation::CPU_FEATURE_SSSE3
             | PlatformInformation::CPU_FEATURE_SSE41
-            | PlatformInformation::CPU_FEATURE_SSE42;
+            | PlatformInformation::CPU_FEATURE_SSE42
+            | PlatformInformation::CPU_FEATURE_AVX
+            | PlatformInformation::CPU_FEATURE_AVX2
+            | PlatformInformation::CPU_FEATURE_FMA
+            | PlatformInformation::CPU_FEATURE_AVX512F;
 
         if ((features & sse_features) && !_checkOperatingSystemSupportSSE())
         {
@@ -531,6 +622,7 @@ namespace Ogre {
         features |= PlatformInformation::CPU_FEATURE_SSE;
         features |= PlatformInformation::CPU_FEATURE_SSE2;
         features |= PlatformInformation::CPU_FEATURE_SSE3;
+        features |= PlatformInformation::CPU_FEATURE_SSSE3;
 #endif
         return features;
     }
@@ -699,10 +791,20 @@ namespace Ogre {
                 " *         SSE2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE2), true));
             pLog->logMessage(
                 " *         SSE3: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE3), true));
+            pLog->logMessage(
+                " *        SSSE3: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSSE3), true));
             pLog->logMessage(
                 " *        SSE41: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE41), true));
             pLog->logMessage(
                 " *        SSE42: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE42), true));
+            pLog->logMessage(
+                " *          AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+            pLog->logMessage(
+                " *         AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+            pLog->logMessage(
+                " *          FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
+            pLog->logMessage(
+                " *      AVX512F: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX512F), true));
             pLog->logMessage(
                 " *          MMX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_MMX), true));
             pLog->logMessage(
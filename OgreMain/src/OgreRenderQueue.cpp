@@ -33,13 +33,24 @@ THE SOFTWARE.
 #include "OgreSceneManagerEnumerator.h"
 
 namespace Ogre {
-
+    namespace
+    {
+        /// Tells the streamed textures of a visible object how large it is on screen
+        void notifyStreamingDemand(MovableObject* mo, Camera* cam)
+        {
+            TextureManager* textureManager = TextureManager::getSingletonPtr();
+            if (textureManager && textureManager->getStreamingBudget())
+                textureManager->_notifyStreamingDemand(mo, cam);
+        }
+    }
     //---------------------------------------------------------------------
     RenderQueue::RenderQueue()
         : mSplitPassesByLightingType(false)
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
+        , mSortKeysEnabled(false)
         , mRenderableListener(0)
+        , mStaging(false)
     {
         // Create the 'main' queue up-front since we'll always need that
         mGroups.insert(
@@ -77,6 +88,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderQueue::addRenderable(Renderable* pRend, uint8 groupID, ushort priority)
     {
+        if (mStaging)
+        {
+            StagedRenderable staged = {pRend, groupID, priority};
+            mStagedRenderables.push_back(staged);
+            return;
+        }
+
         // Find group
         RenderQueueGroup* pGroup = getQueueGroup(groupID);
 
@@ -204,6 +222,7 @@ namespace Ogre {
                 mSplitPassesByLightingType,
                 mSplitNoShadowPasses,
                 mShadowCastersCannotBeReceivers);
+            pGroup->setSortKeysEnabled(mSortKeysEnabled);
             mGroups.insert(RenderQueueGroupMap::value_type(groupID, pGroup));
         }
         else
@@ -269,6 +288,24 @@ namespace Ogre {
         return mShadowCastersCannotBeReceivers;
     }
     //-----------------------------------------------------------------------
+    void RenderQueue::setSortKeysEnabled(bool enabled)
+    {
+        mSortKeysEnabled = enabled;
+
+        RenderQueueGroupMap::iterator i, iend;
+        i = mGroups.begin();
+        iend = mGroups.end();
+        for (; i != iend; ++i)
+        {
+            i->second->setSortKeysEnabled(enabled);
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool RenderQueue::getSortKeysEnabled(void) const
+    {
+        return mSortKeysEnabled;
+    }
+    //-----------------------------------------------------------------------
     void RenderQueue::merge( const RenderQueue* rhs )
     {
         ConstQueueGroupIterator it = rhs->_getQueueGroupIterator( );
@@ -298,6 +335,8 @@ namespace Ogre {
             if (!onlyShadowCasters || mo->getCastShadows())
             {
                 mo -> _updateRenderQueue( this );
+                if (!onlyShadowCasters)
+                    notifyStreamingDemand(mo, cam);
                 if (visibleBounds)
                 {
                     visibleBounds->merge(mo->getWorldBoundingBox(true), 
@@ -315,6 +354,72 @@ namespace Ogre {
         }
 
     }
+    //---------------------------------------------------------------------
+    void RenderQueue::_setStaging(bool staging)
+    {
+        mStaging = staging;
+        mStagedRenderables.clear();
+    }
+    //---------------------------------------------------------------------
+    RenderQueue::StagedObjectState RenderQueue::stageVisibleObject(MovableObject* mo,
+        Camera* cam, bool onlyShadowCasters)
+    {
+        assert(mStaging && "Objects can only be staged on a staging queue");
+
+        mo->_notifyCurrentCamera(cam);
+        if (!mo->isVisible())
+            return SOS_HIDDEN;
+
+        if (onlyShadowCasters && !mo->getCastShadows())
+            return SOS_NOT_CASTER;
+
+        mo->_updateRenderQueue(this);
+        return SOS_QUEUED;
+    }
+    //---------------------------------------------------------------------
+    void RenderQueue::mergeStagedObject(MovableObject* mo, StagedObjectState state,
+        const StagedRenderable* begin, const StagedRenderable* end,
+        Camera* cam, bool onlyShadowCasters, VisibleObjectsBoundsInfo* visibleBounds)
+    {
+        if (state == SOS_HIDDEN)
+            return;
+
+        // same as processVisibleObject from here on
+        if (state == SOS_QUEUED)
+        {
+            for (; begin != end; ++begin)
+                addRenderable(begin->renderable, begin->groupID, begin->priority);
+            if (!onlyShadowCasters)
+                notifyStreamingDemand(mo, cam);
+        }
+
+        if (visibleBounds)
+            mergeStagedBounds(mo, state, cam, visibleBounds);
+    }
+    //---------------------------------------------------------------------
+    void RenderQueue::mergeStagedBounds(MovableObject* mo, StagedObjectState state, Camera* cam,
+        VisibleObjectsBoundsInfo* visibleBounds) const
+    {
+        if (state == SOS_HIDDEN)
+            return;
+
+        // not getQueueGroup, which creates missing groups, with shadows enabled
+        RenderQueueGroupMap::const_iterator group = mGroups.find(mo->getRenderQueueGroup());
+        bool receiveShadows = (group == mGroups.end() || group->second->getShadowsEnabled())
+            && mo->getReceivesShadows();
+
+        if (state == SOS_QUEUED)
+        {
+            visibleBounds->merge(mo->getWorldBoundingBox(true),
+                mo->getWorldBoundingSphere(true), cam,
+                receiveShadows);
+        }
+        else if (receiveShadows)
+        {
+            visibleBounds->mergeNonRenderedButInFrustum(mo->getWorldBoundingBox(true),
+                mo->getWorldBoundingSphere(true), cam);
+        }
+    }
 
 }
 
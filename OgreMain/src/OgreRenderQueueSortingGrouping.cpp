@@ -34,6 +34,69 @@ namespace Ogre {
         RenderablePass, uint32> QueuedRenderableCollection::msRadixSorter1;
     RadixSort<QueuedRenderableCollection::RenderablePassList,
         RenderablePass, float> QueuedRenderableCollection::msRadixSorter2;
+    QueuedRenderableCollection::SortKeyedRenderablePassList QueuedRenderableCollection::msSortKeyScratch;
+
+    namespace {
+        /** Maps a float to a uint32 which sorts in the same order; positive 
+            values get the sign bit set, negative ones have all bits flipped.
+        */
+        uint32 floatSortKey(float f)
+        {
+            uint32 bits;
+            memcpy(&bits, &f, sizeof(bits));
+            return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+        }
+
+        /** Stable LSD radix sort on the 64-bit keys, skipping the bytes which
+            are the same for all keys.
+        */
+        template <typename T>
+        void radixSortByKey(T& list, T& scratch)
+        {
+            const size_t size = list.size();
+            uint32 counters[8][256];
+            memset(counters, 0, sizeof(counters));
+
+            bool needsSorting = false;
+            for (size_t i = 0; i < size; ++i)
+            {
+                uint64 key = list[i].key;
+                if (i > 0 && key < list[i - 1].key)
+                    needsSorting = true;
+                for (int b = 0; b < 8; ++b)
+                    ++counters[b][(key >> (b * 8)) & 0xFF];
+            }
+
+            // early exit if already sorted (temporal coherence)
+            if (!needsSorting)
+                return;
+
+            scratch.resize(size, list.front());
+            T* src = &list;
+            T* dest = &scratch;
+            for (int b = 0; b < 8; ++b)
+            {
+                if (counters[b][(list.front().key >> (b * 8)) & 0xFF] == size)
+                    continue;
+
+                uint32 offsets[256];
+                offsets[0] = 0;
+                for (int i = 1; i < 256; ++i)
+                    offsets[i] = offsets[i - 1] + counters[b][i - 1];
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const typename T::value_type& entry = (*src)[i];
+                    (*dest)[offsets[(entry.key >> (b * 8)) & 0xFF]++] = entry;
+                }
+                std::swap(src, dest);
+            }
+
+            // keep the buffers, just exchange them if the result is in the scratch area
+            if (src != &list)
+                list.swap(scratch);
+        }
+    }
 
 
     //-----------------------------------------------------------------------
@@ -80,6 +143,16 @@ namespace Ogre {
         addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
     }
     //-----------------------------------------------------------------------
+    void RenderPriorityGroup::setSortKeysEnabled(bool enabled)
+    {
+        mSolidsBasic.setSortKeysEnabled(enabled);
+        mSolidsDiffuseSpecular.setSortKeysEnabled(enabled);
+        mSolidsDecal.setSortKeysEnabled(enabled);
+        mSolidsNoShadowReceive.setSortKeysEnabled(enabled);
+        mTransparentsUnsorted.setSortKeysEnabled(enabled);
+        mTransparents.setSortKeysEnabled(enabled);
+    }
+    //-----------------------------------------------------------------------
     void RenderPriorityGroup::addRenderable(Renderable* rend, Technique* pTech)
     {
         // Transparent and depth/colour settings mean depth sorting is required?
@@ -273,6 +346,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     QueuedRenderableCollection::QueuedRenderableCollection(void)
         :mOrganisationMode(0)
+        ,mSortKeysEnabled(false)
     {
     }
 
@@ -287,8 +361,10 @@ namespace Ogre {
             i->second.clear();
         }
 
-        // Clear sorted list
+        // Clear sorted lists
         mSortedDescending.clear();
+        mGroupedByKey.clear();
+        mSortedDescendingByKey.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
@@ -308,7 +384,21 @@ namespace Ogre {
         // ascending and descending sort both set bit 1
         // We always sort descending, because the only difference is in the
         // acceptVisitor method, where we iterate in reverse in ascending mode
-        if (mOrganisationMode & OM_SORT_DESCENDING)
+        if ((mOrganisationMode & OM_SORT_DESCENDING) && mSortKeysEnabled)
+        {
+            // A single sort on the inverted depth in the upper 32 bits and the pass
+            // hash in the lower gives the same order as the 2 radix sorts below
+            SortKeyedRenderablePassList::iterator i, iend;
+            iend = mSortedDescendingByKey.end();
+            for (i = mSortedDescendingByKey.begin(); i != iend; ++i)
+            {
+                const RenderablePass& rp = i->renderablePass;
+                uint32 depth = ~floatSortKey(static_cast<float>(rp.renderable->getSquaredViewDepth(cam)));
+                i->key = (uint64(depth) << 32) | rp.pass->getHash();
+            }
+            radixSortByKey(mSortedDescendingByKey, msSortKeyScratch);
+        }
+        else if (mOrganisationMode & OM_SORT_DESCENDING)
         {
             
             // We can either use a stable_sort and the 'less' implementation,
@@ -338,18 +428,45 @@ namespace Ogre {
         }
 
         // Nothing needs to be done for pass groups, they auto-organise
+        // unless they are grouped by sorting
+        if ((mOrganisationMode & OM_PASS_GROUP) && mSortKeysEnabled)
+        {
+            // The pass hash (the pass index and its texture or GPU program bindings,
+            // see Pass::setHashFunction) in the upper 32 bits, then 16 bits of the 
+            // pass address to keep apart passes whose hashes collide, then the 
+            // depth quantised to 16 bits so that each pass is drawn front to back
+            SortKeyedRenderablePassList::iterator i, iend;
+            iend = mGroupedByKey.end();
+            for (i = mGroupedByKey.begin(); i != iend; ++i)
+            {
+                const RenderablePass& rp = i->renderablePass;
+                uint32 depth = floatSortKey(static_cast<float>(rp.renderable->getSquaredViewDepth(cam)));
+                size_t address = reinterpret_cast<size_t>(rp.pass) >> 4;
+                uint32 passBits = static_cast<uint32>(address ^ (address >> 16)) & 0xFFFF;
+                i->key = (uint64(rp.pass->getHash()) << 32) | (passBits << 16) | (depth >> 16);
+            }
+            radixSortByKey(mGroupedByKey, msSortKeyScratch);
+        }
 
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::addRenderable(Pass* pass, Renderable* rend)
     {
         // ascending and descending sort both set bit 1
-        if (mOrganisationMode & OM_SORT_DESCENDING)
+        if ((mOrganisationMode & OM_SORT_DESCENDING) && mSortKeysEnabled)
+        {
+            mSortedDescendingByKey.push_back(SortKeyedRenderablePass(rend, pass));
+        }
+        else if (mOrganisationMode & OM_SORT_DESCENDING)
         {
             mSortedDescending.push_back(RenderablePass(rend, pass));
         }
 
-        if (mOrganisationMode & OM_PASS_GROUP)
+        if ((mOrganisationMode & OM_PASS_GROUP) && mSortKeysEnabled)
+        {
+            mGroupedByKey.push_back(SortKeyedRenderablePass(rend, pass));
+        }
+        else if (mOrganisationMode & OM_PASS_GROUP)
         {
             PassGroupRenderableMap::iterator i = mGrouped.find(pass);
             if (i == mGrouped.end())
@@ -394,7 +511,10 @@ namespace Ogre {
         switch(om)
         {
         case OM_PASS_GROUP:
-            acceptVisitorGrouped(visitor);
+            if (mSortKeysEnabled)
+                acceptVisitorGroupedByKey(visitor);
+            else
+                acceptVisitorGrouped(visitor);
             break;
         case OM_SORT_DESCENDING:
             acceptVisitorDescending(visitor);
@@ -432,9 +552,42 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void QueuedRenderableCollection::acceptVisitorGroupedByKey(
+        QueuedRenderableVisitor* visitor) const
+    {
+        // Renderables are sorted by pass, so visit the pass whenever it changes
+        const Pass* currentPass = 0;
+        bool skip = false;
+        SortKeyedRenderablePassList::const_iterator i, iend;
+        iend = mGroupedByKey.end();
+        for (i = mGroupedByKey.begin(); i != iend; ++i)
+        {
+            if (i->renderablePass.pass != currentPass)
+            {
+                currentPass = i->renderablePass.pass;
+                // Visit Pass - allow skip
+                skip = !visitor->visit(currentPass);
+            }
+
+            if (!skip)
+                visitor->visit(i->renderablePass.renderable);
+        }
+    }
+    //-----------------------------------------------------------------------
     void QueuedRenderableCollection::acceptVisitorDescending(
         QueuedRenderableVisitor* visitor) const
     {
+        if (mSortKeysEnabled)
+        {
+            SortKeyedRenderablePassList::const_iterator k, kend;
+            kend = mSortedDescendingByKey.end();
+            for (k = mSortedDescendingByKey.begin(); k != kend; ++k)
+            {
+                visitor->visit(const_cast<RenderablePass*>(&k->renderablePass));
+            }
+            return;
+        }
+
         // List is already in descending order, so iterate forward
         RenderablePassList::const_iterator i, iend;
 
@@ -448,6 +601,17 @@ namespace Ogre {
     void QueuedRenderableCollection::acceptVisitorAscending(
         QueuedRenderableVisitor* visitor) const
     {
+        if (mSortKeysEnabled)
+        {
+            SortKeyedRenderablePassList::const_reverse_iterator k, kend;
+            kend = mSortedDescendingByKey.rend();
+            for (k = mSortedDescendingByKey.rbegin(); k != kend; ++k)
+            {
+                visitor->visit(const_cast<RenderablePass*>(&k->renderablePass));
+            }
+            return;
+        }
+
         // List is in descending order, so iterate in reverse
         RenderablePassList::const_reverse_iterator i, iend;
 
@@ -461,7 +625,29 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
     {
+        // The source may be organised with or without sort keys
+        RenderablePassList::const_iterator srcSorted;
+        SortKeyedRenderablePassList::const_iterator srcKeyed;
+        if (mSortKeysEnabled)
+        {
+            mSortedDescendingByKey.insert( mSortedDescendingByKey.end(), rhs.mSortedDescendingByKey.begin(), rhs.mSortedDescendingByKey.end() );
+            for( srcSorted = rhs.mSortedDescending.begin(); srcSorted != rhs.mSortedDescending.end(); ++srcSorted )
+                mSortedDescendingByKey.push_back( SortKeyedRenderablePass( srcSorted->renderable, srcSorted->pass ) );
+
+            mGroupedByKey.insert( mGroupedByKey.end(), rhs.mGroupedByKey.begin(), rhs.mGroupedByKey.end() );
+            PassGroupRenderableMap::const_iterator srcGroup;
+            for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
+            {
+                RenderableList::const_iterator r;
+                for( r = srcGroup->second.begin(); r != srcGroup->second.end(); ++r )
+                    mGroupedByKey.push_back( SortKeyedRenderablePass( *r, srcGroup->first ) );
+            }
+            return;
+        }
+
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
+        for( srcKeyed = rhs.mSortedDescendingByKey.begin(); srcKeyed != rhs.mSortedDescendingByKey.end(); ++srcKeyed )
+            mSortedDescending.push_back( srcKeyed->renderablePass );
 
         PassGroupRenderableMap::const_iterator srcGroup;
         for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
@@ -484,8 +670,12 @@ namespace Ogre {
             // Insert renderable
             dstGroup->second.insert( dstGroup->second.end(), srcGroup->second.begin(), srcGroup->second.end() );
         }
-    }
 
+        for( srcKeyed = rhs.mGroupedByKey.begin(); srcKeyed != rhs.mGroupedByKey.end(); ++srcKeyed )
+        {
+            mGrouped[srcKeyed->renderablePass.pass].push_back( srcKeyed->renderablePass.renderable );
+        }
+    }
 
 }
 
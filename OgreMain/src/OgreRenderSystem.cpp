@@ -37,6 +37,8 @@ THE SOFTWARE.
 #include "OgreIteratorWrappers.h"
 #include "OgreHardwareOcclusionQuery.h"
 
+#include <numeric>
+
 #ifdef OGRE_BUILD_COMPONENT_RTSHADERSYSTEM
 #include <OgreRTShaderConfig.h>
 #endif
@@ -59,6 +61,7 @@ namespace Ogre {
         , mBatchCount(0)
         , mFaceCount(0)
         , mVertexCount(0)
+        , mLastVertexDeclaration(0)
         , mInvertVertexWinding(false)
         , mDisabledTexUnitsFrom(0)
         , mCurrentPassIterationCount(0)
@@ -312,6 +315,7 @@ namespace Ogre {
     {
         // This method is only ever called to set a texture unit to valid details
         // The method _disableTextureUnit is called to turn a unit off
+        mFrameStats.textureBinds++;
 
         const TexturePtr& tex = tl._getTexturePtr();
         bool isValidBinding = false;
@@ -723,6 +727,38 @@ namespace Ogre {
         return static_cast< unsigned int >( mVertexCount );
     }
     //-----------------------------------------------------------------------
+    void RenderSystem::FrameStatistics::reset()
+    {
+        batchCount = faceCount = vertexCount = 0;
+        passChanges = programBinds = textureBinds = 0;
+        vertexDeclarationChanges = constantBytesUploaded = 0;
+        std::fill(bufferLocks, bufferLocks + HardwareBuffer::HBL_WRITE_ONLY + 1, 0);
+        std::fill(bufferBytesLocked, bufferBytesLocked + HardwareBuffer::HBL_WRITE_ONLY + 1, 0);
+        updateSceneGraphTime = findLightsTime = prepareShadowTexturesTime = 0;
+        findVisibleObjectsTime = renderVisibleObjectsTime = 0;
+    }
+    //-----------------------------------------------------------------------
+    size_t RenderSystem::FrameStatistics::getTotalBufferLocks() const
+    {
+        return std::accumulate(bufferLocks, bufferLocks + HardwareBuffer::HBL_WRITE_ONLY + 1, size_t(0));
+    }
+    //-----------------------------------------------------------------------
+    size_t RenderSystem::FrameStatistics::getTotalBufferBytesLocked() const
+    {
+        return std::accumulate(bufferBytesLocked,
+                               bufferBytesLocked + HardwareBuffer::HBL_WRITE_ONLY + 1, size_t(0));
+    }
+    //-----------------------------------------------------------------------
+    void RenderSystem::_finishFrameStatistics()
+    {
+        // buffer locks are global as buffers may be locked without a RenderSystem at hand
+        HardwareBuffer::_collectLockStatistics(mFrameStats.bufferLocks, mFrameStats.bufferBytesLocked);
+        mLastFrameStats = mFrameStats;
+        mFrameStats.reset();
+        // make the first draw of the next frame count as a change
+        mLastVertexDeclaration = 0;
+    }
+    //-----------------------------------------------------------------------
     void RenderSystem::convertColourValue(const ColourValue& colour, uint32* pDest)
     {
         *pDest = VertexElement::convertColourValue(colour, getColourVertexElementType());
@@ -733,6 +769,7 @@ namespace Ogre {
     {
         // Update stats
         size_t val;
+        size_t faceCountBefore = mFaceCount;
 
         if (op.useIndexes)
             val = op.indexData->indexCount;
@@ -797,6 +834,15 @@ namespace Ogre {
         mVertexCount += op.vertexData->vertexCount * trueInstanceNum;
         mBatchCount += mCurrentPassIterationCount;
 
+        mFrameStats.faceCount += mFaceCount - faceCountBefore;
+        mFrameStats.vertexCount += op.vertexData->vertexCount * trueInstanceNum;
+        mFrameStats.batchCount += mCurrentPassIterationCount;
+        if (op.vertexData->vertexDeclaration != mLastVertexDeclaration)
+        {
+            mLastVertexDeclaration = op.vertexData->vertexDeclaration;
+            mFrameStats.vertexDeclarationChanges++;
+        }
+
         // sort out clip planes
         // have to do it here in case of matrix issues
         if (mClipPlanesDirty)
@@ -946,6 +992,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void RenderSystem::bindGpuProgram(GpuProgram* prg)
     {
+        mFrameStats.programBinds++;
+
         switch(prg->getType())
         {
         case GPT_VERTEX_PROGRAM:
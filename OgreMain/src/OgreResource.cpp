@@ -51,6 +51,13 @@ namespace Ogre
         _fireLoadingComplete(true);
     }
     //-----------------------------------------------------------------------
+    void Resource::waitForParallelPreparation(void)
+    {
+        // rather than spinning while a task of ResourceGroupManager prepares this
+        if (ResourceGroupManager* rgm = ResourceGroupManager::getSingletonPtr())
+            rgm->_waitForPreparation(this);
+    }
+    //-----------------------------------------------------------------------
     void Resource::prepare(bool background)
     {
         // quick check that avoids any synchronisation
@@ -62,6 +69,7 @@ namespace Ogre
         old = LOADSTATE_UNLOADED;
         if (!mLoadingState.compare_exchange_strong(old,LOADSTATE_PREPARING))
         {
+            waitForParallelPreparation();
             while( mLoadingState.load() == LOADSTATE_PREPARING )
             {
                             OGRE_LOCK_AUTO_MUTEX;
@@ -156,6 +164,7 @@ namespace Ogre
 
             if ( old == LOADSTATE_PREPARING )
             {
+                waitForParallelPreparation();
                 while( mLoadingState.load() == LOADSTATE_PREPARING )
                 {
                                     OGRE_LOCK_AUTO_MUTEX;
@@ -259,6 +259,40 @@ namespace Ogre {
         return 0; 
 #endif
 
+    }
+    //---------------------------------------------------------------------
+    BackgroundProcessTicket ResourceBackgroundQueue::streamTexture(
+        ResourceHandle handle, uint32 residentMipmap, Listener* listener)
+    {
+#if OGRE_THREAD_SUPPORT
+        // queue a request
+        ResourceRequest req;
+        req.type = RT_STREAM_TEXTURE;
+        req.resourceHandle = handle;
+        req.mipmap = residentMipmap;
+        req.listener = listener;
+        return addRequest(req);
+#else
+        // synchronous
+        TexturePtr tex = static_pointer_cast<Texture>(TextureManager::getSingleton().getByHandle(handle));
+        if (tex)
+        {
+            // called from the frame loop, which must not stop if the file went away
+            try
+            {
+                Image img;
+                tex->_readStreamedImage(img);
+                tex->_loadStreamedImage(img, residentMipmap);
+            }
+            catch (Exception& e)
+            {
+                LogManager::getSingleton().logError("Texture '" + tex->getName() +
+                                                    "' could not be streamed: " + e.getFullDescription());
+                tex->_notifyStreamingFailed();
+            }
+        }
+        return 0; 
+#endif
     }
     //------------------------------------------------------------------------
     bool ResourceBackgroundQueue::isProcessComplete(
@@ -367,6 +401,14 @@ namespace Ogre {
                 else
                     rm->unload(resreq.resourceName, ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
                 break;
+            case RT_STREAM_TEXTURE:
+                // only read the image here, the texture is updated in the main thread
+                if (ResourcePtr tex = TextureManager::getSingleton().getByHandle(resreq.resourceHandle))
+                {
+                    resreq.image.reset(OGRE_NEW Image());
+                    static_cast<Texture*>(tex.get())->_readStreamedImage(*resreq.image);
+                }
+                break;
             };
         }
         catch (Exception& e)
@@ -430,6 +472,14 @@ namespace Ogre {
                 ResourceGroupManager::getSingleton().loadResourceGroup(req.groupName);
             }
 #endif
+            if (req.type == RT_STREAM_TEXTURE && req.image)
+            {
+                TexturePtr tex = static_pointer_cast<Texture>(
+                    TextureManager::getSingleton().getByHandle(req.resourceHandle));
+                if (tex)
+                    tex->_loadStreamedImage(*req.image, req.mipmap);
+            }
+
             mOutstandingRequestSet.erase(res->getRequest()->getID());
 
             // Call resource listener
@@ -446,6 +496,15 @@ namespace Ogre {
                 }
             }
         }
+        else if (req.type == RT_STREAM_TEXTURE)
+        {
+            // don't request it again each frame
+            TexturePtr tex = static_pointer_cast<Texture>(
+                TextureManager::getSingleton().getByHandle(req.resourceHandle));
+            if (tex)
+                tex->_notifyStreamingFailed();
+            mOutstandingRequestSet.erase(res->getRequest()->getID());
+        }
         // Call queue listener
         if (req.listener)
             req.listener->operationCompleted(res->getRequest()->getID(), req.result);
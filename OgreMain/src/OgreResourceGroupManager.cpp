@@ -27,9 +27,305 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
+#include "OgreTaskScheduler.h"
 
 namespace Ogre {
 
+namespace {
+    /// Prepares a resource on a TaskScheduler thread
+    class ResourcePrepareTask : public Task
+    {
+    public:
+        ResourcePrepareTask() : prepared(false) {}
+
+        ResourcePtr resource;
+        bool prepared;
+
+        void execute(void)
+        {
+            try
+            {
+                // as a background preparation, so the listeners are not called here
+                resource->prepare(true);
+                prepared = true;
+            }
+            catch (...)
+            {
+                // the calling thread prepares it again, and throws in order
+            }
+        }
+    };
+}
+
+    /** Prepares the resources of a group on the TaskScheduler threads while the
+        calling thread goes through them in order.
+    */
+    class ResourceGroupManager::ParallelPreparation
+    {
+    public:
+        ParallelPreparation(ResourceGroupManager* manager, const vector<ResourcePtr>::type& resources)
+            : mManager(manager), mRegistered(false), mWaiters(0),
+              mScheduler(resources.empty() ? NULL : Root::getSingleton().getTaskScheduler()),
+              mTasks(resources.size())
+        {
+            if (!mScheduler)
+                return;
+
+            for (size_t i = 0; i < resources.size(); ++i)
+                mTaskMap[resources[i].get()] = &mTasks[i];
+
+            {
+                // only the outermost one, nested groups are prepared while it runs
+                OGRE_WQ_LOCK_MUTEX(mManager->mPreparationMutex);
+                if (!mManager->mActivePreparation)
+                {
+                    mManager->mActivePreparation = this;
+                    mRegistered = true;
+                }
+            }
+
+            for (size_t i = 0; i < resources.size(); ++i)
+            {
+                mTasks[i].resource = resources[i];
+                mScheduler->submit(&mTasks[i], mGroup);
+            }
+        }
+
+        ~ParallelPreparation()
+        {
+            // the tasks must not outlive this, e.g. when loading threw
+            if (!mScheduler)
+                return;
+
+            mScheduler->wait(mGroup);
+            if (mRegistered)
+            {
+                {
+                    OGRE_WQ_LOCK_MUTEX(mManager->mPreparationMutex);
+                    mManager->mActivePreparation = 0;
+                }
+                // waits from other threads which looked this up are on finished tasks
+                while (mWaiters.load())
+                    OGRE_THREAD_YIELD;
+            }
+        }
+
+        /** Wait until res is prepared, if it is prepared by a task
+        @return whether the task prepared it
+        */
+        bool wait(Resource* res)
+        {
+            map<Resource*, ResourcePrepareTask*>::type::iterator it = mTaskMap.find(res);
+            if (it == mTaskMap.end())
+                return false;
+            mScheduler->wait(*it->second);
+            return it->second->prepared;
+        }
+
+        /** Look up the task preparing res for _waitForPreparation, under
+            mPreparationMutex. Pass it to waitFromAnyThread afterwards.
+        */
+        Task* acquireTask(Resource* res)
+        {
+            map<Resource*, ResourcePrepareTask*>::type::iterator it = mTaskMap.find(res);
+            if (it == mTaskMap.end())
+                return 0;
+            ++mWaiters;
+            return it->second;
+        }
+
+        /// Wait for a task of acquireTask, without holding the lock as other tasks may wait as well
+        void waitFromAnyThread(Task* task)
+        {
+            mScheduler->wait(*task);
+            --mWaiters;
+        }
+
+    private:
+        ResourceGroupManager* mManager;
+        bool mRegistered;
+        AtomicScalar<size_t> mWaiters;
+        TaskScheduler* mScheduler;
+        vector<ResourcePrepareTask>::type mTasks;
+        map<Resource*, ResourcePrepareTask*>::type mTaskMap;
+        TaskGroup mGroup;
+    };
+
+namespace {
+    typedef std::pair<ScriptLoader*, FileInfoList> LoaderFileListPair;
+    typedef vector<LoaderFileListPair>::type ScriptLoaderFileList;
+}
+    //-----------------------------------------------------------------------
+    DataStreamPtr ResourceGroupManager::openScript(const FileInfo& file, const String& group) const
+    {
+        DataStreamPtr stream;
+        {
+            // the tasks of a parallel script preparation open their files concurrently
+            OGRE_WQ_LOCK_MUTEX(mOpenResourceMutex);
+            stream = file.archive->open(file.filename);
+        }
+        if (!stream)
+            return stream;
+
+        // parallel parsing is disabled while there is a listener, so this is the calling thread
+        if (mLoadingListener)
+            mLoadingListener->resourceStreamOpened(file.filename, group, 0, stream);
+
+        // memory mapped files are parsed in place
+        if (file.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024 &&
+            !dynamic_cast<MemoryDataStream*>(stream.get()))
+        {
+            return DataStreamPtr(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+        }
+        return stream;
+    }
+
+    /// Prepares a script on a TaskScheduler thread
+    class ResourceGroupManager::ScriptPrepareTask : public Task
+    {
+    public:
+        ScriptPrepareTask() : manager(0), loader(0), file(0), prepared(false) {}
+
+        const ResourceGroupManager* manager;
+        ScriptLoader* loader;
+        const FileInfo* file;
+        String group;
+        Any data;
+        bool prepared;
+
+        void execute(void)
+        {
+            try
+            {
+                DataStreamPtr stream = manager->openScript(*file, group);
+                if (stream)
+                {
+                    data = loader->prepareScript(stream, group);
+                    prepared = true;
+                }
+            }
+            catch (...)
+            {
+                // the calling thread parses it again, and throws in order
+            }
+        }
+    };
+
+    /** Prepares the scripts of a group on the TaskScheduler threads while the
+        calling thread parses them in order.
+    */
+    class ResourceGroupManager::ParallelScriptPreparation
+    {
+    public:
+        ParallelScriptPreparation(const ResourceGroupManager* manager, const ScriptLoaderFileList* scripts,
+                                  const String& group)
+            : mScheduler(NULL), mTasks(countPreparedScripts(scripts))
+        {
+            if (mTasks.empty())
+                return;
+
+            mScheduler = Root::getSingleton().getTaskScheduler();
+            size_t n = 0;
+            for (ScriptLoaderFileList::const_iterator i = scripts->begin(); i != scripts->end(); ++i)
+            {
+                if (!i->first->isPrepareScriptThreadSafe())
+                    continue;
+
+                for (FileInfoList::const_iterator f = i->second.begin(); f != i->second.end(); ++f)
+                {
+                    ScriptPrepareTask& task = mTasks[n++];
+                    task.manager = manager;
+                    task.loader = i->first;
+                    task.file = &*f;
+                    task.group = group;
+                    mTaskMap[task.file] = &task;
+                    mScheduler->submit(&task, mGroup);
+                }
+            }
+        }
+
+        ~ParallelScriptPreparation()
+        {
+            // the tasks must not outlive this, e.g. when parsing threw
+            if (mScheduler)
+                mScheduler->wait(mGroup);
+        }
+
+        /// Finishes parsing file if it was prepared by a task, returns false otherwise
+        bool parse(const FileInfo& file, const String& group)
+        {
+            map<const FileInfo*, ScriptPrepareTask*>::type::iterator it = mTaskMap.find(&file);
+            if (it == mTaskMap.end())
+                return false;
+
+            ScriptPrepareTask* task = it->second;
+            mScheduler->wait(*task);
+            if (!task->prepared)
+                return false;
+
+            task->loader->parsePreparedScript(task->data, group);
+            // release the prepared data early
+            task->data = Any();
+            return true;
+        }
+
+    private:
+        static size_t countPreparedScripts(const ScriptLoaderFileList* scripts)
+        {
+            size_t count = 0;
+            if (!scripts)
+                return count;
+
+            for (ScriptLoaderFileList::const_iterator i = scripts->begin(); i != scripts->end(); ++i)
+            {
+                if (i->first->isPrepareScriptThreadSafe())
+                    count += i->second.size();
+            }
+            return count;
+        }
+
+        TaskScheduler* mScheduler;
+        vector<ScriptPrepareTask>::type mTasks;
+        map<const FileInfo*, ScriptPrepareTask*>::type mTaskMap;
+        TaskGroup mGroup;
+    };
+
+namespace {
+    const uint32 RESOURCE_INDEX_CACHE_VERSION = 1;
+
+    String resourceIndexCacheKey(const Archive* arch, bool recursive)
+    {
+        return arch->getType() + (recursive ? ":r:" : ":") + arch->getName();
+    }
+
+    void writeCacheString(const DataStreamPtr& stream, const String& str)
+    {
+        uint32 length = static_cast<uint32>(str.size());
+        stream->write(&length, sizeof(uint32));
+        stream->write(str.data(), length);
+    }
+
+    void writeCacheNumber(const DataStreamPtr& stream, uint64 value)
+    {
+        stream->write(&value, sizeof(uint64));
+    }
+
+    bool readCacheString(const DataStreamPtr& stream, String& str)
+    {
+        uint32 length = 0;
+        if (stream->read(&length, sizeof(uint32)) != sizeof(uint32) ||
+            (stream->size() && length > stream->size() - stream->tell()))
+            return false;
+        str.resize(length);
+        return length == 0 || stream->read(&str[0], length) == length;
+    }
+
+    bool readCacheNumber(const DataStreamPtr& stream, uint64& value)
+    {
+        return stream->read(&value, sizeof(uint64)) == sizeof(uint64);
+    }
+}
+
     //-----------------------------------------------------------------------
     template<> ResourceGroupManager* Singleton<ResourceGroupManager>::msSingleton = 0;
     ResourceGroupManager* ResourceGroupManager::getSingletonPtr(void)
@@ -54,7 +350,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mCurrentGroup(0), mParallelPreparation(false), mActivePreparation(0), mParallelScriptParsing(false),
+          mUseResourceIndexCache(false), mResourceIndexCacheDirty(false)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -197,6 +494,8 @@ namespace Ogre {
         // Now load for real
         if (prepareMainResources)
         {
+            ParallelPreparation parallel(this, collectParallelPreparation(grp));
+
             for (oi = grp->loadResourceOrderMap.begin(); 
                 oi != grp->loadResourceOrderMap.end(); ++oi)
             {
@@ -215,6 +514,8 @@ namespace Ogre {
                     // If preparing one of these resources cascade-prepares another resource, 
                     // the list will get longer! But these should be prepared immediately
                     // Call prepare regardless, already prepared or loaded resources will be skipped
+                    if (parallel.wait(res.get()))
+                        res->_firePreparingComplete(false); // what prepare would have done here
                     res->prepare();
 
                     fireResourcePrepareEnded();
@@ -249,6 +550,48 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished preparing resource group " + name);
     }
     //-----------------------------------------------------------------------
+    vector<ResourcePtr>::type ResourceGroupManager::collectParallelPreparation(ResourceGroup* grp) const
+    {
+        vector<ResourcePtr>::type resources;
+#if OGRE_THREAD_SUPPORT != 1 && OGRE_THREAD_SUPPORT != 2
+        // the listener callbacks must stay on this thread
+        if (!mParallelPreparation || mLoadingListener || !Root::getSingletonPtr())
+            return resources;
+
+        ResourceGroup::LoadResourceOrderMap::iterator oi;
+        for (oi = grp->loadResourceOrderMap.begin(); oi != grp->loadResourceOrderMap.end(); ++oi)
+        {
+            LoadUnloadResourceList::iterator l;
+            for (l = oi->second.begin(); l != oi->second.end(); ++l)
+            {
+                // nothing to do for the others, or not safe to do on other threads:
+                // manual loaders are user code, and a file found in another group
+                // changes the group of the resource while this one is walked
+                Resource* res = l->get();
+                if (res->getLoadingState() == Resource::LOADSTATE_UNLOADED &&
+                    res->getCreator()->isPrepareThreadSafe() && !res->isManuallyLoaded() &&
+                    resourceExists(grp, res->getName()))
+                    resources.push_back(*l);
+            }
+        }
+#endif
+        return resources;
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::_waitForPreparation(Resource* res)
+    {
+        ParallelPreparation* preparation = 0;
+        Task* task = 0;
+        {
+            OGRE_WQ_LOCK_MUTEX(mPreparationMutex);
+            preparation = mActivePreparation;
+            if (preparation)
+                task = preparation->acquireTask(res);
+        }
+        if (task)
+            preparation->waitFromAnyThread(task);
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::loadResourceGroup(const String& name, 
         bool loadMainResources, bool loadWorldGeom)
     {
@@ -292,6 +635,8 @@ namespace Ogre {
         // Now load for real
         if (loadMainResources)
         {
+            ParallelPreparation parallel(this, collectParallelPreparation(grp));
+
             for (oi = grp->loadResourceOrderMap.begin(); 
                 oi != grp->loadResourceOrderMap.end(); ++oi)
             {
@@ -310,6 +655,7 @@ namespace Ogre {
                     // If loading one of these resources cascade-loads another resource, 
                     // the list will get longer! But these should be loaded immediately
                     // Call load regardless, already loaded resources will be skipped
+                    parallel.wait(res.get());
                     res->load();
 
                     fireResourceLoadEnded();
@@ -534,7 +880,12 @@ namespace Ogre {
         // Add to location list
 
         ResourceLocation loc = {pArch, recursive};
-        StringVectorPtr vec = pArch->find("*", recursive);
+        FileInfoListPtr cached;
+        StringVectorPtr vec;
+        if (mUseResourceIndexCache)
+            cached = listCachedResourceIndex(pArch, recursive);
+        if (!cached)
+            vec = pArch->find("*", recursive);
 
         ResourceGroup* grp = getResourceGroup(resGroup);
         if (!grp)
@@ -547,8 +898,16 @@ namespace Ogre {
         grp->locationList.push_back(loc);
 
         // Index resources
-        for( StringVector::iterator it = vec->begin(); it != vec->end(); ++it )
-            grp->addToIndex(*it, pArch);
+        if (cached)
+        {
+            for (FileInfoList::iterator it = cached->begin(); it != cached->end(); ++it)
+                grp->addToIndex(it->filename, pArch);
+        }
+        else
+        {
+            for (StringVector::iterator it = vec->begin(); it != vec->end(); ++it)
+                grp->addToIndex(*it, pArch);
+        }
         
         StringStream msg;
         msg << "Added resource location '" << name << "' of type '" << locType
@@ -559,6 +918,212 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    FileInfoListPtr ResourceGroupManager::listCachedResourceIndex(Archive* arch, bool recursive)
+    {
+        // other archives either list from memory or may not report modification times
+        if (arch->getType() != "FileSystem")
+            return FileInfoListPtr();
+
+        OGRE_LOCK_AUTO_MUTEX;
+
+        String key = resourceIndexCacheKey(arch, recursive);
+        ResourceIndexCacheEntry& entry = mResourceIndexCache[key];
+
+        bool valid = !entry.directories.empty();
+        ResourceIndexCacheEntry::DirectoryTimeList::iterator d;
+        for (d = entry.directories.begin(); valid && d != entry.directories.end(); ++d)
+            valid = arch->getModifiedTime(d->first) == d->second;
+
+        if (!valid)
+        {
+            // take the times first, so changes while listing show up next time
+            time_t now = time(NULL);
+            entry.directories.clear();
+            entry.directories.push_back(std::make_pair(BLANKSTRING, arch->getModifiedTime(BLANKSTRING)));
+            if (recursive)
+            {
+                StringVectorPtr dirs = arch->list(true, true);
+                for (StringVector::iterator i = dirs->begin(); i != dirs->end(); ++i)
+                    entry.directories.push_back(std::make_pair(*i, arch->getModifiedTime(*i)));
+            }
+
+            for (d = entry.directories.begin(); d != entry.directories.end(); ++d)
+            {
+                if (d->second == 0)
+                {
+                    // no way to validate it later
+                    mResourceIndexCache.erase(key);
+                    return FileInfoListPtr();
+                }
+
+                // further changes within this second would go unnoticed, so
+                // make sure the directory is listed again next time
+                if (d->second >= now)
+                    d->second = 0;
+            }
+
+            entry.files = *arch->listFileInfo(recursive);
+            for (FileInfoList::iterator i = entry.files.begin(); i != entry.files.end(); ++i)
+                i->archive = NULL;
+            mResourceIndexCacheDirty = true;
+        }
+        else
+        {
+            LogManager::getSingleton().logMessage(
+                "Using cached resource index for '" + arch->getName() + "'");
+        }
+
+        entry.validated = true;
+
+        FileInfoListPtr ret(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(entry.files), SPFM_DELETE_T);
+        for (FileInfoList::iterator i = ret->begin(); i != ret->end(); ++i)
+            i->archive = arch;
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr ResourceGroupManager::findIndexedFileInfo(ResourceGroup* grp,
+        const String& pattern) const
+    {
+        // the cache can only answer plain wildcards on file names
+        if (!mUseResourceIndexCache || pattern.find_first_of("/\\?[") != String::npos)
+            return findResourceFileInfo(grp->name, pattern);
+
+        FileInfoListPtr vec(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+
+        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+
+        LocationList::iterator i, iend;
+        iend = grp->locationList.end();
+        for (i = grp->locationList.begin(); i != iend; ++i)
+        {
+            ResourceIndexCache::const_iterator c =
+                mResourceIndexCache.find(resourceIndexCacheKey(i->archive, i->recursive));
+            if (c == mResourceIndexCache.end() || !c->second.validated)
+            {
+                FileInfoListPtr lst = i->archive->findFileInfo(pattern, i->recursive, false);
+                vec->insert(vec->end(), lst->begin(), lst->end());
+                continue;
+            }
+
+            // same order as the archive would list them
+            bool caseSensitive = i->archive->isCaseSensitive();
+            FileInfoList::const_iterator f;
+            for (f = c->second.files.begin(); f != c->second.files.end(); ++f)
+            {
+                if (StringUtil::match(f->basename, pattern, caseSensitive))
+                {
+                    vec->push_back(*f);
+                    vec->back().archive = i->archive;
+                }
+            }
+        }
+
+        return vec;
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::saveResourceIndexCache(const DataStreamPtr& stream) const
+    {
+        if (!stream->isWriteable())
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Unable to write to stream " + stream->getName(),
+                "ResourceGroupManager::saveResourceIndexCache");
+        }
+
+        OGRE_LOCK_AUTO_MUTEX;
+
+        uint32 version = RESOURCE_INDEX_CACHE_VERSION;
+        stream->write(&version, sizeof(uint32));
+        uint32 numEntries = static_cast<uint32>(mResourceIndexCache.size());
+        stream->write(&numEntries, sizeof(uint32));
+
+        ResourceIndexCache::const_iterator c;
+        for (c = mResourceIndexCache.begin(); c != mResourceIndexCache.end(); ++c)
+        {
+            writeCacheString(stream, c->first);
+
+            const ResourceIndexCacheEntry& entry = c->second;
+            uint32 numDirs = static_cast<uint32>(entry.directories.size());
+            stream->write(&numDirs, sizeof(uint32));
+            ResourceIndexCacheEntry::DirectoryTimeList::const_iterator d;
+            for (d = entry.directories.begin(); d != entry.directories.end(); ++d)
+            {
+                writeCacheString(stream, d->first);
+                writeCacheNumber(stream, static_cast<uint64>(d->second));
+            }
+
+            uint32 numFiles = static_cast<uint32>(entry.files.size());
+            stream->write(&numFiles, sizeof(uint32));
+            FileInfoList::const_iterator f;
+            for (f = entry.files.begin(); f != entry.files.end(); ++f)
+            {
+                writeCacheString(stream, f->filename);
+                writeCacheString(stream, f->path);
+                writeCacheString(stream, f->basename);
+                writeCacheNumber(stream, f->compressedSize);
+                writeCacheNumber(stream, f->uncompressedSize);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::loadResourceIndexCache(const DataStreamPtr& stream)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+
+        mResourceIndexCache.clear();
+        mResourceIndexCacheDirty = true;
+
+        uint32 version = 0, numEntries = 0;
+        bool ok = stream->read(&version, sizeof(uint32)) == sizeof(uint32) &&
+                  version == RESOURCE_INDEX_CACHE_VERSION &&
+                  stream->read(&numEntries, sizeof(uint32)) == sizeof(uint32);
+
+        for (uint32 e = 0; ok && e < numEntries; ++e)
+        {
+            String key;
+            ResourceIndexCacheEntry entry;
+            uint32 numDirs = 0, numFiles = 0;
+
+            ok = readCacheString(stream, key) &&
+                 stream->read(&numDirs, sizeof(uint32)) == sizeof(uint32);
+            for (uint32 i = 0; ok && i < numDirs; ++i)
+            {
+                String dir;
+                uint64 time = 0;
+                ok = readCacheString(stream, dir) && readCacheNumber(stream, time);
+                entry.directories.push_back(std::make_pair(dir, static_cast<time_t>(time)));
+            }
+
+            ok = ok && stream->read(&numFiles, sizeof(uint32)) == sizeof(uint32);
+            for (uint32 i = 0; ok && i < numFiles; ++i)
+            {
+                FileInfo fi;
+                uint64 compressedSize = 0, uncompressedSize = 0;
+                fi.archive = NULL;
+                ok = readCacheString(stream, fi.filename) && readCacheString(stream, fi.path) &&
+                     readCacheString(stream, fi.basename) && readCacheNumber(stream, compressedSize) &&
+                     readCacheNumber(stream, uncompressedSize);
+                fi.compressedSize = static_cast<size_t>(compressedSize);
+                fi.uncompressedSize = static_cast<size_t>(uncompressedSize);
+                entry.files.push_back(fi);
+            }
+
+            if (ok)
+                mResourceIndexCache[key] = entry;
+        }
+
+        if (!ok)
+        {
+            LogManager::getSingleton().logWarning(
+                "ignoring invalid resource index cache " + stream->getName());
+            mResourceIndexCache.clear();
+            return;
+        }
+
+        mResourceIndexCacheDirty = false;
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::removeResourceLocation(const String& name, 
         const String& resGroup)
     {
@@ -660,6 +1225,9 @@ namespace Ogre {
                 return stream;
         }
 
+        // the tasks of a parallel preparation open their files concurrently
+        OGRE_WQ_LOCK_MUTEX(mOpenResourceMutex);
+
         // Try to find in resource index first
         ResourceGroup* grp = getResourceGroup(groupName);
         if (!grp)
@@ -955,8 +1523,6 @@ namespace Ogre {
             "Parsing scripts for resource group " + grp->name);
 
         // Count up the number of scripts we have to parse
-        typedef std::pair<ScriptLoader*, FileInfoList> LoaderFileListPair;
-        typedef vector<LoaderFileListPair>::type ScriptLoaderFileList;
         ScriptLoaderFileList scriptLoaderFileList;
         size_t scriptCount = 0;
         // Iterate over script users in loading order and get streams
@@ -972,7 +1538,7 @@ namespace Ogre {
             const StringVector& patterns = su->getScriptPatterns();
             for (StringVector::const_iterator p = patterns.begin(); p != patterns.end(); ++p)
             {
-                FileInfoListPtr fileList = findResourceFileInfo(grp->name, *p);
+                FileInfoListPtr fileList = findIndexedFileInfo(grp, *p);
                 FileInfoList& lst = scriptLoaderFileList.back().second;
                 lst.insert(lst.end(), fileList->begin(), fileList->end());
             }
@@ -982,6 +1548,13 @@ namespace Ogre {
         // Fire scripting event
         fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
+        bool parallel = false;
+#if OGRE_THREAD_SUPPORT != 1 && OGRE_THREAD_SUPPORT != 2
+        // the listener callbacks must stay on this thread
+        parallel = mParallelScriptParsing && !mLoadingListener && Root::getSingletonPtr();
+#endif
+        ParallelScriptPreparation preparation(this, parallel ? &scriptLoaderFileList : NULL, grp->name);
+
         // Iterate over scripts and parse
         // Note we respect original ordering
         for (ScriptLoaderFileList::iterator slfli = scriptLoaderFileList.begin();
@@ -1002,18 +1575,10 @@ namespace Ogre {
                 {
                     LogManager::getSingleton().logMessage(
                         "Parsing script " + fii->filename);
-                    DataStreamPtr stream = fii->archive->open(fii->filename);
-                    if (stream)
+                    if (!preparation.parse(*fii, grp->name))
                     {
-                        if (mLoadingListener)
-                            mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
-
-                        if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
-                        {
-                            DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
-                            su->parseScript(cachedCopy, grp->name);
-                        }
-                        else
+                        DataStreamPtr stream = openScript(*fii, grp->name);
+                        if (stream)
                             su->parseScript(stream, grp->name);
                     }
                 }
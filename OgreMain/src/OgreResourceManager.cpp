@@ -32,7 +32,7 @@ namespace Ogre {
 
     //-----------------------------------------------------------------------
     ResourceManager::ResourceManager()
-        : mNextHandle(1), mMemoryUsage(0), mVerbose(true), mLoadOrder(0)
+        : mNextHandle(1), mMemoryUsage(0), mVerbose(true), mPrepareThreadSafe(false), mLoadOrder(0)
     {
         // Init memory limit & usage
         mMemoryBudget = std::numeric_limits<unsigned long>::max();
@@ -39,6 +39,8 @@ THE SOFTWARE.
 #include "OgrePlugin.h"
 #include "OgreShadowVolumeExtrudeProgram.h"
 #include "OgreResourceBackgroundQueue.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "OgreTaskScheduler.h"
 #include "OgreEntity.h"
 #include "OgreBillboardSet.h"
 #include "OgreBillboardChain.h"
@@ -96,7 +98,7 @@ namespace Ogre {
 
     //-----------------------------------------------------------------------
     Root::Root(const String& pluginFileName, const String& configFileName,
-        const String& logFileName)
+        const String& logFileName, WorkQueueType workQueueType)
       : mQueuedEnd(false)
       , mNextFrame(0)
       , mFrameSmoothingTime(0.0f)
@@ -141,7 +143,11 @@ namespace Ogre {
         mResourceGroupManager.reset(new ResourceGroupManager());
 
         // WorkQueue (note: users can replace this if they want)
-        DefaultWorkQueue* defaultQ = OGRE_NEW DefaultWorkQueue("Root");
+        DefaultWorkQueueBase* defaultQ;
+        if (workQueueType == WQT_WORK_STEALING)
+            defaultQ = OGRE_NEW WorkStealingWorkQueue("Root");
+        else
+            defaultQ = OGRE_NEW DefaultWorkQueue("Root");
         // never process responses in main thread for longer than 10ms by default
         defaultQ->setResponseProcessingTimeLimit(10);
         // match threads to hardware
@@ -153,6 +159,7 @@ namespace Ogre {
         // only allow workers to access rendersystem if threadsupport is 1
         defaultQ->setWorkersCanAccessRenderSystem(OGRE_THREAD_SUPPORT == 1);
         mWorkQueue.reset(defaultQ);
+        mTaskScheduler.reset(new TaskScheduler(defaultQ));
 
         // ResourceBackgroundQueue
         mResourceBackgroundQueue.reset(new ResourceBackgroundQueue());
@@ -740,8 +747,23 @@ namespace Ogre {
         return true;
     }
     //-----------------------------------------------------------------------
+    const RenderSystem::FrameStatistics& Root::getFrameStatistics() const
+    {
+        if (!mActiveRenderer)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                        "Cannot get frame statistics - no render system has been selected.",
+                        "Root::getFrameStatistics");
+        }
+        return mActiveRenderer->getFrameStatistics();
+    }
+    //-----------------------------------------------------------------------
     bool Root::_fireFrameEnded(FrameEvent& evt)
     {
+        // all rendering of this frame is done, so listeners see its statistics
+        if (mActiveRenderer)
+            mActiveRenderer->_finishFrameStatistics();
+
         _syncAddedRemovedFrameListeners();
 
         // Tell all listeners
@@ -1306,6 +1328,10 @@ namespace Ogre {
         for (it = getSceneManagers().begin(); it != end; ++it)
             it->second->_handleLodEvents();
 
+        // All targets told the streamed textures how large they are on screen
+        if (TextureManager* textureManager = TextureManager::getSingletonPtr())
+            textureManager->_updateStreaming();
+
         return ret;
     }
     //---------------------------------------------------------------------
@@ -1325,6 +1351,10 @@ namespace Ogre {
         for (it = getSceneManagers().begin(); it != end; ++it)
             it->second->_handleLodEvents();
 
+        // All targets told the streamed textures how large they are on screen
+        if (TextureManager* textureManager = TextureManager::getSingletonPtr())
+            textureManager->_updateStreaming();
+
         return ret;
     }
     //-----------------------------------------------------------------------
@@ -1494,6 +1524,8 @@ namespace Ogre {
     {
         if (mWorkQueue.get() != queue)
         {
+            // detach from the old queue before it's deleted
+            mTaskScheduler->setWorkQueue(queue);
             mWorkQueue.reset(queue);
             if (mIsInitialised)
                 mWorkQueue->startup();
@@ -51,13 +51,40 @@ THE SOFTWARE.
 #include "OgreRectangle2D.h"
 #include "OgreLodListener.h"
 #include "OgreUnifiedHighLevelGpuProgram.h"
+#include "OgreTimer.h"
 
 // This class implements the most basic scene manager
 
 #include <cstdio>
+#include <typeinfo>
 
 namespace Ogre {
 
+namespace
+{
+    /// Adds its lifetime in microseconds to a RenderSystem::FrameStatistics time
+    class ScopedFrameStatsTimer
+    {
+        Timer* mTimer;
+        unsigned long& mTime;
+        unsigned long mStart;
+    public:
+        ScopedFrameStatsTimer(unsigned long& time)
+            : mTimer(Root::getSingleton().getTimer()), mTime(time), mStart(mTimer->getMicroseconds())
+        {
+        }
+        ~ScopedFrameStatsTimer() { mTime += mTimer->getMicroseconds() - mStart; }
+    };
+
+    size_t getConstantsSize(const GpuProgramParametersSharedPtr& params)
+    {
+        return params->getFloatConstantList().size() * sizeof(float) +
+               params->getDoubleConstantList().size() * sizeof(double) +
+               params->getIntConstantList().size() * sizeof(int) +
+               params->getUnsignedIntConstantList().size() * sizeof(uint);
+    }
+}
+
 //-----------------------------------------------------------------------
 uint32 SceneManager::WORLD_GEOMETRY_TYPE_MASK   = 0x80000000;
 uint32 SceneManager::ENTITY_TYPE_MASK           = 0x40000000;
@@ -126,6 +153,11 @@ mShadowTextureCustomCasterPass(0),
 mShadowTextureCustomReceiverPass(0),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mParallelSceneGraphUpdate(false),
+mParallelCulling(false),
+mParallelAnimation(false),
+mParallelRenderQueueUpdate(false),
+mParallelThreadCount(0),
 mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
@@ -168,6 +200,7 @@ mGpuParamsDirty((uint16)GPV_ALL)
 SceneManager::~SceneManager()
 {
     fireSceneManagerDestroyed();
+
     destroyShadowTextures();
     clearScene();
     destroyAllCameras();
@@ -182,6 +215,9 @@ SceneManager::~SceneManager()
         }
         mMovableObjectCollectionMap.clear();
     }
+
+    for (size_t i = 0; i < mStagingRenderQueues.size(); ++i)
+        OGRE_DELETE mStagingRenderQueues[i];
 }
 //-----------------------------------------------------------------------
 RenderQueue* SceneManager::getRenderQueue(void)
@@ -947,6 +983,8 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
         pass = deriveShadowReceiverPass(pass);
     }
 
+    mDestRenderSystem->_getCurrentFrameStatistics().passChanges++;
+
     // Tell params about current pass
     mAutoParamDataSource->setCurrentPass(pass);
 
@@ -1391,6 +1429,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
     mCameraInProgress = camera;
 
+    RenderSystem::FrameStatistics& frameStats = mDestRenderSystem->_getCurrentFrameStatistics();
 
     // Update controllers 
     ControllerManager::getSingleton().updateAllControllers();
@@ -1412,6 +1451,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         // Update scene graph for this camera (can happen multiple times per frame)
         {
             OgreProfileGroup("_updateSceneGraph", OGREPROF_GENERAL);
+            ScopedFrameStatsTimer statsTimer(frameStats.updateSceneGraphTime);
             _updateSceneGraph(camera);
 
             // Auto-track nodes
@@ -1428,7 +1468,10 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
         if (mIlluminationStage != IRS_RENDER_TO_TEXTURE && mFindVisibleObjects)
         {
             // Locate any lights which could be affecting the frustum
-            findLightsAffectingFrustum(camera);
+            {
+                ScopedFrameStatsTimer statsTimer(frameStats.findLightsTime);
+                findLightsAffectingFrustum(camera);
+            }
 
             // Are we using any shadows at all?
             if (isShadowTechniqueInUse() && vp->getShadowsEnabled())
@@ -1438,6 +1481,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
                 if (isShadowTechniqueTextureBased())
                 {
                     OgreProfileGroup("prepareShadowTextures", OGREPROF_GENERAL);
+                    ScopedFrameStatsTimer statsTimer(frameStats.prepareShadowTexturesTime);
 
                     // *******
                     // WARNING
@@ -1498,9 +1542,16 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
             prepareRenderQueue();
         }
 
+        if (mFindVisibleObjects && mParallelAnimation && getEffectiveParallelThreadCount() > 1)
+        {
+            OgreProfileGroup("_updateEntityAnimations", OGREPROF_GENERAL);
+            _updateEntityAnimations(camera);
+        }
+
         if (mFindVisibleObjects)
         {
             OgreProfileGroup("_findVisibleObjects", OGREPROF_CULLING);
+            ScopedFrameStatsTimer statsTimer(frameStats.findVisibleObjectsTime);
 
             // Assemble an AAB on the fly which contains the scene elements visible
             // by the camera.
@@ -1561,6 +1612,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
     // Render scene content
     {
         OgreProfileGroup("_renderVisibleObjects", OGREPROF_RENDERING);
+        ScopedFrameStatsTimer statsTimer(frameStats.renderVisibleObjectsTime);
         _renderVisibleObjects();
     }
 
@@ -2277,14 +2329,518 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // In this implementation, just update from the root
     // Smarter SceneManager subclasses may choose to update only
     //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+    if (mParallelSceneGraphUpdate && supportsParallelSceneGraphUpdate() &&
+        getEffectiveParallelThreadCount() > 1)
+        updateSceneGraphParallel();
+    else
+        getRootSceneNode()->_update(true, false);
 
     firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+void SceneManager::ParallelJob::execute(size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+        executeItem(i);
+}
+//-----------------------------------------------------------------------
+size_t SceneManager::getEffectiveParallelThreadCount(void) const
+{
+#if OGRE_THREAD_SUPPORT
+    size_t count = mParallelThreadCount;
+    if (!count)
+        count = OGRE_THREAD_HARDWARE_CONCURRENCY;
+
+    Root* root = Root::getSingletonPtr();
+    if (!root)
+        return 1;
+
+    // no point in using more threads than the scheduler has
+    count = std::min(count, root->getTaskScheduler()->getThreadCount());
+
+    return std::max<size_t>(count, 1);
+#else
+    return 1;
+#endif
+}
+//-----------------------------------------------------------------------
+void SceneManager::runParallelJob(ParallelJob& job)
+{
+    size_t threads = getEffectiveParallelThreadCount();
+    if (threads > 1)
+        Root::getSingleton().getTaskScheduler()->parallelFor(0, job.getItemCount(), 1, job, threads);
+    else
+        job.execute(0, job.getItemCount());
+}
+//-----------------------------------------------------------------------
+/// Updates independent subtrees of the scene graph, see updateSceneGraphParallel
+class SceneManager::SceneGraphUpdateJob : public ParallelJob
+{
+public:
+    /// A node at the top of the graph, expanded on the calling thread or updated as a subtree
+    struct Item
+    {
+        Node* node;
+        bool parentHasChanged;
+        /// Range of the children in the item list, if the node was expanded
+        size_t firstChild, numChildren;
+        /// Deferred listener calls of the node, or of its whole subtree
+        Node::UpdatedNodeList calls;
+
+        Item(Node* n, bool changed)
+            : node(n), parentHasChanged(changed), firstChild(0), numChildren(0) {}
+    };
+    typedef vector<Item>::type ItemList;
+
+    SceneGraphUpdateJob(ItemList& items, const vector<size_t>::type& subtrees)
+        : ParallelJob(subtrees.size()), mItems(items), mSubtrees(subtrees)
+    {
+    }
+
+    /// Call the listeners of an item and its children in the same order as a serial update would
+    static void fireListeners(const ItemList& items, size_t index)
+    {
+        const Item& item = items[index];
+        for (Node::UpdatedNodeList::const_iterator it = item.calls.begin(); it != item.calls.end(); ++it)
+        {
+            if (it->second)
+            {
+                if (MovableObject::Listener* listener = it->second->getListener())
+                    listener->objectMoved(it->second);
+            }
+            else if (Node::Listener* listener = it->first->getListener())
+            {
+                listener->nodeUpdated(it->first);
+            }
+        }
+
+        for (size_t i = 0; i < item.numChildren; ++i)
+            fireListeners(items, item.firstChild + i);
+    }
+
+    /// Update the node of an item without its children, which are appended to the list
+    static void expand(ItemList& items, size_t index)
+    {
+        Node::PendingUpdateList children;
+        Node::_setDeferredListenerQueue(&items[index].calls);
+        try
+        {
+            items[index].node->_updateAndCollectChildren(items[index].parentHasChanged, children);
+        }
+        catch (...)
+        {
+            Node::_setDeferredListenerQueue(0);
+            throw;
+        }
+        Node::_setDeferredListenerQueue(0);
+
+        items[index].firstChild = items.size();
+        items[index].numChildren = children.size();
+        for (Node::PendingUpdateList::iterator it = children.begin(); it != children.end(); ++it)
+            items.push_back(Item(it->first, it->second));
+    }
+protected:
+    void executeItem(size_t index)
+    {
+        Item& item = mItems[mSubtrees[index]];
+        Node::_setDeferredListenerQueue(&item.calls);
+        try
+        {
+            item.node->_update(true, item.parentHasChanged);
+        }
+        catch (...)
+        {
+            Node::_setDeferredListenerQueue(0);
+            throw;
+        }
+        Node::_setDeferredListenerQueue(0);
+    }
+
+    ItemList& mItems;
+    const vector<size_t>::type& mSubtrees;
+};
+//-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphParallel(void)
+{
+    // Expand the top of the graph on this thread until there are enough
+    // independent subtrees to balance the load across the threads
+    const size_t targetSubtrees = getEffectiveParallelThreadCount() * 4;
+    const int maxExpandDepth = 4;
+    // Only nodes of the type this SceneManager creates are expanded. Other
+    // subclasses may override _update, so they are updated whole by the job.
+    const std::type_info& nodeType = typeid(*getRootSceneNode());
+
+    SceneGraphUpdateJob::ItemList items;
+    vector<size_t>::type subtrees, expanded;
+    items.push_back(SceneGraphUpdateJob::Item(getRootSceneNode(), false));
+    subtrees.push_back(0);
+
+    for (int depth = 0; depth < maxExpandDepth && subtrees.size() < targetSubtrees; ++depth)
+    {
+        vector<size_t>::type next;
+        size_t numExpanded = expanded.size();
+        for (vector<size_t>::type::iterator it = subtrees.begin(); it != subtrees.end(); ++it)
+        {
+            Node* node = items[*it].node;
+            if (node->numChildren() && typeid(*node) == nodeType)
+            {
+                SceneGraphUpdateJob::expand(items, *it);
+                for (size_t i = 0; i < items[*it].numChildren; ++i)
+                    next.push_back(items[*it].firstChild + i);
+                expanded.push_back(*it);
+            }
+            else
+            {
+                next.push_back(*it);
+            }
+        }
+        subtrees.swap(next);
+
+        if (numExpanded == expanded.size())
+            break;
+    }
+
+    SceneGraphUpdateJob job(items, subtrees);
+    runParallelJob(job);
+    SceneGraphUpdateJob::fireListeners(items, 0);
+
+    // bounds of the expanded nodes depend on their children, so go deepest first
+    for (vector<size_t>::type::reverse_iterator it = expanded.rbegin(); it != expanded.rend(); ++it)
+    {
+        static_cast<SceneNode*>(items[*it].node)->_updateBounds();
+    }
+}
+//-----------------------------------------------------------------------
+/// Culls independent subtrees of the scene graph, see findVisibleObjectsParallel
+class SceneManager::CullingJob : public ParallelJob
+{
+public:
+    /// How a visible entry was handled by the job
+    struct StagedEntry
+    {
+        /// whether the object was staged at all, otherwise it still has to be processed
+        bool staged;
+        RenderQueue::StagedObjectState state;
+        /// range of the staged renderables of the object in its staging queue
+        size_t begin, end;
+    };
+    typedef vector<StagedEntry>::type StagedEntryList;
+
+    /** @param stagingQueues at least one staging queue per subtree if the visible objects
+            should be queued by the job, otherwise NULL
+        @param queue the queue the staged objects are merged into
+        @param collectBounds whether to collect the visible bounds of the staged objects */
+    CullingJob(Camera* cam, bool displayNodes, bool onlyShadowCasters,
+               vector<SceneNode*>::type& subtrees, const RenderQueueList* stagingQueues,
+               const RenderQueue* queue, bool collectBounds)
+        : ParallelJob(subtrees.size()), mCamera(cam), mDisplayNodes(displayNodes),
+          mOnlyShadowCasters(onlyShadowCasters), mEntries(subtrees.size()),
+          mStagedEntries(stagingQueues ? subtrees.size() : 0), mStagingQueues(stagingQueues),
+          mQueue(queue), mBounds(stagingQueues && collectBounds ? subtrees.size() : 0)
+    {
+        mSubtrees.swap(subtrees);
+    }
+
+    const SceneNode::VisibleEntryList& getEntries(size_t index) const { return mEntries[index]; }
+    /// Parallel to getEntries, empty if the job does not queue the objects
+    const StagedEntryList& getStagedEntries(size_t index) const { return mStagedEntries[index]; }
+    RenderQueue* getStagingQueue(size_t index) const { return (*mStagingQueues)[index]; }
+
+    /// Merge the bounds of the staged objects of all subtrees, if the job collected them
+    void mergeBounds(VisibleObjectsBoundsInfo* visibleBounds) const
+    {
+        for (size_t i = 0; i < mBounds.size(); ++i)
+            visibleBounds->merge(mBounds[i]);
+    }
+protected:
+    void executeItem(size_t index)
+    {
+        SceneNode::VisibleEntryList& entries = mEntries[index];
+        mSubtrees[index]->_collectVisibleObjects(mCamera, entries, mDisplayNodes);
+
+        if (!mStagingQueues)
+            return;
+
+        RenderQueue* queue = getStagingQueue(index);
+        StagedEntryList& staged = mStagedEntries[index];
+        staged.resize(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            MovableObject* mo = entries[i].object;
+            staged[i].staged = mo && mo->_supportsParallelRenderQueueUpdate();
+            if (!staged[i].staged)
+                continue;
+
+            staged[i].begin = queue->_getStagedRenderables().size();
+            staged[i].state = queue->stageVisibleObject(mo, mCamera, mOnlyShadowCasters);
+            staged[i].end = queue->_getStagedRenderables().size();
+            if (!mBounds.empty())
+                mQueue->mergeStagedBounds(mo, staged[i].state, mCamera, &mBounds[index]);
+        }
+    }
+
+    Camera* mCamera;
+    bool mDisplayNodes;
+    bool mOnlyShadowCasters;
+    vector<SceneNode*>::type mSubtrees;
+    vector<SceneNode::VisibleEntryList>::type mEntries;
+    vector<StagedEntryList>::type mStagedEntries;
+    const RenderQueueList* mStagingQueues;
+    const RenderQueue* mQueue;
+    /// Visible bounds of the staged objects of each subtree
+    vector<VisibleObjectsBoundsInfo>::type mBounds;
+};
+//-----------------------------------------------------------------------
+/// Either an entry culled on the calling thread or the position of a subtree culled by the job
+struct CullingSlot
+{
+    SceneNode::VisibleEntry entry;
+    size_t subtree;
+};
+static const size_t CULLED_INLINE = ~static_cast<size_t>(0);
+//-----------------------------------------------------------------------
+static void splitForCulling(const Camera* cam, SceneNode* node, int depth,
+    vector<CullingSlot>::type& slots, vector<SceneNode*>::type& subtrees)
+{
+    CullingSlot slot;
+    if (!depth || !node->numChildren())
+    {
+        slot.subtree = subtrees.size();
+        slots.push_back(slot);
+        subtrees.push_back(node);
+        return;
+    }
+
+    if (!cam->isVisible(node->_getWorldAABB()))
+        return;
+
+    // same order as SceneNode::_findVisibleObjects
+    slot.subtree = CULLED_INLINE;
+    slot.entry.node = node;
+    const SceneNode::ObjectMap& objects = node->getAttachedObjects();
+    for (SceneNode::ObjectMap::const_iterator it = objects.begin(); it != objects.end(); ++it)
+    {
+        slot.entry.object = *it;
+        slots.push_back(slot);
+    }
+
+    const Node::ChildNodeMap& children = node->getChildren();
+    for (Node::ChildNodeMap::const_iterator it = children.begin(); it != children.end(); ++it)
+    {
+        splitForCulling(cam, static_cast<SceneNode*>(*it), depth - 1, slots, subtrees);
+    }
+
+    // _addDebugRenderablesToQueue checks whether there is anything to show
+    slot.entry.object = 0;
+    slots.push_back(slot);
+}
+//-----------------------------------------------------------------------
+void SceneManager::findVisibleObjectsParallel(
+    Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+    // bring the frustum planes up to date, the workers only read them
+    cam->isVisible(AxisAlignedBox(Vector3::ZERO, Vector3::ZERO));
+
+    // find how deep the graph has to be split to balance the load across the threads
+    const size_t targetSubtrees = getEffectiveParallelThreadCount() * 4;
+    const int maxSplitDepth = 4;
+
+    int splitDepth = 0;
+    Node::ChildNodeMap level(1, getRootSceneNode());
+    while (splitDepth < maxSplitDepth && level.size() < targetSubtrees)
+    {
+        Node::ChildNodeMap next;
+        for (Node::ChildNodeMap::iterator it = level.begin(); it != level.end(); ++it)
+        {
+            next.insert(next.end(), (*it)->getChildren().begin(), (*it)->getChildren().end());
+        }
+        if (next.empty())
+            break;
+        level.swap(next);
+        ++splitDepth;
+    }
+
+    vector<CullingSlot>::type slots;
+    vector<SceneNode*>::type subtrees;
+    splitForCulling(cam, getRootSceneNode(), splitDepth, slots, subtrees);
+
+    RenderQueue* queue = getRenderQueue();
+
+    // LodListeners are called when the objects are notified of the camera
+    const RenderQueueList* stagingQueues = 0;
+    if (mParallelRenderQueueUpdate && mLodListeners.empty())
+    {
+        while (mStagingRenderQueues.size() < subtrees.size())
+            mStagingRenderQueues.push_back(OGRE_NEW RenderQueue());
+
+        for (size_t i = 0; i < subtrees.size(); ++i)
+        {
+            RenderQueue* staging = mStagingRenderQueues[i];
+            staging->_setStaging(true);
+            staging->setDefaultQueueGroup(queue->getDefaultQueueGroup());
+            staging->setDefaultRenderablePriority(queue->getDefaultRenderablePriority());
+        }
+        stagingQueues = &mStagingRenderQueues;
+
+        // the objects query the LOD camera as well
+        cam->getLodCamera()->isVisible(AxisAlignedBox(Vector3::ZERO, Vector3::ZERO));
+    }
+
+    // the bounds are merged on the threads too, the distances need the view matrix
+    cam->getViewMatrix(true);
+    CullingJob job(cam, mDisplayNodes, onlyShadowCasters, subtrees, stagingQueues, queue,
+                   visibleBounds != 0);
+    runParallelJob(job);
+
+    // everything the job did not do touches shared state, so that stays serial
+    for (vector<CullingSlot>::type::iterator slot = slots.begin(); slot != slots.end(); ++slot)
+    {
+        const SceneNode::VisibleEntry* entry = &slot->entry;
+        const SceneNode::VisibleEntry* end = entry + 1;
+        const CullingJob::StagedEntry* staged = 0;
+        RenderQueue* staging = 0;
+        if (slot->subtree != CULLED_INLINE)
+        {
+            const SceneNode::VisibleEntryList& entries = job.getEntries(slot->subtree);
+            if (entries.empty())
+                continue;
+            entry = &entries.front();
+            end = entry + entries.size();
+            if (stagingQueues)
+            {
+                staged = &job.getStagedEntries(slot->subtree).front();
+                staging = job.getStagingQueue(slot->subtree);
+            }
+        }
+
+        for (; entry != end; ++entry)
+        {
+            if (staged && staged->staged)
+            {
+                const RenderQueue::StagedRenderable* renderables =
+                    staging->_getStagedRenderables().empty() ? 0 : &staging->_getStagedRenderables().front();
+                // the job merged the bounds already
+                queue->mergeStagedObject(entry->object, staged->state, renderables + staged->begin,
+                    renderables + staged->end, cam, onlyShadowCasters, 0);
+            }
+            else if (entry->object)
+                queue->processVisibleObject(entry->object, cam, onlyShadowCasters, visibleBounds);
+            else
+                entry->node->_addDebugRenderablesToQueue(queue, mDisplayNodes);
+
+            if (staged)
+                ++staged;
+        }
+    }
+
+    // all merges are minima and maxima, so the order does not matter
+    if (visibleBounds)
+        job.mergeBounds(visibleBounds);
+}
+//-----------------------------------------------------------------------
+/// Updates groups of entities sharing a skeleton instance, see _updateEntityAnimations
+class SceneManager::AnimationJob : public ParallelJob
+{
+public:
+    AnimationJob(const vector<Entity*>::type& entities, const vector<size_t>::type& groupStarts)
+        : ParallelJob(groupStarts.size() - 1), mEntities(entities), mGroupStarts(groupStarts)
+    {
+    }
+
+protected:
+    void executeItem(size_t index)
+    {
+        for (size_t i = mGroupStarts[index]; i < mGroupStarts[index + 1]; ++i)
+            mEntities[i]->_executeAnimationUpdate();
+    }
+
+private:
+    const vector<Entity*>::type& mEntities;
+    const vector<size_t>::type& mGroupStarts;
+};
+//-----------------------------------------------------------------------
+namespace
+{
+    /// Orders entities by the skeleton instance they share, if any
+    struct SkeletonGroupLess
+    {
+        static const void* key(Entity* ent)
+        {
+            return ent->sharesSkeletonInstance() ?
+                static_cast<const void*>(ent->getSkeleton()) : static_cast<const void*>(ent);
+        }
+        bool operator()(Entity* a, Entity* b) const { return key(a) < key(b); }
+    };
+}
+//-----------------------------------------------------------------------
+void SceneManager::_updateEntityAnimations(Camera* cam)
+{
+    MovableObjectCollectionMap::iterator ci =
+        mMovableObjectCollectionMap.find(EntityFactory::FACTORY_TYPE_NAME);
+    if (ci == mMovableObjectCollectionMap.end())
+        return;
+
+    uint32 visibilityMask = _getCombinedVisibilityMask();
+
+    // collect the animated entities in name order
+    vector<Entity*>::type animated;
+    MovableObjectMap& entities = ci->second->map;
+    for (MovableObjectMap::iterator i = entities.begin(); i != entities.end(); ++i)
+    {
+        Entity* ent = static_cast<Entity*>(i->second);
+        if (!ent->hasSkeleton() && !ent->hasVertexAnimation())
+            continue;
+        // objects on bones are only moved by the update of their parent entity,
+        // and a manual LOD level is animated by an entity of its own
+        if (ent->isParentTagPoint() || !ent->isInScene() || !ent->isVisible() ||
+            !(ent->getVisibilityFlags() & visibilityMask) ||
+            (ent->getCurrentLodIndex() > 0 && ent->getMesh()->hasManualLodLevel()))
+            continue;
+        if (!cam->isVisible(ent->getWorldBoundingBox(true)))
+            continue;
+        animated.push_back(ent);
+    }
+
+    // locking buffers and applying vertex animation has to be done on this thread
+    HardwareBufferLockSet locks;
+    vector<Entity*>::type pending;
+    for (vector<Entity*>::type::iterator i = animated.begin(); i != animated.end(); ++i)
+    {
+        if ((*i)->_prepareAnimationUpdate(locks))
+            pending.push_back(*i);
+    }
+
+    if (!pending.empty())
+    {
+        // entities sharing a skeleton instance are updated by one thread, in name order
+        std::stable_sort(pending.begin(), pending.end(), SkeletonGroupLess());
+        vector<size_t>::type groupStarts;
+        for (size_t i = 0; i < pending.size(); ++i)
+        {
+            if (i == 0 || SkeletonGroupLess::key(pending[i - 1]) != SkeletonGroupLess::key(pending[i]))
+                groupStarts.push_back(i);
+        }
+        groupStarts.push_back(pending.size());
+
+        AnimationJob job(pending, groupStarts);
+        runParallelJob(job);
+    }
+
+    locks.unlockAll();
+
+    for (vector<Entity*>::type::iterator i = animated.begin(); i != animated.end(); ++i)
+        (*i)->_finishAnimationUpdate();
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
     Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    if (mParallelCulling && getEffectiveParallelThreadCount() > 1)
+    {
+        findVisibleObjectsParallel(cam, visibleBounds, onlyShadowCasters);
+        return;
+    }
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
@@ -7183,34 +7739,41 @@ void SceneManager::updateGpuProgramParameters(const Pass* pass)
         if (mGpuParamsDirty)
             pass->_updateAutoParams(mAutoParamDataSource.get(), mGpuParamsDirty);
 
+        size_t& constantBytes = mDestRenderSystem->_getCurrentFrameStatistics().constantBytesUploaded;
+
         if (pass->hasVertexProgram())
         {
             mDestRenderSystem->bindGpuProgramParameters(GPT_VERTEX_PROGRAM, 
                 pass->getVertexProgramParameters(), mGpuParamsDirty);
+            constantBytes += getConstantsSize(pass->getVertexProgramParameters());
         }
 
         if (pass->hasGeometryProgram())
         {
             mDestRenderSystem->bindGpuProgramParameters(GPT_GEOMETRY_PROGRAM,
                 pass->getGeometryProgramParameters(), mGpuParamsDirty);
+            constantBytes += getConstantsSize(pass->getGeometryProgramParameters());
         }
 
         if (pass->hasFragmentProgram())
         {
             mDestRenderSystem->bindGpuProgramParameters(GPT_FRAGMENT_PROGRAM, 
                 pass->getFragmentProgramParameters(), mGpuParamsDirty);
+            constantBytes += getConstantsSize(pass->getFragmentProgramParameters());
         }
 
         if (pass->hasTessellationHullProgram())
         {
             mDestRenderSystem->bindGpuProgramParameters(GPT_HULL_PROGRAM, 
                 pass->getTessellationHullProgramParameters(), mGpuParamsDirty);
+            constantBytes += getConstantsSize(pass->getTessellationHullProgramParameters());
         }
 
         if (pass->hasTessellationDomainProgram())
         {
             mDestRenderSystem->bindGpuProgramParameters(GPT_DOMAIN_PROGRAM, 
                 pass->getTessellationDomainProgramParameters(), mGpuParamsDirty);
+            constantBytes += getConstantsSize(pass->getTessellationDomainProgramParameters());
         }
 
                 // if (pass->hasComputeProgram())
@@ -7282,6 +7845,16 @@ void VisibleObjectsBoundsInfo::mergeNonRenderedButInFrustum(const AxisAlignedBox
     maxDistanceInFrustum = std::max(maxDistanceInFrustum, camDistToCenter + sphereBounds.getRadius());
 
 }
+//---------------------------------------------------------------------
+void VisibleObjectsBoundsInfo::merge(const VisibleObjectsBoundsInfo& other)
+{
+    aabb.merge(other.aabb);
+    receiverAabb.merge(other.receiverAabb);
+    minDistance = std::min(minDistance, other.minDistance);
+    maxDistance = std::max(maxDistance, other.maxDistance);
+    minDistanceInFrustum = std::min(minDistanceInFrustum, other.minDistanceInFrustum);
+    maxDistanceInFrustum = std::max(maxDistanceInFrustum, other.maxDistanceInFrustum);
+}
 
 
 
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 
 namespace Ogre {
+    /// Number of child bounds tested with one call to Camera::areVisible
+    static const size_t CULL_BATCH_SIZE = 64;
     //-----------------------------------------------------------------------
     SceneNode::SceneNode(SceneManager* creator) : SceneNode(creator, BLANKSTRING)
     {
@@ -263,6 +265,14 @@ namespace Ogre {
         if (!cam->isVisible(mWorldAABB))
             return;
 
+        findVisibleObjectsImpl(cam, queue, visibleBounds, includeChildren, displayNodes,
+            onlyShadowCasters);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::findVisibleObjectsImpl(Camera* cam, RenderQueue* queue,
+        VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren,
+        bool displayNodes, bool onlyShadowCasters)
+    {
         // Add all entities
         ObjectMap::iterator iobj;
         ObjectMap::iterator iobjend = mObjectsByName.end();
@@ -275,16 +285,81 @@ namespace Ogre {
 
         if (includeChildren)
         {
-            ChildNodeMap::iterator child, childend;
-            childend = mChildren.end();
-            for (child = mChildren.begin(); child != childend; ++child)
+            // Cull the children a batch at a time, which is faster than one by one
+            const AxisAlignedBox* bounds[CULL_BATCH_SIZE];
+            char visibilities[CULL_BATCH_SIZE];
+            for (size_t start = 0; start < mChildren.size(); start += CULL_BATCH_SIZE)
             {
-                SceneNode* sceneChild = static_cast<SceneNode*>(*child);
-                sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
-                    displayNodes, onlyShadowCasters);
+                size_t count = std::min(CULL_BATCH_SIZE, mChildren.size() - start);
+                for (size_t i = 0; i < count; ++i)
+                    bounds[i] = &static_cast<SceneNode*>(mChildren[start + i])->mWorldAABB;
+                cam->areVisible(bounds, count, visibilities);
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (visibilities[i])
+                    {
+                        SceneNode* sceneChild = static_cast<SceneNode*>(mChildren[start + i]);
+                        sceneChild->findVisibleObjectsImpl(cam, queue, visibleBounds,
+                            includeChildren, displayNodes, onlyShadowCasters);
+                    }
+                }
+            }
+        }
+
+        _addDebugRenderablesToQueue(queue, displayNodes);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_collectVisibleObjects(const Camera* cam, VisibleEntryList& entries,
+        bool displayNodes) const
+    {
+        if (!cam->isVisible(mWorldAABB))
+            return;
+
+        collectVisibleObjectsImpl(cam, entries, displayNodes);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::collectVisibleObjectsImpl(const Camera* cam, VisibleEntryList& entries,
+        bool displayNodes) const
+    {
+        VisibleEntry entry;
+        entry.node = const_cast<SceneNode*>(this);
+        for (ObjectMap::const_iterator i = mObjectsByName.begin(); i != mObjectsByName.end(); ++i)
+        {
+            entry.object = *i;
+            entries.push_back(entry);
+        }
+
+        // Same batching as findVisibleObjectsImpl
+        const AxisAlignedBox* bounds[CULL_BATCH_SIZE];
+        char visibilities[CULL_BATCH_SIZE];
+        for (size_t start = 0; start < mChildren.size(); start += CULL_BATCH_SIZE)
+        {
+            size_t count = std::min(CULL_BATCH_SIZE, mChildren.size() - start);
+            for (size_t i = 0; i < count; ++i)
+                bounds[i] = &static_cast<SceneNode*>(mChildren[start + i])->mWorldAABB;
+            cam->areVisible(bounds, count, visibilities);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (visibilities[i])
+                {
+                    static_cast<SceneNode*>(mChildren[start + i])->collectVisibleObjectsImpl(
+                        cam, entries, displayNodes);
+                }
             }
         }
 
+        if (displayNodes || (!mHideBoundingBox &&
+             (mShowBoundingBox || (mCreator && mCreator->getShowBoundingBoxes()))))
+        {
+            entry.object = 0;
+            entries.push_back(entry);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_addDebugRenderablesToQueue(RenderQueue* queue, bool displayNodes)
+    {
         if (displayNodes)
         {
             // Include self in the render queue
@@ -298,8 +373,6 @@ namespace Ogre {
         { 
             _addBoundingBoxToQueue(queue);
         }
-
-
     }
 
     Node::DebugRenderable* SceneNode::getDebugRenderable()
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreScriptParser.h"
 #include "OgreScriptTranslator.h"
+#include "OgreStreamSerialiser.h"
 
 namespace Ogre
 {
@@ -272,7 +273,7 @@ namespace Ogre
     }
 
     ScriptCompiler::ScriptCompiler()
-        :mListener(0)
+        :mCustomWordIdHash(0), mListener(0)
     {
         initWordMap();
     }
@@ -336,6 +337,29 @@ namespace Ogre
 //  }
 
     bool ScriptCompiler::compile(const ConcreteNodeListPtr &nodes, const String &group)
+    {
+        AbstractNodeListPtr ast = _generateProcessedAST(nodes, group);
+
+        // Allows early bail-out through the listener
+        if(mListener && !mListener->postConversion(this, ast))
+            return mErrors.empty();
+        
+        // Translate the nodes
+        for(AbstractNodeList::iterator i = ast->begin(); i != ast->end(); ++i)
+        {
+            //logAST(0, *i);
+            if((*i)->type == ANT_OBJECT && static_cast<ObjectAbstractNode*>((*i).get())->abstract)
+                continue;
+            //LogManager::getSingleton().logMessage(static_cast<ObjectAbstractNode*>((*i).get())->name);
+            ScriptTranslator *translator = ScriptCompilerManager::getSingleton().getTranslator(*i);
+            if(translator)
+                translator->translate(this, *i);
+        }
+
+        return mErrors.empty();
+    }
+
+    AbstractNodeListPtr ScriptCompiler::_generateProcessedAST(const ConcreteNodeListPtr &nodes, const String &group, StringVector *importedScripts)
     {
         // Set up the compilation context
         mGroup = group;
@@ -358,27 +382,19 @@ namespace Ogre
         // Process variable expansion
         processVariables(ast.get());
 
-        // Allows early bail-out through the listener
-        if(mListener && !mListener->postConversion(this, ast))
-            return mErrors.empty();
-        
-        // Translate the nodes
-        for(AbstractNodeList::iterator i = ast->begin(); i != ast->end(); ++i)
+        // Every requested script, including nested and missing ones
+        if(importedScripts)
         {
-            //logAST(0, *i);
-            if((*i)->type == ANT_OBJECT && static_cast<ObjectAbstractNode*>((*i).get())->abstract)
-                continue;
-            //LogManager::getSingleton().logMessage(static_cast<ObjectAbstractNode*>((*i).get())->name);
-            ScriptTranslator *translator = ScriptCompilerManager::getSingleton().getTranslator(*i);
-            if(translator)
-                translator->translate(this, *i);
+            for(ImportRequestMap::iterator i = mImportRequests.begin(); i != mImportRequests.end();
+                i = mImportRequests.upper_bound(i->first))
+                importedScripts->push_back(i->first);
         }
 
         mImports.clear();
         mImportRequests.clear();
         mImportTable.clear();
 
-        return mErrors.empty();
+        return ast;
     }
 
     AbstractNodeListPtr ScriptCompiler::_generateAST(const String &str, const String &source, bool doImports, bool doObjects, bool doVariables)
@@ -594,7 +610,7 @@ namespace Ogre
                 return retval;
             }
 
-            nodes = ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), name));
+            nodes = ScriptParser::parse(ScriptLexer::tokenize(stream, name));
         }
 
         if(nodes)
@@ -1289,6 +1305,7 @@ namespace Ogre
 		// wasn't used yet.
 		mLargestRegisteredWordId++;
 		mIds[word] = mLargestRegisteredWordId;
+		mCustomWordIdHash = FastHash(word.c_str(), word.size(), mCustomWordIdHash);
 		return mLargestRegisteredWordId;
     }
 
@@ -1562,6 +1579,247 @@ namespace Ogre
     }
     
 
+    namespace {
+        const uint32 COMPILEDSCRIPTCACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("SCAC");
+        const uint16 COMPILEDSCRIPTCACHE_CHUNK_VERSION = 1;
+
+        std::pair<uint64, uint64> hashScript(const char *data, size_t size)
+        {
+            uint64 hash[2];
+            MurmurHash3_128(data, size, 0, hash);
+            return std::make_pair(hash[0], hash[1]);
+        }
+
+        /** Serialises processed abstract syntax trees into a compact binary form.
+            File names are stored once in a table in front of the nodes.
+        */
+        class AbstractNodeWriter
+        {
+        public:
+            void writeList(const AbstractNodeList &nodes)
+            {
+                writeU32(static_cast<uint32>(nodes.size()));
+                for(AbstractNodeList::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+                    writeNode(i->get());
+            }
+
+            void getResult(vector<uchar>::type &out)
+            {
+                vector<uchar>::type nodes;
+                nodes.swap(mOut);
+                writeU32(static_cast<uint32>(mFiles.size()));
+                for(StringVector::const_iterator i = mFiles.begin(); i != mFiles.end(); ++i)
+                    writeString(*i);
+                mOut.insert(mOut.end(), nodes.begin(), nodes.end());
+                out.swap(mOut);
+            }
+        private:
+            vector<uchar>::type mOut;
+            StringVector mFiles;
+            map<String, uint32>::type mFileIds;
+
+            void writeU32(uint32 value)
+            {
+                const uchar *bytes = reinterpret_cast<const uchar*>(&value);
+                mOut.insert(mOut.end(), bytes, bytes + sizeof(uint32));
+            }
+
+            void writeString(const String &str)
+            {
+                writeU32(static_cast<uint32>(str.size()));
+                mOut.insert(mOut.end(), str.begin(), str.end());
+            }
+
+            void writeNode(const AbstractNode *node)
+            {
+                map<String, uint32>::type::iterator file = mFileIds.find(node->file);
+                if(file == mFileIds.end())
+                {
+                    file = mFileIds.insert(std::make_pair(node->file, static_cast<uint32>(mFiles.size()))).first;
+                    mFiles.push_back(node->file);
+                }
+
+                writeU32(node->type);
+                writeU32(file->second);
+                writeU32(node->line);
+
+                switch(node->type)
+                {
+                case ANT_ATOM:
+                    {
+                        const AtomAbstractNode *atom = static_cast<const AtomAbstractNode*>(node);
+                        writeString(atom->value);
+                        writeU32(atom->id);
+                    }
+                    break;
+                case ANT_OBJECT:
+                    {
+                        const ObjectAbstractNode *obj = static_cast<const ObjectAbstractNode*>(node);
+                        writeString(obj->name);
+                        writeString(obj->cls);
+                        writeU32(static_cast<uint32>(obj->bases.size()));
+                        for(StringVector::const_iterator i = obj->bases.begin(); i != obj->bases.end(); ++i)
+                            writeString(*i);
+                        writeU32(obj->id);
+                        writeU32(obj->abstract);
+                        const map<String,String>::type &vars = obj->getVariables();
+                        writeU32(static_cast<uint32>(vars.size()));
+                        for(map<String,String>::type::const_iterator i = vars.begin(); i != vars.end(); ++i)
+                        {
+                            writeString(i->first);
+                            writeString(i->second);
+                        }
+                        // overrides were merged into the children by processObjects
+                        writeList(obj->children);
+                        writeList(obj->values);
+                    }
+                    break;
+                case ANT_PROPERTY:
+                    {
+                        const PropertyAbstractNode *prop = static_cast<const PropertyAbstractNode*>(node);
+                        writeString(prop->name);
+                        writeU32(prop->id);
+                        writeList(prop->values);
+                    }
+                    break;
+                case ANT_IMPORT:
+                    {
+                        const ImportAbstractNode *import = static_cast<const ImportAbstractNode*>(node);
+                        writeString(import->target);
+                        writeString(import->source);
+                    }
+                    break;
+                case ANT_VARIABLE_ACCESS:
+                    writeString(static_cast<const VariableAccessAbstractNode*>(node)->name);
+                    break;
+                default:
+                    break;
+                }
+            }
+        };
+
+        /// Reads the trees written by AbstractNodeWriter
+        class AbstractNodeReader
+        {
+        public:
+            AbstractNodeReader(const vector<uchar>::type &data)
+                : mPos(data.empty() ? 0 : &data[0]), mEnd(mPos + data.size())
+            {
+                uint32 numFiles = readU32();
+                for(uint32 i = 0; i < numFiles; ++i)
+                    mFiles.push_back(readString());
+            }
+
+            void readList(AbstractNodeList &nodes, AbstractNode *parent)
+            {
+                uint32 count = readU32();
+                for(uint32 i = 0; i < count; ++i)
+                    nodes.push_back(readNode(parent));
+            }
+        private:
+            const uchar *mPos, *mEnd;
+            StringVector mFiles;
+
+            void check(size_t size)
+            {
+                if(size > static_cast<size_t>(mEnd - mPos))
+                    OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Corrupt compiled script",
+                        "ScriptCompilerManager::getCompiledScript");
+            }
+
+            uint32 readU32()
+            {
+                uint32 value;
+                check(sizeof(uint32));
+                memcpy(&value, mPos, sizeof(uint32));
+                mPos += sizeof(uint32);
+                return value;
+            }
+
+            String readString()
+            {
+                uint32 size = readU32();
+                check(size);
+                String str(reinterpret_cast<const char*>(mPos), size);
+                mPos += size;
+                return str;
+            }
+
+            AbstractNodePtr readNode(AbstractNode *parent)
+            {
+                uint32 type = readU32();
+                uint32 file = readU32();
+                uint32 line = readU32();
+                if(file >= mFiles.size())
+                    check(size_t(-1));
+
+                AbstractNodePtr node;
+                switch(type)
+                {
+                case ANT_ATOM:
+                    {
+                        AtomAbstractNode *atom = OGRE_NEW AtomAbstractNode(parent);
+                        node.reset(atom);
+                        atom->value = readString();
+                        atom->id = readU32();
+                    }
+                    break;
+                case ANT_OBJECT:
+                    {
+                        ObjectAbstractNode *obj = OGRE_NEW ObjectAbstractNode(parent);
+                        node.reset(obj);
+                        obj->name = readString();
+                        obj->cls = readString();
+                        uint32 numBases = readU32();
+                        for(uint32 i = 0; i < numBases; ++i)
+                            obj->bases.push_back(readString());
+                        obj->id = readU32();
+                        obj->abstract = readU32() != 0;
+                        uint32 numVars = readU32();
+                        for(uint32 i = 0; i < numVars; ++i)
+                        {
+                            String name = readString();
+                            obj->setVariable(name, readString());
+                        }
+                        readList(obj->children, obj);
+                        readList(obj->values, obj);
+                    }
+                    break;
+                case ANT_PROPERTY:
+                    {
+                        PropertyAbstractNode *prop = OGRE_NEW PropertyAbstractNode(parent);
+                        node.reset(prop);
+                        prop->name = readString();
+                        prop->id = readU32();
+                        readList(prop->values, prop);
+                    }
+                    break;
+                case ANT_IMPORT:
+                    {
+                        ImportAbstractNode *import = OGRE_NEW ImportAbstractNode();
+                        node.reset(import);
+                        import->target = readString();
+                        import->source = readString();
+                    }
+                    break;
+                case ANT_VARIABLE_ACCESS:
+                    {
+                        VariableAccessAbstractNode *var = OGRE_NEW VariableAccessAbstractNode(parent);
+                        node.reset(var);
+                        var->name = readString();
+                    }
+                    break;
+                default:
+                    check(size_t(-1));
+                }
+
+                node->file = mFiles[file];
+                node->line = line;
+                return node;
+            }
+        };
+    }
+
     // ScriptCompilerManager
     template<> ScriptCompilerManager *Singleton<ScriptCompilerManager>::msSingleton = 0;
     
@@ -1575,8 +1833,30 @@ namespace Ogre
         assert( msSingleton );  return ( *msSingleton );  
     }
     //-----------------------------------------------------------------------
+    class ScriptCompilerManager::ImportHashListener : public ResourceGroupListener
+    {
+    public:
+        explicit ImportHashListener(ScriptCompilerManager *manager) : mManager(manager) {}
+
+        void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount)
+        {
+            OGRE_WQ_LOCK_MUTEX(mManager->mCompiledScriptMutex);
+            mManager->mImportHashes[groupName].clear();
+        }
+
+        void resourceGroupScriptingEnded(const String& groupName)
+        {
+            // imported scripts may change before the group is parsed again
+            OGRE_WQ_LOCK_MUTEX(mManager->mCompiledScriptMutex);
+            mManager->mImportHashes.erase(groupName);
+        }
+    private:
+        ScriptCompilerManager *mManager;
+    };
+    //-----------------------------------------------------------------------
     ScriptCompilerManager::ScriptCompilerManager()
-        :mListener(0), OGRE_THREAD_POINTER_INIT(mScriptCompiler)
+        :mListener(0), OGRE_THREAD_POINTER_INIT(mScriptCompiler),
+        mUseCompiledScriptCache(false), mCompiledScriptCacheDirty(false)
     {
             OGRE_LOCK_AUTO_MUTEX;
         mScriptPatterns.push_back("*.program");
@@ -1585,6 +1865,8 @@ namespace Ogre
         mScriptPatterns.push_back("*.compositor");
         mScriptPatterns.push_back("*.os");
         ResourceGroupManager::getSingleton()._registerScriptLoader(this);
+        mImportHashListener = OGRE_NEW_T(ImportHashListener, MEMCATEGORY_GENERAL)(this);
+        ResourceGroupManager::getSingleton().addResourceGroupListener(mImportHashListener);
 
         OGRE_THREAD_POINTER_SET(mScriptCompiler, OGRE_NEW ScriptCompiler());
 
@@ -1594,7 +1876,13 @@ namespace Ogre
     //-----------------------------------------------------------------------
     ScriptCompilerManager::~ScriptCompilerManager()
     {
+        // Root destroys the ResourceGroupManager first
+        if(ResourceGroupManager::getSingletonPtr())
+            ResourceGroupManager::getSingleton().removeResourceGroupListener(mImportHashListener);
+        OGRE_DELETE_T(mImportHashListener, ImportHashListener, MEMCATEGORY_GENERAL);
         OGRE_THREAD_POINTER_DELETE(mScriptCompiler);
+        for(size_t i = 0; i < mCompilerPool.size(); ++i)
+            OGRE_DELETE mCompilerPool[i];
         OGRE_DELETE mBuiltinTranslatorManager;
     }
     //-----------------------------------------------------------------------
@@ -1653,9 +1941,26 @@ namespace Ogre
 	//-----------------------------------------------------------------------
 	uint32 ScriptCompilerManager::registerCustomWordId(const String &word)
 	{
+        {
+            OGRE_WQ_LOCK_MUTEX(mCompilerPoolMutex);
+            if(std::find(mCustomWords.begin(), mCustomWords.end(), word) == mCustomWords.end())
+                mCustomWords.push_back(word);
+            // pooled compilers do not know the new word yet
+            for(size_t i = 0; i < mCompilerPool.size(); ++i)
+                OGRE_DELETE mCompilerPool[i];
+            mCompilerPool.clear();
+        }
 		return OGRE_THREAD_POINTER_GET(mScriptCompiler)->registerCustomWordId(word);
     }
     //-----------------------------------------------------------------------
+    ScriptCompiler* ScriptCompilerManager::createCompiler()
+    {
+        ScriptCompiler* compiler = OGRE_NEW ScriptCompiler();
+        for(StringVector::iterator i = mCustomWords.begin(); i != mCustomWords.end(); ++i)
+            compiler->registerCustomWordId(*i);
+        return compiler;
+    }
+    //-----------------------------------------------------------------------
     void ScriptCompilerManager::addScriptPattern(const String &pattern)
     {
         mScriptPatterns.push_back(pattern);
@@ -1680,15 +1985,322 @@ namespace Ogre
         {
             // create a new instance for this thread - will get deleted when
             // the thread dies
-            OGRE_THREAD_POINTER_SET(mScriptCompiler, OGRE_NEW ScriptCompiler());
+            OGRE_WQ_LOCK_MUTEX(mCompilerPoolMutex);
+            OGRE_THREAD_POINTER_SET(mScriptCompiler, createCompiler());
         }
 #endif
+        ScriptCompiler *compiler = OGRE_THREAD_POINTER_GET(mScriptCompiler);
+        bool hasListener;
         // Set the listener on the compiler before we continue
         {
                     OGRE_LOCK_AUTO_MUTEX;
-            OGRE_THREAD_POINTER_GET(mScriptCompiler)->setListener(mListener);
+            compiler->setListener(mListener);
+            hasListener = mListener != 0;
+        }
+
+        if(hasListener)
+        {
+            // tokenize memory (mapped) streams in place instead of copying them to a string
+            ConcreteNodeListPtr nodes = ScriptParser::parse(ScriptLexer::tokenize(stream, stream->getName()));
+            compiler->compile(nodes, groupName);
+            return;
+        }
+
+        AbstractNodeListPtr ast = generateScriptAST(stream, groupName, compiler);
+        compiler->_compile(ast, groupName, false, false, false);
+    }
+    //-----------------------------------------------------------------------
+    bool ScriptCompilerManager::isPrepareScriptThreadSafe(void) const
+    {
+            OGRE_LOCK_AUTO_MUTEX;
+        return !mListener;
+    }
+    //-----------------------------------------------------------------------
+    Any ScriptCompilerManager::prepareScript(DataStreamPtr& stream, const String& groupName)
+    {
+        ScriptCompiler *compiler;
+        {
+            OGRE_WQ_LOCK_MUTEX(mCompilerPoolMutex);
+            if(mCompilerPool.empty())
+            {
+                compiler = createCompiler();
+            }
+            else
+            {
+                compiler = mCompilerPool.back();
+                mCompilerPool.pop_back();
+            }
+        }
+
+        AbstractNodeListPtr ast;
+        try
+        {
+            ast = generateScriptAST(stream, groupName, compiler);
+        }
+        catch (...)
+        {
+            OGRE_DELETE compiler;
+            throw;
+        }
+
+        OGRE_WQ_LOCK_MUTEX(mCompilerPoolMutex);
+        mCompilerPool.push_back(compiler);
+        return Any(ast);
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::parsePreparedScript(const Any& prepared, const String& groupName)
+    {
+        ScriptCompiler *compiler = OGRE_THREAD_POINTER_GET(mScriptCompiler);
+        {
+                    OGRE_LOCK_AUTO_MUTEX;
+            compiler->setListener(mListener);
+        }
+        compiler->_compile(any_cast<AbstractNodeListPtr>(prepared), groupName, false, false, false);
+    }
+    //-----------------------------------------------------------------------
+    AbstractNodeListPtr ScriptCompilerManager::generateScriptAST(DataStreamPtr& stream, const String& groupName,
+        ScriptCompiler *compiler)
+    {
+        if(!mUseCompiledScriptCache)
+        {
+            // tokenize memory (mapped) streams in place instead of copying them to a string
+            ConcreteNodeListPtr nodes = ScriptParser::parse(ScriptLexer::tokenize(stream, stream->getName()));
+            return compiler->_generateProcessedAST(nodes, groupName);
+        }
+
+        // the cache is keyed by the script contents
+        String contents;
+        const char *data;
+        size_t size;
+        if(MemoryDataStream *memStream = dynamic_cast<MemoryDataStream*>(stream.get()))
+        {
+            data = reinterpret_cast<const char*>(memStream->getCurrentPtr());
+            size = memStream->size() - memStream->tell();
+        }
+        else
+        {
+            contents = stream->getAsString();
+            data = contents.data();
+            size = contents.size();
+        }
+        ScriptHash hash = hashScript(data, size);
+
+        AbstractNodeListPtr ast = getCompiledScript(stream->getName(), hash, groupName, compiler);
+        if(!ast)
+        {
+            ConcreteNodeListPtr nodes = ScriptParser::parse(ScriptLexer::tokenize(data, size, stream->getName()));
+            StringVector imports;
+            ast = compiler->_generateProcessedAST(nodes, groupName, &imports);
+            // scripts with errors are compiled from text, so the errors are reported again
+            if(compiler->getErrors().empty())
+                addCompiledScript(stream->getName(), hash, imports, groupName, *ast, compiler);
+        }
+        return ast;
+    }
+    //-----------------------------------------------------------------------
+    ScriptCompilerManager::ScriptHash ScriptCompilerManager::hashImportedScript(const String &name,
+        const String &group)
+    {
+        bool memoise = false;
+        {
+            OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+            map<String, ImportHashMap>::type::const_iterator g = mImportHashes.find(group);
+            if(g != mImportHashes.end())
+            {
+                ImportHashMap::const_iterator it = g->second.find(name);
+                if(it != g->second.end())
+                    return it->second;
+                memoise = true;
+            }
+        }
+
+        ScriptHash hash(0, 0);
+        DataStreamPtr stream;
+        try
+        {
+            stream = ResourceGroupManager::getSingleton().openResource(name, group);
+        }
+        catch (FileNotFoundException&)
+        {
+            // missing imports are remembered as well
+        }
+
+        if(stream)
+        {
+            String contents = stream->getAsString();
+            hash = hashScript(contents.data(), contents.size());
+        }
+
+        if(memoise)
+        {
+            OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+            map<String, ImportHashMap>::type::iterator g = mImportHashes.find(group);
+            if(g != mImportHashes.end())
+                g->second[name] = hash;
+        }
+        return hash;
+    }
+    //-----------------------------------------------------------------------
+    AbstractNodeListPtr ScriptCompilerManager::getCompiledScript(const String &name, const ScriptHash &hash,
+        const String &group, const ScriptCompiler *compiler)
+    {
+        CompiledScript script;
+        {
+            OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+            CompiledScriptMap::iterator it = mCompiledScripts.find(name);
+            if(it == mCompiledScripts.end())
+                return AbstractNodeListPtr();
+            script = it->second;
+        }
+
+        bool valid = script.hash == hash && script.customWordIdHash == compiler->_getCustomWordIdHash();
+        for(size_t i = 0; valid && i < script.imports.size(); ++i)
+            valid = hashImportedScript(script.imports[i].first, group) == script.imports[i].second;
+
+        if(!valid)
+            return AbstractNodeListPtr();
+
+        // MEMCATEGORY_GENERAL is the only category supported for SharedPtr
+        AbstractNodeListPtr ast(OGRE_NEW_T(AbstractNodeList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        try
+        {
+            AbstractNodeReader(script.ast).readList(*ast, 0);
+        }
+        catch (InvalidStateException&)
+        {
+            OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+            mCompiledScripts.erase(name);
+            mCompiledScriptCacheDirty = true;
+            return AbstractNodeListPtr();
+        }
+        return ast;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::addCompiledScript(const String &name, const ScriptHash &hash,
+        const StringVector &imports, const String &group, const AbstractNodeList &ast,
+        const ScriptCompiler *compiler)
+    {
+        CompiledScript script;
+        script.hash = hash;
+        script.customWordIdHash = compiler->_getCustomWordIdHash();
+        for(StringVector::const_iterator i = imports.begin(); i != imports.end(); ++i)
+            script.imports.push_back(std::make_pair(*i, hashImportedScript(*i, group)));
+
+        AbstractNodeWriter writer;
+        writer.writeList(ast);
+        writer.getResult(script.ast);
+
+        OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+        mCompiledScripts[name] = script;
+        mCompiledScriptCacheDirty = true;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::saveCompiledScriptCache(const DataStreamPtr &stream) const
+    {
+        OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+
+        StreamSerialiser ser(stream);
+        ser.writeChunkBegin(COMPILEDSCRIPTCACHE_CHUNK_ID, COMPILEDSCRIPTCACHE_CHUNK_VERSION);
+
+        // the built-in word ids may change between versions
+        uint32 version = OGRE_VERSION;
+        ser.write(&version);
+        uint32 numScripts = static_cast<uint32>(mCompiledScripts.size());
+        ser.write(&numScripts);
+
+        for(CompiledScriptMap::const_iterator i = mCompiledScripts.begin(); i != mCompiledScripts.end(); ++i)
+        {
+            const CompiledScript &script = i->second;
+            ser.write(&i->first);
+            ser.write(&script.hash.first);
+            ser.write(&script.hash.second);
+            ser.write(&script.customWordIdHash);
+
+            uint32 numImports = static_cast<uint32>(script.imports.size());
+            ser.write(&numImports);
+            for(size_t j = 0; j < script.imports.size(); ++j)
+            {
+                ser.write(&script.imports[j].first);
+                ser.write(&script.imports[j].second.first);
+                ser.write(&script.imports[j].second.second);
+            }
+
+            uint32 size = static_cast<uint32>(script.ast.size());
+            ser.write(&size);
+            if(size)
+                ser.write(&script.ast[0], size);
         }
-        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(stream->getAsString(), stream->getName(), groupName);
+
+        ser.writeChunkEnd(COMPILEDSCRIPTCACHE_CHUNK_ID);
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::loadCompiledScriptCache(const DataStreamPtr &stream)
+    {
+        OGRE_WQ_LOCK_MUTEX(mCompiledScriptMutex);
+
+        mCompiledScripts.clear();
+        mCompiledScriptCacheDirty = true;
+
+        try
+        {
+            StreamSerialiser ser(stream);
+            if(!ser.readChunkBegin(COMPILEDSCRIPTCACHE_CHUNK_ID, COMPILEDSCRIPTCACHE_CHUNK_VERSION,
+                "ScriptCompilerManager::loadCompiledScriptCache"))
+                return;
+
+            uint32 version = 0, numScripts = 0;
+            ser.read(&version);
+            if(version != OGRE_VERSION)
+                return;
+
+            ser.read(&numScripts);
+            for(uint32 i = 0; i < numScripts && !stream->eof(); ++i)
+            {
+                String name;
+                CompiledScript script;
+                ser.read(&name);
+                ser.read(&script.hash.first);
+                ser.read(&script.hash.second);
+                ser.read(&script.customWordIdHash);
+
+                uint32 numImports = 0;
+                ser.read(&numImports);
+                for(uint32 j = 0; j < numImports && !stream->eof(); ++j)
+                {
+                    std::pair<String, ScriptHash> import;
+                    ser.read(&import.first);
+                    ser.read(&import.second.first);
+                    ser.read(&import.second.second);
+                    script.imports.push_back(import);
+                }
+
+                uint32 size = 0;
+                ser.read(&size);
+                if(size > stream->size() - stream->tell())
+                    break;
+                script.ast.resize(size);
+                if(size)
+                    ser.read(&script.ast[0], size);
+
+                mCompiledScripts[name] = script;
+            }
+
+            if(mCompiledScripts.size() != numScripts)
+            {
+                mCompiledScripts.clear();
+                return;
+            }
+
+            ser.readChunkEnd(COMPILEDSCRIPTCACHE_CHUNK_ID);
+        }
+        catch (std::exception&)
+        {
+            // corrupt data, including bogus string lengths
+            mCompiledScripts.clear();
+            return;
+        }
+
+        mCompiledScriptCacheDirty = false;
     }
 
     //-------------------------------------------------------------------------
@@ -30,6 +30,24 @@ THE SOFTWARE.
 
 namespace Ogre{
     ScriptTokenListPtr ScriptLexer::tokenize(const String &str, const String &source)
+    {
+        return tokenize(str.data(), str.size(), source);
+    }
+
+    ScriptTokenListPtr ScriptLexer::tokenize(const DataStreamPtr &stream, const String &source)
+    {
+        if (MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get()))
+        {
+            // consumed like getAsString, from the current position
+            const char* data = reinterpret_cast<const char*>(memStream->getCurrentPtr());
+            size_t size = memStream->size() - memStream->tell();
+            memStream->skip(size);
+            return tokenize(data, size, source);
+        }
+        return tokenize(stream->getAsString(), source);
+    }
+
+    ScriptTokenListPtr ScriptLexer::tokenize(const char *str, size_t length, const String &source)
     {
         // State enums
         enum{ READY = 0, COMMENT, MULTICOMMENT, WORD, QUOTE, VAR, POSSIBLECOMMENT };
@@ -43,7 +61,7 @@ namespace Ogre{
         ScriptTokenListPtr tokens(OGRE_NEW_T(ScriptTokenList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
 
         // Iterate over the input
-        String::const_iterator i = str.begin(), end = str.end();
+        const char *i = str, *end = str + length;
         while(i != end)
         {
             lastc = c;
@@ -1253,6 +1253,7 @@ namespace Ogre {
         const String& materialName)
         : mParent(parent)
         , mMaterialName(materialName)
+        , mMaterialLodIndex(0)
         , mTechnique(0)
     {
     }
@@ -1334,9 +1335,10 @@ namespace Ogre {
         if (materialLodStrategy != region->mLodStrategy)
             lodValue = materialLodStrategy->getValue(region, region->mCamera);
 
-        // Determine the current material technique
-        mTechnique = mMaterial->getBestTechnique(
-            mMaterial->getLodIndex(lodValue));
+        // The technique is only resolved by getCurrentTechnique, as this may run on a worker
+        // thread and the material scheme listeners must be called on the rendering one
+        mMaterialLodIndex = mMaterial->getLodIndex(lodValue);
+        mTechnique = 0;
         GeometryBucketList::iterator i, iend;
         iend =  mGeometryBucketList.end();
         for (i = mGeometryBucketList.begin(); i != iend; ++i)
@@ -1346,6 +1348,13 @@ namespace Ogre {
 
     }
     //--------------------------------------------------------------------------
+    Technique* StaticGeometry::MaterialBucket::getCurrentTechnique(void) const
+    {
+        if (!mTechnique && mMaterial)
+            mTechnique = mMaterial->getBestTechnique(mMaterialLodIndex);
+        return mTechnique;
+    }
+    //--------------------------------------------------------------------------
     String StaticGeometry::MaterialBucket::getGeometryFormatString(
         SubMeshLodGeometryLink* geom)
     {
@@ -0,0 +1,350 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreTaskScheduler.h"
+
+#include <thread>
+
+namespace Ogre
+{
+    namespace
+    {
+        /// Shared state of a parallelFor call
+        struct RangeState
+        {
+            TaskScheduler::RangeJob* job;
+            size_t begin;
+            size_t end;
+            size_t grainSize;
+            size_t numChunks;
+            AtomicScalar<size_t> nextChunk;
+            AtomicScalar<bool> failed;
+            std::exception_ptr exception;
+
+            /// Claim and execute chunks until none are left
+            void run()
+            {
+                for (size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+                {
+                    size_t first = begin + chunk * grainSize;
+                    try
+                    {
+                        job->execute(first, std::min(first + grainSize, end));
+                    }
+                    catch (...)
+                    {
+                        // keep the first one, it is rethrown by parallelFor
+                        if (!failed.exchange(true))
+                            exception = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        /// Helps with a parallelFor on another thread
+        class RangeTask : public Task
+        {
+        public:
+            RangeTask() : mState(0) {}
+            void execute(void) { mState->run(); }
+            RangeState* mState;
+        };
+
+        AtomicScalar<uint32> gNextSchedulerID(0);
+    }
+    //---------------------------------------------------------------------
+    Task::Task()
+        : mPendingDependencies(1), mGroup(0), mNext(0), mFinished(false)
+    {
+    }
+    //---------------------------------------------------------------------
+    void Task::addDependency(Task* task)
+    {
+        OgreAssert(!mGroup && !task->mGroup, "dependencies must be added before submitting");
+        ++mPendingDependencies;
+        task->mContinuations.push_back(this);
+    }
+    //---------------------------------------------------------------------
+    TaskGroup::TaskGroup()
+        : mPendingTasks(0), mFailed(false)
+    {
+    }
+    //---------------------------------------------------------------------
+    TaskGroup::~TaskGroup()
+    {
+        // tasks which were waited for one by one may still be finishing
+        while (!isFinished())
+            std::this_thread::yield();
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::TaskScheduler(WorkQueue* queue)
+        : mQueue(0)
+        , mChannel(0)
+        , mReadyHead(0)
+        , mReadyTail(0)
+        , mReadyCount(0)
+        , mActiveWorkers(0)
+    {
+        setWorkQueue(queue);
+    }
+    //---------------------------------------------------------------------
+    TaskScheduler::~TaskScheduler()
+    {
+        setWorkQueue(0);
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::setWorkQueue(WorkQueue* queue)
+    {
+        if (mQueue == queue)
+            return;
+
+        if (mQueue)
+        {
+            mQueue->abortRequestsByChannel(mChannel);
+            // waits for the workers which are still executing tasks
+            mQueue->removeRequestHandler(mChannel, this);
+            mQueue->removeResponseHandler(mChannel, this);
+        }
+
+        mQueue = queue;
+        mActiveWorkers = 0;
+
+        if (mQueue)
+        {
+            // a channel of our own, requests are only meant for this scheduler
+            mChannel = mQueue->getChannel(
+                "Ogre/TaskScheduler/" + StringConverter::toString(gNextSchedulerID++));
+            mQueue->addRequestHandler(mChannel, this);
+            mQueue->addResponseHandler(mChannel, this);
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t TaskScheduler::getWorkerCount(void) const
+    {
+#if OGRE_THREAD_SUPPORT
+        if (!mQueue)
+            return 0;
+
+        DefaultWorkQueueBase* queue = dynamic_cast<DefaultWorkQueueBase*>(mQueue);
+        if (queue)
+            return queue->getWorkerThreadCount();
+
+        return OGRE_THREAD_HARDWARE_CONCURRENCY;
+#else
+        return 0;
+#endif
+    }
+    //---------------------------------------------------------------------
+    size_t TaskScheduler::getThreadCount(void) const
+    {
+        return getWorkerCount() + 1;
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::submit(Task* task, TaskGroup& group)
+    {
+        OgreAssert(!task->mGroup, "a task can only be submitted once");
+        task->mGroup = &group;
+        ++group.mPendingTasks;
+
+        // drop the reference which kept it from running before it was submitted
+        if (--task->mPendingDependencies == 0)
+            makeReady(task);
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::wait(TaskGroup& group)
+    {
+        while (!group.isFinished())
+        {
+            if (Task* task = acquireTask())
+                executeTask(task);
+            else
+                std::this_thread::yield();
+        }
+
+        if (group.mFailed)
+            std::rethrow_exception(group.mException);
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::wait(Task& task)
+    {
+        while (!task.isFinished())
+        {
+            if (Task* ready = acquireTask())
+                executeTask(ready);
+            else
+                std::this_thread::yield();
+        }
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::parallelFor(size_t begin, size_t end, size_t grainSize, RangeJob& job,
+        size_t maxThreads)
+    {
+        if (end <= begin)
+            return;
+
+        RangeState state;
+        state.job = &job;
+        state.begin = begin;
+        state.end = end;
+        state.grainSize = std::max<size_t>(grainSize, 1);
+        state.numChunks = (end - begin + state.grainSize - 1) / state.grainSize;
+        state.nextChunk = 0;
+        state.failed = false;
+
+        size_t threads = maxThreads ? std::min(maxThreads, getThreadCount()) : getThreadCount();
+        threads = std::min(std::min(threads, state.numChunks), size_t(MAX_RANGE_THREADS));
+
+        RangeTask helpers[MAX_RANGE_THREADS - 1];
+        TaskGroup group;
+        for (size_t i = 0; i + 1 < threads; ++i)
+        {
+            helpers[i].mState = &state;
+            submit(&helpers[i], group);
+        }
+
+        state.run();
+        wait(group);
+
+        if (state.failed)
+            std::rethrow_exception(state.exception);
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::makeReady(Task* task)
+    {
+        {
+            OGRE_WQ_LOCK_MUTEX(mReadyMutex);
+            task->mNext = 0;
+            if (mReadyTail)
+                mReadyTail->mNext = task;
+            else
+                mReadyHead = task;
+            mReadyTail = task;
+            ++mReadyCount;
+        }
+        requestWorker();
+    }
+    //---------------------------------------------------------------------
+    Task* TaskScheduler::acquireTask(void)
+    {
+        if (!mReadyCount)
+            return 0;
+
+        OGRE_WQ_LOCK_MUTEX(mReadyMutex);
+        Task* task = mReadyHead;
+        if (task)
+        {
+            mReadyHead = task->mNext;
+            if (!mReadyHead)
+                mReadyTail = 0;
+            --mReadyCount;
+        }
+        return task;
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::executeTask(Task* task)
+    {
+        TaskGroup* group = task->mGroup;
+        try
+        {
+            task->execute();
+        }
+        catch (...)
+        {
+            // keep the first one, it is rethrown by wait
+            if (!group->mFailed.exchange(true))
+                group->mException = std::current_exception();
+        }
+
+        for (vector<Task*>::type::iterator i = task->mContinuations.begin();
+            i != task->mContinuations.end(); ++i)
+        {
+            if (--(*i)->mPendingDependencies == 0)
+                makeReady(*i);
+        }
+
+        // a thread waiting for the task may destroy it, and then the group, whose
+        // destructor waits for this decrement. A thread waiting for the group may
+        // destroy both once it is done, so nothing is touched afterwards.
+        task->mFinished.store(true, std::memory_order_release);
+        group->mPendingTasks.fetch_sub(1, std::memory_order_release);
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::requestWorker(void)
+    {
+#if OGRE_THREAD_SUPPORT
+        if (!mQueue)
+            return;
+
+        size_t workers = getWorkerCount();
+        size_t active = mActiveWorkers;
+        while (active < workers)
+        {
+            if (mActiveWorkers.compare_exchange_weak(active, active + 1))
+            {
+                if (!mQueue->addRequest(mChannel, 0, Any()))
+                    --mActiveWorkers;
+                return;
+            }
+        }
+#endif
+    }
+    //---------------------------------------------------------------------
+    bool TaskScheduler::canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        // aborted requests still have to give their worker slot back
+        return true;
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Response* TaskScheduler::handleRequest(const WorkQueue::Request* req,
+        const WorkQueue* srcQ)
+    {
+        for (;;)
+        {
+            while (Task* task = acquireTask())
+                executeTask(task);
+
+            --mActiveWorkers;
+
+            // a task may have become ready after the list was found empty, in
+            // which case requestWorker may have seen this worker as still active
+            if (!mReadyCount)
+                break;
+            size_t active = mActiveWorkers;
+            if (active >= getWorkerCount() ||
+                !mActiveWorkers.compare_exchange_strong(active, active + 1))
+                break;
+        }
+
+        return OGRE_NEW WorkQueue::Response(req, true, Any());
+    }
+    //---------------------------------------------------------------------
+    void TaskScheduler::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+    {
+        // the tasks report to their waiting threads, not to the main thread
+    }
+}
@@ -58,7 +58,12 @@ namespace Ogre {
             mDesiredIntegerBitDepth(0),
             mDesiredFloatBitDepth(0),
             mTreatLuminanceAsAlpha(false),
-            mInternalResourcesCreated(false)
+            mInternalResourcesCreated(false),
+            mStreamed(false),
+            mLoadingFromFile(false),
+            mResidentMipmap(0),
+            mNumSrcMipmaps(0),
+            mStreamingDemand(0)
     {
         if (createParamDictionary("Texture"))
         {
@@ -99,6 +104,8 @@ namespace Ogre {
         try
         {
                     OGRE_LOCK_AUTO_MUTEX;
+            // the image does not come from a file which could be streamed
+            mLoadingFromFile = false;
             vector<const Image*>::type imagePtrs;
             imagePtrs.push_back(&img);
             _loadImages( imagePtrs );
@@ -220,8 +227,55 @@ namespace Ogre {
             mUsage &= ~TU_AUTOMIPMAP;
         }
 
+        // Streamed textures only keep the mipmaps from mResidentMipmap on resident
+        TextureManager* manager = TextureManager::getSingletonPtr();
+        bool streamed = manager && manager->getStreamingBudget() > 0 && imageMips > 0 &&
+                        (mLoadingFromFile || mStreamed) &&
+                        mTextureType == TEX_TYPE_2D && images.size() == 1 && images[0]->getNumFaces() == 1 &&
+                        mSrcDepth == 1;
+        uint32 firstMip = 0;
+        mNumSrcMipmaps = imageMips;
+        if (streamed)
+        {
+            if (!mStreamed)
+            {
+                // start with the mipmaps up to the minimum size
+                mResidentMipmap = 0;
+                while (mResidentMipmap < imageMips &&
+                       std::max(mSrcWidth, mSrcHeight) >> mResidentMipmap > manager->getStreamingMinSize())
+                    ++mResidentMipmap;
+            }
+            firstMip = mResidentMipmap = std::min(mResidentMipmap, imageMips);
+            mWidth = std::max(mSrcWidth >> firstMip, 1u);
+            mHeight = std::max(mSrcHeight >> firstMip, 1u);
+            imageMips -= firstMip;
+            mNumMipmaps = mNumRequestedMipmaps = imageMips;
+        }
+        else
+        {
+            mResidentMipmap = 0;
+        }
+        mStreamed = streamed;
+
         // Create the texture
         createInternalResources();
+
+        // Generate the mipmaps the hardware can not in software, on copies of the images
+        vector<Image>::type mipmappedImages;
+        ConstImagePtrList mipmappedImagePtrs;
+        if(imageMips == 0 && mNumMipmaps > 0 && (mUsage & TU_AUTOMIPMAP) && !mMipmapsHardwareGenerated &&
+           !PixelUtil::isCompressed(images[0]->getFormat()))
+        {
+            mipmappedImages.reserve(images.size());
+            for(size_t i = 0; i < images.size(); ++i)
+            {
+                mipmappedImages.push_back(*images[i]);
+                mipmappedImages.back().generateMipmaps(mHwGamma);
+                mipmappedImagePtrs.push_back(&mipmappedImages.back());
+            }
+            imageMips = mipmappedImages[0].getNumMipmaps();
+        }
+        const ConstImagePtrList& sources = mipmappedImagePtrs.empty() ? images : mipmappedImagePtrs;
         // Check if we're loading one image with multiple faces
         // or a vector of images representing the faces
         size_t faces;
@@ -249,6 +303,8 @@ namespace Ogre {
                 << "(" << PixelUtil::getFormatName(images[0]->getFormat()) << "," <<
                 images[0]->getWidth() << "x" << images[0]->getHeight() << "x" << images[0]->getDepth() <<
                 ")";
+            if (mStreamed)
+                str << " streamed from mipmap " << firstMip;
             if (!(mMipmapsHardwareGenerated && mNumMipmaps == 0))
             {
                 str << " with " << static_cast<int>(mNumMipmaps);
@@ -290,12 +346,12 @@ namespace Ogre {
                 if(multiImage)
                 {
                     // Load from multiple images
-                    src = images[i]->getPixelBox(0, mip);
+                    src = sources[i]->getPixelBox(0, mip);
                 }
                 else
                 {
                     // Load from faces of images[0]
-                    src = images[0]->getPixelBox(i, mip);
+                    src = sources[0]->getPixelBox(i, mip + firstMip);
                 }
     
                 // Sets to treated format in case is difference
@@ -349,9 +405,53 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------------
+    void Texture::preLoadImpl(void)
+    {
+        // manual loaders provide the images, and may not be able to provide them again
+        mLoadingFromFile = !mIsManual;
+    }
+    //-----------------------------------------------------------------------------
+    void Texture::postLoadImpl(void)
+    {
+        mLoadingFromFile = false;
+    }
+    //-----------------------------------------------------------------------------
     void Texture::unloadImpl(void)
     {
         freeInternalResources();
+        mStreamed = false;
+        mResidentMipmap = 0;
+    }
+    //-----------------------------------------------------------------------------
+    size_t Texture::getStreamedSize(uint32 residentMipmap) const
+    {
+        uint32 mip = std::min(residentMipmap, mNumSrcMipmaps);
+        return Image::calculateSize(mNumSrcMipmaps - mip, getNumFaces(), std::max(mSrcWidth >> mip, 1u),
+                                    std::max(mSrcHeight >> mip, 1u), 1, mFormat);
+    }
+    //-----------------------------------------------------------------------------
+    void Texture::_loadStreamedImage(const Image& img, uint32 residentMipmap)
+    {
+        if (!mStreamed || !isLoaded() || residentMipmap == mResidentMipmap)
+            return;
+
+        OGRE_LOCK_AUTO_MUTEX;
+        // the size changes with the resident mipmaps
+        if (mCreator)
+            mCreator->_notifyResourceUnloaded(this);
+
+        freeInternalResources();
+        mResidentMipmap = residentMipmap;
+        ConstImagePtrList imagePtrs(1, &img);
+        _loadImages(imagePtrs);
+
+        if (mCreator)
+            mCreator->_notifyResourceLoaded(this);
+    }
+    //-----------------------------------------------------------------------------
+    void Texture::_readStreamedImage(Image& img)
+    {
+        img.load(ResourceGroupManager::getSingleton().openResource(mName, mGroup, this), getSourceFileType());
     }
     //-----------------------------------------------------------------------------   
     void Texture::copyToTexture( TexturePtr& target )
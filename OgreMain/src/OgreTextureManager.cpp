@@ -27,6 +27,8 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgrePixelFormat.h"
+#include "OgreTextureUnitState.h"
+#include "OgreViewport.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -44,9 +46,14 @@ namespace Ogre {
          : mPreferredIntegerBitDepth(0)
          , mPreferredFloatBitDepth(0)
          , mDefaultNumMipmaps(MIP_UNLIMITED)
+         , mStreamingBudget(0)
+         , mStreamingMinSize(64)
+         , mStreamingMaxRequests(2)
+         , mStreamingUsage(0)
     {
         mResourceType = "Texture";
         mLoadOrder = 75.0f;
+        mPrepareThreadSafe = true;
 
         // Subclasses should register (when this is fully constructed)
     }
@@ -313,4 +320,219 @@ namespace Ogre {
 
         return mWarningTexture;
     }
+    //-----------------------------------------------------------------------
+    namespace
+    {
+        /// Passes the size on screen of an object to the streamed textures of its renderables
+        struct StreamingDemandVisitor : public Renderable::Visitor
+        {
+            Real size;
+            explicit StreamingDemandVisitor(Real s) : size(s) {}
+
+            void visit(Renderable* rend, ushort lodIndex, bool isDebug, Any* pAny)
+            {
+                if (isDebug || !rend->getMaterial())
+                    return;
+
+                Technique* tech = rend->getTechnique();
+                if (!tech)
+                    return;
+
+                const Technique::Passes& passes = tech->getPasses();
+                for (size_t i = 0; i < passes.size(); ++i)
+                {
+                    const Pass::TextureUnitStates& units = passes[i]->getTextureUnitStates();
+                    for (size_t j = 0; j < units.size(); ++j)
+                    {
+                        for (size_t frame = 0; frame < units[j]->getNumFrames(); ++frame)
+                        {
+                            const TexturePtr& tex = units[j]->_getTexturePtr(frame);
+                            if (tex && tex->isStreamed())
+                                tex->_notifyStreamingDemand(size);
+                        }
+                    }
+                }
+            }
+        };
+
+        /// The first mipmap no larger than minSize, the detail streamed textures always keep
+        uint32 getMaxResidentMipmap(uint32 width, uint32 height, uint32 numMipmaps, uint32 minSize)
+        {
+            uint32 mip = 0;
+            while (mip < numMipmaps && std::max(width, height) >> mip > minSize)
+                ++mip;
+            return mip;
+        }
+
+        /// Orders the streamed textures to drop a mipmap, the unseen ones first, then the most texels per pixel
+        typedef std::pair<std::pair<bool, Real>, size_t> StreamingCandidate;
+        StreamingCandidate getStreamingCandidate(const TextureManager::StreamingTexture& t, size_t index)
+        {
+            Real texels = Real(std::max(t.width, t.height) >> t.targetMipmap);
+            bool unseen = t.demand <= 0;
+            return StreamingCandidate(std::make_pair(unseen, unseen ? texels : texels / t.demand), index);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void TextureManager::_notifyStreamingDemand(MovableObject* mo, const Camera* cam)
+    {
+        const Viewport* vp = cam->getViewport();
+        if (!mStreamingBudget || !vp || !mo->getParentNode())
+            return;
+
+        // Estimate the diameter of the bounding sphere on screen, like AbsolutePixelCountLodStrategy
+        Real vpSize = Real(std::max(vp->getActualWidth(), vp->getActualHeight()));
+        Real radius = mo->getWorldBoundingSphere(true).getRadius();
+        Real size = vpSize;
+        if (cam->getProjectionType() == PT_PERSPECTIVE)
+        {
+            Real depth = Math::Sqrt(mo->getParentNode()->getSquaredViewDepth(cam));
+            // the whole viewport if the camera is inside
+            if (depth > radius)
+                size = radius * vp->getActualHeight() * cam->getProjectionMatrix()[1][1] / depth;
+        }
+        else if (cam->getOrthoWindowHeight() > 0)
+        {
+            size = 2 * radius * vp->getActualHeight() / cam->getOrthoWindowHeight();
+        }
+
+        StreamingDemandVisitor visitor(std::min(size, vpSize));
+        mo->visitRenderables(&visitor);
+    }
+    //-----------------------------------------------------------------------
+    void TextureManager::_updateStreaming(void)
+    {
+        // nothing to plan, and nothing in flight to collect
+        if (!mStreamingBudget && mStreamingRequests.empty())
+            return;
+
+        ResourceBackgroundQueue& queue = ResourceBackgroundQueue::getSingleton();
+        for (StreamingRequestMap::iterator it = mStreamingRequests.begin(); it != mStreamingRequests.end();)
+        {
+            if (queue.isProcessComplete(it->second))
+                mStreamingRequests.erase(it++);
+            else
+                ++it;
+        }
+
+        StreamingTextureList textures;
+        size_t usage = 0;
+        {
+            OGRE_LOCK_AUTO_MUTEX;
+            for (ResourceHandleMap::iterator it = mResourcesByHandle.begin(); it != mResourcesByHandle.end(); ++it)
+            {
+                Texture* tex = static_cast<Texture*>(it->second.get());
+                if (!tex->isStreamed() || !tex->isLoaded())
+                    continue;
+
+                StreamingTexture t;
+                t.width = tex->getSrcWidth();
+                t.height = tex->getSrcHeight();
+                t.numMipmaps = tex->getNumSrcMipmaps();
+                t.format = tex->getFormat();
+                t.maxResidentMipmap = getMaxResidentMipmap(t.width, t.height, t.numMipmaps, mStreamingMinSize);
+                t.residentMipmap = tex->getResidentMipmap();
+                t.demand = tex->_getStreamingDemand();
+                t.targetMipmap = t.residentMipmap;
+                t.texture = tex;
+                tex->_resetStreamingDemand();
+
+                usage += t.getSize(t.residentMipmap);
+                textures.push_back(t);
+            }
+        }
+        mStreamingUsage = usage;
+
+        if (textures.empty() || !mStreamingBudget)
+            return;
+
+        _planStreaming(textures, mStreamingBudget);
+
+        // Drop detail first to make room, then add it where the most texels per pixel are missing
+        vector<std::pair<Real, size_t> >::type upgrades;
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            const StreamingTexture& t = textures[i];
+            if (t.targetMipmap == t.residentMipmap || mStreamingRequests.count(t.texture->getHandle()))
+                continue;
+
+            if (t.targetMipmap > t.residentMipmap)
+            {
+                if (mStreamingRequests.size() >= mStreamingMaxRequests)
+                    return;
+                usage -= t.getSize(t.residentMipmap) - t.getSize(t.targetMipmap);
+                mStreamingRequests[t.texture->getHandle()] =
+                    queue.streamTexture(t.texture->getHandle(), t.targetMipmap);
+            }
+            else
+            {
+                Real dim = Real(std::max(t.width, t.height) >> t.residentMipmap);
+                upgrades.push_back(std::make_pair(t.demand / dim, i));
+            }
+        }
+
+        std::sort(upgrades.begin(), upgrades.end(), std::greater<std::pair<Real, size_t> >());
+        for (size_t i = 0; i < upgrades.size() && mStreamingRequests.size() < mStreamingMaxRequests; ++i)
+        {
+            const StreamingTexture& t = textures[upgrades[i].second];
+            size_t growth = t.getSize(t.targetMipmap) - t.getSize(t.residentMipmap);
+            if (usage + growth > mStreamingBudget)
+                continue;
+            usage += growth;
+            mStreamingRequests[t.texture->getHandle()] =
+                queue.streamTexture(t.texture->getHandle(), t.targetMipmap);
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t TextureManager::StreamingTexture::getSize(uint32 mipmap) const
+    {
+        mipmap = std::min(mipmap, numMipmaps);
+        return Image::calculateSize(numMipmaps - mipmap, 1, std::max(width >> mipmap, 1u),
+                                    std::max(height >> mipmap, 1u), 1, format);
+    }
+    //-----------------------------------------------------------------------
+    size_t TextureManager::_planStreaming(StreamingTextureList& textures, size_t budget)
+    {
+        std::priority_queue<StreamingCandidate> candidates;
+
+        size_t total = 0;
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            StreamingTexture& t = textures[i];
+            t.maxResidentMipmap = std::min(t.maxResidentMipmap, t.numMipmaps);
+            uint32 dim = std::max(t.width, t.height);
+
+            // the smallest mipmap still having a texel per pixel on screen
+            uint32 wanted = t.maxResidentMipmap;
+            if (t.demand > 0)
+            {
+                wanted = 0;
+                while (wanted < t.maxResidentMipmap && Real(dim >> (wanted + 1)) >= t.demand)
+                    ++wanted;
+            }
+
+            // keep what is resident already as long as it fits
+            t.targetMipmap = std::min(wanted, std::min(t.residentMipmap, t.maxResidentMipmap));
+            total += t.getSize(t.targetMipmap);
+
+            if (t.targetMipmap < t.maxResidentMipmap)
+                candidates.push(getStreamingCandidate(t, i));
+        }
+
+        while (total > budget && !candidates.empty())
+        {
+            size_t i = candidates.top().second;
+            candidates.pop();
+
+            StreamingTexture& t = textures[i];
+            total -= t.getSize(t.targetMipmap);
+            ++t.targetMipmap;
+            total += t.getSize(t.targetMipmap);
+
+            if (t.targetMipmap < t.maxResidentMipmap)
+                candidates.push(getStreamingCandidate(t, i));
+        }
+
+        return total;
+    }
 }
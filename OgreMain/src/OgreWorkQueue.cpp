@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreWorkQueue.h"
 #include "OgreTimer.h"
 
+#include <thread>
+
 namespace Ogre {
     //---------------------------------------------------------------------
     uint16 WorkQueue::getChannel(const String& channelName)
@@ -125,6 +127,14 @@ namespace Ogre {
         mResponseQueue.clear();
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::RequestHandlerHolder::disconnectHandler()
+    {
+        mHandler = 0;
+        // must wait for all requests to finish
+        while (mActiveRequests)
+            std::this_thread::yield();
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::addRequestHandler(uint16 channel, RequestHandler* rh)
     {
             OGRE_WQ_LOCK_RW_MUTEX_WRITE(mRequestHandlerMutex);
@@ -637,13 +647,14 @@ namespace Ogre {
     //---------------------------------------------------------------------
     WorkQueue::Response* DefaultWorkQueueBase::processRequest(Request* r)
     {
-        RequestHandlerListByChannel handlerListCopy;
+        RequestHandlerList handlers;
         {
-            // lock the list only to make a copy of it, to maximise parallelism
+            // lock the list only to make a copy of this channel's handlers, to maximise parallelism
                     OGRE_WQ_LOCK_RW_MUTEX_READ(mRequestHandlerMutex);
             
-            handlerListCopy = mRequestHandlers;
-            
+            RequestHandlerListByChannel::iterator i = mRequestHandlers.find(r->getChannel());
+            if (i != mRequestHandlers.end())
+                handlers = i->second;
         }
 
         Response* response = 0;
@@ -657,18 +668,13 @@ namespace Ogre {
         LogManager::getSingleton().stream(LML_TRIVIAL) << 
             "DefaultWorkQueueBase('" << mName << "') - PROCESS_REQUEST_START(" << dbgMsg.str();
 
-        RequestHandlerListByChannel::iterator i = handlerListCopy.find(r->getChannel());
-        if (i != handlerListCopy.end())
+        for (RequestHandlerList::reverse_iterator j = handlers.rbegin(); j != handlers.rend(); ++j)
         {
-            RequestHandlerList& handlers = i->second;
-            for (RequestHandlerList::reverse_iterator j = handlers.rbegin(); j != handlers.rend(); ++j)
-            {
-                // threadsafe call which tests canHandleRequest and calls it if so 
-                response = (*j)->handleRequest(r, this);
+            // threadsafe call which tests canHandleRequest and calls it if so 
+            response = (*j)->handleRequest(r, this);
 
-                if (response)
-                    break;
-            }
+            if (response)
+                break;
         }
 
         LogManager::getSingleton().stream(LML_TRIVIAL) << 
@@ -0,0 +1,808 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "OgreRenderSystem.h"
+#include "OgreTimer.h"
+
+#include <unordered_map>
+
+namespace Ogre
+{
+    namespace
+    {
+        /// Identifies the worker deque owned by the current thread
+        struct WorkerIdentity
+        {
+            const WorkStealingWorkQueue* queue;
+            int index;
+            uint32 seed;
+        };
+        thread_local WorkerIdentity tCurrentWorker = { 0, -1, 0 };
+    }
+    //---------------------------------------------------------------------
+    /** Bounded single owner, multiple thief deque (Chase-Lev).
+    @remarks
+        The owning worker pushes and pops at the bottom, other threads steal
+        from the top. Follows "Correct and Efficient Work-Stealing for Weak
+        Memory Models" (Le et al.) without the buffer growth; push fails when
+        the deque is full so the caller can fall back to the shared queue.
+    */
+    class WorkStealingWorkQueue::WorkerDeque : public GeneralAllocatedObject
+    {
+    public:
+        static const int64 CAPACITY = 1024;
+
+        WorkerDeque() : mTop(0), mBottom(0)
+        {
+            for (int64 i = 0; i < CAPACITY; ++i)
+                mBuffer[i].store(0, std::memory_order_relaxed);
+        }
+
+        /// Owner only
+        bool push(Request* r)
+        {
+            int64 b = mBottom.load(std::memory_order_relaxed);
+            int64 t = mTop.load(std::memory_order_acquire);
+            if (b - t >= CAPACITY)
+                return false;
+
+            mBuffer[b & (CAPACITY - 1)].store(r, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /// Owner only
+        Request* pop()
+        {
+            int64 b = mBottom.load(std::memory_order_relaxed) - 1;
+            mBottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 t = mTop.load(std::memory_order_relaxed);
+
+            Request* r = 0;
+            if (t <= b)
+            {
+                r = mBuffer[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+                if (t == b)
+                {
+                    // last item, race against the thieves
+                    if (!mTop.compare_exchange_strong(t, t + 1,
+                            std::memory_order_seq_cst, std::memory_order_relaxed))
+                        r = 0;
+                    mBottom.store(b + 1, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                mBottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return r;
+        }
+
+        /// Any thread; returns null if empty or if another thread got in first
+        Request* steal()
+        {
+            int64 t = mTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 b = mBottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return 0;
+
+            Request* r = mBuffer[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+            if (!mTop.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed))
+                return 0;
+            return r;
+        }
+
+        bool empty() const
+        {
+            return mBottom.load() <= mTop.load();
+        }
+
+    private:
+        AtomicScalar<int64> mTop;
+        // keep the thieves' index away from the owner's
+        char mPad[64];
+        AtomicScalar<int64> mBottom;
+        AtomicScalar<Request*> mBuffer[CAPACITY];
+    };
+    //---------------------------------------------------------------------
+    /** Bounded multiple producer, multiple consumer FIFO queue (Vyukov).
+    @remarks
+        Each cell carries a sequence number telling producers and consumers
+        whether it is free for the current lap, so neither side needs a lock.
+    */
+    class WorkStealingWorkQueue::InjectionQueue : public GeneralAllocatedObject
+    {
+    public:
+        static const size_t CAPACITY = 4096;
+
+        InjectionQueue() : mEnqueuePos(0), mDequeuePos(0)
+        {
+            for (size_t i = 0; i < CAPACITY; ++i)
+            {
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+                mCells[i].request = 0;
+            }
+        }
+
+        bool push(Request* r)
+        {
+            Cell* cell;
+            size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &mCells[pos & (CAPACITY - 1)];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+                if (diff == 0)
+                {
+                    if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    pos = mEnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->request = r;
+            // seq_cst so a sleeping worker can't miss it, see waitForNextRequest
+            cell->sequence.store(pos + 1);
+            return true;
+        }
+
+        Request* pop()
+        {
+            Cell* cell;
+            size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &mCells[pos & (CAPACITY - 1)];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+                if (diff == 0)
+                {
+                    if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return 0; // empty
+                }
+                else
+                {
+                    pos = mDequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+            Request* r = cell->request;
+            cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+            return r;
+        }
+
+        bool empty() const
+        {
+            size_t pos = mDequeuePos.load();
+            return mCells[pos & (CAPACITY - 1)].sequence.load() != pos + 1;
+        }
+
+    private:
+        struct Cell
+        {
+            AtomicScalar<size_t> sequence;
+            Request* request;
+        };
+        Cell mCells[CAPACITY];
+        char mPad0[64];
+        AtomicScalar<size_t> mEnqueuePos;
+        char mPad1[64];
+        AtomicScalar<size_t> mDequeuePos;
+    };
+    //---------------------------------------------------------------------
+    /** One slice of the registry of queued requests.
+    @remarks
+        Requests stay registered from addRequest until they're deleted, so
+        they can be aborted by ID wherever they are.
+    */
+    struct WorkStealingWorkQueue::RequestShard
+    {
+        struct Record
+        {
+            Request* request;
+            bool started;
+        };
+        typedef std::unordered_map<RequestID, Record> RecordMap;
+
+        OGRE_WQ_MUTEX(mutex);
+        RecordMap records;
+    };
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::WorkStealingWorkQueue(const String& name)
+        : DefaultWorkQueueBase(name)
+        , mInjectionQueue(OGRE_NEW InjectionQueue())
+        , mRequestShards(OGRE_NEW_ARRAY_T(RequestShard, REQUEST_SHARD_COUNT, MEMCATEGORY_GENERAL))
+        , mNextRequestID(0)
+        , mNextWorkerIndex(0)
+        , mSleepingWorkers(0)
+        , mOverflowCount(0)
+        , mIdleCount(0)
+        , mIdleRunning(false)
+        , mNumThreadsRegisteredWithRS(0)
+    {
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::~WorkStealingWorkQueue()
+    {
+        shutdown();
+
+        // requests which were never started
+        while (Request* r = mInjectionQueue->pop())
+            OGRE_DELETE r;
+        for (RequestQueue::iterator i = mOverflowQueue.begin(); i != mOverflowQueue.end(); ++i)
+            OGRE_DELETE *i;
+        mOverflowQueue.clear();
+        for (RequestQueue::iterator i = mIdleRequestQueue.begin(); i != mIdleRequestQueue.end(); ++i)
+            OGRE_DELETE *i;
+        mIdleRequestQueue.clear();
+
+        OGRE_DELETE mInjectionQueue;
+        OGRE_DELETE_ARRAY_T(mRequestShards, RequestShard, REQUEST_SHARD_COUNT, MEMCATEGORY_GENERAL);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::startup(bool forceRestart)
+    {
+        if (mIsRunning)
+        {
+            if (forceRestart)
+                shutdown();
+            else
+                return;
+        }
+
+        mShuttingDown = false;
+
+        mWorkerFunc = OGRE_NEW_T(WorkerFunc(this), MEMCATEGORY_GENERAL);
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') initialising on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+#if OGRE_THREAD_SUPPORT
+        mNextWorkerIndex = 0;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+            mWorkerDeques.push_back(OGRE_NEW WorkerDeque());
+
+        if (mWorkerRenderSystemAccess)
+            Root::getSingleton().getRenderSystem()->preExtraThreadsStarted();
+
+        mNumThreadsRegisteredWithRS = 0;
+        for (size_t i = 0; i < mWorkerThreadCount; ++i)
+        {
+            OGRE_THREAD_CREATE(t, *mWorkerFunc);
+            mWorkers.push_back(t);
+        }
+
+        if (mWorkerRenderSystemAccess)
+        {
+            OGRE_WQ_LOCK_MUTEX_NAMED(mInitMutex, initLock);
+            // have to wait until all threads are registered with the render system
+            while (mNumThreadsRegisteredWithRS < mWorkerThreadCount)
+                OGRE_THREAD_WAIT(mInitSync, mInitMutex, initLock);
+
+            Root::getSingleton().getRenderSystem()->postExtraThreadsStarted();
+        }
+#endif
+
+        mIsRunning = true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::notifyThreadRegistered()
+    {
+        OGRE_WQ_LOCK_MUTEX(mInitMutex);
+
+        ++mNumThreadsRegisteredWithRS;
+
+        // wake up main thread
+        OGRE_THREAD_NOTIFY_ALL(mInitSync);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::shutdown()
+    {
+        if (!mIsRunning)
+            return;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << mName << "') shutting down on thread " <<
+            OGRE_THREAD_CURRENT_ID
+            << ".";
+
+        {
+            // under the lock, so a worker about to sleep can't miss it
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            mShuttingDown = true;
+        }
+        abortAllRequests();
+#if OGRE_THREAD_SUPPORT
+        {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            OGRE_THREAD_NOTIFY_ALL(mRequestCondition);
+        }
+
+        for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
+        {
+            (*i)->join();
+            OGRE_THREAD_DESTROY(*i);
+        }
+        mWorkers.clear();
+
+        // the workers are gone, anything left in their deques was never started
+        for (WorkerDequeList::iterator i = mWorkerDeques.begin(); i != mWorkerDeques.end(); ++i)
+        {
+            while (Request* r = (*i)->pop())
+            {
+                unregisterRequest(r);
+                OGRE_DELETE r;
+            }
+            OGRE_DELETE *i;
+        }
+        mWorkerDeques.clear();
+#endif
+
+        OGRE_DELETE_T(mWorkerFunc, WorkerFunc, MEMCATEGORY_GENERAL);
+        mWorkerFunc = 0;
+
+        mIsRunning = false;
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::RequestID WorkStealingWorkQueue::addRequest(uint16 channel, uint16 requestType,
+        const Any& rData, uint8 retryCount, bool forceSynchronous, bool idleThread)
+    {
+        if (!mAcceptRequests || mShuttingDown)
+            return 0;
+
+        RequestID rid = ++mNextRequestID;
+        Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+        registerRequest(req);
+
+#if OGRE_THREAD_SUPPORT
+        if (!forceSynchronous && !idleThread)
+        {
+            enqueueRequest(req);
+            return rid;
+        }
+        if (idleThread)
+        {
+            OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+            mIdleRequestQueue.push_back(req);
+            ++mIdleCount;
+            if (!mIdleRunning)
+                notifyWorkers();
+            return rid;
+        }
+#endif
+        runRequest(req, true);
+        return rid;
+    }
+    //---------------------------------------------------------------------
+    int WorkStealingWorkQueue::getCurrentWorkerIndex() const
+    {
+        const WorkerIdentity& self = tCurrentWorker;
+        if (self.queue == this && self.index < (int)mWorkerDeques.size())
+            return self.index;
+        return -1;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::enqueueRequest(Request* r)
+    {
+        int self = getCurrentWorkerIndex();
+        if (self < 0 || !mWorkerDeques[self]->push(r))
+        {
+            if (!mInjectionQueue->push(r))
+            {
+                OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+                mOverflowQueue.push_back(r);
+                ++mOverflowCount;
+            }
+        }
+        notifyWorkers();
+    }
+    //---------------------------------------------------------------------
+    WorkQueue::Request* WorkStealingWorkQueue::acquireRequest()
+    {
+        int self = getCurrentWorkerIndex();
+        Request* r = 0;
+
+        if (self >= 0 && (r = mWorkerDeques[self]->pop()))
+            return r;
+
+        if ((r = mInjectionQueue->pop()))
+            return r;
+
+        if (mOverflowCount)
+        {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            if (!mOverflowQueue.empty())
+            {
+                r = mOverflowQueue.front();
+                mOverflowQueue.pop_front();
+                --mOverflowCount;
+                return r;
+            }
+        }
+
+        // pick a random victim to start with so thieves spread out
+        size_t numDeques = mWorkerDeques.size();
+        if (numDeques)
+        {
+            uint32& seed = tCurrentWorker.seed;
+            seed = seed * 1664525u + 1013904223u;
+            size_t start = (seed >> 16) % numDeques;
+            for (size_t i = 0; i < numDeques; ++i)
+            {
+                size_t victim = (start + i) % numDeques;
+                if ((int)victim != self && (r = mWorkerDeques[victim]->steal()))
+                    return r;
+            }
+        }
+
+        return 0;
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::hasPendingWork() const
+    {
+        if (!mInjectionQueue->empty() || mOverflowCount || (mIdleCount && !mIdleRunning))
+            return true;
+
+        for (WorkerDequeList::const_iterator i = mWorkerDeques.begin(); i != mWorkerDeques.end(); ++i)
+        {
+            if (!(*i)->empty())
+                return true;
+        }
+        return false;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::notifyWorkers()
+    {
+        // pairs with the fence in waitForNextRequest: either we see the sleeper
+        // or it sees the request we've just queued
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (mSleepingWorkers)
+        {
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            OGRE_THREAD_NOTIFY_ONE(mRequestCondition);
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::waitForNextRequest()
+    {
+#if OGRE_THREAD_SUPPORT
+        if (hasPendingWork())
+            return;
+
+        OGRE_WQ_LOCK_MUTEX_NAMED(mRequestMutex, queueLock);
+        ++mSleepingWorkers;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!mShuttingDown && !hasPendingWork())
+        {
+            // frees lock and suspends the thread
+            OGRE_THREAD_WAIT(mRequestCondition, mRequestMutex, queueLock);
+        }
+        --mSleepingWorkers;
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::_threadMain()
+    {
+#if OGRE_THREAD_SUPPORT
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << getName() << "')::WorkerFunc - thread "
+            << OGRE_THREAD_CURRENT_ID << " starting.";
+
+        WorkerIdentity& self = tCurrentWorker;
+        self.queue = this;
+        self.index = (int)mNextWorkerIndex++;
+        self.seed = (uint32)self.index * 2654435761u + 1;
+
+        // Initialise the thread for RS if necessary
+        if (mWorkerRenderSystemAccess)
+        {
+            Root::getSingleton().getRenderSystem()->registerThread();
+            notifyThreadRegistered();
+        }
+
+        // Spin forever until we're told to shut down
+        while (!isShuttingDown())
+        {
+            waitForNextRequest();
+            _processNextRequest();
+        }
+
+        self.queue = 0;
+        self.index = -1;
+
+        LogManager::getSingleton().stream() <<
+            "WorkStealingWorkQueue('" << getName() << "')::WorkerFunc - thread "
+            << OGRE_THREAD_CURRENT_ID << " stopped.";
+#endif
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::_processNextRequest()
+    {
+        if (processIdleRequest())
+            return;
+
+        if (Request* r = acquireRequest())
+            runRequest(r, false);
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::processIdleRequest()
+    {
+        if (!mIdleCount || mIdleRunning)
+            return false;
+
+        {
+            OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+            if (mIdleRequestQueue.empty() || mIdleRunning)
+                return false;
+            mIdleRunning = true;
+        }
+
+        Request* r = 0;
+        try
+        {
+            for (;;)
+            {
+                {
+                    OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+                    if (mIdleRequestQueue.empty())
+                    {
+                        mIdleRunning = false;
+                        return true;
+                    }
+                    r = mIdleRequestQueue.front();
+                    mIdleRequestQueue.pop_front();
+                    --mIdleCount;
+                }
+                runRequest(r, false);
+            }
+        }
+        catch (...) // Normally this should not happen.
+        {
+            // It is very important to clean up or the idle thread will be locked forever!
+            OGRE_WQ_LOCK_MUTEX(mIdleMutex);
+            mIdleRunning = false;
+            LogManager::getSingleton().stream() << "Exception caught in top of worker thread!";
+            return true;
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::runRequest(Request* r, bool synchronous)
+    {
+        markRequestStarted(r);
+
+        Response* response = processRequest(r);
+
+        if (!response)
+        {
+            if (!r->getAborted())
+            {
+                LogManager::getSingleton().stream(LML_WARNING) <<
+                    "WorkStealingWorkQueue('" << mName << "') warning: no handler processed request "
+                    << r->getID() << ", channel " << r->getChannel()
+                    << ", type " << r->getType();
+            }
+            unregisterRequest(r);
+            OGRE_DELETE r;
+            return;
+        }
+
+        if (!response->succeeded())
+        {
+            // Failed, should we retry?
+            const Request* req = response->getRequest();
+            if (req->getRetryCount())
+            {
+                if (!mShuttingDown)
+                {
+                    Request* retry = OGRE_NEW Request(req->getChannel(), req->getType(),
+                        req->getData(), req->getRetryCount() - 1, req->getID());
+                    // replaces the record of the failed request
+                    registerRequest(retry);
+#if OGRE_THREAD_SUPPORT
+                    enqueueRequest(retry);
+#else
+                    runRequest(retry, true);
+#endif
+                }
+                // discard response (this also deletes request)
+                destroyResponse(response);
+                return;
+            }
+        }
+
+        if (synchronous)
+        {
+            processResponse(response);
+            destroyResponse(response);
+        }
+        else
+        {
+            // Queue response, processed by the main thread
+            OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+            mResponseQueue.push_back(response);
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::processResponses()
+    {
+        unsigned long msStart = Root::getSingleton().getTimer()->getMilliseconds();
+        unsigned long msCurrent = 0;
+
+        // keep going until we run out of responses or out of time
+        for (;;)
+        {
+            Response* response = 0;
+            {
+                OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+
+                if (mResponseQueue.empty())
+                    break;
+
+                response = mResponseQueue.front();
+                mResponseQueue.pop_front();
+            }
+
+            if (response->getRequest()->getAborted())
+            {
+                // destroy response user data
+                response->abortRequest();
+            }
+            processResponse(response);
+            destroyResponse(response);
+
+            // time limit
+            if (mResposeTimeLimitMS)
+            {
+                msCurrent = Root::getSingleton().getTimer()->getMilliseconds();
+                if (msCurrent - msStart > mResposeTimeLimitMS)
+                    break;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::destroyResponse(Response* r)
+    {
+        unregisterRequest(r->getRequest());
+        OGRE_DELETE r;
+    }
+    //---------------------------------------------------------------------
+    WorkStealingWorkQueue::RequestShard& WorkStealingWorkQueue::getShard(RequestID id) const
+    {
+        return mRequestShards[id % REQUEST_SHARD_COUNT];
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::registerRequest(Request* r)
+    {
+        RequestShard& shard = getShard(r->getID());
+        RequestShard::Record record = { r, false };
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        shard.records[r->getID()] = record;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::unregisterRequest(const Request* r)
+    {
+        RequestShard& shard = getShard(r->getID());
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        RequestShard::RecordMap::iterator i = shard.records.find(r->getID());
+        // a retry may have taken over the ID already
+        if (i != shard.records.end() && i->second.request == r)
+            shard.records.erase(i);
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::markRequestStarted(const Request* r)
+    {
+        RequestShard& shard = getShard(r->getID());
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        RequestShard::RecordMap::iterator i = shard.records.find(r->getID());
+        if (i != shard.records.end() && i->second.request == r)
+            i->second.started = true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequest(RequestID id)
+    {
+        RequestShard& shard = getShard(id);
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        RequestShard::RecordMap::iterator i = shard.records.find(id);
+        if (i != shard.records.end())
+            i->second.request->abortRequest();
+    }
+    //---------------------------------------------------------------------
+    bool WorkStealingWorkQueue::abortPendingRequest(RequestID id)
+    {
+        RequestShard& shard = getShard(id);
+
+        OGRE_WQ_LOCK_MUTEX(shard.mutex);
+        RequestShard::RecordMap::iterator i = shard.records.find(id);
+        if (i == shard.records.end() || i->second.started)
+            return false;
+
+        i->second.request->abortRequest();
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortRequestsByChannel(uint16 channel)
+    {
+        for (size_t s = 0; s < REQUEST_SHARD_COUNT; ++s)
+        {
+            RequestShard& shard = mRequestShards[s];
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            for (RequestShard::RecordMap::iterator i = shard.records.begin(); i != shard.records.end(); ++i)
+            {
+                if (i->second.request->getChannel() == channel)
+                    i->second.request->abortRequest();
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortPendingRequestsByChannel(uint16 channel)
+    {
+        for (size_t s = 0; s < REQUEST_SHARD_COUNT; ++s)
+        {
+            RequestShard& shard = mRequestShards[s];
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            for (RequestShard::RecordMap::iterator i = shard.records.begin(); i != shard.records.end(); ++i)
+            {
+                if (!i->second.started && i->second.request->getChannel() == channel)
+                    i->second.request->abortRequest();
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void WorkStealingWorkQueue::abortAllRequests()
+    {
+        for (size_t s = 0; s < REQUEST_SHARD_COUNT; ++s)
+        {
+            RequestShard& shard = mRequestShards[s];
+            OGRE_WQ_LOCK_MUTEX(shard.mutex);
+            for (RequestShard::RecordMap::iterator i = shard.records.begin(); i != shard.records.end(); ++i)
+                i->second.request->abortRequest();
+        }
+    }
+}
@@ -99,6 +99,8 @@ namespace DirectX
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -110,6 +112,9 @@ namespace Ogre {
     class _OgrePrivate OptimisedUtilDirectXMath : public OptimisedUtil
     {
     public:
+        /// @copydoc OptimisedUtil::getName
+        virtual const char* getName(void) const { return "DirectXMath"; }
+
         /// @copydoc OptimisedUtil::softwareVertexSkinning
         virtual void softwareVertexSkinning(
             const float *srcPosPtr, float *destPosPtr,
@@ -159,6 +164,14 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const float* boxes,
+            char* visibilities,
+            size_t numBoxes);
     };
 
 //---------------------------------------------------------------------
@@ -2032,6 +2045,18 @@ static OGRE_FORCE_INLINE bool _isAlignedForDirectXMath(const void *p)
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilDirectXMath::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const float* boxes,
+        char* visibilities,
+        size_t numBoxes)
+    {
+        // No DirectXMath specific version yet
+        _getOptimisedUtilGeneral()->cullAxisAlignedBoxes(
+            planes, numPlanes, boxes, visibilities, numBoxes);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilDirectXMath(void)
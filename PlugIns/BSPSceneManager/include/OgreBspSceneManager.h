@@ -69,6 +69,8 @@ namespace Ogre {
     class BspSceneManager : public SceneManager
     {
     protected:
+        /// BspSceneNode updates the shared object to leaf map, so nodes must be updated serially
+        bool supportsParallelSceneGraphUpdate(void) const { return false; }
 
         /// World geometry
         BspLevelPtr mLevel;
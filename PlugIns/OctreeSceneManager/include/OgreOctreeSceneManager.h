@@ -193,10 +193,16 @@ protected:
 
     /// The root octree
     Octree *mOctree;
+    /// Guards mOctree against concurrent node updates, see SceneManager::setParallelSceneGraphUpdate
+    OGRE_WQ_MUTEX(mOctreeMutex);
 
     /// List of boxes to be rendered
     BoxList mBoxes;
 
+    /// Scratch space for culling the nodes of partially visible octants in one batch
+    vector<const AxisAlignedBox*>::type mCullBounds;
+    vector<char>::type mCullVisibilities;
+
     /// Number of rendered objs
     int mNumObjects;
 
@@ -393,6 +393,9 @@ void OctreeSceneManager::_updateOctreeNode( OctreeNode * onode )
     if ( box.isNull() )
         return ;
 
+    // nodes may be updated on several threads at once
+    OGRE_WQ_LOCK_MUTEX(mOctreeMutex);
+
     // Skip if octree has been destroyed (shutdown conditions)
     if (!mOctree)
         return;
@@ -611,15 +614,24 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
 
         bool vis = true;
 
-        while ( it != octant -> mNodes.end() )
+        // if this octree is partially visible, manually cull all
+        // scene nodes attached directly to this level, in one batch.
+        if ( v == OctreeCamera::PARTIAL && !octant -> mNodes.empty() )
         {
-            OctreeNode * sn = *it;
+            mCullBounds.clear();
+            for ( ; it != octant -> mNodes.end(); ++it )
+                mCullBounds.push_back( &(*it) -> _getWorldAABB() );
+            mCullVisibilities.resize( mCullBounds.size() );
+            camera -> areVisible( &mCullBounds[0], mCullBounds.size(), &mCullVisibilities[0] );
+            it = octant -> mNodes.begin();
+        }
 
-            // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
+        for ( size_t index = 0; it != octant -> mNodes.end(); ++index )
+        {
+            OctreeNode * sn = *it;
 
             if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
+                vis = mCullVisibilities[ index ] != 0;
 
             if ( vis )
             {
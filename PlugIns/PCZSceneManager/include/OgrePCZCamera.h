@@ -75,6 +75,10 @@ namespace Ogre
         /* Overridden isVisible function for aabb */
         virtual bool isVisible( const AxisAlignedBox &bound, FrustumPlane *culledBy=0) const;
 
+        /* Overridden areVisible function, so the extra culling planes are used */
+        virtual void areVisible(const AxisAlignedBox* const* bounds, size_t numBounds,
+            char* visibilities) const;
+
         /* isVisible() function for portals */
         bool isVisible(PortalBase* portal, FrustumPlane* culledBy = 0) const;
 
@@ -331,6 +331,9 @@ namespace Ogre
         virtual void prepareShadowTextures(Camera* cam, Viewport* vp, const LightList* lightList = 0);
 
     protected:
+        /// PCZSceneNode updates zone membership, so nodes must be updated serially
+        bool supportsParallelSceneGraphUpdate(void) const { return false; }
+
         /// Type of default zone to be used
         String mDefaultZoneTypeName;
 
@@ -85,6 +85,13 @@ namespace Ogre
         return true;
    }
 
+    void PCZCamera::areVisible(const AxisAlignedBox* const* bounds, size_t numBounds,
+        char* visibilities) const
+    {
+        for (size_t i = 0; i < numBounds; ++i)
+            visibilities[i] = isVisible(*bounds[i]);
+    }
+
     /* A 'more detailed' check for visibility of an AAB.  This function returns
       none, partial, or full for visibility of the box.  This is useful for 
       stuff like Octree leaf culling */
@@ -376,6 +376,7 @@ namespace Ogre
     {
         D3D9_DEVICE_ACCESS_CRITICAL_SECTION
         mLoadedStreams.reset();
+        Texture::postLoadImpl();
     }   
 
     /****************************************************************************************/
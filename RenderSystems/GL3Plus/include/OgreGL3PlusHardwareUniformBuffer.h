@@ -40,6 +40,11 @@ namespace Ogre {
     private:
         GL3PlusHardwareBuffer mBuffer;
         GLint mBinding;
+        /// Where the contents were last written to in the uniform ring buffer
+        size_t mRingOffset;
+        /// Region serial of that, only valid if mInRing
+        uint64 mRingSerial;
+        bool mInRing;
 
     protected:
         void* lockImpl(size_t offset, size_t length, LockOptions options) {
@@ -67,6 +72,19 @@ namespace Ogre {
         GLuint getGLBufferId(void) const { return mBuffer.getGLBufferId(); }
         void setGLBufferBinding(GLint binding);
         GLint getGLBufferBinding(void) const { return mBinding; }
+
+        /** Gets space for new contents of this block in a uniform ring buffer, and binds
+            it to the binding point of this buffer instead of the buffer itself.
+        @return Where to write the contents to, or NULL if the block is too large for
+            the ring, in which case this buffer is bound again and has to be written to
+        */
+        void* _allocateRingRange(GL3PlusUniformRingBuffer* ring);
+
+        /** Binds the contents last written with _allocateRingRange again
+        @return false if there are none, or the ring moved on to another region since,
+            in which case the contents have to be written to a new range
+        */
+        bool _bindRingRange(GL3PlusUniformRingBuffer* ring);
     };
 }
 #endif // __GL3PlusHARDWAREUNIFORMBUFFER_H__
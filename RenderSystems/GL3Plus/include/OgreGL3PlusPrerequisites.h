@@ -40,6 +40,7 @@ namespace Ogre {
     typedef GLRTTManager GL3PlusRTTManager;
     class GL3PlusRenderSystem;
     class GL3PlusStateCacheManager;
+    class GL3PlusUniformRingBuffer;
     class GL3PlusSupport;
     class GL3PlusTexture;
     class GL3PlusTextureManager;
@@ -108,6 +108,11 @@ namespace Ogre {
         */
         GLRTTManager *mRTTManager;
 
+        /// Where uniform blocks are written to, if the "Uniform Ring Buffer" option is used
+        GL3PlusUniformRingBuffer* mUniformRingBuffer;
+        /// Size of each of its regions, enough for the uniform blocks of a frame
+        static const size_t UNIFORM_RING_REGION_SIZE = 4 * 1024 * 1024;
+
         /** These variables are used for caching RenderSystem state.
             They are cached because OpenGL state changes can be quite expensive,
             which is especially important on mobile or embedded systems.
@@ -230,6 +235,9 @@ namespace Ogre {
 
         void _endFrame(void);
 
+        /// @copydoc RenderSystem::_swapAllRenderTargetBuffers
+        void _swapAllRenderTargetBuffers();
+
         void _setCullingMode(CullingMode mode);
 
         void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true, CompareFunction depthFunction = CMPF_LESS_EQUAL);
@@ -291,6 +299,11 @@ namespace Ogre {
 
         GL3PlusStateCacheManager * _getStateCacheManager() { return mStateCacheManager; }
 
+        /** The persistently mapped buffer uniform blocks are suballocated from, or NULL
+            if the "Uniform Ring Buffer" option is off or not supported
+        */
+        GL3PlusUniformRingBuffer* _getUniformRingBuffer() { return mUniformRingBuffer; }
+
         /** Create VAO on current context */
         uint32 _createVao();
         /** Bind VAO, context should be equal to current context, as VAOs are not shared  */
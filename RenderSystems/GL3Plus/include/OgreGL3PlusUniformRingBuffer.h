@@ -0,0 +1,106 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __GL3PlusUniformRingBuffer_H__
+#define __GL3PlusUniformRingBuffer_H__
+
+#include "OgreGL3PlusPrerequisites.h"
+
+namespace Ogre {
+
+    /** A large uniform buffer that stays mapped for its whole lifetime, from which
+        the contents of uniform blocks are suballocated.
+    @remarks
+        The buffer is split into regions that are filled one after another. Once the
+        draws reading a region were issued, it is protected by a fence and only written
+        to again after the GPU passed that fence. So writing a block never has to wait
+        for the driver, and using it is a single glBindBufferRange call.
+        Requires GL 4.4 or GL_ARB_buffer_storage.
+    */
+    class _OgreGL3PlusExport GL3PlusUniformRingBuffer : public BufferAlloc
+    {
+    public:
+        /** Creates and maps the buffer, which must be done with a context current
+        @param regionSize Size of each region in bytes
+        @param numRegions Number of regions, i.e. how many frames may be in flight
+        */
+        GL3PlusUniformRingBuffer(GL3PlusRenderSystem* renderSystem, size_t regionSize, size_t numRegions = 3);
+        ~GL3PlusUniformRingBuffer();
+
+        /** Reserves space for a uniform block in the current region.
+        @param length Size of the block in bytes
+        @param offset Set to the offset of the block in the buffer
+        @return Where to write the block contents to, or NULL if the block does not fit in a region
+        */
+        void* allocate(size_t length, size_t& offset);
+
+        /// Binds a block returned by allocate to a uniform buffer binding point
+        void bindRange(GLuint binding, size_t offset, size_t length);
+
+        /** Fences the current region and starts the next one.
+        @remarks
+            Called once all render targets of a frame were updated, and by allocate
+            when the current region is full. Waits until the GPU is done with the
+            next region if needed.
+        */
+        void _nextRegion(void);
+
+        /// The number of regions started so far
+        uint64 getRegionSerial(void) const { return mRegionSerial; }
+
+        /** Whether blocks allocated while getRegionSerial returned the given value
+            may be bound again.
+        @remarks
+            Only true for the current region: the fence of an older region was set
+            when it ended, so draws binding its blocks afterwards would not be covered
+            by it and the region could be overwritten while they still read it.
+        */
+        bool isCurrentRegion(uint64 serial) const { return serial == mRegionSerial; }
+
+        GLuint getGLBufferId(void) const { return mBufferId; }
+        size_t getSizeInBytes(void) const { return mRegionSize * mNumRegions; }
+
+    private:
+        GL3PlusRenderSystem* mRenderSystem;
+        GLuint mBufferId;
+        uchar* mMappedData;
+        size_t mRegionSize;
+        size_t mNumRegions;
+        /// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+        size_t mAlignment;
+        /// The current region is mRegionSerial % mNumRegions
+        uint64 mRegionSerial;
+        /// Write position in the current region
+        size_t mRegionOffset;
+        /// Fences of the regions the GPU might still read from
+        vector<GLsync>::type mFences;
+
+        void waitForRegion(size_t region);
+    };
+}
+
+#endif // __GL3PlusUniformRingBuffer_H__
@@ -31,10 +31,12 @@
 #include "OgreGLSLShader.h"
 #include "OgreGLSLProgramManager.h"
 #include "OgreGL3PlusRenderSystem.h"
+#include "OgreGL3PlusUniformRingBuffer.h"
 #include "OgreStringVector.h"
 #include "OgreLogManager.h"
 #include "OgreGpuProgramManager.h"
 #include "OgreStringConverter.h"
+#include "OgreRoot.h"
 
 namespace Ogre {
 
@@ -433,6 +435,9 @@ namespace Ogre {
 
         const GpuProgramParameters::GpuSharedParamUsageList& sharedParams = params->getSharedParameters();
 
+        GL3PlusUniformRingBuffer* ring =
+            static_cast<GL3PlusRenderSystem*>(Root::getSingleton().getRenderSystem())->_getUniformRingBuffer();
+
         GpuProgramParameters::GpuSharedParamUsageList::const_iterator it, end = sharedParams.end();
         for (it = sharedParams.begin(); it != end; ++it)
         {
@@ -446,7 +451,16 @@ namespace Ogre {
                 OGRE_CHECK_GL_ERROR(UniformTransform = glGetUniformBlockIndex(mGLProgramHandle, it->getName().c_str()));
                 OGRE_CHECK_GL_ERROR(glUniformBlockBinding(mGLProgramHandle, UniformTransform, hwGlBuffer->getGLBufferBinding()));
 
-                hwGlBuffer->writeData(0, hwGlBuffer->getSizeInBytes(), &paramsPtr->getFloatConstantList().front());
+                const FloatConstantList& data = paramsPtr->getFloatConstantList();
+                if (void* ringData = ring ? hwGlBuffer->_allocateRingRange(ring) : NULL)
+                {
+                    // a fresh range of the ring, so no waiting for draws using the previous contents
+                    memcpy(ringData, &data.front(),
+                           std::min(hwGlBuffer->getSizeInBytes(), data.size() * sizeof(float)));
+                    continue;
+                }
+
+                hwGlBuffer->writeData(0, hwGlBuffer->getSizeInBytes(), &data.front());
             }
         }
     }
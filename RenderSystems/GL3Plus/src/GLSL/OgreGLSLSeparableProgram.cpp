@@ -35,6 +35,9 @@
 #include "OgreLogManager.h"
 #include "OgreGLUniformCache.h"
 #include "OgreGL3PlusStateCacheManager.h"
+#include "OgreGL3PlusRenderSystem.h"
+#include "OgreGL3PlusUniformRingBuffer.h"
+#include "OgreRoot.h"
 
 namespace Ogre
 {
@@ -615,15 +618,29 @@ namespace Ogre
         // const GpuProgramParameters::GpuSharedParamUsageList& sharedParams = params->getSharedParameters();
         // GpuProgramParameters::GpuSharedParamUsageList::const_iterator it, end = sharedParams.end();
 
+        GL3PlusUniformRingBuffer* ring =
+            static_cast<GL3PlusRenderSystem*>(Root::getSingleton().getRenderSystem())->_getUniformRingBuffer();
+
         for (; currentPair != endPair; ++currentPair)
         {
             // force const call to get*Pointer
             const GpuSharedParameters* paramsPtr = currentPair->first.get();
 
             //FIXME Possible buffer does not exist if no associated uniform block.
-            HardwareUniformBuffer* hwGlBuffer = currentPair->second.get();
+            GL3PlusHardwareUniformBuffer* hwGlBuffer =
+                static_cast<GL3PlusHardwareUniformBuffer*>(currentPair->second.get());
 
-            if (!paramsPtr->isDirty()) continue;
+            // With a ring buffer the block is written to a fresh range of it, so the
+            // driver never has to wait for draws still using the previous contents
+            uchar* ringData = NULL;
+            if (ring)
+            {
+                // also rebind unchanged blocks, the binding point is shared with other programs
+                if (!paramsPtr->isDirty() && hwGlBuffer->_bindRingRange(ring))
+                    continue;
+                ringData = static_cast<uchar*>(hwGlBuffer->_allocateRingRange(ring));
+            }
+            else if (!paramsPtr->isDirty()) continue;
 
             //FIXME does not check if current progrtype, or if shared param is active
 
@@ -673,7 +690,14 @@ namespace Ogre
 
                 // NOTE: the naming is backward. this is the physical offset in bytes
                 size_t offset = param->logicalIndex;
-                hwGlBuffer->writeData(offset, length, dataPtr);
+                if (ringData)
+                {
+                    if (offset < hwGlBuffer->getSizeInBytes())
+                        memcpy(ringData + offset, dataPtr,
+                               std::min(length, hwGlBuffer->getSizeInBytes() - offset));
+                }
+                else
+                    hwGlBuffer->writeData(offset, length, dataPtr);
             }
         }
     }
@@ -28,6 +28,7 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 
 #include "OgreGL3PlusHardwareBufferManager.h"
 #include "OgreGL3PlusHardwareUniformBuffer.h"
+#include "OgreGL3PlusUniformRingBuffer.h"
 
 namespace Ogre {
     GL3PlusHardwareUniformBuffer::GL3PlusHardwareUniformBuffer(
@@ -37,7 +38,10 @@ namespace Ogre {
         bool useShadowBuffer, const String& name)
         : HardwareUniformBuffer(mgr, bufferSize, usage, useShadowBuffer, name),
           mBuffer(GL_UNIFORM_BUFFER, mSizeInBytes, usage),
-          mBinding(0)
+          mBinding(0),
+          mRingOffset(0),
+          mRingSerial(0),
+          mInRing(false)
     {
     }
 
@@ -49,6 +53,32 @@ namespace Ogre {
         OGRE_CHECK_GL_ERROR(glBindBufferBase(GL_UNIFORM_BUFFER, mBinding, getGLBufferId()));
     }
 
+    void* GL3PlusHardwareUniformBuffer::_allocateRingRange(GL3PlusUniformRingBuffer* ring)
+    {
+        void* data = ring->allocate(mSizeInBytes, mRingOffset);
+        if (!data)
+        {
+            // the binding point might be taken by a ring range of another block
+            mInRing = false;
+            setGLBufferBinding(mBinding);
+            return NULL;
+        }
+
+        mRingSerial = ring->getRegionSerial();
+        mInRing = true;
+        ring->bindRange(mBinding, mRingOffset, mSizeInBytes);
+        return data;
+    }
+
+    bool GL3PlusHardwareUniformBuffer::_bindRingRange(GL3PlusUniformRingBuffer* ring)
+    {
+        if (!mInRing || !ring->isCurrentRegion(mRingSerial))
+            return false;
+
+        ring->bindRange(mBinding, mRingOffset, mSizeInBytes);
+        return true;
+    }
+
     void GL3PlusHardwareUniformBuffer::readData(size_t offset, size_t length, void* pDest)
     {
         mBuffer.readData(offset, length, pDest);
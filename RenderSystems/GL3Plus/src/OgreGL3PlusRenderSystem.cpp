@@ -60,6 +60,7 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 #include "OgreViewport.h"
 #include "OgreGL3PlusPixelFormat.h"
 #include "OgreGL3PlusStateCacheManager.h"
+#include "OgreGL3PlusUniformRingBuffer.h"
 #include "OgreGLSLProgramCommon.h"
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_APPLE
@@ -137,6 +138,7 @@ namespace Ogre {
           mGLSLShaderFactory(0),
           mHardwareBufferManager(0),
           mRTTManager(0),
+          mUniformRingBuffer(0),
           mActiveTextureUnit(0)
     {
         size_t i;
@@ -189,6 +191,14 @@ namespace Ogre {
     void GL3PlusRenderSystem::initConfigOptions(void)
     {
         mGLSupport->addConfig();
+
+        ConfigOption optRingBuffer;
+        optRingBuffer.name = "Uniform Ring Buffer";
+        optRingBuffer.possibleValues.push_back("No");
+        optRingBuffer.possibleValues.push_back("Yes");
+        optRingBuffer.currentValue = optRingBuffer.possibleValues[0];
+        optRingBuffer.immutable = false;
+        mGLSupport->getConfigOptions()[optRingBuffer.name] = optRingBuffer;
     }
 
     ConfigOptionMap& GL3PlusRenderSystem::getConfigOptions(void)
@@ -566,6 +576,16 @@ namespace Ogre {
             mShaderManager->setSaveMicrocodesToCache(true);
         }
 
+        ConfigOptionMap::iterator opt = getConfigOptions().find("Uniform Ring Buffer");
+        if (opt != getConfigOptions().end() && opt->second.currentValue == "Yes")
+        {
+            if (hasMinGLVersion(4, 4) || checkExtension("GL_ARB_buffer_storage"))
+                mUniformRingBuffer = OGRE_NEW GL3PlusUniformRingBuffer(this, UNIFORM_RING_REGION_SIZE);
+            else
+                LogManager::getSingleton().logMessage(
+                    "GL3+: Uniform Ring Buffer needs GL_ARB_buffer_storage, updating uniform buffers in place");
+        }
+
         mGLInitialised = true;
     }
 
@@ -584,6 +604,9 @@ namespace Ogre {
         }
 
         // Deleting the GPU program manager and hardware buffer manager.  Has to be done before the mGLSupport->stop().
+        OGRE_DELETE mUniformRingBuffer;
+        mUniformRingBuffer = 0;
+
         OGRE_DELETE mShaderManager;
         mShaderManager = 0;
 
@@ -1125,6 +1148,16 @@ namespace Ogre {
         mStateCacheManager->setEnabled(GL_SCISSOR_TEST, true);
     }
 
+    void GL3PlusRenderSystem::_swapAllRenderTargetBuffers()
+    {
+        RenderSystem::_swapAllRenderTargetBuffers();
+
+        // the uniform blocks of all viewports of this frame were submitted,
+        // _endFrame is too early as it runs once per viewport
+        if (mUniformRingBuffer)
+            mUniformRingBuffer->_nextRegion();
+    }
+
     void GL3PlusRenderSystem::_endFrame(void)
     {
         // Deactivate the viewport clipping.
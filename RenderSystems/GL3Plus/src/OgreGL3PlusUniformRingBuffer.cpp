@@ -0,0 +1,147 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreGL3PlusUniformRingBuffer.h"
+#include "OgreGL3PlusRenderSystem.h"
+#include "OgreGL3PlusStateCacheManager.h"
+#include "OgreLogManager.h"
+
+namespace Ogre {
+
+    GL3PlusUniformRingBuffer::GL3PlusUniformRingBuffer(GL3PlusRenderSystem* renderSystem,
+                                                       size_t regionSize, size_t numRegions)
+        : mRenderSystem(renderSystem)
+        , mBufferId(0)
+        , mMappedData(0)
+        , mNumRegions(numRegions)
+        , mRegionSerial(0)
+        , mRegionOffset(0)
+        , mFences(numRegions, (GLsync)0)
+    {
+        GLint alignment = 256;
+        OGRE_CHECK_GL_ERROR(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+        mAlignment = std::max<GLint>(alignment, 1);
+        // keep every region start aligned
+        mRegionSize = (regionSize + mAlignment - 1) / mAlignment * mAlignment;
+
+        OGRE_CHECK_GL_ERROR(glGenBuffers(1, &mBufferId));
+        if (!mBufferId)
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                        "Cannot create GL uniform buffer",
+                        "GL3PlusUniformRingBuffer::GL3PlusUniformRingBuffer");
+        }
+
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        mRenderSystem->_getStateCacheManager()->bindGLBuffer(GL_UNIFORM_BUFFER, mBufferId);
+        OGRE_CHECK_GL_ERROR(glBufferStorage(GL_UNIFORM_BUFFER, getSizeInBytes(), NULL, flags));
+        OGRE_CHECK_GL_ERROR(mMappedData = static_cast<uchar*>(
+            glMapBufferRange(GL_UNIFORM_BUFFER, 0, getSizeInBytes(), flags)));
+
+        if (!mMappedData)
+        {
+            mRenderSystem->_getStateCacheManager()->deleteGLBuffer(GL_UNIFORM_BUFFER, mBufferId);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                        "Cannot map GL uniform buffer persistently",
+                        "GL3PlusUniformRingBuffer::GL3PlusUniformRingBuffer");
+        }
+
+        LogManager::getSingleton().stream()
+            << "GL3+: Using a " << mNumRegions << " x " << mRegionSize / 1024
+            << " KiB persistently mapped uniform ring buffer";
+    }
+
+    GL3PlusUniformRingBuffer::~GL3PlusUniformRingBuffer()
+    {
+        for (size_t i = 0; i < mNumRegions; ++i)
+        {
+            if (mFences[i])
+                OGRE_CHECK_GL_ERROR(glDeleteSync(mFences[i]));
+        }
+
+        GL3PlusStateCacheManager* stateCacheManager = mRenderSystem->_getStateCacheManager();
+        stateCacheManager->bindGLBuffer(GL_UNIFORM_BUFFER, mBufferId);
+        OGRE_CHECK_GL_ERROR(glUnmapBuffer(GL_UNIFORM_BUFFER));
+        stateCacheManager->deleteGLBuffer(GL_UNIFORM_BUFFER, mBufferId);
+    }
+
+    void* GL3PlusUniformRingBuffer::allocate(size_t length, size_t& offset)
+    {
+        if (length > mRegionSize)
+            return NULL;
+
+        size_t start = (mRegionOffset + mAlignment - 1) / mAlignment * mAlignment;
+        if (start + length > mRegionSize)
+        {
+            _nextRegion();
+            start = 0;
+        }
+
+        mRegionOffset = start + length;
+        offset = (mRegionSerial % mNumRegions) * mRegionSize + start;
+        return mMappedData + offset;
+    }
+
+    void GL3PlusUniformRingBuffer::bindRange(GLuint binding, size_t offset, size_t length)
+    {
+        // glBindBufferRange also changes the generic binding, so let the cache know
+        mRenderSystem->_getStateCacheManager()->bindGLBuffer(GL_UNIFORM_BUFFER, mBufferId);
+        OGRE_CHECK_GL_ERROR(glBindBufferRange(GL_UNIFORM_BUFFER, binding, mBufferId, offset, length));
+    }
+
+    void GL3PlusUniformRingBuffer::_nextRegion(void)
+    {
+        // nothing was written, so the current region can be used further
+        if (mRegionOffset == 0)
+            return;
+
+        size_t region = mRegionSerial % mNumRegions;
+        OGRE_CHECK_GL_ERROR(mFences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+        ++mRegionSerial;
+        mRegionOffset = 0;
+        waitForRegion(mRegionSerial % mNumRegions);
+    }
+
+    void GL3PlusUniformRingBuffer::waitForRegion(size_t region)
+    {
+        GLsync fence = mFences[region];
+        if (!fence)
+            return;
+
+        GLenum result;
+        do
+        {
+            // one second at a time, flushing so the fence is guaranteed to signal
+            OGRE_CHECK_GL_ERROR(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        OGRE_CHECK_GL_ERROR(glDeleteSync(fence));
+        mFences[region] = 0;
+    }
+}
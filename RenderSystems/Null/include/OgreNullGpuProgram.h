@@ -0,0 +1,109 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullGpuProgram_H__
+#define __NullGpuProgram_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreHighLevelGpuProgram.h"
+#include "OgreHighLevelGpuProgramManager.h"
+
+namespace Ogre {
+
+    /// Assembler program that is accepted but never compiled
+    class _OgreNullExport NullGpuProgram : public GpuProgram
+    {
+    public:
+        NullGpuProgram(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader);
+    protected:
+        void loadFromSource(void) {}
+        void unloadImpl(void) {}
+    };
+
+    /** High level program that is accepted but never compiled.
+
+        The constant definitions are built by scanning the source for
+        declarations using the @c uniform keyword, so named parameters and
+        auto constants of GLSL programs and of HLSL and Cg programs declaring
+        their uniforms explicitly resolve like they would on a real device.
+    */
+    class _OgreNullExport NullHighLevelGpuProgram : public HighLevelGpuProgram
+    {
+    public:
+        NullHighLevelGpuProgram(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader,
+            const String& language);
+        ~NullHighLevelGpuProgram();
+
+        /// Overridden, the program binds itself
+        GpuProgram* _getBindingDelegate(void) { return this; }
+        const String& getLanguage(void) const { return mLanguage; }
+    protected:
+        void loadFromSource(void) {}
+        void createLowLevelImpl(void) {}
+        void unloadHighLevelImpl(void) {}
+        void buildConstantDefinitions() const;
+
+        String mLanguage;
+    };
+
+    /// Creates NullHighLevelGpuProgram instances for one language
+    class _OgreNullExport NullHighLevelGpuProgramFactory : public HighLevelGpuProgramFactory
+    {
+    public:
+        NullHighLevelGpuProgramFactory(const String& language) : mLanguage(language) {}
+
+        const String& getLanguage(void) const { return mLanguage; }
+        HighLevelGpuProgram* create(ResourceManager* creator,
+            const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader);
+        void destroy(HighLevelGpuProgram* prog);
+    protected:
+        String mLanguage;
+    };
+
+    /// Creates NullGpuProgram instances
+    class _OgreNullExport NullGpuProgramManager : public GpuProgramManager
+    {
+    protected:
+        /// @copydoc ResourceManager::createImpl
+        Resource* createImpl(const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader,
+            const NameValuePairList* createParams);
+        /// Specialised create method with specific parameters
+        Resource* createImpl(const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader,
+            GpuProgramType gptype, const String& syntaxCode);
+    public:
+        NullGpuProgramManager();
+        ~NullGpuProgramManager();
+    };
+}
+
+#endif
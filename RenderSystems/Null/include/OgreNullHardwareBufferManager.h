@@ -0,0 +1,119 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwareBufferManager_H__
+#define __NullHardwareBufferManager_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreNullRenderSystem.h"
+
+namespace Ogre {
+
+    /** System memory buffer that reports the bytes written to it to the
+        NullRenderSystem.
+
+        Everything but the accounting is done by the default buffer
+        implementation it derives from.
+    */
+    template<class BufferType> class NullHardwareBuffer : public BufferType
+    {
+    public:
+        template<typename... Args>
+        NullHardwareBuffer(NullRenderSystem* renderSystem, Args... args)
+            : BufferType(args...), mRenderSystem(renderSystem), mLockedBytes(0)
+        {
+        }
+
+        using BufferType::lock;
+
+        void* lock(size_t offset, size_t length, HardwareBuffer::LockOptions options)
+        {
+            mLockedBytes = options == HardwareBuffer::HBL_READ_ONLY ? 0 : length;
+            // the system memory lock() bypasses the accounting in HardwareBuffer::lock
+            HardwareBuffer::_notifyLocked(options, length);
+            return BufferType::lock(offset, length, options);
+        }
+
+        void unlock(void)
+        {
+            BufferType::unlock();
+            mRenderSystem->_notifyBytesUploaded(mLockedBytes);
+            mLockedBytes = 0;
+        }
+
+        void writeData(size_t offset, size_t length, const void* pSource,
+                bool discardWholeBuffer = false)
+        {
+            BufferType::writeData(offset, length, pSource, discardWholeBuffer);
+            mRenderSystem->_notifyBytesUploaded(length);
+        }
+    protected:
+        NullRenderSystem* mRenderSystem;
+        /// Bytes that will be uploaded on unlock
+        size_t mLockedBytes;
+    };
+
+    typedef NullHardwareBuffer<DefaultHardwareVertexBuffer> NullHardwareVertexBuffer;
+    typedef NullHardwareBuffer<DefaultHardwareIndexBuffer> NullHardwareIndexBuffer;
+    typedef NullHardwareBuffer<DefaultHardwareUniformBuffer> NullHardwareUniformBuffer;
+
+    /// Creates the system memory buffers of the NullRenderSystem
+    class _OgreNullExport NullHardwareBufferManagerBase : public DefaultHardwareBufferManagerBase
+    {
+    public:
+        NullHardwareBufferManagerBase(NullRenderSystem* renderSystem);
+
+        HardwareVertexBufferSharedPtr
+            createVertexBuffer(size_t vertexSize, size_t numVerts,
+                HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+        HardwareIndexBufferSharedPtr
+            createIndexBuffer(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+                HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+        HardwareUniformBufferSharedPtr createUniformBuffer(size_t sizeBytes,
+                HardwareBuffer::Usage usage = HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE,
+                bool useShadowBuffer = false, const String& name = "");
+    protected:
+        NullRenderSystem* mRenderSystem;
+    };
+
+    /// NullHardwareBufferManagerBase as a Singleton
+    class _OgreNullExport NullHardwareBufferManager : public HardwareBufferManager
+    {
+    public:
+        NullHardwareBufferManager(NullRenderSystem* renderSystem)
+            : HardwareBufferManager(OGRE_NEW NullHardwareBufferManagerBase(renderSystem))
+        {
+        }
+        ~NullHardwareBufferManager()
+        {
+            OGRE_DELETE mImpl;
+        }
+    };
+}
+
+#endif
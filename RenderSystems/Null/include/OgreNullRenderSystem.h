@@ -0,0 +1,209 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystem_H__
+#define __NullRenderSystem_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderSystem.h"
+
+#include <atomic>
+
+namespace Ogre {
+    /** \addtogroup RenderSystems RenderSystems
+    *  @{
+    */
+    /** \defgroup Null Null
+    * RenderSystem that does not render anything
+    *  @{
+    */
+    /** RenderSystem that accepts every rendering call without touching a GPU.
+
+        Render targets and textures live in system memory, gpu programs are
+        accepted without being compiled and draw calls only update counters.
+        This allows running the complete CPU side of the frame (scene graph
+        update, culling, render queue sorting, auto constant updates and
+        compositors) on machines without a graphics device, e.g. to profile or
+        benchmark it.
+
+        The work submitted by the engine is counted, see getStatistics.
+    */
+    class _OgreNullExport NullRenderSystem : public RenderSystem
+    {
+    public:
+        /// Counters of the work submitted to the render system
+        struct Statistics
+        {
+            /// Draw calls, i.e. render operations times pass iterations
+            size_t drawCalls;
+            /// Calls to the render state setters (blending, depth, stencil, culling, ...)
+            size_t stateChanges;
+            /// Texture units bound or disabled
+            size_t textureBinds;
+            /// Gpu programs bound
+            size_t programBinds;
+            /// Gpu program parameter sets uploaded
+            size_t parameterUploads;
+            /// Render target and viewport switches
+            size_t renderTargetChanges;
+            /// Frame buffer clears
+            size_t clears;
+            /** Bytes written to hardware buffers, textures and gpu program
+                constants. Updated from any thread. */
+            size_t bytesUploaded;
+        };
+
+        NullRenderSystem();
+        ~NullRenderSystem();
+
+        /** Returns the work submitted since the last call to resetStatistics.
+        */
+        Statistics getStatistics() const;
+
+        /** Resets all counters, e.g. at the start of each frame.
+        */
+        void resetStatistics();
+
+        /// Adds to the Statistics::bytesUploaded counter
+        void _notifyBytesUploaded(size_t bytes) { mBytesUploaded += bytes; }
+
+        const String& getName(void) const;
+        ConfigOptionMap& getConfigOptions(void) { return mOptions; }
+        void setConfigOption(const String &name, const String &value);
+        String validateConfigOptions(void);
+
+        HardwareOcclusionQuery* createHardwareOcclusionQuery(void);
+
+        RenderWindow* _initialise(bool autoCreateWindow, const String& windowTitle = "OGRE Render Window");
+        RenderSystemCapabilities* createRenderSystemCapabilities() const;
+        void reinitialise(void);
+        void shutdown(void);
+
+        RenderWindow* _createRenderWindow(const String &name, unsigned int width, unsigned int height,
+            bool fullScreen, const NameValuePairList *miscParams = 0);
+        MultiRenderTarget* createMultiRenderTarget(const String & name);
+        DepthBuffer* _createDepthBufferFor(RenderTarget *renderTarget);
+
+        void _setTexture(size_t unit, bool enabled, const TexturePtr &texPtr);
+        void _setTextureCoordSet(size_t unit, size_t index);
+        void _setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter);
+        void _setTextureUnitCompareEnabled(size_t unit, bool compare);
+        void _setTextureUnitCompareFunction(size_t unit, CompareFunction function);
+        void _setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy);
+        void _setTextureAddressingMode(size_t unit, const TextureUnitState::UVWAddressingMode& uvw);
+        void _setTextureBorderColour(size_t unit, const ColourValue& colour);
+        void _setTextureMipmapBias(size_t unit, float bias);
+
+        void _setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor, SceneBlendOperation op = SBO_ADD);
+        void _setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor, SceneBlendFactor sourceFactorAlpha,
+            SceneBlendFactor destFactorAlpha, SceneBlendOperation op = SBO_ADD, SceneBlendOperation alphaOp = SBO_ADD);
+        void _setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage);
+
+        void _beginFrame(void) {}
+        void _endFrame(void) {}
+        void _setViewport(Viewport *vp);
+        void _setRenderTarget(RenderTarget *target);
+
+        void _setCullingMode(CullingMode mode);
+        void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true, CompareFunction depthFunction = CMPF_LESS_EQUAL);
+        void _setDepthBufferCheckEnabled(bool enabled = true);
+        void _setDepthBufferWriteEnabled(bool enabled = true);
+        void _setDepthBufferFunction(CompareFunction func = CMPF_LESS_EQUAL);
+        void _setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha);
+        void _setDepthBias(float constantBias, float slopeScaleBias = 0.0f);
+        void _setPolygonMode(PolygonMode level);
+        void setStencilCheckEnabled(bool enabled);
+        void setStencilBufferParams(CompareFunction func = CMPF_ALWAYS_PASS,
+            uint32 refValue = 0, uint32 compareMask = 0xFFFFFFFF, uint32 writeMask = 0xFFFFFFFF,
+            StencilOperation stencilFailOp = SOP_KEEP,
+            StencilOperation depthFailOp = SOP_KEEP,
+            StencilOperation passOp = SOP_KEEP,
+            bool twoSidedOperation = false,
+            bool readBackAsTexture = false);
+        void setScissorTest(bool enabled, size_t left = 0, size_t top = 0,
+            size_t right = 800, size_t bottom = 600);
+
+        VertexElementType getColourVertexElementType(void) const { return VET_COLOUR_ABGR; }
+        void _convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest, bool forGpuProgram = false);
+        void _makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+            Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram = false);
+        void _makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+            Matrix4& dest, bool forGpuProgram = false);
+        void _applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane, bool forGpuProgram);
+
+        void _render(const RenderOperation& op);
+
+        void bindGpuProgram(GpuProgram* prg);
+        void unbindGpuProgram(GpuProgramType gptype);
+        void bindGpuProgramParameters(GpuProgramType gptype,
+            GpuProgramParametersSharedPtr params, uint16 variabilityMask);
+        void bindGpuProgramPassIterationParameters(GpuProgramType gptype);
+
+        void clearFrameBuffer(unsigned int buffers,
+            const ColourValue& colour = ColourValue::Black,
+            Real depth = 1.0f, unsigned short stencil = 0);
+
+        // Same conventions as OpenGL
+        Real getHorizontalTexelOffset(void) { return 0.0f; }
+        Real getVerticalTexelOffset(void) { return 0.0f; }
+        Real getMinimumDepthInputValue(void) { return -1.0f; }
+        Real getMaximumDepthInputValue(void) { return 1.0f; }
+
+        void preExtraThreadsStarted() {}
+        void postExtraThreadsStarted() {}
+        void registerThread() {}
+        void unregisterThread() {}
+        unsigned int getDisplayMonitorCount() const { return 1; }
+
+        void beginProfileEvent(const String &eventName) {}
+        void endProfileEvent(void) {}
+        void markProfileEvent(const String &event) {}
+
+        bool hasAnisotropicMipMapFilter() const { return true; }
+    protected:
+        void setClipPlanesImpl(const PlaneList& clipPlanes);
+        void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary);
+
+        ConfigOptionMap mOptions;
+
+        NullHardwareBufferManager* mHardwareBufferManager;
+        NullGpuProgramManager* mGpuProgramManager;
+        typedef vector<HighLevelGpuProgramFactory*>::type ProgramFactoryList;
+        ProgramFactoryList mProgramFactories;
+
+        bool mInitialised;
+
+        Statistics mStats;
+        std::atomic<size_t> mBytesUploaded;
+    };
+    /** @} */
+    /** @} */
+}
+
+#endif
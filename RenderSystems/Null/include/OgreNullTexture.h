@@ -0,0 +1,125 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullTexture_H__
+#define __NullTexture_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreTexture.h"
+#include "OgreTextureManager.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreRenderTexture.h"
+
+namespace Ogre {
+
+    /// One surface of a NullTexture, stored in system memory
+    class _OgreNullExport NullHardwarePixelBuffer : public HardwarePixelBuffer
+    {
+    public:
+        NullHardwarePixelBuffer(NullRenderSystem* renderSystem, const String& name, uint32 width,
+                                uint32 height, uint32 depth, PixelFormat format, Usage usage);
+        ~NullHardwarePixelBuffer();
+
+        void blitFromMemory(const PixelBox &src, const Box &dstBox);
+        void blitToMemory(const Box &srcBox, const PixelBox &dst);
+        RenderTexture* getRenderTarget(size_t slice = 0);
+    protected:
+        PixelBox lockImpl(const Box &lockBox, LockOptions options);
+        void unlockImpl(void);
+
+        NullRenderSystem* mRenderSystem;
+        /// The pixels of the whole surface
+        PixelBox mBuffer;
+        /// Bytes that will be uploaded on unlock
+        size_t mLockedBytes;
+
+        typedef vector<RenderTexture*>::type SliceTRT;
+        SliceTRT mSliceTRT;
+        StringVector mSliceNames;
+    };
+
+    /// RenderTexture rendering to a slice of a NullHardwarePixelBuffer
+    class _OgreNullExport NullRenderTexture : public RenderTexture
+    {
+    public:
+        NullRenderTexture(const String& name, HardwarePixelBuffer* buffer, uint32 zoffset, uint fsaa);
+
+        bool requiresTextureFlipping() const { return false; }
+    };
+
+    /// Texture stored in system memory
+    class _OgreNullExport NullTexture : public Texture
+    {
+    public:
+        NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                    const String& group, bool isManual, ManualResourceLoader* loader,
+                    NullRenderSystem* renderSystem);
+        ~NullTexture();
+
+        HardwarePixelBufferSharedPtr getBuffer(size_t face = 0, size_t mipmap = 0);
+    protected:
+        void prepareImpl(void);
+        void unprepareImpl(void);
+        void loadImpl(void);
+        void createInternalResourcesImpl(void);
+        void freeInternalResourcesImpl(void);
+
+        /// Reads a single image from the resource group of this texture
+        void readImage(const String& name, const String& ext);
+
+        NullRenderSystem* mRenderSystem;
+
+        /// Images read by prepareImpl, consumed by loadImpl
+        typedef vector<Image>::type LoadedImages;
+        LoadedImages mLoadedImages;
+
+        typedef vector<HardwarePixelBufferSharedPtr>::type SurfaceList;
+        SurfaceList mSurfaceList;
+    };
+
+    /// Creates NullTexture instances
+    class _OgreNullExport NullTextureManager : public TextureManager
+    {
+    public:
+        NullTextureManager(NullRenderSystem* renderSystem);
+        ~NullTextureManager();
+
+        /// Every format is natively supported
+        PixelFormat getNativeFormat(TextureType ttype, PixelFormat format, int usage) { return format; }
+
+        bool isHardwareFilteringSupported(TextureType ttype, PixelFormat format, int usage,
+                                          bool preciseFormatOnly = false) { return true; }
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle,
+            const String& group, bool isManual, ManualResourceLoader* loader,
+            const NameValuePairList* createParams);
+
+        NullRenderSystem* mRenderSystem;
+    };
+}
+
+#endif
@@ -0,0 +1,257 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullGpuProgram.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+    namespace {
+        typedef std::map<String, GpuConstantType> TypeMap;
+
+        /// GLSL and HLSL/Cg type names
+        const TypeMap& getTypeMap()
+        {
+            static TypeMap types;
+            if (types.empty())
+            {
+                const char* floats[] = {"float", "vec2", "vec3", "vec4",
+                                        "float1", "float2", "float3", "float4",
+                                        "half", "half2", "half3", "half4"};
+                const GpuConstantType floatTypes[] = {GCT_FLOAT1, GCT_FLOAT2, GCT_FLOAT3, GCT_FLOAT4};
+                for (size_t i = 0; i < 12; ++i)
+                    types[floats[i]] = floatTypes[i < 4 ? i : (i - 4) % 4];
+
+                const char* ints[] = {"int", "ivec2", "ivec3", "ivec4",
+                                      "int1", "int2", "int3", "int4"};
+                const GpuConstantType intTypes[] = {GCT_INT1, GCT_INT2, GCT_INT3, GCT_INT4};
+                for (size_t i = 0; i < 8; ++i)
+                    types[ints[i]] = intTypes[i % 4];
+
+                types["uint"] = GCT_UINT1;
+                types["uvec2"] = GCT_UINT2;
+                types["uvec3"] = GCT_UINT3;
+                types["uvec4"] = GCT_UINT4;
+                types["bool"] = GCT_BOOL1;
+                types["bvec2"] = GCT_BOOL2;
+                types["bvec3"] = GCT_BOOL3;
+                types["bvec4"] = GCT_BOOL4;
+
+                types["mat2"] = types["float2x2"] = types["mat2x2"] = GCT_MATRIX_2X2;
+                types["mat2x3"] = types["float2x3"] = GCT_MATRIX_2X3;
+                types["mat2x4"] = types["float2x4"] = GCT_MATRIX_2X4;
+                types["mat3x2"] = types["float3x2"] = GCT_MATRIX_3X2;
+                types["mat3"] = types["float3x3"] = types["mat3x3"] = GCT_MATRIX_3X3;
+                types["mat3x4"] = types["float3x4"] = GCT_MATRIX_3X4;
+                types["mat4x2"] = types["float4x2"] = GCT_MATRIX_4X2;
+                types["mat4x3"] = types["float4x3"] = GCT_MATRIX_4X3;
+                types["mat4"] = types["float4x4"] = types["mat4x4"] = GCT_MATRIX_4X4;
+
+                types["sampler1D"] = GCT_SAMPLER1D;
+                types["sampler2D"] = GCT_SAMPLER2D;
+                types["sampler3D"] = GCT_SAMPLER3D;
+                types["samplerCUBE"] = types["samplerCube"] = GCT_SAMPLERCUBE;
+                types["sampler1DShadow"] = GCT_SAMPLER1DSHADOW;
+                types["sampler2DShadow"] = GCT_SAMPLER2DSHADOW;
+                types["sampler2DArray"] = GCT_SAMPLER2DARRAY;
+                types["samplerRECT"] = types["sampler2DRect"] = GCT_SAMPLERRECT;
+            }
+            return types;
+        }
+
+        void addConstant(GpuNamedConstants& defs, const String& name, GpuConstantType type,
+                         size_t arraySize)
+        {
+            GpuConstantDefinition def;
+            def.constType = type;
+            def.elementSize = GpuConstantDefinition::getElementSize(type, false);
+            def.arraySize = arraySize;
+            def.logicalIndex = 0;
+
+            if (def.isFloat())
+            {
+                def.physicalIndex = defs.floatBufferSize;
+                defs.floatBufferSize += def.arraySize * def.elementSize;
+            }
+            else if (def.isInt() || def.isSampler() || type == GCT_SAMPLERRECT)
+            {
+                def.physicalIndex = defs.intBufferSize;
+                defs.intBufferSize += def.arraySize * def.elementSize;
+            }
+            else
+            {
+                def.physicalIndex = defs.uintBufferSize;
+                defs.uintBufferSize += def.arraySize * def.elementSize;
+            }
+
+            defs.map.insert(GpuConstantDefinitionMap::value_type(name, def));
+            defs.generateConstantDefinitionArrayEntries(name, def);
+        }
+    }
+    //-----------------------------------------------------------------------------
+    NullGpuProgram::NullGpuProgram(ResourceManager* creator, const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader)
+        : GpuProgram(creator, name, handle, group, isManual, loader)
+    {
+    }
+    //-----------------------------------------------------------------------------
+    NullHighLevelGpuProgram::NullHighLevelGpuProgram(ResourceManager* creator, const String& name,
+        ResourceHandle handle, const String& group, bool isManual, ManualResourceLoader* loader,
+        const String& language)
+        : HighLevelGpuProgram(creator, name, handle, group, isManual, loader), mLanguage(language)
+    {
+        mSyntaxCode = language;
+    }
+    //-----------------------------------------------------------------------------
+    NullHighLevelGpuProgram::~NullHighLevelGpuProgram()
+    {
+        // have to call this here rather than in Resource destructor
+        // since calling virtual methods in base destructors causes crash
+        if (isLoaded())
+        {
+            unload();
+        }
+        else
+        {
+            unloadHighLevel();
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullHighLevelGpuProgram::buildConstantDefinitions() const
+    {
+        createParameterMappingStructures(true);
+
+        const TypeMap& types = getTypeMap();
+
+        // Tokenize declarations of the form "uniform <type> <name>[<size>], ..."
+        // which end at ';' for globals and at ',' or ')' for entry point parameters
+        String::size_type pos = 0;
+        while ((pos = mSource.find("uniform", pos)) != String::npos)
+        {
+            bool isWord = (pos == 0 || !(isalnum(mSource[pos - 1]) || mSource[pos - 1] == '_'));
+            pos += 7;
+            if (!isWord || (pos < mSource.size() && (isalnum(mSource[pos]) || mSource[pos] == '_')))
+                continue;
+
+            String::size_type end = mSource.find_first_of(";)", pos);
+            if (end == String::npos)
+                break;
+            String decl = mSource.substr(pos, end - pos);
+            // uniform blocks are not supported
+            if (decl.find('{') != String::npos)
+                continue;
+
+            // "uniform vec4 a, b[2];" declares several uniforms of the same type, while
+            // in "uniform float4 a, in float4 b)" the next entry point parameter follows
+            StringVector parts = StringUtil::split(decl, ",");
+            GpuConstantType type = GCT_UNKNOWN;
+            for (size_t i = 0; i < parts.size(); ++i)
+            {
+                // drop initialisers and semantics
+                String part = parts[i];
+                String::size_type cut = part.find_first_of("=:");
+                if (cut != String::npos)
+                    part.erase(cut);
+
+                size_t arraySize = 1;
+                String::size_type arrayStart;
+                while ((arrayStart = part.find('[')) != String::npos)
+                {
+                    String::size_type arrayEnd = part.find(']', arrayStart);
+                    if (arrayEnd == String::npos)
+                        break;
+                    arraySize *= StringConverter::parseUnsignedInt(
+                        part.substr(arrayStart + 1, arrayEnd - arrayStart - 1), 1);
+                    part.erase(arrayStart, arrayEnd - arrayStart + 1);
+                }
+
+                StringVector tokens = StringUtil::split(part, " \t\r\n");
+                if (tokens.empty() || (i > 0 && tokens.size() > 1))
+                    break;
+
+                // the type is followed by the name, skipping qualifiers like "highp"
+                for (size_t t = 0; i == 0 && t < tokens.size(); ++t)
+                {
+                    TypeMap::const_iterator it = types.find(tokens[t]);
+                    if (it != types.end())
+                        type = it->second;
+                }
+
+                if (type == GCT_UNKNOWN)
+                    break;
+
+                addConstant(*mConstantDefs, tokens.back(), type, arraySize);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------
+    HighLevelGpuProgram* NullHighLevelGpuProgramFactory::create(ResourceManager* creator,
+        const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader)
+    {
+        return OGRE_NEW NullHighLevelGpuProgram(creator, name, handle, group, isManual, loader,
+                                                mLanguage);
+    }
+    //-----------------------------------------------------------------------------
+    void NullHighLevelGpuProgramFactory::destroy(HighLevelGpuProgram* prog)
+    {
+        OGRE_DELETE prog;
+    }
+    //-----------------------------------------------------------------------------
+    NullGpuProgramManager::NullGpuProgramManager()
+    {
+        // Register with resource group manager
+        ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+    }
+    //-----------------------------------------------------------------------------
+    NullGpuProgramManager::~NullGpuProgramManager()
+    {
+        // Unregister with resource group manager
+        ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+    }
+    //-----------------------------------------------------------------------------
+    Resource* NullGpuProgramManager::createImpl(const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader,
+        const NameValuePairList* params)
+    {
+        if (!params || params->find("type") == params->end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "You must supply a 'type' parameter",
+                "NullGpuProgramManager::createImpl");
+        }
+
+        return OGRE_NEW NullGpuProgram(this, name, handle, group, isManual, loader);
+    }
+    //-----------------------------------------------------------------------------
+    Resource* NullGpuProgramManager::createImpl(const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader,
+        GpuProgramType gptype, const String& syntaxCode)
+    {
+        return OGRE_NEW NullGpuProgram(this, name, handle, group, isManual, loader);
+    }
+}
@@ -0,0 +1,647 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullRenderSystem.h"
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullTexture.h"
+#include "OgreNullGpuProgram.h"
+#include "OgreNullRenderWindow.h"
+#include "OgreHardwareOcclusionQuery.h"
+#include "OgreHighLevelGpuProgramManager.h"
+#include "OgreDepthBuffer.h"
+#include "OgreViewport.h"
+#include "OgreFrustum.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+    namespace {
+        /// Occlusion query that reports everything as visible
+        class NullHardwareOcclusionQuery : public HardwareOcclusionQuery
+        {
+        public:
+            void beginOcclusionQuery() {}
+            void endOcclusionQuery() {}
+            bool pullOcclusionQuery(unsigned int* NumOfFragments)
+            {
+                mPixelCount = *NumOfFragments = 1;
+                return true;
+            }
+            bool isStillOutstanding(void) { return false; }
+        };
+
+        /// High level languages the null render system accepts programs for
+        const char* sLanguages[] = {"glsl", "glsles", "hlsl", "cg"};
+    }
+    //-----------------------------------------------------------------------------
+    NullRenderSystem::NullRenderSystem()
+        : mHardwareBufferManager(0), mGpuProgramManager(0), mInitialised(false), mBytesUploaded(0)
+    {
+        LogManager::getSingleton().logMessage(getName() + " created.");
+
+        ConfigOption optFullScreen;
+        optFullScreen.name = "Full Screen";
+        optFullScreen.possibleValues.push_back("No");
+        optFullScreen.possibleValues.push_back("Yes");
+        optFullScreen.currentValue = "No";
+        optFullScreen.immutable = false;
+        mOptions[optFullScreen.name] = optFullScreen;
+
+        ConfigOption optVideoMode;
+        optVideoMode.name = "Video Mode";
+        optVideoMode.possibleValues.push_back("800 x 600");
+        optVideoMode.possibleValues.push_back("1280 x 720");
+        optVideoMode.possibleValues.push_back("1920 x 1080");
+        optVideoMode.currentValue = optVideoMode.possibleValues[0];
+        optVideoMode.immutable = false;
+        mOptions[optVideoMode.name] = optVideoMode;
+
+        resetStatistics();
+    }
+    //-----------------------------------------------------------------------------
+    NullRenderSystem::~NullRenderSystem()
+    {
+        shutdown();
+    }
+    //-----------------------------------------------------------------------------
+    const String& NullRenderSystem::getName(void) const
+    {
+        static String strName("Null Rendering Subsystem");
+        return strName;
+    }
+    //-----------------------------------------------------------------------------
+    NullRenderSystem::Statistics NullRenderSystem::getStatistics() const
+    {
+        Statistics stats = mStats;
+        stats.bytesUploaded = mBytesUploaded;
+        return stats;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::resetStatistics()
+    {
+        memset(&mStats, 0, sizeof(Statistics));
+        mBytesUploaded = 0;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::setConfigOption(const String &name, const String &value)
+    {
+        ConfigOptionMap::iterator it = mOptions.find(name);
+        if (it == mOptions.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Option named " + name + " does not exist.",
+                        "NullRenderSystem::setConfigOption");
+        }
+
+        it->second.currentValue = value;
+    }
+    //-----------------------------------------------------------------------------
+    String NullRenderSystem::validateConfigOptions(void)
+    {
+        // any resolution is fine for a window that is never shown
+        return BLANKSTRING;
+    }
+    //-----------------------------------------------------------------------------
+    HardwareOcclusionQuery* NullRenderSystem::createHardwareOcclusionQuery(void)
+    {
+        HardwareOcclusionQuery* ret = OGRE_NEW NullHardwareOcclusionQuery();
+        mHwOcclusionQueries.push_back(ret);
+        return ret;
+    }
+    //-----------------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_initialise(bool autoCreateWindow, const String& windowTitle)
+    {
+        RenderWindow* autoWindow = NULL;
+        if (autoCreateWindow)
+        {
+            StringVector tokens = StringUtil::split(mOptions["Video Mode"].currentValue, " x");
+            uint w = tokens.size() > 0 ? StringConverter::parseUnsignedInt(tokens[0], 800) : 800;
+            uint h = tokens.size() > 1 ? StringConverter::parseUnsignedInt(tokens[1], 600) : 600;
+            bool fullscreen = mOptions["Full Screen"].currentValue == "Yes";
+            autoWindow = _createRenderWindow(windowTitle, w, h, fullscreen);
+        }
+        RenderSystem::_initialise(autoCreateWindow, windowTitle);
+        return autoWindow;
+    }
+    //-----------------------------------------------------------------------------
+    RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+    {
+        RenderSystemCapabilities* rsc = OGRE_NEW RenderSystemCapabilities();
+
+        rsc->setDriverVersion(mDriverVersion);
+        rsc->setDeviceName("Null");
+        rsc->setRenderSystemName(getName());
+        rsc->setVendor(GPU_UNKNOWN);
+
+        rsc->setNumTextureUnits(OGRE_MAX_TEXTURE_LAYERS);
+        rsc->setNumVertexAttributes(16);
+        rsc->setNumMultiRenderTargets(OGRE_MAX_MULTIPLE_RENDER_TARGETS);
+        rsc->setMaxSupportedAnisotropy(16);
+        rsc->setStencilBufferBitDepth(8);
+        rsc->setMaxPointSize(256);
+
+        rsc->setCapability(RSC_FIXED_FUNCTION);
+        rsc->setCapability(RSC_AUTOMIPMAP);
+        rsc->setCapability(RSC_AUTOMIPMAP_COMPRESSED);
+        rsc->setCapability(RSC_ANISOTROPY);
+        rsc->setCapability(RSC_DOT3);
+        rsc->setCapability(RSC_CUBEMAPPING);
+        rsc->setCapability(RSC_POINT_SPRITES);
+        rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+        rsc->setCapability(RSC_HWSTENCIL);
+        rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+        rsc->setCapability(RSC_STENCIL_WRAP);
+        rsc->setCapability(RSC_HW_GAMMA);
+        rsc->setCapability(RSC_MAPBUFFER);
+        rsc->setCapability(RSC_32BIT_INDEX);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION_DXT);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION_BC4_BC5);
+        rsc->setCapability(RSC_TEXTURE_COMPRESSION_BC6H_BC7);
+        rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+        rsc->setCapability(RSC_MRT_DIFFERENT_BIT_DEPTHS);
+        rsc->setCapability(RSC_RTT_DEPTHBUFFER_RESOLUTION_LESSEQUAL);
+        rsc->setCapability(RSC_ADVANCED_BLEND_OPERATIONS);
+        rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+        rsc->setCapability(RSC_SCISSOR_TEST);
+        rsc->setCapability(RSC_USER_CLIP_PLANES);
+        rsc->setCapability(RSC_TEXTURE_1D);
+        rsc->setCapability(RSC_TEXTURE_3D);
+        rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+        rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+        rsc->setCapability(RSC_HWOCCLUSION);
+        rsc->setCapability(RSC_VERTEX_TEXTURE_FETCH);
+        rsc->setNumVertexTextureUnits(OGRE_MAX_TEXTURE_LAYERS);
+        rsc->setVertexTextureUnitsShared(true);
+
+        rsc->setCapability(RSC_VERTEX_PROGRAM);
+        rsc->setCapability(RSC_FRAGMENT_PROGRAM);
+        rsc->setCapability(RSC_GEOMETRY_PROGRAM);
+        rsc->setVertexProgramConstantFloatCount(4096);
+        rsc->setVertexProgramConstantIntCount(4096);
+        rsc->setVertexProgramConstantBoolCount(4096);
+        rsc->setFragmentProgramConstantFloatCount(4096);
+        rsc->setFragmentProgramConstantIntCount(4096);
+        rsc->setFragmentProgramConstantBoolCount(4096);
+        rsc->setGeometryProgramConstantFloatCount(4096);
+        rsc->setGeometryProgramConstantIntCount(4096);
+        rsc->setGeometryProgramConstantBoolCount(4096);
+        rsc->setGeometryProgramNumOutputVertices(1024);
+
+        // every program is accepted, so claim the usual profiles
+        for (size_t i = 0; i < sizeof(sLanguages) / sizeof(sLanguages[0]); ++i)
+            rsc->addShaderProfile(sLanguages[i]);
+        const char* profiles[] = {"glsl100", "glsl300es", "glsl130", "glsl140", "glsl150", "glsl330",
+                                  "glsl400", "glsl410", "glsl420", "glsl430", "glsl440", "glsl450",
+                                  "arbvp1", "arbfp1", "vs_1_1", "vs_2_0", "vs_3_0", "ps_2_0",
+                                  "ps_3_0", "vs_4_0", "ps_4_0", "gs_4_0", "vs_5_0", "ps_5_0"};
+        for (size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); ++i)
+            rsc->addShaderProfile(profiles[i]);
+
+        return rsc;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps,
+                                                                  RenderTarget* primary)
+    {
+        if (caps->getRenderSystemName() != getName())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Trying to initialize NullRenderSystem from RenderSystemCapabilities that do not support it",
+                        "NullRenderSystem::initialiseFromRenderSystemCapabilities");
+        }
+
+        mGpuProgramManager = OGRE_NEW NullGpuProgramManager();
+
+        // Only take over languages no other plugin provides, e.g. Cg
+        HighLevelGpuProgramManager& hlgpm = HighLevelGpuProgramManager::getSingleton();
+        for (size_t i = 0; i < sizeof(sLanguages) / sizeof(sLanguages[0]); ++i)
+        {
+            if (hlgpm.isLanguageSupported(sLanguages[i]))
+                continue;
+            mProgramFactories.push_back(OGRE_NEW NullHighLevelGpuProgramFactory(sLanguages[i]));
+            hlgpm.addFactory(mProgramFactories.back());
+        }
+
+        mHardwareBufferManager = OGRE_NEW NullHardwareBufferManager(this);
+        mTextureManager = OGRE_NEW NullTextureManager(this);
+
+        Log* defaultLog = LogManager::getSingleton().getDefaultLog();
+        if (defaultLog)
+        {
+            caps->log(defaultLog);
+        }
+
+        mInitialised = true;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::reinitialise(void)
+    {
+        shutdown();
+        _initialise(true);
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::shutdown(void)
+    {
+        RenderSystem::shutdown();
+
+        for (ProgramFactoryList::iterator it = mProgramFactories.begin(); it != mProgramFactories.end(); ++it)
+        {
+            // Remove from manager safely
+            if (HighLevelGpuProgramManager::getSingletonPtr())
+                HighLevelGpuProgramManager::getSingleton().removeFactory(*it);
+            OGRE_DELETE *it;
+        }
+        mProgramFactories.clear();
+
+        OGRE_DELETE mGpuProgramManager;
+        mGpuProgramManager = 0;
+
+        OGRE_DELETE mHardwareBufferManager;
+        mHardwareBufferManager = 0;
+
+        OGRE_DELETE mTextureManager;
+        mTextureManager = 0;
+
+        mInitialised = false;
+    }
+    //-----------------------------------------------------------------------------
+    RenderWindow* NullRenderSystem::_createRenderWindow(const String &name, unsigned int width, unsigned int height,
+                                                        bool fullScreen, const NameValuePairList *miscParams)
+    {
+        if (mRenderTargets.find(name) != mRenderTargets.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                        "Window with name '" + name + "' already exists",
+                        "NullRenderSystem::_createRenderWindow");
+        }
+
+        RenderWindow* win = OGRE_NEW NullRenderWindow();
+        win->create(name, width, height, fullScreen, miscParams);
+        attachRenderTarget(*win);
+
+        if (!mInitialised)
+        {
+            mRealCapabilities = createRenderSystemCapabilities();
+
+            // use real capabilities if custom capabilities are not available
+            if (!mUseCustomCapabilities)
+                mCurrentCapabilities = mRealCapabilities;
+
+            fireEvent("RenderSystemCapabilitiesCreated");
+
+            initialiseFromRenderSystemCapabilities(mCurrentCapabilities, win);
+        }
+
+        if (win->getDepthBufferPool() != DepthBuffer::POOL_NO_DEPTH)
+        {
+            DepthBuffer* depthBuffer = OGRE_NEW DepthBuffer(DepthBuffer::POOL_DEFAULT, 24,
+                win->getWidth(), win->getHeight(), win->getFSAA(), win->getFSAAHint(), true);
+
+            mDepthBufferPool[depthBuffer->getPoolId()].push_back(depthBuffer);
+
+            win->attachDepthBuffer(depthBuffer);
+        }
+
+        return win;
+    }
+    //-----------------------------------------------------------------------------
+    MultiRenderTarget* NullRenderSystem::createMultiRenderTarget(const String & name)
+    {
+        MultiRenderTarget* retval = OGRE_NEW NullMultiRenderTarget(name);
+        attachRenderTarget(*retval);
+        return retval;
+    }
+    //-----------------------------------------------------------------------------
+    DepthBuffer* NullRenderSystem::_createDepthBufferFor(RenderTarget *renderTarget)
+    {
+        return OGRE_NEW DepthBuffer(DepthBuffer::POOL_DEFAULT, 24, renderTarget->getWidth(),
+                                    renderTarget->getHeight(), renderTarget->getFSAA(),
+                                    renderTarget->getFSAAHint(), false);
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTexture(size_t unit, bool enabled, const TexturePtr &texPtr)
+    {
+        ++mStats.textureBinds;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureCoordSet(size_t unit, size_t index)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureUnitCompareEnabled(size_t unit, bool compare)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureUnitCompareFunction(size_t unit, CompareFunction function)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureAddressingMode(size_t unit, const TextureUnitState::UVWAddressingMode& uvw)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureBorderColour(size_t unit, const ColourValue& colour)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setTextureMipmapBias(size_t unit, float bias)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+                                             SceneBlendOperation op)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+                                                     SceneBlendFactor sourceFactorAlpha,
+                                                     SceneBlendFactor destFactorAlpha,
+                                                     SceneBlendOperation op, SceneBlendOperation alphaOp)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setViewport(Viewport *vp)
+    {
+        if (vp && vp != mActiveViewport)
+        {
+            mActiveViewport = vp;
+            _setRenderTarget(vp->getTarget());
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setRenderTarget(RenderTarget *target)
+    {
+        if (target != mActiveRenderTarget)
+        {
+            mActiveRenderTarget = target;
+            ++mStats.renderTargetChanges;
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setCullingMode(CullingMode mode)
+    {
+        mCullingMode = mode;
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferParams(bool depthTest, bool depthWrite, CompareFunction depthFunction)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferCheckEnabled(bool enabled)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferWriteEnabled(bool enabled)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBufferFunction(CompareFunction func)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setDepthBias(float constantBias, float slopeScaleBias)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_setPolygonMode(PolygonMode level)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::setStencilCheckEnabled(bool enabled)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::setStencilBufferParams(CompareFunction func, uint32 refValue, uint32 compareMask,
+                                                  uint32 writeMask, StencilOperation stencilFailOp,
+                                                  StencilOperation depthFailOp, StencilOperation passOp,
+                                                  bool twoSidedOperation, bool readBackAsTexture)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::setScissorTest(bool enabled, size_t left, size_t top, size_t right, size_t bottom)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::setClipPlanesImpl(const PlaneList& clipPlanes)
+    {
+        ++mStats.stateChanges;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest, bool forGpuProgram)
+    {
+        // Same as OpenGL, no conversion required
+        dest = matrix;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+                                                 Matrix4& dest, bool forGpuProgram)
+    {
+        Radian thetaY(fovy / 2.0f);
+        Real tanThetaY = Math::Tan(thetaY);
+
+        // Calc matrix elements
+        Real w = (1.0f / tanThetaY) / aspect;
+        Real h = 1.0f / tanThetaY;
+        Real q, qn;
+        if (farPlane == 0)
+        {
+            // Infinite far plane
+            q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+            qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+        }
+        else
+        {
+            q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+            qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+        }
+
+        // NB This creates Z in range [-1,1]
+        dest = Matrix4::ZERO;
+        dest[0][0] = w;
+        dest[1][1] = h;
+        dest[2][2] = q;
+        dest[2][3] = qn;
+        dest[3][2] = -1;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+                                                 Real nearPlane, Real farPlane, Matrix4& dest,
+                                                 bool forGpuProgram)
+    {
+        Real width = right - left;
+        Real height = top - bottom;
+        Real q, qn;
+        if (farPlane == 0)
+        {
+            // Infinite far plane
+            q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+            qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+        }
+        else
+        {
+            q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+            qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+        }
+
+        dest = Matrix4::ZERO;
+        dest[0][0] = 2 * nearPlane / width;
+        dest[0][2] = (right+left) / width;
+        dest[1][1] = 2 * nearPlane / height;
+        dest[1][2] = (top+bottom) / height;
+        dest[2][2] = q;
+        dest[2][3] = qn;
+        dest[3][2] = -1;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+                                            Matrix4& dest, bool forGpuProgram)
+    {
+        Radian thetaY(fovy / 2.0f);
+        Real tanThetaY = Math::Tan(thetaY);
+
+        Real tanThetaX = tanThetaY * aspect;
+        Real half_w = tanThetaX * nearPlane;
+        Real half_h = tanThetaY * nearPlane;
+        Real iw = 1.0f / half_w;
+        Real ih = 1.0f / half_h;
+        Real q = farPlane == 0 ? 0 : 2.0f / (farPlane - nearPlane);
+
+        dest = Matrix4::ZERO;
+        dest[0][0] = iw;
+        dest[1][1] = ih;
+        dest[2][2] = -q;
+        dest[2][3] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+        dest[3][3] = 1;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane, bool forGpuProgram)
+    {
+        // Calculate the clip-space corner point opposite the clipping plane
+        // as (sgn(clipPlane.x), sgn(clipPlane.y), 1, 1) and
+        // transform it into camera space by multiplying it
+        // by the inverse of the projection matrix
+        Vector4 q;
+        q.x = (Math::Sign(plane.normal.x) + matrix[0][2]) / matrix[0][0];
+        q.y = (Math::Sign(plane.normal.y) + matrix[1][2]) / matrix[1][1];
+        q.z = -1.0F;
+        q.w = (1.0F + matrix[2][2]) / matrix[2][3];
+
+        // Calculate the scaled plane vector
+        Vector4 clipPlane4d(plane.normal.x, plane.normal.y, plane.normal.z, plane.d);
+        Vector4 c = clipPlane4d * (2.0F / (clipPlane4d.dotProduct(q)));
+
+        // Replace the third row of the projection matrix
+        matrix[2][0] = c.x;
+        matrix[2][1] = c.y;
+        matrix[2][2] = c.z + 1.0F;
+        matrix[2][3] = c.w;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::_render(const RenderOperation& op)
+    {
+        // Call super class
+        RenderSystem::_render(op);
+
+        // one draw call per pass iteration, like the other render systems issue them
+        do
+        {
+            ++mStats.drawCalls;
+        } while (updatePassIterationRenderState());
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgram(GpuProgram* prg)
+    {
+        RenderSystem::bindGpuProgram(prg);
+        ++mStats.programBinds;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::unbindGpuProgram(GpuProgramType gptype)
+    {
+        RenderSystem::unbindGpuProgram(gptype);
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramParameters(GpuProgramType gptype,
+        GpuProgramParametersSharedPtr params, uint16 variabilityMask)
+    {
+        ++mStats.parameterUploads;
+
+        // the variability is not tracked per constant, so count the whole buffers
+        mBytesUploaded += params->getFloatConstantList().size() * sizeof(float) +
+                          params->getDoubleConstantList().size() * sizeof(double) +
+                          params->getIntConstantList().size() * sizeof(int) +
+                          params->getUnsignedIntConstantList().size() * sizeof(uint);
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
+    {
+        ++mStats.parameterUploads;
+    }
+    //-----------------------------------------------------------------------------
+    void NullRenderSystem::clearFrameBuffer(unsigned int buffers, const ColourValue& colour,
+                                            Real depth, unsigned short stencil)
+    {
+        ++mStats.clears;
+    }
+}
@@ -0,0 +1,294 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullTexture.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreRoot.h"
+#include "OgreBitwise.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+    //-----------------------------------------------------------------------------
+    NullHardwarePixelBuffer::NullHardwarePixelBuffer(NullRenderSystem* renderSystem, const String& name,
+                                                     uint32 width, uint32 height, uint32 depth,
+                                                     PixelFormat format, Usage usage)
+        : HardwarePixelBuffer(width, height, depth, format, usage, true, false),
+          mRenderSystem(renderSystem), mBuffer(width, height, depth, format), mLockedBytes(0)
+    {
+        mSizeInBytes = PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat);
+        mBuffer.data = OGRE_ALLOC_T(uchar, mSizeInBytes, MEMCATEGORY_RENDERSYS);
+
+        if (mUsage & TU_RENDERTARGET)
+        {
+            // Create render target for each slice
+            mSliceTRT.reserve(mDepth);
+            mSliceNames.reserve(mDepth);
+            for (uint32 zoffset = 0; zoffset < mDepth; ++zoffset)
+            {
+                String rttName = "rtt/" + StringConverter::toString((size_t)this) + "/" + name;
+                if (zoffset > 0)
+                    rttName += "/" + StringConverter::toString(zoffset);
+                RenderTexture* trt = OGRE_NEW NullRenderTexture(rttName, this, zoffset, 0);
+                mSliceTRT.push_back(trt);
+                mSliceNames.push_back(rttName);
+                mRenderSystem->attachRenderTarget(*trt);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------
+    NullHardwarePixelBuffer::~NullHardwarePixelBuffer()
+    {
+        // Delete all render targets that were not yet deleted by the user or the
+        // render system. Look them up by name as the pointers might be dangling.
+        for (size_t zoffset = 0; zoffset < mSliceNames.size(); ++zoffset)
+        {
+            mRenderSystem->destroyRenderTarget(mSliceNames[zoffset]);
+        }
+
+        OGRE_FREE(mBuffer.data, MEMCATEGORY_RENDERSYS);
+    }
+    //-----------------------------------------------------------------------------
+    PixelBox NullHardwarePixelBuffer::lockImpl(const Box &lockBox, LockOptions options)
+    {
+        mLockedBytes = options == HBL_READ_ONLY ? 0 :
+            PixelUtil::getMemorySize(lockBox.getWidth(), lockBox.getHeight(), lockBox.getDepth(), mFormat);
+        return mBuffer.getSubVolume(lockBox);
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::unlockImpl(void)
+    {
+        mRenderSystem->_notifyBytesUploaded(mLockedBytes);
+        mLockedBytes = 0;
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitFromMemory(const PixelBox &src, const Box &dstBox)
+    {
+        PixelBox dst = mBuffer.getSubVolume(dstBox);
+        if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight() ||
+            src.getDepth() != dst.getDepth())
+        {
+            Image::scale(src, dst);
+        }
+        else
+        {
+            PixelUtil::bulkPixelConversion(src, dst);
+        }
+
+        mRenderSystem->_notifyBytesUploaded(
+            PixelUtil::getMemorySize(dst.getWidth(), dst.getHeight(), dst.getDepth(), mFormat));
+    }
+    //-----------------------------------------------------------------------------
+    void NullHardwarePixelBuffer::blitToMemory(const Box &srcBox, const PixelBox &dst)
+    {
+        PixelBox src = mBuffer.getSubVolume(srcBox);
+        if (src.getWidth() != dst.getWidth() || src.getHeight() != dst.getHeight() ||
+            src.getDepth() != dst.getDepth())
+        {
+            Image::scale(src, dst);
+        }
+        else
+        {
+            PixelUtil::bulkPixelConversion(src, dst);
+        }
+    }
+    //-----------------------------------------------------------------------------
+    RenderTexture* NullHardwarePixelBuffer::getRenderTarget(size_t zoffset)
+    {
+        assert(mUsage & TU_RENDERTARGET);
+        assert(zoffset < mDepth);
+        return mSliceTRT[zoffset];
+    }
+    //-----------------------------------------------------------------------------
+    NullRenderTexture::NullRenderTexture(const String& name, HardwarePixelBuffer* buffer,
+                                         uint32 zoffset, uint fsaa)
+        : RenderTexture(buffer, zoffset)
+    {
+        mName = name;
+        mFSAA = fsaa;
+    }
+    //-----------------------------------------------------------------------------
+    NullTexture::NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+                             const String& group, bool isManual, ManualResourceLoader* loader,
+                             NullRenderSystem* renderSystem)
+        : Texture(creator, name, handle, group, isManual, loader), mRenderSystem(renderSystem)
+    {
+        // nothing to generate, so pretend it happens on the device
+        mMipmapsHardwareGenerated = true;
+    }
+    //-----------------------------------------------------------------------------
+    NullTexture::~NullTexture()
+    {
+        // have to call this here rather than in Resource destructor
+        // since calling virtual methods in base destructors causes crash
+        if (isLoaded())
+        {
+            unload();
+        }
+        else
+        {
+            freeInternalResources();
+        }
+    }
+    //-----------------------------------------------------------------------------
+    HardwarePixelBufferSharedPtr NullTexture::getBuffer(size_t face, size_t mipmap)
+    {
+        if (face >= getNumFaces())
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Face index out of range",
+                        "NullTexture::getBuffer");
+        }
+
+        if (mipmap > mNumMipmaps)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Mipmap index out of range",
+                        "NullTexture::getBuffer");
+        }
+
+        size_t idx = face * (mNumMipmaps + 1) + mipmap;
+        assert(idx < mSurfaceList.size());
+        return mSurfaceList[idx];
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::readImage(const String& name, const String& ext)
+    {
+        mLoadedImages.push_back(Image());
+        DataStreamPtr dstream = ResourceGroupManager::getSingleton().openResource(name, mGroup, this);
+        mLoadedImages.back().load(dstream, ext);
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::prepareImpl(void)
+    {
+        if (mUsage & TU_RENDERTARGET)
+            return;
+
+        String baseName, ext;
+        StringUtil::splitBaseFilename(mName, baseName, ext);
+
+        if (mTextureType == TEX_TYPE_CUBE_MAP && getSourceFileType() != "dds")
+        {
+            for (size_t i = 0; i < 6; i++)
+            {
+                String fullName = baseName + CUBEMAP_SUFFIXES[i];
+                if (!ext.empty())
+                    fullName = fullName + "." + ext;
+                readImage(fullName, ext);
+            }
+            return;
+        }
+
+        readImage(mName, ext);
+
+        if (mLoadedImages[0].hasFlag(IF_CUBEMAP))
+            mTextureType = TEX_TYPE_CUBE_MAP;
+        if (mLoadedImages[0].getDepth() > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+            mTextureType = TEX_TYPE_3D;
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::unprepareImpl(void)
+    {
+        mLoadedImages.clear();
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::loadImpl(void)
+    {
+        if (mUsage & TU_RENDERTARGET)
+        {
+            createInternalResources();
+            return;
+        }
+
+        // Now the only copy is on the stack and will be cleaned in case of
+        // exceptions being thrown from _loadImages
+        LoadedImages loadedImages;
+        std::swap(loadedImages, mLoadedImages);
+
+        ConstImagePtrList imagePtrs;
+        for (size_t i = 0; i < loadedImages.size(); ++i)
+        {
+            imagePtrs.push_back(&loadedImages[i]);
+        }
+
+        _loadImages(imagePtrs);
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::createInternalResourcesImpl(void)
+    {
+        mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
+
+        uint32 maxMips = Bitwise::mostSignificantBitSet(std::max(mWidth, std::max(mHeight, mDepth)));
+        if (PixelUtil::isCompressed(mFormat) && (mNumMipmaps == 0))
+            mNumRequestedMipmaps = 0;
+        mNumMipmaps = std::min(mNumRequestedMipmaps, maxMips);
+
+        mSurfaceList.clear();
+        for (uint8 face = 0; face < getNumFaces(); face++)
+        {
+            uint32 width = mWidth;
+            uint32 height = mHeight;
+            uint32 depth = mDepth;
+
+            for (uint32 mip = 0; mip <= mNumMipmaps; mip++)
+            {
+                mSurfaceList.push_back(HardwarePixelBufferSharedPtr(OGRE_NEW NullHardwarePixelBuffer(
+                    mRenderSystem, mName, width, height, depth, mFormat, (HardwareBuffer::Usage)mUsage)));
+
+                if (width > 1)
+                    width = width / 2;
+                if (height > 1)
+                    height = height / 2;
+                if (depth > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+                    depth = depth / 2;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void NullTexture::freeInternalResourcesImpl(void)
+    {
+        mSurfaceList.clear();
+    }
+    //-----------------------------------------------------------------------------
+    NullTextureManager::NullTextureManager(NullRenderSystem* renderSystem)
+        : mRenderSystem(renderSystem)
+    {
+        // Register with group manager
+        ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+    }
+    //-----------------------------------------------------------------------------
+    NullTextureManager::~NullTextureManager()
+    {
+        // Unregister with group manager
+        ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+    }
+    //-----------------------------------------------------------------------------
+    Resource* NullTextureManager::createImpl(const String& name, ResourceHandle handle,
+        const String& group, bool isManual, ManualResourceLoader* loader,
+        const NameValuePairList* createParams)
+    {
+        return OGRE_NEW NullTexture(this, name, handle, group, isManual, loader, mRenderSystem);
+    }
+}
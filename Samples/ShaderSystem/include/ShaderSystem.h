@@ -37,6 +37,8 @@ public:
         mFrustumPlanes[FRUSTUM_PLANE_FAR].d = 9999999999999999999.0f;
     }
     virtual bool isVisible(const AxisAlignedBox& bound, FrustumPlane* culledBy = 0) const {return true;};
+    virtual void areVisible(const AxisAlignedBox* const* bounds, size_t numBounds, char* visibilities) const
+    {memset(visibilities, 1, numBounds);};
     virtual bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const {return true;};
     virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const {return true;};
     bool projectSphere(const Sphere& sphere, 
@@ -0,0 +1,79 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Benchmark_H__
+#define __Benchmark_H__
+
+#include "OgrePrerequisites.h"
+
+#include <vector>
+
+/** A measurement of one hot path of Ogre.
+
+    The runner calls setUp once, then run repeatedly until the minimum
+    measuring time has passed, then tearDown. All benchmarks run headless,
+    either on the Null RenderSystem with a window named "Benchmark", if it
+    was built, or with a Root without RenderSystem and the
+    DefaultHardwareBufferManager.
+*/
+class Benchmark
+{
+public:
+    explicit Benchmark(const Ogre::String& name) : mName(name) {}
+    virtual ~Benchmark() {}
+
+    /// Name of the form "Area/What", used for filtering and reporting
+    const Ogre::String& getName() const { return mName; }
+
+    /// Prepares the data, not measured
+    virtual void setUp() {}
+    /// Does one iteration and returns the number of items it processed
+    virtual size_t run() = 0;
+    /// Releases what setUp created, not measured
+    virtual void tearDown() {}
+private:
+    Ogre::String mName;
+};
+
+/** Adds the benchmarks of one area to the list.
+    @note
+        Called after the Root was created, so this may query e.g. the
+        OptimisedUtil implementations.
+*/
+typedef void (*BenchmarkFactory)(std::vector<Benchmark*>& benchmarks);
+
+/// Registers a BenchmarkFactory at static initialisation time
+struct BenchmarkRegistration
+{
+    explicit BenchmarkRegistration(BenchmarkFactory factory);
+
+    static std::vector<BenchmarkFactory>& getFactories();
+};
+
+#define REGISTER_BENCHMARKS(factory) static BenchmarkRegistration factory##Registration(factory)
+
+#endif
@@ -0,0 +1,187 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+#include "OgreLight.h"
+#include "OgreGpuProgramParams.h"
+#include "OgreAutoParamDataSource.h"
+#include "OgreRenderable.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    const size_t numRenderables = 10000;
+
+    /// Renderable with its own world transform
+    class TransformRenderable : public Renderable
+    {
+        Matrix4 mTransform;
+        const LightList& mLights;
+    public:
+        TransformRenderable(const Matrix4& transform, const LightList& lights)
+            : mTransform(transform), mLights(lights) {}
+
+        const MaterialPtr& getMaterial(void) const
+        {
+            static MaterialPtr nullMaterial;
+            return nullMaterial;
+        }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const { *xform = mTransform; }
+        Real getSquaredViewDepth(const Camera* cam) const { return 0; }
+        const LightList& getLights(void) const { return mLights; }
+    };
+
+    /** Updates the per object auto constants of a typical lit vertex
+        program for every renderable, as SceneManager does when rendering.
+
+        With pass changes, the renderables alternate between two passes, so
+        every update follows a program change and is asked for all autos.
+    */
+    class AutoParamsBenchmark : public Benchmark
+    {
+        SceneManager* mSceneMgr;
+        Camera* mCamera;
+        LightList mLights;
+        AutoParamDataSource* mSource;
+        GpuProgramParametersSharedPtr mParams[2];
+        vector<TransformRenderable*>::type mRenderables;
+        bool mPassChanges;
+    public:
+        AutoParamsBenchmark(bool passChanges)
+            : Benchmark(passChanges ? "GpuProgramParameters/_updateAutoParams pass changes"
+                                    : "GpuProgramParameters/_updateAutoParams per object")
+            , mSceneMgr(0), mCamera(0), mSource(0), mPassChanges(passChanges)
+        {
+        }
+
+        void setUp()
+        {
+            mSceneMgr = Root::getSingleton().createSceneManager();
+            mCamera = mSceneMgr->createCamera("Camera");
+            mSceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 10, 50))->attachObject(mCamera);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                Light* light = mSceneMgr->createLight();
+                mSceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(i * 10.0f, 20, 0))->attachObject(light);
+                mLights.push_back(light);
+            }
+
+            for (int p = 0; p < 2; ++p)
+            {
+                // as a low level program would get them, one register per row
+                GpuLogicalBufferStructPtr floatIndexMap(OGRE_NEW GpuLogicalBufferStruct());
+                GpuProgramParametersSharedPtr params(OGRE_NEW GpuProgramParameters());
+                params->_setLogicalIndexes(floatIndexMap, GpuLogicalBufferStructPtr(), GpuLogicalBufferStructPtr(),
+                                           GpuLogicalBufferStructPtr(), GpuLogicalBufferStructPtr());
+                size_t index = 0;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_WORLDVIEWPROJ_MATRIX); index += 4;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_WORLD_MATRIX); index += 4;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_WORLDVIEW_MATRIX); index += 4;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_INVERSE_TRANSPOSE_WORLD_MATRIX); index += 4;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_CAMERA_POSITION_OBJECT_SPACE); index += 1;
+                for (size_t i = 0; i < mLights.size(); ++i)
+                {
+                    params->setAutoConstant(index, GpuProgramParameters::ACT_LIGHT_POSITION_OBJECT_SPACE, i);
+                    index += 1;
+                    params->setAutoConstant(index, GpuProgramParameters::ACT_LIGHT_DIFFUSE_COLOUR, i);
+                    index += 1;
+                }
+                params->setAutoConstant(index, GpuProgramParameters::ACT_VIEWPROJ_MATRIX); index += 4;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_INVERSE_VIEW_MATRIX); index += 4;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_CAMERA_POSITION); index += 1;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR); index += 1;
+                params->setAutoConstant(index, GpuProgramParameters::ACT_FOG_PARAMS); index += 1;
+                mParams[p] = params;
+            }
+
+            mSource = OGRE_NEW AutoParamDataSource();
+            mSource->setCurrentSceneManager(mSceneMgr);
+            mSource->setCurrentCamera(mCamera, false);
+            mSource->setCurrentLightList(&mLights);
+
+            std::minstd_rand rng;
+            std::uniform_real_distribution<float> position(-100, 100);
+            for (size_t i = 0; i < numRenderables; ++i)
+            {
+                Matrix4 transform;
+                transform.makeTransform(Vector3(position(rng), position(rng), position(rng)),
+                                        Vector3::UNIT_SCALE, Quaternion(Radian(position(rng)), Vector3::UNIT_Y));
+                mRenderables.push_back(new TransformRenderable(transform, mLights));
+            }
+        }
+
+        size_t run()
+        {
+            if (mPassChanges)
+            {
+                for (size_t i = 0; i < mRenderables.size(); ++i)
+                {
+                    mSource->setCurrentRenderable(mRenderables[i]);
+                    mParams[i % 2]->_updateAutoParams(mSource, GPV_ALL);
+                }
+                return mRenderables.size();
+            }
+
+            for (size_t i = 0; i < mRenderables.size(); ++i)
+            {
+                mSource->setCurrentRenderable(mRenderables[i]);
+                mParams[0]->_updateAutoParams(mSource, GPV_PER_OBJECT);
+            }
+            return mRenderables.size();
+        }
+
+        void tearDown()
+        {
+            for (size_t i = 0; i < mRenderables.size(); ++i)
+                delete mRenderables[i];
+            mRenderables.clear();
+            mParams[0].reset();
+            mParams[1].reset();
+            OGRE_DELETE mSource;
+            mLights.clear();
+            Root::getSingleton().destroySceneManager(mSceneMgr);
+        }
+    };
+
+    void createAutoParamsBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        benchmarks.push_back(new AutoParamsBenchmark(false));
+        benchmarks.push_back(new AutoParamsBenchmark(true));
+    }
+}
+
+REGISTER_BENCHMARKS(createAutoParamsBenchmarks);
@@ -0,0 +1,189 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreFrustum.h"
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    const size_t numBoxes = 100000;
+
+    /// Frustum opting into the SIMD batch culling Camera uses
+    class BatchFrustum : public Frustum
+    {
+    public:
+        void areVisible(const AxisAlignedBox* const* bounds, size_t numBounds, char* visibilities) const
+        {
+            areVisibleImpl(bounds, numBounds, visibilities);
+        }
+    };
+
+    /// Culls world space bounding boxes one at a time, or in batches
+    class FrustumBenchmark : public Benchmark
+    {
+        bool mBatched;
+        Frustum* mFrustum;
+        vector<AxisAlignedBox>::type mBoxes;
+        vector<const AxisAlignedBox*>::type mBounds;
+        vector<char>::type mVisibilities;
+    public:
+        FrustumBenchmark(bool batched)
+            : Benchmark(batched ? "Culling/Frustum::areVisible" : "Culling/Frustum::isVisible")
+            , mBatched(batched), mFrustum(0)
+        {
+        }
+
+        void setUp()
+        {
+            mFrustum = OGRE_NEW BatchFrustum();
+            mFrustum->setNearClipDistance(1);
+            mFrustum->setFarClipDistance(1000);
+
+            // most of the boxes are outside of the frustum, as in a typical scene
+            std::minstd_rand rng;
+            std::uniform_real_distribution<float> position(-1000, 1000);
+            std::uniform_real_distribution<float> extent(0, 20);
+
+            mBoxes.resize(numBoxes);
+            mBounds.resize(numBoxes);
+            mVisibilities.resize(numBoxes);
+            for (size_t i = 0; i < numBoxes; ++i)
+            {
+                Vector3 centre(position(rng), position(rng), -Math::Abs(position(rng)));
+                Vector3 halfSize(extent(rng), extent(rng), extent(rng));
+                mBoxes[i].setExtents(centre - halfSize, centre + halfSize);
+                mBounds[i] = &mBoxes[i];
+            }
+        }
+
+        size_t run()
+        {
+            if (mBatched)
+            {
+                mFrustum->areVisible(&mBounds[0], numBoxes, &mVisibilities[0]);
+            }
+            else
+            {
+                for (size_t i = 0; i < numBoxes; ++i)
+                    mVisibilities[i] = mFrustum->isVisible(mBoxes[i]);
+            }
+            return numBoxes;
+        }
+
+        void tearDown()
+        {
+            OGRE_DELETE mFrustum;
+            mBoxes.clear();
+            mBounds.clear();
+        }
+    };
+
+    /// Culls the scene graph against a camera, serially or on the worker threads
+    class SceneCullingBenchmark : public Benchmark
+    {
+        bool mParallel;
+        SceneManager* mSceneMgr;
+        Camera* mCamera;
+        size_t mNumNodes;
+    public:
+        SceneCullingBenchmark(bool parallel)
+            : Benchmark(parallel ? "Culling/SceneManager::_findVisibleObjects parallel"
+                                 : "Culling/SceneManager::_findVisibleObjects")
+            , mParallel(parallel), mSceneMgr(0), mCamera(0), mNumNodes(0)
+        {
+        }
+
+        void setUp()
+        {
+            mSceneMgr = Root::getSingleton().createSceneManager();
+            mSceneMgr->setParallelCulling(mParallel);
+            mCamera = mSceneMgr->createCamera("Camera");
+            mCamera->setNearClipDistance(1);
+            mCamera->setFarClipDistance(1000);
+            mSceneMgr->getRootSceneNode()->attachObject(mCamera);
+
+            // Nodes spread around the camera, each with a small box so the
+            // bounds are not null. Frustums are the cheapest MovableObject
+            // which does not need a RenderSystem.
+            std::minstd_rand rng;
+            std::uniform_real_distribution<float> position(-1000, 1000);
+            for (int i = 0; i < 100; ++i)
+            {
+                SceneNode* group = mSceneMgr->getRootSceneNode()->createChildSceneNode(
+                    Vector3(position(rng), position(rng), position(rng)) * 0.5f);
+                for (int j = 0; j < 200; ++j)
+                {
+                    SceneNode* node = group->createChildSceneNode(
+                        Vector3(position(rng), position(rng), position(rng)) * 0.1f);
+                    Frustum* frustum = OGRE_NEW Frustum();
+                    frustum->setFarClipDistance(5);
+                    frustum->setVisible(false);
+                    node->attachObject(frustum);
+                    mFrustums.push_back(frustum);
+                    ++mNumNodes;
+                }
+            }
+            mSceneMgr->_updateSceneGraph(mCamera);
+        }
+
+        size_t run()
+        {
+            mSceneMgr->_findVisibleObjects(mCamera, 0, false);
+            return mNumNodes;
+        }
+
+        void tearDown()
+        {
+            Root::getSingleton().destroySceneManager(mSceneMgr);
+            for (size_t i = 0; i < mFrustums.size(); ++i)
+                OGRE_DELETE mFrustums[i];
+            mFrustums.clear();
+            mNumNodes = 0;
+        }
+    private:
+        vector<Frustum*>::type mFrustums;
+    };
+
+    void createCullingBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        benchmarks.push_back(new FrustumBenchmark(false));
+        benchmarks.push_back(new FrustumBenchmark(true));
+        benchmarks.push_back(new SceneCullingBenchmark(false));
+        benchmarks.push_back(new SceneCullingBenchmark(true));
+    }
+}
+
+REGISTER_BENCHMARKS(createCullingBenchmarks);
@@ -0,0 +1,114 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreRenderSystem.h"
+#include "OgreRenderWindow.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreCamera.h"
+
+using namespace Ogre;
+
+namespace
+{
+    /// Renders complete frames of a scene of cubes, serially or with parallel culling and queueing
+    class FrameBenchmark : public Benchmark
+    {
+        bool mParallel;
+        bool mParallelQueue;
+        SceneManager* mSceneMgr;
+        RenderWindow* mWindow;
+    public:
+        FrameBenchmark(bool parallel, bool parallelQueue)
+            : Benchmark(parallelQueue ? "Frame/Root::renderOneFrame parallel queueing"
+                        : parallel ? "Frame/Root::renderOneFrame parallel" : "Frame/Root::renderOneFrame")
+            , mParallel(parallel), mParallelQueue(parallelQueue), mSceneMgr(0), mWindow(0)
+        {
+        }
+
+        void setUp()
+        {
+            mSceneMgr = Root::getSingleton().createSceneManager();
+            mSceneMgr->setParallelCulling(mParallel);
+            mSceneMgr->setParallelRenderQueueUpdate(mParallelQueue);
+            mSceneMgr->setAmbientLight(ColourValue(0.5f, 0.5f, 0.5f));
+
+            Camera* camera = mSceneMgr->createCamera("Camera");
+            camera->setNearClipDistance(1);
+            camera->setFarClipDistance(5000);
+            SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(0, 0, 2000));
+            camNode->attachObject(camera);
+
+            mWindow = static_cast<RenderWindow*>(Root::getSingleton().getRenderTarget("Benchmark"));
+            mWindow->addViewport(camera);
+
+            // a grid of cubes, about half of them in front of the camera
+            for (int x = -10; x < 10; ++x)
+            {
+                for (int y = -10; y < 10; ++y)
+                {
+                    for (int z = -10; z < 10; ++z)
+                    {
+                        Entity* ent = mSceneMgr->createEntity(SceneManager::PT_CUBE);
+                        mSceneMgr->getRootSceneNode()
+                            ->createChildSceneNode(Vector3(x * 200.0f, y * 200.0f, z * 200.0f))
+                            ->attachObject(ent);
+                    }
+                }
+            }
+        }
+
+        size_t run()
+        {
+            Root::getSingleton().renderOneFrame();
+            return Root::getSingleton().getRenderSystem()->_getBatchCount();
+        }
+
+        void tearDown()
+        {
+            mWindow->removeAllViewports();
+            Root::getSingleton().destroySceneManager(mSceneMgr);
+        }
+    };
+
+    void createFrameBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        // complete frames need a RenderSystem
+        if (!Root::getSingleton().getRenderSystem())
+            return;
+
+        benchmarks.push_back(new FrameBenchmark(false, false));
+        benchmarks.push_back(new FrameBenchmark(true, false));
+        benchmarks.push_back(new FrameBenchmark(true, true));
+    }
+}
+
+REGISTER_BENCHMARKS(createFrameBenchmarks);
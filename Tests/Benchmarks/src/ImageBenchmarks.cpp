@@ -0,0 +1,375 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreImage.h"
+#include "OgreDataStream.h"
+#include "OgreImageCodec.h"
+#include "OgrePixelFormat.h"
+#include "OgreStringConverter.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    /// Random bytes, which are valid pixels for every format but float ones
+    void fillRandom(std::vector<uchar>& data)
+    {
+        std::minstd_rand rng;
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<uchar>(rng());
+    }
+
+    /// Values in [0, 1] for float formats
+    void fillRandomFloat(std::vector<uchar>& data)
+    {
+        std::minstd_rand rng;
+        std::uniform_real_distribution<float> value(0, 1);
+        float* values = reinterpret_cast<float*>(&data[0]);
+        for (size_t i = 0; i < data.size() / sizeof(float); ++i)
+            values[i] = value(rng);
+    }
+
+    /** PixelUtil::bulkPixelConversion, convertSRGBToLinear or convertLinearToSRGB
+        of a 1024x1024 image, items are pixels
+    */
+    class PixelConversionBenchmark : public Benchmark
+    {
+    public:
+        typedef void (*Conversion)(const PixelBox& src, const PixelBox& dst);
+    private:
+        PixelFormat mSrcFormat;
+        PixelFormat mDstFormat;
+        Conversion mConversion;
+        std::vector<uchar> mSrc;
+        std::vector<uchar> mDst;
+    public:
+        static const unsigned int numPixels = 1024 * 1024;
+
+        PixelConversionBenchmark(PixelFormat srcFormat, PixelFormat dstFormat,
+                                 Conversion conversion = PixelUtil::bulkPixelConversion,
+                                 const String& conversionName = "bulkPixelConversion")
+            : Benchmark("PixelUtil/" + conversionName + " " + PixelUtil::getFormatName(srcFormat) + " to " +
+                        PixelUtil::getFormatName(dstFormat))
+            , mSrcFormat(srcFormat), mDstFormat(dstFormat), mConversion(conversion)
+        {
+        }
+
+        void setUp()
+        {
+            mSrc.resize(PixelUtil::getMemorySize(numPixels, 1, 1, mSrcFormat));
+            mDst.resize(PixelUtil::getMemorySize(numPixels, 1, 1, mDstFormat));
+            if (PixelUtil::isFloatingPoint(mSrcFormat))
+                fillRandomFloat(mSrc);
+            else
+                fillRandom(mSrc);
+        }
+
+        size_t run()
+        {
+            mConversion(PixelBox(numPixels, 1, 1, mSrcFormat, &mSrc[0]),
+                        PixelBox(numPixels, 1, 1, mDstFormat, &mDst[0]));
+            return numPixels;
+        }
+
+        void tearDown()
+        {
+            mSrc.clear();
+            mDst.clear();
+        }
+    };
+
+    /// Image::scale of a 1024x1024 image, items are destination pixels
+    class ImageScaleBenchmark : public Benchmark
+    {
+        PixelFormat mFormat;
+        uint32 mDstSize;
+        Image::Filter mFilter;
+        bool mGammaCorrected;
+        std::vector<uchar> mSrc;
+        std::vector<uchar> mDst;
+    public:
+        static const uint32 srcSize = 1024;
+
+        ImageScaleBenchmark(PixelFormat format, uint32 dstSize, Image::Filter filter, const String& filterName,
+                            bool gammaCorrected = false)
+            : Benchmark("Image/scale " + PixelUtil::getFormatName(format) + " to " +
+                        StringConverter::toString(dstSize) + " " + filterName + (gammaCorrected ? " sRGB" : ""))
+            , mFormat(format), mDstSize(dstSize), mFilter(filter), mGammaCorrected(gammaCorrected)
+        {
+        }
+
+        void setUp()
+        {
+            mSrc.resize(PixelUtil::getMemorySize(srcSize, srcSize, 1, mFormat));
+            mDst.resize(PixelUtil::getMemorySize(mDstSize, mDstSize, 1, mFormat));
+            if (PixelUtil::isFloatingPoint(mFormat))
+                fillRandomFloat(mSrc);
+            else
+                fillRandom(mSrc);
+        }
+
+        size_t run()
+        {
+            PixelBox src(srcSize, srcSize, 1, mFormat, &mSrc[0]);
+            PixelBox dst(mDstSize, mDstSize, 1, mFormat, &mDst[0]);
+            Image::scale(src, dst, mFilter, mGammaCorrected);
+            return size_t(mDstSize) * mDstSize;
+        }
+
+        void tearDown()
+        {
+            mSrc.clear();
+            mDst.clear();
+        }
+    };
+
+    /// Image::generateMipmaps of a 2048x2048 image, items are source pixels
+    class GenerateMipmapsBenchmark : public Benchmark
+    {
+        PixelFormat mFormat;
+        Image::Filter mFilter;
+        bool mGammaCorrected;
+        std::vector<uchar> mSrc;
+        Image mImage;
+    public:
+        static const uint32 srcSize = 2048;
+
+        GenerateMipmapsBenchmark(PixelFormat format, Image::Filter filter, const String& filterName,
+                                 bool gammaCorrected = false)
+            : Benchmark("Image/generateMipmaps " + PixelUtil::getFormatName(format) + " " + filterName +
+                        (gammaCorrected ? " sRGB" : ""))
+            , mFormat(format), mFilter(filter), mGammaCorrected(gammaCorrected)
+        {
+        }
+
+        void setUp()
+        {
+            mSrc.resize(PixelUtil::getMemorySize(srcSize, srcSize, 1, mFormat));
+            if (PixelUtil::isFloatingPoint(mFormat))
+                fillRandomFloat(mSrc);
+            else
+                fillRandom(mSrc);
+        }
+
+        size_t run()
+        {
+            mImage.loadDynamicImage(&mSrc[0], srcSize, srcSize, 1, mFormat);
+            mImage.generateMipmaps(mGammaCorrected, mFilter);
+            return size_t(srcSize) * srcSize;
+        }
+
+        void tearDown()
+        {
+            mImage.freeMemory();
+            mSrc.clear();
+        }
+    };
+
+    /// DDSCodec::decode of a 1024x1024 block compressed image without mipmaps, items are pixels
+    class DDSDecodeBenchmark : public Benchmark
+    {
+        PixelFormat mFormat;
+        std::vector<uchar> mFile;
+        Codec* mCodec;
+    public:
+        static const uint32 size = 1024;
+
+        DDSDecodeBenchmark(PixelFormat format)
+            : Benchmark("Image/DDSCodec::decode " + PixelUtil::getFormatName(format)), mFormat(format), mCodec(0)
+        {
+        }
+
+        void setUp()
+        {
+            uint32 fourCC = 0, dxgiFormat = 0;
+            switch (mFormat)
+            {
+            case PF_DXT1: fourCC = FOURCC('D', 'X', 'T', '1'); break;
+            case PF_DXT3: fourCC = FOURCC('D', 'X', 'T', '3'); break;
+            case PF_DXT5: fourCC = FOURCC('D', 'X', 'T', '5'); break;
+            case PF_BC4_UNORM: dxgiFormat = 80; break;
+            case PF_BC5_UNORM: dxgiFormat = 83; break;
+            case PF_BC6H_UF16: dxgiFormat = 95; break;
+            default: dxgiFormat = 98; break;
+            }
+
+            // magic, DDS_HEADER and DDS_HEADER_DXT10 as 32 bit words
+            std::vector<uint32> header(1 + 31 + (dxgiFormat ? 5 : 0), 0);
+            header[0] = FOURCC('D', 'D', 'S', ' ');
+            header[1] = 124;                    // size
+            header[2] = 0x1007;                 // caps, height, width, pixel format
+            header[3] = size;                   // height
+            header[4] = size;                   // width
+            header[19] = 32;                    // pixel format size
+            header[20] = 0x4;                   // DDPF_FOURCC
+            header[21] = dxgiFormat ? FOURCC('D', 'X', '1', '0') : fourCC;
+            header[27] = 0x1000;                // DDSCAPS_TEXTURE
+            if (dxgiFormat)
+            {
+                header[32] = dxgiFormat;
+                header[33] = 3;                 // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+                header[35] = 1;                 // array size
+            }
+
+            std::vector<uchar> blocks(PixelUtil::getMemorySize(size, size, 1, mFormat));
+            fillRandom(blocks);
+            mFile.resize(header.size() * sizeof(uint32));
+            memcpy(&mFile[0], &header[0], mFile.size());
+            mFile.insert(mFile.end(), blocks.begin(), blocks.end());
+            mCodec = Codec::getCodec("dds");
+        }
+
+        size_t run()
+        {
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(&mFile[0], mFile.size()));
+            Codec::DecodeResult result = mCodec->decode(stream);
+            return size_t(size) * size;
+        }
+
+        void tearDown()
+        {
+            mFile.clear();
+        }
+
+        static uint32 FOURCC(char c0, char c1, char c2, char c3)
+        {
+            return uint32(c0) | (uint32(c1) << 8) | (uint32(c2) << 16) | (uint32(c3) << 24);
+        }
+    };
+
+    /// Image::compress of a 512x512 PF_BYTE_RGBA image of noisy gradients, items are pixels
+    class CompressBenchmark : public Benchmark
+    {
+        PixelFormat mFormat;
+        Image::CompressionQuality mQuality;
+        std::vector<uchar> mSrc;
+        Image mImage;
+    public:
+        static const uint32 size = 512;
+
+        CompressBenchmark(PixelFormat format, Image::CompressionQuality quality, const String& qualityName)
+            : Benchmark("Image/compress " + PixelUtil::getFormatName(format) + " " + qualityName)
+            , mFormat(format), mQuality(quality)
+        {
+        }
+
+        void setUp()
+        {
+            mSrc.resize(size * size * 4);
+            fillRandom(mSrc);
+            for (uint32 y = 0; y < size; ++y)
+            {
+                for (uint32 x = 0; x < size; ++x)
+                {
+                    uchar* p = &mSrc[(y * size + x) * 4];
+                    p[0] = uchar(x / 2 + p[0] % 8);
+                    p[1] = uchar(y / 2 + p[1] % 8);
+                    p[2] = uchar((x + y) / 4 + p[2] % 8);
+                    p[3] = uchar(255 - x / 4 - p[3] % 8);
+                }
+            }
+        }
+
+        size_t run()
+        {
+            mImage.loadDynamicImage(&mSrc[0], size, size, 1, PF_BYTE_RGBA);
+            mImage.compress(mFormat, mQuality);
+            return size_t(size) * size;
+        }
+
+        void tearDown()
+        {
+            mImage.freeMemory();
+            mSrc.clear();
+        }
+    };
+
+    void createImageBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        // the conversions done when uploading and loading textures
+        const PixelFormat conversions[][2] = {
+            { PF_A8R8G8B8, PF_A8B8G8R8 },
+            { PF_B8G8R8A8, PF_R8G8B8A8 },
+            { PF_R8G8B8, PF_A8R8G8B8 },
+            { PF_R8G8B8, PF_R8G8B8A8 },
+            { PF_A8R8G8B8, PF_R8G8B8 },
+            { PF_L8, PF_A8R8G8B8 },
+            { PF_BYTE_LA, PF_A8B8G8R8 },
+            { PF_R5G6B5, PF_A8R8G8B8 },
+            { PF_A8R8G8B8, PF_FLOAT32_RGBA },
+            { PF_R8G8B8, PF_FLOAT32_RGB },
+            { PF_FLOAT32_RGBA, PF_A8R8G8B8 },
+            { PF_FLOAT32_RGB, PF_R8G8B8 },
+            { PF_FLOAT16_RGBA, PF_FLOAT32_RGBA },
+            { PF_FLOAT32_RGBA, PF_FLOAT16_RGBA },
+            { PF_FLOAT32_RGB, PF_FLOAT16_RGB },
+        };
+        for (size_t i = 0; i < sizeof(conversions) / sizeof(conversions[0]); ++i)
+            benchmarks.push_back(new PixelConversionBenchmark(conversions[i][0], conversions[i][1]));
+
+        benchmarks.push_back(new PixelConversionBenchmark(PF_A8B8G8R8, PF_FLOAT32_RGBA,
+            PixelUtil::convertSRGBToLinear, "convertSRGBToLinear"));
+        benchmarks.push_back(new PixelConversionBenchmark(PF_FLOAT32_RGBA, PF_A8B8G8R8,
+            PixelUtil::convertLinearToSRGB, "convertLinearToSRGB"));
+
+        benchmarks.push_back(new ImageScaleBenchmark(PF_A8R8G8B8, 512, Image::FILTER_NEAREST, "nearest"));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_A8R8G8B8, 512, Image::FILTER_BILINEAR, "bilinear"));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_A8R8G8B8, 1536, Image::FILTER_BILINEAR, "bilinear"));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_FLOAT32_RGBA, 512, Image::FILTER_BILINEAR, "bilinear"));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_A8R8G8B8, 512, Image::FILTER_BOX, "box"));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_A8R8G8B8, 512, Image::FILTER_BILINEAR, "bilinear", true));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_A8R8G8B8, 384, Image::FILTER_LANCZOS, "lanczos"));
+        benchmarks.push_back(new ImageScaleBenchmark(PF_FLOAT32_RGBA, 384, Image::FILTER_KAISER, "kaiser"));
+
+        benchmarks.push_back(new GenerateMipmapsBenchmark(PF_A8R8G8B8, Image::FILTER_BOX, "box"));
+        benchmarks.push_back(new GenerateMipmapsBenchmark(PF_A8R8G8B8, Image::FILTER_BOX, "box", true));
+        benchmarks.push_back(new GenerateMipmapsBenchmark(PF_A8R8G8B8, Image::FILTER_KAISER, "kaiser", true));
+        benchmarks.push_back(new GenerateMipmapsBenchmark(PF_FLOAT16_RGBA, Image::FILTER_BOX, "box"));
+
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_DXT1));
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_DXT3));
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_DXT5));
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_BC4_UNORM));
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_BC5_UNORM));
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_BC6H_UF16));
+        benchmarks.push_back(new DDSDecodeBenchmark(PF_BC7_UNORM));
+
+        PixelFormat compressed[] = { PF_DXT1, PF_DXT5, PF_BC4_UNORM, PF_BC5_UNORM, PF_BC7_UNORM };
+        for (size_t i = 0; i < sizeof(compressed) / sizeof(compressed[0]); ++i)
+        {
+            benchmarks.push_back(new CompressBenchmark(compressed[i], Image::CQ_FAST, "fast"));
+            benchmarks.push_back(new CompressBenchmark(compressed[i], Image::CQ_NORMAL, "normal"));
+            benchmarks.push_back(new CompressBenchmark(compressed[i], Image::CQ_BEST, "best"));
+        }
+    }
+}
+
+REGISTER_BENCHMARKS(createImageBenchmarks);
@@ -0,0 +1,269 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreOptimisedUtil.h"
+#include "OgreEdgeListBuilder.h"
+#include "OgreMatrix4.h"
+#include "OgreVector4.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    const size_t numVertices = 65536;
+    const size_t numMatrices = 64;
+    const size_t numWeights = 4;
+
+    std::minstd_rand rng;
+
+    float random(float low, float high)
+    {
+        return std::uniform_real_distribution<float>(low, high)(rng);
+    }
+
+    /// SIMD aligned float buffer filled with random values
+    struct Buffer
+    {
+        float* data;
+        explicit Buffer(size_t count)
+            : data(static_cast<float*>(OGRE_MALLOC_SIMD(sizeof(float) * count, MEMCATEGORY_GENERAL)))
+        {
+            for (size_t i = 0; i < count; ++i)
+                data[i] = random(-10, 10);
+        }
+        ~Buffer() { OGRE_FREE_SIMD(data, MEMCATEGORY_GENERAL); }
+        operator float*() { return data; }
+    };
+
+    /// One OptimisedUtil function with its input data
+    struct Kernel
+    {
+        virtual ~Kernel() {}
+        /// Returns the number of vertices, matrices or triangles processed
+        virtual size_t run(OptimisedUtil* impl) = 0;
+    };
+
+    struct SkinningKernel : public Kernel
+    {
+        vector<Affine3>::type matrices;
+        vector<const Affine3*>::type blendMatrices;
+        Buffer src, dst, weights;
+        vector<unsigned char>::type indices;
+        bool normals;
+
+        SkinningKernel(bool _normals)
+            : matrices(numMatrices), blendMatrices(numMatrices)
+            , src(numVertices * 6), dst(numVertices * 6), weights(numVertices * numWeights)
+            , indices(numVertices * numWeights), normals(_normals)
+        {
+            for (size_t i = 0; i < numMatrices; ++i)
+            {
+                Quaternion q(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+                q.normalise();
+                matrices[i].makeTransform(Vector3(random(-5, 5), random(-5, 5), random(-5, 5)),
+                                          Vector3::UNIT_SCALE, q);
+                blendMatrices[i] = &matrices[i];
+            }
+            for (size_t i = 0; i < numVertices * numWeights; ++i)
+            {
+                weights[i] = 1.0f / numWeights;
+                indices[i] = static_cast<unsigned char>(rng() % numMatrices);
+            }
+        }
+
+        size_t run(OptimisedUtil* impl)
+        {
+            impl->softwareVertexSkinning(src, dst, normals ? src + 3 : NULL, normals ? dst + 3 : NULL,
+                weights, &indices[0], &blendMatrices[0],
+                24, 24, 24, 24, numWeights * sizeof(float), numWeights, numWeights, numVertices);
+            return numVertices;
+        }
+    };
+
+    struct MorphKernel : public Kernel
+    {
+        Buffer src1, src2, dst;
+        bool normals;
+
+        MorphKernel(bool _normals)
+            : src1(numVertices * 6), src2(numVertices * 6), dst(numVertices * 6), normals(_normals)
+        {
+        }
+
+        size_t run(OptimisedUtil* impl)
+        {
+            size_t vsize = normals ? 24 : 12;
+            impl->softwareVertexMorph(0.3f, src1, src2, dst, vsize, vsize, vsize, numVertices, normals);
+            return numVertices;
+        }
+    };
+
+    struct ConcatenateKernel : public Kernel
+    {
+        Affine3 base;
+        vector<Affine3>::type src, dst;
+
+        ConcatenateKernel()
+            : src(numVertices / 16), dst(numVertices / 16)
+        {
+            base.makeTransform(Vector3(1, 2, 3), Vector3(2, 2, 2), Quaternion::IDENTITY);
+            for (size_t i = 0; i < src.size(); ++i)
+                src[i].makeTransform(Vector3(random(-5, 5), random(-5, 5), random(-5, 5)),
+                                     Vector3::UNIT_SCALE, Quaternion::IDENTITY);
+        }
+
+        size_t run(OptimisedUtil* impl)
+        {
+            impl->concatenateAffineMatrices(base, &src[0], &dst[0], src.size());
+            return src.size();
+        }
+    };
+
+    struct ShadowKernel : public Kernel
+    {
+        enum Stage { FACE_NORMALS, LIGHT_FACING, EXTRUDE };
+
+        Stage stage;
+        Buffer positions, extruded;
+        vector<EdgeData::Triangle>::type triangles;
+        EdgeData::TriangleFaceNormalList faceNormals;
+        vector<char>::type lightFacings;
+
+        ShadowKernel(Stage _stage)
+            : stage(_stage), positions(numVertices * 3), extruded(numVertices * 3)
+            , triangles(numVertices), faceNormals(numVertices), lightFacings(numVertices)
+        {
+            for (size_t i = 0; i < numVertices; ++i)
+            {
+                for (int k = 0; k < 3; ++k)
+                    triangles[i].vertIndex[k] = rng() % numVertices;
+                faceNormals[i] = Vector4(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+            }
+        }
+
+        size_t run(OptimisedUtil* impl)
+        {
+            switch (stage)
+            {
+            case FACE_NORMALS:
+                impl->calculateFaceNormals(positions, &triangles[0], &faceNormals[0], numVertices);
+                break;
+            case LIGHT_FACING:
+                impl->calculateLightFacing(Vector4(10, 20, 30, 1), &faceNormals[0], &lightFacings[0], numVertices);
+                break;
+            case EXTRUDE:
+                impl->extrudeVertices(Vector4(10, 20, 30, 1), 100, positions, extruded, numVertices);
+                break;
+            }
+            return numVertices;
+        }
+    };
+
+    enum KernelType
+    {
+        SKINNING,
+        SKINNING_NORMALS,
+        MORPH,
+        MORPH_NORMALS,
+        CONCATENATE,
+        FACE_NORMALS,
+        LIGHT_FACING,
+        EXTRUDE,
+        NUM_KERNELS
+    };
+
+    const char* kernelNames[NUM_KERNELS] = {
+        "softwareVertexSkinning",
+        "softwareVertexSkinning normals",
+        "softwareVertexMorph",
+        "softwareVertexMorph normals",
+        "concatenateAffineMatrices",
+        "calculateFaceNormals",
+        "calculateLightFacing",
+        "extrudeVertices",
+    };
+
+    /// One kernel of one OptimisedUtil implementation
+    class OptimisedUtilBenchmark : public Benchmark
+    {
+        KernelType mType;
+        OptimisedUtil* mImpl;
+        Kernel* mKernel;
+    public:
+        OptimisedUtilBenchmark(KernelType type, OptimisedUtil* impl)
+            : Benchmark(String("OptimisedUtil/") + kernelNames[type] + " " + impl->getName())
+            , mType(type), mImpl(impl), mKernel(0)
+        {
+        }
+
+        void setUp()
+        {
+            // same data for every implementation
+            rng.seed();
+            switch (mType)
+            {
+            case SKINNING: mKernel = new SkinningKernel(false); break;
+            case SKINNING_NORMALS: mKernel = new SkinningKernel(true); break;
+            case MORPH: mKernel = new MorphKernel(false); break;
+            case MORPH_NORMALS: mKernel = new MorphKernel(true); break;
+            case CONCATENATE: mKernel = new ConcatenateKernel(); break;
+            case FACE_NORMALS: mKernel = new ShadowKernel(ShadowKernel::FACE_NORMALS); break;
+            case LIGHT_FACING: mKernel = new ShadowKernel(ShadowKernel::LIGHT_FACING); break;
+            default: mKernel = new ShadowKernel(ShadowKernel::EXTRUDE); break;
+            }
+        }
+
+        size_t run()
+        {
+            return mKernel->run(mImpl);
+        }
+
+        void tearDown()
+        {
+            delete mKernel;
+            mKernel = 0;
+        }
+    };
+
+    /// Every kernel of every implementation usable on this machine, the
+    /// general one first as the reference
+    void createOptimisedUtilBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        const vector<OptimisedUtil*>::type& impls = OptimisedUtil::getAvailableImplementations();
+        for (int k = 0; k < NUM_KERNELS; ++k)
+        {
+            for (size_t i = 0; i < impls.size(); ++i)
+                benchmarks.push_back(new OptimisedUtilBenchmark(KernelType(k), impls[i]));
+        }
+    }
+}
+
+REGISTER_BENCHMARKS(createOptimisedUtilBenchmarks);
@@ -0,0 +1,189 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreCamera.h"
+#include "OgreRenderQueue.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreRadixSort.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgreRenderable.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    const size_t numRenderables = 20000;
+    const size_t numMaterials = 64;
+
+    /// Renderable with just a position, which is all the sorting looks at
+    class PointRenderable : public Renderable
+    {
+        MaterialPtr mMaterial;
+        Vector3 mPosition;
+        LightList mLights;
+    public:
+        PointRenderable(const MaterialPtr& material, const Vector3& position)
+            : mMaterial(material), mPosition(position) {}
+
+        const MaterialPtr& getMaterial(void) const { return mMaterial; }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const { xform->makeTrans(mPosition); }
+        Real getSquaredViewDepth(const Camera* cam) const
+        {
+            return (mPosition - cam->getDerivedPosition()).squaredLength();
+        }
+        const LightList& getLights(void) const { return mLights; }
+    };
+
+    /** Fills the main render queue group with opaque and transparent
+        renderables and sorts it, as SceneManager does every frame.
+        Techniques are passed directly, RenderQueue::addRenderable would
+        need a RenderSystem to find a supported one.
+    */
+    class RenderQueueBenchmark : public Benchmark
+    {
+        bool mSortKeys;
+        SceneManager* mSceneMgr;
+        Camera* mCamera;
+        RenderQueue* mQueue;
+        vector<MaterialPtr>::type mMaterials;
+        vector<PointRenderable*>::type mRenderables;
+    public:
+        RenderQueueBenchmark(bool sortKeys)
+            : Benchmark(sortKeys ? "RenderQueue/addRenderable and sort keys" : "RenderQueue/addRenderable and sort")
+            , mSortKeys(sortKeys), mSceneMgr(0), mCamera(0), mQueue(0)
+        {
+        }
+
+        void setUp()
+        {
+            mSceneMgr = Root::getSingleton().createSceneManager();
+            mCamera = mSceneMgr->createCamera("Camera");
+            // RenderQueue::clear only clears the queues of the scene managers
+            mQueue = mSceneMgr->getRenderQueue();
+            mQueue->setSortKeysEnabled(mSortKeys);
+
+            // one in four materials is alpha blended, so needs depth sorting
+            for (size_t i = 0; i < numMaterials; ++i)
+            {
+                MaterialPtr mat = MaterialManager::getSingleton().create(
+                    "Benchmark/RenderQueue/" + StringConverter::toString(i),
+                    ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+                if (i % 4 == 0)
+                {
+                    mat->setSceneBlending(SBT_TRANSPARENT_ALPHA);
+                    mat->setDepthWriteEnabled(false);
+                }
+                mMaterials.push_back(mat);
+            }
+
+            std::minstd_rand rng;
+            std::uniform_real_distribution<float> position(-1000, 1000);
+            for (size_t i = 0; i < numRenderables; ++i)
+            {
+                mRenderables.push_back(new PointRenderable(mMaterials[rng() % numMaterials],
+                    Vector3(position(rng), position(rng), position(rng))));
+            }
+        }
+
+        size_t run()
+        {
+            mQueue->clear();
+            RenderQueueGroup* group = mQueue->getQueueGroup(RENDER_QUEUE_MAIN);
+            for (size_t i = 0; i < mRenderables.size(); ++i)
+            {
+                PointRenderable* rend = mRenderables[i];
+                group->addRenderable(rend, rend->getMaterial()->getTechnique(0),
+                                     OGRE_RENDERABLE_DEFAULT_PRIORITY);
+            }
+
+            RenderQueueGroup::PriorityMapIterator it = group->getIterator();
+            while (it.hasMoreElements())
+                it.getNext()->sort(mCamera);
+
+            return mRenderables.size();
+        }
+
+        void tearDown()
+        {
+            for (size_t i = 0; i < mRenderables.size(); ++i)
+                delete mRenderables[i];
+            mRenderables.clear();
+            for (size_t i = 0; i < mMaterials.size(); ++i)
+                MaterialManager::getSingleton().remove(mMaterials[i]);
+            mMaterials.clear();
+            Root::getSingleton().destroySceneManager(mSceneMgr);
+        }
+    };
+
+    struct FloatFunctor
+    {
+        float operator()(const float& f) const { return f; }
+    };
+
+    /// Sorts random floats with RadixSort, which is used for depth sorting
+    class RadixSortBenchmark : public Benchmark
+    {
+        std::vector<float> mValues;
+        std::vector<float> mSorted;
+        RadixSort<std::vector<float>, float, float> mSorter;
+    public:
+        RadixSortBenchmark() : Benchmark("RenderQueue/RadixSort float") {}
+
+        void setUp()
+        {
+            std::minstd_rand rng;
+            std::uniform_real_distribution<float> value(-1000, 1000);
+            mValues.resize(100000);
+            for (size_t i = 0; i < mValues.size(); ++i)
+                mValues[i] = value(rng);
+        }
+
+        size_t run()
+        {
+            mSorted = mValues;
+            mSorter.sort(mSorted, FloatFunctor());
+            return mSorted.size();
+        }
+    };
+
+    void createRenderQueueBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        benchmarks.push_back(new RenderQueueBenchmark(false));
+        benchmarks.push_back(new RenderQueueBenchmark(true));
+        benchmarks.push_back(new RadixSortBenchmark());
+    }
+}
+
+REGISTER_BENCHMARKS(createRenderQueueBenchmarks);
@@ -0,0 +1,106 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    /** Moves every node of a three level scene graph, then updates the
+        derived transforms and bounds, serially or on the worker threads.
+    */
+    class SceneGraphUpdateBenchmark : public Benchmark
+    {
+        bool mParallel;
+        SceneManager* mSceneMgr;
+        Camera* mCamera;
+        vector<SceneNode*>::type mNodes;
+    public:
+        SceneGraphUpdateBenchmark(bool parallel)
+            : Benchmark(parallel ? "SceneGraph/_updateSceneGraph parallel" : "SceneGraph/_updateSceneGraph")
+            , mParallel(parallel), mSceneMgr(0), mCamera(0)
+        {
+        }
+
+        void setUp()
+        {
+            mSceneMgr = Root::getSingleton().createSceneManager();
+            mSceneMgr->setParallelSceneGraphUpdate(mParallel);
+            mCamera = mSceneMgr->createCamera("Camera");
+
+            std::minstd_rand rng;
+            std::uniform_real_distribution<float> position(-100, 100);
+            for (int i = 0; i < 10; ++i)
+            {
+                SceneNode* parent = mSceneMgr->getRootSceneNode()->createChildSceneNode(
+                    Vector3(position(rng), position(rng), position(rng)));
+                mNodes.push_back(parent);
+                for (int j = 0; j < 20; ++j)
+                {
+                    SceneNode* child = parent->createChildSceneNode(
+                        Vector3(position(rng), position(rng), position(rng)));
+                    mNodes.push_back(child);
+                    for (int k = 0; k < 100; ++k)
+                    {
+                        mNodes.push_back(child->createChildSceneNode(
+                            Vector3(position(rng), position(rng), position(rng))));
+                    }
+                }
+            }
+        }
+
+        size_t run()
+        {
+            for (size_t i = 0; i < mNodes.size(); ++i)
+                mNodes[i]->yaw(Radian(0.01f));
+            mSceneMgr->_updateSceneGraph(mCamera);
+            return mNodes.size();
+        }
+
+        void tearDown()
+        {
+            Root::getSingleton().destroySceneManager(mSceneMgr);
+            mNodes.clear();
+        }
+    };
+
+    void createSceneGraphBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        benchmarks.push_back(new SceneGraphUpdateBenchmark(false));
+        benchmarks.push_back(new SceneGraphUpdateBenchmark(true));
+    }
+}
+
+REGISTER_BENCHMARKS(createSceneGraphBenchmarks);
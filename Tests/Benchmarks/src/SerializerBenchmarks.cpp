@@ -0,0 +1,171 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreMesh.h"
+#include "OgreMeshManager.h"
+#include "OgreMeshSerializer.h"
+#include "OgreSkeleton.h"
+#include "OgreSkeletonManager.h"
+#include "OgreStringConverter.h"
+#include "OgreSkeletonSerializer.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreBone.h"
+#include "OgreSubMesh.h"
+
+using namespace Ogre;
+
+namespace
+{
+    /// Copy of everything written to stream since its start
+    std::vector<uchar> getWrittenData(const DataStreamPtr& stream)
+    {
+        size_t size = stream->tell();
+        std::vector<uchar> data(size);
+        stream->seek(0);
+        stream->read(&data[0], size);
+        return data;
+    }
+
+    /** Deserialises a skinned 256x256 vertex grid with positions, normals
+        and texture coordinates from memory.
+    */
+    class MeshImportBenchmark : public Benchmark
+    {
+        std::vector<uchar> mData;
+        size_t mNumVertices;
+    public:
+        MeshImportBenchmark() : Benchmark("Serializer/MeshSerializer::importMesh"), mNumVertices(0) {}
+
+        void setUp()
+        {
+            MeshPtr mesh = MeshManager::getSingleton().createPlane(
+                "Benchmark/Export.mesh", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+                Plane(Vector3::UNIT_Z, 0), 100, 100, 255, 255);
+
+            // two bones per vertex, as for a character
+            mNumVertices = mesh->sharedVertexData->vertexCount;
+            for (size_t v = 0; v < mNumVertices; ++v)
+            {
+                for (unsigned short b = 0; b < 2; ++b)
+                {
+                    VertexBoneAssignment vba;
+                    vba.vertexIndex = static_cast<unsigned int>(v);
+                    vba.boneIndex = static_cast<unsigned short>((v + b) % 32);
+                    vba.weight = 0.5f;
+                    mesh->addBoneAssignment(vba);
+                }
+            }
+
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(64 << 20));
+            MeshSerializer().exportMesh(mesh.get(), stream);
+            mData = getWrittenData(stream);
+            MeshManager::getSingleton().remove(mesh);
+        }
+
+        size_t run()
+        {
+            MeshPtr mesh = MeshManager::getSingleton().create(
+                "Benchmark/Import.mesh", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(&mData[0], mData.size(), false, true));
+            MeshSerializer().importMesh(stream, mesh.get());
+            MeshManager::getSingleton().remove(mesh);
+            return mNumVertices;
+        }
+    };
+
+    /** Deserialises a skeleton of 64 bones with an animation of 60 key
+        frames per bone from memory.
+    */
+    class SkeletonImportBenchmark : public Benchmark
+    {
+        std::vector<uchar> mData;
+        size_t mNumKeyFrames;
+    public:
+        SkeletonImportBenchmark()
+            : Benchmark("Serializer/SkeletonSerializer::importSkeleton"), mNumKeyFrames(0) {}
+
+        void setUp()
+        {
+            const unsigned short numBones = 64;
+            const int numKeyFrames = 60;
+
+            SkeletonPtr skeleton = SkeletonManager::getSingleton().create(
+                "Benchmark/Export.skeleton", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+            Bone* parent = 0;
+            for (unsigned short b = 0; b < numBones; ++b)
+            {
+                Bone* bone = skeleton->createBone("Bone" + StringConverter::toString(b), b);
+                bone->setPosition(0, 1, 0);
+                if (parent)
+                    parent->addChild(bone);
+                // a few chains rather than one
+                parent = b % 16 == 15 ? 0 : bone;
+            }
+            skeleton->setBindingPose();
+
+            Animation* anim = skeleton->createAnimation("Walk", 2.0f);
+            for (unsigned short b = 0; b < numBones; ++b)
+            {
+                NodeAnimationTrack* track = anim->createNodeTrack(b, skeleton->getBone(b));
+                for (int k = 0; k < numKeyFrames; ++k)
+                {
+                    TransformKeyFrame* key = track->createNodeKeyFrame(k * 2.0f / numKeyFrames);
+                    key->setRotation(Quaternion(Radian(k * 0.1f), Vector3::UNIT_X));
+                    key->setTranslate(Vector3(0, 0.01f * k, 0));
+                }
+            }
+            mNumKeyFrames = numBones * numKeyFrames;
+
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(16 << 20));
+            SkeletonSerializer().exportSkeleton(skeleton.get(), stream);
+            mData = getWrittenData(stream);
+            SkeletonManager::getSingleton().remove(skeleton);
+        }
+
+        size_t run()
+        {
+            SkeletonPtr skeleton = SkeletonManager::getSingleton().create(
+                "Benchmark/Import.skeleton", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(&mData[0], mData.size(), false, true));
+            SkeletonSerializer().importSkeleton(stream, skeleton.get());
+            SkeletonManager::getSingleton().remove(skeleton);
+            return mNumKeyFrames;
+        }
+    };
+
+    void createSerializerBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        benchmarks.push_back(new MeshImportBenchmark());
+        benchmarks.push_back(new SkeletonImportBenchmark());
+    }
+}
+
+REGISTER_BENCHMARKS(createSerializerBenchmarks);
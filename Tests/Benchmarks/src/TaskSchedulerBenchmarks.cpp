@@ -0,0 +1,125 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreTaskScheduler.h"
+#include "OgreMath.h"
+
+using namespace Ogre;
+
+namespace
+{
+    /// Some arithmetic per element, so the run time is dominated by computation
+    struct TransformJob : public TaskScheduler::RangeJob
+    {
+        vector<float>::type& mValues;
+        TransformJob(vector<float>::type& values) : mValues(values) {}
+        void execute(size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                float v = mValues[i];
+                for (int k = 0; k < 16; ++k)
+                    v = Math::Sqrt(v * v + 1.0f) - 0.5f;
+                mValues[i] = v;
+            }
+        }
+    };
+
+    struct EmptyTask : public Task
+    {
+        void execute(void) {}
+    };
+
+    /// TaskScheduler::parallelFor limited to a number of threads, to show the scaling
+    class ParallelForBenchmark : public Benchmark
+    {
+        size_t mThreads;
+        vector<float>::type mValues;
+    public:
+        static const size_t numValues = 1 << 20;
+        static const size_t grainSize = 4096;
+
+        ParallelForBenchmark(size_t threads)
+            : Benchmark("TaskScheduler/parallelFor " + StringConverter::toString(threads) + " threads")
+            , mThreads(threads)
+        {
+        }
+
+        void setUp()
+        {
+            mValues.assign(numValues, 1.0f);
+        }
+
+        size_t run()
+        {
+            TransformJob job(mValues);
+            Root::getSingleton().getTaskScheduler()->parallelFor(0, numValues, grainSize, job, mThreads);
+            return numValues;
+        }
+
+        void tearDown()
+        {
+            mValues.clear();
+        }
+    };
+
+    /// Overhead of scheduling many small tasks
+    class EmptyTasksBenchmark : public Benchmark
+    {
+    public:
+        EmptyTasksBenchmark() : Benchmark("TaskScheduler/submit empty tasks") {}
+
+        size_t run()
+        {
+            // tasks can only be submitted once, so create new ones for each iteration
+            vector<EmptyTask>::type tasks(10000);
+
+            TaskScheduler* scheduler = Root::getSingleton().getTaskScheduler();
+            TaskGroup group;
+            for (size_t i = 0; i < tasks.size(); ++i)
+                scheduler->submit(&tasks[i], group);
+            scheduler->wait(group);
+            return tasks.size();
+        }
+    };
+
+    void createTaskSchedulerBenchmarks(std::vector<Benchmark*>& benchmarks)
+    {
+        // powers of two, then all threads
+        size_t maxThreads = Root::getSingleton().getTaskScheduler()->getThreadCount();
+        for (size_t threads = 1; threads < maxThreads; threads *= 2)
+            benchmarks.push_back(new ParallelForBenchmark(threads));
+        benchmarks.push_back(new ParallelForBenchmark(maxThreads));
+
+        benchmarks.push_back(new EmptyTasksBenchmark());
+    }
+}
+
+REGISTER_BENCHMARKS(createTaskSchedulerBenchmarks);
@@ -0,0 +1,260 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+
+#include "OgreRoot.h"
+#include "OgreLogManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreOptimisedUtil.h"
+#include "OgrePlatformInformation.h"
+#include "OgreWorkQueue.h"
+#include "OgreTimer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+using namespace Ogre;
+
+BenchmarkRegistration::BenchmarkRegistration(BenchmarkFactory factory)
+{
+    getFactories().push_back(factory);
+}
+//--------------------------------------------------------------------------
+std::vector<BenchmarkFactory>& BenchmarkRegistration::getFactories()
+{
+    static std::vector<BenchmarkFactory> factories;
+    return factories;
+}
+
+namespace
+{
+    struct Result
+    {
+        String name;
+        size_t iterations;
+        size_t items;
+        double seconds;
+
+        double nsPerItem() const { return seconds * 1e9 / std::max<size_t>(items, 1); }
+        double itemsPerSecond() const { return items / seconds; }
+    };
+
+    String escapeJson(const String& str)
+    {
+        String ret;
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+            if (str[i] == '"' || str[i] == '\\')
+                ret += '\\';
+            ret += str[i];
+        }
+        return ret;
+    }
+
+    void writeCsv(FILE* out, const std::vector<Result>& results)
+    {
+        fprintf(out, "name,iterations,items,seconds,ns_per_item,items_per_second\n");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            fprintf(out, "\"%s\",%zu,%zu,%.6f,%.3f,%.1f\n", r.name.c_str(), r.iterations, r.items,
+                    r.seconds, r.nsPerItem(), r.itemsPerSecond());
+        }
+    }
+
+    void writeJson(FILE* out, const std::vector<Result>& results, double minTime)
+    {
+        // the context needed to compare runs across versions and machines
+        fprintf(out, "{\n");
+        fprintf(out, "  \"ogre_version\": \"%d.%d.%d\",\n", OGRE_VERSION_MAJOR, OGRE_VERSION_MINOR, OGRE_VERSION_PATCH);
+        fprintf(out, "  \"cpu\": \"%s\",\n", escapeJson(PlatformInformation::getCpuIdentifier()).c_str());
+        fprintf(out, "  \"optimised_util\": \"%s\",\n", OptimisedUtil::getImplementation()->getName());
+        fprintf(out, "  \"min_time\": %.3f,\n", minTime);
+        fprintf(out, "  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            fprintf(out, "    {\"name\": \"%s\", \"iterations\": %zu, \"items\": %zu, \"seconds\": %.6f, "
+                    "\"ns_per_item\": %.3f, \"items_per_second\": %.1f}%s\n",
+                    escapeJson(r.name).c_str(), r.iterations, r.items, r.seconds, r.nsPerItem(),
+                    r.itemsPerSecond(), i + 1 < results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+    }
+
+    void printUsage(const char* program)
+    {
+        printf("Usage: %s [options]\n"
+               "  --filter <text>     only run benchmarks whose name contains text\n"
+               "  --list              list the benchmarks and exit\n"
+               "  --min-time <s>      measure each benchmark for at least s seconds, default 0.5\n"
+               "  --format <f>        text, csv or json, default text\n"
+               "  --output <file>     write csv or json results to file rather than stdout\n",
+               program);
+    }
+}
+
+/** Runs the OgreMain benchmark suite. Progress goes to stderr, so the csv
+    or json results on stdout can be piped directly.
+*/
+int main(int argc, char** argv)
+{
+    String filter;
+    String format = "text";
+    String outputFile;
+    double minTime = 0.5;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--filter") == 0 && hasValue)
+            filter = argv[++i];
+        else if (strcmp(argv[i], "--format") == 0 && hasValue)
+            format = argv[++i];
+        else if (strcmp(argv[i], "--output") == 0 && hasValue)
+            outputFile = argv[++i];
+        else if (strcmp(argv[i], "--min-time") == 0 && hasValue)
+            minTime = atof(argv[++i]);
+        else if (strcmp(argv[i], "--list") == 0)
+            listOnly = true;
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (format != "text" && format != "csv" && format != "json")
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // keep the output to the results
+    LogManager logManager;
+    logManager.createLog("", true, false, true);
+
+    Root root("");
+#ifdef OGRE_BENCHMARK_NULL_PLUGIN
+    // run complete frames without a GPU
+    root.loadPlugin(OGRE_BENCHMARK_NULL_PLUGIN);
+    root.setRenderSystem(root.getAvailableRenderers().front());
+    root.initialise(false);
+    root.createRenderWindow("Benchmark", 1280, 720, false);
+#else
+    DefaultHardwareBufferManager hbm;
+    MaterialManager::getSingleton().initialise();
+#endif
+    // for the parallel variants
+    root.getWorkQueue()->startup();
+
+    std::vector<Benchmark*> benchmarks;
+    const std::vector<BenchmarkFactory>& factories = BenchmarkRegistration::getFactories();
+    for (size_t i = 0; i < factories.size(); ++i)
+        factories[i](benchmarks);
+
+    bool text = format == "text";
+    bool failed = false;
+    std::vector<Result> results;
+    Timer timer;
+
+    for (size_t b = 0; b < benchmarks.size(); ++b)
+    {
+        Benchmark* benchmark = benchmarks[b];
+        if (!filter.empty() && benchmark->getName().find(filter) == String::npos)
+            continue;
+
+        if (listOnly)
+        {
+            printf("%s\n", benchmark->getName().c_str());
+            continue;
+        }
+
+        if (!text)
+            fprintf(stderr, "%s\n", benchmark->getName().c_str());
+
+        Result result;
+        result.name = benchmark->getName();
+        result.iterations = 0;
+        result.items = 0;
+        try
+        {
+            benchmark->setUp();
+            // warm up the caches
+            benchmark->run();
+
+            timer.reset();
+            do
+            {
+                result.items += benchmark->run();
+                ++result.iterations;
+                result.seconds = timer.getMicroseconds() * 1e-6;
+            } while (result.seconds < minTime);
+        }
+        catch (Exception& e)
+        {
+            fprintf(stderr, "%s failed: %s\n", benchmark->getName().c_str(), e.getFullDescription().c_str());
+            failed = true;
+            continue;
+        }
+
+        benchmark->tearDown();
+        results.push_back(result);
+
+        if (text)
+        {
+            printf("%-64s %12.2f ns/item %12.3f Mitems/s\n", result.name.c_str(), result.nsPerItem(),
+                   result.itemsPerSecond() * 1e-6);
+        }
+    }
+
+    for (size_t b = 0; b < benchmarks.size(); ++b)
+        delete benchmarks[b];
+
+    if (text || listOnly)
+        return failed ? 1 : 0;
+
+    FILE* out = outputFile.empty() ? stdout : fopen(outputFile.c_str(), "w");
+    if (!out)
+    {
+        fprintf(stderr, "Cannot open %s\n", outputFile.c_str());
+        return 1;
+    }
+
+    if (format == "csv")
+        writeCsv(out, results);
+    else
+        writeJson(out, results, minTime);
+
+    if (out != stdout)
+        fclose(out);
+    return failed ? 1 : 0;
+}
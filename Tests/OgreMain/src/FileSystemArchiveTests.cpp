@@ -258,6 +258,32 @@ TEST_F(FileSystemArchiveTests,FileRead)
     EXPECT_TRUE(stream->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,MappedFileRead)
+{
+    FileSystemArchiveFactory::setUseMemoryMapping(true);
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+    DataStreamPtr rwStream = mArch->open("rootfile.txt", false);
+    FileSystemArchiveFactory::setUseMemoryMapping(false);
+
+    // only read-only streams are mapped
+    MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get());
+    ASSERT_TRUE(memStream);
+    EXPECT_FALSE(dynamic_cast<MemoryDataStream*>(rwStream.get()));
+    EXPECT_FALSE(stream->isWriteable());
+    EXPECT_EQ((size_t)mFileSizeRoot1, stream->size());
+
+    EXPECT_EQ(0, memcmp(memStream->getPtr(), "this is line 1 in file 1", 24));
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    stream->skipLine();
+    stream->skipLine();
+    stream->skipLine();
+    EXPECT_EQ(String("this is line 5 in file 1"), stream->getLine());
+    EXPECT_TRUE(stream->eof());
+
+    stream->close();
+    EXPECT_FALSE(memStream->getPtr());
+}
+//--------------------------------------------------------------------------
 TEST_F(FileSystemArchiveTests,ReadInterleave)
 {
     // Test overlapping reads from same archive
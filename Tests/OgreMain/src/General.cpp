@@ -31,11 +31,32 @@ THE SOFTWARE.
 #include "OgreSceneNode.h"
 #include "OgreEntity.h"
 #include "OgreCamera.h"
+#include "OgreFrustum.h"
+#include "OgreWorkQueue.h"
+#include "OgreWorkStealingWorkQueue.h"
+#include "OgreRenderQueue.h"
+#include "OgreSubEntity.h"
+#include "OgreSubMesh.h"
+#include "OgreMesh.h"
+#include "OgreAnimationState.h"
+#include "OgreRectangle2D.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgreAutoParamDataSource.h"
+#include "OgreMeshManager.h"
+#include "OgreMeshSerializer.h"
+#include "OgreFileSystem.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreScriptCompiler.h"
 #include "RootWithoutRenderSystemFixture.h"
 #include "OgreStaticPluginLoader.h"
 
+#include <fstream>
+
 #if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
 #include <random>
+#include <thread>
 using std::minstd_rand;
 #else
 #include <tr1/random>
@@ -155,3 +176,1196 @@ TEST_F(SceneQueryTest, Ray) {
     ASSERT_EQ("501", results[0].movable->getName());
     ASSERT_EQ("397", results[1].movable->getName());
 }
+
+struct NodeUpdateCounter : public Node::Listener, public MovableObject::Listener
+{
+    size_t mCount;
+    size_t mMovedCount;
+    std::thread::id mThread;
+    bool mOtherThread;
+    /// Position of each updated node in the graph, and of the node of each moved object
+    StringVector mCalls;
+    NodeUpdateCounter() : mCount(0), mMovedCount(0), mThread(std::this_thread::get_id()), mOtherThread(false) {}
+    void nodeUpdated(const Node* node) { ++mCount; checkThread(); mCalls.push_back(getPath(node)); }
+    void objectMoved(MovableObject* obj)
+    {
+        ++mMovedCount;
+        checkThread();
+        mCalls.push_back(getPath(obj->getParentNode()) + "/object");
+    }
+    void checkThread() { mOtherThread |= std::this_thread::get_id() != mThread; }
+    void reset()
+    {
+        mCount = mMovedCount = 0;
+        mCalls.clear();
+    }
+
+    static String getPath(const Node* node)
+    {
+        String path;
+        for (; node->getParent(); node = node->getParent())
+        {
+            const Node::ChildNodeMap& siblings = node->getParent()->getChildren();
+            size_t index = std::find(siblings.begin(), siblings.end(), node) - siblings.begin();
+            path = "/" + StringConverter::toString(index) + path;
+        }
+        return path;
+    }
+};
+
+/// SceneNode subclass doing its own work when updated
+struct UpdateCountingNode : public SceneNode
+{
+    size_t mUpdates;
+    UpdateCountingNode(SceneManager* creator) : SceneNode(creator), mUpdates(0) {}
+    void _update(bool updateChildren, bool parentHasChanged)
+    {
+        SceneNode::_update(updateChildren, parentHasChanged);
+        ++mUpdates;
+    }
+};
+
+static void createRandomTree(SceneNode* parent, Entity* ent, int depth, minstd_rand& rng,
+                             NodeUpdateCounter* listener)
+{
+    for (int n = 0; n < 4; ++n)
+    {
+        SceneNode* node = parent->createChildSceneNode(
+            Vector3(Real(rng() % 100), Real(rng() % 100), Real(rng() % 100)),
+            Quaternion(Degree(Real(rng() % 360)), Vector3::UNIT_Y));
+        node->setListener(listener);
+
+        if (depth)
+            createRandomTree(node, ent, depth - 1, rng, listener);
+        else
+        {
+            Entity* clone = ent->clone(ent->getName() + StringConverter::toString(rng()));
+            clone->setListener(listener);
+            node->attachObject(clone);
+        }
+    }
+}
+
+static void expectSameTransforms(const Node* a, const Node* b)
+{
+    EXPECT_EQ(a->_getDerivedPosition(), b->_getDerivedPosition());
+    EXPECT_EQ(a->_getDerivedOrientation(), b->_getDerivedOrientation());
+    EXPECT_EQ(a->_getDerivedScale(), b->_getDerivedScale());
+    EXPECT_EQ(static_cast<const SceneNode*>(a)->_getWorldAABB(),
+              static_cast<const SceneNode*>(b)->_getWorldAABB());
+
+    ASSERT_EQ(a->numChildren(), b->numChildren());
+    for (unsigned short i = 0; i < a->numChildren(); ++i)
+        expectSameTransforms(a->getChild(i), b->getChild(i));
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParallelSceneGraphUpdate)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* serial = mRoot->createSceneManager();
+    SceneManager* parallel = mRoot->createSceneManager();
+    parallel->setParallelSceneGraphUpdate(true);
+    parallel->setParallelThreadCount(4);
+
+    NodeUpdateCounter serialCounter, parallelCounter;
+    minstd_rand serialRng, parallelRng;
+    createRandomTree(serial->getRootSceneNode(), serial->createEntity("serial", "sphere.mesh"), 4,
+                     serialRng, &serialCounter);
+    createRandomTree(parallel->getRootSceneNode(), parallel->createEntity("parallel", "sphere.mesh"), 4,
+                     parallelRng, &parallelCounter);
+
+    // a node class whose _update does more than SceneNode's, with a subtree of its own
+    UpdateCountingNode serialCustom(serial), parallelCustom(parallel);
+    serial->getRootSceneNode()->getChild(0)->addChild(&serialCustom);
+    parallel->getRootSceneNode()->getChild(0)->addChild(&parallelCustom);
+    createRandomTree(&serialCustom, serial->getEntity("serial"), 1, serialRng, &serialCounter);
+    createRandomTree(&parallelCustom, parallel->getEntity("parallel"), 1, parallelRng, &parallelCounter);
+
+    Camera* serialCam = serial->createCamera("Camera");
+    Camera* parallelCam = parallel->createCamera("Camera");
+
+    serial->_updateSceneGraph(serialCam);
+    parallel->_updateSceneGraph(parallelCam);
+    expectSameTransforms(serial->getRootSceneNode(), parallel->getRootSceneNode());
+    EXPECT_EQ(serialCounter.mCount, parallelCounter.mCount);
+    EXPECT_EQ(serialCounter.mMovedCount, parallelCounter.mMovedCount);
+    EXPECT_GT(parallelCounter.mMovedCount, size_t(0));
+    // also for the nodes at the top, which are updated before the subtrees
+    EXPECT_EQ(serialCounter.mCalls, parallelCounter.mCalls);
+    // the listeners are only called on this thread
+    EXPECT_FALSE(parallelCounter.mOtherThread);
+    EXPECT_EQ(serialCustom.mUpdates, size_t(1));
+    EXPECT_EQ(parallelCustom.mUpdates, size_t(1));
+
+    // only some branches need an update now
+    Node* serialNode = serial->getRootSceneNode()->getChild(1)->getChild(2);
+    Node* parallelNode = parallel->getRootSceneNode()->getChild(1)->getChild(2);
+    serialNode->translate(10, 0, 0);
+    parallelNode->translate(10, 0, 0);
+    serialNode->getChild(0)->getChild(3)->setScale(2, 2, 2);
+    parallelNode->getChild(0)->getChild(3)->setScale(2, 2, 2);
+
+    serialCounter.reset();
+    parallelCounter.reset();
+    serial->_updateSceneGraph(serialCam);
+    parallel->_updateSceneGraph(parallelCam);
+    expectSameTransforms(serial->getRootSceneNode(), parallel->getRootSceneNode());
+    EXPECT_EQ(serialCounter.mCount, parallelCounter.mCount);
+    EXPECT_EQ(serialCounter.mMovedCount, parallelCounter.mMovedCount);
+    EXPECT_EQ(serialCounter.mCalls, parallelCounter.mCalls);
+    EXPECT_FALSE(parallelCounter.mOtherThread);
+    EXPECT_LT(parallelCounter.mCount, size_t(100));
+
+    // the custom nodes and the listeners go out of scope first
+    serialCustom.removeAndDestroyAllChildren();
+    parallelCustom.removeAndDestroyAllChildren();
+    serialCustom.getParent()->removeChild(&serialCustom);
+    parallelCustom.getParent()->removeChild(&parallelCustom);
+    mRoot->destroySceneManager(serial);
+    mRoot->destroySceneManager(parallel);
+}
+
+namespace
+{
+/// Frustum opting into the SIMD batch culling Camera uses
+struct BatchFrustum : public Frustum
+{
+    void areVisible(const AxisAlignedBox* const* bounds, size_t numBounds, char* visibilities) const
+    {
+        areVisibleImpl(bounds, numBounds, visibilities);
+    }
+};
+
+/// Culling frustum which sees nothing on the right
+struct LeftHalfFrustum : public Frustum
+{
+    bool isVisible(const AxisAlignedBox& bound, FrustumPlane* culledBy = 0) const
+    {
+        return bound.getMaximum().x < 0 && Frustum::isVisible(bound, culledBy);
+    }
+    using Frustum::isVisible;
+};
+}
+
+TEST_F(RootWithoutRenderSystemFixture, FrustumAreVisible)
+{
+    BatchFrustum frustum;
+    frustum.setNearClipDistance(1);
+    frustum.setFarClipDistance(500);
+
+    // not a multiple of the batch sizes, and some boxes are on the edges of the frustum
+    minstd_rand rng;
+    vector<AxisAlignedBox>::type boxes(203);
+    vector<const AxisAlignedBox*>::type bounds;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        Vector3 centre(Real(rng() % 800) - 400, Real(rng() % 800) - 400, -Real(rng() % 800));
+        Vector3 halfSize(Real(rng() % 50), Real(rng() % 50), Real(rng() % 50));
+        boxes[i].setExtents(centre - halfSize, centre + halfSize);
+        bounds.push_back(&boxes[i]);
+    }
+    boxes[7].setNull();
+    boxes[100].setInfinite();
+
+    vector<char>::type visibilities(boxes.size());
+    for (int farDist = 500; farDist >= 0; farDist -= 500)
+    {
+        frustum.setFarClipDistance(Real(farDist));
+        frustum.areVisible(&bounds[0], bounds.size(), &visibilities[0]);
+
+        size_t numVisible = 0;
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            EXPECT_EQ(frustum.isVisible(boxes[i]), visibilities[i] != 0) << i;
+            numVisible += visibilities[i];
+        }
+        EXPECT_GT(numVisible, size_t(0));
+        EXPECT_LT(numVisible, boxes.size());
+    }
+
+    // overrides of isVisible are respected, also by a Camera culling with the frustum
+    LeftHalfFrustum leftHalf;
+    leftHalf.setNearClipDistance(1);
+    leftHalf.setFarClipDistance(500);
+    Camera* cam = mRoot->createSceneManager()->createCamera("Camera");
+    cam->setCullingFrustum(&leftHalf);
+    for (int useCamera = 0; useCamera < 2; ++useCamera)
+    {
+        std::fill(visibilities.begin(), visibilities.end(), 2);
+        if (useCamera)
+            cam->areVisible(&bounds[0], bounds.size(), &visibilities[0]);
+        else
+            leftHalf.areVisible(&bounds[0], bounds.size(), &visibilities[0]);
+
+        for (size_t i = 0; i < boxes.size(); ++i)
+            EXPECT_EQ(leftHalf.isVisible(boxes[i]), visibilities[i] != 0) << i;
+    }
+}
+
+struct QueuedRenderableRecorder : public RenderQueue::RenderableListener
+{
+    vector<std::pair<Renderable*, uint8> >::type mQueued;
+    bool renderableQueued(Renderable* rend, uint8 groupID, ushort, Technique**, RenderQueue*)
+    {
+        mQueued.push_back(std::make_pair(rend, groupID));
+        // there are no supported techniques without a RenderSystem
+        return false;
+    }
+};
+
+TEST_F(RootWithoutRenderSystemFixture, ParallelCulling)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* sm = mRoot->createSceneManager();
+    sm->setParallelThreadCount(4);
+
+    minstd_rand rng;
+    createRandomTree(sm->getRootSceneNode(), sm->createEntity("ent", "sphere.mesh"), 4, rng, NULL);
+    static_cast<SceneNode*>(sm->getRootSceneNode()->getChild(2))->showBoundingBox(true);
+    static_cast<SceneNode*>(sm->getRootSceneNode()->getChild(0)->getChild(1))->showBoundingBox(true);
+
+    // only see part of the scene
+    Camera* cam = sm->createCamera("Camera");
+    SceneNode* camNode = sm->getRootSceneNode()->createChildSceneNode(Vector3(100, 50, 300));
+    camNode->attachObject(cam);
+    camNode->lookAt(Vector3(50, 50, 0), Node::TS_WORLD);
+    sm->_updateSceneGraph(cam);
+
+    QueuedRenderableRecorder serialQueue, parallelQueue, stagedQueue;
+    VisibleObjectsBoundsInfo serialBounds, parallelBounds, stagedBounds;
+
+    sm->getRenderQueue()->setRenderableListener(&serialQueue);
+    sm->_findVisibleObjects(cam, &serialBounds, false);
+
+    sm->getRenderQueue()->clear();
+    sm->getRenderQueue()->setRenderableListener(&parallelQueue);
+    sm->setParallelCulling(true);
+    sm->_findVisibleObjects(cam, &parallelBounds, false);
+
+    // the entities queue themselves on the worker threads
+    sm->getRenderQueue()->clear();
+    sm->getRenderQueue()->setRenderableListener(&stagedQueue);
+    sm->setParallelRenderQueueUpdate(true);
+    sm->_findVisibleObjects(cam, &stagedBounds, false);
+    sm->getRenderQueue()->setRenderableListener(NULL);
+
+    EXPECT_FALSE(serialQueue.mQueued.empty());
+    EXPECT_LT(serialQueue.mQueued.size(), size_t(1024));
+    EXPECT_TRUE(serialQueue.mQueued == parallelQueue.mQueued);
+    EXPECT_TRUE(serialQueue.mQueued == stagedQueue.mQueued);
+    EXPECT_EQ(serialBounds.aabb, parallelBounds.aabb);
+    EXPECT_EQ(serialBounds.minDistance, parallelBounds.minDistance);
+    EXPECT_EQ(serialBounds.maxDistance, parallelBounds.maxDistance);
+    // merged per subtree on the threads, then combined
+    EXPECT_EQ(serialBounds.aabb, stagedBounds.aabb);
+    EXPECT_EQ(serialBounds.receiverAabb, stagedBounds.receiverAabb);
+    EXPECT_EQ(serialBounds.minDistance, stagedBounds.minDistance);
+    EXPECT_EQ(serialBounds.maxDistance, stagedBounds.maxDistance);
+    EXPECT_EQ(serialBounds.minDistanceInFrustum, stagedBounds.minDistanceInFrustum);
+    EXPECT_EQ(serialBounds.maxDistanceInFrustum, stagedBounds.maxDistanceInFrustum);
+}
+
+TEST_F(RootWithoutRenderSystemFixture, RenderQueueStaging)
+{
+    RenderQueue queue;
+    queue._setStaging(true);
+    queue.setDefaultQueueGroup(RENDER_QUEUE_6);
+
+    Rectangle2D rects[3];
+    queue.addRenderable(&rects[0]);
+    queue.addRenderable(&rects[1], RENDER_QUEUE_2);
+    queue.addRenderable(&rects[2], RENDER_QUEUE_8, 5);
+
+    // staged renderables are recorded in order, without touching the groups
+    const RenderQueue::StagedRenderableList& staged = queue._getStagedRenderables();
+    ASSERT_EQ(staged.size(), 3u);
+    EXPECT_EQ(staged[0].renderable, &rects[0]);
+    EXPECT_EQ(staged[0].groupID, RENDER_QUEUE_6);
+    EXPECT_EQ(staged[0].priority, OGRE_RENDERABLE_DEFAULT_PRIORITY);
+    EXPECT_EQ(staged[1].groupID, RENDER_QUEUE_2);
+    EXPECT_EQ(staged[2].groupID, RENDER_QUEUE_8);
+    EXPECT_EQ(staged[2].priority, 5);
+    // only the main group created up-front
+    RenderQueue::QueueGroupIterator groups = queue._getQueueGroupIterator();
+    EXPECT_EQ(groups.peekNextKey(), RENDER_QUEUE_MAIN);
+    groups.moveNext();
+    EXPECT_FALSE(groups.hasMoreElements());
+
+    queue._setStaging(false);
+    EXPECT_TRUE(queue._getStagedRenderables().empty());
+}
+
+/// Renderable with just a position, which is all the sorting looks at
+class PointRenderable : public Renderable
+{
+    MaterialPtr mMaterial;
+    Vector3 mPosition;
+    LightList mLights;
+public:
+    PointRenderable(const MaterialPtr& material, const Vector3& position)
+        : mMaterial(material), mPosition(position) {}
+
+    const MaterialPtr& getMaterial(void) const { return mMaterial; }
+    void getRenderOperation(RenderOperation& op) {}
+    void getWorldTransforms(Matrix4* xform) const { xform->makeTrans(mPosition); }
+    Real getSquaredViewDepth(const Camera* cam) const
+    {
+        return (mPosition - cam->getDerivedPosition()).squaredLength();
+    }
+    const LightList& getLights(void) const { return mLights; }
+};
+
+/// Records the order in which a collection is visited
+struct QueuedRenderableOrderRecorder : public QueuedRenderableVisitor
+{
+    typedef std::vector<std::pair<const Pass*, Renderable*> > VisitList;
+    VisitList visits;
+    const Pass* currentPass;
+    size_t passVisits;
+
+    QueuedRenderableOrderRecorder() : currentPass(0), passVisits(0) {}
+
+    void visit(RenderablePass* rp) { visits.push_back(std::make_pair(rp->pass, rp->renderable)); }
+    bool visit(const Pass* p) { currentPass = p; ++passVisits; return true; }
+    void visit(Renderable* r) { visits.push_back(std::make_pair(currentPass, r)); }
+};
+
+TEST_F(RootWithoutRenderSystemFixture, RenderQueueSortKeys)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+
+    // none of the materials have textures or programs, so all their passes
+    // have the same hash
+    vector<MaterialPtr>::type materials;
+    for (int i = 0; i < 6; ++i)
+    {
+        MaterialPtr mat = MaterialManager::getSingleton().create(
+            "SortKeys" + StringConverter::toString(i), ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        if (i >= 4)
+        {
+            mat->setSceneBlending(SBT_TRANSPARENT_ALPHA);
+            mat->setDepthWriteEnabled(false);
+        }
+        materials.push_back(mat);
+    }
+
+    // depths far enough apart to survive the quantisation, queued out of order
+    std::vector<int> order;
+    for (int i = 0; i < 60; ++i)
+        order.push_back(i);
+    std::shuffle(order.begin(), order.end(), minstd_rand());
+    std::vector<PointRenderable*> renderables;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        renderables.push_back(new PointRenderable(materials[i % materials.size()],
+                                                  Vector3(0, 0, -100 * Real(order[i] + 1))));
+    }
+
+    RenderQueue queues[2];
+    queues[1].setSortKeysEnabled(true);
+    EXPECT_TRUE(queues[1].getQueueGroup(RENDER_QUEUE_MAIN)->getSortKeysEnabled());
+    QueuedRenderableOrderRecorder solids[2], transparents[2];
+    for (int q = 0; q < 2; ++q)
+    {
+        RenderQueueGroup* group = queues[q].getQueueGroup(RENDER_QUEUE_MAIN);
+        for (size_t i = 0; i < renderables.size(); ++i)
+        {
+            group->addRenderable(renderables[i], renderables[i]->getMaterial()->getTechnique(0),
+                                 OGRE_RENDERABLE_DEFAULT_PRIORITY);
+        }
+
+        RenderPriorityGroup* priorityGroup = group->getIterator().getNext();
+        priorityGroup->sort(cam);
+        priorityGroup->getSolidsBasic().acceptVisitor(&solids[q], QueuedRenderableCollection::OM_PASS_GROUP);
+        priorityGroup->getTransparents().acceptVisitor(&transparents[q], QueuedRenderableCollection::OM_SORT_DESCENDING);
+    }
+
+    // transparents are sorted the same way
+    EXPECT_EQ(transparents[0].visits, transparents[1].visits);
+
+    // solids are grouped by pass the same way, front to back within a pass
+    EXPECT_EQ(solids[0].passVisits, 4u);
+    EXPECT_EQ(solids[1].passVisits, 4u);
+    ASSERT_EQ(solids[0].visits.size(), solids[1].visits.size());
+    std::map<const Pass*, std::set<Renderable*> > grouped[2];
+    for (int q = 0; q < 2; ++q)
+    {
+        for (size_t i = 0; i < solids[q].visits.size(); ++i)
+            grouped[q][solids[q].visits[i].first].insert(solids[q].visits[i].second);
+    }
+    EXPECT_EQ(grouped[0], grouped[1]);
+    for (size_t i = 1; i < solids[1].visits.size(); ++i)
+    {
+        if (solids[1].visits[i].first == solids[1].visits[i - 1].first)
+        {
+            EXPECT_LT(solids[1].visits[i - 1].second->getSquaredViewDepth(cam),
+                      solids[1].visits[i].second->getSquaredViewDepth(cam));
+        }
+    }
+
+    for (size_t i = 0; i < renderables.size(); ++i)
+        delete renderables[i];
+    for (size_t i = 0; i < materials.size(); ++i)
+        MaterialManager::getSingleton().remove(materials[i]);
+}
+
+/// Appends the skinned positions and normals of an entity
+static void getSkinnedVertices(Entity* ent, vector<float>::type& vertices)
+{
+    vector<VertexData*>::type datas;
+    if (ent->getMesh()->sharedVertexData)
+        datas.push_back(ent->_getSkelAnimVertexData());
+    for (unsigned int i = 0; i < ent->getNumSubEntities(); ++i)
+    {
+        if (!ent->getSubEntity(i)->getSubMesh()->useSharedVertices)
+            datas.push_back(ent->getSubEntity(i)->_getSkelAnimVertexData());
+    }
+
+    for (size_t d = 0; d < datas.size(); ++d)
+    {
+        const VertexElement* pos = datas[d]->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        HardwareVertexBufferSharedPtr buf = datas[d]->vertexBufferBinding->getBuffer(pos->getSource());
+        HardwareVertexBufferLockGuard lock(buf, HardwareBuffer::HBL_READ_ONLY);
+        const float* data = static_cast<const float*>(lock.pData);
+        vertices.insert(vertices.end(), data, data + buf->getSizeInBytes() / sizeof(float));
+    }
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParallelAnimation)
+{
+    mRoot->getWorkQueue()->startup();
+
+    SceneManager* sms[2] = {mRoot->createSceneManager(), mRoot->createSceneManager()};
+    sms[1]->setParallelAnimation(true);
+    sms[1]->setParallelThreadCount(4);
+
+    const char* meshes[2] = {"ninja.mesh", "robot.mesh"};
+    vector<Entity*>::type entities[2];
+    Camera* cams[2];
+    for (int s = 0; s < 2; ++s)
+    {
+        for (int i = 0; i < 12; ++i)
+        {
+            Entity* ent = sms[s]->createEntity("ent" + StringConverter::toString(i), meshes[i % 2]);
+            // the last one is behind the camera
+            Vector3 pos(Real(i % 4) * 200 - 300, 0, i < 11 ? -Real(i) * 200 - 500 : 2000);
+            sms[s]->getRootSceneNode()->createChildSceneNode(pos)->attachObject(ent);
+
+            AnimationState* state = ent->getAnimationState("Walk");
+            state->setEnabled(true);
+            state->setTimePosition(Real(i) * 0.1f);
+            entities[s].push_back(ent);
+        }
+        // updated together with the one they share it with
+        entities[s][7]->shareSkeletonInstanceWith(entities[s][1]);
+        entities[s][9]->shareSkeletonInstanceWith(entities[s][1]);
+
+        cams[s] = sms[s]->createCamera("Camera");
+        sms[s]->getRootSceneNode()->createChildSceneNode()->attachObject(cams[s]);
+        sms[s]->_updateSceneGraph(cams[s]);
+    }
+
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        sms[1]->_updateEntityAnimations(cams[1]);
+        for (size_t i = 0; i < entities[0].size(); ++i)
+        {
+            // what _updateRenderQueue does
+            entities[0][i]->_updateAnimation();
+            if (i != 11)
+            {
+                vector<float>::type serialVertices, parallelVertices;
+                getSkinnedVertices(entities[0][i], serialVertices);
+                getSkinnedVertices(entities[1][i], parallelVertices);
+                EXPECT_FALSE(serialVertices.empty());
+                EXPECT_TRUE(serialVertices == parallelVertices) << i;
+            }
+            entities[1][i]->_updateAnimation();
+        }
+
+        vector<float>::type serialVertices, parallelVertices;
+        getSkinnedVertices(entities[0][11], serialVertices);
+        getSkinnedVertices(entities[1][11], parallelVertices);
+        EXPECT_TRUE(serialVertices == parallelVertices);
+
+        for (int s = 0; s < 2; ++s)
+        {
+            for (size_t i = 0; i < entities[s].size(); ++i)
+                entities[s][i]->getAnimationState("Walk")->addTime(0.25f);
+        }
+        // next frame, the temporary blend buffers are released
+        mRoot->_fireFrameRenderingQueued();
+        mRoot->_fireFrameEnded();
+    }
+}
+
+struct CountingRequestHandler : public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
+{
+    AtomicScalar<int> mHandled;
+    int mResponses;
+    CountingRequestHandler() : mHandled(0), mResponses(0) {}
+
+    WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+    {
+        int value = any_cast<int>(req->getData());
+        // spawn follow up requests from the worker threads
+        if (req->getType() == 1)
+        {
+            for (int i = 0; i < 8; ++i)
+                const_cast<WorkQueue*>(srcQ)->addRequest(req->getChannel(), 2, Any(i));
+        }
+        // fail the first attempt, it's retried
+        bool success = req->getType() != 3 || req->getRetryCount() == 0;
+        if (success)
+            ++mHandled;
+        return OGRE_NEW WorkQueue::Response(req, success, Any(value));
+    }
+    void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
+    {
+        if (res->succeeded())
+            ++mResponses;
+    }
+};
+
+TEST_F(RootWithoutRenderSystemFixture, WorkStealingWorkQueue)
+{
+    WorkStealingWorkQueue wq("Test");
+    wq.setWorkerThreadCount(4);
+    wq.startup();
+
+    CountingRequestHandler handler;
+    uint16 channel = wq.getChannel("Test");
+    wq.addRequestHandler(channel, &handler);
+    wq.addResponseHandler(channel, &handler);
+
+    // 100 + 100 * 8 spawned + 50 retried
+    for (int i = 0; i < 100; ++i)
+        wq.addRequest(channel, 1, Any(i));
+    for (int i = 0; i < 50; ++i)
+        wq.addRequest(channel, 3, Any(i), 1);
+    // idle and synchronous requests
+    wq.addRequest(channel, 2, Any(0), 0, false, true);
+    wq.addRequest(channel, 2, Any(0), 0, true);
+
+    while (handler.mResponses < 952)
+    {
+        wq.processResponses();
+        std::this_thread::yield();
+    }
+    wq.processResponses();
+    EXPECT_EQ(handler.mResponses, 952);
+    EXPECT_EQ(handler.mHandled, 952);
+    wq.shutdown();
+
+    // nobody picks up requests without workers, so they can be aborted
+    wq.setWorkerThreadCount(0);
+    wq.startup();
+    handler.mResponses = handler.mHandled = 0;
+    WorkQueue::RequestID ids[4];
+    for (int i = 0; i < 4; ++i)
+        ids[i] = wq.addRequest(channel, 2, Any(i));
+    EXPECT_TRUE(wq.abortPendingRequest(ids[1]));
+    wq.abortRequest(ids[3]);
+    // an unknown ID
+    EXPECT_FALSE(wq.abortPendingRequest(ids[3] + 1));
+
+    for (int i = 0; i < 4; ++i)
+        wq._processNextRequest();
+    wq.processResponses();
+    // aborted requests don't reach the handler
+    EXPECT_EQ(handler.mHandled, 2);
+    EXPECT_EQ(handler.mResponses, 2);
+    // handled requests are no longer pending
+    EXPECT_FALSE(wq.abortPendingRequest(ids[0]));
+
+    wq.removeRequestHandler(channel, &handler);
+    wq.removeResponseHandler(channel, &handler);
+    wq.shutdown();
+}
+
+namespace
+{
+    /// system memory buffer that goes through HardwareBuffer::lock
+    class LockCountingBuffer : public HardwareBuffer
+    {
+        vector<uchar>::type mData;
+        void* lockImpl(size_t offset, size_t, LockOptions) { return &mData[offset]; }
+        void unlockImpl() { mIsLocked = false; }
+    public:
+        LockCountingBuffer(size_t size) : HardwareBuffer(HBU_DYNAMIC, true, false), mData(size)
+        {
+            mSizeInBytes = size;
+        }
+        void readData(size_t, size_t, void*) {}
+        void writeData(size_t, size_t, const void*, bool) {}
+    };
+}
+
+TEST_F(RootWithoutRenderSystemFixture, FrameStatistics)
+{
+    size_t counts[HardwareBuffer::HBL_WRITE_ONLY + 1];
+    size_t bytes[HardwareBuffer::HBL_WRITE_ONLY + 1];
+    // drop whatever the fixture locked
+    HardwareBuffer::_collectLockStatistics(counts, bytes);
+
+    LockCountingBuffer buf(64);
+    buf.lock(HardwareBuffer::HBL_DISCARD);
+    buf.unlock();
+    buf.lock(16, 8, HardwareBuffer::HBL_READ_ONLY);
+    buf.unlock();
+    buf.lock(0, 32, HardwareBuffer::HBL_DISCARD);
+    buf.unlock();
+
+    HardwareBuffer::_collectLockStatistics(counts, bytes);
+    EXPECT_EQ(counts[HardwareBuffer::HBL_DISCARD], 2u);
+    EXPECT_EQ(bytes[HardwareBuffer::HBL_DISCARD], 96u);
+    EXPECT_EQ(counts[HardwareBuffer::HBL_READ_ONLY], 1u);
+    EXPECT_EQ(bytes[HardwareBuffer::HBL_READ_ONLY], 8u);
+    EXPECT_EQ(counts[HardwareBuffer::HBL_NORMAL], 0u);
+
+    // collecting resets the counters
+    HardwareBuffer::_collectLockStatistics(counts, bytes);
+    EXPECT_EQ(counts[HardwareBuffer::HBL_DISCARD], 0u);
+
+    RenderSystem::FrameStatistics stats;
+    EXPECT_EQ(stats.getTotalBufferLocks(), 0u);
+    stats.bufferLocks[HardwareBuffer::HBL_DISCARD] = 2;
+    stats.bufferLocks[HardwareBuffer::HBL_WRITE_ONLY] = 3;
+    stats.bufferBytesLocked[HardwareBuffer::HBL_WRITE_ONLY] = 100;
+    EXPECT_EQ(stats.getTotalBufferLocks(), 5u);
+    EXPECT_EQ(stats.getTotalBufferBytesLocked(), 100u);
+    stats.reset();
+    EXPECT_EQ(stats.getTotalBufferLocks(), 0u);
+
+    // statistics are gathered by the RenderSystem
+    EXPECT_THROW(mRoot->getFrameStatistics(), InvalidStateException);
+}
+
+TEST_F(RootWithoutRenderSystemFixture, AutoParamVersions)
+{
+    SceneManager* sm = mRoot->createSceneManager();
+    Camera* cam = sm->createCamera("cam");
+    sm->getRootSceneNode()->attachObject(cam);
+
+    Light* red = sm->createLight();
+    red->setDiffuseColour(ColourValue::Red);
+    Light* green = sm->createLight();
+    green->setDiffuseColour(ColourValue::Green);
+    LightList redLights, greenLights;
+    redLights.push_back(red);
+    greenLights.push_back(green);
+
+    PointRenderable first(MaterialPtr(), Vector3(1, 2, 3));
+    PointRenderable second(MaterialPtr(), Vector3(4, 5, 6));
+    Affine3 firstWorld = Affine3::getTrans(Vector3(1, 2, 3));
+    Affine3 secondWorld = Affine3::getTrans(Vector3(4, 5, 6));
+
+    // one auto per category, at physical indices 0, 4 and 20
+    GpuProgramParameters params;
+    params._setLogicalIndexes(GpuLogicalBufferStructPtr(OGRE_NEW GpuLogicalBufferStruct()),
+                              GpuLogicalBufferStructPtr(), GpuLogicalBufferStructPtr(),
+                              GpuLogicalBufferStructPtr(), GpuLogicalBufferStructPtr());
+    params.setAutoConstant(0, GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR);
+    params.setAutoConstant(1, GpuProgramParameters::ACT_WORLD_MATRIX);
+    params.setAutoConstant(5, GpuProgramParameters::ACT_LIGHT_DIFFUSE_COLOUR, 0);
+    const size_t ambient = 0, worldTransX = 7, diffuse = 20;
+
+    AutoParamDataSource source;
+    source.setCurrentSceneManager(sm);
+    source.setCurrentCamera(cam, false);
+    source.setAmbientLightColour(ColourValue::Blue);
+    source.setCurrentLightList(&redLights);
+    source.setCurrentRenderable(&first);
+    source.setWorldMatrices(&firstWorld, 1);
+
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params.getFloatPointer(ambient + 2), 1.0f);
+    EXPECT_EQ(*params.getFloatPointer(worldTransX), 1.0f);
+    EXPECT_EQ(*params.getFloatPointer(diffuse), 1.0f);
+
+    // nothing changed, so nothing is written
+    *params.getFloatPointer(ambient + 2) = -1;
+    *params.getFloatPointer(worldTransX) = -1;
+    *params.getFloatPointer(diffuse) = -1;
+    source.setAmbientLightColour(ColourValue::Blue);
+    source.setCurrentLightList(&redLights);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params.getFloatPointer(ambient + 2), -1.0f);
+    EXPECT_EQ(*params.getFloatPointer(worldTransX), -1.0f);
+    EXPECT_EQ(*params.getFloatPointer(diffuse), -1.0f);
+
+    // only the categories that changed are written
+    source.setCurrentRenderable(&second);
+    source.setWorldMatrices(&secondWorld, 1);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params.getFloatPointer(ambient + 2), -1.0f);
+    EXPECT_EQ(*params.getFloatPointer(worldTransX), 4.0f);
+    EXPECT_EQ(*params.getFloatPointer(diffuse), -1.0f);
+
+    source.setCurrentLightList(&greenLights);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params.getFloatPointer(ambient + 2), -1.0f);
+    EXPECT_EQ(*params.getFloatPointer(diffuse), 0.0f);
+
+    // changes outside the mask are picked up by the next update that includes them
+    *params.getFloatPointer(ambient) = -1;
+    source.setAmbientLightColour(ColourValue::White);
+    params._updateAutoParams(&source, GPV_PER_OBJECT);
+    EXPECT_EQ(*params.getFloatPointer(ambient), -1.0f);
+    params._updateAutoParams(&source, GPV_GLOBAL);
+    EXPECT_EQ(*params.getFloatPointer(ambient), 1.0f);
+
+    // a new camera or pass invalidates the global autos
+    *params.getFloatPointer(ambient) = -1;
+    source.setCurrentCamera(cam, false);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params.getFloatPointer(ambient), 1.0f);
+
+    *params.getFloatPointer(ambient) = -1;
+    source.setPassNumber(1);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(*params.getFloatPointer(ambient), 1.0f);
+
+    // versions are not shared between data sources
+    *params.getFloatPointer(ambient) = -1;
+    AutoParamDataSource otherSource;
+    otherSource.setCurrentSceneManager(sm);
+    otherSource.setCurrentCamera(cam, false);
+    otherSource.setAmbientLightColour(ColourValue::White);
+    otherSource.setPassNumber(1);
+    params._updateAutoParams(&otherSource, GPV_GLOBAL);
+    EXPECT_EQ(*params.getFloatPointer(ambient), 1.0f);
+
+    // and changing the autos updates all of them again
+    *params.getFloatPointer(ambient) = -1;
+    params.setAutoConstant(6, GpuProgramParameters::ACT_FOG_COLOUR);
+    params._updateAutoParams(&otherSource, GPV_GLOBAL);
+    EXPECT_EQ(*params.getFloatPointer(ambient), 1.0f);
+}
+
+TEST_F(RootWithoutRenderSystemFixture, DataOnlyMeshLoading)
+{
+    // reference data, read through a file stream and buffer locks
+    std::vector<uchar> refVertices, refIndices;
+    {
+        MeshPtr ref = MeshManager::getSingleton().createManual(
+            "ref.mesh", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource("sphere.mesh");
+        MeshSerializer().importMesh(stream, ref.get());
+        SubMesh* sub = ref->getSubMesh(0);
+        HardwareBuffer* vbuf = (sub->useSharedVertices ? ref->sharedVertexData : sub->vertexData)
+                                   ->vertexBufferBinding->getBuffer(0).get();
+        HardwareBuffer* ibuf = sub->indexData->indexBuffer.get();
+        refVertices.resize(vbuf->getSizeInBytes());
+        vbuf->readData(0, refVertices.size(), &refVertices[0]);
+        refIndices.resize(ibuf->getSizeInBytes());
+        ibuf->readData(0, refIndices.size(), &refIndices[0]);
+
+        MeshManager::getSingleton().remove(ref);
+    }
+
+    // no RenderSystem nor HardwareBufferManager, mapped file uploaded in place
+    delete mHBM;
+    mHBM = NULL;
+    FileSystemArchiveFactory::setUseMemoryMapping(true);
+    MeshPtr mesh =
+        MeshManager::getSingleton().load("sphere.mesh", ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+    FileSystemArchiveFactory::setUseMemoryMapping(false);
+
+    EXPECT_EQ(mesh->getHardwareBufferManager(), MeshManager::getSingleton()._getDataOnlyBufferManager());
+
+    SubMesh* sub = mesh->getSubMesh(0);
+    HardwareBuffer* vbuf = (sub->useSharedVertices ? mesh->sharedVertexData : sub->vertexData)
+                               ->vertexBufferBinding->getBuffer(0).get();
+    HardwareBuffer* ibuf = sub->indexData->indexBuffer.get();
+    ASSERT_EQ(vbuf->getSizeInBytes(), refVertices.size());
+    ASSERT_EQ(ibuf->getSizeInBytes(), refIndices.size());
+    EXPECT_EQ(0, memcmp(vbuf->lock(HardwareBuffer::HBL_READ_ONLY), &refVertices[0], refVertices.size()));
+    vbuf->unlock();
+    EXPECT_EQ(0, memcmp(ibuf->lock(HardwareBuffer::HBL_READ_ONLY), &refIndices[0], refIndices.size()));
+    ibuf->unlock();
+}
+
+namespace
+{
+struct LoadOrderListener : public ResourceGroupListener
+{
+    StringVector events;
+    void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount) {}
+    void scriptParseStarted(const String& scriptName, bool& skipThisScript) {}
+    void scriptParseEnded(const String& scriptName, bool skipped) {}
+    void resourceGroupScriptingEnded(const String& groupName) {}
+    void resourceGroupLoadStarted(const String& groupName, size_t resourceCount)
+    {
+        events.push_back("groupStarted " + StringConverter::toString(resourceCount));
+    }
+    void resourceLoadStarted(const ResourcePtr& resource)
+    {
+        events.push_back(resource->getName());
+    }
+    void resourceLoadEnded(void) { events.push_back("ended"); }
+    void resourceGroupLoadEnded(const String& groupName) { events.push_back("groupEnded"); }
+};
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParallelResourcePreparation)
+{
+    mRoot->getWorkQueue()->startup();
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    FileInfoListPtr infos = rgm.findResourceFileInfo("General", "sphere.mesh");
+    ASSERT_FALSE(infos->empty());
+
+    const char* meshes[] = {"sphere.mesh", "ninja.mesh", "robot.mesh", "knot.mesh", "ogrehead.mesh"};
+    rgm.createResourceGroup("Parallel");
+    rgm.addResourceLocation(infos->front().archive->getName(), "FileSystem", "Parallel");
+    for (size_t i = 0; i < 5; ++i)
+        rgm.declareResource(meshes[i], "Mesh", "Parallel");
+    rgm.initialiseResourceGroup("Parallel");
+
+    LoadOrderListener listener;
+    rgm.addResourceGroupListener(&listener);
+    rgm.setParallelPreparation(true);
+    rgm.loadResourceGroup("Parallel");
+    rgm.setParallelPreparation(false);
+    rgm.removeResourceGroupListener(&listener);
+
+    // same callbacks in the same order as the serial path
+    ASSERT_EQ(listener.events.size(), 12u);
+    EXPECT_EQ(listener.events.front(), "groupStarted 5");
+    EXPECT_EQ(listener.events.back(), "groupEnded");
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(listener.events[1 + i * 2], meshes[i]);
+        EXPECT_EQ(listener.events[2 + i * 2], "ended");
+
+        MeshPtr mesh = MeshManager::getSingleton().getByName(meshes[i], "Parallel");
+        ASSERT_TRUE(mesh);
+        EXPECT_TRUE(mesh->isLoaded());
+    }
+
+    rgm.destroyResourceGroup("Parallel");
+}
+
+namespace
+{
+struct PreparingCompleteListener : public Resource::Listener
+{
+    std::thread::id thread;
+    int calls;
+    bool otherThread;
+
+    PreparingCompleteListener() : thread(std::this_thread::get_id()), calls(0), otherThread(false) {}
+    void preparingComplete(Resource*)
+    {
+        ++calls;
+        otherThread |= std::this_thread::get_id() != thread;
+    }
+};
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParallelResourcePreparationListeners)
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    FileInfoListPtr infos = rgm.findResourceFileInfo("General", "sphere.mesh");
+    ASSERT_FALSE(infos->empty());
+
+    const char* meshes[] = {"sphere.mesh", "ninja.mesh", "robot.mesh", "knot.mesh", "ogrehead.mesh"};
+    rgm.createResourceGroup("Parallel");
+    rgm.addResourceLocation(infos->front().archive->getName(), "FileSystem", "Parallel");
+    for (size_t i = 0; i < 5; ++i)
+        rgm.declareResource(meshes[i], "Mesh", "Parallel");
+    rgm.initialiseResourceGroup("Parallel");
+
+    PreparingCompleteListener listener;
+    for (size_t i = 0; i < 5; ++i)
+        MeshManager::getSingleton().getByName(meshes[i], "Parallel")->addListener(&listener);
+
+    rgm.setParallelPreparation(true);
+    rgm.prepareResourceGroup("Parallel");
+    rgm.setParallelPreparation(false);
+
+    // fired once per resource, and only on the calling thread
+    EXPECT_EQ(listener.calls, 5);
+    EXPECT_FALSE(listener.otherThread);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        MeshPtr mesh = MeshManager::getSingleton().getByName(meshes[i], "Parallel");
+        EXPECT_EQ(mesh->getLoadingState(), Resource::LOADSTATE_PREPARED);
+        mesh->removeListener(&listener);
+    }
+
+    rgm.destroyResourceGroup("Parallel");
+}
+
+namespace
+{
+struct ScriptListListener : public ResourceGroupListener
+{
+    StringVector scripts;
+    void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount) {}
+    void scriptParseStarted(const String& scriptName, bool& skipThisScript)
+    {
+        scripts.push_back(scriptName);
+        skipThisScript = true;
+    }
+    void scriptParseEnded(const String& scriptName, bool skipped) {}
+    void resourceGroupScriptingEnded(const String& groupName) {}
+};
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ResourceIndexCache)
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+
+    // a location that changes and one that does not
+    String changing = mFSLayer->getWritablePath("ResourceIndexCacheTest");
+    FileSystemLayer::createDirectory(changing);
+    std::ofstream((changing + "/first.material").c_str()).close();
+    FileInfoListPtr infos = rgm.findResourceFileInfo("General", "Examples.material");
+    ASSERT_FALSE(infos->empty());
+    String unchanged = infos->front().archive->getName();
+
+    rgm.setUseResourceIndexCache(true);
+    rgm.addResourceLocation(changing, "FileSystem", "CacheTest");
+    rgm.addResourceLocation(unchanged, "FileSystem", "CacheTest");
+    EXPECT_TRUE(rgm.isResourceIndexCacheDirty());
+
+    MemoryDataStream* buffer = OGRE_NEW MemoryDataStream(1 << 20);
+    DataStreamPtr output(buffer);
+    rgm.saveResourceIndexCache(output);
+    rgm.destroyResourceGroup("CacheTest");
+
+    std::ofstream((changing + "/second.material").c_str()).close();
+
+    rgm.loadResourceIndexCache(DataStreamPtr(OGRE_NEW MemoryDataStream(buffer->getPtr(), buffer->tell())));
+    EXPECT_FALSE(rgm.isResourceIndexCacheDirty());
+    rgm.addResourceLocation(unchanged, "FileSystem", "CacheTest");
+    EXPECT_FALSE(rgm.isResourceIndexCacheDirty());
+    rgm.addResourceLocation(changing, "FileSystem", "CacheTest");
+    EXPECT_TRUE(rgm.isResourceIndexCacheDirty());
+
+    EXPECT_TRUE(rgm.resourceExists("CacheTest", "Examples.material"));
+    EXPECT_TRUE(rgm.resourceExists("CacheTest", "second.material"));
+
+    // scripts are found in the same order as without the cache
+    ScriptListListener cachedListener, listener;
+    rgm.addResourceGroupListener(&cachedListener);
+    rgm.initialiseResourceGroup("CacheTest");
+    rgm.removeResourceGroupListener(&cachedListener);
+    rgm.destroyResourceGroup("CacheTest");
+
+    rgm.setUseResourceIndexCache(false);
+    rgm.addResourceLocation(unchanged, "FileSystem", "CacheTest");
+    rgm.addResourceLocation(changing, "FileSystem", "CacheTest");
+    rgm.addResourceGroupListener(&listener);
+    rgm.initialiseResourceGroup("CacheTest");
+    rgm.removeResourceGroupListener(&listener);
+    rgm.destroyResourceGroup("CacheTest");
+
+    EXPECT_EQ(cachedListener.scripts, listener.scripts);
+    EXPECT_NE(std::find(listener.scripts.begin(), listener.scripts.end(), "second.material"),
+              listener.scripts.end());
+
+    FileSystemLayer::removeFile(changing + "/first.material");
+    FileSystemLayer::removeFile(changing + "/second.material");
+    FileSystemLayer::removeDirectory(changing);
+}
+
+namespace
+{
+struct ScriptOrderListener : public ResourceGroupListener
+{
+    StringVector scripts;
+    void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount) {}
+    void scriptParseStarted(const String& scriptName, bool& skipThisScript) { scripts.push_back(scriptName); }
+    void scriptParseEnded(const String& scriptName, bool skipped) {}
+    void resourceGroupScriptingEnded(const String& groupName) {}
+};
+}
+
+namespace
+{
+struct StreamOpenedListener : public ResourceLoadingListener
+{
+    std::thread::id thread;
+    int opened;
+    bool otherThread;
+
+    StreamOpenedListener() : thread(std::this_thread::get_id()), opened(0), otherThread(false) {}
+    DataStreamPtr resourceLoading(const String&, const String&, Resource*) { return DataStreamPtr(); }
+    void resourceStreamOpened(const String&, const String&, Resource*, DataStreamPtr&)
+    {
+        ++opened;
+        otherThread |= std::this_thread::get_id() != thread;
+    }
+    bool resourceCollision(Resource*, ResourceManager*) { return true; }
+};
+}
+
+TEST_F(RootWithoutRenderSystemFixture, ParallelScriptParsing)
+{
+    mRoot->getWorkQueue()->startup();
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    String dir = mFSLayer->getWritablePath("ParallelScriptParsingTest");
+    FileSystemLayer::createDirectory(dir);
+
+    // the scripts import a shared base material
+    StringVector files(1, "base.material");
+    std::ofstream((dir + "/base.material").c_str())
+        << "abstract material Base { set $col \"1 1 1 1\" technique { pass { diffuse $col } } }\n";
+    for (int i = 0; i < 32; ++i)
+    {
+        String name = "parallel" + StringConverter::toString(i) + ".material";
+        files.push_back(name);
+        std::ofstream((dir + "/" + name).c_str())
+            << "import Base from \"base.material\"\n"
+            << "material Parallel" << i << " : Base { set $col \"" << i / 32.0f << " 0 0 1\" }\n";
+    }
+
+    ScriptOrderListener listener, parallelListener;
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+        rgm.setParallelScriptParsing(parallel != 0);
+        rgm.addResourceLocation(dir, "FileSystem", "ParallelScripts");
+        rgm.addResourceGroupListener(parallel ? &parallelListener : &listener);
+        rgm.initialiseResourceGroup("ParallelScripts");
+        rgm.removeResourceGroupListener(parallel ? &parallelListener : &listener);
+
+        for (int i = 0; i < 32; ++i)
+        {
+            MaterialPtr mat = MaterialManager::getSingleton().getByName(
+                "Parallel" + StringConverter::toString(i), "ParallelScripts");
+            ASSERT_TRUE(mat);
+            EXPECT_EQ(mat->getTechnique(0)->getPass(0)->getDiffuse(), ColourValue(i / 32.0f, 0, 0));
+        }
+        rgm.destroyResourceGroup("ParallelScripts");
+    }
+
+    // parsed in the same order
+    EXPECT_EQ(parallelListener.scripts, listener.scripts);
+    EXPECT_EQ(listener.scripts.size(), files.size());
+
+    // a loading listener is only called on the calling thread, once per script
+    StreamOpenedListener loadingListener;
+    rgm.setLoadingListener(&loadingListener);
+    rgm.addResourceLocation(dir, "FileSystem", "ParallelScripts");
+    rgm.initialiseResourceGroup("ParallelScripts");
+    rgm.destroyResourceGroup("ParallelScripts");
+    rgm.setLoadingListener(NULL);
+    EXPECT_FALSE(loadingListener.otherThread);
+    EXPECT_GE(loadingListener.opened, int(files.size()));
+
+    // errors are thrown on the calling thread
+    files.push_back("broken.material");
+    std::ofstream((dir + "/broken.material").c_str()) << "import\n";
+    rgm.addResourceLocation(dir, "FileSystem", "ParallelScripts");
+    EXPECT_THROW(rgm.initialiseResourceGroup("ParallelScripts"), InvalidStateException);
+    rgm.destroyResourceGroup("ParallelScripts");
+    rgm.setParallelScriptParsing(false);
+
+    for (size_t i = 0; i < files.size(); ++i)
+        FileSystemLayer::removeFile(dir + "/" + files[i]);
+    FileSystemLayer::removeDirectory(dir);
+}
+
+TEST_F(RootWithoutRenderSystemFixture, CompiledScriptCache)
+{
+    ScriptCompilerManager& scm = ScriptCompilerManager::getSingleton();
+    scm.setUseCompiledScriptCache(true);
+
+    // inheritance and variables are resolved in the cached tree
+    String script = "abstract material Base { set $col \"1 0 0 1\" technique { pass { diffuse $col } } }\n"
+                    "material Derived : Base { set $col \"0 1 0 1\" }\n";
+    String group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (i == 1)
+        {
+            // carried over to the next run
+            MemoryDataStream* buffer = OGRE_NEW MemoryDataStream(1 << 16);
+            DataStreamPtr output(buffer);
+            scm.saveCompiledScriptCache(output);
+            scm.loadCompiledScriptCache(
+                DataStreamPtr(OGRE_NEW MemoryDataStream(buffer->getPtr(), buffer->tell())));
+            EXPECT_FALSE(scm.isCompiledScriptCacheDirty());
+        }
+        else if (i == 2)
+        {
+            script = StringUtil::replaceAll(script, "0 1 0 1", "0 0 1 1");
+        }
+
+        DataStreamPtr stream(OGRE_NEW MemoryDataStream("Cached.material", &script[0], script.size()));
+        scm.parseScript(stream, group);
+        // only new or changed scripts are added
+        EXPECT_EQ(scm.isCompiledScriptCacheDirty(), i != 1);
+
+        MaterialPtr mat = MaterialManager::getSingleton().getByName("Derived", group);
+        ASSERT_TRUE(mat);
+        EXPECT_EQ(mat->getTechnique(0)->getPass(0)->getDiffuse(),
+                  i < 2 ? ColourValue::Green : ColourValue::Blue);
+        MaterialManager::getSingleton().remove(mat);
+    }
+
+    // invalid caches are ignored
+    String garbage = "not a compiled script cache";
+    scm.loadCompiledScriptCache(DataStreamPtr(OGRE_NEW MemoryDataStream(&garbage[0], garbage.size())));
+    EXPECT_TRUE(scm.isCompiledScriptCacheDirty());
+
+    scm.setUseCompiledScriptCache(false);
+}
+
+TEST_F(RootWithoutRenderSystemFixture, CompiledScriptCacheImports)
+{
+    ScriptCompilerManager& scm = ScriptCompilerManager::getSingleton();
+    scm.setUseCompiledScriptCache(true);
+
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    String dir = mFSLayer->getWritablePath("CompiledScriptCacheTest");
+    FileSystemLayer::createDirectory(dir);
+
+    StringVector files(1, "base.material");
+    for (int i = 0; i < 8; ++i)
+    {
+        String name = "cached" + StringConverter::toString(i) + ".material";
+        files.push_back(name);
+        std::ofstream((dir + "/" + name).c_str())
+            << "import Base from \"base.material\"\n"
+            << "material Cached" << i << " : Base {}\n";
+    }
+
+    StreamOpenedListener loadingListener;
+    rgm.setLoadingListener(&loadingListener);
+    for (int i = 0; i < 3; ++i)
+    {
+        std::ofstream((dir + "/base.material").c_str())
+            << "abstract material Base { technique { pass { diffuse "
+            << (i < 2 ? "0 1 0 1" : "0 0 1 1") << " } } }\n";
+
+        loadingListener.opened = 0;
+        rgm.addResourceLocation(dir, "FileSystem", "CachedScripts");
+        rgm.initialiseResourceGroup("CachedScripts");
+
+        // the import is hashed once per parse of the group
+        if (i == 1)
+            EXPECT_EQ(loadingListener.opened, int(files.size()) + 1);
+
+        // and changes are picked up by the next parse
+        MaterialPtr mat = MaterialManager::getSingleton().getByName("Cached7", "CachedScripts");
+        ASSERT_TRUE(mat);
+        EXPECT_EQ(mat->getTechnique(0)->getPass(0)->getDiffuse(),
+                  i < 2 ? ColourValue::Green : ColourValue::Blue);
+        rgm.destroyResourceGroup("CachedScripts");
+    }
+    rgm.setLoadingListener(NULL);
+    scm.setUseCompiledScriptCache(false);
+
+    for (size_t i = 0; i < files.size(); ++i)
+        FileSystemLayer::removeFile(dir + "/" + files[i]);
+    FileSystemLayer::removeDirectory(dir);
+}
@@ -0,0 +1,434 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreImage.h"
+#include "OgreColourValue.h"
+#include "OgreRoot.h"
+
+#include <random>
+
+using namespace Ogre;
+
+static const Image::Filter ALL_FILTERS[] = {
+    Image::FILTER_NEAREST, Image::FILTER_LINEAR, Image::FILTER_BILINEAR, Image::FILTER_BOX,
+    Image::FILTER_TRIANGLE, Image::FILTER_BICUBIC, Image::FILTER_LANCZOS, Image::FILTER_KAISER
+};
+
+//--------------------------------------------------------------------------
+TEST(ImageTests, ScalePreservesConstantColour)
+{
+    PixelFormat formats[] = { PF_A8R8G8B8, PF_R8G8B8, PF_FLOAT32_RGBA, PF_FLOAT16_RGBA };
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f)
+    {
+        PixelBox src(61, 47, 1, formats[f]);
+        std::vector<uchar> srcData(src.getConsecutiveSize());
+        src.data = &srcData[0];
+        ColourValue colour(0.2f, 0.6f, 0.8f, 1.0f);
+        for (size_t i = 0; i < src.getWidth() * src.getHeight(); ++i)
+            PixelUtil::packColour(colour, src.format, &srcData[i * PixelUtil::getNumElemBytes(src.format)]);
+
+        for (size_t i = 0; i < sizeof(ALL_FILTERS) / sizeof(ALL_FILTERS[0]); ++i)
+        {
+            for (int gamma = 0; gamma < 2; ++gamma)
+            {
+                // minify and magnify
+                for (uint32 size = 13; size < 130; size += 100)
+                {
+                    PixelBox dst(size, size + 3, 1, PF_FLOAT32_RGBA);
+                    std::vector<float> dstData(dst.getWidth() * dst.getHeight() * 4);
+                    dst.data = (uchar*)&dstData[0];
+                    Image::scale(src, dst, ALL_FILTERS[i], gamma != 0);
+
+                    for (size_t j = 0; j < dstData.size(); j += 4)
+                    {
+                        ColourValue c(dstData[j], dstData[j + 1], dstData[j + 2], dstData[j + 3]);
+                        EXPECT_NEAR(c.r, colour.r, 1.0f / 255) << "filter " << ALL_FILTERS[i];
+                        EXPECT_NEAR(c.g, colour.g, 1.0f / 255) << "filter " << ALL_FILTERS[i];
+                        EXPECT_NEAR(c.b, colour.b, 1.0f / 255) << "filter " << ALL_FILTERS[i];
+                        EXPECT_NEAR(c.a, colour.a, 1.0f / 255) << "filter " << ALL_FILTERS[i];
+                    }
+                }
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, ScaleBoxAveragesBytes)
+{
+    uchar src[] = { 0, 10, 20, 31,
+                    2, 12, 40, 61 };
+    uchar dst[2] = { 0, 0 };
+    Image::scale(PixelBox(4, 2, 1, PF_L8, src), PixelBox(2, 1, 1, PF_L8, dst), Image::FILTER_BOX);
+    EXPECT_EQ(dst[0], 6);
+    EXPECT_EQ(dst[1], 38);
+
+    // the box filter of a size which is not halved filters in floating point
+    uchar dst3[3] = { 0, 0, 0 };
+    Image::scale(PixelBox(4, 2, 1, PF_L8, src), PixelBox(3, 1, 1, PF_L8, dst3), Image::FILTER_BOX);
+    EXPECT_EQ(dst3[0], 1);
+    EXPECT_EQ(dst3[2], 46);
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, ScaleVolume)
+{
+    PixelBox src(8, 8, 8, PF_FLOAT32_RGBA);
+    std::vector<float> srcData(8 * 8 * 8 * 4);
+    src.data = (uchar*)&srcData[0];
+    // a gradient along z
+    for (size_t i = 0; i < srcData.size(); i += 4)
+    {
+        srcData[i] = srcData[i + 1] = srcData[i + 2] = float(i / (8 * 8 * 4)) / 7;
+        srcData[i + 3] = 1;
+    }
+
+    for (size_t i = 0; i < sizeof(ALL_FILTERS) / sizeof(ALL_FILTERS[0]); ++i)
+    {
+        PixelBox dst(4, 4, 2, PF_FLOAT32_RGBA);
+        std::vector<float> dstData(4 * 4 * 2 * 4);
+        dst.data = (uchar*)&dstData[0];
+        Image::scale(src, dst, ALL_FILTERS[i]);
+
+        // the front slice is darker than the back slice
+        EXPECT_LT(dstData[0], dstData[4 * 4 * 4]) << "filter " << ALL_FILTERS[i];
+        // and symmetric about the centre, but nearest samples are not centred
+        if (ALL_FILTERS[i] != Image::FILTER_NEAREST)
+            EXPECT_NEAR(dstData[0] + dstData[4 * 4 * 4], 1.0f, 1e-4f) << "filter " << ALL_FILTERS[i];
+        EXPECT_NEAR(dstData[3], 1.0f, 1e-4f) << "filter " << ALL_FILTERS[i];
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, GenerateMipmaps)
+{
+    Image img;
+    uint32 width = 16, height = 8;
+    uchar* data = OGRE_ALLOC_T(uchar, width * height * 4, MEMCATEGORY_GENERAL);
+    for (size_t i = 0; i < width * height * 4; ++i)
+        data[i] = uchar((i * 37) % 251);
+    img.loadDynamicImage(data, width, height, 1, PF_R8G8B8A8, true);
+
+    ASSERT_TRUE(img.generateMipmaps());
+    EXPECT_EQ(img.getNumMipmaps(), 4u);
+    EXPECT_EQ(img.getSize(), Image::calculateSize(4, 1, width, height, 1, PF_R8G8B8A8));
+    PixelBox last = img.getPixelBox(0, 4);
+    EXPECT_EQ(last.getWidth(), 1u);
+    EXPECT_EQ(last.getHeight(), 1u);
+
+    // every level is the rounded average of 2x2 pixels of the previous one
+    for (uint32 mip = 1; mip <= img.getNumMipmaps(); ++mip)
+    {
+        PixelBox prev = img.getPixelBox(0, mip - 1);
+        PixelBox cur = img.getPixelBox(0, mip);
+        for (uint32 y = 0; y < cur.getHeight(); ++y)
+        {
+            for (uint32 x = 0; x < cur.getWidth(); ++x)
+            {
+                uint32 x2 = prev.getWidth() > 1 ? 1 : 0, y2 = prev.getHeight() > 1 ? prev.getWidth() : 0;
+                const uchar* p = prev.data + 4 * ((y << (y2 ? 1 : 0)) * prev.getWidth() + (x << (x2 ? 1 : 0)));
+                for (int k = 0; k < 4; ++k)
+                {
+                    int sum = 2 * (p[k] + p[4 * x2 + k] + p[4 * y2 + k] + p[4 * (x2 + y2) + k]);
+                    EXPECT_EQ(cur.data[4 * (y * cur.getWidth() + x) + k], (sum + 4) >> 3);
+                }
+            }
+        }
+    }
+
+    // the old chain is replaced
+    ASSERT_TRUE(img.generateMipmaps(false, Image::FILTER_LANCZOS));
+    EXPECT_EQ(img.getNumMipmaps(), 4u);
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, GenerateMipmapsGammaCorrected)
+{
+    // black and white checker board
+    uchar data[4 * 4 * 3];
+    for (int i = 0; i < 16; ++i)
+        memset(&data[i * 3], ((i + i / 4) % 2) * 255, 3);
+
+    for (size_t i = 0; i < sizeof(ALL_FILTERS) / sizeof(ALL_FILTERS[0]); ++i)
+    {
+        if (ALL_FILTERS[i] == Image::FILTER_NEAREST)
+            continue;
+        Image img, gammaImg;
+        img.loadDynamicImage(data, 4, 4, PF_R8G8B8);
+        gammaImg.loadDynamicImage(data, 4, 4, PF_R8G8B8);
+        ASSERT_TRUE(img.generateMipmaps(false, ALL_FILTERS[i]));
+        ASSERT_TRUE(gammaImg.generateMipmaps(true, ALL_FILTERS[i]));
+
+        // the dynamic buffer is untouched
+        EXPECT_EQ(data[0], 0);
+        EXPECT_EQ(data[3], 255);
+
+        // 50% grey is about 188 in sRGB
+        EXPECT_NEAR(img.getPixelBox(0, 2).data[0], 128, 1) << "filter " << ALL_FILTERS[i];
+        EXPECT_NEAR(gammaImg.getPixelBox(0, 2).data[0], 188, 1) << "filter " << ALL_FILTERS[i];
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, GenerateMipmapsCubeMap)
+{
+    Image img;
+    uchar* data = OGRE_ALLOC_T(uchar, 6 * 8 * 8 * 2, MEMCATEGORY_GENERAL);
+    for (size_t face = 0; face < 6; ++face)
+        memset(data + face * 8 * 8 * 2, int(face * 40), 8 * 8 * 2);
+    img.loadDynamicImage(data, 8, 8, 1, PF_BYTE_LA, true, 6);
+
+    ASSERT_TRUE(img.generateMipmaps());
+    EXPECT_EQ(img.getNumMipmaps(), 3u);
+    for (size_t face = 0; face < 6; ++face)
+    {
+        EXPECT_EQ(img.getPixelBox(face, 0).data[0], face * 40);
+        EXPECT_EQ(img.getPixelBox(face, 3).data[0], face * 40);
+        EXPECT_EQ(img.getPixelBox(face, 3).data[1], face * 40);
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, GenerateMipmapsCompressed)
+{
+    uchar data[8] = { 0 };
+    Image img;
+    img.loadDynamicImage(data, 4, 4, 1, PF_DXT1);
+    EXPECT_FALSE(img.generateMipmaps());
+    EXPECT_EQ(img.getNumMipmaps(), 0u);
+}
+//--------------------------------------------------------------------------
+static const PixelFormat COMPRESSED_FORMATS[] = {
+    PF_DXT1, PF_DXT3, PF_DXT5, PF_BC4_UNORM, PF_BC5_UNORM, PF_BC7_UNORM
+};
+
+/// Smooth gradients with some noise, which block compression approximates well
+static std::vector<uchar> makeCompressionTestImage(uint32 width, uint32 height)
+{
+    std::vector<uchar> pixels(width * height * 4);
+    std::mt19937 rng(width * 31 + height);
+    std::uniform_int_distribution<int> noise(-6, 6);
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            uchar* p = &pixels[(y * width + x) * 4];
+            int values[4] = { int(x * 255 / width), int(y * 255 / height), int((x + y) * 127 / (width + height)) + 64,
+                              255 - int(x * 100 / width) };
+            for (int c = 0; c < 4; ++c)
+                p[c] = uchar(std::min(std::max(values[c] + noise(rng), 0), 255));
+        }
+    }
+    return pixels;
+}
+
+/// Peak signal to noise ratio of the first channels of two PF_BYTE_RGBA buffers
+static double psnr(const std::vector<uchar>& a, const uchar* b, size_t channels)
+{
+    double error = 0;
+    for (size_t i = 0; i < a.size(); i += 4)
+    {
+        for (size_t c = 0; c < channels; ++c)
+            error += (a[i + c] - b[i + c]) * (a[i + c] - b[i + c]);
+    }
+    error /= a.size() / 4 * channels;
+    return error == 0 ? 100 : 10 * std::log10(255.0 * 255.0 / error);
+}
+
+/// Decodes the top level of a compressed image to PF_BYTE_RGBA
+static std::vector<uchar> decompress(const Image& img, size_t mip = 0)
+{
+    PixelBox src = img.getPixelBox(0, mip);
+    PixelBox dst(src.getWidth(), src.getHeight(), 1, PF_BYTE_RGBA);
+    std::vector<uchar> pixels(dst.getConsecutiveSize());
+    dst.data = &pixels[0];
+    PixelUtil::bulkPixelConversion(src, dst);
+    return pixels;
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, Compress)
+{
+    // the channels each format keeps, and the least PSNR at CQ_FAST
+    const size_t channels[] = { 3, 4, 4, 1, 2, 4 };
+    const double minPsnr[] = { 32, 30, 32, 40, 40, 35 };
+    const uint32 width = 64, height = 48;
+    std::vector<uchar> pixels = makeCompressionTestImage(width, height);
+
+    for (size_t f = 0; f < sizeof(COMPRESSED_FORMATS) / sizeof(COMPRESSED_FORMATS[0]); ++f)
+    {
+        double previous = 0;
+        for (int quality = Image::CQ_FAST; quality <= Image::CQ_BEST; ++quality)
+        {
+            Image img;
+            img.loadDynamicImage(&pixels[0], width, height, 1, PF_BYTE_RGBA);
+            ASSERT_TRUE(img.compress(COMPRESSED_FORMATS[f], Image::CompressionQuality(quality)));
+            EXPECT_EQ(img.getFormat(), COMPRESSED_FORMATS[f]);
+            EXPECT_TRUE(img.hasFlag(IF_COMPRESSED));
+            EXPECT_EQ(img.getSize(), PixelUtil::getMemorySize(width, height, 1, COMPRESSED_FORMATS[f]));
+
+            double value = psnr(pixels, &decompress(img)[0], channels[f]);
+            EXPECT_GE(value, minPsnr[f]) << PixelUtil::getFormatName(COMPRESSED_FORMATS[f]) << " quality " << quality;
+            // better qualities never do much worse
+            EXPECT_GE(value, previous - 0.1) << PixelUtil::getFormatName(COMPRESSED_FORMATS[f]) << " quality " << quality;
+            previous = value;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, CompressSolidColour)
+{
+    uchar pixels[8 * 8 * 4];
+    for (size_t i = 0; i < 64; ++i)
+    {
+        pixels[i * 4 + 0] = 200;
+        pixels[i * 4 + 1] = 100;
+        pixels[i * 4 + 2] = 37;
+        pixels[i * 4 + 3] = 255;
+    }
+    // 565 colours are within 4 of any colour, BC7 7 bit endpoints within 1
+    const int tolerance[] = { 4, 4, 4, 0, 0, 1 };
+    for (size_t f = 0; f < sizeof(COMPRESSED_FORMATS) / sizeof(COMPRESSED_FORMATS[0]); ++f)
+    {
+        Image img;
+        img.loadDynamicImage(pixels, 8, 8, 1, PF_BYTE_RGBA);
+        ASSERT_TRUE(img.compress(COMPRESSED_FORMATS[f], Image::CQ_NORMAL));
+        std::vector<uchar> decoded = decompress(img);
+        for (size_t i = 0; i < decoded.size(); i += 4)
+        {
+            EXPECT_NEAR(decoded[i], pixels[i], tolerance[f]) << PixelUtil::getFormatName(COMPRESSED_FORMATS[f]);
+            if (COMPRESSED_FORMATS[f] == PF_BC4_UNORM)
+                continue;
+            EXPECT_NEAR(decoded[i + 1], pixels[i + 1], tolerance[f]) << PixelUtil::getFormatName(COMPRESSED_FORMATS[f]);
+            EXPECT_EQ(decoded[i + 3], 255) << PixelUtil::getFormatName(COMPRESSED_FORMATS[f]);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, CompressDXT1Transparency)
+{
+    // a transparent checker board over a gradient
+    const uint32 width = 16, height = 16;
+    std::vector<uchar> pixels = makeCompressionTestImage(width, height);
+    for (uint32 y = 0; y < height; ++y)
+        for (uint32 x = 0; x < width; ++x)
+            pixels[(y * width + x) * 4 + 3] = ((x / 2 + y / 2) & 1) ? 255 : 20;
+
+    Image img;
+    img.loadDynamicImage(&pixels[0], width, height, 1, PF_BYTE_RGBA);
+    ASSERT_TRUE(img.compress(PF_DXT1, Image::CQ_BEST));
+    std::vector<uchar> decoded = decompress(img);
+    for (size_t i = 0; i < decoded.size(); i += 4)
+    {
+        if (pixels[i + 3] < 128)
+        {
+            EXPECT_EQ(decoded[i + 3], 0);
+            continue;
+        }
+        EXPECT_EQ(decoded[i + 3], 255);
+        EXPECT_NEAR(decoded[i], pixels[i], 24);
+        EXPECT_NEAR(decoded[i + 1], pixels[i + 1], 24);
+    }
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, CompressPartialBlocksAndMipmaps)
+{
+    const uint32 width = 13, height = 6;
+    std::vector<uchar> pixels = makeCompressionTestImage(width, height);
+    Image img;
+    img.loadDynamicImage(&pixels[0], width, height, 1, PF_BYTE_RGBA);
+    ASSERT_TRUE(img.generateMipmaps());
+    ASSERT_TRUE(img.compress(PF_BC7_UNORM, Image::CQ_BEST));
+    EXPECT_EQ(img.getNumMipmaps(), 3u);
+    EXPECT_EQ(img.getSize(), Image::calculateSize(3, 1, width, height, 1, PF_BC7_UNORM));
+
+    // the same as the image padded to whole blocks by replicating its edges
+    std::vector<uchar> padded(16 * 8 * 4);
+    for (uint32 y = 0; y < 8; ++y)
+        for (uint32 x = 0; x < 16; ++x)
+            memcpy(&padded[(y * 16 + x) * 4], &pixels[(std::min(y, height - 1) * width + std::min(x, width - 1)) * 4], 4);
+    Image paddedImg;
+    paddedImg.loadDynamicImage(&padded[0], 16, 8, 1, PF_BYTE_RGBA);
+    ASSERT_TRUE(paddedImg.compress(PF_BC7_UNORM, Image::CQ_BEST));
+    std::vector<uchar> decoded = decompress(img), paddedDecoded = decompress(paddedImg);
+    for (uint32 y = 0; y < height; ++y)
+        for (uint32 x = 0; x < width * 4; ++x)
+            ASSERT_EQ(decoded[y * width * 4 + x], paddedDecoded[y * 16 * 4 + x]);
+
+    // the 1x1 level replicates its only pixel
+    Image level;
+    level.loadDynamicImage(&pixels[0], width, height, 1, PF_BYTE_RGBA);
+    level.generateMipmaps();
+    uchar expected[4];
+    memcpy(expected, level.getPixelBox(0, 3).data, 4);
+    decoded = decompress(img, 3);
+    for (size_t c = 0; c < 4; ++c)
+        EXPECT_NEAR(decoded[c], expected[c], 2);
+
+    // already compressed
+    EXPECT_FALSE(img.compress(PF_DXT1));
+    EXPECT_EQ(img.getFormat(), PF_BC7_UNORM);
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, CompressUnsupportedFormat)
+{
+    uchar pixels[4 * 4 * 4] = { 0 };
+    Image img;
+    img.loadDynamicImage(pixels, 4, 4, 1, PF_BYTE_RGBA);
+    EXPECT_FALSE(img.compress(PF_BC6H_UF16));
+    EXPECT_FALSE(img.compress(PF_R8G8B8A8));
+    EXPECT_EQ(img.getFormat(), PF_BYTE_RGBA);
+    EXPECT_EQ(img.getData(), pixels);
+}
+//--------------------------------------------------------------------------
+TEST(ImageTests, CompressEncodeDDS)
+{
+    Root root("");
+    const uint32 width = 32, height = 32;
+    std::vector<uchar> pixels = makeCompressionTestImage(width, height);
+    for (size_t f = 0; f < sizeof(COMPRESSED_FORMATS) / sizeof(COMPRESSED_FORMATS[0]); ++f)
+    {
+        Image img;
+        img.loadDynamicImage(&pixels[0], width, height, 1, PF_BYTE_RGBA);
+        img.generateMipmaps();
+        ASSERT_TRUE(img.compress(COMPRESSED_FORMATS[f]));
+
+        // without a render system the blocks are decoded on load
+        Image loaded;
+        loaded.load(img.encode("dds"), "dds");
+        ASSERT_EQ(loaded.getWidth(), width);
+        ASSERT_EQ(loaded.getHeight(), height);
+        ASSERT_EQ(loaded.getNumMipmaps(), img.getNumMipmaps());
+        for (size_t mip = 0; mip <= img.getNumMipmaps(); ++mip)
+        {
+            std::vector<uchar> expected = decompress(img, mip);
+            PixelBox box = loaded.getPixelBox(0, mip);
+            std::vector<uchar> actual(expected.size());
+            PixelUtil::bulkPixelConversion(box, PixelBox(box.getWidth(), box.getHeight(), 1, PF_BYTE_RGBA, &actual[0]));
+            // DXT1 loads as PF_BYTE_RGB if its first block is opaque, BC4 and BC5 only keep red and green
+            const size_t channels[] = { 3, 4, 4, 1, 2, 4 };
+            for (size_t i = 0; i < actual.size(); i += 4)
+                for (size_t c = 0; c < channels[f]; ++c)
+                    ASSERT_EQ(actual[i + c], expected[i + c]) << PixelUtil::getFormatName(COMPRESSED_FORMATS[f]);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreOptimisedUtil.h"
+#include "OgreMatrix4.h"
+#include "OgrePlane.h"
+#include "OgreVector4.h"
+
+#include <random>
+
+using namespace Ogre;
+
+/** Checks every SIMD implementation of OptimisedUtil usable on this machine
+    against the general one. Sizes are chosen to leave tails for all vector
+    widths.
+*/
+class OptimisedUtilTests : public ::testing::Test
+{
+public:
+    /// SIMD aligned float buffer
+    struct Buffer
+    {
+        float* data;
+        explicit Buffer(size_t count)
+            : data(static_cast<float*>(OGRE_MALLOC_SIMD(sizeof(float) * count, MEMCATEGORY_GENERAL)))
+        {
+            memset(data, 0, sizeof(float) * count);
+        }
+        ~Buffer() { OGRE_FREE_SIMD(data, MEMCATEGORY_GENERAL); }
+        operator float*() { return data; }
+    };
+
+    std::minstd_rand mRng;
+
+    float random(float low, float high)
+    {
+        return std::uniform_real_distribution<float>(low, high)(mRng);
+    }
+
+    void fill(float* data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data[i] = random(-10, 10);
+    }
+
+    static void expectNear(const float* expected, const float* actual, size_t count, const char* name)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            // the SIMD versions may use approximate reciprocals
+            float tolerance = 1e-3f * std::max(1.0f, Math::Abs(expected[i]));
+            ASSERT_NEAR(expected[i], actual[i], tolerance) << name << " at " << i;
+        }
+    }
+
+    static OptimisedUtil* general()
+    {
+        return OptimisedUtil::getAvailableImplementations()[0];
+    }
+};
+//--------------------------------------------------------------------------
+TEST_F(OptimisedUtilTests, Implementations)
+{
+    const vector<OptimisedUtil*>::type& impls = OptimisedUtil::getAvailableImplementations();
+    ASSERT_FALSE(impls.empty());
+    EXPECT_STREQ("General", impls[0]->getName());
+    EXPECT_TRUE(std::find(impls.begin(), impls.end(), OptimisedUtil::getImplementation()) != impls.end());
+}
+//--------------------------------------------------------------------------
+TEST_F(OptimisedUtilTests, SoftwareVertexSkinning)
+{
+    const size_t numVertices = 37, numMatrices = 10, numWeights = 4;
+
+    vector<Affine3>::type matrices(numMatrices);
+    vector<const Affine3*>::type blendMatrices(numMatrices);
+    for (size_t i = 0; i < numMatrices; ++i)
+    {
+        Quaternion q(random(-1, 1), random(-1, 1), random(-1, 1), random(-1, 1));
+        q.normalise();
+        matrices[i].makeTransform(Vector3(random(-5, 5), random(-5, 5), random(-5, 5)),
+            Vector3::UNIT_SCALE * random(0.5f, 2), q);
+        blendMatrices[i] = &matrices[i];
+    }
+
+    // Interleaved position and normal, as in a shared buffer
+    Buffer src(numVertices * 6);
+    fill(src, numVertices * 6);
+    Buffer weights(numVertices * numWeights);
+    vector<unsigned char>::type indices(numVertices * numWeights);
+    for (size_t v = 0; v < numVertices; ++v)
+    {
+        float sum = 0;
+        for (size_t w = 0; w < numWeights; ++w)
+        {
+            // some unused weights, as on vertices with fewer bones
+            bool used = w == 0 || random(0, 1) < 0.6f;
+            weights[v * numWeights + w] = used ? random(0.1f, 1) : 0;
+            indices[v * numWeights + w] = (unsigned char)(mRng() % numMatrices);
+            sum += weights[v * numWeights + w];
+        }
+        for (size_t w = 0; w < numWeights; ++w)
+            weights[v * numWeights + w] /= sum;
+    }
+
+    const size_t stride = sizeof(float) * 6;
+    Buffer expected(numVertices * 6), actual(numVertices * 6);
+    for (int withNormals = 0; withNormals < 2; ++withNormals)
+    {
+        general()->softwareVertexSkinning(
+            src, expected, withNormals ? src + 3 : 0, expected + 3,
+            weights, &indices[0], &blendMatrices[0],
+            stride, stride, stride, stride,
+            sizeof(float) * numWeights, numWeights, numWeights, numVertices);
+
+        for (size_t i = 1; i < OptimisedUtil::getAvailableImplementations().size(); ++i)
+        {
+            OptimisedUtil* impl = OptimisedUtil::getAvailableImplementations()[i];
+            memset(actual, 0, sizeof(float) * numVertices * 6);
+            impl->softwareVertexSkinning(
+                src, actual, withNormals ? src + 3 : 0, actual + 3,
+                weights, &indices[0], &blendMatrices[0],
+                stride, stride, stride, stride,
+                sizeof(float) * numWeights, numWeights, numWeights, numVertices);
+            expectNear(expected, actual, numVertices * 6, impl->getName());
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(OptimisedUtilTests, SoftwareVertexMorph)
+{
+    const size_t numVertices = 37;
+    Buffer src1(numVertices * 6), src2(numVertices * 6);
+    fill(src1, numVertices * 6);
+    fill(src2, numVertices * 6);
+
+    Buffer expected(numVertices * 6), actual(numVertices * 6);
+    for (int withNormals = 0; withNormals < 2; ++withNormals)
+    {
+        // packed positions only, or positions and normals
+        const size_t vsize = sizeof(float) * (withNormals ? 6 : 3);
+        general()->softwareVertexMorph(0.3f, src1, src2, expected, vsize, vsize, vsize, numVertices, withNormals != 0);
+
+        for (size_t i = 1; i < OptimisedUtil::getAvailableImplementations().size(); ++i)
+        {
+            OptimisedUtil* impl = OptimisedUtil::getAvailableImplementations()[i];
+            memset(actual, 0, sizeof(float) * numVertices * 6);
+            impl->softwareVertexMorph(0.3f, src1, src2, actual, vsize, vsize, vsize, numVertices, withNormals != 0);
+            expectNear(expected, actual, numVertices * 6, impl->getName());
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(OptimisedUtilTests, ConcatenateAffineMatrices)
+{
+    const size_t numMatrices = 13;
+    Affine3 base(Vector3(1, 2, 3), Quaternion(Degree(30), Vector3::UNIT_Y), Vector3(2, 2, 2));
+
+    // Affine3 is 16 floats, keep the arrays aligned
+    Buffer src(numMatrices * 16), expected(numMatrices * 16), actual(numMatrices * 16);
+    Affine3* srcMatrices = reinterpret_cast<Affine3*>(src.data);
+    for (size_t i = 0; i < numMatrices; ++i)
+    {
+        srcMatrices[i] = Affine3(Vector3(random(-5, 5), random(-5, 5), random(-5, 5)),
+            Quaternion(Radian(random(-3, 3)), Vector3::UNIT_X));
+    }
+
+    general()->concatenateAffineMatrices(base, srcMatrices, reinterpret_cast<Affine3*>(expected.data), numMatrices);
+    for (size_t i = 1; i < OptimisedUtil::getAvailableImplementations().size(); ++i)
+    {
+        OptimisedUtil* impl = OptimisedUtil::getAvailableImplementations()[i];
+        memcpy(actual, expected, sizeof(float) * numMatrices * 16);
+        for (size_t m = 0; m < numMatrices; ++m)
+            memset(actual + m * 16, 0, sizeof(float) * 12);
+
+        impl->concatenateAffineMatrices(base, srcMatrices, reinterpret_cast<Affine3*>(actual.data), numMatrices);
+        expectNear(expected, actual, numMatrices * 16, impl->getName());
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(OptimisedUtilTests, ShadowVolumeKernels)
+{
+    const size_t numVertices = 41, numTriangles = 37;
+    Buffer positions(numVertices * 3);
+    fill(positions, numVertices * 3);
+
+    vector<EdgeData::Triangle>::type triangles(numTriangles);
+    for (size_t i = 0; i < numTriangles; ++i)
+    {
+        for (size_t k = 0; k < 3; ++k)
+            triangles[i].vertIndex[k] = mRng() % numVertices;
+    }
+
+    Buffer expectedNormals(numTriangles * 4), actualNormals(numTriangles * 4);
+    general()->calculateFaceNormals(positions, &triangles[0],
+        reinterpret_cast<Vector4*>(expectedNormals.data), numTriangles);
+
+    const Vector4 pointLight(3, -4, 5, 1), directionalLight(-1, -2, 0.5f, 0);
+    vector<char>::type expectedFacings(numTriangles), actualFacings(numTriangles);
+    general()->calculateLightFacing(pointLight,
+        reinterpret_cast<Vector4*>(expectedNormals.data), &expectedFacings[0], numTriangles);
+
+    Buffer expectedExtruded(numVertices * 3), actualExtruded(numVertices * 3);
+
+    for (size_t i = 1; i < OptimisedUtil::getAvailableImplementations().size(); ++i)
+    {
+        OptimisedUtil* impl = OptimisedUtil::getAvailableImplementations()[i];
+
+        impl->calculateFaceNormals(positions, &triangles[0],
+            reinterpret_cast<Vector4*>(actualNormals.data), numTriangles);
+        expectNear(expectedNormals, actualNormals, numTriangles * 4, impl->getName());
+
+        impl->calculateLightFacing(pointLight,
+            reinterpret_cast<Vector4*>(expectedNormals.data), &actualFacings[0], numTriangles);
+        const Vector4* normals = reinterpret_cast<Vector4*>(expectedNormals.data);
+        for (size_t t = 0; t < numTriangles; ++t)
+        {
+            // rounding may flip faces exactly edge on
+            if (Math::Abs(pointLight.dotProduct(normals[t])) > 1e-3f)
+                EXPECT_EQ(expectedFacings[t], actualFacings[t]) << impl->getName() << " at " << t;
+        }
+
+        const Vector4* lights[] = { &pointLight, &directionalLight };
+        for (size_t l = 0; l < 2; ++l)
+        {
+            general()->extrudeVertices(*lights[l], 100, positions, expectedExtruded, numVertices);
+            impl->extrudeVertices(*lights[l], 100, positions, actualExtruded, numVertices);
+            expectNear(expectedExtruded, actualExtruded, numVertices * 3, impl->getName());
+        }
+    }
+}
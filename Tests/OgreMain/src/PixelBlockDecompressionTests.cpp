@@ -0,0 +1,306 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgrePixelFormat.h"
+#include "OgreBitwise.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+    /// Decodes blocks through PixelUtil::bulkPixelConversion
+    std::vector<uchar> decompress(const std::vector<uchar>& blocks, uint32 width, uint32 height,
+                                  PixelFormat format, PixelFormat dstFormat = PF_BYTE_RGBA)
+    {
+        PixelBox dst(width, height, 1, dstFormat);
+        std::vector<uchar> pixels(dst.getConsecutiveSize());
+        dst.data = &pixels[0];
+        PixelUtil::bulkPixelConversion(PixelBox(width, height, 1, format, const_cast<uchar*>(&blocks[0])), dst);
+        return pixels;
+    }
+
+    /// Writes the fields of a BC6H or BC7 block, least significant bits first
+    struct BlockWriter
+    {
+        uchar block[16];
+        size_t pos;
+
+        BlockWriter() : pos(0) { memset(block, 0, sizeof(block)); }
+
+        void write(uint32 value, size_t bits)
+        {
+            for (size_t i = 0; i < bits; ++i, ++pos)
+                block[pos / 8] |= ((value >> i) & 1) << (pos % 8);
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    // Reference decoders of the colour and alpha blocks, one pixel at a time
+    //--------------------------------------------------------------------------
+    void referenceColour(const uchar* block, bool opaque, uint32 pixel, uchar* rgba)
+    {
+        uint32 c[2] = { uint32(block[0] | (block[1] << 8)), uint32(block[2] | (block[3] << 8)) };
+        int palette[4][4];
+        for (int i = 0; i < 2; ++i)
+        {
+            // 565 expanded by bit replication
+            uint32 r = (c[i] >> 11) & 31, g = (c[i] >> 5) & 63, b = c[i] & 31;
+            palette[i][0] = int((r << 3) | (r >> 2));
+            palette[i][1] = int((g << 2) | (g >> 4));
+            palette[i][2] = int((b << 3) | (b >> 2));
+            palette[i][3] = 255;
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            if (opaque || c[0] > c[1])
+            {
+                palette[2][k] = (2 * palette[0][k] + palette[1][k] + 1) / 3;
+                palette[3][k] = (palette[0][k] + 2 * palette[1][k] + 1) / 3;
+            }
+            else
+            {
+                palette[2][k] = (palette[0][k] + palette[1][k] + 1) / 2;
+                palette[3][k] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = opaque || c[0] > c[1] ? 255 : 0;
+
+        uint32 index = (block[4 + pixel / 4] >> ((pixel % 4) * 2)) & 3;
+        for (int k = 0; k < 4; ++k)
+            rgba[k] = uchar(palette[index][k]);
+    }
+
+    uchar referenceAlpha(const uchar* block, uint32 pixel)
+    {
+        int a0 = block[0], a1 = block[1];
+        uint64 bits = 0;
+        for (int i = 0; i < 6; ++i)
+            bits |= uint64(block[2 + i]) << (i * 8);
+        int index = int((bits >> (pixel * 3)) & 7);
+        if (index < 2)
+            return uchar(index ? a1 : a0);
+        if (a0 > a1)
+            return uchar(((8 - index) * a0 + (index - 1) * a1 + 3) / 7);
+        if (index >= 6)
+            return index == 6 ? 0 : 255;
+        return uchar(((6 - index) * a0 + (index - 1) * a1 + 2) / 5);
+    }
+}
+
+//--------------------------------------------------------------------------
+TEST(PixelBlockDecompressionTests, DXT1)
+{
+    // red, blue and the two colours between them
+    std::vector<uchar> blocks = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+    std::vector<uchar> pixels = decompress(blocks, 4, 4, PF_DXT1);
+    const uchar expected[16] = { 255, 0, 0, 255, 0, 0, 255, 255, 170, 0, 85, 255, 85, 0, 170, 255 };
+    for (size_t y = 0; y < 4; ++y)
+        EXPECT_EQ(0, memcmp(&pixels[y * 16], expected, 16)) << "row " << y;
+
+    // 3 colour mode with transparent black
+    std::swap(blocks[0], blocks[2]);
+    std::swap(blocks[1], blocks[3]);
+    pixels = decompress(blocks, 4, 4, PF_DXT1);
+    const uchar expectedTransparent[16] = { 0, 0, 255, 255, 255, 0, 0, 255, 128, 0, 128, 255, 0, 0, 0, 0 };
+    EXPECT_EQ(0, memcmp(&pixels[0], expectedTransparent, 16));
+}
+//--------------------------------------------------------------------------
+TEST(PixelBlockDecompressionTests, MatchesReference)
+{
+    // random blocks, which cover every mode, through the SIMD decoders where available
+    const PixelFormat formats[] = { PF_DXT1, PF_DXT3, PF_DXT5, PF_BC4_UNORM, PF_BC5_UNORM };
+    const uint32 width = 32, height = 16;
+    std::minstd_rand rng;
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f)
+    {
+        PixelFormat format = formats[f];
+        std::vector<uchar> blocks(PixelUtil::getMemorySize(width, height, 1, format));
+        for (size_t i = 0; i < blocks.size(); ++i)
+            blocks[i] = uchar(rng());
+        std::vector<uchar> pixels = decompress(blocks, width, height, format);
+
+        const size_t blockSize = blocks.size() / (width * height / 16);
+        for (uint32 y = 0; y < height; ++y)
+        {
+            for (uint32 x = 0; x < width; ++x)
+            {
+                const uchar* block = &blocks[((y / 4) * (width / 4) + x / 4) * blockSize];
+                uint32 pixel = (y % 4) * 4 + x % 4;
+                uchar expected[4] = { 0, 0, 0, 255 };
+                switch (format)
+                {
+                case PF_DXT1:
+                    referenceColour(block, false, pixel, expected);
+                    break;
+                case PF_DXT3:
+                    referenceColour(block + 8, true, pixel, expected);
+                    expected[3] = uchar(((block[pixel / 2] >> ((pixel % 2) * 4)) & 0xF) * 17);
+                    break;
+                case PF_DXT5:
+                    referenceColour(block + 8, true, pixel, expected);
+                    expected[3] = referenceAlpha(block, pixel);
+                    break;
+                case PF_BC5_UNORM:
+                    expected[1] = referenceAlpha(block + 8, pixel);
+                    // fall through
+                default:
+                    expected[0] = referenceAlpha(block, pixel);
+                    break;
+                }
+                const uchar* actual = &pixels[(y * width + x) * 4];
+                for (int k = 0; k < 4; ++k)
+                    ASSERT_EQ(expected[k], actual[k]) << PixelUtil::getFormatName(format)
+                                                      << " x " << x << " y " << y << " channel " << k;
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST(PixelBlockDecompressionTests, PartialBlocksAndSubBox)
+{
+    // a 6x5 image is 2x2 blocks, decoded into the middle of a larger image
+    std::vector<uchar> blocks(4 * 8);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        // a solid colour per block
+        blocks[i * 8 + 0] = blocks[i * 8 + 2] = uchar(0x1F * i / 3);
+    }
+
+    std::vector<uchar> pixels(16 * 16 * 4, 0x55);
+    PixelBox dst(Box(3, 7, 9, 12), PF_BYTE_RGBA, &pixels[0]);
+    dst.rowPitch = 16;
+    dst.slicePitch = 16 * 16;
+    PixelUtil::bulkPixelConversion(PixelBox(6, 5, 1, PF_DXT1, &blocks[0]), dst);
+
+    for (uint32 y = 0; y < 16; ++y)
+    {
+        for (uint32 x = 0; x < 16; ++x)
+        {
+            const uchar* pixel = &pixels[(y * 16 + x) * 4];
+            if (x < 3 || x >= 9 || y < 7 || y >= 12)
+            {
+                EXPECT_EQ(0x55, pixel[0]) << x << " " << y;
+                EXPECT_EQ(0x55, pixel[3]) << x << " " << y;
+                continue;
+            }
+            size_t block = ((y - 7) / 4) * 2 + (x - 3) / 4;
+            uint32 b = 0x1F * uint32(block) / 3;
+            EXPECT_EQ(uchar((b << 3) | (b >> 2)), pixel[2]) << x << " " << y;
+            EXPECT_EQ(255, pixel[3]) << x << " " << y;
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST(PixelBlockDecompressionTests, SignedBC4BC5)
+{
+    // 127 and -127 (0x81), the first two pixels use them, -128 is clamped to -127
+    std::vector<uchar> blocks = { 0x7F, 0x81, 0x08, 0, 0, 0, 0, 0, 0x80, 0x7F, 0x08, 0, 0, 0, 0, 0 };
+    std::vector<uchar> pixels = decompress(blocks, 4, 4, PF_BC5_SNORM, PF_FLOAT32_RGBA);
+    const float* values = reinterpret_cast<const float*>(&pixels[0]);
+    EXPECT_FLOAT_EQ(1.0f, values[0]);
+    EXPECT_FLOAT_EQ(-1.0f, values[1]);
+    EXPECT_FLOAT_EQ(-1.0f, values[4]);
+    EXPECT_FLOAT_EQ(1.0f, values[5]);
+    EXPECT_FLOAT_EQ(0.0f, values[6]);
+    EXPECT_FLOAT_EQ(1.0f, values[7]);
+}
+//--------------------------------------------------------------------------
+TEST(PixelBlockDecompressionTests, BC7)
+{
+    // mode 6: one subset of RGBA 7.7.7.7 endpoints with a p-bit each, 4 bit indices
+    BlockWriter writer;
+    writer.write(1 << 6, 7);
+    const uint32 endpoints[4][2] = { { 100, 0 }, { 50, 0 }, { 127, 0 }, { 127, 0 } };
+    for (int c = 0; c < 4; ++c)
+    {
+        writer.write(endpoints[c][0], 7);
+        writer.write(endpoints[c][1], 7);
+    }
+    writer.write(1, 1);
+    writer.write(0, 1);
+    // the anchor index has 3 bits, the second pixel uses the second endpoint
+    writer.write(0, 3);
+    writer.write(15, 4);
+    writer.write(8, 4);
+    ASSERT_EQ(7u + 56 + 2 + 3 + 4 + 4, writer.pos);
+
+    std::vector<uchar> blocks(writer.block, writer.block + 16);
+    std::vector<uchar> pixels = decompress(blocks, 4, 4, PF_BC7_UNORM);
+    const uchar expected[12] = { 201, 101, 255, 255, 0, 0, 0, 0, 94, 47, 120, 120 };
+    EXPECT_EQ(0, memcmp(&pixels[0], expected, sizeof(expected)));
+    // remaining pixels use index 0
+    for (size_t i = 3; i < 16; ++i)
+        EXPECT_EQ(0, memcmp(&pixels[i * 4], expected, 4)) << "pixel " << i;
+
+    // the reserved mode 8 is transparent black
+    blocks.assign(16, 0);
+    pixels = decompress(blocks, 4, 4, PF_BC7_UNORM);
+    EXPECT_EQ(std::vector<uchar>(64, 0), pixels);
+}
+//--------------------------------------------------------------------------
+TEST(PixelBlockDecompressionTests, BC6H)
+{
+    // mode 11: one region of 10 bit endpoints, 4 bit indices
+    BlockWriter writer;
+    writer.write(3, 5);
+    for (int i = 0; i < 3; ++i)
+        writer.write(0x3FF, 10);
+    for (int i = 0; i < 3; ++i)
+        writer.write(0, 10);
+    // pixel 1 uses the second endpoint
+    writer.write(0, 3);
+    writer.write(15, 4);
+
+    std::vector<uchar> blocks(writer.block, writer.block + 16);
+    std::vector<uchar> pixels = decompress(blocks, 4, 4, PF_BC6H_UF16, PF_FLOAT32_RGBA);
+    const float* values = reinterpret_cast<const float*>(&pixels[0]);
+    // the largest unsigned endpoint is the largest half float
+    EXPECT_FLOAT_EQ(65504.0f, values[0]);
+    EXPECT_FLOAT_EQ(65504.0f, values[2]);
+    EXPECT_FLOAT_EQ(1.0f, values[3]);
+    EXPECT_FLOAT_EQ(0.0f, values[4]);
+    EXPECT_FLOAT_EQ(65504.0f, values[8]);
+
+    // signed, the same bits are -1 and 0
+    pixels = decompress(blocks, 4, 4, PF_BC6H_SF16, PF_FLOAT32_RGBA);
+    values = reinterpret_cast<const float*>(&pixels[0]);
+    EXPECT_GT(0.0f, values[0]);
+    EXPECT_FLOAT_EQ(0.0f, values[4]);
+
+    // a reserved mode decodes to black
+    blocks.assign(16, 0);
+    blocks[0] = 0x13;
+    pixels = decompress(blocks, 4, 4, PF_BC6H_UF16, PF_FLOAT32_RGBA);
+    values = reinterpret_cast<const float*>(&pixels[0]);
+    EXPECT_FLOAT_EQ(0.0f, values[0]);
+    EXPECT_FLOAT_EQ(1.0f, values[3]);
+}
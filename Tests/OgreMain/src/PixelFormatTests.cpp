@@ -220,6 +220,102 @@ TEST_F(PixelFormatTests,BulkConversion)
     testCase(PF_X8B8G8R8, PF_A8B8G8R8);
     testCase(PF_X8B8G8R8, PF_B8G8R8A8);
     testCase(PF_X8B8G8R8, PF_R8G8B8A8);
+
+    // Row kernels
+    testCase(PF_R8G8B8, PF_R8G8B8A8);
+    testCase(PF_R8G8B8A8, PF_R8G8B8);
+    testCase(PF_BYTE_LA, PF_A8R8G8B8);
+    testCase(PF_A8R8G8B8, PF_BYTE_LA);
+    testCase(PF_A8R8G8B8, PF_B8G8R8);
+    testCase(PF_L8, PF_R8G8B8);
+    testCase(PF_A8R8G8B8, PF_FLOAT32_RGBA);
+    testCase(PF_A8B8G8R8, PF_FLOAT32_RGB);
+    testCase(PF_R8G8B8, PF_FLOAT32_RGBA);
+    testCase(PF_L8, PF_FLOAT32_R);
+    testCase(PF_BYTE_LA, PF_FLOAT32_GR);
+    testCase(PF_FLOAT32_RGBA, PF_A8R8G8B8);
+    testCase(PF_FLOAT32_RGBA, PF_R8G8B8);
+    testCase(PF_FLOAT32_RGB, PF_A8B8G8R8);
+    testCase(PF_FLOAT32_R, PF_L8);
+    testCase(PF_FLOAT32_GR, PF_B8G8R8A8);
+    testCase(PF_FLOAT16_R, PF_FLOAT32_R);
+    testCase(PF_FLOAT16_GR, PF_FLOAT32_GR);
+    testCase(PF_FLOAT16_RGB, PF_FLOAT32_RGB);
+    testCase(PF_FLOAT16_RGBA, PF_FLOAT32_RGBA);
+    testCase(PF_FLOAT32_R, PF_FLOAT16_R);
+    testCase(PF_FLOAT32_GR, PF_FLOAT16_GR);
+    testCase(PF_FLOAT32_RGB, PF_FLOAT16_RGB);
+    testCase(PF_FLOAT32_RGBA, PF_FLOAT16_RGBA);
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,BulkConversionSubBox)
+{
+    // rows with odd widths and pitches, so the SIMD kernels handle tails
+    PixelBox src(Box(3, 1, 0, 3 + 37, 1 + 5, 2), PF_R8G8B8, mRandomData);
+    src.rowPitch = 45;
+    src.slicePitch = 45 * 7;
+    PixelBox dst1(src.getWidth(), src.getHeight(), src.getDepth(), PF_A8B8G8R8, mTemp);
+    PixelBox dst2(src.getWidth(), src.getHeight(), src.getDepth(), PF_A8B8G8R8, mTemp2);
+
+    PixelUtil::bulkPixelConversion(src, dst1);
+
+    uint8* dstptr = dst2.data;
+    for(size_t z = src.front; z < src.back; z++)
+    {
+        for(size_t y = src.top; y < src.bottom; y++)
+        {
+            for(size_t x = src.left; x < src.right; x++)
+            {
+                float r, g, b, a;
+                PixelUtil::unpackColour(&r, &g, &b, &a, src.format,
+                                        src.data + (z * src.slicePitch + y * src.rowPitch + x) * 3);
+                PixelUtil::packColour(r, g, b, a, dst2.format, dstptr);
+                dstptr += 4;
+            }
+        }
+    }
+    EXPECT_TRUE(memcmp(dst1.data, dst2.data, dst1.getConsecutiveSize()) == 0);
+}
+//--------------------------------------------------------------------------
+TEST_F(PixelFormatTests,SRGBConversion)
+{
+    setupBoxes(PF_A8B8G8R8, PF_FLOAT32_RGBA);
+    PixelUtil::convertSRGBToLinear(mSrc, mDst1);
+
+    const float* linear = reinterpret_cast<const float*>(mDst1.data);
+    for(size_t x = 0; x < mSrc.getWidth(); x++)
+    {
+        float rgba[4];
+        PixelUtil::unpackColour(&rgba[0], &rgba[1], &rgba[2], &rgba[3], mSrc.format,
+                                mSrc.data + x * 4);
+        for(int c = 0; c < 3; c++)
+        {
+            float v = rgba[c];
+            float expected = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+            EXPECT_NEAR(linear[x * 4 + c], expected, 1e-6f);
+        }
+        EXPECT_EQ(linear[x * 4 + 3], rgba[3]);
+    }
+
+    // 8 bit sRGB survives the round trip through linear floats
+    mDst2 = PixelBox(mSrc.getWidth(), 1, 1, PF_A8B8G8R8, mTemp2);
+    PixelUtil::convertLinearToSRGB(mDst1, mDst2);
+    EXPECT_TRUE(memcmp(mSrc.data, mDst2.data, mSrc.getConsecutiveSize()) == 0);
+
+    // the per pixel path gives the same bytes
+    float* srgb = reinterpret_cast<float*>(mTemp);
+    for(size_t x = 0; x < 256; x++)
+        srgb[x] = x / 255.0f;
+    PixelBox lum(256, 1, 1, PF_FLOAT32_R, srgb);
+    uint8 fast[256], slow[256 * 2];
+    PixelUtil::convertLinearToSRGB(lum, PixelBox(256, 1, 1, PF_L8, fast));
+    PixelUtil::convertLinearToSRGB(lum, PixelBox(256, 1, 1, PF_L16, slow));
+    for(size_t x = 0; x < 256; x++)
+    {
+        uint16 l16;
+        memcpy(&l16, slow + x * 2, sizeof(l16));
+        EXPECT_NEAR(fast[x], l16 / 257.0f, 0.51f);
+    }
 }
 //--------------------------------------------------------------------------
 
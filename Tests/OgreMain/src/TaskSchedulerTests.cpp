@@ -0,0 +1,212 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreTaskScheduler.h"
+#include "OgreLogManager.h"
+#include "OgreException.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+
+using namespace Ogre;
+
+class TaskSchedulerTests : public ::testing::Test
+{
+public:
+    LogManager* mLogManager;
+    DefaultWorkQueue* mQueue;
+    TaskScheduler* mScheduler;
+
+    void SetUp()
+    {
+        mLogManager = OGRE_NEW LogManager();
+        mLogManager->createLog("TaskSchedulerTests.log", true, false, true);
+
+        mQueue = OGRE_NEW DefaultWorkQueue("Test");
+        mQueue->setWorkerThreadCount(4);
+        mQueue->startup();
+        mScheduler = OGRE_NEW TaskScheduler(mQueue);
+    }
+    void TearDown()
+    {
+        OGRE_DELETE mScheduler;
+        OGRE_DELETE mQueue;
+        OGRE_DELETE mLogManager;
+    }
+};
+
+/// Counts how often each index is visited
+struct CountingRangeJob : public TaskScheduler::RangeJob
+{
+    vector<AtomicScalar<int> >::type mVisits;
+    CountingRangeJob(size_t count) : mVisits(count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            mVisits[i] = 0;
+    }
+    void execute(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            ++mVisits[i];
+    }
+};
+
+/// Records the order in which tasks finish
+struct OrderedTask : public Task
+{
+    AtomicScalar<int>* mCounter;
+    int mOrder;
+    OrderedTask() : mCounter(0), mOrder(-1) {}
+    void execute(void) { mOrder = (*mCounter)++; }
+};
+
+TEST_F(TaskSchedulerTests, ParallelFor)
+{
+    EXPECT_EQ(mScheduler->getThreadCount(), 5u);
+
+    CountingRangeJob job(100000);
+    mScheduler->parallelFor(10, 100000, 7, job);
+    mScheduler->parallelFor(10, 100000, 100000, job);
+
+    for (size_t i = 0; i < 100000; ++i)
+        ASSERT_EQ(job.mVisits[i], i < 10 ? 0 : 2);
+
+    // nothing to do
+    mScheduler->parallelFor(10, 10, 1, job);
+}
+
+TEST_F(TaskSchedulerTests, Dependencies)
+{
+    AtomicScalar<int> counter(0);
+    OrderedTask tasks[4];
+    for (int i = 0; i < 4; ++i)
+        tasks[i].mCounter = &counter;
+
+    // diamond: 0 before 1 and 2, which are before 3
+    tasks[1].addDependency(&tasks[0]);
+    tasks[2].addDependency(&tasks[0]);
+    tasks[3].addDependency(&tasks[1]);
+    tasks[3].addDependency(&tasks[2]);
+
+    // submit the continuations first
+    TaskGroup group;
+    for (int i = 3; i >= 0; --i)
+        mScheduler->submit(&tasks[i], group);
+    mScheduler->wait(group);
+
+    EXPECT_TRUE(group.isFinished());
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(tasks[i].isFinished());
+    EXPECT_EQ(tasks[0].mOrder, 0);
+    EXPECT_EQ(tasks[3].mOrder, 3);
+
+    // a long chain
+    counter = 0;
+    OrderedTask chain[100];
+    for (int i = 0; i < 100; ++i)
+    {
+        chain[i].mCounter = &counter;
+        if (i)
+            chain[i].addDependency(&chain[i - 1]);
+    }
+    TaskGroup chainGroup;
+    for (int i = 0; i < 100; ++i)
+        mScheduler->submit(&chain[i], chainGroup);
+    mScheduler->wait(chainGroup);
+
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(chain[i].mOrder, i);
+}
+
+/// Runs a parallelFor from within a task
+struct NestedTask : public Task
+{
+    TaskScheduler* mScheduler;
+    CountingRangeJob mJob;
+    NestedTask() : mScheduler(0), mJob(1000) {}
+    void execute(void) { mScheduler->parallelFor(0, 1000, 10, mJob); }
+};
+
+TEST_F(TaskSchedulerTests, NestedWait)
+{
+    NestedTask tasks[16];
+    TaskGroup group;
+    for (int i = 0; i < 16; ++i)
+    {
+        tasks[i].mScheduler = mScheduler;
+        mScheduler->submit(&tasks[i], group);
+    }
+    mScheduler->wait(group);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        for (size_t j = 0; j < 1000; ++j)
+            ASSERT_EQ(tasks[i].mJob.mVisits[j], 1);
+    }
+}
+
+struct ThrowingRangeJob : public TaskScheduler::RangeJob
+{
+    void execute(size_t begin, size_t end)
+    {
+        if (begin <= 500 && 500 < end)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "500", "ThrowingRangeJob::execute");
+    }
+};
+
+TEST_F(TaskSchedulerTests, Exceptions)
+{
+    ThrowingRangeJob job;
+    EXPECT_THROW(mScheduler->parallelFor(0, 1000, 1, job), InvalidParametersException);
+
+    // the scheduler can still be used
+    CountingRangeJob counting(1000);
+    mScheduler->parallelFor(0, 1000, 1, counting);
+    EXPECT_EQ(counting.mVisits[999], 1);
+}
+
+TEST_F(TaskSchedulerTests, WithoutWorkers)
+{
+    mScheduler->setWorkQueue(NULL);
+    EXPECT_EQ(mScheduler->getThreadCount(), 1u);
+
+    CountingRangeJob job(1000);
+    mScheduler->parallelFor(0, 1000, 3, job);
+    for (size_t i = 0; i < 1000; ++i)
+        ASSERT_EQ(job.mVisits[i], 1);
+
+    AtomicScalar<int> counter(0);
+    OrderedTask tasks[2];
+    tasks[0].mCounter = tasks[1].mCounter = &counter;
+    tasks[0].addDependency(&tasks[1]);
+    TaskGroup group;
+    mScheduler->submit(&tasks[0], group);
+    mScheduler->submit(&tasks[1], group);
+    mScheduler->wait(group);
+    EXPECT_EQ(tasks[0].mOrder, 1);
+    EXPECT_EQ(tasks[1].mOrder, 0);
+}
@@ -0,0 +1,141 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "OgreTextureManager.h"
+#include "OgreImage.h"
+#include "OgreBitwise.h"
+
+using namespace Ogre;
+
+namespace
+{
+    TextureManager::StreamingTexture makeTexture(uint32 size, uint32 residentMipmap, Real demand)
+    {
+        TextureManager::StreamingTexture t;
+        t.width = t.height = size;
+        t.numMipmaps = Bitwise::mostSignificantBitSet(size);
+        t.format = PF_A8R8G8B8;
+        // keep 64x64
+        t.maxResidentMipmap = t.numMipmaps - 6;
+        t.residentMipmap = residentMipmap;
+        t.demand = demand;
+        t.targetMipmap = residentMipmap;
+        t.texture = 0;
+        return t;
+    }
+
+    size_t getTotalSize(const TextureManager::StreamingTextureList& textures)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < textures.size(); ++i)
+            total += textures[i].getSize(textures[i].targetMipmap);
+        return total;
+    }
+}
+//--------------------------------------------------------------------------
+TEST(TextureStreamingTests, Size)
+{
+    TextureManager::StreamingTexture t = makeTexture(1024, 0, 0);
+    EXPECT_EQ(Image::calculateSize(10, 1, 1024, 1024, 1, PF_A8R8G8B8), t.getSize(0));
+    EXPECT_EQ(Image::calculateSize(6, 1, 64, 64, 1, PF_A8R8G8B8), t.getSize(4));
+    EXPECT_EQ(4u, t.getSize(10));
+}
+//--------------------------------------------------------------------------
+TEST(TextureStreamingTests, DemandWithinBudget)
+{
+    TextureManager::StreamingTextureList textures;
+    // 300 pixels on screen need the 512 mipmap
+    textures.push_back(makeTexture(1024, 4, 300));
+    // larger than the texture
+    textures.push_back(makeTexture(1024, 4, 5000));
+    // not seen
+    textures.push_back(makeTexture(1024, 4, 0));
+    // less than the smallest detail kept
+    textures.push_back(makeTexture(1024, 4, 10));
+
+    size_t total = TextureManager::_planStreaming(textures, 100 << 20);
+    EXPECT_EQ(1u, textures[0].targetMipmap);
+    EXPECT_EQ(0u, textures[1].targetMipmap);
+    EXPECT_EQ(4u, textures[2].targetMipmap);
+    EXPECT_EQ(4u, textures[3].targetMipmap);
+    EXPECT_EQ(getTotalSize(textures), total);
+}
+//--------------------------------------------------------------------------
+TEST(TextureStreamingTests, KeepsResidentDetailWithoutPressure)
+{
+    TextureManager::StreamingTextureList textures;
+    textures.push_back(makeTexture(1024, 0, 0));
+    textures.push_back(makeTexture(1024, 2, 100));
+
+    TextureManager::_planStreaming(textures, 100 << 20);
+    EXPECT_EQ(0u, textures[0].targetMipmap);
+    EXPECT_EQ(2u, textures[1].targetMipmap);
+}
+//--------------------------------------------------------------------------
+TEST(TextureStreamingTests, BudgetDropsUnseenFirst)
+{
+    TextureManager::StreamingTextureList textures;
+    textures.push_back(makeTexture(1024, 0, 1024));
+    textures.push_back(makeTexture(1024, 0, 0));
+
+    // room for one full texture and the smallest detail of the other
+    size_t budget = textures[0].getSize(0) + textures[1].getSize(4);
+    size_t total = TextureManager::_planStreaming(textures, budget);
+    EXPECT_EQ(0u, textures[0].targetMipmap);
+    EXPECT_EQ(4u, textures[1].targetMipmap);
+    EXPECT_LE(total, budget);
+}
+//--------------------------------------------------------------------------
+TEST(TextureStreamingTests, BudgetBalancesTexelsPerPixel)
+{
+    TextureManager::StreamingTextureList textures;
+    textures.push_back(makeTexture(2048, 0, 1500));
+    textures.push_back(makeTexture(1024, 0, 800));
+    textures.push_back(makeTexture(512, 0, 120));
+
+    // the far 512 texture loses its excess detail, then the others have the most texels per pixel
+    size_t budget = textures[0].getSize(1) + textures[1].getSize(1) + textures[2].getSize(2);
+    size_t total = TextureManager::_planStreaming(textures, budget);
+    EXPECT_EQ(1u, textures[0].targetMipmap);
+    EXPECT_EQ(1u, textures[1].targetMipmap);
+    EXPECT_EQ(2u, textures[2].targetMipmap);
+    EXPECT_EQ(budget, total);
+}
+//--------------------------------------------------------------------------
+TEST(TextureStreamingTests, BudgetNeverDropsSmallestDetail)
+{
+    TextureManager::StreamingTextureList textures;
+    textures.push_back(makeTexture(1024, 0, 1024));
+    textures.push_back(makeTexture(256, 0, 256));
+
+    size_t total = TextureManager::_planStreaming(textures, 1);
+    EXPECT_EQ(4u, textures[0].targetMipmap);
+    EXPECT_EQ(2u, textures[1].targetMipmap);
+    EXPECT_EQ(textures[0].getSize(4) + textures[1].getSize(2), total);
+}